@@ -28,6 +28,8 @@
 #include "S57data.h"    // S57_prj2geo(), S52_geo2prj*(), projXY, S57_geo
 #include "S52CS.h"      // S52_CS_*()
 #include "S52GL.h"      // S52_GL_draw()
+#include "S52HO.h"      // S52_HO_*()
+#include "S52TR.h"      // S52_TR_CALL()
 
 #ifdef S52_USE_GV
 #include "S57gv.h"      // S57_gvLoadCell()
@@ -35,6 +37,24 @@
 #include "S57ogr.h"     // S57_ogrLoadCell()
 #endif // S52_USE_GV
 
+#ifdef S52_USE_ISO8211
+#include "S57iso8211.h" // S57_iso8211LoadCell(), S57_iso8211LoadUpdate()
+static int _ISO8211 = FALSE;  // TRUE while _crntCell is streamed by the native ISO 8211 reader (not OGR)
+#define S57_LOADLAYER(name,layer,cb) ((TRUE==_ISO8211) ? S57_iso8211LoadLayer(name,layer,cb) : S57_ogrLoadLayer(name,layer,cb))
+#define S57_LOADOBJECT(name,shape)   ((TRUE==_ISO8211) ? S57_iso8211LoadObject(name,shape)  : S57_ogrLoadObject(name,shape))
+#else
+#define S57_LOADLAYER(name,layer,cb) S57_ogrLoadLayer(name,layer,cb)
+#define S57_LOADOBJECT(name,shape)   S57_ogrLoadObject(name,shape)
+#endif  // S52_USE_ISO8211
+
+#ifdef S52_USE_CHART_MANAGER
+#include "S52CM.h"      // S52_CM_*()
+#endif
+
+#ifdef S52_USE_RENDER_THREAD
+#include "S52RT.h"      // S52_RT_*()
+#endif
+
 #include <string.h>     // memmove(), memcpy()
 #include <math.h>       // INFINITY
 #include <stdio.h>      // setbuf()
@@ -61,8 +81,6 @@ typedef struct { double u, v; } projUV;
 
 #define ATAN2TODEG(pt)    (90.0 - atan2(pt[1].y-pt[0].y, pt[1].x-pt[0].x) * RAD_TO_DEG)
 
-static GTimer *_timer = NULL;
-
 // trap signal (ESC abort rendering)
 // must be compiled with -std=gnu99 or -std=c99 -D_POSIX_C_SOURCE=199309L
 #include <unistd.h>      // getuid()
@@ -141,6 +159,24 @@ typedef struct _legend {
 
 } _legend;
 
+typedef struct _memStat {
+    guint nobj;
+    guint nvertex;
+    gsize geo;     // S57_geo + coords
+    gsize att;     // attributes
+    gsize prim;    // tessellated prim (CPU copy)
+    gsize obj;     // S52_obj (cmd, CS)
+    gsize text;    // text
+    gsize vbo;     // GPU - geo + text VBO
+} _memStat;
+
+// journal - place holder for object to be drawn (after culling)
+typedef struct _jrnl_t {
+    GPtrArray *objList_supp;   // list of object on the "Supress by Radar" layer
+    GPtrArray *objList_over;   // list of object on the "Over Radar" layer  (ie on top)
+    GPtrArray *textList;       // hold ref to object with text (drawn on top of everything)
+} _jrnl_t;
+
 typedef struct _cell {
     ObjExt_t   geoExt;     // cell geo extent
 
@@ -157,10 +193,11 @@ typedef struct _cell {
 
     _legend   legend;
 
-    // journal - place holder for object to be drawn (after culling)
-    GPtrArray *objList_supp;   // list of object on the "Supress by Radar" layer
-    GPtrArray *objList_over;   // list of object on the "Over Radar" layer  (ie on top)
-    GPtrArray *textList;       // hold ref to object with text (drawn on top of everything)
+#ifdef S52_USE_CTX
+    GArray    *jrnl;           // _jrnl_t of each context - indexed by slot (see JRNL())
+#else
+    _jrnl_t    jrnl;
+#endif
 
     GString   *S57ClassList;   // hold the names of S57 class of this cell
 
@@ -168,6 +205,36 @@ typedef struct _cell {
     int        projDone;       // TRUE this cell has been projected
 #endif
 
+#ifdef S52_USE_ARENA
+    S57_arena *arena;          // geo and coords of this cell - NULL for MARINER_CELL
+#endif
+
+#ifdef S52_USE_CHART_MANAGER
+    gint       cmSample;       // TRUE - loaded by the CM, size to re-sample once drawn (prim, VBO)
+#endif
+
+    // memory of this cell (see S52_getStats()) - under _str_mutex
+    _memStat   mem;
+    gint       memDirty;       // TRUE - obj added / removed / resolved / tessellated, re-walk mem
+
+    // DSID - edition and last update applied (see S52_loadUpdate())
+    guint      edtn;
+    guint      updn;
+
+    // HO data limit / scale boundary (see _appDATCVR())
+    int        hoDirty;        // TRUE - M_COVR of this cell not yet sent to the HO thread
+    int        hoData;         // TRUE - in S52_HO_HODATA union tree
+    int        hoTree;         // scale boundary union tree (INTU) - 0 if none
+    GPtrArray *m_covr;         // ref to M_COVR:CATCOV=1 geo
+    GPtrArray *sclbdGeo;       // ref to M_COVR:CATCOV=1 geo that are a scale boundary
+    GArray    *sclbdyH;        // sclbdy obj of sclbdGeo
+
+#ifdef S52_USE_SCAMIN_BIN
+    // cull record of each renderBin sorted on SCAMIN (descending) - see _cullSCAMIN()
+    GArray    *scaminBin[S52_PRIO_NUM][S52_N_OBJ];
+    gint       scaminDirty;    // TRUE - renderBin or SCAMIN changed, rebuild scaminBin
+#endif
+
     /*
     // optimisation - do CS only on obj affected by a change in a MP
     // instead of resolving the CS logic at render-time.
@@ -182,11 +249,28 @@ typedef struct _cell {
 
 } _cell;
 
+#ifdef S52_USE_SCAMIN_BIN
+// cull record - one per object of a renderBin
+typedef struct _scaminRec {
+    double scamin;   // INFINITY if never suppressed (DISPLAYBASE)
+    guint  idx;      // index of obj in renderBin (drawing order)
+} _scaminRec;
+
+// renderBin of this cell has changed (obj added / removed / moved, CS resolved)
+#define SCAMIN_DIRTY(c) g_atomic_int_set(&(c)->scaminDirty, TRUE)
+#else
+#define SCAMIN_DIRTY(c)
+#endif
+
+// obj of this cell changed - S52_getStats() re-walk its memory
+#define MEM_DIRTY(c) g_atomic_int_set(&(c)->memDirty, TRUE)
+
 // work buffer
 #ifdef S52_USE_SUPP_LINE_OVERLAP
-static guint      _baseRCID       = 0;     // offset of "ConnectedNode" (first primitive)
-static GPtrArray *_ConnectedNodes = NULL;  // Note: ConnectedNodes rcid are random in some case (CA4579016)
-static GPtrArray *_S57Edges       = NULL;  // final segment build from ENs and CNs
+// primitive of the cell being loaded, keyed on RCID - one table per RCNM
+// Note: ConnectedNodes rcid are random in some case (CA4579016) and not continuous after update
+static GHashTable *_ConnectedNodes = NULL;  // RCNM 120: rcid --> S57_geo
+static GHashTable *_S57Edges       = NULL;  // RCNM 130: rcid --> S57_geo, final segment build from ENs and CNs
 #endif
 
 #ifdef S52_USE_C_AGGR_C_ASSO
@@ -195,6 +279,39 @@ static GPtrArray *_S57Edges       = NULL;  // final segment build from ENs and C
 static GTree     *_lnamBBT      = NULL;
 #endif  // S52_USE_C_AGGR_C_ASSO
 
+// time (msec) of each phase of the last S52_draw() / S52_drawLast() - S52_getDrawTime()
+typedef struct _drawTime_t {
+    double app;
+    double cull;
+    double draw;    // text excluded
+    double text;
+    double last;
+} _drawTime_t;
+
+// change generation of the scene - S52_needDraw() / S52_needDrawLast()
+typedef enum _gen_t {
+    _GEN_VIEW = 0,      // view, viewport
+    _GEN_MP,            // Mariners' Parameter, text display, color
+    _GEN_CELL,          // cell load / done / update, PLib
+    _GEN_CLASS,         // S57 class suppression
+    _GEN_MAROBJ,        // mariners' object drawn by S52_draw()
+    _GEN_MAROBJ_LAST,   // mariners' object drawn by S52_drawLast() (S52_PRIO_MARINR)
+    _GEN_RASTER,        // raster, RADAR
+    _GEN_N
+} _gen_t;
+static gint _gen[_GEN_N];           // bumped on change (writer lock held)
+
+// _gen at the last S52_draw() / S52_drawLast() - per context
+typedef struct _drawnGen_t {
+    gint draw[_GEN_N];
+    gint last[_GEN_N];
+    gint fb;            // TRUE - S52_draw() replaced the FB that S52_drawLast() draw on
+} _drawnGen_t;
+
+static S52_dirty_cb _dirtyCB    = NULL;
+static void        *_dirtyUData = NULL;
+static guint        _nRADAR     = 0;    // RADAR callback - new image at each draw
+
 static GPtrArray *_cellList     = NULL;    // list of loaded cells - sorted, big to small scale (small to large region)
 static _cell     *_crntCell     = NULL;    // current cell (passed around when loading --FIXME: global var (dumb))
 static _cell     *_marinerCell  = NULL;    // place holder MIO's, and other (fake) S57 object
@@ -208,6 +325,7 @@ static GString   *_paltNameList = NULL;    // string that gather palette name
 static GString   *_S57ClassList = NULL;    // string that gather cell S57 class name
 static GString   *_S52ObjNmList = NULL;    // string that gather cell S52 obj name
 static GString   *_cellNameList = NULL;    // string that gather cell name
+static GString   *_statsStr     = NULL;    // string that gather stats (JSON) - S52_getStats()
 
 static int        _doInit       = TRUE;    // init the lib
 
@@ -220,19 +338,18 @@ static int        _CULL_Lights  = FALSE;   // TRUE will do lights_sector culling
 static int        _CULL_hodata  = FALSE;   // TRUE will compute display of HODATA
 static int        _CULL_sclbdy  = FALSE;   // TRUE will compute display of SCLBDY
 
-// obj of union of all HO Data Limit
-static S52ObjectHandle _HODATAUnion = FALSE;
-// list of scale boundary reference (system generated DATCVR01-3)
-static GArray         *_sclbdyList  = NULL;
-static const guint     INTU_SEP     = 0;  // intu separator in _sclbdyList
-
-// experimental: list of sclbdU - union of obj in _sclbdyList for each INTU
+// obj of union of all HO Data Limit - one per ring (system generated DATCVR01-2)
+static GArray         *_HODATAList  = NULL;
+// sclbdy obj of unloaded cell, deleted at next _app() (system generated DATCVR01-3)
+static GArray         *_sclbdyDel   = NULL;
+// experimental: list of sclbdU - union of sclbdy for each INTU - one per ring
 static GArray         *_sclbdUList  = NULL;
+// S52_HO_getGen() of the obj in _HODATAList / _sclbdUList - atomic (read by S52_needDraw())
+static gint            _HOgen       = 0;
+// S52_HO_getGen() applied by _app() - set with the writer lock held (see _drawTryLock())
+static guint           _HOgenSnap   = 0;
 
 static char           *_intl        = NULL;    // setlocal()
-// statistic
-static guint           _nCull    = 0;
-static guint           _nTotal   = 0;
 
 // CSYMB init scale bar, north arrow, unit, CHKSYM
 static int             _iniCSYMB = TRUE;
@@ -250,11 +367,58 @@ static GPtrArray      *_rasterList  = NULL;  // list of Raster
 
 static GPtrArray      *_tmpRenderBin= NULL;  // list of obj that overide prio
 
-// callback to eglMakeCurrent() / eglSwapBuffers()
+// state of a frame - one per context of a chart view (see S52_newCtx())
+// Note: cells, PLib and mariners' object are shared by all context
+typedef struct _S52_ctx {
+#ifdef S52_USE_CTX
+    guint        id;          // 0 - default context
+    gpointer     GLctx;       // view, viewport, program, FB copy (S52GL)
+    gpointer     MPctx;       // Mariners' Parameter, text display (S52MP)
+    guint        slot;        // journal of this context in the cells (see JRNL())
+    gint         drawing;     // TRUE - a thread is drawing this context (see _drawTryLock())
+#endif
+    int          drawExcl;    // TRUE if the frame hold the writer lock
+    _drawTime_t  drawTime;
+    _drawnGen_t  drawnGen;
+    guint        nCull;       // statistic
+    guint        nTotal;
+    GTimer      *timer;
+#ifdef S52_USE_SCAMIN_BIN
+    GArray      *scaminIdx;   // index of obj not suppressed by SCAMIN
+    GPtrArray   *scaminObj;   // same obj in drawing order
+#endif
+#ifdef S52_USE_EGL
+    // callback to eglMakeCurrent() / eglSwapBuffers()
+    S52_EGL_cb   eglBeg;
+    S52_EGL_cb   eglEnd;
+    void        *EGLctx;
+#endif
+} _S52_ctx;
+
+static _S52_ctx _ctxDef;    // default context - the one of S52_init()
+
+#ifdef S52_USE_CTX
+// context of this thread (see _ctxSwitch()) - a thread only touch the state of its context
+static S52_TLS _S52_ctx *_ctxCrnt = &_ctxDef;
+#else
+#define _ctxCrnt (&_ctxDef)
+#endif
+
+#define _drawExcl   (_ctxCrnt->drawExcl)
+#define _drawTime   (_ctxCrnt->drawTime)
+#define _drawn      (&_ctxCrnt->drawnGen)
+#define _nCull      (_ctxCrnt->nCull)
+#define _nTotal     (_ctxCrnt->nTotal)
+#define _timer      (_ctxCrnt->timer)
+#ifdef S52_USE_SCAMIN_BIN
+#define _scaminIdx  (_ctxCrnt->scaminIdx)
+#define _scaminObj  (_ctxCrnt->scaminObj)
+#endif
+
 #ifdef S52_USE_EGL
-static S52_EGL_cb _eglBeg = NULL;
-static S52_EGL_cb _eglEnd = NULL;
-static void      *_EGLctx = NULL;
+#define _eglBeg     (_ctxCrnt->eglBeg)
+#define _eglEnd     (_ctxCrnt->eglEnd)
+#define _EGLctx     (_ctxCrnt->EGLctx)
 
 #define EGL_BEG(tag)    if (NULL != _eglBeg) {                    \
                            if (FALSE == _eglBeg(_EGLctx,#tag)) {  \
@@ -277,15 +441,270 @@ static void      *_EGLctx = NULL;
 // Note: the mutex never have to do work with the main_loop already serializing call.
 // Note: that DBus and socket/WebSocket are running from the main loop but the handling is done from threads
 
+// Note: _mp_mutex is a reader-writer lock - call that mutate state take the writer lock,
+// read-only query (S52_getMarinerParam(), S52_xy2LL(), ..) take the reader lock.
+// Drawing only read the scene graph so it also take the reader lock, plus _draw_mutex
+// so that only one thread draw at a time. Hence query run in parallel with rendering.
+// A frame that mutate the scene graph (_app() after a setter, stray vessel in S52_drawLast())
+// take the writer lock instead - see _drawMutate().
+// Note: with S52_USE_CTX frame of different context are drawn in parallel (GL2),
+// one frame at a time per context - GL1 and SW still take _draw_mutex.
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticRWLock _mp_mutex   = G_STATIC_RW_LOCK_INIT;
+static GStaticMutex  _draw_mutex = G_STATIC_MUTEX_INIT;
+static GStaticMutex  _str_mutex  = G_STATIC_MUTEX_INIT;
+static GStaticMutex  _cb_mutex   = G_STATIC_MUTEX_INIT;
+#define GMUTEXLOCK     g_static_rw_lock_writer_lock
+#define GMUTEXUNLOCK   g_static_rw_lock_writer_unlock
+#define GMUTEXTRYLOCK  g_static_rw_lock_writer_trylock
+#define GREADLOCK      g_static_rw_lock_reader_lock
+#define GREADUNLOCK    g_static_rw_lock_reader_unlock
+#define GREADTRYLOCK   g_static_rw_lock_reader_trylock
+#define GDRAWLOCK      g_static_mutex_lock
+#define GDRAWTRYLOCK   g_static_mutex_trylock
+#define GDRAWUNLOCK    g_static_mutex_unlock
+#define GSTRLOCK       g_static_mutex_lock
+#define GSTRUNLOCK     g_static_mutex_unlock
+#define GCBLOCK        g_static_mutex_lock
+#define GCBUNLOCK      g_static_mutex_unlock
+#if defined(S52_USE_CTX) && defined(S52_USE_SCAMIN_BIN)
+static GStaticMutex  _scamin_mutex = G_STATIC_MUTEX_INIT;
+#define GSCAMINLOCK    g_static_mutex_lock
+#define GSCAMINUNLOCK  g_static_mutex_unlock
+#endif
+#else
+static GRWLock       _mp_mutex;
+static GMutex        _draw_mutex;
+static GMutex        _str_mutex;
+static GMutex        _cb_mutex;     // _dirtyCB - also called from the HO thread (see _HOpublish())
+#define GMUTEXLOCK     g_rw_lock_writer_lock
+#define GMUTEXUNLOCK   g_rw_lock_writer_unlock
+#define GMUTEXTRYLOCK  g_rw_lock_writer_trylock
+#define GREADLOCK      g_rw_lock_reader_lock
+#define GREADUNLOCK    g_rw_lock_reader_unlock
+#define GREADTRYLOCK   g_rw_lock_reader_trylock
+#define GDRAWLOCK      g_mutex_lock
+#define GDRAWTRYLOCK   g_mutex_trylock
+#define GDRAWUNLOCK    g_mutex_unlock
+#define GSTRLOCK       g_mutex_lock
+#define GSTRUNLOCK     g_mutex_unlock
+#define GCBLOCK        g_mutex_lock
+#define GCBUNLOCK      g_mutex_unlock
+#if defined(S52_USE_CTX) && defined(S52_USE_SCAMIN_BIN)
+static GMutex        _scamin_mutex;  // scaminBin rebuilt by the first frame that cull the cell
+#define GSCAMINLOCK    g_mutex_lock
+#define GSCAMINUNLOCK  g_mutex_unlock
+#endif
+#endif
+
+static int        _newJrnl(_jrnl_t *j)
+// journal - obj ref, no free_func()
+{
+    j->objList_supp = g_ptr_array_new();
+    j->objList_over = g_ptr_array_new();
+    j->textList     = g_ptr_array_new();
+
+    return TRUE;
+}
+
+static int        _delJrnl(_jrnl_t *j)
+{
+    g_ptr_array_free(j->textList,      TRUE);
+    g_ptr_array_free(j->objList_supp,  TRUE);
+    g_ptr_array_free(j->objList_over,  TRUE);
+
+    return TRUE;
+}
+
+static int        _resetJrnl(_jrnl_t *j)
+{
+    g_ptr_array_set_size(j->objList_supp, 0);
+    g_ptr_array_set_size(j->objList_over, 0);
+    g_ptr_array_set_size(j->textList,     0);
+
+    return TRUE;
+}
+
+#ifdef S52_USE_CTX
+static GPtrArray *_ctxList    = NULL;  // all context - [0] is the default context
+static guint      _ctxID      = 0;     // last context id - trace
+static guint      _ctxSlotN   = 1;     // journal per cell (see JRNL())
+static double     _csKey[S52_MP_CSKEY_NUM];  // MP of the CS of the shared obj (see _app())
+
+// context bound to a thread (S52_setCtx()) - NULL is the default context
 #if (defined(S52_USE_ANDROID) || defined(_MINGW))
-static GStaticMutex  _mp_mutex = G_STATIC_MUTEX_INIT;
-#define GMUTEXLOCK   g_static_mutex_lock
-#define GMUTEXUNLOCK g_static_mutex_unlock
+static GStaticPrivate _ctxThread = G_STATIC_PRIVATE_INIT;
+#define CTXGET(key)      g_static_private_get(key)
+#define CTXSET(key, ctx) g_static_private_set(key, ctx, NULL)
+#else
+static GPrivate       _ctxThread = G_PRIVATE_INIT(NULL);
+#define CTXGET(key)      g_private_get(key)
+#define CTXSET(key, ctx) g_private_set(key, ctx)
+#endif
+
+// GL1 and SW render state is global - one frame at a time
+#if (defined(S52_USE_GL2) || defined(S52_USE_GLES2) || defined(S52_USE_GLSC2)) && !defined(S52_USE_SW)
+#define CTX_DRAWLOCK
+#define CTX_DRAWUNLOCK
+#else
+#define CTX_DRAWLOCK     GDRAWLOCK(&_draw_mutex);
+#define CTX_DRAWUNLOCK   GDRAWUNLOCK(&_draw_mutex);
+#endif
+
+// journal of the current context
+#define JRNL(c)          (&g_array_index((c)->jrnl, _jrnl_t, _ctxCrnt->slot))
+
+static int        _ctxSlot(void)
+// first slot not used by a context - call with _mp_mutex held (writer)
+{
+    for (guint slot=0; ; ++slot) {
+        guint i = 0;
+        for (i=0; i<_ctxList->len; ++i) {
+            if (slot == ((_S52_ctx*)g_ptr_array_index(_ctxList, i))->slot)
+                break;
+        }
+        if (i == _ctxList->len)
+            return slot;
+    }
+
+    return 0;
+}
+
+static int        _setJrnl(GArray *jrnl, guint n)
+// journal of cell for n context
+{
+    for (guint k=jrnl->len; k<n; ++k) {
+        _jrnl_t j;
+        _newJrnl(&j);
+        g_array_append_val(jrnl, j);
+    }
+
+    return TRUE;
+}
+
+static _S52_ctx  *_newCtx(void)
+// copy of the current state - call with _mp_mutex held (writer)
+{
+    _S52_ctx *ctx = g_new0(_S52_ctx, 1);
+
+    ctx->GLctx     = S52_GL_newCtx();
+    ctx->MPctx     = S52_MP_newCtx();
+    ctx->slot      = _ctxSlot();
+    ctx->drawTime  = _drawTime;
+    ctx->drawnGen  = *_drawn;
+    ctx->timer     = g_timer_new();
+#ifdef S52_USE_SCAMIN_BIN
+    ctx->scaminIdx = g_array_new(FALSE, FALSE, sizeof(guint));
+    ctx->scaminObj = g_ptr_array_new();
+#endif
+#ifdef S52_USE_EGL
+    ctx->eglBeg    = _eglBeg;
+    ctx->eglEnd    = _eglEnd;
+    ctx->EGLctx    = _EGLctx;
+#endif
+
+    // one more journal in each cell
+    if (ctx->slot >= _ctxSlotN) {
+        _ctxSlotN = ctx->slot + 1;
+        for (guint i=0; i<_cellList->len; ++i) {
+            _cell *c = (_cell*) g_ptr_array_index(_cellList, i);
+            _setJrnl(c->jrnl, _ctxSlotN);
+        }
+    }
+
+    return ctx;
+}
+
+static int        _delCtx(_S52_ctx *ctx)
+// call with _mp_mutex held (writer)
+{
+    // drop obj ref of this context - the slot is reused by the next context
+    for (guint i=0; i<_cellList->len; ++i) {
+        _cell   *c = (_cell*) g_ptr_array_index(_cellList, i);
+        _resetJrnl(&g_array_index(c->jrnl, _jrnl_t, ctx->slot));
+    }
+
+    S52_GL_delCtx(ctx->GLctx);
+    S52_MP_delCtx(ctx->MPctx);
+    g_timer_destroy(ctx->timer);
+#ifdef S52_USE_SCAMIN_BIN
+    g_array_free(ctx->scaminIdx, TRUE);
+    g_ptr_array_free(ctx->scaminObj, TRUE);
+#endif
+    g_free(ctx);
+
+    return TRUE;
+}
+
+static int        _ctxCSKey(void)
+// TRUE if the current context use other MP for CS than the one of the last _app()
+{
+    double key[S52_MP_CSKEY_NUM];
+    S52_MP_getCSKey(key);
+
+    return (0 != memcmp(key, _csKey, sizeof(key)));
+}
+
+static int        _ctxSwitch(int writer)
+// make the context of this thread current - call with _mp_mutex held
+// Note: only set the thread local pointer to the state of the context (S52GL, S52MP)
+{
+    // before S52_init()
+    if (NULL == _ctxList)
+        return FALSE;
+
+    _S52_ctx *ctx = (_S52_ctx*) CTXGET(&_ctxThread);
+    if (NULL == ctx)
+        ctx = &_ctxDef;
+
+    if (&_ctxDef != ctx) {
+        // ctx deleted by an other thread
+        // Note: the list of context only change with the writer lock
+        guint i = 0;
+        for (i=0; i<_ctxList->len; ++i) {
+            if (ctx == g_ptr_array_index(_ctxList, i))
+                break;
+        }
+        if (i == _ctxList->len) {
+            PRINTF("WARNING: context of this thread deleted, fall back to default context\n");
+            CTXSET(&_ctxThread, NULL);
+            ctx = &_ctxDef;
+        }
+    }
+
+    _ctxCrnt = ctx;
+    S52_GL_loadCtx(ctx->GLctx);
+    S52_MP_loadCtx(ctx->MPctx);
+
+    // CS of the shared object depend on MP - resolve again only
+    // if this context use other MP than the one of the last _app()
+    if ((TRUE==writer) && (TRUE==_ctxCSKey())) {
+        _APP_CS     = TRUE;
+        _APP_RASTER = TRUE;
+    }
+
+    return TRUE;
+}
+#define S52_CTX_SWITCH   _ctxSwitch(TRUE);
+#define S52_CTX_READ     _ctxSwitch(FALSE);
+#else   // S52_USE_CTX
+#define JRNL(c)          (&(c)->jrnl)
+#define S52_CTX_SWITCH
+#define S52_CTX_READ
+#endif  // S52_USE_CTX
+
+#ifdef S52_USE_RENDER_THREAD
+#ifdef S52_USE_CTX
+#define RT_CTX  CTXGET(&_ctxThread)   // the render thread draw the context of the caller
 #else
-static GMutex        _mp_mutex;
-#define GMUTEXLOCK   g_mutex_lock
-#define GMUTEXUNLOCK g_mutex_unlock
+#define RT_CTX  NULL
 #endif
+#endif
+// read state of the context of this thread (current - switched by S52_CHECK_READ)
+#define RD_MP            NULL
+#define RD_GL            NULL
+#define RD_DRAWN         _drawn
+#define RD_TIME(t,c,n)   {*(t)=_drawTime; *(c)=_nCull; *(n)=_nTotal;}
 
 
 // check basic init
@@ -293,9 +712,261 @@ static GMutex        _mp_mutex;
                            PRINTF("WARNING: libS52 not initialized --call S52_init() first\n"); \
                            goto exit;                                                           \
                         }
-#define S52_CHECK_MUTX                   GMUTEXLOCK(&_mp_mutex);
-#define S52_CHECK_MUTX_INIT              GMUTEXLOCK(&_mp_mutex); S52_CHECK_INIT
-#define S52_CHECK_MUTX_INIT_EGLBEG(tag)  GMUTEXLOCK(&_mp_mutex); S52_CHECK_INIT EGL_BEG(tag)
+#define S52_CHECK_MUTX                   GMUTEXLOCK(&_mp_mutex); S52_CTX_SWITCH
+#define S52_CHECK_MUTX_INIT              GMUTEXLOCK(&_mp_mutex); S52_CTX_SWITCH S52_CHECK_INIT
+#define S52_CHECK_MUTX_INIT_EGLBEG(tag)  GMUTEXLOCK(&_mp_mutex); S52_CTX_SWITCH S52_CHECK_INIT EGL_BEG(tag)
+
+// Note: query only switch the thread local pointer to the state of their context
+#define S52_CHECK_READ                   GREADLOCK(&_mp_mutex); S52_CTX_READ
+#define S52_CHECK_READ_INIT              GREADLOCK(&_mp_mutex); S52_CTX_READ S52_CHECK_INIT
+#define S52_READ_UNLOCK                  GREADUNLOCK(&_mp_mutex)
+
+static int        _drawMutate(int last)
+// TRUE if this frame will mutate the scene graph (rare - after a setter or a new HO union)
+{
+    // the HO thread publish at any time - _app() apply union up to _HOgenSnap
+    // (set once the writer lock is held)
+    guint HOgen = S52_HO_getGen();
+
+    // _delOldVessel()
+    if (TRUE == last)
+        return (0.0 != S52_MP_get(S52_MAR_DISP_VESSEL_DELAY));
+
+#ifdef S52_USE_CTX
+    // CS of the shared object resolved with the MP of an other context
+    if (TRUE == _ctxCSKey())
+        return TRUE;
+#endif
+
+#ifdef S52_USE_CHART_MANAGER
+    // S52_CM_unload() - free cell
+    if (TRUE == S52_CM_needUnload())
+        return TRUE;
+#endif
+
+    // _app() - CS, new HO Data Limit / sclbdy object, ..
+    if ((TRUE==_APP_CS) || (TRUE==_APP_DATCVR) || (TRUE==_APP_RASTER) || ((guint)_HOgen!=HOgen))
+        return TRUE;
+
+    // _cull*()
+    if ((TRUE==_CULL_Lights) || (TRUE==_CULL_hodata) || (TRUE==_CULL_sclbdy))
+        return TRUE;
+
+    return FALSE;
+}
+
+static int        _drawWait(void)
+// TRUE if this thread wait for the lock instead of skipping the frame
+{
+#ifdef S52_USE_RENDER_THREAD
+    // the render thread (S52_drawAsync()) - no host loop to return to
+    if (TRUE == S52_RT_isRT())
+        return TRUE;
+#endif
+
+#ifdef S52_USE_CTX
+    // context of S52_newCtx() - a render thread of a chart view (ex: tile),
+    // the default context is the one of the host loop
+    if (NULL != CTXGET(&_ctxThread))
+        return TRUE;
+#endif
+
+    return FALSE;
+}
+
+static int        _drawTryLock(int last)
+// do not wait if an other thread is allready drawing
+// (S52_USE_CTX: this context - GL1 and SW wait for the frame of an other context,
+//  render state is global so their context serialise draw)
+// Note: the render thread wait for a writer (see _drawWait())
+// return TRUE if the lock is taken
+{
+    int wait = _drawWait();
+
+#ifdef S52_USE_CTX
+    // the frame of an other context is not this frame - wait for it (GL1, SW)
+    CTX_DRAWLOCK
+
+    // a writer hold the scene graph
+    if (TRUE == wait) {
+        GREADLOCK(&_mp_mutex);
+    } else {
+        if (FALSE == GREADTRYLOCK(&_mp_mutex)) {
+            CTX_DRAWUNLOCK
+            return FALSE;
+        }
+    }
+
+    // Note: only set the thread local pointer - other context draw in parallel
+    _ctxSwitch(FALSE);
+
+    // an other thread is allready drawing this context
+    if (FALSE == g_atomic_int_compare_and_exchange(&_ctxCrnt->drawing, FALSE, TRUE)) {
+        GREADUNLOCK(&_mp_mutex);
+        CTX_DRAWUNLOCK
+        return FALSE;
+    }
+#else
+    if (TRUE == wait) {
+        GDRAWLOCK(&_draw_mutex);
+        GREADLOCK(&_mp_mutex);
+    } else {
+        if (FALSE == GDRAWTRYLOCK(&_draw_mutex))
+            return FALSE;
+
+        // a writer hold the scene graph
+        if (FALSE == GREADTRYLOCK(&_mp_mutex)) {
+            GDRAWUNLOCK(&_draw_mutex);
+            return FALSE;
+        }
+    }
+#endif
+
+    // no lock upgrade - drop the reader lock and wait for the writer lock
+    // (frame that mutate are rare, query are short)
+    _drawExcl = _drawMutate(last);
+    if (TRUE == _drawExcl) {
+        GREADUNLOCK(&_mp_mutex);
+        GMUTEXLOCK(&_mp_mutex);
+
+        // a writer of an other context might have come in between
+        S52_CTX_SWITCH
+
+        _HOgenSnap = S52_HO_getGen();
+    }
+
+    return TRUE;
+}
+
+static int        _needDrawHO(void)
+// TRUE if the HO thread published a union not yet applied by _app()
+{
+    return (S52_HO_getGen() != (guint)g_atomic_int_get(&_HOgen));
+}
+
+static int        _needDrawGen(const _drawnGen_t *drawn)
+// TRUE if a generation drawn by S52_draw() changed since the last S52_draw()
+{
+    if (0 < _nRADAR)
+        return TRUE;
+
+    for (int i=0; i<_GEN_N; ++i) {
+        if (_GEN_MAROBJ_LAST == i)
+            continue;
+        if (g_atomic_int_get(&_gen[i]) != g_atomic_int_get(&drawn->draw[i]))
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+static int        _needDraw(const _drawnGen_t *drawn)
+// TRUE if something drawn by S52_draw() changed since the last S52_draw()
+{
+    // new HO Data Limit / scale boundary - applied by a frame holding the writer lock
+    if (TRUE == _needDrawHO())
+        return TRUE;
+
+    return _needDrawGen(drawn);
+}
+
+static int        _needDrawLast(const _drawnGen_t *drawn)
+// TRUE if anything changed since the last S52_drawLast()
+// (a new S52_draw() need a S52_drawLast() on top)
+{
+    if (0 < _nRADAR)
+        return TRUE;
+
+    if (TRUE == g_atomic_int_get(&drawn->fb))
+        return TRUE;
+
+    if (TRUE == _needDrawHO())
+        return TRUE;
+
+    for (int i=0; i<_GEN_N; ++i) {
+        if (g_atomic_int_get(&_gen[i]) != g_atomic_int_get(&drawn->last[i]))
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+static void       _drawnSnap(gint *drawn)
+{
+    for (int i=0; i<_GEN_N; ++i)
+        g_atomic_int_set(&drawn[i], g_atomic_int_get(&_gen[i]));
+}
+
+static void       _dirty(_gen_t gen)
+// bump generation - call with _mp_mutex held (writer, or reader: S52_setView() of a context)
+{
+    // Note: under _cb_mutex - the clean --> dirty transition is seen once
+    GCBLOCK(&_cb_mutex);
+
+    int needDraw     = _needDraw    (_drawn);
+    int needDrawLast = _needDrawLast(_drawn);
+
+    g_atomic_int_inc(&_gen[gen]);
+
+    if (NULL != _dirtyCB) {
+        // signal the transition clean --> dirty only
+        if ((FALSE==needDraw) && (TRUE==_needDraw(_drawn))) {
+            _dirtyCB(_dirtyUData, FALSE);
+        } else {
+            if ((FALSE==needDrawLast) && (TRUE==_needDrawLast(_drawn)))
+                _dirtyCB(_dirtyUData, TRUE);
+        }
+    }
+    GCBUNLOCK(&_cb_mutex);
+}
+
+static void       _HOpublish(guint gen)
+// HO thread - new union published, the scene is dirty until _app() apply it
+// Note: no _mp_mutex here - S52_done() hold it while joining the HO thread
+{
+    GCBLOCK(&_cb_mutex);
+    if (NULL != _dirtyCB) {
+        // signal the transition clean --> dirty only (previous union allready applied)
+        if ((gen-1==(guint)g_atomic_int_get(&_HOgen)) && (FALSE==_needDrawGen(_drawn)))
+            _dirtyCB(_dirtyUData, FALSE);
+    }
+    GCBUNLOCK(&_cb_mutex);
+}
+
+static void       _dirtyObj(S52_obj *obj)
+// mariners' object change - layer 9 (S52_PRIO_MARINR) is drawn by S52_drawLast()
+{
+    if (NULL == obj)
+        return;
+
+    if (S52_PRIO_MARINR == S52_PL_getDPRI(obj))
+        _dirty(_GEN_MAROBJ_LAST);
+    else
+        _dirty(_GEN_MAROBJ);
+}
+
+static int        _drawUnlock(void)
+{
+    int excl  = _drawExcl;
+    _drawExcl = FALSE;
+
+#ifdef S52_USE_CTX
+    g_atomic_int_set(&_ctxCrnt->drawing, FALSE);
+#endif
+
+    if (TRUE == excl)
+        GMUTEXUNLOCK(&_mp_mutex);
+    else
+        GREADUNLOCK(&_mp_mutex);
+
+#ifdef S52_USE_CTX
+    CTX_DRAWUNLOCK
+#else
+    GDRAWUNLOCK(&_draw_mutex);
+#endif
+
+    return TRUE;
+}
 
 // traverse Render Bin and call func1() on each bin
 #define TRAV_RBIN_ij(func1)                                    \
@@ -352,13 +1023,22 @@ DLL double STD S52_getMarinerParam(S52MarinerParameter paramID)
 // return Mariner parameter or the value in S52_MAR_ERROR if fail
 // FIXME: check mariner param against groups selection
 {
-    S52_CHECK_MUTX;
+    S52_TR_CALL(S52_TR_getMarinerParam, "i", paramID);
+
+#ifdef S52_USE_RENDER_THREAD
+    // staged for the next frame
+    double stage = 0.0;
+    if (TRUE == S52_RT_getMP(RT_CTX, paramID, &stage))
+        return stage;
+#endif
 
-    double val = S52_MP_get(paramID);
+    S52_CHECK_READ;
+
+    double val = S52_MP_getCtx(RD_MP, paramID);
 
     PRINTF("NOTE: paramID:%i, val:%f\n", paramID, val);
 
-    GMUTEXUNLOCK(&_mp_mutex);
+    S52_READ_UNLOCK;
 
     return val;
 }
@@ -366,6 +1046,14 @@ DLL double STD S52_getMarinerParam(S52MarinerParameter paramID)
 DLL int    STD S52_setMarinerParam(S52MarinerParameter paramID, double val)
 // validate and set Mariner Parameter
 {
+    S52_TR_CALL(S52_TR_setMarinerParam, "id", paramID, val);
+
+#ifdef S52_USE_RENDER_THREAD
+    // render thread on - stage it for the next frame, don't wait for the frame being drawn
+    if ((S52_MAR_ERROR<=paramID) && (paramID<S52_MAR_NUM) && (TRUE==S52_RT_setMP(RT_CTX, paramID, val)))
+        return TRUE;
+#endif
+
     S52_CHECK_MUTX;
 
     PRINTF("NOTE: paramID:%i, val:%f\n", paramID, val);
@@ -401,6 +1089,8 @@ DLL int    STD S52_setMarinerParam(S52MarinerParameter paramID, double val)
         return FALSE;
     }
 
+    _dirty(_GEN_MP);
+
     // set APP() / CULL() flags
     switch (paramID) {
         // _SNDFRM02->OBSTRN04, WRECKS02;
@@ -483,11 +1173,15 @@ DLL int    STD S52_setMarinerParam(S52MarinerParameter paramID, double val)
 
 DLL int    STD S52_setTextDisp(unsigned int prioIdx, unsigned int count, unsigned int state)
 {
+    S52_TR_CALL(S52_TR_setTextDisp, "uuu", prioIdx, count, state);
+
     S52_CHECK_MUTX;
 
     //state = _validate_bool(state);
 
     int ret = S52_MP_setTextDisp(prioIdx, count, state);
+    if (TRUE == ret)
+        _dirty(_GEN_MP);
 
     GMUTEXUNLOCK(&_mp_mutex);
 
@@ -496,11 +1190,13 @@ DLL int    STD S52_setTextDisp(unsigned int prioIdx, unsigned int count, unsigne
 
 DLL int    STD S52_getTextDisp(unsigned int prioIdx)
 {
-    S52_CHECK_MUTX;
+    S52_TR_CALL(S52_TR_getTextDisp, "u", prioIdx);
 
-    int ret = S52_MP_getTextDisp(prioIdx);
+    S52_CHECK_READ;
 
-    GMUTEXUNLOCK(&_mp_mutex);
+    int ret = S52_MP_getTextDispCtx(RD_MP, prioIdx);
+
+    S52_READ_UNLOCK;
 
     return ret;
 }
@@ -565,15 +1261,28 @@ static _cell     *_newCell(const char *filename)
 
         cell->local = S52_CS_init();
 
-        // journal - obj ref, no free_func()
-        cell->objList_supp = g_ptr_array_new();
-        cell->objList_over = g_ptr_array_new();
-        cell->textList     = g_ptr_array_new();
-
+        // journal - one per context
+#ifdef S52_USE_CTX
+        cell->jrnl = g_array_new(FALSE, FALSE, sizeof(_jrnl_t));
+        _setJrnl(cell->jrnl, _ctxSlotN);
+#else
+        _newJrnl(&cell->jrnl);
+#endif
+
         cell->S57ClassList = g_string_new("");
 
         cell->projDone     = FALSE;
 
+        cell->hoDirty      = TRUE;
+        cell->m_covr       = g_ptr_array_new();
+        cell->sclbdGeo     = g_ptr_array_new();
+        cell->sclbdyH      = g_array_new(FALSE, FALSE, sizeof(S52ObjectHandle));
+
+#ifdef S52_USE_SCAMIN_BIN
+        cell->scaminDirty  = TRUE;
+#endif
+        cell->memDirty     = TRUE;
+
         /*
         cell->DEPARElist = g_ptr_array_new();
         cell->DEPCNTlist = g_ptr_array_new();
@@ -608,20 +1317,45 @@ static void       _delObj(S52_obj *obj)
 
 static void       _freeCell(_cell *c)
 {
+#ifdef S52_USE_ARENA
+    // geo and coords of this cell are unmapped at the end - not freed obj by obj
+    if (NULL != c->arena)
+        S57_closeArena(c->arena);
+#endif
+
+    // HO data limit / scale boundary - remove from union
+    if (TRUE == c->hoData)
+        S52_HO_delCov(S52_HO_HODATA, c);
+    if (0 != c->hoTree)
+        S52_HO_delCov(c->hoTree, c);
+    if (NULL != _sclbdyDel)
+        g_array_append_vals(_sclbdyDel, c->sclbdyH->data, c->sclbdyH->len);
+    g_ptr_array_free(c->m_covr,   TRUE);
+    g_ptr_array_free(c->sclbdGeo, TRUE);
+    g_array_free    (c->sclbdyH,  TRUE);
+
     if (NULL != c->filename)
         g_string_free(c->filename, TRUE);
     g_free(c->encPath);
 
     TRAV_RBIN_ij(g_ptr_array_free(c->renderBin[i][j], TRUE));
 
+#ifdef S52_USE_SCAMIN_BIN
+    TRAV_RBIN_ij(if (NULL != c->scaminBin[i][j]) g_array_free(c->scaminBin[i][j], TRUE));
+#endif
+
     S52_CS_done(c->local);
 
     g_ptr_array_free(c->lights_sector, TRUE);
 
     // Note: all bellow are ref to obj - no free_func / _delObj() on array
-    g_ptr_array_free(c->textList,      TRUE);
-    g_ptr_array_free(c->objList_supp,  TRUE);
-    g_ptr_array_free(c->objList_over,  TRUE);
+#ifdef S52_USE_CTX
+    for (guint k=0; k<c->jrnl->len; ++k)
+        _delJrnl(&g_array_index(c->jrnl, _jrnl_t, k));
+    g_array_free(c->jrnl, TRUE);
+#else
+    _delJrnl(&c->jrnl);
+#endif
 
     /*
     if (NULL != c->DEPARElist)   g_ptr_array_free(c->DEPARElist, TRUE);
@@ -633,6 +1367,12 @@ static void       _freeCell(_cell *c)
 
     g_string_free(c->S57ClassList, TRUE);
 
+#ifdef S52_USE_ARENA
+    // all geo of this cell are done - unmap the lot
+    if (NULL != c->arena)
+        S57_doneArena(c->arena);
+#endif
+
     g_free(c);
 
     //return TRUE;
@@ -1063,6 +1803,11 @@ static int        _initPROJview(void)
         return TRUE;
 
     ObjExt_t ext = _getCellsExt();
+#ifdef S52_USE_CHART_MANAGER
+    // no cell loaded yet - use the extent of the catalogue
+    if (TRUE == S52_CM_isInit())
+        S52_CM_getExt(&ext);
+#endif
     double cLat  =  (ext.N + ext.S) / 2.0;
     double cLon  =  (ext.W + ext.E) / 2.0;
     double rNM   = ((ext.N - ext.S) / 2.0) * 60.0;
@@ -1091,8 +1836,59 @@ static int        _initPROJview(void)
 
 //void (*GFunc) (gpointer data, gpointer user_data);
 static void       _S57_geo2prj(S52_obj *obj, gpointer dummy) {(void)dummy; S57_geo2prj(S52PLGETGEO(obj));}
+static void       _S57_setCenter(gpointer geo, gpointer dummy) {(void)dummy; S57_setCenter((S57_geo*)geo);}
+static void       _addCenter(S52_obj *obj, GPtrArray *geoCenter)
+// area that can have a centred symbol or text
+{
+    S57_geo *geo = S52PLGETGEO(obj);
+    if (S57_AREAS_T != S57_getObjtype(geo))
+        return;
+
+    const char *cmd = S52_PL_getCMDstr(obj);
+    if (NULL == cmd)
+        return;
+
+    // CS may add SY / TX
+    if ((NULL!=strstr(cmd, "SY(")) || (NULL!=strstr(cmd, "TX(")) ||
+        (NULL!=strstr(cmd, "TE(")) || (NULL!=strstr(cmd, "CS(")))
+        g_ptr_array_add(geoCenter, geo);
+
+    return;
+}
+
+static int        _setCenter(GPtrArray *geoCenter)
+// visual centre of area, one geo per job - not in S52_draw()
+{
+    if (0 == geoCenter->len)
+        return TRUE;
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+    int nThread = 4;  // FIXME: no g_get_num_processors() in glib < 2.36
+#else
+    int nThread = (int)g_get_num_processors();
+#endif
+
+    GThreadPool *pool = g_thread_pool_new(_S57_setCenter, NULL, nThread, TRUE, NULL);
+    if (NULL == pool) {
+        g_ptr_array_foreach(geoCenter, _S57_setCenter, NULL);
+        return TRUE;
+    }
+
+    for (guint i=0; i<geoCenter->len; ++i)
+        g_thread_pool_push(pool, g_ptr_array_index(geoCenter, i), NULL);
+
+    // wait all
+    g_thread_pool_free(pool, FALSE, TRUE);
+
+    PRINTF("DEBUG: %i area centre (%i thread)\n", geoCenter->len, nThread);
+
+    return TRUE;
+}
+
 static int        _projectCells(void)
 {
+    GPtrArray *geoCenter = g_ptr_array_new();
+
     for (guint k=0; k<_cellList->len; ++k) {
         _cell *c = (_cell*) g_ptr_array_index(_cellList, k);
         if (FALSE == c->projDone) {
@@ -1100,10 +1896,17 @@ static int        _projectCells(void)
 
             g_ptr_array_foreach(c->lights_sector, (GFunc)_S57_geo2prj, NULL);
 
+            // PRJ coord - centre of area
+            TRAV_RBIN_ij(g_ptr_array_foreach(c->renderBin[i][j], (GFunc)_addCenter, geoCenter));
+
             c->projDone = TRUE;
         }
     }
 
+    _setCenter(geoCenter);
+
+    g_ptr_array_free(geoCenter, TRUE);
+
     return TRUE;
 }
 
@@ -1121,9 +1924,35 @@ static int        _collect_CS_touch(_cell* c)
     return TRUE;
 }
 
+#ifdef S52_USE_CFG_WATCH
+static void       _cfgMP(CCHAR *label, CCHAR *value, void *user_data)
+// s52.cfg label S52_MAR_* (ex "S52_MAR_SAFETY_CONTOUR 10.0") --> S52_setMarinerParam()
+{
+    (void)user_data;
+
+    S52MarinerParameter paramID = S52_MP_getID(label);
+    if (S52_MAR_ERROR == paramID)
+        return;
+
+    char  *end = NULL;
+    double val = g_ascii_strtod(value, &end);
+    if ((end==value) || ('\0'!=*end)) {
+        PRINTF("WARNING: %s: not a number (%s)\n", label, value);
+        return;
+    }
+
+    // not traced - replay apply s52.cfg itself
+    S52_TR_INTERNAL(TRUE);
+    S52_setMarinerParam(paramID, val);
+    S52_TR_INTERNAL(FALSE);
+}
+#endif
+
 DLL int    STD S52_init(int screen_pixels_w, int screen_pixels_h, int screen_mm_w, int screen_mm_h, S52_log_cb log_cb)
 // init basic stuff (outside of the main loop)
 {
+    S52_TR_CALL(S52_TR_init, "iiii", screen_pixels_w, screen_pixels_h, screen_mm_w, screen_mm_h);
+
     //libS52Zdso();
 
     // check if init already done
@@ -1164,6 +1993,13 @@ DLL int    STD S52_init(int screen_pixels_w, int screen_pixels_h, int screen_mm_
     //
     _initSIG();
 
+#ifdef S52_USE_CTX
+    // this thread draw the default context (until S52_setCtx())
+    _ctxCrnt = &_ctxDef;
+    S52_GL_loadCtx(S52_GL_defCtx());
+    S52_MP_loadCtx(S52_MP_defCtx());
+#endif
+
     ///////////////////////////////////////////////////////////
     // init global info
     //
@@ -1173,6 +2009,8 @@ DLL int    STD S52_init(int screen_pixels_w, int screen_pixels_h, int screen_mm_
         _paltNameList = g_string_new("");
     if (NULL == _cellNameList)
         _cellNameList = g_string_new("");
+    if (NULL == _statsStr)
+        _statsStr = g_string_new("");
     if (NULL == _S57ClassList)
         _S57ClassList = g_string_new("");
     if (NULL == _S52ObjNmList)
@@ -1262,13 +2100,29 @@ DLL int    STD S52_init(int screen_pixels_w, int screen_pixels_h, int screen_mm_
     if (NULL == _tmpRenderBin)
         _tmpRenderBin = g_ptr_array_new();
 
-    // scale boudary
-    if (NULL == _sclbdyList)
-        _sclbdyList = g_array_new(FALSE, FALSE, sizeof(unsigned int));
+#ifdef S52_USE_SCAMIN_BIN
+    if (NULL == _scaminIdx)
+        _scaminIdx = g_array_new(FALSE, FALSE, sizeof(guint));
+    if (NULL == _scaminObj)
+        _scaminObj = g_ptr_array_new();
+#endif
+
+    // HO data limit
+    if (NULL == _HODATAList)
+        _HODATAList = g_array_new(FALSE, FALSE, sizeof(S52ObjectHandle));
+
+    // scale boudary of unloaded cell
+    if (NULL == _sclbdyDel)
+        _sclbdyDel  = g_array_new(FALSE, FALSE, sizeof(S52ObjectHandle));
 
     // scale boudary Union List
     if (NULL == _sclbdUList)
-        _sclbdUList = g_array_new(FALSE, FALSE, sizeof(unsigned int));
+        _sclbdUList = g_array_new(FALSE, FALSE, sizeof(S52ObjectHandle));
+
+    // union of HO data limit / scale boudary (thread)
+    S52_HO_init(_HOpublish);
+    _HOgenSnap = S52_HO_getGen();
+    g_atomic_int_set(&_HOgen, _HOgenSnap);
 
 
     ///////////////////////////////////////////////////////////
@@ -1301,16 +2155,51 @@ DLL int    STD S52_init(int screen_pixels_w, int screen_pixels_h, int screen_mm_
 
     _timer =  g_timer_new();
 
+    // first frame
+    _dirty(_GEN_VIEW);
+
+#ifdef S52_USE_CTX
+    // default context
+    _ctxList       = g_ptr_array_new();
+    _ctxDef.id     = 0;
+    _ctxDef.slot   = 0;
+    _ctxDef.GLctx  = S52_GL_defCtx();
+    _ctxDef.MPctx  = S52_MP_defCtx();
+    _ctxID         = 0;
+    g_ptr_array_add(_ctxList, &_ctxDef);
+    S52_MP_getCSKey(_csKey);
+#endif
+
     _doInit = FALSE;
 
+#ifdef S52_USE_CFG_WATCH
+    // Mariners' Parameter in s52.cfg, then live on change
+    S52_utils_loadConfig (_cfgMP, NULL);
+    S52_utils_watchConfig(_cfgMP, NULL);
+#endif
 
     PRINTF("S52_INIT() .. DONE\n");
 
     return TRUE;
 }
 
+DLL int    STD S52_setLogLevel(S52_logLevel level)
+{
+    S52_TR_CALL(S52_TR_setLogLevel, "i", level);
+
+    // no lock - atomic
+#if defined(S52_DEBUG) || defined(S52_USE_LOGFILE)
+    return S52_utils_setLogLevel(level);
+#else
+    (void)level;
+    return FALSE;
+#endif
+}
+
 DLL CCHAR *STD S52_version(void)
 {
+    S52_TR_CALL(S52_TR_version, "");
+
     PRINTF("%s\n", S52_utils_version());
 
     return S52_utils_version();
@@ -1319,18 +2208,58 @@ DLL CCHAR *STD S52_version(void)
 DLL int    STD S52_done(void)
 // clear all - shutdown libS52
 {
+    S52_TR_CALL(S52_TR_done, "");
+
+#ifdef S52_USE_CHART_MANAGER
+    // Note: before lock - the CM thread might be waiting on it
+    S52_CM_done();
+#endif
+
+#ifdef S52_USE_RENDER_THREAD
+    // Note: before lock - pending frame need it
+    S52_RT_done();
+#endif
+
+    // Note: before lock - the cfg watch thread might be in S52_setMarinerParam()
+    S52_utils_doneConfig();
+
     S52_CHECK_MUTX_INIT;
 
+#ifdef S52_USE_CTX
+    // back to the default context - S52_GL_done() free it
+    CTXSET(&_ctxThread, NULL);
+    _ctxCrnt = &_ctxDef;
+    S52_GL_loadCtx(_ctxDef.GLctx);
+    S52_MP_loadCtx(_ctxDef.MPctx);
+
+    // other context
+    for (guint i=0; i<_ctxList->len; ++i) {
+        _S52_ctx *ctx = (_S52_ctx*) g_ptr_array_index(_ctxList, i);
+        if (&_ctxDef != ctx)
+            _delCtx(ctx);
+    }
+    g_ptr_array_free(_ctxList, TRUE);
+    _ctxList  = NULL;
+    _ctxSlotN = 1;
+#endif
+
     // this call free_func() if set
     g_ptr_array_free(_cellList, TRUE);
     _cellList    = NULL;
     _marinerCell = NULL;
 
+    // after _freeCell() - stop HO thread
+    S52_HO_done();
+
     S52_GL_done();
     S52_PL_done();
 
     S57_donePROJ();
 
+#ifdef S52_USE_ISO8211
+    S57_iso8211Done();
+#endif
+
     _intl   = NULL;
 
     S52_utils_doneLog();
@@ -1348,6 +2277,7 @@ DLL int    STD S52_done(void)
     g_string_free(_plibNameList, TRUE); _plibNameList = NULL;
     g_string_free(_paltNameList, TRUE); _paltNameList = NULL;
     g_string_free(_cellNameList, TRUE); _cellNameList = NULL;
+    g_string_free(_statsStr,     TRUE); _statsStr     = NULL;
     g_string_free(_S57ClassList, TRUE); _S57ClassList = NULL;
     g_string_free(_S52ObjNmList, TRUE); _S52ObjNmList = NULL;
 
@@ -1367,11 +2297,20 @@ DLL int    STD S52_done(void)
     g_ptr_array_free(_tmpRenderBin, TRUE);
     _tmpRenderBin = NULL;
 
-    // scale boudary list - obj allready deleted
-    g_array_free(_sclbdyList, TRUE);
-    _sclbdyList = NULL;
+#ifdef S52_USE_SCAMIN_BIN
+    g_array_free(_scaminIdx, TRUE);
+    _scaminIdx = NULL;
+    g_ptr_array_free(_scaminObj, TRUE);
+    _scaminObj = NULL;
+#endif
+
+    // HO data limit / scale boudary list - obj allready deleted
+    g_array_free(_HODATAList, TRUE);
+    _HODATAList = NULL;
+
+    g_array_free(_sclbdyDel,  TRUE);
+    _sclbdyDel  = NULL;
 
-    // scale boudary Union list - obj allready deleted
     g_array_free(_sclbdUList, TRUE);
     _sclbdUList = NULL;
 
@@ -1387,26 +2326,33 @@ exit:
 
     PRINTF("libS52 .. done\n");
 
+#ifdef S52_USE_TRACE
+    S52_TR_close();
+#endif
+
     return TRUE;
 }
 
 #ifdef S52_USE_SUPP_LINE_OVERLAP
+static void       _doneS57Prim(gpointer key, gpointer value, gpointer user_data)
+{
+    (void)key;
+
+    S57_doneData((S57_geo *)value, user_data);
+}
+
 static int        _suppLineOverlap(void)
 // no SUPP in case manual chart correction (LC(CHCRIDnn) and LC(CHCRDELn))
 // Note: for now, work for LC() only (LS() not processed)
 // FIXME: does NAME_RCNM, NAME_RCID and MASK value refer to original winding?
 
-// Note: RCNM ReCord NaMe
-// 110 - VI, isolated node
-// 120 - VC, connected node
-// 130 - VE, edge
-// In GDAL/OGR value are in the form = (<num value>:<val1>,<val2>, .. ,<valn>) in Attribute
-// NAME_RCNM (IntegerList) = (1:130)
-// NAME_RCID (IntegerList) = (1:72)
+// Note: the edge list of each geo (S57_getEdgeRef()) is filled at load time
+// from FSPT (NAME_RCNM = 130, NAME_RCID, MASK), so this is one sweep of integer
+// lookup in _S57Edges. The first geo (higher prio) that reference an edge own it,
+// the following geo get the edge coords marked (-S57_OVERLAP_GEO_Z), same for a masked edge.
 {
-    //return_if_null(_crntCell->S57Edges);
-    return_if_null(_S57Edges);
-    //return_if_null(_crntCell->ConnectedNodes); // not used (yet!)
+    if (NULL == _S57Edges)
+        goto exit;
 
     // assume that there is nothing on layer S52_PRIO_NODATA
     for (S52_disPrio prio=S52_PRIO_MARINR; prio>S52_PRIO_NODATA; --prio) {
@@ -1415,221 +2361,49 @@ static int        _suppLineOverlap(void)
             GPtrArray *rbin = _crntCell->renderBin[prio][obj_t];
             for (guint idx=0; idx<rbin->len; ++idx) {
 
-                // degug - Ctrl-C land here also now
-                //for (;;) {
-                    g_atomic_int_get(&_atomicAbort);
-                    if (TRUE == _atomicAbort) {
-                        PRINTF("NOTE: abort _suppLineOverlap() .. \n");
+                g_atomic_int_get(&_atomicAbort);
+                if (TRUE == _atomicAbort) {
+                    PRINTF("NOTE: abort _suppLineOverlap() .. \n");
 #ifdef S52_USE_BACKTRACE
-                        _backtrace();
+                    _backtrace();
 #endif
-                        g_atomic_int_set(&_atomicAbort, FALSE);
-                        goto exit;
-                    }
-                //    g_usleep(1000 * 1000); // 1.0 sec
-                //}
+                    g_atomic_int_set(&_atomicAbort, FALSE);
+                    goto exit;
+                }
 
                 // one object
-                S52_obj *obj = (S52_obj *)g_ptr_array_index(rbin, idx);
+                S52_obj *obj     = (S52_obj *)g_ptr_array_index(rbin, idx);
+                S57_geo *geo     = S52_PL_getGeo(obj);
+                GArray  *edgeRef = S57_getEdgeRef(geo);
 
-                // get edge ID list
-                S57_geo *geo = S52_PL_getGeo(obj);
-
-                GString *name_rcnmstr = S57_getAttVal(geo, "NAME_RCNM");
-                GString *name_rcidstr = S57_getAttVal(geo, "NAME_RCID");
+                // system generated obj (M_COVR of DATCVR, ..) have no edge
+                if (NULL == edgeRef)
+                    continue;
 
-                if ((NULL==name_rcnmstr) || (NULL==name_rcidstr)) {
-                    PRINTF("WARNING: no RCNM/RCID for obj:%s\n", S57_getName(geo));
-                    g_assert(0);
-                    break;
-                }
+                for (guint i=0; i<edgeRef->len; ++i) {
+                    S57_edgeRef *ref     = &g_array_index(edgeRef, S57_edgeRef, i);
+                    S57_geo     *geoEdge = (S57_geo *)g_hash_table_lookup(_S57Edges, GUINT_TO_POINTER(ref->rcid));
 
-                // see ogr/ogrfeature.cpp:994
-                #define OGR_TEMP_BUFFER_SIZE 80
-                if ((OGR_TEMP_BUFFER_SIZE==name_rcnmstr->len) && ('.'==name_rcnmstr->str[name_rcnmstr->len-1])) {
-                    PRINTF("FIXME: OGR buffer TEMP_BUFFER_SIZE in ogr/ogrfeature.cpp:994 overflow\n");
-                    PRINTF("FIXME: apply patch in S52/doc/ogrfeature.cpp.diff to OGR source code\n");
-                    g_assert(0);
-                    return FALSE;
-                }
-                /* FIXME: overkill, find a better way . maybe when loading att
-                {   // check for substring ",...)" if found at the end
-                    // this mean that TEMP_BUFFER_SIZE in OGR is not large anought.
-                    // see ogr/ogrfeature.cpp:994
-                    // #define OGR_TEMP_BUFFER_SIZE 80
-                    // apply patch in S52/doc/ogrfeature.cpp.diff to OGR source code
-                    const gchar *substr = ",...)";
-                    gchar       *found1 = g_strrstr(name_rcnmstr->str, substr);
-                    gchar       *found2 = g_strrstr(name_rcidstr->str, substr);
-                    if (NULL!=found1 || NULL!=found2) {
-                        PRINTF("FIXME: OGR buffer TEMP_BUFFER_SIZE in ogr/ogrfeature.cpp:994 overflow\n");
-                        PRINTF("FIXME: apply patch in S52/doc/ogrfeature.cpp.diff to OGR source code\n");
-                        g_assert(0);
-                        return FALSE;
+                    if (NULL == geoEdge) {
+                        PRINTF("DEBUG: edge RCID:%u not found, geo: %s ID:%i\n", ref->rcid, S57_getName(geo), S57_getS57ID(geo));
+                        continue;
                     }
-                }
-                //*/
-
-
-                /////////////////////// DEBUG MASK ////////////////////////////////////////////////
-                //
-                // CA379035.000 Tadoussac has Mask on TSSLPT:5339,5340
-                // but TSSLPT has no LC() or LS() to mask !
-                // Note: RESARE02 has LC()!
-                // TSSLPT:5339 : MASK (IntegerList) = (7:1,2,255,255,255,255,2)
-                // 1 - mask, 2 - show, 255 - NULL, Masking is no relevant (exterior boundary truncated by the data limit)
-
-                // Note: use clip plane - Z_CLIP_PLANE = S57_OVERLAP_GEO_Z + 1
-
-                /*
-                GString *maskstr = S57_getAttVal(geo, "MASK");
-                if (NULL != maskstr) {
-                    // check if buff is large enough
-                    // the check will be done previously (see above)
-                    //gchar *substr = ",...)";
-                    //gchar *found1 = g_strrstr(maskstr->str, substr);
-                    //if (NULL != found1) {
-                    //    PRINTF("ERROR: OGR buffer TEMP_BUFFER_SIZE in ogr/ogrfeature.cpp:994 overflow\n");
-                    //    g_assert(0);
-                    //} else {
-                        // buff size OK
-                        gchar **splitMASK = g_strsplit_set(maskstr->str+1, "():,", 0);
-                        gchar **topMASK   = splitMASK;
-
-                        // the first integer is the lenght (ie the number of mask value)
-                        guint n = atoi(*splitMASK++);
-                        for (guint i=0; i<n; ++splitMASK, ++i) {
-                            if (('1'==*splitMASK[0]) || ('5'==*splitMASK[1])) {
-                                // debug
-                                PRINTF("DEBUG: 'MASK' FOUND ---> %s:%i : %s\n", S57_getName(geo), S57_getS57ID(geo), maskstr->str);
-                                // TSSLPT:5339 : (7:1,2,255,255,255,255,2)
-                                // TSSLPT:5340 : (5:1,2,255,255,2)
-                                //g_assert(0);
-                            }
-                        }
-                        g_strfreev(topMASK);
-                    //}
-                }
-                //*/
-                ///////////////////////////////////////////////////////////////////////////
-
-
-                // take only Edge (ie rcnm == 130 (Edge type))
-                gchar **splitrcnm  = g_strsplit_set(name_rcnmstr->str+1, "():,", 0);
-                gchar **splitrcid  = g_strsplit_set(name_rcidstr->str+1, "():,", 0);
-                gchar **toprcnm    = splitrcnm;
-                gchar **toprcid    = splitrcid;
 
-                guint nRCNM = atoi(*splitrcnm);
-                guint nRCID = atoi(*splitrcid);
-
-                // debug
-                if (nRCNM != nRCID) {
-                    PRINTF("DEBUG: nRCNM != nRCID .. exit\n");
-                    g_assert(0);
-                    return FALSE;
-                }
-
-                /* check if splitrcnm / splitrcid are valid
-                for (guint i=0; i<nRCNM; ++splitrcnm, ++i) {
-                    if (NULL == *splitrcnm) {
-                        PRINTF("ERROR: *splitrcnm\n");
-                        g_assert(0);
+                    // masked edge (ie exterior boundary truncated by the data limit): not drawn
+                    // Note: the clip plane (Z_CLIP_PLANE) do the same for LS()
+                    if (TRUE == ref->mask) {
+                        S57_markOverlapGeo(geo, geoEdge);
+                        continue;
                     }
-                }
-                for (guint i=0; i<nRCID; ++splitrcid, ++i) {
-                    if (NULL == *splitrcid) {
-                        PRINTF("ERROR: *splitrcid\n");
-                        g_assert(0);
-                    }
-                }
-                */
-
-
-                //////////////////////////////////////////////////////////////////
-                //
-                // Algo:
-                //for (i=0; NULL!=str; ++i)
-                // for all rcnm == 130
-                //   take rcid
-                //   get Edge with rcid
-                //   if geo is null
-                //       make Edge to point to geo
-                //   else
-                //       make geo coord z==-1 for all vertex in Edge that are found in geo
-                //
-                // So vertex in Edge are matched to vertex in geo - what ever the winding is!
-                //
-
-                // NAME_RCNM (IntegerList) = (1:130)
-                // NAME_RCID (IntegerList) = (1:72)
-
-                // FIXME: does this reversing really help - find a solid test case
-                // check original winding and reverse splitrcnm if CCW
-                int increment = 0;
-
-                // reset list
-                /*
-                S57_AW_t origAW = S57_getOrigAW(geo);
-                if (S57_AW_CCW == origAW) {
-                    splitrcnm = toprcnm + nRCNM;
-                    splitrcid = toprcid + nRCID;
-                    increment = -1;
-                } else {
-                    splitrcnm = toprcnm;
-                    splitrcid = toprcid;
-                    splitrcnm++;  // skip first integer (length)
-                    splitrcid++;  // skip first integer (length)
-                    increment = 1;
-                }
-                //*/
-
-                //*
-                splitrcnm = toprcnm;
-                splitrcid = toprcid;
-                splitrcnm++;  // skip first integer (length)
-                splitrcid++;  // skip first integer (length)
-                increment = 1;
-                //*/
-
-                for (guint i=0; i<nRCNM; ++i, splitrcnm+=increment, splitrcid+=increment) {
-
-                    //if (0 == g_strcmp0(*splitrcnm, "130")) {
-                    // the S57 name for Edge (130 --> S57_RCNM_VE = '3')
-                    //if (S57_RCNM_VE == *(*splitrcnm+1)) {
-                    if (S57_RCNM_VE == (*splitrcnm)[1]) {
-                        // search Edges with the same RCID then one of geo RCID
-                        //for (guint j=0; j<_crntCell->S57Edges->len; ++j) {
-                        for (guint j=0; j<_S57Edges->len; ++j) {
-                            //S57_geo *geoEdge      = (S57_geo *)g_ptr_array_index(_crntCell->S57Edges, j);
-                            S57_geo *geoEdge      = (S57_geo *)g_ptr_array_index(_S57Edges, j);
-                            gchar   *name_rcidstr = S57_getRCIDstr(geoEdge);
-
-                            // failsafe
-                            if (NULL == name_rcidstr) {
-                                PRINTF("DEBUG: RCID NULL geo: %s ID:%i\n", S57_getName(geo), S57_getS57ID(geo));
-                                g_assert(0);
-                                continue;
-                            }
-
-                            // same RCID found
-                            if (0 == g_strcmp0(name_rcidstr, *splitrcid)) {
-                                if (NULL == S57_getEdgeOwner(geoEdge)) {
-                                    S57_setEdgeOwner(geoEdge, geo);
-                                } else {
-                                    //PRINTF("DEBUG: edge overlap found on %s ID:%i\n", S57_getName(geo), S57_getS57ID(geo));
-                                    S57_markOverlapGeo(geo, geoEdge);
-                                }
-
-                                // edge found, in S57 a geometry can't have the same edge twice,
-                                // hence bailout because this edge will not apear again
-                                break;
-                            }
-                        }
+
+                    // in S57 a geometry can't have the same edge twice
+                    if (NULL == S57_getEdgeOwner(geoEdge)) {
+                        S57_setEdgeOwner(geoEdge, geo);
+                    } else {
+                        //PRINTF("DEBUG: edge overlap found on %s ID:%i\n", S57_getName(geo), S57_getS57ID(geo));
+                        S57_markOverlapGeo(geo, geoEdge);
                     }
                 }
-                g_strfreev(toprcnm);
-                g_strfreev(toprcid);
             }
         }
     }
@@ -1640,23 +2414,16 @@ exit:
         // these are not S52_obj, so no delObj()
         int quiet = TRUE;
 
-        //g_ptr_array_foreach(_crntCell->S57Edges,       (GFunc)S57_doneData, &quiet);
-        //g_ptr_array_foreach(_crntCell->ConnectedNodes, (GFunc)S57_doneData, &quiet);
-        g_ptr_array_foreach(_S57Edges,       (GFunc)S57_doneData, &quiet);
-        g_ptr_array_foreach(_ConnectedNodes, (GFunc)S57_doneData, &quiet);
-
-        // this call free_func() if set
-        //g_ptr_array_free(_crntCell->S57Edges,       TRUE);
-        //g_ptr_array_free(_crntCell->ConnectedNodes, TRUE);
-        g_ptr_array_free(_S57Edges,       TRUE);
-        g_ptr_array_free(_ConnectedNodes, TRUE);
-
-        //_crntCell->S57Edges       = NULL;
-        //_crntCell->ConnectedNodes = NULL;
-        //_crntCell->baseRCID       = 0;
-        _S57Edges       = NULL;
-        _ConnectedNodes = NULL;
-        _baseRCID       = 0;
+        if (NULL != _S57Edges) {
+            g_hash_table_foreach(_S57Edges, _doneS57Prim, &quiet);
+            g_hash_table_destroy(_S57Edges);
+            _S57Edges = NULL;
+        }
+        if (NULL != _ConnectedNodes) {
+            g_hash_table_foreach(_ConnectedNodes, _doneS57Prim, &quiet);
+            g_hash_table_destroy(_ConnectedNodes);
+            _ConnectedNodes = NULL;
+        }
     }
 
     return TRUE;
@@ -1758,11 +2525,26 @@ static _cell     *_loadBaseCell(char *filename, S52_loadLayer_cb loadLayer_cb, S
     g_ptr_array_add(_cellList, c);
     g_ptr_array_sort(_cellList, _cmpCellINTU);
 
+#ifdef S52_USE_ARENA
+    c->arena = S57_newArena();
+    S57_arena *arena = S57_setArena(c->arena);
+#endif
+
 #ifdef S52_USE_GV
     S57_gvLoadCell (filename, layer_cb);
+#else
+#ifdef S52_USE_ISO8211
+    // stream base cell natively - OGR for .shp or if the cell has update
+    _ISO8211 = TRUE;
+    if (FALSE == S57_iso8211LoadCell(filename, loadLayer_cb, loadObject_cb)) {
+        _ISO8211 = FALSE;
+        S57_ogrLoadCell(filename, loadLayer_cb, loadObject_cb);
+    }
+    _ISO8211 = FALSE;
 #else
     S57_ogrLoadCell(filename, loadLayer_cb, loadObject_cb);
-#endif
+#endif  // S52_USE_ISO8211
+#endif  // S52_USE_GV
 
     // FIXME: resolve heightdatum correction here!
     // FIX: go trouht all layer that have to look for
@@ -1798,6 +2580,10 @@ static _cell     *_loadBaseCell(char *filename, S52_loadLayer_cb loadLayer_cb, S
         PRINTF("DEBUG: NODATA Layer check -END-   ==============================================\n");
     }
 
+#ifdef S52_USE_ARENA
+    S57_setArena(arena);
+#endif
+
     return c;
 }
 
@@ -2128,6 +2914,60 @@ int               _loadRaster(const char *fname)
 #endif  // S52_USE_RADAR S52_USE_RASTER
 
 int            S52_loadLayer(const char *layername, void *layer, S52_loadObject_cb loadObject_cb);  // forward decl
+
+#ifdef S52_USE_CHART_MANAGER
+static gsize      _getCellMem(const char *encPath);  // forward decl
+static int        _CM_resample(ObjExt_t ext);        // forward decl
+
+static int        _CM_loadCell(const char *encPath, gsize *size)
+// Chart Manager thread
+{
+    // not traced - replay of S52_loadCell(CATALOG.031) restart the Chart Manager
+    S52_TR_INTERNAL(TRUE);
+    int ret = S52_loadCell(encPath, NULL);
+    S52_TR_INTERNAL(FALSE);
+    if (TRUE == ret)
+        *size = _getCellMem(encPath);
+
+    return ret;
+}
+
+static int        _isCATALOG(const char *fname)
+// TRUE if fname is a CATALOG.031 or an ENC_ROOT with a CATALOG.031
+{
+    if (TRUE == g_str_has_suffix(fname, "CATALOG.031"))
+        return TRUE;
+
+    if (TRUE == g_file_test(fname, G_FILE_TEST_IS_DIR)) {
+        gchar *catalog = g_build_filename(fname, "CATALOG.031", NULL);
+        int    ret     = g_file_test(catalog, G_FILE_TEST_EXISTS);
+        g_free(catalog);
+
+        return ret;
+    }
+
+    return FALSE;
+}
+
+static int        _loadCATALOG(const char *fname)
+// index CATALOG - cell are loaded by the Chart Manager when near the view
+{
+    // 0 - no limit
+    int budgetMB = S52_utils_getConfigInt(CFG_CM_BUDGET, 0);
+    if (budgetMB < 0)
+        budgetMB = 0;
+
+    if (FALSE == S52_CM_init(fname, budgetMB, _CM_loadCell))
+        return FALSE;
+
+#ifdef S52_USE_PROJ
+    _initPROJview();
+#endif
+
+    return TRUE;
+}
+#endif  // S52_USE_CHART_MANAGER
+
 DLL int    STD S52_loadCell(const char *encPath, S52_loadObject_cb loadObject_cb)
 // FIXME: handle each type of cell separatly
 // OGR:
@@ -2139,6 +2979,8 @@ DLL int    STD S52_loadCell(const char *encPath, S52_loadObject_cb loadObject_cb
 // GDAL:
 // - GeoTIFF
 {
+    S52_TR_CALL(S52_TR_loadCell, "s", encPath);
+
     int    ret   = FALSE;
     char  *fname = NULL;
     //_cell *c     = NULL;
@@ -2189,6 +3031,13 @@ DLL int    STD S52_loadCell(const char *encPath, S52_loadObject_cb loadObject_cb
         goto exit;
     }
 
+#ifdef S52_USE_CHART_MANAGER
+    if (TRUE == _isCATALOG(fname)) {
+        ret = _loadCATALOG(fname);
+        goto exit;
+    }
+#endif
+
 #ifdef S52_USE_WORLD
     {   // experimental - load world shapefile
         gchar *basename = g_path_get_basename(fname);
@@ -2205,6 +3054,7 @@ DLL int    STD S52_loadCell(const char *encPath, S52_loadObject_cb loadObject_cb
         if ((TRUE==g_str_has_suffix(fname, ".tif" )) ||
             (TRUE==g_str_has_suffix(fname, ".tiff"))) {
             _loadRaster(fname);
+            _dirty(_GEN_RASTER);
 
             ret = TRUE;
             goto exit;
@@ -2301,6 +3151,9 @@ DLL int    STD S52_loadCell(const char *encPath, S52_loadObject_cb loadObject_cb
 
 exit:
 
+    if (TRUE == ret)
+        _dirty(_GEN_CELL);
+
     g_free(fname);
 
     GMUTEXUNLOCK(&_mp_mutex);
@@ -2308,11 +3161,31 @@ exit:
     return ret;
 }
 
+static int        _doneCell(const char *fname)
+// unload cell - lock held
+{
+    int    ret      = FALSE;
+    gchar *baseName = g_path_get_basename(fname);
+    guint  i        = _isCellLoaded(baseName);
+    if (0 < i) {
+        // this call free_func() if set
+        g_ptr_array_remove_index(_cellList, i);
+        ret = TRUE;
+    }
+    g_free(baseName);
+
+    // _app() - compute HO Data Limit
+    _APP_DATCVR = TRUE;
+
+    return ret;
+}
+
 DLL int    STD S52_doneCell(const char *encPath)
-// FIXME: the (futur) chart manager (CM) should to this by itself
-// so loadCell would load a CATALOG then CM would load individual cell
-// to fill the view (and unload cell outside the view)
+// Note: with S52_USE_CHART_MANAGER, a CATALOG passed to S52_loadCell()
+// is loaded / unloaded by the chart manager (S52CM.c) to fill the view
 {
+    S52_TR_CALL(S52_TR_doneCell, "s", encPath);
+
     return_if_null(encPath);
 
     int    ret      = FALSE;
@@ -2375,21 +3248,20 @@ DLL int    STD S52_doneCell(const char *encPath)
         goto exit;
     }
 
-    gchar *baseName = g_path_get_basename(fname);
-    guint  i        = _isCellLoaded(baseName);
-    if (0 < i) {
-        // this call free_func() if set
-        //_cell *c = (_cell*)
-        g_ptr_array_remove_index(_cellList, i);
-        //_freeCell(c);
-        ret = TRUE;
-    }
-    g_free(baseName);
+#ifdef S52_USE_CHART_MANAGER
+    // CM will not reload this cell
+    S52_CM_doneCell(fname);
+#endif
+
+    ret = _doneCell(fname);
 
 exit:
     // _app() - compute HO Data Limit
     _APP_DATCVR = TRUE;
 
+    if (TRUE == ret)
+        _dirty(_GEN_CELL);
+
     g_free(fname);
 
     GMUTEXUNLOCK(&_mp_mutex);
@@ -2416,7 +3288,7 @@ static int        __builS57Edge(S57_geo *geo, double *ppt_0, double *ppt_1)
 
     // new S57 Edge = ENs + CNs
     guint   npt_new     = npt + 2;  // the new edge will have 2 more point - one at each end
-    double *ppt_new     = g_new(double, npt_new*3);
+    double *ppt_new     = (double*)S57_newGeoData(geo, sizeof(double)*3*npt_new);
 
     // set coords at both ends
     ppt_new[0] = ppt_0[0];                  // CN-0
@@ -2429,21 +3301,19 @@ static int        __builS57Edge(S57_geo *geo, double *ppt_0, double *ppt_1)
         // +3 step over first pos.
         memcpy(ppt_new+3, ppt, sizeof(double) * 3 * npt);
     }
-    g_free(ppt);
 
-    // update S57 Edge
+    // update S57 Edge - free old coords
     S57_setGeoLine(geo, npt_new, ppt_new);
 
-    // add to this cell (crntCell)
-    //if (NULL == _crntCell->S57Edges)
-    //    _crntCell->S57Edges = g_ptr_array_new();
-    if (NULL == _S57Edges)
-        _S57Edges = g_ptr_array_new();
+    return TRUE;
+}
 
-    //g_ptr_array_add(_crntCell->S57Edges, geo);
-    g_ptr_array_add(_S57Edges, geo);
+static guint      _getRCID(S57_geo *geo, const char *attName)
+// primitive RCID (or NAME_RCID_n) - 0 if none
+{
+    GString *rcidstr = S57_getAttVal(geo, attName);
 
-    return TRUE;
+    return (NULL == rcidstr) ? 0 : (guint)atoi(rcidstr->str);
 }
 
 static int        _loadS57Edge(const char *name, void *Edge)
@@ -2456,88 +3326,49 @@ static int        _loadS57Edge(const char *name, void *Edge)
         return FALSE;
     }
 
-    S57_geo *geo = S57_ogrLoadObject(name, (void*)Edge);
+    S57_geo *geo = S57_LOADOBJECT(name, (void*)Edge);
     if (NULL == geo) {
-        PRINTF("WARNING: OGR fail to load object: %s\n", name);
-        g_assert(0);
+        PRINTF("WARNING: fail to load object: %s, edge skipped\n", name);
         return FALSE;
     }
 
     // get CN at edge end
-    GString *name_rcid_0str = S57_getAttVal(geo, "NAME_RCID_0");
-    guint    name_rcid_0    = (NULL == name_rcid_0str) ? 1 : atoi(name_rcid_0str->str);
-    GString *name_rcid_1str = S57_getAttVal(geo, "NAME_RCID_1");
-    guint    name_rcid_1    = (NULL == name_rcid_1str) ? 1 : atoi(name_rcid_1str->str);
-
-    // debug
-    if (NULL==name_rcid_0str || NULL==name_rcid_1str) {
-        PRINTF("DEBUG: Edge with no end point\n");
-        g_assert(0);
+    guint name_rcid_0 = _getRCID(geo, "NAME_RCID_0");
+    guint name_rcid_1 = _getRCID(geo, "NAME_RCID_1");
+
+    S57_geo *node_0 = (NULL == _ConnectedNodes) ? NULL : (S57_geo *)g_hash_table_lookup(_ConnectedNodes, GUINT_TO_POINTER(name_rcid_0));
+    S57_geo *node_1 = (NULL == _ConnectedNodes) ? NULL : (S57_geo *)g_hash_table_lookup(_ConnectedNodes, GUINT_TO_POINTER(name_rcid_1));
+    // malformed cell - skip this edge (no overlap suppression on it)
+    if ((NULL==node_0) || (NULL==node_1)) {
+        PRINTF("WARNING: Edge end point not found in ConnectedNode (RCID %u, %u), edge skipped\n", name_rcid_0, name_rcid_1);
+        S57_doneData(geo, NULL);
         return FALSE;
     }
 
-    // node-0
-    //if ((name_rcid_0 - _crntCell->baseRCID) > _crntCell->ConnectedNodes->len) {
-    if ((name_rcid_0 - _baseRCID) > _ConnectedNodes->len) {
-        PRINTF("DEBUG: Edge end point 0 (%s) and ConnectedNodes array lenght mismatch\n", name_rcid_0str->str);
-        g_assert(0);
-        return FALSE;
-    }
-    //S57_geo *node_0 =  (S57_geo *)g_ptr_array_index(_crntCell->ConnectedNodes, (name_rcid_0 - _crntCell->baseRCID));
-    S57_geo *node_0 =  (S57_geo *)g_ptr_array_index(_ConnectedNodes, (name_rcid_0 - _baseRCID));
-    if (NULL == node_0) {
-        PRINTF("DEBUG: got empty node_0 at name_rcid_0 = %i\n", name_rcid_0);
-        g_assert(0);
-        return FALSE;
-    }
     guint   npt_0 = 0;
     double *ppt_0 = NULL;
     S57_getGeoData(node_0, 0, &npt_0, &ppt_0);
 
-    // node-1
-    //if ((name_rcid_1 - _crntCell->baseRCID) > _crntCell->ConnectedNodes->len) {
-    if ((name_rcid_1 - _baseRCID) > _ConnectedNodes->len) {
-        PRINTF("DEBUG: Edge end point 1 (%s) and ConnectedNodes array lenght mismatch\n", name_rcid_1str->str);
-        g_assert(0);
-        return FALSE;
-    }
-    //S57_geo *node_1 =  (S57_geo *)g_ptr_array_index(_crntCell->ConnectedNodes, (name_rcid_1 - _crntCell->baseRCID));
-    S57_geo *node_1 =  (S57_geo *)g_ptr_array_index(_ConnectedNodes, (name_rcid_1 - _baseRCID));
-    if (NULL == node_1) {
-        // if we land here it meen that there no ConnectedNodes at this index
-        // ptr_array has hold (NULL) because of S57 update
-        PRINTF("DEBUG: got empty node_1 at name_rcid_1 = %i\n", name_rcid_1);
-        g_assert(0);
-        return FALSE;
-    }
-    guint   npt_1   = 0;
-    double *ppt_1   = NULL;
+    guint   npt_1 = 0;
+    double *ppt_1 = NULL;
     S57_getGeoData(node_1, 0, &npt_1, &ppt_1);
 
-    // debug - invariant
-    {   // check that index are in sync with rcid
-        // check assumion that ConnectedNodes are continuous
-        // FIXME: when applying update this is no longer true (ie continuous)
-        GString *rcid_0str = S57_getAttVal(node_0, "RCID");
-        guint    rcid_0    = (NULL == rcid_0str) ? 1 : atoi(rcid_0str->str);
-        GString *rcid_1str = S57_getAttVal(node_1, "RCID");
-        guint    rcid_1    = (NULL == rcid_1str) ? 1 : atoi(rcid_1str->str);
-
-        if (name_rcid_0 != rcid_0) {
-            PRINTF("DEBUG: name_rcid_0 mismatch\n");
-            g_assert(0);
-            return FALSE;
-        }
-        if (name_rcid_1 != rcid_1) {
-            PRINTF("DEBUG: name_rcid_1 mismatch\n");
-            g_assert(0);
-            return FALSE;
-        }
+    // ConnectedNode without SG2D
+    if ((0==npt_0) || (NULL==ppt_0) || (0==npt_1) || (NULL==ppt_1)) {
+        PRINTF("WARNING: ConnectedNode without coordinate (RCID %u, %u), edge skipped\n", name_rcid_0, name_rcid_1);
+        S57_doneData(geo, NULL);
+        return FALSE;
     }
 
     // 3rd - build actual chaine node (complete geo edge ready for overlap test - _suppLineOverlap())
     __builS57Edge(geo, ppt_0, ppt_1);
 
+    // add to this cell (crntCell)
+    if (NULL == _S57Edges)
+        _S57Edges = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    g_hash_table_insert(_S57Edges, GUINT_TO_POINTER(_getRCID(geo, "RCID")), geo);
+
     // debug
     //PRINTF("%X len:%i\n", _crntCell->Edges->pdata, _crntCell->Edges->len);
     //PRINTF("XXX %s\n", S57_getName(geo));
@@ -2554,48 +3385,18 @@ static int        _loadS57ConnectedNode(const char *name, void *ConnectedNode)
         return FALSE;
     }
 
-    S57_geo *geo = S57_ogrLoadObject(name, (void*)ConnectedNode);
+    S57_geo *geo = S57_LOADOBJECT(name, (void*)ConnectedNode);
     if (NULL == geo) {
         PRINTF("WARNING: OGR fail to load object: %s\n", name);
         g_assert(0);
         return FALSE;
     }
 
-    {
-        GString *rcidstr = S57_getAttVal(geo, "RCID");
-        guint    rcid    = (NULL == rcidstr) ? 0 : atoi(rcidstr->str);
-
-        // debug
-        if (NULL == rcidstr) {
-            PRINTF("DEBUG: no Att RCID .. \n");
-            g_assert(0);
-            return FALSE;
-        }
-
-        //if (0 == _crntCell->baseRCID) {
-        //    _crntCell->baseRCID = rcid;
-        if (0 == _baseRCID) {
-            _baseRCID = rcid;
-        }
-
-        // add to this cell (crntCell)
-        //if (NULL == _crntCell->ConnectedNodes) {
-        //    _crntCell->ConnectedNodes = g_ptr_array_new();
-        if (NULL == _ConnectedNodes) {
-            _ConnectedNodes = g_ptr_array_new();
-        }
-
-        // set_size is over grown - should be  'rcid - _crntCell->baseRCID + 1'
-        //if (rcid > _crntCell->ConnectedNodes->len) {
-        //    g_ptr_array_set_size(_crntCell->ConnectedNodes, rcid);
-        if (rcid > _ConnectedNodes->len) {
-            g_ptr_array_set_size(_ConnectedNodes, rcid);
-            //g_assert(0);
-        }
+    // add to this cell (crntCell)
+    if (NULL == _ConnectedNodes)
+        _ConnectedNodes = g_hash_table_new(g_direct_hash, g_direct_equal);
 
-        //_crntCell->ConnectedNodes->pdata[rcid - _crntCell->baseRCID] = geo;
-        _ConnectedNodes->pdata[rcid - _baseRCID] = geo;
-    }
+    g_hash_table_insert(_ConnectedNodes, GUINT_TO_POINTER(_getRCID(geo, "RCID")), geo);
 
     return TRUE;
 }
@@ -2642,12 +3443,12 @@ int            S52_loadLayer(const char *layername, void *layer, S52_loadObject_
 
     // 3rd layer - ConnectedNode use to complete an Edge
     if (0 == g_strcmp0(layername, "ConnectedNode")) {
-        S57_ogrLoadLayer(layername, layer, _loadS57ConnectedNode);
+        S57_LOADLAYER(layername, layer, _loadS57ConnectedNode);
         return TRUE;
     }
     // 4th layer - Edge is use to resolve overlapping line
     if (0 == g_strcmp0(layername, "Edge")) {
-        S57_ogrLoadLayer(layername, layer, _loadS57Edge);
+        S57_LOADLAYER(layername, layer, _loadS57Edge);
         return TRUE;
     }
     // --------------------------------------------
@@ -2687,7 +3488,7 @@ int            S52_loadLayer(const char *layername, void *layer, S52_loadObject_
 #ifdef S52_USE_GV
     S57_gvLoadLayer (layername, layer, loadObject_cb);
 #else
-    S57_ogrLoadLayer(layername, layer, loadObject_cb);
+    S57_LOADLAYER(layername, layer, loadObject_cb);
 #endif
 
     return TRUE;
@@ -2752,6 +3553,8 @@ static S52_obj   *_insertS57geo(_cell *c, S57_geo *geo)
     if (FALSE == _insertLightSec(c, obj)) {
         // insert normal object (ie not a light with sector)
         g_ptr_array_add(c->renderBin[disPrioIdx][obj_t], obj);
+        SCAMIN_DIRTY(c);
+        MEM_DIRTY(c);
 
         /* optimisation: recompute only CS that change due to new MarParam value
         // save reference for quickly find CS to re-compute after a MarinerParameter change
@@ -2796,6 +3599,8 @@ static S52_obj   *_insertS52obj(_cell *c, S52_obj *obj)
     if (FALSE == _insertLightSec(c, obj)) {
         // insert normal object (ie not a light with sector)
         g_ptr_array_add(c->renderBin[disPrioIdx][obj_t], obj);
+        SCAMIN_DIRTY(c);
+        MEM_DIRTY(c);
 
         /* optimisation: recompute only CS that change due to new MarParam value
         // save reference for quickly find CS to re-compute after a MarinerParameter change
@@ -2820,31 +3625,10 @@ static S52_obj   *_insertS52obj(_cell *c, S52_obj *obj)
     return obj;
 }
 
-//DLL int    STD S52_loadObject(const char *objname, void *shape)
-int            S52_loadObject(const char *objname, void *shape)
+static S52_obj   *_loadGeo(const char *objname, S57_geo *geo)
+// insert geo in _crntCell - cell extent, legend, CS
+// return the new S52_obj
 {
-    S57_geo *geo = NULL;
-
-    if ((NULL==objname) || (NULL==shape)) {
-        PRINTF("WARNING: objname / shape NULL\n");
-        return FALSE;
-    }
-
-#ifdef S52_USE_GV
-    // debug: filter out metadata
-    if (0 == g_strcmp0("DSID", objname))
-        return FALSE;
-
-    geo = S57_gvLoadObject (objname, (void*)shape);
-#else
-    geo = S57_ogrLoadObject(objname, (void*)shape);
-#endif
-
-    if (NULL == geo) {
-        PRINTF("OBJNAME:%s skipped .. no geo\n", objname);
-        return FALSE;
-    }
-
     // set cell extent from each area object
     // Note: should be the same as CATALOG.03x
     if (S57__META_T != S57_getObjtype(geo)) {
@@ -2986,6 +3770,9 @@ int            S52_loadObject(const char *objname, void *shape)
             _crntCell->legend.dsid_edtnstr = S57_getAttVal(geo, "DSID_EDTN");  // edition number
             _crntCell->legend.dsid_uadtstr = S57_getAttVal(geo, "DSID_UADT");  // edition date
             _crntCell->legend.dsid_intustr = S57_getAttVal(geo, "DSID_INTU");  // intended usage (navigational purpose)
+            _crntCell->edtn = (NULL == _crntCell->legend.dsid_edtnstr) ? 0 : (guint)atoi(_crntCell->legend.dsid_edtnstr->str);
+            _crntCell->updn = (NULL == _crntCell->legend.dsid_updnstr) ? 0 : (guint)atoi(_crntCell->legend.dsid_updnstr->str);
+
             if (_crntCell->filename->str[2] != *_crntCell->legend.dsid_intustr->str) {
                 PRINTF("DEBUG: DSID_INTU mismatch filename nav purp\n");
                 g_assert(0);
@@ -2998,16 +3785,16 @@ int            S52_loadObject(const char *objname, void *shape)
 
 #ifdef S52_USE_WORLD
     if (0 == g_strcmp0(objname, WORLD_BASENM)) {
-        _insertS57geo(_crntCell, geo);
+        S52_obj *obj = _insertS57geo(_crntCell, geo);
 
         // unlink Poly chain - else will loop forever in S52_loadPLib()
         S57_delNextPoly(geo);
 
-        return TRUE;
+        return obj;
     }
 #endif
 
-    _insertS57geo(_crntCell, geo);
+    S52_obj *obj = _insertS57geo(_crntCell, geo);
 
     S52_CS_add(_crntCell->local, geo);
 
@@ -3025,8 +3812,363 @@ int            S52_loadObject(const char *objname, void *shape)
     //--------------------------------------------------
 #endif  // S52_USE_C_AGGR_C_ASSO
 
+    return obj;
+}
+
+//DLL int    STD S52_loadObject(const char *objname, void *shape)
+int            S52_loadObject(const char *objname, void *shape)
+{
+    S57_geo *geo = NULL;
+
+    if ((NULL==objname) || (NULL==shape)) {
+        PRINTF("WARNING: objname / shape NULL\n");
+        return FALSE;
+    }
+
+#ifdef S52_USE_GV
+    // debug: filter out metadata
+    if (0 == g_strcmp0("DSID", objname))
+        return FALSE;
+
+    geo = S57_gvLoadObject (objname, (void*)shape);
+#else
+    geo = S57_LOADOBJECT(objname, (void*)shape);
+#endif
+
+    if (NULL == geo) {
+        PRINTF("OBJNAME:%s skipped .. no geo\n", objname);
+        return FALSE;
+    }
+
+    if (NULL == _loadGeo(objname, geo))
+        return FALSE;
+
+    return TRUE;
+}
+
+#ifdef S52_USE_ISO8211
+typedef struct _update {
+    _cell      *c;
+    GHashTable *lnam;       // LNAM --> GPtrArray of S52_obj (SOUNDG) - obj before update
+    GHashTable *geo;        // set of S57_geo deleted or inserted by the update
+    GPtrArray  *delObj;     // S52_obj taken out of the cell - deleted once unlinked
+    GPtrArray  *newObj;     // S52_obj inserted by the update
+    GPtrArray  *nbrObj;     // S52_obj neighbour of a changed obj - touch and resolve CS again
+    int         lights;     // TRUE if a light sector changed
+    int         datcvr;     // TRUE if a M_COVR changed
+} _update;
+
+static void       _freeObjList(GPtrArray *objList) {g_ptr_array_free(objList, TRUE);}
+static void       __addLNAM(S52_obj *obj, GHashTable *lnam)
+{
+    GString *lnamstr = S57_getAttVal(S52PLGETGEO(obj), "LNAM");
+    if (NULL == lnamstr)
+        return;
+
+    GPtrArray *objList = (GPtrArray *)g_hash_table_lookup(lnam, lnamstr->str);
+    if (NULL == objList) {
+        objList = g_ptr_array_new();
+        g_hash_table_insert(lnam, lnamstr->str, objList);
+    }
+    g_ptr_array_add(objList, obj);
+
+    return;
+}
+
+static int        _unlinkObj(GPtrArray *rbin, S52_obj *obj)
+// remove obj from rbin without free_func() - keep drawing order
+{
+    for (guint idx=0; idx<rbin->len; ++idx) {
+        if (obj == g_ptr_array_index(rbin, idx)) {
+            memmove(rbin->pdata+idx, rbin->pdata+idx+1, sizeof(gpointer) * (rbin->len-idx-1));
+
+            rbin->len             -= 1;
+            rbin->pdata[rbin->len] = NULL;
+
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+static int        _delLegend(_legend *legend, S57_geo *geo)
+// clear legend ref to attribute value of geo (about to be deleted)
+{
+    GString   **str[] = {&legend->cscalestr,  &legend->catzocstr,  &legend->posaccstr,
+                         &legend->sverdatstr, &legend->vverdatstr,
+                         &legend->valmagstr,  &legend->ryrmgvstr,  &legend->valacmstr};
+    const char *att[] = {"CSCALE", "CATZOC", "POSACC",
+                         "VERDAT", "VERDAT",
+                         "VALMAG", "RYRMGV", "VALACM"};
+
+    for (guint i=0; i<G_N_ELEMENTS(str); ++i) {
+        if ((NULL!=*str[i]) && (*str[i]==S57_getAttVal(geo, att[i])))
+            *str[i] = NULL;
+    }
+
+    return TRUE;
+}
+
+static int        _updateObj(const char *objname, const char *lnam, S57_geo *geo, void *user_data)
+// S57_iso8211LoadUpdate() callback - geo NULL: take out all obj of LNAM, else insert geo
+{
+    _update *upd = (_update *)user_data;
+    _cell   *c   = upd->c;
+
+    if (0 == g_strcmp0(objname, "M_COVR"))
+        upd->datcvr = TRUE;
+
+    if (NULL == geo) {
+        GPtrArray *objList = (GPtrArray *)g_hash_table_lookup(upd->lnam, lnam);
+        if (NULL == objList) {
+            PRINTF("WARNING: %s:%s not in cell %s\n", objname, lnam, c->filename->str);
+            return FALSE;
+        }
+
+        for (guint k=0; k<objList->len; ++k) {
+            S52_obj *obj  = (S52_obj *)g_ptr_array_index(objList, k);
+            S57_geo *ogeo = S52PLGETGEO(obj);
+
+            if (TRUE == _unlinkObj(c->lights_sector, obj)) {
+                upd->lights = TRUE;
+            } else {
+                // Note: obj with prio override might not be in its original bin
+                if (FALSE == _unlinkObj(c->renderBin[S52_PL_getDPRI(obj)][S52_PL_getFTYP(obj)], obj)) {
+                    TRAV_RBIN_ij(_unlinkObj(c->renderBin[i][j], obj));
+                }
+                SCAMIN_DIRTY(c);
+                MEM_DIRTY(c);
+            }
+
+            S52_CS_del(c->local, ogeo);
+            _delLegend(&c->legend, ogeo);
+
+            g_hash_table_insert(upd->geo, ogeo, ogeo);
+            g_ptr_array_add(upd->delObj, obj);
+        }
+
+        // this call free_func() - key still valid (geo not deleted yet)
+        g_hash_table_remove(upd->lnam, lnam);
+
+        return TRUE;
+    }
+
+    S52_obj *obj = _loadGeo(objname, geo);
+    if (NULL == obj)
+        return FALSE;
+
+#ifdef S52_USE_PROJ
+    if (TRUE == c->projDone)
+        S57_geo2prj(geo);
+#endif
+
+    if ((0<c->lights_sector->len) && (obj==g_ptr_array_index(c->lights_sector, c->lights_sector->len-1)))
+        upd->lights = TRUE;
+
+    g_hash_table_insert(upd->geo, geo, geo);
+    g_ptr_array_add(upd->newObj, obj);
+
+    return TRUE;
+}
+
+static void       __touchObj(S52_obj *obj, _update *upd)
+// collect neighbour of deleted / inserted obj
+{
+    S57_geo *geo = S52PLGETGEO(obj);
+
+    // skip new obj
+    if (NULL != g_hash_table_lookup(upd->geo, geo))
+        return;
+
+    // Note: touch is an union (S57data.c) - any getter return the ref
+    S57_geo *touch = S57_getTouchTOPMAR(geo);
+    if ((NULL!=touch) && (NULL!=g_hash_table_lookup(upd->geo, touch))) {
+        S57_unlinkGeo(geo, touch);
+        g_ptr_array_add(upd->nbrObj, obj);
+        return;
+    }
+
+#ifdef S52_USE_C_AGGR_C_ASSO
+    S57_geo *rel = S57_getRelationship(geo);
+    if ((NULL!=rel) && (NULL!=g_hash_table_lookup(upd->geo, rel)))
+        S57_unlinkGeo(geo, rel);
+#endif
+
+    // obj that could touch a new obj
+    ObjExt_t ext = S57_getExt(geo);
+    for (guint k=0; k<upd->newObj->len; ++k) {
+        ObjExt_t next = S57_getExt(S52PLGETGEO(g_ptr_array_index(upd->newObj, k)));
+        if ((next.N<ext.S) || (next.E<ext.W) || (next.S>ext.N) || (next.W>ext.E))
+            continue;
+
+        g_ptr_array_add(upd->nbrObj, obj);
+        return;
+    }
+
+    return;
+}
+
+static void       __resolveObj(S52_obj *obj, _cell *c)
+// re-parse CS of obj, move it if the prio change (override)
+{
+    S52_disPrio   prio  = S52_PL_getDPRI(obj);
+    S52ObjectType obj_t = S52_PL_getFTYP(obj);
+
+    S52_PL_resolveSMB(obj, NULL);
+    SCAMIN_DIRTY(c);
+    MEM_DIRTY(c);
+
+    if (prio != S52_PL_getDPRI(obj)) {
+        // Note: light sector are not in renderBin
+        if (TRUE == _unlinkObj(c->renderBin[prio][obj_t], obj))
+            g_ptr_array_add(c->renderBin[S52_PL_getDPRI(obj)][S52_PL_getFTYP(obj)], obj);
+    }
+
+    return;
+}
+
+static int        _updateCell(_update *upd)
+// after update: touch and resolve CS of new obj and their neighbour, then delete old obj
+{
+    _cell *c = upd->c;
+
+    TRAV_RBIN_ij(g_ptr_array_foreach(c->renderBin[i][j], (GFunc)__touchObj, upd));
+    g_ptr_array_foreach(c->lights_sector, (GFunc)__touchObj, upd);
+
+    g_ptr_array_foreach(upd->newObj, (GFunc)_S52_CS_touch, c->local);
+    g_ptr_array_foreach(upd->nbrObj, (GFunc)_S52_CS_touch, c->local);
+
+    g_ptr_array_foreach(upd->newObj, (GFunc)__resolveObj, c);
+    g_ptr_array_foreach(upd->nbrObj, (GFunc)__resolveObj, c);
+
+    PRINTF("DEBUG: %s: %i obj deleted, %i obj inserted, %i neighbour\n",
+           c->filename->str, upd->delObj->len, upd->newObj->len, upd->nbrObj->len);
+
+    // journal might have ref to deleted obj
+#ifdef S52_USE_CTX
+    for (guint k=0; k<c->jrnl->len; ++k)
+        _resetJrnl(&g_array_index(c->jrnl, _jrnl_t, k));
+#else
+    _resetJrnl(&c->jrnl);
+#endif
+
+    // free GL (VBO, DL) of deleted obj only
+    g_ptr_array_foreach(upd->delObj, (GFunc)_delObj, NULL);
+
     return TRUE;
 }
+#endif  // S52_USE_ISO8211
+
+DLL int    STD S52_loadUpdate(const char *updPath)
+// Note: the base cell must be loaded - OGR (UPDATES=APPLY) or ISO 8211
+{
+    S52_TR_CALL(S52_TR_loadUpdate, "s", updPath);
+
+    return_if_null(updPath);
+
+    int ret = FALSE;
+
+    S52_CHECK_MUTX_INIT;
+
+    PRINTF("%s\n", updPath);
+
+#ifdef S52_USE_ISO8211
+    {
+        gchar *fname    = g_strstrip(g_strdup(updPath));
+        gchar *baseName = g_path_get_basename(fname);
+        guint  len      = strlen(baseName);
+        guint  idx      = 0;
+        guint  updn     = 0;
+
+        // .00N --> .000
+        if (4 < len) {
+            updn = (guint)atoi(baseName+len-3);
+            g_snprintf(baseName+len-3, 4, "000");
+            idx = _isCellLoaded(baseName);
+        }
+
+        _cell *c = (0 == idx) ? NULL : (_cell*)g_ptr_array_index(_cellList, idx);
+
+        if (NULL == c) {
+            PRINTF("WARNING: base cell not loaded (%s)\n", fname);
+        } else if (updn <= c->updn) {
+            PRINTF("WARNING: update allready applied (%s, last update: %u)\n", fname, c->updn);
+        } else if (updn != c->updn+1) {
+            PRINTF("WARNING: update out of sequence (%s, last update: %u)\n", fname, c->updn);
+        } else {
+            _update upd;
+            _cell  *crntCell = _crntCell;
+
+            upd.c      = c;
+            upd.lnam   = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, (GDestroyNotify)_freeObjList);
+            upd.geo    = g_hash_table_new(g_direct_hash, g_direct_equal);
+            upd.delObj = g_ptr_array_new();
+            upd.newObj = g_ptr_array_new();
+            upd.nbrObj = g_ptr_array_new();
+            upd.lights = FALSE;
+            upd.datcvr = FALSE;
+
+            TRAV_RBIN_ij(g_ptr_array_foreach(upd.c->renderBin[i][j], (GFunc)__addLNAM, upd.lnam));
+            g_ptr_array_foreach(upd.c->lights_sector, (GFunc)__addLNAM, upd.lnam);
+
+            _crntCell = upd.c;
+#ifdef S52_USE_ARENA
+            // Note: deleted geo go back to the arena free list
+            S57_arena *arena = S57_setArena(upd.c->arena);
+#endif
+            ret       = S57_iso8211LoadUpdate(fname, c->edtn, _updateObj, &upd);
+#ifdef S52_USE_ARENA
+            S57_setArena(arena);
+#endif
+            _crntCell = crntCell;
+
+            if (TRUE == ret) {
+                c->updn = updn;
+                if (NULL != c->legend.dsid_updnstr)
+                    g_string_printf(c->legend.dsid_updnstr, "%u", updn);
+            }
+
+            _updateCell(&upd);
+
+#ifdef S52_USE_C_AGGR_C_ASSO
+            // Note: C_AGGR / C_ASSO of new obj are not linked
+            if (NULL != _lnamBBT) {
+                g_tree_destroy(_lnamBBT);
+                _lnamBBT = NULL;
+            }
+#endif
+
+            // _app() - compute HO Data Limit, only if M_COVR changed
+            if (TRUE == upd.datcvr) {
+                upd.c->hoDirty = TRUE;
+                _APP_DATCVR    = TRUE;
+            }
+            if (TRUE == upd.lights)
+                _CULL_Lights = TRUE;
+
+            g_hash_table_destroy(upd.lnam);
+            g_hash_table_destroy(upd.geo);
+            g_ptr_array_free(upd.delObj, TRUE);
+            g_ptr_array_free(upd.newObj, TRUE);
+            g_ptr_array_free(upd.nbrObj, TRUE);
+        }
+
+        g_free(baseName);
+        g_free(fname);
+    }
+#else
+    PRINTF("WARNING: S52_loadUpdate() need S52_USE_ISO8211\n");
+#endif  // S52_USE_ISO8211
+
+exit:
+    if (TRUE == ret)
+        _dirty(_GEN_CELL);
+
+    GMUTEXUNLOCK(&_mp_mutex);
+
+    return ret;
+}
 
 
 //---------------------------------------------------
@@ -3113,19 +4255,13 @@ static double    *_revArray(guint npt, double *ppt, double *outArr)
 
 // forward decl
 static S52ObjectHandle _newMarObj(const char *plibObjName, S52ObjectType objType, unsigned int xyznbr, double *xyz, const char *listAttVal);
+static S52ObjectHandle _delMarObj(S52ObjectHandle objH);
 //static S52_obj        *_updateGeo(S52_obj *obj, double *xyz);
 static S52_obj        *_updateGeo(S52_obj *obj, pt3 *pt);
-static int        _appSclbdy(GArray *sclbdyList, S57_geo *geoM_COVR, char intu)
+static int        _appSclbdy(GArray *sclbdyList, S57_geo *geoM_COVR)
 // SCALE BOUNDARIES: system generated CS DATCVR01-3
 // generate a sclbdy obj for a M_COVR:CATCOV=1 geo obj
 {
-    static char _intu = 0;
-
-    if (_intu != intu) {
-        g_array_append_val(sclbdyList, INTU_SEP);
-        _intu = intu;
-    }
-
     guint   npt = 0;
     double *ppt = NULL;
     S57_getGeoData(geoM_COVR, 0, &npt, &ppt);
@@ -3151,178 +4287,231 @@ static int        _appSclbdy(GArray *sclbdyList, S57_geo *geoM_COVR, char intu)
     return TRUE;
 }
 
-static int        _appHODATA(GArray *sclbdyList)
-// compute HO data limit CS DATCVR01-2
-// Note: will populate sclbdyList for further processing in _appSCLBDU()
+static int        _getM_COVR(_cell *c)
+// collect M_COVR:CATCOV=1 of this cell
 {
-    // combine HODATA ==> union gluTessProperty(tobj, ..);
-    // GLU_TESS_WINDING_NONZERO or GLU_TESS_WINDING_POSITIVE winding rules.
-
-    // begin union
-    S52_GLU_begUnion();
+    // M_COVR:CATCOV=1, link to PLib_AUX "m_covr" as ";OP(3OD11060);LC(HODATA01)"
+    // (ie 3 - S52_PRIO_AREA_2, Over Radar, Display Base)
+    //LUPT   40LU00102NILm_covrA00003OPLAIN_BOUNDARIES
+    //LUPT   45LU00357NILm_covrA00003OSYMBOLIZED_BOUNDARIES
 
-    // skip Mariners Cell
-    //for (guint i=0; i<_cellList->len; ++i) {
-    for (guint i=1; i<_cellList->len; ++i) {
-        _cell *c = (_cell*) g_ptr_array_index(_cellList, i);
-
-        // M_COVR:CATCOV=1, link to PLib_AUX "m_covr" as ";OP(3OD11060);LC(HODATA01)"
-        // (ie 3 - S52_PRIO_AREA_2, Over Radar, Display Base)
-        //LUPT   40LU00102NILm_covrA00003OPLAIN_BOUNDARIES
-        //LUPT   45LU00357NILm_covrA00003OSYMBOLIZED_BOUNDARIES
+    // M_COVR:CATCOV=2, link to PLib
+    // LUPT   40LU00102NILM_COVRA00001SPLAIN_BOUNDARIES
+    // LUPT   45LU00357NILM_COVRA00001SSYMBOLIZED_BOUNDARIES
+    GPtrArray *rbin = c->renderBin[S52_PRIO_GROUP1][S52_AREAS];
 
-        // M_COVR:CATCOV=2, link to PLib
-        // LUPT   40LU00102NILM_COVRA00001SPLAIN_BOUNDARIES
-        // LUPT   45LU00357NILM_COVRA00001SSYMBOLIZED_BOUNDARIES
-        GPtrArray *rbin = c->renderBin[S52_PRIO_GROUP1][S52_AREAS];
-
-        for (guint idx=0; idx<rbin->len; ++idx) {
-            S52_obj *obj = (S52_obj *)g_ptr_array_index(rbin, idx);
-            S57_geo *geo = S52_PL_getGeo(obj);
+    g_ptr_array_set_size(c->m_covr, 0);
+    for (guint idx=0; idx<rbin->len; ++idx) {
+        S52_obj *obj = (S52_obj *)g_ptr_array_index(rbin, idx);
+        S57_geo *geo = S52_PL_getGeo(obj);
 
-            if (0 == g_strcmp0(S57_getName(geo), "M_COVR")) {
-                GString *catcovstr = S57_getAttVal(geo, "CATCOV");
-                if ((NULL!=catcovstr) && ('1'==*catcovstr->str)) {
-                    // add this M_COVR to HO data limit set
-                    S52_GLU_addUnion(geo);
-
-                    // SCALE BOUNDARIES: system generated CS DATCVR01-3
-                    // add this M_COVR to scale Boundary if
-                    // intersect smaller nav purp cells
-                    if (TRUE == _intersectM_COVR(c, geo)) {
-                        _appSclbdy(sclbdyList, geo, *c->legend.dsid_intustr->str);
-                    }
-                }
+        if (0 == g_strcmp0(S57_getName(geo), "M_COVR")) {
+            GString *catcovstr = S57_getAttVal(geo, "CATCOV");
+            if ((NULL!=catcovstr) && ('1'==*catcovstr->str)) {
+                g_ptr_array_add(c->m_covr, geo);
             }
         }
     }
 
-    // get union of HO data
-    // FIXME: can Union output more than 1 poly
-    // (ie: 2 non-overlap poly!)
-    guint   npt = 0;
-    double *ppt = NULL;
-    S52_GLU_endUnion(&npt, &ppt);
-    if (0 == npt)
-        return FALSE;
-
-    // reverse Union output - CCW -> CW (S57 winding)
-    double rev[npt*3];
-    ppt = _revArray(npt, ppt, rev);
+    return TRUE;
+}
 
-    // PLib AUX link to "m_covr" ;OP(3OD11060);LC(HODATA01)
-    _HODATAUnion = _newMarObj("m_covr", S52_AREAS, npt, NULL, "CATCOV:1");
-    if (FALSE != _HODATAUnion) {
-        S52_obj *obj = S52_PL_isObjValid(_HODATAUnion);
-        _updateGeo(obj, (pt3*)ppt);
+static int        _getRings(GPtrArray *geoList, GArray *vertex, GArray *nvertex)
+// outer ring of each geo in geoList
+{
+    g_array_set_size(vertex,  0);
+    g_array_set_size(nvertex, 0);
 
-        // FIXME: optimisation: unproject
-        //S57_geo *geo = S52_PL_getGeo(obj);
-        //_setExt(geo, npt, (double*)rev);
-        // then:
-        //   - get extent
-        //   - unproj
-        //   - set ext
-
-         //ObjExt_t ext   = S57_getExt(geo);
-         //S57_geo *geoSB = S52_PL_getGeo(objSB);
-         //S57_setExt(geoSB, ext.W, ext.S, ext.E, ext.N);
-    } else {
-        PRINTF("WARNING: 'm_cover' fail (check PLib AUX)\n");
-        g_assert(0);
+    for (guint i=0; i<geoList->len; ++i) {
+        guint   npt = 0;
+        double *ppt = NULL;
+        if ((TRUE==S57_getGeoData((S57_geo*)g_ptr_array_index(geoList, i), 0, &npt, &ppt)) && (0<npt)) {
+            g_array_append_vals(vertex,  ppt, npt);
+            g_array_append_val (nvertex, npt);
+        }
     }
 
-    return TRUE;
+    return nvertex->len;
 }
 
-static int        _appSclbdU(GArray *sclbdyList, GArray *sclbdUList)
-// SCALE BOUNDARIES: system generated CS DATCVR01-3
+static int        _appDATCVR(void)
+// HO data limit: send M_COVR:CATCOV=1 of new / updated cell to the HO thread
+// scale boundary: redo sclbdy of cell that change (ie a smaller nav purp cell (un)loaded)
+// Note: the union it self is done by the HO thread (see _appHOUnion())
 {
-    //
-    // FIXME: experimental: get union of sclbdy for a nav purp (INTU)
-    // CSG - Computational Solid Geometry
-    //*
-    for (guint i=0; i<sclbdyList->len; ++i) {
-        // begin sclbdy union
-        S52_GLU_begUnion();
-
-        S52ObjectHandle sclbdyH = (S52ObjectHandle) g_array_index(sclbdyList, unsigned int, i);
-        while ((INTU_SEP!=sclbdyH) && (i<sclbdyList->len)) {
-        // FIXME: compare INTU !!!
-        //while (i < sclbdyList->len) {
-            S52_obj *obj = S52_PL_isObjValid(sclbdyH);
-            S57_geo *geo = S52_PL_getGeo(obj);
+    // sclbdy obj of unloaded cell
+    for (guint i=0; i<_sclbdyDel->len; ++i) {
+        S52ObjectHandle objH = g_array_index(_sclbdyDel, S52ObjectHandle, i);
+        if (0 != _delMarObj(objH))
+            g_assert(0);
+    }
+    g_array_set_size(_sclbdyDel, 0);
 
-            S52_GLU_addUnion(geo);
-            // all obj after i are of sclbdyH, union them
-            PRINTF("DEBUG: add sclbdy from %s:%i\n", S57_getName(geo), S57_getS57ID(geo));
+    GArray    *vertex  = g_array_new(FALSE, FALSE, sizeof(pt3));
+    GArray    *nvertex = g_array_new(FALSE, FALSE, sizeof(guint));
+    GPtrArray *sclbd   = g_ptr_array_new();
 
-            sclbdyH = (S52ObjectHandle) g_array_index(sclbdyList, unsigned int, ++i);
+    // skip Mariners Cell
+    for (guint i=1; i<_cellList->len; ++i) {
+        _cell *c = (_cell*) g_ptr_array_index(_cellList, i);
+
+        // HO data limit - CS DATCVR01-2
+        if (TRUE == c->hoDirty) {
+            _getM_COVR(c);
+
+            if (0 < _getRings(c->m_covr, vertex, nvertex)) {
+                S52_HO_setCov(S52_HO_HODATA, c, vertex, nvertex);
+                c->hoData = TRUE;
+            } else {
+                if (TRUE == c->hoData)
+                    S52_HO_delCov(S52_HO_HODATA, c);
+                c->hoData = FALSE;
+            }
         }
 
-        // get union of sclbdy
-        // FIXME: what if more than 1 poly
-        guint   npt = 0;
-        double *ppt = NULL;
-        S52_GLU_endUnion(&npt, &ppt);
-        if (0 == npt) {
-            PRINTF("DEBUG: 'sclbdU' no poly\n");
-            continue;
-        } else {
-            PRINTF("DEBUG: 'sclbdU' union\n");
+        // SCALE BOUNDARIES: system generated CS DATCVR01-3
+        // M_COVR that intersect smaller nav purp cells
+        g_ptr_array_set_size(sclbd, 0);
+        for (guint j=0; j<c->m_covr->len; ++j) {
+            S57_geo *geo = (S57_geo *)g_ptr_array_index(c->m_covr, j);
+            if (TRUE == _intersectM_COVR(c, geo))
+                g_ptr_array_add(sclbd, geo);
         }
 
-        // reverse Union output - CCW -> CW (S57 winding)
-        double rev[npt*3];
-        ppt = _revArray(npt, ppt, rev);
+        // same as last time
+        if ((FALSE==c->hoDirty) && (sclbd->len==c->sclbdGeo->len) &&
+            (0==memcmp(sclbd->pdata, c->sclbdGeo->pdata, sizeof(gpointer)*sclbd->len)))
+            continue;
 
-        // PLib AUX link to "sclbdU"
-        S52ObjectHandle sclbdyUnion = _newMarObj("sclbdU", S52_AREAS, npt, NULL, NULL);
-        if (FALSE != sclbdyUnion) {
-            S52_obj *obj = S52_PL_isObjValid(sclbdyUnion);
-            _updateGeo(obj, (pt3*)ppt);
+        c->hoDirty = FALSE;
 
-            // FIXME: optimisation: unproject
-            S57_geo *geo = S52_PL_getGeo(obj);
-            //_setExt(geo, npt, (double*)rev);
-            // then:
-            //   - get extent
-            //   - unproj
-            //   - set ext
-
-            //ObjExt_t ext   = S57_getExt(geo);
-            //S57_geo *geoSB = S52_PL_getGeo(objSB);
-            //S57_setExt(geoSB, ext.W, ext.S, ext.E, ext.N);
-
-            g_array_append_val(sclbdUList, sclbdyUnion);
-            PRINTF("DEBUG: add sclbdU from %s:%i\n", S57_getName(geo), S57_getS57ID(geo));
-        } else {
-            PRINTF("WARNING: 'sclbdU' fail (check PLib AUX)\n");
-            g_assert(0);
+        for (guint j=0; j<c->sclbdyH->len; ++j) {
+            S52ObjectHandle objH = g_array_index(c->sclbdyH, S52ObjectHandle, j);
+            if (0 != _delMarObj(objH))
+                g_assert(0);
+        }
+        g_array_set_size(c->sclbdyH, 0);
+        g_ptr_array_set_size(c->sclbdGeo, 0);
+
+        for (guint j=0; j<sclbd->len; ++j) {
+            S57_geo *geo = (S57_geo *)g_ptr_array_index(sclbd, j);
+            _appSclbdy(c->sclbdyH, geo);
+            g_ptr_array_add(c->sclbdGeo, geo);
         }
 
+        // union of sclbdy for this INTU
+        int tree = 0;
+        if ((NULL!=c->legend.dsid_intustr) && ('1'<=*c->legend.dsid_intustr->str) && (*c->legend.dsid_intustr->str<='6'))
+            tree = *c->legend.dsid_intustr->str - '0';
+
+        if ((0!=c->hoTree) && ((tree!=c->hoTree) || (0==sclbd->len)))
+            S52_HO_delCov(c->hoTree, c);
+        c->hoTree = 0;
 
+        if ((0!=tree) && (0 < _getRings(sclbd, vertex, nvertex))) {
+            S52_HO_setCov(tree, c, vertex, nvertex);
+            c->hoTree = tree;
+        }
     }
-    //*/
+
+    g_array_free(vertex,  TRUE);
+    g_array_free(nvertex, TRUE);
+    g_ptr_array_free(sclbd, TRUE);
 
     return TRUE;
 }
 
-static int        _appMoveObj(_cell *c, GPtrArray *tmpRenderBin)
+static S52ObjectHandle _newUnionObj(const char *plibObjName, guint npt, pt3 *pt, const char *listAttVal)
+// one ring of a union (CCW exterior) into a mariner obj (S57 winding - CW exterior, closed)
 {
-    for (guint idx=0; idx<tmpRenderBin->len; ++idx) {
-        S52_obj      *obj   = (S52_obj *)g_ptr_array_index(tmpRenderBin, idx);
-        S52_disPrio   prio  = S52_PL_getDPRI(obj);
-        S52ObjectType obj_t = S52_PL_getFTYP(obj);
-
-        g_ptr_array_add(c->renderBin[prio][obj_t], obj);
+    S52ObjectHandle objH = _newMarObj(plibObjName, S52_AREAS, npt+1, NULL, listAttVal);
+    if (FALSE == objH) {
+        PRINTF("WARNING: '%s' fail (check PLib AUX)\n", plibObjName);
+        g_assert(0);
+        return FALSE;
     }
-    g_ptr_array_set_size(tmpRenderBin, 0);
 
-    return TRUE;
+    // reverse Union output - CCW -> CW (S57 winding)
+    pt3 *rev = g_new(pt3, npt+1);
+    _revArray(npt, (double*)pt, (double*)rev);
+    rev[npt] = rev[0];
+
+    _updateGeo(S52_PL_isObjValid(objH), rev);
+
+    g_free(rev);
+
+    return objH;
 }
 
-static void       __findOPrioObj(GPtrArray *rbin)
+static int        _appHOUnion(guint gen)
+// replace m_covr / sclbdU obj by the last union published by the HO thread
+// Note: a union published after gen is picked up again at the next frame
+{
+    g_atomic_int_set(&_HOgen, gen);
+
+    // del previous m_covr / sclbdU obj
+    for (guint i=0; i<_HODATAList->len; ++i) {
+        S52ObjectHandle objH = g_array_index(_HODATAList, S52ObjectHandle, i);
+        if (0 != _delMarObj(objH))
+            g_assert(0);
+    }
+    g_array_set_size(_HODATAList, 0);
+
+    for (guint i=0; i<_sclbdUList->len; ++i) {
+        S52ObjectHandle objH = g_array_index(_sclbdUList, S52ObjectHandle, i);
+        if (0 != _delMarObj(objH))
+            g_assert(0);
+    }
+    g_array_set_size(_sclbdUList, 0);
+
+    GArray *vertex  = g_array_new(FALSE, FALSE, sizeof(pt3));
+    GArray *nvertex = g_array_new(FALSE, FALSE, sizeof(guint));
+
+    for (int tree=0; tree<S52_HO_TREE_NBR; ++tree) {
+        if (FALSE == S52_HO_getUnion(tree, vertex, nvertex))
+            continue;
+
+        pt3 *pt = (pt3*)vertex->data;
+        for (guint i=0; i<nvertex->len; ++i) {
+            guint npt = g_array_index(nvertex, guint, i);
+
+            if (S52_HO_HODATA == tree) {
+                // PLib AUX link to "m_covr" ;OP(3OD11060);LC(HODATA01)
+                S52ObjectHandle objH = _newUnionObj("m_covr", npt, pt, "CATCOV:1");
+                if (FALSE != objH)
+                    g_array_append_val(_HODATAList, objH);
+            } else {
+                // PLib AUX link to "sclbdU"
+                S52ObjectHandle objH = _newUnionObj("sclbdU", npt, pt, NULL);
+                if (FALSE != objH)
+                    g_array_append_val(_sclbdUList, objH);
+            }
+
+            pt += npt;
+        }
+    }
+
+    g_array_free(vertex,  TRUE);
+    g_array_free(nvertex, TRUE);
+
+    return TRUE;
+}
+
+static int        _appMoveObj(_cell *c, GPtrArray *tmpRenderBin)
+{
+    for (guint idx=0; idx<tmpRenderBin->len; ++idx) {
+        S52_obj      *obj   = (S52_obj *)g_ptr_array_index(tmpRenderBin, idx);
+        S52_disPrio   prio  = S52_PL_getDPRI(obj);
+        S52ObjectType obj_t = S52_PL_getFTYP(obj);
+
+        g_ptr_array_add(c->renderBin[prio][obj_t], obj);
+    }
+    g_ptr_array_set_size(tmpRenderBin, 0);
+
+    return TRUE;
+}
+
+static void       __findOPrioObj(GPtrArray *rbin)
 // find all obj that have prio override and move to _tmpRenderBin
 {
     guint idx = 0;
@@ -3345,7 +4534,6 @@ static void       __findOPrioObj(GPtrArray *rbin)
     return;
 }
 
-static S52ObjectHandle _delMarObj(S52ObjectHandle objH);  // forward decl
 static int        _app(void)
 // FIXME: doCSMar Mariner Only - time the cost of APP
 // -OR-
@@ -3367,10 +4555,18 @@ static int        _app(void)
             TRAV_RBIN_ij(__findOPrioObj(c->renderBin[i][j]));
 
             _appMoveObj(c, _tmpRenderBin);
+
+            // CS can reset SCAMIN (DEPCNT02, UDWHAZ03)
+            SCAMIN_DIRTY(c);
+            MEM_DIRTY(c);
         }
 
         // done rebuilding CS
         _APP_CS = FALSE;
+
+#ifdef S52_USE_CTX
+        S52_MP_getCSKey(_csKey);
+#endif
     }
 
     // 2.3 - texApha, when raster is bathy,
@@ -3390,36 +4586,18 @@ static int        _app(void)
     // CS DATCVR01-2/3: compute HO Data Limit, scale boundary, ..
     //
     if (TRUE == _APP_DATCVR) {
-        // del previous _HODATAUnion obj
-        if (FALSE != _HODATAUnion) {
-            _HODATAUnion = _delMarObj(_HODATAUnion);
-        }
-
-        // flush old scale boudary obj
-        for (guint i=0; i<_sclbdyList->len; ++i) {
-            S52ObjectHandle objH = (S52ObjectHandle) g_array_index(_sclbdyList, unsigned int, i);
-            if (0 != _delMarObj(objH))
-                g_assert(0);
-        }
-        g_array_set_size(_sclbdyList, 0);
-
-        // flush old scale boundary Union obj
-        for (guint i=0; i<_sclbdUList->len; ++i) {
-            S52ObjectHandle objH = (S52ObjectHandle) g_array_index(_sclbdUList, unsigned int, i);
-            if (0 != _delMarObj(objH))
-                g_assert(0);
-        }
-        g_array_set_size(_sclbdUList, 0);
-
-        // compute HO data limit union - system generated CS DATCVR01-2
-        if (TRUE == _appHODATA(_sclbdyList)) {
-            // compute scale boundaries union - system generated CS DATCVR01-3
-            _appSclbdU(_sclbdyList, _sclbdUList);
-        }
+        // send cell coverage that changed to the HO thread, redo sclbdy
+        _appDATCVR();
 
         _APP_DATCVR = FALSE;
     }
 
+    // pick up union from the HO thread (incremental - see S52HO.c)
+    // Note: only a frame holding the writer lock (_drawMutate() saw the new gen)
+    if ((TRUE==_drawExcl) && ((guint)_HOgen!=_HOgenSnap)) {
+        _appHOUnion(_HOgenSnap);
+    }
+
     // debug
     //PRINTF("_app(): -1-\n");
 
@@ -3430,9 +4608,7 @@ static int        _resetJournal(void)
 {
     for (guint i=0; i<_cellList->len; ++i) {
         _cell *c = (_cell*) g_ptr_array_index(_cellList, i);
-        g_ptr_array_set_size(c->objList_supp, 0);
-        g_ptr_array_set_size(c->objList_over, 0);
-        g_ptr_array_set_size(c->textList,     0);
+        _resetJrnl(JRNL(c));
     }
 
     return TRUE;
@@ -3543,9 +4719,9 @@ static int        _cullObj(_cell *c, GPtrArray *rbin)
         // store object according to radar flags
         // Note: default to 'over' if something else than 'supp'
         if (S52_RAD_SUPP == S52_PL_getRPRI(obj)) {
-            g_ptr_array_add(c->objList_supp, obj);
+            g_ptr_array_add(JRNL(c)->objList_supp, obj);
         } else {
-            g_ptr_array_add(c->objList_over, obj);
+            g_ptr_array_add(JRNL(c)->objList_over, obj);
             S57_geo *geo = S52_PL_getGeo(obj);
 
             // switch OFF highlight if user acknowledge Alarm / Indication by
@@ -3559,7 +4735,7 @@ static int        _cullObj(_cell *c, GPtrArray *rbin)
 
         // if this object has TX or TE, draw text last (on top)
         if (TRUE == S52_PL_hasText(obj)) {
-            g_ptr_array_add(c->textList, obj);
+            g_ptr_array_add(JRNL(c)->textList, obj);
             //PRINTF("DEBUG: add text %p\n", obj);
         }
     }
@@ -3567,10 +4743,131 @@ static int        _cullObj(_cell *c, GPtrArray *rbin)
     return TRUE;
 }
 
+#ifdef S52_USE_SCAMIN_BIN
+static gint       _cmpScamin(gconstpointer a, gconstpointer b)
+// SCAMIN descending - same SCAMIN in drawing order
+{
+    const _scaminRec *ra = (const _scaminRec *)a;
+    const _scaminRec *rb = (const _scaminRec *)b;
+
+    if (ra->scamin > rb->scamin) return -1;
+    if (ra->scamin < rb->scamin) return  1;
+
+    return (ra->idx < rb->idx) ? -1 : 1;
+}
+
+static gint       _cmpIdx(gconstpointer a, gconstpointer b)
+{
+    guint ia = *(const guint *)a;
+    guint ib = *(const guint *)b;
+
+    return (ia < ib) ? -1 : (ia > ib);
+}
+
+static int        _setScaminBin(_cell *c)
+// (re)build the cull record of each renderBin of this cell
+{
+    for (S52_disPrio i=S52_PRIO_NODATA; i<S52_PRIO_NUM; ++i) {
+        for (S52ObjectType j=S52__META; j<S52_N_OBJ; ++j) {
+            GPtrArray *rbin = c->renderBin[i][j];
+
+            if (NULL == c->scaminBin[i][j])
+                c->scaminBin[i][j] = g_array_new(FALSE, FALSE, sizeof(_scaminRec));
+            g_array_set_size(c->scaminBin[i][j], rbin->len);
+
+            for (guint idx=0; idx<rbin->len; ++idx) {
+                S52_obj    *obj = (S52_obj *)g_ptr_array_index(rbin, idx);
+                _scaminRec *rec = &g_array_index(c->scaminBin[i][j], _scaminRec, idx);
+
+                // Note: obj on BASE are never suppressed (see S52_GL_isSupp())
+                rec->scamin = (DISPLAYBASE == S52_PL_getDISC(obj)) ? INFINITY : S57_getScamin(S52PLGETGEO(obj));
+                rec->idx    = idx;
+            }
+
+            g_array_sort(c->scaminBin[i][j], _cmpScamin);
+        }
+    }
+
+    g_atomic_int_set(&c->scaminDirty, FALSE);
+
+    return TRUE;
+}
+
+static int        _cullSCAMIN(_cell *c, GPtrArray *rbin, GArray *sbin)
+// cull only obj not suppressed by SCAMIN - binary search the first obj suppressed
+// at this scale, then restore drawing order of the other for _cullObj()
+{
+    // renderBin changed without SCAMIN_DIRTY() - rebuild
+    if (sbin->len != rbin->len) {
+#ifdef S52_USE_CTX
+        // the frame of an other context might be reading it - cull all obj instead
+        PRINTF("WARNING: scaminBin out of sync (%u/%u)\n", sbin->len, rbin->len);
+        return _cullObj(c, rbin);
+#else
+        PRINTF("WARNING: scaminBin out of sync (%u/%u), rebuild\n", sbin->len, rbin->len);
+        _setScaminBin(c);
+#endif
+    }
+
+    double     scale = S52_GL_getSCAMIN();
+    _scaminRec *rec  = (_scaminRec *)sbin->data;
+
+    // n: number of obj with scamin >= scale
+    guint n = 0;
+    guint m = sbin->len;
+    while (n < m) {
+        guint mid = (n + m) / 2;
+        if (rec[mid].scamin < scale)
+            m = mid;
+        else
+            n = mid + 1;
+    }
+
+    // stat - same as if S52_GL_isSupp() had been called on each obj
+    _nTotal += sbin->len - n;
+    _nCull  += sbin->len - n;
+    S52_GL_addSupp(sbin->len - n);
+
+    if (0 == n)
+        return TRUE;
+
+    if (n == rbin->len)
+        return _cullObj(c, rbin);
+
+    g_array_set_size(_scaminIdx, 0);
+    for (guint k=0; k<n; ++k)
+        g_array_append_val(_scaminIdx, rec[k].idx);
+    g_array_sort(_scaminIdx, _cmpIdx);
+
+    g_ptr_array_set_size(_scaminObj, 0);
+    for (guint k=0; k<n; ++k)
+        g_ptr_array_add(_scaminObj, g_ptr_array_index(rbin, g_array_index(_scaminIdx, guint, k)));
+
+    return _cullObj(c, _scaminObj);
+}
+#endif  // S52_USE_SCAMIN_BIN
+
 static int        _cullLayer(_cell *c)
 // one cell, cull object outside the view and object supressed
 // object culled are not inserted in the list of object to draw (journal)
 {
+#ifdef S52_USE_SCAMIN_BIN
+    // Note: SCAMIN filter OFF - visit all obj
+    int scaminBin = (TRUE == (int) S52_MP_get(S52_MAR_SCAMIN));
+#ifdef S52_USE_CTX
+    // first frame after a change rebuild it, frame of other context wait for it
+    if ((TRUE==scaminBin) && (TRUE==g_atomic_int_get(&c->scaminDirty))) {
+        GSCAMINLOCK(&_scamin_mutex);
+        if (TRUE == g_atomic_int_get(&c->scaminDirty))
+            _setScaminBin(c);
+        GSCAMINUNLOCK(&_scamin_mutex);
+    }
+#else
+    if ((TRUE==scaminBin) && (TRUE==c->scaminDirty))
+        _setScaminBin(c);
+#endif
+#endif
+
     // layer 0-8
     for (S52_disPrio i=S52_PRIO_NODATA; i<S52_PRIO_MARINR; ++i) {
     // FIXME: Chart No 1 put object on layer 9 (Mariners' Objects)
@@ -3578,7 +4875,12 @@ static int        _cullLayer(_cell *c)
         for (S52ObjectType j=S52__META; j<S52_N_OBJ; ++j) {
 
             GPtrArray *c_rbin = c->renderBin[i][j];
-            _cullObj(c, c_rbin);
+#ifdef S52_USE_SCAMIN_BIN
+            if (TRUE == scaminBin)
+                _cullSCAMIN(c, c_rbin, c->scaminBin[i][j]);
+            else
+#endif
+                _cullObj(c, c_rbin);
 
             //_cullObj(c_rbin, c);
             //foreach(c->renderBin[i][j], _cullObj, c);
@@ -3729,7 +5031,7 @@ static int        _drawLayer(ObjExt_t ext, int layer)
 
                         // doing this after the draw because draw() will parse the text
                         if (TRUE == S52_PL_hasText(obj))
-                            g_ptr_array_add(c->textList, obj); // not tested
+                            g_ptr_array_add(JRNL(c)->textList, obj); // not tested
 
                     }
                 }
@@ -4031,7 +5333,7 @@ static int        _draw(void)
         }
 
         // draw under radar
-        g_ptr_array_foreach(c->objList_supp, (GFunc)S52_GL_draw, NULL);
+        g_ptr_array_foreach(JRNL(c)->objList_supp, (GFunc)S52_GL_draw, NULL);
 
         // USE_RASTER/RADAR
 #if defined(S52_USE_GL2)    || defined(S52_USE_GLES2)
@@ -4046,14 +5348,16 @@ static int        _draw(void)
 #endif
 #endif
         // draw over radar
-        g_ptr_array_foreach(c->objList_over, (GFunc)S52_GL_draw, NULL);
+        g_ptr_array_foreach(JRNL(c)->objList_over, (GFunc)S52_GL_draw, NULL);
 
         // end scissor test
         S52_GL_setScissor(0, 0, -1, -1);
 
         // draw text
         // FIXME: implicit call to S52_PL_hasText() again
-        g_ptr_array_foreach(c->textList,     (GFunc)S52_GL_drawText, NULL);
+        gdouble t0 = g_timer_elapsed(_timer, NULL);
+        g_ptr_array_foreach(JRNL(c)->textList,     (GFunc)S52_GL_drawText, NULL);
+        _drawTime.text += (g_timer_elapsed(_timer, NULL) - t0) * 1000.0;
     }
 
     return TRUE;
@@ -4061,17 +5365,15 @@ static int        _draw(void)
 
 DLL int    STD S52_draw(void)
 {
+    S52_TR_CALL(S52_TR_draw, "");
+
     // debug
     //PRINTF("DRAW: start ..\n");
 
     int ret = FALSE;
 
     // do not wait if an other thread is allready drawing
-#if (defined(S52_USE_ANDROID) || defined(_MINGW))
-    if (FALSE == g_static_mutex_trylock(&_mp_mutex)) {
-#else
-    if (FALSE == g_mutex_trylock(&_mp_mutex)) {
-#endif
+    if (FALSE == _drawTryLock(FALSE)) {
         PRINTF("WARNING: trylock failed\n");
         //goto exit;
         return FALSE;
@@ -4086,6 +5388,13 @@ DLL int    STD S52_draw(void)
 
     g_timer_reset(_timer);
 
+    _drawTime.app  = 0.0;
+    _drawTime.cull = 0.0;
+    _drawTime.draw = 0.0;
+    _drawTime.text = 0.0;
+
+    // prim / VBO built by this frame change the memory of cell in view
+    guint memGen = S52_GL_getMemGen();
 
     // debug
     //PRINTF("DRAW: start ..\n");
@@ -4096,7 +5405,10 @@ DLL int    STD S52_draw(void)
 
         //////////////////////////////////////////////
         // APP:  .. update object
+        gdouble t0 = g_timer_elapsed(_timer, NULL);
         _app();
+        gdouble t1 = g_timer_elapsed(_timer, NULL);
+        _drawTime.app = (t1 - t0) * 1000.0;
 
         //////////////////////////////////////////////
         // CULL: .. supress display of object (eg outside view)
@@ -4132,10 +5444,25 @@ DLL int    STD S52_draw(void)
         //    ext.W = ext.W - 360.0;
         //}
 
+#ifdef S52_USE_CHART_MANAGER
+        {   // unload LRU cell queued by the last frame (writer lock only),
+            // then queue cell near the view and LRU cell if over budget
+            if (TRUE == _drawExcl)
+                S52_CM_unload(_doneCell);
+
+            double cLat, cLon, rNM, north;
+            S52_GL_getView(&cLat, &cLon, &rNM, &north);
+            S52_CM_update(ext, rNM);
+        }
+#endif
+
         _cull(ext);
 
         _cullLights();
 
+        gdouble t2 = g_timer_elapsed(_timer, NULL);
+        _drawTime.cull = (t2 - t1) * 1000.0;
+
         //PRINTF("S52_draw() .. -1.3-\n");
 
         //////////////////////////////////////////////
@@ -4179,6 +5506,21 @@ DLL int    STD S52_draw(void)
 
         ret = S52_GL_end(S52_GL_DRAW);
 
+        _drawTime.draw = (g_timer_elapsed(_timer, NULL) - t2) * 1000.0 - _drawTime.text;
+
+#ifdef S52_USE_CHART_MANAGER
+        // prim and VBO of a new cell are only made by its first draw - charge them now
+        _CM_resample(ext);
+#endif
+
+        if (memGen != S52_GL_getMemGen()) {
+            for (guint i=_cellList->len-1; i>0; --i) {
+                _cell *c = (_cell*) g_ptr_array_index(_cellList, i);
+                if (TRUE == _intersectEXT(c->geoExt, ext))
+                    MEM_DIRTY(c);
+            }
+        }
+
         // for each cell, not after all cell,
         // because city name appear twice
         // FIXME: cull object of overlapping region of cell of DIFFERENT nav pourpose
@@ -4211,7 +5553,13 @@ exit:
     }
 #endif
 
-    GMUTEXUNLOCK(&_mp_mutex);
+    // scene drawn - clean, but layer 9 is gone with the old FB
+    if (TRUE == ret) {
+        _drawnSnap(_drawn->draw);
+        g_atomic_int_set(&_drawn->fb, TRUE);
+    }
+
+    _drawUnlock();
 
     return ret;
 }
@@ -4323,14 +5671,12 @@ static int        _drawLast(GPtrArray *rbin)
 
 DLL int    STD S52_drawLast(void)
 {
+    S52_TR_CALL(S52_TR_drawLast, "");
+
     int ret = FALSE;
 
-#if (defined(S52_USE_ANDROID) || defined(_MINGW))
     // do not wait if an other thread is allready drawing
-    if (FALSE == g_static_mutex_trylock(&_mp_mutex)) {
-#else
-    if (FALSE == g_mutex_trylock(&_mp_mutex)) {
-#endif
+    if (FALSE == _drawTryLock(TRUE)) {
         PRINTF("WARNING: trylock failed\n");
         return FALSE;
     }
@@ -4349,51 +5695,584 @@ DLL int    STD S52_drawLast(void)
 
     g_timer_reset(_timer);
 
-    if (TRUE == S52_GL_begin(S52_GL_LAST)) {
+    _drawTime.last = 0.0;
+
+    if (TRUE == S52_GL_begin(S52_GL_LAST)) {
+
+        ////////////////////////////////////////////////////////////////////
+        // APP: no CS code for Mariner - all in GL now
+        //_app();
+
+        // check stray vessel (occur when s52ais/gpsd restart)
+        if (0.0 != S52_MP_get(S52_MAR_DISP_VESSEL_DELAY)) {
+            GPtrArray *rbinPT = _marinerCell->renderBin[S52_PRIO_MARINR][S52_POINT];
+            g_ptr_array_foreach(rbinPT, _delOldVessel, rbinPT);
+            GPtrArray *rbinLN = _marinerCell->renderBin[S52_PRIO_MARINR][S52_LINES];
+            g_ptr_array_foreach(rbinLN, _delOldVessel, rbinLN);
+        }
+
+        ////////////////////////////////////////////////////////////////////
+        // CULL / DRAW:
+        //
+        _nCull = 0;
+        _nTotal= 0;
+
+        // Mariners' (layer 9 - Last)
+        //ret = _drawLast();
+        for (S52ObjectType j=S52__META; j<S52_N_OBJ; ++j) {
+            _drawLast(_marinerCell->renderBin[S52_PRIO_MARINR][j]);
+        }
+
+        S52_GL_end(S52_GL_LAST);
+
+        // scene drawn - clean
+        _drawnSnap(_drawn->last);
+        g_atomic_int_set(&_drawn->fb, FALSE);
+
+        _drawTime.last = g_timer_elapsed(_timer, NULL) * 1000.0;
+    } else {
+        PRINTF("WARNING: S52_GL_begin() failed\n");
+    }
+
+exit:
+
+    EGL_END(LAST);
+
+#ifdef S52_DEBUG
+    {
+        //gdouble sec = g_timer_elapsed(_timer, NULL);
+        //PRINTF("DRAWLAST: %.0f msec (cull/total) %i/%i\n", sec * 1000, _nCull, _nTotal);
+    }
+#endif
+
+    _drawUnlock();
+
+    return ret;
+}
+
+DLL int    STD S52_getDrawTime(double *app, double *cull, double *draw, double *text, double *last)
+{
+    S52_TR_CALL(S52_TR_getDrawTime, "");
+
+#ifdef S52_USE_CTX
+    // the reader lock to resolve the context of this thread
+    int ret = FALSE;
+
+    S52_CHECK_READ_INIT;
+#else
+    // no lock - read only, might be from the frame being drawn
+    int ret = TRUE;
+#endif
+
+    if (NULL != app ) *app  = _drawTime.app;
+    if (NULL != cull) *cull = _drawTime.cull;
+    if (NULL != draw) *draw = _drawTime.draw;
+    if (NULL != text) *text = _drawTime.text;
+    if (NULL != last) *last = _drawTime.last;
+
+#ifdef S52_USE_CTX
+    ret = TRUE;
+
+exit:
+    S52_READ_UNLOCK;
+#endif
+
+    return ret;
+}
+
+#ifdef S52_USE_GPU_TIMER
+DLL int    STD S52_getGPUTime(unsigned int *frame, double *draw, double *text, double *raster, double *last, double *prio, double *cmd)
+{
+    S52_TR_CALL(S52_TR_getGPUTime, "");
+
+    int ret = FALSE;
+
+    S52_CHECK_MUTX_INIT;
+
+    S52_GL_gpuTime gpu;
+    if (FALSE == S52_GL_getGPUTime(&gpu))
+        goto exit;
+
+    if (NULL != frame ) *frame  = gpu.frame;
+    if (NULL != draw  ) *draw   = gpu.draw;
+    if (NULL != text  ) *text   = gpu.text;
+    if (NULL != raster) *raster = gpu.raster;
+    if (NULL != last  ) *last   = gpu.last;
+    if (NULL != prio  ) memcpy(prio, gpu.prio, sizeof(gpu.prio));
+    if (NULL != cmd   ) memcpy(cmd,  gpu.cmd,  sizeof(gpu.cmd));
+
+    ret = (TRUE==gpu.isGPU) ? 2 : 1;
+
+exit:
+
+    GMUTEXUNLOCK(&_mp_mutex);
+
+    return ret;
+}
+#endif
+
+DLL int    STD S52_needDraw(void)
+{
+    S52_TR_CALL(S52_TR_needDraw, "");
+
+    int ret = FALSE;
+
+    S52_CHECK_READ_INIT;
+
+    ret = _needDraw(RD_DRAWN);
+
+exit:
+
+    S52_READ_UNLOCK;
+
+    return ret;
+}
+
+DLL int    STD S52_needDrawLast(void)
+{
+    S52_TR_CALL(S52_TR_needDrawLast, "");
+
+    int ret = FALSE;
+
+    S52_CHECK_READ_INIT;
+
+    ret = _needDrawLast(RD_DRAWN);
+
+exit:
+
+    S52_READ_UNLOCK;
+
+    return ret;
+}
+
+DLL int    STD S52_setDirtyCallBack(S52_dirty_cb cb, void *user_data)
+{
+    S52_TR_CALL(S52_TR_setDirtyCallBack, "");
+
+    int ret = FALSE;
+
+    S52_CHECK_MUTX_INIT;
+
+    GCBLOCK(&_cb_mutex);
+    _dirtyCB    = cb;
+    _dirtyUData = user_data;
+    GCBUNLOCK(&_cb_mutex);
+
+    ret = TRUE;
+
+exit:
+
+    GMUTEXUNLOCK(&_mp_mutex);
+
+    return ret;
+}
+
+#ifdef S52_USE_RENDER_THREAD
+DLL int    STD S52_setRenderThread(int on)
+{
+    S52_TR_CALL(S52_TR_setRenderThread, "i", on);
+
+    // Note: no lock - the render thread need it to finish pending frame
+    if (TRUE == _doInit) {
+        PRINTF("WARNING: libS52 not initialized --call S52_init() first\n");
+        return FALSE;
+    }
+
+    if (TRUE == on) {
+#ifdef S52_USE_EGL
+        if (NULL == _eglBeg)
+            PRINTF("WARNING: no EGL callback - GL context must be current in the render thread\n");
+#endif
+        return S52_RT_init();
+    }
+
+    return S52_RT_done();
+}
+
+DLL unsigned int STD S52_drawAsync(double cLat, double cLon, double rNM, double north)
+{
+    S52_TR_CALL(S52_TR_drawAsync, "dddd", cLat, cLon, rNM, north);
+
+    return S52_RT_push(RT_CTX, FALSE, cLat, cLon, rNM, north);
+}
+
+DLL unsigned int STD S52_drawLastAsync(void)
+{
+    S52_TR_CALL(S52_TR_drawLastAsync, "");
+
+    return S52_RT_push(RT_CTX, TRUE, 0.0, 0.0, 0.0, 0.0);
+}
+
+DLL int    STD S52_waitFence(unsigned int fence, int timeout_ms)
+{
+    S52_TR_CALL(S52_TR_waitFence, "ui", fence, timeout_ms);
+
+    return S52_RT_wait(fence, timeout_ms);
+}
+#endif  // S52_USE_RENDER_THREAD
+
+#ifdef S52_USE_CTX
+DLL void * STD S52_newCtx(void)
+{
+    S52_TR_CALL(S52_TR_newCtx, "");
+
+    _S52_ctx *ctx = NULL;
+
+    S52_CHECK_MUTX_INIT;
+
+    ctx     = _newCtx();
+    ctx->id = ++_ctxID;
+    g_ptr_array_add(_ctxList, ctx);
+
+exit:
+
+    GMUTEXUNLOCK(&_mp_mutex);
+
+    return ctx;
+}
+
+DLL int    STD S52_setCtx(void *ctx)
+{
+    // Note: a context is traced by its id (replay create context in the same order)
+    S52_TR_CALL(S52_TR_setCtx, "u", (NULL == ctx) ? 0 : ((_S52_ctx*)ctx)->id);
+
+    int ret = FALSE;
+
+    GMUTEXLOCK(&_mp_mutex);
+    S52_CHECK_INIT;
+
+    if (NULL != ctx) {
+        guint i = 0;
+        for (i=0; i<_ctxList->len; ++i) {
+            if (ctx == g_ptr_array_index(_ctxList, i))
+                break;
+        }
+        if (i == _ctxList->len) {
+            PRINTF("WARNING: unknown context\n");
+            goto exit;
+        }
+    }
+
+    // this thread now use ctx
+    CTXSET(&_ctxThread, ctx);
+    _ctxSwitch(TRUE);
+
+    ret = TRUE;
+
+exit:
+
+    GMUTEXUNLOCK(&_mp_mutex);
+
+    return ret;
+}
+
+DLL int    STD S52_delCtx(void *ctx)
+{
+    S52_TR_CALL(S52_TR_delCtx, "u", (NULL == ctx) ? 0 : ((_S52_ctx*)ctx)->id);
+
+    int ret = FALSE;
+
+    return_if_null(ctx);
+
+    S52_CHECK_MUTX_INIT;
+
+    if (ctx == &_ctxDef) {
+        PRINTF("WARNING: can't delete the default context\n");
+        goto exit;
+    }
+    if (ctx == _ctxCrnt) {
+        PRINTF("WARNING: context in use - S52_setCtx(NULL) first\n");
+        goto exit;
+    }
+    if (FALSE == g_ptr_array_remove(_ctxList, ctx)) {
+        PRINTF("WARNING: unknown context\n");
+        goto exit;
+    }
+
+    _delCtx((_S52_ctx*)ctx);
+
+    ret = TRUE;
+
+exit:
+
+    GMUTEXUNLOCK(&_mp_mutex);
+
+    return ret;
+}
+#endif  // S52_USE_CTX
+
+static int        _getMemStat(_cell *c, _memStat *ms)
+// walk all obj of this cell and add up memory
+{
+    for (S52_disPrio i=S52_PRIO_NODATA; i<S52_PRIO_NUM; ++i) {
+        for (S52ObjectType j=S52__META; j<S52_N_OBJ; ++j) {
+            GPtrArray *rbin = c->renderBin[i][j];
+            for (guint idx=0; idx<rbin->len; ++idx) {
+                S52_obj *obj = (S52_obj *)g_ptr_array_index(rbin, idx);
+                S57_geo *geo = S52_PL_getGeo(obj);
+
+                guint npt  = 0;
+                gsize geoB = 0, attB = 0, primB = 0, objB = 0, textB = 0;
+
+                S57_getMemSize(geo, &npt, &geoB, &attB, &primB);
+                S52_PL_getMemSize(obj, &objB, &textB, NULL);
+
+                ms->nobj    += 1;
+                ms->nvertex += npt;
+                ms->geo     += geoB;
+                ms->att     += attB;
+                ms->prim    += primB;
+                ms->obj     += objB;
+                ms->text    += textB;
+                ms->vbo     += S52_GL_getVBOSize(obj);
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+#ifdef S52_USE_CHART_MANAGER
+static gsize      _sumCellMem(_cell *c)
+// resident bytes of a cell (CPU + GPU) - CM budget
+{
+    _memStat ms = {0,0,0,0,0,0,0,0};
+
+    _getMemStat(c, &ms);
+
+    return ms.geo + ms.att + ms.prim + ms.obj + ms.text + ms.vbo;
+}
+
+static gsize      _getCellMem(const char *encPath)
+// CM thread - size of a cell just loaded, flag it to be re-sampled after its first draw
+{
+    gsize  size     = 0;
+    gchar *baseName = g_path_get_basename(encPath);
+
+    S52_CHECK_READ;
+
+    guint i = _isCellLoaded(baseName);
+    if (0 < i) {
+        _cell *c = (_cell*)g_ptr_array_index(_cellList, i);
+
+        size = _sumCellMem(c);
+        g_atomic_int_set(&c->cmSample, TRUE);
+    }
+
+    S52_READ_UNLOCK;
+
+    g_free(baseName);
+
+    return size;
+}
+
+static int        _CM_resample(ObjExt_t ext)
+// draw thread - re-sample the size of cell drawn for the first time since loaded
+{
+    for (guint i=_cellList->len-1; i>0; --i) {
+        _cell *c = (_cell*) g_ptr_array_index(_cellList, i);
+
+        if ((FALSE==g_atomic_int_get(&c->cmSample)) || (FALSE==_intersectEXT(c->geoExt, ext)))
+            continue;
+
+        // FALSE - the CM thread has not yet recorded the load, retry next frame
+        if (TRUE == S52_CM_setSize(c->encPath, _sumCellMem(c)))
+            g_atomic_int_set(&c->cmSample, FALSE);
+    }
+
+    return TRUE;
+}
+#endif
+
+static _memStat  *_getMemStatCell(_cell *c)
+// memory of this cell - walk obj only if changed since the last call (under _str_mutex)
+// Note: MARINER_CELL is small and change without MEM_DIRTY() (VESSEL, delMarObj) - always walked
+{
+    if ((TRUE==g_atomic_int_get(&c->memDirty)) || (c==_marinerCell)) {
+        _memStat ms = {0,0,0,0,0,0,0,0};
+
+        // clear first - a change while walking is picked up at the next call
+        g_atomic_int_set(&c->memDirty, FALSE);
+
+        _getMemStat(c, &ms);
+        c->mem = ms;
+    }
+
+    return &c->mem;
+}
+
+static void       _appendJSONStr(GString *str, const char *val)
+// append val as a JSON string (quoted and escaped)
+{
+    g_string_append_c(str, '"');
+    for (const char *c=val; '\0'!=*c; ++c) {
+        switch (*c) {
+            case '"':  g_string_append(str, "\\\""); break;
+            case '\\': g_string_append(str, "\\\\"); break;
+            case '\n': g_string_append(str, "\\n");  break;
+            case '\r': g_string_append(str, "\\r");  break;
+            case '\t': g_string_append(str, "\\t");  break;
+            default:
+                if ((guchar)*c < 0x20)
+                    g_string_append_printf(str, "\\u%04x", (guchar)*c);
+                else
+                    g_string_append_c(str, *c);
+        }
+    }
+    g_string_append_c(str, '"');
+
+    return;
+}
+
+static void       _appendMemStat(GString *str, _memStat *ms)
+{
+    g_string_append_printf(str, "\"obj\":%u,\"vertex\":%u,"
+                           "\"cpu\":{\"geo\":%lu,\"att\":%lu,\"prim\":%lu,\"obj\":%lu,\"text\":%lu},",
+                           ms->nobj, ms->nvertex,
+                           (gulong)ms->geo, (gulong)ms->att, (gulong)ms->prim, (gulong)ms->obj, (gulong)ms->text);
+}
+
+DLL CCHAR *STD S52_getStats(const char *cellName)
+{
+    S52_TR_CALL(S52_TR_getStats, "s", cellName);
+
+    static const char *str;
+    str = NULL;
+
+    S52_CHECK_READ_INIT;
+
+    GSTRLOCK(&_str_mutex);
+
+    g_string_set_size(_statsStr, 0);
+
+    // one cell
+    if (NULL!=cellName && 0!=g_strcmp0(cellName, "*")) {
+        for (guint i=0; i<_cellList->len; ++i) {
+            _cell *c = (_cell*)g_ptr_array_index(_cellList, i);
+
+            if (0 != g_strcmp0(c->filename->str, cellName))
+                continue;
+
+            _memStat *ms = _getMemStatCell(c);
+
+            g_string_append(_statsStr, "{\"cell\":");
+            _appendJSONStr(_statsStr, c->filename->str);
+            g_string_append_c(_statsStr, ',');
+            _appendMemStat(_statsStr, ms);
+            g_string_append_printf(_statsStr, "\"gpu\":{\"vbo\":%lu}}", (gulong)ms->vbo);
+
+            str = _statsStr->str;
+            break;
+        }
+
+        if (NULL == str)
+            PRINTF("WARNING: cell not loaded (%s)\n", cellName);
+
+        goto unlock;
+    }
+
+    // global
+    {
+        S52_GL_stat draw;
+        S52_GL_stat last;
+        S52_GL_getStat(S52_GL_DRAW, &draw);
+        S52_GL_getStat(S52_GL_LAST, &last);
+
+        _drawTime_t t;
+        guint       nCull  = 0;
+        guint       nTotal = 0;
+        RD_TIME(&t, &nCull, &nTotal);
+
+        g_string_append_printf(_statsStr,
+            "{\"time\":{\"app\":%.3f,\"cull\":%.3f,\"draw\":%.3f,\"text\":%.3f,\"last\":%.3f},",
+            t.app, t.cull, t.draw, t.text, t.last);
+        g_string_append_printf(_statsStr, "\"cull\":{\"total\":%u,\"cull\":%u},", nTotal, nCull);
+        g_string_append_printf(_statsStr,
+            "\"gl\":{\"draw\":{\"obj\":%u,\"cmd\":%u,\"clip\":%u,\"tris\":%u,\"poly\":%u,\"bind\":%u},"
+                     "\"last\":{\"obj\":%u,\"cmd\":%u,\"clip\":%u,\"tris\":%u,\"poly\":%u,\"bind\":%u}},",
+            draw.nobj, draw.ncmd, draw.oclip, draw.ntris, draw.npoly, draw.nbind,
+            last.nobj, last.ncmd, last.oclip, last.ntris, last.npoly, last.nbind);
+    }
+
+#ifdef S52_USE_GPU_TIMER
+    {
+        S52_GL_gpuTime gpu;
+        if (TRUE == S52_GL_getGPUTime(&gpu)) {
+            g_string_append_printf(_statsStr,
+                "\"gpuTime\":{\"src\":\"%s\",\"frame\":%u,\"draw\":%.3f,\"text\":%.3f,\"raster\":%.3f,\"last\":%.3f,",
+                (TRUE==gpu.isGPU) ? "timer_query" : "cpu", gpu.frame, gpu.draw, gpu.text, gpu.raster, gpu.last);
+            g_string_append(_statsStr, "\"prio\":[");
+            for (int i=0; i<S52_PRIO_NUM; ++i)
+                g_string_append_printf(_statsStr, "%s%.3f", (0==i) ? "" : ",", gpu.prio[i]);
+            g_string_append_printf(_statsStr,
+                "],\"cmd\":{\"SY\":%.3f,\"LS\":%.3f,\"LC\":%.3f,\"AC\":%.3f,\"AP\":%.3f},"
+                "\"overflow\":%u,\"dropped\":%u},",
+                gpu.cmd[S52_GL_TQ_SY], gpu.cmd[S52_GL_TQ_LS], gpu.cmd[S52_GL_TQ_LC],
+                gpu.cmd[S52_GL_TQ_AC], gpu.cmd[S52_GL_TQ_AP], gpu.overflow, gpu.dropped);
+        }
+    }
+#endif
+
+    {
+        GString *cells = NULL;
+        _memStat total = {0,0,0,0,0,0,0,0};
+
+        if (NULL != cellName)
+            cells = g_string_new(",\"cells\":[");
 
-        ////////////////////////////////////////////////////////////////////
-        // APP: no CS code for Mariner - all in GL now
-        //_app();
+        for (guint i=0; i<_cellList->len; ++i) {
+            _cell    *c  = (_cell*)g_ptr_array_index(_cellList, i);
+            _memStat *ms = _getMemStatCell(c);
+
+            total.nobj    += ms->nobj;
+            total.nvertex += ms->nvertex;
+            total.geo     += ms->geo;
+            total.att     += ms->att;
+            total.prim    += ms->prim;
+            total.obj     += ms->obj;
+            total.text    += ms->text;
+            total.vbo     += ms->vbo;
+
+            if (NULL != cells) {
+                g_string_append(cells, (0==i) ? "{\"cell\":" : ",{\"cell\":");
+                _appendJSONStr(cells, c->filename->str);
+                g_string_append_c(cells, ',');
+                _appendMemStat(cells, ms);
+                g_string_append_printf(cells, "\"gpu\":{\"vbo\":%lu}}", (gulong)ms->vbo);
+            }
+        }
 
-        // check stray vessel (occur when s52ais/gpsd restart)
-        if (0.0 != S52_MP_get(S52_MAR_DISP_VESSEL_DELAY)) {
-            GPtrArray *rbinPT = _marinerCell->renderBin[S52_PRIO_MARINR][S52_POINT];
-            g_ptr_array_foreach(rbinPT, _delOldVessel, rbinPT);
-            GPtrArray *rbinLN = _marinerCell->renderBin[S52_PRIO_MARINR][S52_LINES];
-            g_ptr_array_foreach(rbinLN, _delOldVessel, rbinLN);
+        gsize tex = S52_GL_getTexSize();
+#ifdef S52_USE_RASTER
+        for (guint i=0; i<_rasterList->len; ++i) {
+            S52_GL_ras *r = (S52_GL_ras *) g_ptr_array_index(_rasterList, i);
+            tex += S52_GL_getRasterSize(r);
         }
+#endif
 
-        ////////////////////////////////////////////////////////////////////
-        // CULL / DRAW:
-        //
-        _nCull = 0;
-        _nTotal= 0;
+        g_string_append_printf(_statsStr, "\"ncell\":%u,", _cellList->len);
+        _appendMemStat(_statsStr, &total);
+        g_string_append_printf(_statsStr, "\"gpu\":{\"vbo\":%lu,\"tex\":%lu}",
+                               (gulong)total.vbo, (gulong)tex);
 
-        // Mariners' (layer 9 - Last)
-        //ret = _drawLast();
-        for (S52ObjectType j=S52__META; j<S52_N_OBJ; ++j) {
-            _drawLast(_marinerCell->renderBin[S52_PRIO_MARINR][j]);
+        if (NULL != cells) {
+            g_string_append(cells, "]");
+            g_string_append(_statsStr, cells->str);
+            g_string_free(cells, TRUE);
         }
 
-        S52_GL_end(S52_GL_LAST);
-    } else {
-        PRINTF("WARNING: S52_GL_begin() failed\n");
+        g_string_append(_statsStr, "}");
     }
 
-exit:
-
-    EGL_END(LAST);
+    str = _statsStr->str;
 
-#ifdef S52_DEBUG
-    {
-        //gdouble sec = g_timer_elapsed(_timer, NULL);
-        //PRINTF("DRAWLAST: %.0f msec (cull/total) %i/%i\n", sec * 1000, _nCull, _nTotal);
-    }
-#endif
+unlock:
+    GSTRUNLOCK(&_str_mutex);
 
-    GMUTEXUNLOCK(&_mp_mutex);
+exit:
+    S52_READ_UNLOCK;
 
-    return ret;
+    return str;
 }
 
 //void (*GFunc) (gpointer data, gpointer user_data);
@@ -4420,6 +6299,8 @@ DLL int    STD S52_loadPLib(const char *plibName)
 // (re)load a PLib - rebuild S52_obj wrapper around S57_geo
 // Note: allow to reload a PLib to overwrite rules
 {
+    S52_TR_CALL(S52_TR_loadPLib, "s", plibName);
+
     int ret = FALSE;
 
     S52_CHECK_MUTX_INIT;
@@ -4469,6 +6350,8 @@ DLL int    STD S52_loadPLib(const char *plibName)
         TRAV_RBIN_ij(g_free(g_ptr_array_free(cell->renderBin[i][j], FALSE)));
         // replace new rbin in cell
         TRAV_RBIN_ij(cell->renderBin[i][j] = tmpCell.renderBin[i][j]);
+        SCAMIN_DIRTY(cell);
+        MEM_DIRTY(cell);
 
         /* optimisation: recompute only CS that change due to new MarParam value
         // save reference for quickly find CS to re-compute after a MarinerParameter change
@@ -4492,6 +6375,7 @@ DLL int    STD S52_loadPLib(const char *plibName)
 
     // signal to rebuild all cmd
     _APP_CS = TRUE;
+    _dirty(_GEN_CELL);
 
     ret = TRUE;
 
@@ -4623,6 +6507,8 @@ static int        _validate_screenPos(double *xx, double *yy)
 
 DLL int    STD S52_drawStr(double pixels_x, double pixels_y, const char *colorName, unsigned int bsize, const char *str)
 {
+    S52_TR_CALL(S52_TR_drawStr, "ddsus", pixels_x, pixels_y, colorName, bsize, str);
+
     int ret = FALSE;
 
     return_if_null(colorName);
@@ -4655,6 +6541,8 @@ exit:
 
 DLL int    STD S52_drawBlit(double scale_x, double scale_y, double scale_z, double north)
 {
+    S52_TR_CALL(S52_TR_drawBlit, "dddd", scale_x, scale_y, scale_z, north);
+
     int ret = FALSE;
 
     // FIXME: try lock skip touch -
@@ -4716,24 +6604,33 @@ exit:
 
 DLL int    STD S52_xy2LL(double *pixels_x, double *pixels_y)
 {
+    S52_TR_CALL(S52_TR_xy2LL, "PP", pixels_x, pixels_y);
+
     int ret = FALSE;
 
-    S52_CHECK_MUTX_INIT;
+    S52_CHECK_READ_INIT;
 
     if (NULL == S57_getPrjStr())
         goto exit;
 
-    // check bound
-    if (FALSE == _validate_screenPos(pixels_x, pixels_y)) {
-        PRINTF("WARNING: _validate_screenPos() failed\n");
-        goto exit;
+    // check bound - viewport of the last frame drawn
+    {
+        int x, y, width, height;
+        if (FALSE == S52_GL_getViewPortFrame(RD_GL, &x, &y, &width, &height)) {
+            PRINTF("WARNING: S52_GL_getViewPortFrame() failed (no frame drawn yet)\n");
+            goto exit;
+        }
+        *pixels_x = CLAMP(*pixels_x, 0.0, (double)(x + width));
+        *pixels_y = CLAMP(*pixels_y, 0.0, (double)(y + height));
     }
 
-    if (FALSE == S52_GL_win2prj(pixels_x, pixels_y)) {
-        PRINTF("WARNING: S52_GL_win2prj() failed\n");
+    // use the view of the last frame drawn - no GL call, so any thread can query
+    if (FALSE == S52_GL_win2prjFrame(RD_GL, pixels_x, pixels_y)) {
+        PRINTF("WARNING: S52_GL_win2prjFrame() failed (no frame drawn yet)\n");
         goto exit;
     }
 
+    // Note: PROJ4 pj_inv()/pj_transform() on the same projection are reentrant (pj_errno aside)
     {
         projXY uv = {*pixels_x, *pixels_y};
         uv = S57_prj2geo(uv);
@@ -4744,16 +6641,18 @@ DLL int    STD S52_xy2LL(double *pixels_x, double *pixels_y)
 
 exit:
 
-    GMUTEXUNLOCK(&_mp_mutex);
+    S52_READ_UNLOCK;
 
     return ret;
 }
 
 DLL int    STD S52_LL2xy(double *longitude, double *latitude)
 {
+    S52_TR_CALL(S52_TR_LL2xy, "PP", longitude, latitude);
+
     int ret = FALSE;
 
-    S52_CHECK_MUTX_INIT;
+    S52_CHECK_READ_INIT;
 
     if (NULL == S57_getPrjStr())
         goto exit;
@@ -4769,7 +6668,10 @@ DLL int    STD S52_LL2xy(double *longitude, double *latitude)
     }
 
     //S52_GL_prj2win(&xyz[0], &xyz[1]);
-    S52_GL_prj2win(&pt.x, &pt.y);
+    if (FALSE == S52_GL_prj2winFrame(RD_GL, &pt.x, &pt.y)) {
+        PRINTF("WARNING: S52_GL_prj2winFrame() failed (no frame drawn yet)\n");
+        goto exit;
+    }
 
     //*longitude = xyz[0];
     //*latitude  = xyz[1];
@@ -4779,54 +6681,248 @@ DLL int    STD S52_LL2xy(double *longitude, double *latitude)
     ret = TRUE;
 exit:
 
-    GMUTEXUNLOCK(&_mp_mutex);
+    S52_READ_UNLOCK;
 
     return ret;
 }
 
-DLL int    STD S52_setView(double cLat, double cLon, double rNM, double north)
+// per-thread scratch of the batch conversion - grow only, freed at thread exit
+typedef struct _xyv_t {
+    double *v;
+    gsize   sz;
+} _xyv_t;
+
+static void       _xyvFree(gpointer data)
 {
-    int ret = FALSE;
+    _xyv_t *xyv = (_xyv_t*) data;
 
-    S52_CHECK_MUTX_INIT;
+    g_free(xyv->v);
+    g_free(xyv);
+}
 
-    // debug
-    PRINTF("lat:%f, long:%f, range:%f north:%f\n", cLat, cLon, rNM, north);
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticPrivate _xyvThread = G_STATIC_PRIVATE_INIT;
+#define XYVGET()         ((_xyv_t*)g_static_private_get(&_xyvThread))
+#define XYVSET(xyv)      g_static_private_set(&_xyvThread, xyv, _xyvFree)
+#else
+static GPrivate       _xyvThread = G_PRIVATE_INIT(_xyvFree);
+#define XYVGET()         ((_xyv_t*)g_private_get(&_xyvThread))
+#define XYVSET(xyv)      g_private_set(&_xyvThread, xyv)
+#endif
+
+static double    *_dupXYv(unsigned int npt, double *xy, unsigned int stride, gsize *sz)
+// copy of a strided array - batch conversion work on it, the caller array
+// is only written on success
+{
+    *sz = (0 == npt) ? 0 : ((gsize)(npt-1) * stride + 2) * sizeof(double);
+    if (0 == *sz)
+        return NULL;
+
+    _xyv_t *xyv = XYVGET();
+    if (NULL == xyv) {
+        xyv = g_new0(_xyv_t, 1);
+        XYVSET(xyv);
+    }
+
+    if (xyv->sz < *sz) {
+        g_free(xyv->v);
+        xyv->v  = (double*) g_malloc(*sz);
+        xyv->sz = *sz;
+    }
+
+    memcpy(xyv->v, xy, *sz);
+
+    return xyv->v;
+}
+
+DLL int    STD S52_xy2LLv(unsigned int npt, double *xy, unsigned int stride)
+{
+    // 0 - packed XY
+    if (0 == stride)
+        stride = 2;
+
+    S52_TR_CALL(S52_TR_xy2LLv, "uua", npt, stride, (NULL==xy || 0==npt) ? 0 : (npt-1) * stride + 2, xy);
+
+    return_if_null(xy);
+
+    // point overlap
+    if (1 == stride) {
+        PRINTF("WARNING: stride 1 invalid (X/Y overlap)\n");
+        return FALSE;
+    }
+
+    int    ret = FALSE;
+    gsize  sz  = 0;
+    double *v  = _dupXYv(npt, xy, stride, &sz);
+
+    S52_CHECK_READ_INIT;
+
+    if (NULL == S57_getPrjStr())
+        goto exit;
+
+    if (0 == npt) {
+        ret = TRUE;
+        goto exit;
+    }
+
+    // check bound - same as _validate_screenPos(), viewport of the last frame drawn
+    {
+        int x, y, width, height;
+        if (FALSE == S52_GL_getViewPortFrame(RD_GL, &x, &y, &width, &height)) {
+            PRINTF("WARNING: S52_GL_getViewPortFrame() failed (no frame drawn yet)\n");
+            goto exit;
+        }
+
+        double *p = v;
+        for (guint i=0; i<npt; ++i, p+=stride) {
+            p[0] = CLAMP(p[0], 0.0, (double)(x + width));
+            p[1] = CLAMP(p[1], 0.0, (double)(y + height));
+        }
+    }
+
+    if (FALSE == S52_GL_win2prjFramev(RD_GL, npt, v, v+1, stride)) {
+        PRINTF("WARNING: S52_GL_win2prjFramev() failed (no frame drawn yet)\n");
+        goto exit;
+    }
+
+    if (FALSE == S57_prj2geov(npt, v, v+1, stride)) {
+        PRINTF("WARNING: S57_prj2geov() failed\n");
+        goto exit;
+    }
+
+    memcpy(xy, v, sz);
+
+    ret = TRUE;
+
+exit:
+
+    S52_READ_UNLOCK;
+
+    return ret;
+}
+
+DLL int    STD S52_LL2xyv(unsigned int npt, double *xy, unsigned int stride)
+{
+    // 0 - packed lon/lat
+    if (0 == stride)
+        stride = 2;
+
+    S52_TR_CALL(S52_TR_LL2xyv, "uua", npt, stride, (NULL==xy || 0==npt) ? 0 : (npt-1) * stride + 2, xy);
+
+    return_if_null(xy);
+
+    // point overlap
+    if (1 == stride) {
+        PRINTF("WARNING: stride 1 invalid (lon/lat overlap)\n");
+        return FALSE;
+    }
+
+    int    ret = FALSE;
+    gsize  sz  = 0;
+    double *v  = _dupXYv(npt, xy, stride, &sz);
+
+    S52_CHECK_READ_INIT;
+
+    if (NULL == S57_getPrjStr())
+        goto exit;
+
+    if (0 == npt) {
+        ret = TRUE;
+        goto exit;
+    }
+
+    if (FALSE == S57_geo2prjv(npt, v, v+1, stride)) {
+        PRINTF("WARNING: S57_geo2prjv() failed\n");
+        goto exit;
+    }
+
+    if (FALSE == S52_GL_prj2winFramev(RD_GL, npt, v, v+1, stride)) {
+        PRINTF("WARNING: S52_GL_prj2winFramev() failed (no frame drawn yet)\n");
+        goto exit;
+    }
+
+    memcpy(xy, v, sz);
+
+    ret = TRUE;
+
+exit:
+
+    S52_READ_UNLOCK;
+
+    return ret;
+}
 
+static int        _validView(double cLat, double cLon, double rNM, double north)
+{
     //*
     if (ABS(cLat) > 90.0) {
         PRINTF("WARNING: FAIL, cLat outside [-90..+90](%f)\n", cLat);
-        goto exit;
+        return FALSE;
     }
 
     if (ABS(cLon) > 180.0) {
         PRINTF("WARNING: FAIL, cLon outside [-180..+180] (%f)\n", cLon);
-        goto exit;
+        return FALSE;
     }
     //*/
 
     if ((rNM < MIN_RANGE) || (rNM > MAX_RANGE)) {
         PRINTF("WARNING: FAIL, rNM outside limit (%f)\n", rNM);
-        goto exit;
+        return FALSE;
     }
 
     // FIXME: PROJ4 will explode here (INFINITY) for mercator
     // Note: must validate rNM first
     if ((ABS(cLat)*60.0 + rNM) > (90.0*60)) {
         PRINTF("WARNING: FAIL, rangeNM > 90*60 NM (%f)\n", rNM);
-        goto exit;
+        return FALSE;
     }
 
     if ((north>=360.0) || (north<0.0)) {
         PRINTF("WARNING: FAIL, north outside [0..360[ (%f)\n", north);
-        goto exit;
+        return FALSE;
     }
-    //}
+
+    return TRUE;
+}
+
+DLL int    STD S52_setView(double cLat, double cLon, double rNM, double north)
+{
+    S52_TR_CALL(S52_TR_setView, "dddd", cLat, cLon, rNM, north);
+
+    int ret  = FALSE;
+    int excl = FALSE;
 
     // debug
-    //PRINTF("lat:%f, long:%f, range:%f north:%f\n", cLat, cLon, rNM, north);
+    PRINTF("lat:%f, long:%f, range:%f north:%f\n", cLat, cLon, rNM, north);
+
+    if (FALSE == _validView(cLat, cLon, rNM, north))
+        return FALSE;
+
+#ifdef S52_USE_CTX
+    // the view is state of the context - the reader lock keep S52_done() / S52_delCtx() out
+    // and the frame of other context keep going (no barrier for every render thread)
+    S52_CHECK_READ_INIT;
+
+    if (TRUE == g_atomic_int_compare_and_exchange(&_ctxCrnt->drawing, FALSE, TRUE)) {
+        ret = S52_GL_setView(cLat, cLon, rNM, north);
+        if (TRUE == ret)
+            _dirty(_GEN_VIEW);
+        g_atomic_int_set(&_ctxCrnt->drawing, FALSE);
+
+        goto exit;
+    }
+
+    // a frame of this context in an other thread - the writer lock wait for it
+    S52_READ_UNLOCK;
+#endif
+
+    excl = TRUE;
+    S52_CHECK_MUTX_INIT;
 
     ret = S52_GL_setView(cLat, cLon, rNM, north);
+    if (TRUE == ret)
+        _dirty(_GEN_VIEW);
 
     /* update local var _view
     _view.cLat  = cLat;
@@ -4837,7 +6933,10 @@ DLL int    STD S52_setView(double cLat, double cLon, double rNM, double north)
 
 exit:
 
-    GMUTEXUNLOCK(&_mp_mutex);
+    if (TRUE == excl)
+        GMUTEXUNLOCK(&_mp_mutex);
+    else
+        S52_READ_UNLOCK;
 
     //return TRUE;
     return ret;
@@ -4845,15 +6944,17 @@ exit:
 
 DLL int    STD S52_getView(double *cLat, double *cLon, double *rNM, double *north)
 {
+    S52_TR_CALL(S52_TR_getView, "");
+
     return_if_null(cLat);
     return_if_null(cLon);
     return_if_null(rNM);
     return_if_null(north);
 
-    S52_CHECK_MUTX_INIT;
-
+    S52_CHECK_READ_INIT;
 
-    S52_GL_getView(cLat, cLon, rNM, north);
+    // view set in the context of this thread
+    S52_GL_getViewCtx(RD_GL, cLat, cLon, rNM, north);
 
     /*
     double LLv;
@@ -4873,13 +6974,15 @@ DLL int    STD S52_getView(double *cLat, double *cLon, double *rNM, double *nort
 
 exit:
 
-    GMUTEXUNLOCK(&_mp_mutex);
+    S52_READ_UNLOCK;
 
     return TRUE;
 }
 
 DLL int    STD S52_setViewPort(int pixels_x, int pixels_y, int pixels_width, int pixels_height)
 {
+    S52_TR_CALL(S52_TR_setViewPort, "iiii", pixels_x, pixels_y, pixels_width, pixels_height);
+
     S52_CHECK_MUTX_INIT;
 
     PRINTF("pixels_x:%i, pixels_y:%i, pixels_width:%i, pixels_height:%i\n", pixels_x, pixels_y, pixels_width, pixels_height);
@@ -4887,6 +6990,7 @@ DLL int    STD S52_setViewPort(int pixels_x, int pixels_y, int pixels_width, int
     //_validate_screenPos(&x, &y);
 
     S52_GL_setViewPort(pixels_x, pixels_y, pixels_width, pixels_height);
+    _dirty(_GEN_VIEW);
 
 exit:
 
@@ -4998,6 +7102,8 @@ static ObjExt_t   _getCellsExt(void)
 
 DLL int    STD S52_getCellExtent(const char *filename, double *S, double *W, double *N, double *E)
 {
+    S52_TR_CALL(S52_TR_getCellExtent, "s", filename);
+
     int ret = FALSE;
 
     if (NULL==S || NULL==W || NULL==N || NULL==E) {
@@ -5070,6 +7176,8 @@ exit:
 
 DLL int    STD S52_getS57ObjClassSupp(const char *className)
 {
+    S52_TR_CALL(S52_TR_getS57ObjClassSupp, "s", className);
+
     return_if_null(className);
 
     S52_objSupp suppState = S52_SUPP_ERR;
@@ -5095,6 +7203,8 @@ exit:
 
 DLL int    STD S52_setS57ObjClassSupp(const char *className, int value)
 {
+    S52_TR_CALL(S52_TR_setS57ObjClassSupp, "si", className, value);
+
     return_if_null(className);
 
     int ret = FALSE;
@@ -5118,6 +7228,7 @@ DLL int    STD S52_setS57ObjClassSupp(const char *className, int value)
     }
 
     ret = S52_PL_toggleObjClass(className);
+    _dirty(_GEN_CLASS);
 
 exit:
 
@@ -5137,6 +7248,8 @@ exit:
 
 DLL CCHAR *STD S52_pickAt(double pixels_x, double pixels_y)
 {
+    S52_TR_CALL(S52_TR_pickAt, "dd", pixels_x, pixels_y);
+
     static const char *name;
     name = NULL;
 
@@ -5288,6 +7401,8 @@ exit:
 
 DLL CCHAR *STD S52_getPLibNameList(void)
 {
+    S52_TR_CALL(S52_TR_getPLibNameList, "");
+
     static const char *str;
     str = NULL;
 
@@ -5305,6 +7420,8 @@ exit:
 DLL CCHAR *STD S52_getPalettesNameList(void)
 // return a string of palettes name loaded
 {
+    S52_TR_CALL(S52_TR_getPalettesNameList, "");
+
     static const char *str;
     str = NULL;
 
@@ -5339,6 +7456,8 @@ static void       _getS57ClassList(S52_obj *obj, GString *classList)
 
 DLL CCHAR *STD S52_getS57ClassList(const char *cellName)
 {
+    S52_TR_CALL(S52_TR_getS57ClassList, "s", cellName);
+
     static const char *str;
     str = NULL;
 
@@ -5408,6 +7527,8 @@ static void       _getObjList(S52_obj *obj, const char *className)
 
 DLL CCHAR *STD S52_getObjList(const char *cellName, const char *className)
 {
+    S52_TR_CALL(S52_TR_getObjList, "ss", cellName, className);
+
     return_if_null(cellName);
     return_if_null(className);
 
@@ -5455,33 +7576,43 @@ exit:
 
 DLL CCHAR *STD S52_getAttList(unsigned int S57ID)
 {
+    S52_TR_CALL(S52_TR_getAttList, "u", S57ID);
+
     static const char *str;
     str = NULL;
 
-    S52_CHECK_MUTX_INIT;
+    S52_CHECK_READ_INIT;
 
     PRINTF("S57ID: %i\n", S57ID);
 
     S52_obj *obj = S52_PL_isObjValid(S57ID);
     if (NULL != obj) {
         S57_geo *geo = S52_PL_getGeo(obj);
-        if (NULL != geo)
+        if (NULL != geo) {
+            // S57_getAtt() build the list in a shared buffer
+            GSTRLOCK(&_str_mutex);
             str = S57_getAtt(geo);
+            GSTRUNLOCK(&_str_mutex);
+        }
     }
 
 exit:
 
-    GMUTEXUNLOCK(&_mp_mutex);
+    S52_READ_UNLOCK;
 
     return str;
 }
 
 DLL CCHAR *STD S52_getCellNameList(void)
 {
+    S52_TR_CALL(S52_TR_getCellNameList, "");
+
     static const char *str;
     str = NULL;
 
-    S52_CHECK_MUTX_INIT;
+    S52_CHECK_READ_INIT;
+
+    GSTRLOCK(&_str_mutex);
 
     g_string_set_size(_cellNameList, 0);
 
@@ -5527,9 +7658,11 @@ DLL CCHAR *STD S52_getCellNameList(void)
     if (0 != _cellNameList->len)
         str = _cellNameList->str;
 
+    GSTRUNLOCK(&_str_mutex);
+
 exit:
 
-    GMUTEXUNLOCK(&_mp_mutex);
+    S52_READ_UNLOCK;
 
     return str;
 }
@@ -5538,6 +7671,8 @@ exit:
 
 DLL int    STD S52_setRGB(const char *colorName, unsigned char  R, unsigned char  G, unsigned char  B)
 {
+    S52_TR_CALL(S52_TR_setRGB, "suuu", colorName, R, G, B);
+
     return_if_null(colorName);
 
     S52_CHECK_MUTX_INIT;
@@ -5545,6 +7680,7 @@ DLL int    STD S52_setRGB(const char *colorName, unsigned char  R, unsigned char
     PRINTF("colorName:%s, R:%c, G:%c, B:%c\n", colorName, R, G, B);
 
     S52_PL_setRGB(colorName, R, G, B);
+    _dirty(_GEN_MP);
 
 exit:
 
@@ -5555,27 +7691,34 @@ exit:
 
 DLL int    STD S52_getRGB(const char *colorName, unsigned char *R, unsigned char *G, unsigned char *B)
 {
+    S52_TR_CALL(S52_TR_getRGB, "s", colorName);
+
     return_if_null(colorName);
     return_if_null(R);
     return_if_null(G);
     return_if_null(B);
 
-    S52_CHECK_MUTX_INIT;
+    int ret = FALSE;
+
+    S52_CHECK_READ_INIT;
 
     PRINTF("colorName:%s, R:%#lX, G:%#lX, B:%#lX\n", colorName, (long unsigned int)R, (long unsigned int)G, (long unsigned int)B);
 
-    S52_PL_getRGB(colorName, R, G, B);
+    // palette of the context of this thread
+    ret = S52_PL_getRGB((unsigned int) S52_MP_getCtx(RD_MP, S52_MAR_COLOR_PALETTE), colorName, R, G, B);
 
 exit:
 
-    GMUTEXUNLOCK(&_mp_mutex);
+    S52_READ_UNLOCK;
 
-    return TRUE;
+    return ret;
 }
 
 DLL int    STD S52_setRADARCallBack(S52_RADAR_cb cb, unsigned int texRadius)
 // experimental - load raw raster RADAR via callback
 {
+    S52_TR_CALL(S52_TR_setRADARCallBack, "u", texRadius);
+
     (void)cb;
     (void)texRadius;
 
@@ -5599,6 +7742,9 @@ DLL int    STD S52_setRADARCallBack(S52_RADAR_cb cb, unsigned int texRadius)
 
                 S52_GL_delRaster(raster, TRUE);
 
+                --_nRADAR;
+                _dirty(_GEN_RASTER);
+
                 goto exit;
             } else {
                 ret = FALSE;
@@ -5615,6 +7761,9 @@ DLL int    STD S52_setRADARCallBack(S52_RADAR_cb cb, unsigned int texRadius)
     raster->w          = texRadius * 2;  // E/W
     g_ptr_array_add(_rasterList, raster);
 
+    ++_nRADAR;
+    _dirty(_GEN_RASTER);
+
 exit:
 
     GMUTEXUNLOCK(&_mp_mutex);
@@ -5627,6 +7776,8 @@ exit:
 
 DLL int    STD S52_setEGLCallBack(S52_EGL_cb eglBeg, S52_EGL_cb eglEnd, void *EGLctx)
 {
+    S52_TR_CALL(S52_TR_setEGLCallBack, "");
+
     (void)eglBeg;
     (void)eglEnd;
     (void)EGLctx;
@@ -5634,10 +7785,19 @@ DLL int    STD S52_setEGLCallBack(S52_EGL_cb eglBeg, S52_EGL_cb eglEnd, void *EG
 #ifdef S52_USE_EGL
     PRINTF("set EGL_cb .. \n");
 
+#ifdef S52_USE_CTX
+    // EGL_cb of the context of this thread
+    S52_CHECK_MUTX;
+#endif
+
     _eglBeg = eglBeg;
     _eglEnd = eglEnd;
     _EGLctx = EGLctx;
 
+#ifdef S52_USE_CTX
+    GMUTEXUNLOCK(&_mp_mutex);
+#endif
+
 #endif
 
     return TRUE;
@@ -5822,6 +7982,8 @@ static int        _isObjNameValid(S52_obj *obj, const char *objName)
 
 DLL int    STD S52_dumpS57IDPixels(const char *toFilename, unsigned int S57ID, unsigned int width, unsigned int height)
 {
+    S52_TR_CALL(S52_TR_dumpS57IDPixels, "suuu", toFilename, S57ID, width, height);
+
     int ret = FALSE;
 
     S52_CHECK_MUTX_INIT;
@@ -5956,6 +8118,8 @@ static S52ObjectHandle     _newMarObj(const char *plibObjName, S52ObjectType obj
     // doCS now (intead of _app() - expensive)
     S52_PL_resolveSMB(obj, NULL);
 
+    _dirtyObj(obj);
+
     // set timer for afterglow
     if (0 == g_strcmp0("vessel", S57_getName(geo))) {
         S52_PL_setTimeNow(obj);
@@ -5975,6 +8139,8 @@ static S52ObjectHandle     _newMarObj(const char *plibObjName, S52ObjectType obj
 DLL S52ObjectHandle STD S52_newMarObj(const char *plibObjName, S52ObjectType objType,
                                       unsigned int xyznbr, double *xyz, const char *listAttVal)
 {
+    S52_TR_CALL_SEQ(S52_TR_newMarObj, "siuas", plibObjName, objType, xyznbr, ((NULL==xyz) ? 0 : xyznbr*3), xyz, listAttVal);
+
     return_if_null(plibObjName);
 
     S52ObjectHandle objH = FALSE;
@@ -6012,6 +8178,8 @@ DLL S52ObjectHandle STD S52_newMarObj(const char *plibObjName, S52ObjectType obj
 
 exit:
 
+    S52_TR_RET(objH);
+
     GMUTEXUNLOCK(&_mp_mutex);
 
     return objH;
@@ -6019,6 +8187,8 @@ exit:
 
 DLL S52ObjectHandle STD S52_getMarObj(unsigned int S57ID)
 {
+    S52_TR_CALL_SEQ(S52_TR_getMarObj, "u", S57ID);
+
     S52ObjectHandle ret = 0;
 
     S52_CHECK_MUTX_INIT;
@@ -6030,6 +8200,8 @@ DLL S52ObjectHandle STD S52_getMarObj(unsigned int S57ID)
 
 exit:
 
+    S52_TR_RET(ret);
+
     GMUTEXUNLOCK(&_mp_mutex);
 
     return ret;
@@ -6056,6 +8228,8 @@ static S52ObjectHandle     _delMarObj(S52ObjectHandle objH)
         array = _marinerCell->renderBin[disPrioIdx][obj_t];
     }
 
+    _dirtyObj(obj);
+
     // will call _delObj() if free_func() set
     if (TRUE == g_ptr_array_remove(array, obj)) {
         //_delObj(obj, NULL);
@@ -6075,6 +8249,8 @@ DLL S52ObjectHandle STD S52_delMarObj(S52ObjectHandle objH)
 // Note: will happen when an AIS get older than S52_MAR_DISP_VESSEL_DELAY
 //       and self-destruct
 {
+    S52_TR_CALL(S52_TR_delMarObj, "u", objH);
+
     S52_CHECK_MUTX_INIT;
 
     PRINTF("objH:%u\n", objH);
@@ -6094,9 +8270,12 @@ exit:
 
 DLL S52ObjectHandle STD S52_toggleDispMarObj(S52ObjectHandle  objH)
 {
+    S52_TR_CALL(S52_TR_toggleDispMarObj, "u", objH);
+
     S52_CHECK_MUTX_INIT;
 
     S52_obj *obj = S52_PL_isObjValid(objH);
+    _dirtyObj(obj);
     if (NULL != obj) {
         if (TRUE == S52_PL_getSupp(obj)) {
             S52_PL_setSupp(obj, FALSE);
@@ -6116,6 +8295,8 @@ exit:
 
 DLL S52ObjectHandle STD S52_newCLRLIN(int catclr, double latBegin, double lonBegin, double latEnd, double lonEnd)
 {
+    S52_TR_CALL_SEQ(S52_TR_newCLRLIN, "idddd", catclr, latBegin, lonBegin, latEnd, lonEnd);
+
     S52ObjectHandle clrlin = FALSE;
 
     S52_CHECK_MUTX_INIT;
@@ -6144,6 +8325,8 @@ DLL S52ObjectHandle STD S52_newCLRLIN(int catclr, double latBegin, double lonBeg
 
 exit:
 
+    S52_TR_RET(clrlin);
+
     GMUTEXUNLOCK(&_mp_mutex);
 
     return clrlin;
@@ -6153,6 +8336,8 @@ DLL S52ObjectHandle STD S52_newLEGLIN(int select, double plnspd, double wholinDi
                                       double latBegin, double lonBegin, double latEnd, double lonEnd,
                                       S52ObjectHandle previousLEGLIN)
 {
+    S52_TR_CALL_SEQ(S52_TR_newLEGLIN, "iddddddu", select, plnspd, wholinDist, latBegin, lonBegin, latEnd, lonEnd, previousLEGLIN);
+
     S52ObjectHandle leglinH = FALSE;
 
     S52_CHECK_MUTX_INIT;
@@ -6270,7 +8455,7 @@ DLL S52ObjectHandle STD S52_newLEGLIN(int select, double plnspd, double wholinDi
                         }
 
                         // over radar
-                        g_ptr_array_add(c->objList_over, obj);
+                        g_ptr_array_add(JRNL(c)->objList_over, obj);
                     }
                 }
             }
@@ -6474,6 +8659,8 @@ DLL S52ObjectHandle STD S52_newLEGLIN(int select, double plnspd, double wholinDi
 
 exit:
 
+    S52_TR_RET(leglinH);
+
     GMUTEXUNLOCK(&_mp_mutex);
 
     return leglinH;
@@ -6481,6 +8668,8 @@ exit:
 
 DLL S52ObjectHandle STD S52_newOWNSHP(const char *label)
 {
+    S52_TR_CALL_SEQ(S52_TR_newOWNSHP, "s", label);
+
     S52_CHECK_MUTX_INIT;
 
     char   attval[80];
@@ -6496,6 +8685,8 @@ DLL S52ObjectHandle STD S52_newOWNSHP(const char *label)
 
 exit:
 
+    S52_TR_RET(_OWNSHP);
+
     GMUTEXUNLOCK(&_mp_mutex);
 
     return _OWNSHP;
@@ -6503,6 +8694,8 @@ exit:
 
 DLL S52ObjectHandle STD S52_setDimension(S52ObjectHandle objH, double a, double b, double c, double d)
 {
+    S52_TR_CALL(S52_TR_setDimension, "udddd", objH, a, b, c, d);
+
     S52_CHECK_MUTX_INIT;
 
     PRINTF("objH:%u, a:%f, b:%f, c:%f, d:%f\n", objH, a, b, c, d);
@@ -6516,6 +8709,7 @@ DLL S52ObjectHandle STD S52_setDimension(S52ObjectHandle objH, double a, double
     //  stwspd: Speed through water,
 
     S52_obj *obj = S52_PL_isObjValid(objH);
+    _dirtyObj(obj);
     if (NULL == obj) {
         objH = FALSE;
         goto exit;
@@ -6548,6 +8742,8 @@ exit:
 
 DLL S52ObjectHandle STD S52_setVector(S52ObjectHandle objH, int vecstb, double course, double speed)
 {
+    S52_TR_CALL(S52_TR_setVector, "uidd", objH, vecstb, course, speed);
+
     S52_CHECK_MUTX_INIT;
 
     // debug
@@ -6564,6 +8760,7 @@ DLL S52ObjectHandle STD S52_setVector(S52ObjectHandle objH, int vecstb, double c
     }
 
     S52_obj *obj = S52_PL_isObjValid(objH);
+    _dirtyObj(obj);
     if (NULL == obj) {
         PRINTF("WARNING: invalid S52ObjectHandle objH\n");
         objH = FALSE;
@@ -6594,6 +8791,8 @@ exit:
 
 DLL S52ObjectHandle STD S52_newPASTRK(int catpst, unsigned int maxpts)
 {
+    S52_TR_CALL_SEQ(S52_TR_newPASTRK, "iu", catpst, maxpts);
+
     S52ObjectHandle pastrk = FALSE;
 
     S52_CHECK_MUTX_INIT;
@@ -6614,6 +8813,8 @@ DLL S52ObjectHandle STD S52_newPASTRK(int catpst, unsigned int maxpts)
 
 exit:
 
+    S52_TR_RET(pastrk);
+
     GMUTEXUNLOCK(&_mp_mutex);
 
     return pastrk;
@@ -6679,6 +8880,8 @@ static S52_obj            *_setPointPosition(S52_obj *obj, double latitude, doub
 DLL S52ObjectHandle STD S52_pushPosition(S52ObjectHandle objH, double latitude, double longitude, double data)
 // FIXME: if ownshp check alarm
 {
+    S52_TR_CALL(S52_TR_pushPosition, "uddd", objH, latitude, longitude, data);
+
     S52_CHECK_MUTX_INIT;
 
     if (NULL == S57_getPrjStr()) {
@@ -6694,6 +8897,7 @@ DLL S52ObjectHandle STD S52_pushPosition(S52ObjectHandle objH, double latitude,
     //time      = _validate_min(time);
 
     S52_obj *obj = S52_PL_isObjValid(objH);
+    _dirtyObj(obj);
     if (NULL == obj) {
         objH = FALSE;
         goto exit;
@@ -6791,6 +8995,8 @@ exit:
 
 DLL S52ObjectHandle STD S52_newVESSEL(int vesrce, const char *label)
 {
+    S52_TR_CALL_SEQ(S52_TR_newVESSEL, "is", vesrce, label);
+
     S52ObjectHandle vessel = FALSE;
 
     S52_CHECK_MUTX_INIT;
@@ -6833,6 +9039,8 @@ DLL S52ObjectHandle STD S52_newVESSEL(int vesrce, const char *label)
 
 exit:
 
+    S52_TR_RET(vessel);
+
     GMUTEXUNLOCK(&_mp_mutex);
 
     return vessel;
@@ -6840,9 +9048,12 @@ exit:
 
 DLL S52ObjectHandle STD S52_setVESSELlabel(S52ObjectHandle objH, const char *newLabel)
 {
+    S52_TR_CALL(S52_TR_setVESSELlabel, "us", objH, newLabel);
+
     S52_CHECK_MUTX_INIT;
 
     S52_obj *obj = S52_PL_isObjValid(objH);
+    _dirtyObj(obj);
     if (NULL == obj) {
         objH = FALSE;
         goto exit;
@@ -6887,11 +9098,14 @@ exit:
 
 DLL S52ObjectHandle STD S52_setVESSELstate(S52ObjectHandle objH, int vesselSelect, int vestat, int vesselTurn)
 {
+    S52_TR_CALL(S52_TR_setVESSELstate, "uiii", objH, vesselSelect, vestat, vesselTurn);
+
     S52_CHECK_MUTX_INIT;
 
     PRINTF("vesselSelect:%i, vestat:%i, vesselTurn:%i\n", vesselSelect, vestat, vesselTurn);
 
     S52_obj *obj = S52_PL_isObjValid(objH);
+    _dirtyObj(obj);
     if (NULL == obj) {
         objH = FALSE;
         goto exit;
@@ -6972,6 +9186,8 @@ exit:
 
 DLL S52ObjectHandle STD S52_newVRMEBL(int vrm, int ebl, int normalLineStyle, int setOrigin)
 {
+    S52_TR_CALL_SEQ(S52_TR_newVRMEBL, "iiii", vrm, ebl, normalLineStyle, setOrigin);
+
     S52ObjectHandle vrmebl = FALSE;
 
     S52_CHECK_MUTX_INIT;
@@ -7017,6 +9233,8 @@ DLL S52ObjectHandle STD S52_newVRMEBL(int vrm, int ebl, int normalLineStyle, int
 
 exit:
 
+    S52_TR_RET(vrmebl);
+
     GMUTEXUNLOCK(&_mp_mutex);
 
     return vrmebl;
@@ -7024,6 +9242,8 @@ exit:
 
 DLL S52ObjectHandle STD S52_setVRMEBL(S52ObjectHandle objH, double pixels_x, double pixels_y, double *brg, double *rge)
 {
+    S52_TR_CALL(S52_TR_setVRMEBL, "udd", objH, pixels_x, pixels_y);
+
     S52_CHECK_MUTX_INIT;
 
     if (NULL == S57_getPrjStr()) {
@@ -7032,6 +9252,7 @@ DLL S52ObjectHandle STD S52_setVRMEBL(S52ObjectHandle objH, double pixels_x, dou
     }
 
     S52_obj *obj = S52_PL_isObjValid(objH);
+    _dirtyObj(obj);
     if (NULL == obj) {
         objH = FALSE;
         goto exit;
@@ -7134,6 +9355,8 @@ exit:
 
 DLL int             STD S52_newCSYMB(void)
 {
+    S52_TR_CALL(S52_TR_newCSYMB, "");
+
     int ret = FALSE;
 
     S52_CHECK_MUTX_INIT;
@@ -267,6 +267,55 @@ DLL int    STD S52_getTextDisp(unsigned int dispPrioIdx);
 typedef int (*S52_EGL_cb)(void *EGLctx, const char *tag);
 DLL int    STD S52_setEGLCallBack(S52_EGL_cb eglBeg, S52_EGL_cb eglEnd, void *EGLctx);
 
+#ifdef S52_USE_CTX
+/**
+ * S52_newCtx: new chart view context
+ *
+ * A context hold the view, viewport, Mariners' Parameter, text display,
+ * EGL callback and FB copy of a chart view. Cells, PLib and mariners' object
+ * are shared (loaded once) by all context.
+ * The new context is a copy of the current context of the calling thread.
+ *
+ * Note: each context render in its own GL context, these must be in the same
+ * share group (see eglCreateContext(share_context)) since VBO and texture are shared
+ * Note: with GL2 / GLES2 the frame of each context are drawn in parallel, one
+ * frame at a time per context (GL1 and SW: one frame at a time), setter are serialized
+ * but S52_setView() that only touch the context of the calling thread (frame of other
+ * context keep going). S52_draw() / S52_drawLast() in a context of S52_newCtx() wait
+ * for a setter instead of failing (render thread). CS are resolved again (frame holding the writer lock) only when a context
+ * use other Mariners' Parameter for CS (safety contour, shallow pattern, ..)
+ * Note: query (S52_getMarinerParam(), S52_xy2LL(), S52_getView(), ..) read the
+ * context of the calling thread, so they run in parallel with the frame of any context
+ *
+ *
+ * Return: (transfer none): context, NULL on failure
+ */
+DLL void * STD S52_newCtx(void);
+
+/**
+ * S52_setCtx: use @ctx for all S52_* call from this thread
+ * @ctx: (in) (allow-none): context from S52_newCtx(), NULL for the default context
+ *
+ * The default context is created by S52_init().
+ *
+ *
+ * Return: TRUE on success, else FALSE
+ */
+DLL int    STD S52_setCtx(void *ctx);
+
+/**
+ * S52_delCtx: delete @ctx
+ * @ctx: (in): context from S52_newCtx()
+ *
+ * Note: fail if @ctx is in use (call S52_setCtx(NULL) first) or is the default context
+ * Note: other thread using @ctx fall back to the default context
+ *
+ *
+ * Return: TRUE on success, else FALSE
+ */
+DLL int    STD S52_delCtx(void *ctx);
+#endif  // S52_USE_CTX
+
 /**
  * S52_setRADARCallBack:
  * @cb: (scope call) (allow-none):
@@ -322,6 +371,170 @@ DLL int    STD S52_draw(void);
  */
 DLL int    STD S52_drawLast(void);
 
+/**
+ * S52_getDrawTime: time spent in each phase of the last S52_draw() / S52_drawLast()
+ * @app:  (out) (allow-none): S52_draw(): APP  - update object (CS, HO data limit, ..) (msec)
+ * @cull: (out) (allow-none): S52_draw(): CULL - object outside view, SCAMIN, ..       (msec)
+ * @draw: (out) (allow-none): S52_draw(): DRAW - render (text excluded)              (msec)
+ * @text: (out) (allow-none): S52_draw(): DRAW - render text                         (msec)
+ * @last: (out) (allow-none): S52_drawLast()                                         (msec)
+ *
+ * Note: CPU time as seen by libS52, GL call are async and the driver
+ * might defer work up to EGL swap (after the end of S52_draw())
+ *
+ *
+ * Return: TRUE on success, else FALSE
+ */
+DLL int    STD S52_getDrawTime(double *app, double *cull, double *draw, double *text, double *last);
+
+#ifdef S52_USE_GPU_TIMER
+/**
+ * S52_getGPUTime: GPU time of a recent S52_draw() / S52_drawLast()
+ * @frame:  (out) (allow-none): number of the S52_draw() of this result
+ * @draw:   (out) (allow-none): S52_draw()                                  (msec)
+ * @text:   (out) (allow-none): S52_draw(): text (TE, TX)                   (msec)
+ * @raster: (out) (allow-none): S52_draw(): raster / radar                  (msec)
+ * @last:   (out) (allow-none): S52_drawLast()                              (msec)
+ * @prio:   (out) (allow-none): S52_draw(): object, by display priority    (msec, array of 10)
+ * @cmd:    (out) (allow-none): S52_draw(): object, by command SY LS LC AC AP (msec, array of 5)
+ *
+ * GL timestamp query (GL_EXT_disjoint_timer_query / GL_ARB_timer_query) at each change of
+ * display priority / command word / stage. Result are read a few frames later, so the GPU
+ * is not stalled. Without timer query, CPU timestamp (time to submit the GL calls).
+ * Also in S52_getStats() ("gpuTime").
+ *
+ *
+ * Return: 2 GPU time, 1 CPU time (no timer query), 0 no result yet
+ */
+DLL int    STD S52_getGPUTime(unsigned int *frame, double *draw, double *text, double *raster, double *last, double *prio, double *cmd);
+#endif
+
+/**
+ * S52_needDraw: scene changed since the last S52_draw()
+ *
+ * A change generation is kept for the view (and viewport), Mariners' Parameter (text
+ * display, color), cells (load, done, update, PLib), S57 class suppression, mariners'
+ * object drawn by S52_draw() and raster / RADAR input.
+ * Host can skip S52_draw() when nothing changed (idle display).
+ *
+ * Note: always TRUE while a RADAR callback is set (new image at each draw)
+ *
+ *
+ * Return: TRUE if S52_draw() is needed, else FALSE
+ */
+DLL int    STD S52_needDraw(void);
+
+/**
+ * S52_needDrawLast: scene changed since the last S52_drawLast()
+ *
+ * Same as S52_needDraw() plus the mariners' object of layer 9 (position, label, vector, ..)
+ * Also TRUE after a S52_draw() - the new framebuffer need layer 9 on top
+ *
+ * Note: vessel afterglow and stray vessel (S52_MAR_DISP_VESSEL_DELAY) change with
+ * time only - host using them should still call S52_drawLast() periodically
+ *
+ *
+ * Return: TRUE if S52_drawLast() is needed, else FALSE
+ */
+DLL int    STD S52_needDrawLast(void);
+
+/**
+ * S52_setDirtyCallBack: register callback called when the scene become dirty
+ * @cb:        (in) (allow-none): callback, NULL to remove
+ * @user_data: (in): passed to @cb
+ *
+ * S52_dirty_cb: called once on the transition clean --> dirty
+ * @user_data: (in): from S52_setDirtyCallBack()
+ * @drawLast:  (in): TRUE if only S52_drawLast() is needed, FALSE if S52_draw() is needed
+ *
+ * Note: @cb is called from the thread doing the change, with libS52 lock held -
+ * do not call S52_* from @cb, just schedule a redraw (ex: g_idle_add())
+ *
+ *
+ * Return: TRUE on success, else FALSE
+ */
+typedef int (*S52_dirty_cb)(void *user_data, int drawLast);
+DLL int    STD S52_setDirtyCallBack(S52_dirty_cb cb, void *user_data);
+
+#ifdef S52_USE_RENDER_THREAD
+/**
+ * S52_setRenderThread: start / stop the render thread
+ * @on: (in): TRUE start, FALSE stop (after pending frame)
+ *
+ * The render thread call S52_draw() / S52_drawLast() queued by S52_drawAsync() / S52_drawLastAsync().
+ * The EGL callback (S52_setEGLCallBack()) are then called from the render thread,
+ * so the host must release the GL context (eglMakeCurrent(EGL_NO_CONTEXT)) on its thread.
+ *
+ * Note: do not call S52_draw() / S52_drawLast() directly while the render thread is on
+ * Note: S52_setMarinerParam() from an other thread is staged (return TRUE) and applied by the
+ * render thread before the next frame of that context, the view go with the frame - so these
+ * don't wait for the frame being rendered. Other S52_* setter still do (lock).
+ * Note: the render thread wait for a setter holding the lock (ex: S52_loadCell())
+ *
+ *
+ * Return: TRUE on success, else FALSE
+ */
+DLL int    STD S52_setRenderThread(int on);
+
+/**
+ * S52_drawAsync: queue a S52_setView() + S52_draw() to the render thread
+ * @cLat:  (in): latitude  of the center of the view (deg)
+ * @cLon:  (in): longitude of the center of the view (deg)
+ * @rNM:   (in): range (NM)
+ * @north: (in): angle from north (deg)
+ *
+ * Return immediatly. If frames are pending when the render thread is ready,
+ * only the newest is drawn, older frame are dropped (their fence signaled).
+ * Mariners' Parameter are those set before this call (see S52_setRenderThread()).
+ * With S52_USE_CTX, the frame is drawn in the context of the calling thread.
+ *
+ *
+ * Return: fence (see S52_waitFence()), 0 on failure
+ */
+DLL unsigned int STD S52_drawAsync(double cLat, double cLon, double rNM, double north);
+
+/**
+ * S52_drawLastAsync: queue a S52_drawLast() to the render thread
+ *
+ *
+ * Return: fence (see S52_waitFence()), 0 on failure
+ */
+DLL unsigned int STD S52_drawLastAsync(void);
+
+/**
+ * S52_waitFence: wait for the frame of @fence
+ * @fence:      (in): from S52_drawAsync() / S52_drawLastAsync()
+ * @timeout_ms: (in): 0 poll, -1 wait until done
+ *
+ *
+ * Note: a frame is dropped when a newer S52_drawAsync() of the same context is pending
+ *
+ *
+ * Return: TRUE frame drawn, 2 frame dropped, FALSE on timeout or if the frame could not be drawn
+ */
+DLL int    STD S52_waitFence(unsigned int fence, int timeout_ms);
+#endif  // S52_USE_RENDER_THREAD
+
+/**
+ * S52_getStats: runtime statistic and memory accounting
+ * @cellName: (in) (allow-none): cell name (ex: CA479017.000), "*" for all cells, or NULL
+ *
+ * NULL:  JSON object of the last frame - time of each phase (msec, see S52_getDrawTime()),
+ *        cull count, GL count (obj, cmd, clip, triangles, glDrawArrays, symbol VBO bind) of DRAW and LAST,
+ *        total nbr of obj and vertex, CPU bytes (geo, att, prim, obj, text)
+ *        and GPU bytes (vbo, tex)
+ * "*":   as NULL plus an array "cells" with the obj, vertex and bytes of each cell
+ * cell:  obj, vertex and bytes of this cell only
+ *
+ * Note: bytes are an estimate (malloc overhead and PLib not counted)
+ * Note: counters are updated during draw, memory of a cell is cached and walked again only
+ *       after its obj changed (load, update, CS, tessellation / VBO at draw)
+ *
+ *
+ * Return: (transfer none): JSON string, NULL if cellName not loaded
+ */
+DLL const char * STD S52_getStats(const char *cellName);
+
 
 // DEPRECATED
 DLL int    STD S52_drawLayer(const char *name);
@@ -396,6 +609,8 @@ DLL const char * STD S52_pickAt(double pixels_x, double pixels_y);
  * Convert pixel X/Y to longitude/latitude (deg)
  *
  * Note: call will fail if no ENC loaded (via S52_loadCell)
+ * Note: use the view of the last frame drawn (fail if none yet) - can be call
+ * from any thread, in parallel with S52_draw()
  *
  *
  * Return: TRUE on success, else FALSE
@@ -410,11 +625,46 @@ DLL int    STD S52_xy2LL(double *pixels_x,  double *pixels_y);
  * Convert longitude/latitude to X/Y (pixel - origin LL corner)
  *
  * Note: call will fail if no ENC loaded (via S52_loadCell)
+ * Note: use the view of the last frame drawn (fail if none yet) - can be call
+ * from any thread, in parallel with S52_draw()
  *
  *
  * Return: TRUE on success, else FALSE
  */
 DLL int    STD S52_LL2xy(double *longitude, double *latitude);
+
+/**
+ * S52_xy2LLv:
+ * @npt:    number of point
+ * @xy:     (inout) (array): pixel X/Y, origin LL corner (return longitude/latitude)
+ * @stride: distance in double from one point to the next (0 - packed X/Y, same as 2, 1 is invalid)
+ *
+ * Batch version of S52_xy2LL() - convert @npt pixel X/Y 'in-place' with
+ * one lock and one PROJ call for the whole array.
+ * Ex: stride 3 to convert the X/Y of an array of X/Y/Z.
+ *
+ * Note: use the view of the last frame drawn (fail if none yet)
+ *
+ *
+ * Return: TRUE on success, else FALSE
+ */
+DLL int    STD S52_xy2LLv(unsigned int npt, double *xy, unsigned int stride);
+
+/**
+ * S52_LL2xyv:
+ * @npt:    number of point
+ * @xy:     (inout) (array): longitude/latitude in degree (return pixel X/Y - origin LL corner)
+ * @stride: distance in double from one point to the next (0 - packed lon/lat, same as 2, 1 is invalid)
+ *
+ * Batch version of S52_LL2xy() - convert @npt longitude/latitude 'in-place' with
+ * one lock and one PROJ call for the whole array.
+ *
+ * Note: use the view of the last frame drawn (fail if none yet)
+ *
+ *
+ * Return: TRUE on success, else FALSE
+ */
+DLL int    STD S52_LL2xyv(unsigned int npt, double *xy, unsigned int stride);
 // --------------
 
 
@@ -440,6 +690,29 @@ DLL int    STD S52_LL2xy(double *longitude, double *latitude);
 typedef int (*S52_log_cb)(const char *str);
 DLL int    STD S52_init(int screen_pixels_w, int screen_pixels_h, int screen_mm_w, int screen_mm_h, S52_log_cb log_cb);
 
+/**
+ * S52_setLogLevel: runtime log level
+ * @level: (in): S52_LOG_ERROR .. S52_LOG_DEBUG, message above @level are skipped (not formated)
+ *
+ * Level of a message is given by its prefix: "ERROR:", "WARNING:", "NOTE:",
+ * anything else is S52_LOG_DEBUG. Initial level from env S52_LOG_LEVEL (0-3), default S52_LOG_DEBUG.
+ * Each call site is also rate limited (20 msg/sec, ERROR excepted).
+ *
+ * Note: with S52_USE_LOG_ASYNC message are queued in a per-thread ring and written
+ * by a thread - @log_cb of S52_init() is then called from that thread (ERROR are written at once)
+ * Note: need S52_DEBUG or S52_USE_LOGFILE
+ *
+ *
+ * Return: TRUE on success, else FALSE
+ */
+typedef enum S52_logLevel {
+    S52_LOG_ERROR   = 0,
+    S52_LOG_WARNING = 1,
+    S52_LOG_NOTE    = 2,
+    S52_LOG_DEBUG   = 3
+} S52_logLevel;
+DLL int    STD S52_setLogLevel(S52_logLevel level);
+
 /**
  * S52_done:
  *
@@ -492,6 +765,10 @@ typedef int (*S52_loadObject_cb)(const char *objname, /* OGRFeatureH */ void *fe
  *
  * if @encPath is NULL look for label 'CHART' in s52.cfg
  * if @encPath is a path load all S57 base cell + update
+ * if @encPath is a CATALOG.031 (or a path with one) and libS52 is compiled with
+ * S52_USE_CHART_MANAGER then only the catalogue is read, cells are loaded
+ * (by a thread) as they come near the view and unloaded, least recently viewed
+ * first, when over the memory budget (label CM_BUDGET in s52.cfg)
  * if @loadObject_cb is NULL then S52_loadObject() is executed
  *
  * Note: the first call to S52_loadCell() will set the Mercator Projection Latitude
@@ -514,6 +791,23 @@ DLL int    STD S52_loadCell(const char *encPath,  S52_loadObject_cb loadObject_c
  * Return: TRUE on success, else FALSE
  */
 DLL int    STD S52_doneCell        (const char *encPath);
+
+/**
+ * S52_loadUpdate:
+ * @updPath: (in): S-57 update file (.001, .002, ..)
+ *
+ * Apply the update to the loaded base cell (.000) without a full reload:
+ * only object inserted, deleted or modified (by LNAM) are rebuilt, with
+ * CS of their neighbour (TOPMAR, LIGHTS, DEPARE, ..)
+ *
+ * Note: update must be applied in sequence - previous update (.001 .. .00N-1)
+ *       are read again to resolve the geometry of @updPath
+ * Note: need libS52 compiled with S52_USE_ISO8211
+ *
+ *
+ * Return: TRUE on success, else FALSE
+ */
+DLL int    STD S52_loadUpdate      (const char *updPath);
 // ---- CHART LOADING (cell) -------------------------------------------
 
 
@@ -0,0 +1,478 @@
+// S52CM.c: Chart Manager - load / unload cell of a CATALOG.031 following the view
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Note: only the CATD records (file name + extent) are read at start-up.
+// A cell is queued when it come near the view and loaded by a thread
+// (via S52_loadCell()). Cell outside the view are unloaded, least recently
+// viewed first, when the memory used by the loaded cells is over budget.
+// Unload are only queued by S52_CM_update() (in S52_draw()) - S52.c apply
+// them via S52_CM_unload() while holding the writer lock.
+// The size of a cell is re-sampled after its first draw (S52_CM_setSize()),
+// once tessellation and VBO exist.
+
+
+#include "S52CM.h"
+#include "S57iso8211.h" // S57_iso8211ReadCATALOG()
+#include "S52utils.h"   // PRINTF()
+
+#include <glib.h>
+#include <string.h>     // strlen()
+#include <math.h>       // INFINITY, isnan()
+
+
+#define PREFETCH_MARGIN  0.25   // fraction of the view added on all side
+#define PREFETCH_PAN     1.00   // fraction of the view added in the pan direction
+
+// max view range (NM) to load a cell of this navigational purpose (3rd char of cell name)
+// ie overview, general, coastal, approach, harbour, berthing
+static const double _maxRangeNM[7] = {0.0, INFINITY, 240.0, 60.0, 20.0, 6.0, 2.0};
+
+typedef enum _cm_state {
+    _CM_UNLOADED = 0,
+    _CM_QUEUED,         // in _queue
+    _CM_LOADING,        // in the loader thread
+    _CM_LOADED,
+    _CM_UNLOADING,      // LRU - waiting for S52_CM_unload()
+    _CM_FAILED,         // don't retry
+    _CM_USER            // unloaded by user - don't reload
+} _cm_state;
+
+typedef struct _cmcell {
+    gchar    *encPath;
+    ObjExt_t  ext;
+    int       intu;     // navigational purpose [1..6]
+    gsize     size;     // resident bytes (from loadCell_cb) - set when loaded
+    guint     lastView; // _frame number when last near the view (LRU)
+    _cm_state state;
+} _cmcell;
+
+static GPtrArray          *_cmList      = NULL;     // _cmcell
+static ObjExt_t            _cmExt       = {INFINITY, INFINITY, -INFINITY, -INFINITY};
+static GAsyncQueue        *_queue       = NULL;     // _cmcell to load
+static GThread            *_thread      = NULL;
+static _cmcell             _quit;                   // sentinel that stop _loader()
+static S52_CM_loadCell_cb  _loadCell_cb = NULL;
+static guint64             _budget      = 0;        // bytes, 0 - no limit
+static guint64             _loaded      = 0;        // bytes
+static guint               _nUnload     = 0;        // cell in state _CM_UNLOADING
+static guint               _frame       = 0;
+static double              _cLat        = NAN;      // last view center - pan direction
+static double              _cLon        = NAN;
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticMutex  _cm_mutex = G_STATIC_MUTEX_INIT;
+#define GMUTEXLOCK   g_static_mutex_lock
+#define GMUTEXUNLOCK g_static_mutex_unlock
+#else
+static GMutex        _cm_mutex;
+#define GMUTEXLOCK   g_mutex_lock
+#define GMUTEXUNLOCK g_mutex_unlock
+#endif
+
+
+static gpointer   _loader(gpointer data)
+{
+    (void)data;
+
+    for (;;) {
+        _cmcell *c = (_cmcell *)g_async_queue_pop(_queue);
+        if (&_quit == c)
+            break;
+
+        GMUTEXLOCK(&_cm_mutex);
+        // stale - left the prefetch region or allready loaded
+        if (_CM_QUEUED != c->state) {
+            GMUTEXUNLOCK(&_cm_mutex);
+            continue;
+        }
+        c->state = _CM_LOADING;
+        GMUTEXUNLOCK(&_cm_mutex);
+
+        PRINTF("DEBUG: loading %s\n", c->encPath);
+
+        gsize size = 0;
+        int   ret  = _loadCell_cb(c->encPath, &size);
+
+        GMUTEXLOCK(&_cm_mutex);
+        if (TRUE == ret) {
+            c->state = _CM_LOADED;
+            c->size  = size;
+            _loaded += size;
+        } else {
+            PRINTF("WARNING: fail to load %s\n", c->encPath);
+            c->state = _CM_FAILED;
+        }
+        GMUTEXUNLOCK(&_cm_mutex);
+    }
+
+    return NULL;
+}
+
+static int        _addCATD(const char *file, const char *impl, double S, double W, double N, double E, void *user_data)
+{
+    const gchar *dir = (const gchar *)user_data;
+
+    // skip text, picture, update, ..
+    if ((0!=g_strcmp0(impl, "BIN")) || (FALSE==g_str_has_suffix(file, ".000")))
+        return FALSE;
+
+    if (isnan(S) || isnan(W) || isnan(N) || isnan(E)) {
+        PRINTF("WARNING: no extent in CATALOG for %s - skipped\n", file);
+        return FALSE;
+    }
+
+    // FILE is relative to CATALOG.031 with DOS path
+    gchar *name = g_strdup(file);
+    g_strdelimit(name, "\\/", G_DIR_SEPARATOR);
+    gchar *base = g_path_get_basename(name);
+
+    _cmcell *c  = g_new0(_cmcell, 1);
+    c->encPath  = g_build_filename(dir, name, NULL);
+    c->ext.S    = S;
+    c->ext.W    = W;
+    c->ext.N    = N;
+    c->ext.E    = E;
+    c->intu     = ((strlen(base)>2) && ('1'<=base[2]) && (base[2]<='6')) ? (base[2]-'0') : 1;
+    c->state    = _CM_UNLOADED;
+
+    g_ptr_array_add(_cmList, c);
+
+    _cmExt.S = MIN(_cmExt.S, S);
+    _cmExt.W = MIN(_cmExt.W, W);
+    _cmExt.N = MAX(_cmExt.N, N);
+    _cmExt.E = MAX(_cmExt.E, E);
+
+    g_free(base);
+    g_free(name);
+
+    return TRUE;
+}
+
+static void       _freeCMCell(_cmcell *c)
+{
+    g_free(c->encPath);
+    g_free(c);
+
+    return;
+}
+
+static int        _intersect(ObjExt_t A, ObjExt_t B)
+{
+    if ((B.N < A.S) || (B.S > A.N) || (B.E < A.W) || (B.W > A.E))
+        return FALSE;
+
+    return TRUE;
+}
+
+static int        _queueCell(_cmcell *c)
+{
+    // back near the view before S52_CM_unload() - keep it
+    if (_CM_UNLOADING == c->state) {
+        c->state = _CM_LOADED;
+        _loaded += c->size;
+        --_nUnload;
+    }
+
+    if (_CM_UNLOADED == c->state) {
+        c->state = _CM_QUEUED;
+        g_async_queue_push(_queue, c);
+    }
+
+    return TRUE;
+}
+
+int            S52_CM_init(const char *catalog, unsigned int budgetMB, S52_CM_loadCell_cb loadCell_cb)
+{
+    return_if_null(catalog);
+    return_if_null(loadCell_cb);
+
+    if (NULL != _cmList) {
+        PRINTF("WARNING: Chart Manager allready init\n");
+        return FALSE;
+    }
+
+    gchar *fname = NULL;
+    if (TRUE == g_file_test(catalog, G_FILE_TEST_IS_DIR))
+        fname = g_build_filename(catalog, "CATALOG.031", NULL);
+    else
+        fname = g_strdup(catalog);
+
+    gchar *dir = g_path_get_dirname(fname);
+
+    _cmList = g_ptr_array_new_with_free_func((GDestroyNotify)_freeCMCell);
+    S57_iso8211ReadCATALOG(fname, _addCATD, dir);
+
+    g_free(dir);
+    g_free(fname);
+
+    if (0 == _cmList->len) {
+        PRINTF("WARNING: no cell in CATALOG (%s)\n", catalog);
+        g_ptr_array_free(_cmList, TRUE);
+        _cmList = NULL;
+        return FALSE;
+    }
+
+    PRINTF("NOTE: Chart Manager: %i cells, budget: %u MB\n", _cmList->len, budgetMB);
+
+    _loadCell_cb = loadCell_cb;
+    _budget      = (guint64)budgetMB * 1024 * 1024;
+    _loaded      = 0;
+    _nUnload     = 0;
+    _frame       = 0;
+    _cLat        = NAN;
+    _cLon        = NAN;
+    _queue       = g_async_queue_new();
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+    if (!g_thread_supported())
+        g_thread_init(NULL);
+    _thread = g_thread_create(_loader, NULL, TRUE, NULL);
+#else
+    _thread = g_thread_new("S52CM", _loader, NULL);
+#endif
+
+    return TRUE;
+}
+
+int            S52_CM_done(void)
+{
+    if (NULL == _cmList)
+        return FALSE;
+
+    // stop loader - after the cell being loaded
+    g_async_queue_push(_queue, &_quit);
+    g_thread_join(_thread);
+    _thread = NULL;
+
+    g_async_queue_unref(_queue);
+    _queue = NULL;
+
+    g_ptr_array_free(_cmList, TRUE);
+    _cmList = NULL;
+
+    _cmExt.S =  INFINITY;
+    _cmExt.W =  INFINITY;
+    _cmExt.N = -INFINITY;
+    _cmExt.E = -INFINITY;
+
+    return TRUE;
+}
+
+int            S52_CM_isInit(void)
+{
+    return (NULL == _cmList) ? FALSE : TRUE;
+}
+
+int            S52_CM_getExt(ObjExt_t *ext)
+{
+    return_if_null(ext);
+
+    if (NULL == _cmList)
+        return FALSE;
+
+    *ext = _cmExt;
+
+    return TRUE;
+}
+
+int            S52_CM_update(ObjExt_t view, double rangeNM)
+{
+    if (NULL == _cmList)
+        return FALSE;
+
+    GMUTEXLOCK(&_cm_mutex);
+
+    ++_frame;
+
+    // prefetch region - extended in the pan direction
+    double   dLat = view.N - view.S;
+    double   dLon = view.E - view.W;
+    double   cLat = (view.N + view.S) / 2.0;
+    double   cLon = (view.E + view.W) / 2.0;
+    ObjExt_t pre  = {view.W - dLon*PREFETCH_MARGIN, view.S - dLat*PREFETCH_MARGIN,
+                     view.E + dLon*PREFETCH_MARGIN, view.N + dLat*PREFETCH_MARGIN};
+
+    if (!isnan(_cLat)) {
+        if (cLon > _cLon) pre.E += dLon*PREFETCH_PAN;
+        if (cLon < _cLon) pre.W -= dLon*PREFETCH_PAN;
+        if (cLat > _cLat) pre.N += dLat*PREFETCH_PAN;
+        if (cLat < _cLat) pre.S -= dLat*PREFETCH_PAN;
+    }
+    _cLat = cLat;
+    _cLon = cLon;
+
+    // queue cell in view first, then the prefetch region
+    for (guint i=0; i<_cmList->len; ++i) {
+        _cmcell *c = (_cmcell *)g_ptr_array_index(_cmList, i);
+        if ((rangeNM<=_maxRangeNM[c->intu]) && (TRUE==_intersect(view, c->ext))) {
+            c->lastView = _frame;
+            _queueCell(c);
+        }
+    }
+    for (guint i=0; i<_cmList->len; ++i) {
+        _cmcell *c = (_cmcell *)g_ptr_array_index(_cmList, i);
+        if ((rangeNM<=_maxRangeNM[c->intu]) && (TRUE==_intersect(pre, c->ext))) {
+            c->lastView = _frame;
+            _queueCell(c);
+        } else {
+            // left the prefetch region before the loader got to it
+            if (_CM_QUEUED == c->state)
+                c->state = _CM_UNLOADED;
+        }
+    }
+
+    // over budget - unload least recently viewed cell (not near the view)
+    while ((0!=_budget) && (_loaded>_budget)) {
+        _cmcell *lru = NULL;
+        for (guint i=0; i<_cmList->len; ++i) {
+            _cmcell *c = (_cmcell *)g_ptr_array_index(_cmList, i);
+            if ((_CM_LOADED==c->state) && (_frame!=c->lastView))
+                if ((NULL==lru) || (c->lastView<lru->lastView))
+                    lru = c;
+        }
+        if (NULL == lru)
+            break;
+
+        PRINTF("DEBUG: queue unload %s (%lu bytes loaded)\n", lru->encPath, (unsigned long)_loaded);
+
+        lru->state = _CM_UNLOADING;
+        _loaded   -= lru->size;
+        ++_nUnload;
+    }
+
+    GMUTEXUNLOCK(&_cm_mutex);
+
+    return TRUE;
+}
+
+int            S52_CM_needUnload(void)
+{
+    if (NULL == _cmList)
+        return FALSE;
+
+    GMUTEXLOCK(&_cm_mutex);
+    int ret = (0 < _nUnload) ? TRUE : FALSE;
+    GMUTEXUNLOCK(&_cm_mutex);
+
+    return ret;
+}
+
+int            S52_CM_unload(S52_CM_doneCell_cb doneCell_cb)
+{
+    return_if_null(doneCell_cb);
+
+    if (NULL == _cmList)
+        return FALSE;
+
+    GMUTEXLOCK(&_cm_mutex);
+
+    for (guint i=0; (0<_nUnload) && (i<_cmList->len); ++i) {
+        _cmcell *c = (_cmcell *)g_ptr_array_index(_cmList, i);
+        if (_CM_UNLOADING != c->state)
+            continue;
+
+        PRINTF("DEBUG: unloading %s\n", c->encPath);
+
+        doneCell_cb(c->encPath);
+        c->state = _CM_UNLOADED;
+        --_nUnload;
+    }
+
+    GMUTEXUNLOCK(&_cm_mutex);
+
+    return TRUE;
+}
+
+int            S52_CM_doneCell(const char *encPath)
+{
+    return_if_null(encPath);
+
+    if (NULL == _cmList)
+        return FALSE;
+
+    int    ret  = FALSE;
+    gchar *base = g_path_get_basename(encPath);
+
+    GMUTEXLOCK(&_cm_mutex);
+
+    for (guint i=0; i<_cmList->len; ++i) {
+        _cmcell *c     = (_cmcell *)g_ptr_array_index(_cmList, i);
+        gchar   *cbase = g_path_get_basename(c->encPath);
+        int      same  = (0 == g_strcmp0(base, cbase)) ? TRUE : FALSE;
+        g_free(cbase);
+
+        if (TRUE == same) {
+            if (_CM_LOADED == c->state)
+                _loaded -= c->size;
+            if (_CM_UNLOADING == c->state)
+                --_nUnload;
+            c->state = _CM_USER;
+            ret      = TRUE;
+            break;
+        }
+    }
+
+    GMUTEXUNLOCK(&_cm_mutex);
+
+    g_free(base);
+
+    return ret;
+}
+
+int            S52_CM_setSize(const char *encPath, gsize size)
+{
+    return_if_null(encPath);
+
+    if (NULL == _cmList)
+        return FALSE;
+
+    int    ret  = FALSE;
+    gchar *base = g_path_get_basename(encPath);
+
+    GMUTEXLOCK(&_cm_mutex);
+
+    for (guint i=0; i<_cmList->len; ++i) {
+        _cmcell *c     = (_cmcell *)g_ptr_array_index(_cmList, i);
+        gchar   *cbase = g_path_get_basename(c->encPath);
+        int      same  = (0 == g_strcmp0(base, cbase)) ? TRUE : FALSE;
+        g_free(cbase);
+
+        if (TRUE == same) {
+            // loader not done - the caller retry
+            if ((_CM_LOADED!=c->state) && (_CM_UNLOADING!=c->state))
+                break;
+
+            // UNLOADING is allready out of _loaded
+            if (_CM_LOADED == c->state)
+                _loaded = _loaded - c->size + size;
+            c->size = size;
+            ret     = TRUE;
+            break;
+        }
+    }
+
+    GMUTEXUNLOCK(&_cm_mutex);
+
+    g_free(base);
+
+    return ret;
+}
@@ -0,0 +1,64 @@
+// S52CM.h: Chart Manager - load / unload cell of a CATALOG.031 following the view
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _S52CM_H_
+#define _S52CM_H_
+
+#include "S57data.h"    // ObjExt_t
+
+// load a cell - called from the CM thread (must take the lock)
+// size: resident bytes of the cell once loaded
+typedef int (*S52_CM_loadCell_cb)(const char *encPath, gsize *size);
+// unload a cell - called from S52_CM_unload() (writer lock held)
+typedef int (*S52_CM_doneCell_cb)(const char *encPath);
+
+// index CATALOG.031 (file or ENC_ROOT) and start the loader thread
+// budgetMB: memory used by the cells kept loaded (0 - no limit)
+int S52_CM_init(const char *catalog, unsigned int budgetMB, S52_CM_loadCell_cb loadCell_cb);
+int S52_CM_done(void);
+
+// TRUE if a catalogue is managed
+int S52_CM_isInit(void);
+
+// extent of all cells in the catalogue
+int S52_CM_getExt(ObjExt_t *ext);
+
+// queue cell that intersect the view (+ prefetch margin in the pan direction)
+// and queue the least recently viewed cell for unload if over budget
+// (reader lock is enough - the scene graph is not touched)
+int S52_CM_update(ObjExt_t view, double rangeNM);
+
+// TRUE if S52_CM_update() queued cell to unload
+int S52_CM_needUnload(void);
+// unload the queued cell - the caller must hold the writer lock
+int S52_CM_unload(S52_CM_doneCell_cb doneCell_cb);
+
+// cell unloaded by user (S52_doneCell())
+int S52_CM_doneCell(const char *encPath);
+
+// resident bytes of a loaded cell re-sampled after its first draw (prim, VBO)
+// FALSE if the cell is not loaded (yet)
+int S52_CM_setSize(const char *encPath, gsize size);
+
+#endif // _S52CM_H_
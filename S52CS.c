@@ -174,6 +174,24 @@ int       S52_CS_add (_localObj *local, S57_geo *geo)
     return TRUE;
 }
 
+int       S52_CS_del (_localObj *local, S57_geo *geo)
+// remove geo from local list (before deleting it)
+// return TRUE if geo was in a list
+{
+    return_if_null(local);
+    return_if_null(geo);
+
+    int ret = FALSE;
+
+    // Note: a DEPARE can be in depare_list and depval_list
+    if (TRUE == g_ptr_array_remove(local->topmar_list, geo)) ret = TRUE;
+    if (TRUE == g_ptr_array_remove(local->lights_list, geo)) ret = TRUE;
+    if (TRUE == g_ptr_array_remove(local->depare_list, geo)) ret = TRUE;
+    if (TRUE == g_ptr_array_remove(local->depval_list, geo)) ret = TRUE;
+
+    return ret;
+}
+
 static int      _intersectGEO(S57_geo *A, S57_geo *B)
 // TRUE if A instersec B, else FALSE
 {
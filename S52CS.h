@@ -50,6 +50,7 @@ typedef struct _localObj localObj;
 localObj   *S52_CS_init (void);
 localObj   *S52_CS_done (localObj *local);
 int         S52_CS_add  (localObj *local, S57_geo *geo);
+int         S52_CS_del  (localObj *local, S57_geo *geo);
 int         S52_CS_touch(localObj *local, S57_geo *geo);
 
 #endif //_S52CS_H_
@@ -0,0 +1,949 @@
+// S52EC.c: ear clipping triangulation of simple area (fast path of libtess)
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Note: port of the ear clipping of mapbox/earcut (ISC) - hole are bridged to
+// the outer ring (right-most visible vertex), then ear are cut from the single
+// ring. Above EARCUT_HASH vertex, the ear test only look at the vertex in the
+// bbox of the ear along a z-order curve (15 bits per axis) instead of the whole
+// ring. Local self-intersection left by bridging are cured, then the ring is split
+// by a valid diagonal as a last resort.
+// Earcut give bad triangle on bad input, so the rings are first checked: no
+// segment intersect or touch any other non-adjacent segment (segment binned in
+// a grid of about sqrt(n) x sqrt(n) cells - only pairs in the same cell are
+// tested), hole are inside the outer ring and not inside another hole.
+// Anything else (self-intersecting, touching, nested, degenerate) go to libtess.
+
+#include "S52EC.h"
+
+#ifdef S52_USE_EARCUT
+
+#include <math.h>       // sqrt(), ceil(), INFINITY
+#include <stdlib.h>     // qsort()
+#include <string.h>     // memset()
+
+#define EARCUT_HASH  80     // z-order hash above this nbr of vertex
+#define GRID_MIN     16     // brute force segment test below this nbr of segment
+#define GRID_MAX    256     // max cell per axis
+
+typedef struct _pt {
+    double x, y;
+} _pt;
+
+typedef struct _ring {
+    guint  first;           // index in vert
+    guint  n;               // nbr of vertex (not closed)
+    double minx, miny, maxx, maxy;
+} _ring;
+
+typedef struct _node {
+    guint         i;        // vertex index
+    double        x, y;
+    gint32        z;        // z-order
+    gboolean      steiner;
+    struct _node *prev,  *next;
+    struct _node *prevZ, *nextZ;
+} _node;
+
+#define POOL_BLK   1024
+
+struct _S52_EC {
+    GArray    *vert;        // _pt   - rings without duplicate / closing vertex
+    GArray    *ring;        // _ring
+    GArray    *tri;         // double xyz - out
+
+    GPtrArray *blk;         // _node[POOL_BLK]
+    guint      nNode;       // node used in blk
+
+    GArray    *cell;        // guint - first seg of cell (grid)
+    GArray    *segs;        // guint - seg binned by cell
+    GPtrArray *queue;       // _node* - hole
+
+    // z-order
+    double     minX;
+    double     minY;
+    double     invSize;     // 0.0 no hash
+};
+
+S52_EC  *S52_EC_new (void)
+{
+    S52_EC *ec = g_new0(S52_EC, 1);
+
+    ec->vert  = g_array_new(FALSE, FALSE, sizeof(_pt));
+    ec->ring  = g_array_new(FALSE, FALSE, sizeof(_ring));
+    ec->tri   = g_array_new(FALSE, FALSE, sizeof(double)*3);
+    ec->blk   = g_ptr_array_new();
+    ec->cell  = g_array_new(FALSE, FALSE, sizeof(guint));
+    ec->segs  = g_array_new(FALSE, FALSE, sizeof(guint));
+    ec->queue = g_ptr_array_new();
+
+    return ec;
+}
+
+S52_EC  *S52_EC_free(S52_EC *ec)
+{
+    if (NULL == ec)
+        return NULL;
+
+    g_array_free(ec->vert, TRUE);
+    g_array_free(ec->ring, TRUE);
+    g_array_free(ec->tri,  TRUE);
+    for (guint i=0; i<ec->blk->len; ++i)
+        g_free(g_ptr_array_index(ec->blk, i));
+    g_ptr_array_free(ec->blk, TRUE);
+    g_array_free(ec->cell, TRUE);
+    g_array_free(ec->segs, TRUE);
+    g_ptr_array_free(ec->queue, TRUE);
+
+    g_free(ec);
+
+    return NULL;
+}
+
+//-----------------------------------------------
+//
+// simplicity check
+//
+
+static double    _cross(const _pt *p, const _pt *q, const _pt *r)
+// > 0 if p q r turn left
+{
+    return (q->x - p->x) * (r->y - p->y) - (q->y - p->y) * (r->x - p->x);
+}
+
+static int       _sign(double d)
+{
+    return (0.0 < d) ? 1 : ((d < 0.0) ? -1 : 0);
+}
+
+static int       _onSeg(const _pt *p, const _pt *q, const _pt *r)
+// q collinear with p r is on p r
+{
+    return (q->x <= MAX(p->x, r->x)) && (q->x >= MIN(p->x, r->x)) &&
+           (q->y <= MAX(p->y, r->y)) && (q->y >= MIN(p->y, r->y));
+}
+
+static int       _segTouch(const _pt *p1, const _pt *q1, const _pt *p2, const _pt *q2)
+// segment cross or touch
+{
+    int o1 = _sign(_cross(p1, q1, p2));
+    int o2 = _sign(_cross(p1, q1, q2));
+    int o3 = _sign(_cross(p2, q2, p1));
+    int o4 = _sign(_cross(p2, q2, q1));
+
+    if ((o1 != o2) && (o3 != o4)) return TRUE;
+
+    if ((0 == o1) && (TRUE == _onSeg(p1, p2, q1))) return TRUE;
+    if ((0 == o2) && (TRUE == _onSeg(p1, q2, q1))) return TRUE;
+    if ((0 == o3) && (TRUE == _onSeg(p2, p1, q2))) return TRUE;
+    if ((0 == o4) && (TRUE == _onSeg(p2, q1, q2))) return TRUE;
+
+    return FALSE;
+}
+
+static int       _inRing(S52_EC *ec, const _ring *r, double x, double y)
+// even-odd - (x,y) not on the ring
+{
+    const _pt *v  = &g_array_index(ec->vert, _pt, r->first);
+    int        in = FALSE;
+
+    if ((x < r->minx) || (x > r->maxx) || (y < r->miny) || (y > r->maxy))
+        return FALSE;
+
+    for (guint i=0, j=r->n-1; i<r->n; j=i++) {
+        if (((v[i].y > y) != (v[j].y > y)) &&
+            (x < (v[j].x - v[i].x) * (y - v[i].y) / (v[j].y - v[i].y) + v[i].x))
+            in = !in;
+    }
+
+    return in;
+}
+
+static guint     _segNext(S52_EC *ec, guint *segRing, guint s)
+// end vertex of segment s (s is its start vertex)
+{
+    const _ring *r = &g_array_index(ec->ring, _ring, segRing[s]);
+
+    return (s+1 == r->first + r->n) ? r->first : s+1;
+}
+
+static int       _segPair(S52_EC *ec, guint *segRing, guint a, guint b)
+// TRUE if non-adjacent segment a b touch
+{
+    guint a1 = _segNext(ec, segRing, a);
+    guint b1 = _segNext(ec, segRing, b);
+
+    // share a vertex - spike checked in _isSimple()
+    if ((a1 == b) || (b1 == a))
+        return FALSE;
+
+    const _pt *v = (const _pt *)ec->vert->data;
+    return _segTouch(&v[a], &v[a1], &v[b], &v[b1]);
+}
+
+static int       _isSimple(S52_EC *ec)
+{
+    guint  nSeg = ec->vert->len;
+    _pt   *v    = (_pt *)ec->vert->data;
+    guint *segRing = g_new(guint, nSeg);
+    int    ret  = FALSE;
+
+    // ring: 3 vertex, area, spike
+    for (guint r=0; r<ec->ring->len; ++r) {
+        _ring *ring = &g_array_index(ec->ring, _ring, r);
+        double a    = 0.0;
+
+        if (ring->n < 3)
+            goto exit;
+
+        for (guint i=0; i<ring->n; ++i) {
+            _pt *p = &v[ring->first + (i+ring->n-1) % ring->n];
+            _pt *q = &v[ring->first + i];
+            _pt *s = &v[ring->first + (i+1) % ring->n];
+
+            a += (p->x - q->x) * (q->y + p->y);
+
+            // back track on the same line
+            if ((0.0 == _cross(p, q, s)) && ((q->x-p->x)*(s->x-q->x) + (q->y-p->y)*(s->y-q->y) < 0.0))
+                goto exit;
+
+            segRing[ring->first + i] = r;
+        }
+        if (0.0 == a)
+            goto exit;
+    }
+
+    // segment pair
+    if (nSeg < GRID_MIN) {
+        for (guint a=0; a<nSeg; ++a)
+            for (guint b=a+1; b<nSeg; ++b)
+                if (TRUE == _segPair(ec, segRing, a, b))
+                    goto exit;
+    } else {
+        _ring *r0   = &g_array_index(ec->ring, _ring, 0);
+        double minx = r0->minx, miny = r0->miny, maxx = r0->maxx, maxy = r0->maxy;
+        for (guint r=1; r<ec->ring->len; ++r) {
+            _ring *ring = &g_array_index(ec->ring, _ring, r);
+            minx = MIN(minx, ring->minx); miny = MIN(miny, ring->miny);
+            maxx = MAX(maxx, ring->maxx); maxy = MAX(maxy, ring->maxy);
+        }
+
+        guint  g  = MIN(GRID_MAX, (guint)ceil(sqrt((double)nSeg)));
+        double sx = g / (maxx - minx);
+        double sy = g / (maxy - miny);
+
+        // bin by bbox of segment - count then fill
+        g_array_set_size(ec->cell, g*g+1);
+        guint *cell = (guint *)ec->cell->data;
+        memset(cell, 0, sizeof(guint)*(g*g+1));
+
+#define _CELL(i, x0, y0, x1, y1)                                         \
+        guint i##1 = _segNext(ec, segRing, i);                           \
+        guint x0 = MIN(g-1, (guint)((MIN(v[i].x, v[i##1].x)-minx) * sx)); \
+        guint x1 = MIN(g-1, (guint)((MAX(v[i].x, v[i##1].x)-minx) * sx)); \
+        guint y0 = MIN(g-1, (guint)((MIN(v[i].y, v[i##1].y)-miny) * sy)); \
+        guint y1 = MIN(g-1, (guint)((MAX(v[i].y, v[i##1].y)-miny) * sy))
+
+        for (guint s=0; s<nSeg; ++s) {
+            _CELL(s, x0, y0, x1, y1);
+            for (guint y=y0; y<=y1; ++y)
+                for (guint x=x0; x<=x1; ++x)
+                    ++cell[y*g + x + 1];
+        }
+        for (guint c=1; c<=g*g; ++c)
+            cell[c] += cell[c-1];
+
+        g_array_set_size(ec->segs, cell[g*g]);
+        guint *segs = (guint *)ec->segs->data;
+        for (guint s=0; s<nSeg; ++s) {
+            _CELL(s, x0, y0, x1, y1);
+            for (guint y=y0; y<=y1; ++y)
+                for (guint x=x0; x<=x1; ++x)
+                    segs[cell[y*g + x]++] = s;
+        }
+#undef _CELL
+
+        // cell[c] is now the end of cell c
+        for (guint c=0; c<g*g; ++c) {
+            guint beg = (0 == c) ? 0 : cell[c-1];
+            for (guint a=beg; a<cell[c]; ++a)
+                for (guint b=a+1; b<cell[c]; ++b)
+                    if (TRUE == _segPair(ec, segRing, segs[a], segs[b]))
+                        goto exit;
+        }
+    }
+
+    // hole inside outer, not inside an other hole
+    for (guint h=1; h<ec->ring->len; ++h) {
+        _ring *ring = &g_array_index(ec->ring, _ring, h);
+        _pt   *p    = &v[ring->first];
+
+        if (FALSE == _inRing(ec, &g_array_index(ec->ring, _ring, 0), p->x, p->y))
+            goto exit;
+
+        for (guint o=1; o<ec->ring->len; ++o) {
+            if ((o != h) && (TRUE == _inRing(ec, &g_array_index(ec->ring, _ring, o), p->x, p->y)))
+                goto exit;
+        }
+    }
+
+    ret = TRUE;
+
+exit:
+    g_free(segRing);
+
+    return ret;
+}
+
+//-----------------------------------------------
+//
+// earcut
+//
+
+static _node    *_newNode(S52_EC *ec, guint i, double x, double y)
+{
+    guint b = ec->nNode / POOL_BLK;
+    if (b == ec->blk->len)
+        g_ptr_array_add(ec->blk, g_new(_node, POOL_BLK));
+
+    _node *p = (_node *)g_ptr_array_index(ec->blk, b) + (ec->nNode % POOL_BLK);
+    ++ec->nNode;
+
+    p->i       = i;
+    p->x       = x;
+    p->y       = y;
+    p->z       = 0;
+    p->steiner = FALSE;
+    p->prev    = p->next  = NULL;
+    p->prevZ   = p->nextZ = NULL;
+
+    return p;
+}
+
+static double    _area(const _node *p, const _node *q, const _node *r)
+// > 0 if p q r turn right (earcut sign)
+{
+    return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+}
+
+static int       _equals(const _node *p1, const _node *p2)
+{
+    return (p1->x == p2->x) && (p1->y == p2->y);
+}
+
+static _node    *_insertNode(S52_EC *ec, guint i, double x, double y, _node *last)
+{
+    _node *p = _newNode(ec, i, x, y);
+
+    if (NULL == last) {
+        p->prev = p;
+        p->next = p;
+    } else {
+        p->next       = last->next;
+        p->prev       = last;
+        last->next->prev = p;
+        last->next    = p;
+    }
+
+    return p;
+}
+
+static void      _removeNode(_node *p)
+{
+    p->next->prev = p->prev;
+    p->prev->next = p->next;
+
+    if (NULL != p->prevZ) p->prevZ->nextZ = p->nextZ;
+    if (NULL != p->nextZ) p->nextZ->prevZ = p->prevZ;
+}
+
+static _node    *_linkedList(S52_EC *ec, guint r, int clockwise)
+// circular list of ring r in the given winding
+{
+    _ring *ring = &g_array_index(ec->ring, _ring, r);
+    _pt   *v    = &g_array_index(ec->vert, _pt, ring->first);
+    _node *last = NULL;
+    double sum  = 0.0;
+
+    for (guint i=0, j=ring->n-1; i<ring->n; j=i++)
+        sum += (v[j].x - v[i].x) * (v[i].y + v[j].y);
+
+    if (clockwise == (0.0 < sum)) {
+        for (guint i=0; i<ring->n; ++i)
+            last = _insertNode(ec, ring->first+i, v[i].x, v[i].y, last);
+    } else {
+        for (guint i=ring->n; i>0; --i)
+            last = _insertNode(ec, ring->first+i-1, v[i-1].x, v[i-1].y, last);
+    }
+
+    if ((NULL != last) && (TRUE == _equals(last, last->next))) {
+        _removeNode(last);
+        last = last->next;
+    }
+
+    return last;
+}
+
+static _node    *_filterPoints(_node *start, _node *end)
+// remove duplicate and collinear point
+{
+    if (NULL == start) return start;
+    if (NULL == end)   end = start;
+
+    _node *p     = start;
+    int    again = FALSE;
+    do {
+        again = FALSE;
+
+        if ((FALSE == p->steiner) && ((TRUE == _equals(p, p->next)) || (0.0 == _area(p->prev, p, p->next)))) {
+            _removeNode(p);
+            p = end = p->prev;
+            if (p == p->next)
+                break;
+            again = TRUE;
+        } else {
+            p = p->next;
+        }
+    } while ((TRUE == again) || (p != end));
+
+    return end;
+}
+
+static void      _addTri(S52_EC *ec, const _node *a, const _node *b, const _node *c)
+// out CCW
+{
+    if ((b->x - a->x) * (c->y - a->y) - (b->y - a->y) * (c->x - a->x) < 0.0) {
+        const _node *t = b;
+        b = c;
+        c = t;
+    }
+
+    double t[9] = {a->x, a->y, 0.0, b->x, b->y, 0.0, c->x, c->y, 0.0};
+    g_array_append_vals(ec->tri, t, 3);
+}
+
+static gint32    _zOrder(S52_EC *ec, double fx, double fy)
+{
+    gint32 x = (gint32)((fx - ec->minX) * ec->invSize);
+    gint32 y = (gint32)((fy - ec->minY) * ec->invSize);
+
+    x = (x | (x << 8)) & 0x00FF00FF;
+    x = (x | (x << 4)) & 0x0F0F0F0F;
+    x = (x | (x << 2)) & 0x33333333;
+    x = (x | (x << 1)) & 0x55555555;
+
+    y = (y | (y << 8)) & 0x00FF00FF;
+    y = (y | (y << 4)) & 0x0F0F0F0F;
+    y = (y | (y << 2)) & 0x33333333;
+    y = (y | (y << 1)) & 0x55555555;
+
+    return x | (y << 1);
+}
+
+static _node    *_sortLinked(_node *list)
+// merge sort on z (Simon Tatham)
+{
+    int inSize = 1;
+    int numMerges;
+
+    do {
+        _node *p    = list;
+        _node *tail = NULL;
+        list      = NULL;
+        numMerges = 0;
+
+        while (NULL != p) {
+            _node *q     = p;
+            int    pSize = 0;
+            ++numMerges;
+
+            for (int i=0; i<inSize; ++i) {
+                ++pSize;
+                q = q->nextZ;
+                if (NULL == q) break;
+            }
+
+            int qSize = inSize;
+            while ((0 < pSize) || ((0 < qSize) && (NULL != q))) {
+                _node *e = NULL;
+                if ((0 != pSize) && ((0 == qSize) || (NULL == q) || (p->z <= q->z))) {
+                    e = p;
+                    p = p->nextZ;
+                    --pSize;
+                } else {
+                    e = q;
+                    q = q->nextZ;
+                    --qSize;
+                }
+
+                if (NULL != tail) tail->nextZ = e;
+                else              list        = e;
+
+                e->prevZ = tail;
+                tail     = e;
+            }
+
+            p = q;
+        }
+
+        tail->nextZ = NULL;
+        inSize *= 2;
+
+    } while (1 < numMerges);
+
+    return list;
+}
+
+static void      _indexCurve(S52_EC *ec, _node *start)
+{
+    _node *p = start;
+    do {
+        if (0 == p->z)
+            p->z = _zOrder(ec, p->x, p->y);
+        p->prevZ = p->prev;
+        p->nextZ = p->next;
+        p = p->next;
+    } while (p != start);
+
+    p->prevZ->nextZ = NULL;
+    p->prevZ        = NULL;
+
+    _sortLinked(p);
+}
+
+static int       _pointInTriangle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py)
+{
+    return ((cx - px) * (ay - py) >= (ax - px) * (cy - py)) &&
+           ((ax - px) * (by - py) >= (bx - px) * (ay - py)) &&
+           ((bx - px) * (cy - py) >= (cx - px) * (by - py));
+}
+
+static int       _isEar(_node *ear)
+{
+    _node *a = ear->prev;
+    _node *b = ear;
+    _node *c = ear->next;
+
+    // reflex
+    if (0.0 <= _area(a, b, c))
+        return FALSE;
+
+    double x0 = MIN(a->x, MIN(b->x, c->x));
+    double y0 = MIN(a->y, MIN(b->y, c->y));
+    double x1 = MAX(a->x, MAX(b->x, c->x));
+    double y1 = MAX(a->y, MAX(b->y, c->y));
+
+    for (_node *p=c->next; p!=a; p=p->next) {
+        if ((p->x >= x0) && (p->x <= x1) && (p->y >= y0) && (p->y <= y1) &&
+            (TRUE == _pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y)) &&
+            (0.0 <= _area(p->prev, p, p->next)))
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+static int       _isEarHashed(S52_EC *ec, _node *ear)
+{
+    _node *a = ear->prev;
+    _node *b = ear;
+    _node *c = ear->next;
+
+    if (0.0 <= _area(a, b, c))
+        return FALSE;
+
+    double x0 = MIN(a->x, MIN(b->x, c->x));
+    double y0 = MIN(a->y, MIN(b->y, c->y));
+    double x1 = MAX(a->x, MAX(b->x, c->x));
+    double y1 = MAX(a->y, MAX(b->y, c->y));
+
+    gint32 minZ = _zOrder(ec, x0, y0);
+    gint32 maxZ = _zOrder(ec, x1, y1);
+
+#define _IN_EAR(n) ((n->x >= x0) && (n->x <= x1) && (n->y >= y0) && (n->y <= y1) && (n != a) && (n != c) && \
+                    (TRUE == _pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, n->x, n->y)) &&           \
+                    (0.0 <= _area(n->prev, n, n->next)))
+
+    _node *p = ear->prevZ;
+    _node *n = ear->nextZ;
+
+    // look both way along the curve
+    while ((NULL != p) && (p->z >= minZ) && (NULL != n) && (n->z <= maxZ)) {
+        if (_IN_EAR(p)) return FALSE;
+        p = p->prevZ;
+
+        if (_IN_EAR(n)) return FALSE;
+        n = n->nextZ;
+    }
+
+    while ((NULL != p) && (p->z >= minZ)) {
+        if (_IN_EAR(p)) return FALSE;
+        p = p->prevZ;
+    }
+
+    while ((NULL != n) && (n->z <= maxZ)) {
+        if (_IN_EAR(n)) return FALSE;
+        n = n->nextZ;
+    }
+#undef _IN_EAR
+
+    return TRUE;
+}
+
+static int       _intersects(const _node *p1, const _node *q1, const _node *p2, const _node *q2)
+{
+    return _segTouch((const _pt *)&p1->x, (const _pt *)&q1->x, (const _pt *)&p2->x, (const _pt *)&q2->x);
+}
+
+static int       _intersectsPolygon(_node *a, _node *b)
+// diagonal a b intersect a polygon edge
+{
+    _node *p = a;
+    do {
+        if ((p->i != a->i) && (p->next->i != a->i) && (p->i != b->i) && (p->next->i != b->i) &&
+            (TRUE == _intersects(p, p->next, a, b)))
+            return TRUE;
+        p = p->next;
+    } while (p != a);
+
+    return FALSE;
+}
+
+static int       _locallyInside(const _node *a, const _node *b)
+{
+    return (_area(a->prev, a, a->next) < 0.0) ?
+        ((0.0 <= _area(a, b, a->next)) && (0.0 <= _area(a, a->prev, b))) :
+        ((_area(a, b, a->prev) < 0.0)  || (_area(a, a->next, b) < 0.0));
+}
+
+static int       _middleInside(_node *a, _node *b)
+{
+    _node *p  = a;
+    int    in = FALSE;
+    double px = (a->x + b->x) / 2.0;
+    double py = (a->y + b->y) / 2.0;
+
+    do {
+        if (((p->y > py) != (p->next->y > py)) && (p->next->y != p->y) &&
+            (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x))
+            in = !in;
+        p = p->next;
+    } while (p != a);
+
+    return in;
+}
+
+static int       _isValidDiagonal(_node *a, _node *b)
+{
+    return (a->next->i != b->i) && (a->prev->i != b->i) && (FALSE == _intersectsPolygon(a, b)) &&
+           (((TRUE == _locallyInside(a, b)) && (TRUE == _locallyInside(b, a)) && (TRUE == _middleInside(a, b)) &&
+             ((0.0 != _area(a->prev, a, b->prev)) || (0.0 != _area(a, b->prev, b)))) ||
+            ((TRUE == _equals(a, b)) && (0.0 < _area(a->prev, a, a->next)) && (0.0 < _area(b->prev, b, b->next))));
+}
+
+static _node    *_splitPolygon(S52_EC *ec, _node *a, _node *b)
+// link a to b with a bridge - return the other polygon
+{
+    _node *a2 = _newNode(ec, a->i, a->x, a->y);
+    _node *b2 = _newNode(ec, b->i, b->x, b->y);
+    _node *an = a->next;
+    _node *bp = b->prev;
+
+    a->next  = b;
+    b->prev  = a;
+
+    a2->next = an;
+    an->prev = a2;
+
+    b2->next = a2;
+    a2->prev = b2;
+
+    bp->next = b2;
+    b2->prev = bp;
+
+    return b2;
+}
+
+static void      _earcutLinked(S52_EC *ec, _node *ear, int pass);
+
+static _node    *_cureLocalIntersections(S52_EC *ec, _node *start)
+{
+    _node *p = start;
+    do {
+        _node *a = p->prev;
+        _node *b = p->next->next;
+
+        if ((FALSE == _equals(a, b)) && (TRUE == _intersects(a, p, p->next, b)) &&
+            (TRUE == _locallyInside(a, b)) && (TRUE == _locallyInside(b, a))) {
+
+            _addTri(ec, a, p, b);
+
+            _removeNode(p);
+            _removeNode(p->next);
+
+            p = start = b;
+        }
+        p = p->next;
+    } while (p != start);
+
+    return _filterPoints(p, NULL);
+}
+
+static void      _splitEarcut(S52_EC *ec, _node *start)
+{
+    _node *a = start;
+    do {
+        _node *b = a->next->next;
+        while (b != a->prev) {
+            if ((a->i != b->i) && (TRUE == _isValidDiagonal(a, b))) {
+                _node *c = _splitPolygon(ec, a, b);
+
+                a = _filterPoints(a, a->next);
+                c = _filterPoints(c, c->next);
+
+                _earcutLinked(ec, a, 0);
+                _earcutLinked(ec, c, 0);
+                return;
+            }
+            b = b->next;
+        }
+        a = a->next;
+    } while (a != start);
+}
+
+static void      _earcutLinked(S52_EC *ec, _node *ear, int pass)
+{
+    if (NULL == ear)
+        return;
+
+    if ((0 == pass) && (0.0 != ec->invSize))
+        _indexCurve(ec, ear);
+
+    _node *stop = ear;
+
+    while (ear->prev != ear->next) {
+        _node *prev = ear->prev;
+        _node *next = ear->next;
+
+        if ((0.0 != ec->invSize) ? _isEarHashed(ec, ear) : _isEar(ear)) {
+            _addTri(ec, prev, ear, next);
+
+            _removeNode(ear);
+
+            // skip next vertex (thinner triangle)
+            ear  = next->next;
+            stop = next->next;
+
+            continue;
+        }
+
+        ear = next;
+
+        // loop without an ear
+        if (ear == stop) {
+            if (0 == pass) {
+                _earcutLinked(ec, _filterPoints(ear, NULL), 1);
+            } else if (1 == pass) {
+                ear = _cureLocalIntersections(ec, _filterPoints(ear, NULL));
+                _earcutLinked(ec, ear, 2);
+            } else if (2 == pass) {
+                _splitEarcut(ec, ear);
+            }
+            break;
+        }
+    }
+}
+
+static int       _sectorContainsSector(const _node *m, const _node *p)
+{
+    return (_area(m->prev, m, p->prev) < 0.0) && (_area(p->next, m, m->next) < 0.0);
+}
+
+static _node    *_findHoleBridge(_node *hole, _node *outerNode)
+// vertex of outer visible from the left-most vertex of hole
+{
+    _node *p  = outerNode;
+    _node *m  = NULL;
+    double hx = hole->x;
+    double hy = hole->y;
+    double qx = -INFINITY;
+
+    // segment left of hole hit by a ray to the left
+    do {
+        if ((hy <= p->y) && (hy >= p->next->y) && (p->next->y != p->y)) {
+            double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+            if ((x <= hx) && (x > qx)) {
+                qx = x;
+                m  = (p->x < p->next->x) ? p : p->next;
+                if (x == hx)
+                    return m;
+            }
+        }
+        p = p->next;
+    } while (p != outerNode);
+
+    if (NULL == m)
+        return NULL;
+
+    // vertex in the triangle hole, hit, m - take the one with min angle to the ray
+    _node *stop   = m;
+    double mx     = m->x;
+    double my     = m->y;
+    double tanMin = INFINITY;
+
+    p = m;
+    do {
+        if ((hx >= p->x) && (p->x >= mx) && (hx != p->x) &&
+            (TRUE == _pointInTriangle((hy < my) ? hx : qx, hy, mx, my, (hy < my) ? qx : hx, hy, p->x, p->y))) {
+
+            double tan = fabs(hy - p->y) / (hx - p->x);
+
+            if ((TRUE == _locallyInside(p, hole)) &&
+                ((tan < tanMin) || ((tan == tanMin) && ((p->x > m->x) || ((p->x == m->x) && (TRUE == _sectorContainsSector(m, p))))))) {
+                m      = p;
+                tanMin = tan;
+            }
+        }
+        p = p->next;
+    } while (p != stop);
+
+    return m;
+}
+
+static _node    *_getLeftmost(_node *start)
+{
+    _node *p        = start;
+    _node *leftmost = start;
+    do {
+        if ((p->x < leftmost->x) || ((p->x == leftmost->x) && (p->y < leftmost->y)))
+            leftmost = p;
+        p = p->next;
+    } while (p != start);
+
+    return leftmost;
+}
+
+static int       _cmpX(const void *a, const void *b)
+{
+    const _node *na = *(const _node **)a;
+    const _node *nb = *(const _node **)b;
+
+    return (na->x < nb->x) ? -1 : ((na->x > nb->x) ? 1 : 0);
+}
+
+static _node    *_eliminateHoles(S52_EC *ec, _node *outerNode)
+// bridge each hole to outer, left to right
+{
+    g_ptr_array_set_size(ec->queue, 0);
+
+    for (guint r=1; r<ec->ring->len; ++r) {
+        _node *list = _linkedList(ec, r, FALSE);
+        if (list == list->next)
+            list->steiner = TRUE;
+        g_ptr_array_add(ec->queue, _getLeftmost(list));
+    }
+
+    qsort(ec->queue->pdata, ec->queue->len, sizeof(gpointer), _cmpX);
+
+    for (guint i=0; i<ec->queue->len; ++i) {
+        _node *hole   = (_node *)g_ptr_array_index(ec->queue, i);
+        _node *bridge = _findHoleBridge(hole, outerNode);
+        if (NULL == bridge)
+            continue;
+
+        _node *bridgeReverse = _splitPolygon(ec, bridge, hole);
+        _filterPoints(bridgeReverse, bridgeReverse->next);
+
+        outerNode = _filterPoints(bridge, bridge->next);
+    }
+
+    return outerNode;
+}
+
+guint    S52_EC_triangulate(S52_EC *ec, guint nRing, guint *nPt, double **ppt, double **tri)
+{
+    if ((NULL==ec) || (0==nRing) || (NULL==nPt) || (NULL==ppt) || (NULL==tri))
+        return 0;
+
+    g_array_set_size(ec->vert, 0);
+    g_array_set_size(ec->ring, 0);
+    g_array_set_size(ec->tri,  0);
+    ec->nNode = 0;
+
+    // copy ring - drop duplicate and closing vertex
+    for (guint r=0; r<nRing; ++r) {
+        _ring   ring = {ec->vert->len, 0, INFINITY, INFINITY, -INFINITY, -INFINITY};
+        double *p    = ppt[r];
+
+        for (guint i=0; i<nPt[r]; ++i, p+=3) {
+            _pt pt = {p[0], p[1]};
+
+            if (0 < ring.n) {
+                _pt *last  = &g_array_index(ec->vert, _pt, ec->vert->len-1);
+                _pt *first = &g_array_index(ec->vert, _pt, ring.first);
+                if ((pt.x == last->x) && (pt.y == last->y))
+                    continue;
+                if ((i == nPt[r]-1) && (pt.x == first->x) && (pt.y == first->y))
+                    continue;
+            }
+
+            g_array_append_val(ec->vert, pt);
+            ++ring.n;
+
+            ring.minx = MIN(ring.minx, pt.x);
+            ring.miny = MIN(ring.miny, pt.y);
+            ring.maxx = MAX(ring.maxx, pt.x);
+            ring.maxy = MAX(ring.maxy, pt.y);
+        }
+
+        g_array_append_val(ec->ring, ring);
+    }
+
+    if (FALSE == _isSimple(ec))
+        return 0;
+
+    _node *outerNode = _linkedList(ec, 0, TRUE);
+    if ((NULL == outerNode) || (outerNode->next == outerNode->prev))
+        return 0;
+
+    if (1 < nRing)
+        outerNode = _eliminateHoles(ec, outerNode);
+
+    // z-order hash - bbox of outer ring
+    ec->invSize = 0.0;
+    if (EARCUT_HASH < ec->vert->len) {
+        _ring *r0 = &g_array_index(ec->ring, _ring, 0);
+
+        ec->minX    = r0->minx;
+        ec->minY    = r0->miny;
+        ec->invSize = MAX(r0->maxx - r0->minx, r0->maxy - r0->miny);
+        ec->invSize = (0.0 != ec->invSize) ? 32767.0 / ec->invSize : 0.0;
+    }
+
+    _earcutLinked(ec, outerNode, 0);
+
+    *tri = (double *)ec->tri->data;
+
+    return ec->tri->len / 3;
+}
+
+#endif  // S52_USE_EARCUT
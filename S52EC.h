@@ -0,0 +1,43 @@
+// S52EC.h: ear clipping triangulation of simple area (fast path of libtess)
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _S52EC_H_
+#define _S52EC_H_
+
+#include <glib.h>       // guint
+
+// triangulator state (node pool, segment grid, output) - one per thread
+typedef struct _S52_EC S52_EC;
+
+S52_EC  *S52_EC_new (void);
+S52_EC  *S52_EC_free(S52_EC *ec);
+
+// triangulate area: ring 0 outer, other ring are hole - xyz (3 double), last vertex
+// may repeat the first (S57 ring)
+// return the number of triangle, xyz CCW in 'tri' (valid until next call),
+// 0 if the rings are not simple (self-intersecting, touching ring, hole outside
+// outer or inside another hole, degenerate) - then use libtess (ODD winding)
+guint    S52_EC_triangulate(S52_EC *ec, guint nRing, guint *nPt, double **ppt, double **tri);
+
+#endif // _S52EC_H_
@@ -36,6 +36,10 @@
 // compiled with -std=gnu99 (or -std=c99 -D_POSIX_C_SOURCE=???) will define M_PI
 #include <math.h>         // sin(), cos(), atan2(), pow(), sqrt(), floor(), fabs(), INFINITY, M_PI
 
+#ifdef __SSE2__
+#include <emmintrin.h>    // _mm_*_pd() - batch window <--> projected (S52_GL_win2prjFramev())
+#endif
+
 // FIXME: for C99
 #ifndef M_PI
 #    define M_PI 3.14159265358979323846
@@ -49,13 +53,15 @@ static int          _ctxValidated  = FALSE;   // validate GL context
 static GPtrArray   *_objPick       = NULL;    // list of object picked
 static GString     *_strPick       = NULL;    // hold temps val
 //static int          _doHighlight   = FALSE;   // TRUE then _objhighlight point to the object to hightlight
-static S52_GL_cycle _crnt_GL_cycle = S52_GL_INIT; // state before first S52_GL_DRAW
 
 // FIXME: rename to something like _doInitViewFirstTime
 static int          _symbCreated   = FALSE;   // TRUE if PLib symb created (DList/VBO)
 
-// now used by _renderLC() only
-static GArray      *_tmpWorkBuffer = NULL;    // tmp buffer
+#ifdef S52_USE_SYM_ATLAS
+// all PLib symbol / pattern sub-list in one VBO (see _buildSymbAtlas())
+static guint        _symbAtlasVBO  = 0;
+static GArray      *_symbAtlasTmp  = NULL;    // vertex of the atlas while building
+#endif
 
 
 ////////////////////////////////////////////////////////////////////
@@ -69,20 +75,8 @@ static GArray      *_tmpWorkBuffer = NULL;    // tmp buffer
 typedef struct _view_t{
     double cLat, cLon, rNM, north;     // center of screen (lat,long), range of view(NM)
 } _view_t;
-static _view_t _view = {0.0, 0.0, 0.0, 0.0};
 //*/
 
-static double       _SCAMIN    = 1.0;  // screen scale (SCAle MINimum in S57)
-static double       _scalex    = 1.0;  // meter per pixel in X
-static double       _scaley    = 1.0;  // meter per pixel in Y
-
-// projected view
-static projUV _pmin = { INFINITY,  INFINITY};
-static projUV _pmax = {-INFINITY, -INFINITY};
-// _pmin, _pmax convert to GEO for culling object with their extent (in deg)
-static projUV _gmin = { INFINITY,  INFINITY};
-static projUV _gmax = {-INFINITY, -INFINITY};
-
 // current ViewPort
 typedef struct vp_t {
     guint x;
@@ -90,7 +84,6 @@ typedef struct vp_t {
     guint w;
     guint h;
 } vp_t;
-static vp_t _vp;
 
 // GL_PROJECTION matrix
 typedef enum _VP {
@@ -105,11 +98,6 @@ typedef enum _VP {
 
 ////////////////////////////////////////////////////////////////////
 
-// Note: S52 pixels for symb are 0.3 mm
-// this is the real (physical) dotpitch of the device as computed at init() time
-// virtual dotpitch is set by user with S52_MP_set(S52_MAR_DOTPITCH_MM_X/Y, ..);
-static double _dotpitch_mm_x = 0.3;  // will be overwright at init()
-static double _dotpitch_mm_y = 0.3;  // will be overwright at init()
 #define MM2INCH  25.4
 #define PICA      0.351  // mm
 
@@ -144,6 +132,255 @@ static double _dotpitch_mm_y = 0.3;  // will be overwright at init()
 #if defined(S52_USE_GLSC2) && !defined(S52_USE_EGL)
 #error "GLSC2 need EGL"
 #endif
+#if defined(S52_USE_GPU_TIMER) && !defined(S52_USE_GL2)
+#error "GPU timer need GL2 or GLES2"
+#endif
+#if defined(S52_USE_SW) && !defined(S52_USE_GL2)
+#error "SW rasteriser need GL2 or GLES2"
+#endif
+#if defined(S52_USE_STENCIL_FILL) && !defined(S52_USE_GL2)
+#error "stencil-then-cover fill need GL2 or GLES2"
+#endif
+#if defined(S52_USE_SYM_ATLAS) && !(defined(S52_USE_GL2) && defined(S52_USE_OPENGL_VBO))
+#error "symbol atlas need GL2 or GLES2 and VBO"
+#endif
+
+
+///////////////////////////////////////////////////////////////////
+//
+// state of a context (see S52_newCtx())
+//
+
+#define MATRIX_STACK_MAX 8
+
+// view of the last frame drawn - read lock free by S52_GL_win2prjFrame() / S52_GL_prj2winFrame()
+typedef struct _frameView_t {
+    double l, r, b, t;      // VP_PRJ ortho
+    double north;
+    double x, y, w, h;      // viewport
+} _frameView_t;
+
+// read state of a context - query read it without switching context
+// Note: seqlock - odd seq while fv is written (S52_GL_begin(DRAW))
+typedef struct _frame_t {
+    gint         seq;       // 0 - no frame yet
+    _frameView_t fv;
+    _view_t      view;      // view set by S52_GL_setView() - written by the writer only
+} _frame_t;
+
+// everything a frame write - the rest (VBO, texture, symbol, prim) is shared by the GL share group
+// and built once, at draw time, under _build_mutex
+typedef struct _GL_ctx {
+    S52_GL_cycle   crnt_GL_cycle;   // S52_GL_INIT - state before first S52_GL_DRAW
+
+    _view_t        view;
+    double         SCAMIN;          // screen scale (SCAle MINimum in S57)
+    double         scalex;          // meter per pixel in X
+    double         scaley;          // meter per pixel in Y
+    projUV         pmin;            // projected view
+    projUV         pmax;
+    projUV         gmin;            // pmin, pmax convert to GEO for culling object with their extent (in deg)
+    projUV         gmax;
+    vp_t           vp;              // current ViewPort
+
+    // Note: S52 pixels for symb are 0.3 mm
+    // this is the real (physical) dotpitch of the device as computed at init() time
+    // virtual dotpitch is set by user with S52_MP_set(S52_MAR_DOTPITCH_MM_X/Y, ..);
+    double         dotpitch_mm_x;
+    double         dotpitch_mm_y;
+
+    // statistique
+    guint          nobj;            // number of object drawn during lap
+    guint          ncmd;            // number of command drawn during lap
+    guint          oclip;           // number of object clipped
+    guint          nFrag;           // number of pixel fragment (color switch)
+    guint          nbind;           // number of symbol VBO bind (_glCallList())
+    int            drgare;          // DRGARE
+    int            depare;          // DEPARE
+    int            nAC;             // total AC (Area Color)
+    // tesselated area stat
+    guint          ntris;           // area GL_TRIANGLES      count
+    guint          ntristrip;       // area GL_TRIANGLE_STRIP count
+    guint          ntrisfan;        // area GL_TRIANGLE_FAN   count
+    guint          nCall;
+    guint          npoly;           // total polys
+    // snapshot of the stat above at S52_GL_end() - [0]:DRAW, [1]:LAST
+    S52_GL_stat    stat[2];
+
+    // hold copy of FrameBuffer
+    guint          fb_pixels_id;    // texture ID
+    unsigned char *fb_pixels;
+    guint          fb_pixels_size;
+    int            fb_pixels_udp;   // TRUE flag that the FB changed
+
+    _frame_t       frame;
+
+    GArray        *tmpWorkBuffer;   // now used by _renderLC() only
+    GArray        *centroids;       // centroids of poly's (_getCentroids())
+
+#ifdef S52_USE_GL2
+    // Note: an FBO, and the uniform of a program, can't be shared by GL context drawing at once
+    guint          fboID;           // other pattern are created using FBO
+    float          mvm[MATRIX_STACK_MAX][16];  // modelview matrix
+    float          pjm[MATRIX_STACK_MAX][16];  // projection matrix
+    float         *crntMat;         // point to active matrix
+    int            mvmTop;          // point to stack top
+    int            pjmTop;          // point to stack top
+
+    guint          programObject;   // glsl main - 0 until the first S52_GL_begin() of the context
+    // glsl uniform
+    int            uProjection;
+    int            uModelview;
+    int            uColor;
+    int            uPointSize;
+    int            uSampler2d0;
+    int            uSampler2d1;
+    int            uBlitOn;
+    int            uTextOn;         // textured line and text from freetype-gl
+    int            uGlowOn;
+    int            uPattOn;
+    int            uPattGridX;
+    int            uPattGridY;
+    int            uPattW;
+    int            uPattH;
+    // glsl varying
+    int            aPosition;
+    int            aUV;
+    int            aAlpha;
+
+    GArray        *tessWorkBuf_f;   // used to convert geo double to VBO float
+    GArray        *freetype_gl_buffer;
+#ifdef S52_USE_SYM_ATLAS
+    int            atlasOn;         // GL_ARRAY_BUFFER / aPosition on the symbol atlas (see _glAtlasOff())
+#endif
+#endif
+
+#ifdef S52_USE_AFGLOW
+    // experimental: synthetic after glow
+    GArray        *aftglwColorArr;
+    guint          vboIDaftglwVertID;
+    guint          vboIDaftglwColrID;
+#endif
+
+#ifdef S52_USE_GPU_TIMER
+    struct _tqState *tq;            // query are not shared between GL context
+#endif
+} _GL_ctx;
+
+static _GL_ctx _glcDef = {
+    .crnt_GL_cycle = S52_GL_INIT,
+    .view          = {0.0, 0.0, 0.0, 0.0},
+    .SCAMIN        = 1.0,
+    .scalex        = 1.0,
+    .scaley        = 1.0,
+    .pmin          = { INFINITY,  INFINITY},
+    .pmax          = {-INFINITY, -INFINITY},
+    .gmin          = { INFINITY,  INFINITY},
+    .gmax          = {-INFINITY, -INFINITY},
+    .dotpitch_mm_x = 0.3,   // will be overwright at init()
+    .dotpitch_mm_y = 0.3,   // will be overwright at init()
+    .fb_pixels_udp = TRUE,
+};
+
+#ifdef S52_USE_CTX
+// context of the drawing thread (S52_GL_loadCtx()) - each context draw in its own GL context
+static S52_TLS _GL_ctx *_glc = &_glcDef;
+#else
+#define _glc (&_glcDef)
+#endif
+
+#define _crnt_GL_cycle      (_glc->crnt_GL_cycle)
+#define _view               (_glc->view)
+#define _SCAMIN             (_glc->SCAMIN)
+#define _scalex             (_glc->scalex)
+#define _scaley             (_glc->scaley)
+#define _pmin               (_glc->pmin)
+#define _pmax               (_glc->pmax)
+#define _gmin               (_glc->gmin)
+#define _gmax               (_glc->gmax)
+#define _vp                 (_glc->vp)
+#define _dotpitch_mm_x      (_glc->dotpitch_mm_x)
+#define _dotpitch_mm_y      (_glc->dotpitch_mm_y)
+#define _nobj               (_glc->nobj)
+#define _ncmd               (_glc->ncmd)
+#define _oclip              (_glc->oclip)
+#define _nFrag              (_glc->nFrag)
+#define _nbind              (_glc->nbind)
+#define _drgare             (_glc->drgare)
+#define _depare             (_glc->depare)
+#define _nAC                (_glc->nAC)
+#define _ntris              (_glc->ntris)
+#define _ntristrip          (_glc->ntristrip)
+#define _ntrisfan           (_glc->ntrisfan)
+#define _nCall              (_glc->nCall)
+#define _npoly              (_glc->npoly)
+#define _stat               (_glc->stat)
+#define _fb_pixels_id       (_glc->fb_pixels_id)
+#define _fb_pixels          (_glc->fb_pixels)
+#define _fb_pixels_size     (_glc->fb_pixels_size)
+#define _fb_pixels_udp      (_glc->fb_pixels_udp)
+#define _frame              (&_glc->frame)
+#define _tmpWorkBuffer      (_glc->tmpWorkBuffer)
+#define _centroids          (_glc->centroids)
+#ifdef S52_USE_GL2
+#define _fboID              (_glc->fboID)
+#define _mvm                (_glc->mvm)
+#define _pjm                (_glc->pjm)
+#define _crntMat            (_glc->crntMat)
+#define _mvmTop             (_glc->mvmTop)
+#define _pjmTop             (_glc->pjmTop)
+#define _programObject      (_glc->programObject)
+#define _uProjection        (_glc->uProjection)
+#define _uModelview         (_glc->uModelview)
+#define _uColor             (_glc->uColor)
+#define _uPointSize         (_glc->uPointSize)
+#define _uSampler2d0        (_glc->uSampler2d0)
+#define _uSampler2d1        (_glc->uSampler2d1)
+#define _uBlitOn            (_glc->uBlitOn)
+#define _uTextOn            (_glc->uTextOn)
+#define _uGlowOn            (_glc->uGlowOn)
+#define _uPattOn            (_glc->uPattOn)
+#define _uPattGridX         (_glc->uPattGridX)
+#define _uPattGridY         (_glc->uPattGridY)
+#define _uPattW             (_glc->uPattW)
+#define _uPattH             (_glc->uPattH)
+#define _aPosition          (_glc->aPosition)
+#define _aUV                (_glc->aUV)
+#ifdef S52_USE_SYM_ATLAS
+#define _atlasOn            (_glc->atlasOn)
+#endif
+#define _aAlpha             (_glc->aAlpha)
+#define _tessWorkBuf_f      (_glc->tessWorkBuf_f)
+#define _freetype_gl_buffer (_glc->freetype_gl_buffer)
+#endif
+#ifdef S52_USE_AFGLOW
+#define _aftglwColorArr     (_glc->aftglwColorArr)
+#define _vboIDaftglwVertID  (_glc->vboIDaftglwVertID)
+#define _vboIDaftglwColrID  (_glc->vboIDaftglwColrID)
+#endif
+#ifdef S52_USE_GPU_TIMER
+#define _tq                 (_glc->tq)
+#endif
+
+// prim, VBO, texture and symbol of the share group are built by the first context
+// that draw them - check, lock, check again (GL1 and SW draw one context at a time)
+#if defined(S52_USE_CTX) && defined(S52_USE_GL2) && !defined(S52_USE_SW)
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticRecMutex _build_mutex = G_STATIC_REC_MUTEX_INIT;
+#define GLBUILDLOCK    g_static_rec_mutex_lock(&_build_mutex)
+#define GLBUILDUNLOCK  g_static_rec_mutex_unlock(&_build_mutex)
+#else
+static GRecMutex       _build_mutex;
+#define GLBUILDLOCK    g_rec_mutex_lock(&_build_mutex)
+#define GLBUILDUNLOCK  g_rec_mutex_unlock(&_build_mutex)
+#endif
+// the GL object is complete for the other GL context of the share group
+#define GLBUILDFLUSH   glFlush()
+#else
+#define GLBUILDLOCK
+#define GLBUILDUNLOCK
+#define GLBUILDFLUSH
+#endif
 
 // GL1.x
 #ifdef S52_USE_GL1
@@ -155,6 +392,13 @@ static double _dotpitch_mm_y = 0.3;  // will be overwright at init()
 #include "_GL2.i"
 #endif
 
+// GPU timer (_GL2.i) - no-op
+#ifndef S52_USE_GPU_TIMER
+#define TQ_MARK(stage, prio, cmd)
+#define TQ_BEG(cycle)
+#define TQ_END(cycle)
+#endif
+
 // GL3.x, GLES3.x -- in a day (npot)
 //#ifdef S52_USE_GL3
 //#define S52_USE_GL2 // super set of GL2
@@ -163,35 +407,15 @@ static double _dotpitch_mm_y = 0.3;  // will be overwright at init()
 //#endif
 
 
-///////////////////////////////////////////////////////////////////
-//
-// statistique
-//
-static guint   _nobj   = 0;     // number of object drawn during lap
-static guint   _ncmd   = 0;     // number of command drawn during lap
-static guint   _oclip  = 0;     // number of object clipped
-static guint   _nFrag  = 0;     // number of pixel fragment (color switch)
-static int     _drgare = 0;     // DRGARE
-static int     _depare = 0;     // DEPARE
-static int     _nAC    = 0;     // total AC (Area Color)
-
-// tesselated area stat
-static guint   _ntris     = 0;     // area GL_TRIANGLES      count
-static guint   _ntristrip = 0;     // area GL_TRIANGLE_STRIP count
-static guint   _ntrisfan  = 0;     // area GL_TRIANGLE_FAN   count
-static guint   _nCall     = 0;
-static guint   _npoly     = 0;     // total polys
+// bumped when prim / VBO are built at draw time - S52_getStats() re-walk cell memory
+static gint    _memGen    = 0;
 
 // debug
 //static int   _debug  = 0;
 //static int   _DEBUG  = FALSE;
 //static guint _S57ID  = 0;
 
-// hold copy of FrameBuffer
-static guint          _fb_pixels_id   = 0;     // texture ID
-static unsigned char *_fb_pixels      = NULL;
-static guint          _fb_pixels_size = 0;
-static int            _fb_pixels_udp  = TRUE;  // TRUE flag that the FB changed
+// format of the copy of FrameBuffer
 #define _RGB           3
 #define _RGBA          4
 #ifdef S52_USE_ADRENO
@@ -205,6 +429,10 @@ static int            _fb_pixels_format      = _RGBA;
 // GL utility
 #include "_GLU.i"
 
+#ifndef ATLAS_OFF
+#define ATLAS_OFF()
+#endif
+
 #ifdef S52_USE_PROJ
 #include <proj_api.h>   // projUV, projXY
 #else
@@ -225,13 +453,6 @@ typedef struct { double u, v; } projUV;
 
 #define NM_METER 1852.0
 
-#ifdef S52_USE_AFGLOW
-// experimental: synthetic after glow
-static GArray  *_aftglwColorArr    = NULL;
-static GLuint   _vboIDaftglwVertID = 0;
-static GLuint   _vboIDaftglwColrID = 0;
-#endif
-
 // experimental
 static vertex_t _hazardZone[5*3];
 
@@ -545,11 +766,35 @@ static int       _getLODidx(char **str)
     }
 }
 
-static int       _computeCentroid(S57_geo *geo)
+static int       _isCentroidClip(S57_geo *geo)
+// TRUE if _computeCentroid() clip the area to the view - ie extent not inside
+// the view and visual centre of the area out of view
+{
+    ObjExt_t ext = S57_getExt(geo);
+    pt3 pt[2] = {{ext.W, ext.S, 0.0}, {ext.E, ext.N, 0.0}};
+    if (FALSE == S57_geo2prj3dv(2, pt))
+        return FALSE;
+
+    if ((_pmin.u < pt[0].x) && (_pmin.v < pt[0].y) && (_pmax.u > pt[1].x) && (_pmax.v > pt[1].y))
+        return FALSE;
+
+    pt3 c = {0.0, 0.0, 0.0};
+    if ((TRUE == S57_getCenter(geo, &c.x, &c.y)) &&
+        (_pmin.u < c.x) && (_pmin.v < c.y) && (_pmax.u > c.x) && (_pmax.v > c.y))
+        return FALSE;
+
+    return TRUE;
+}
+
+static int       _computeCentroid(S57_geo *geo, int *clip)
 // return centroids
 // fill global array _centroid
-// FIXME: this is very expensive for large poly (good test case:CA279037.000, IT zone)
+// Note: CSG clip (expensive for large poly, test case:CA279037.000, IT zone) only
+// when the visual centre of the area (S57_getCenter()) is outside the view
+// clip: TRUE if the centroids are the one of the part of the area in view
 {
+    *clip = FALSE;
+
 #ifdef S52_USE_GV
     // FIXME: there is a bug, tesselator fail
     return _centroids;
@@ -659,15 +904,36 @@ User bands Navigational
         g_array_set_size(_centroids, 0);
 
         //_getCentroidClose(npt, (pt3*)ppt);
-        _getCentroid(npt, (pt3*)ppt);
+        //_getCentroid(npt, (pt3*)ppt);
         //_getCentroidClose(nptLOD1, pptLOD1);
         //PRINTF("no clip: %s\n", S57_getName(geo));
 
+        // pole of inaccessibility - allway inside, precomputed at load
+        pt3 c = {0.0, 0.0, 0.0};
+        if (TRUE == S57_getCenter(geo, &c.x, &c.y))
+            g_array_append_val(_centroids, c);
+        else
+            _getCentroid(npt, (pt3*)ppt);
+
         return TRUE;
     }
 
+    // area clipped by view but its centre is in view - no need to clip
+    {
+        pt3 c = {0.0, 0.0, 0.0};
+        if ((TRUE == S57_getCenter(geo, &c.x, &c.y)) &&
+            (_pmin.u < c.x) && (_pmin.v < c.y) && (_pmax.u > c.x) && (_pmax.v > c.y)) {
+            g_array_set_size(_centroids, 0);
+            g_array_append_val(_centroids, c);
+
+            return TRUE;
+        }
+    }
+
     // CSG - Computational Solid Geometry  (clip poly)
     {
+        *clip = TRUE;
+
         _g_ptr_array_clear(_tmpV);
 
         g_array_set_size(_centroids, 0);
@@ -758,6 +1024,58 @@ User bands Navigational
     return TRUE;
 }
 
+static int       _getCentroidsGeo(S57_geo *geo)
+// fill _centroids from the centroids of geo - compute new one (_computeCentroid())
+// only if the LOD band changed, a centroid is out of view or the centroids of
+// the clipped area are stale (whole area or its centre now in view)
+{
+    char *str = NULL;
+    int   lod = _getLODidx(&str);
+
+    g_array_set_size(_centroids, 0);
+
+    if ((lod==S57_getCentroidLOD(geo)) && (TRUE==S57_hasCentroid(geo)) &&
+        ((FALSE==S57_getCentroidClip(geo)) || (TRUE==_isCentroidClip(geo)))) {
+        pt3      pt     = {0.0, 0.0, 0.0};
+        gboolean inView = TRUE;
+        while (TRUE == S57_getNextCent(geo, &pt.x, &pt.y)) {
+            if ((pt.x < _pmin.u) || (pt.y < _pmin.v) || (pt.x > _pmax.u) || (pt.y > _pmax.v)) {
+                inView = FALSE;
+                break;
+            }
+            g_array_append_val(_centroids, pt);
+        }
+
+        if (TRUE == inView)
+            return TRUE;
+
+        g_array_set_size(_centroids, 0);
+    }
+
+    int clip = FALSE;
+    _computeCentroid(geo, &clip);
+
+    S57_newCentroid(geo);
+    for (guint i=0; i<_centroids->len; ++i) {
+        pt3 *pt = &g_array_index(_centroids, pt3, i);
+        S57_addCentroid(geo, pt->x, pt->y);
+    }
+    S57_setCentroidLOD (geo, lod);
+    S57_setCentroidClip(geo, clip);
+
+    return TRUE;
+}
+
+static int       _getCentroids(S57_geo *geo)
+// Note: centroid cache of geo and the GLU tesselator are shared by the context
+{
+    GLBUILDLOCK;
+    int ret = _getCentroidsGeo(geo);
+    GLBUILDUNLOCK;
+
+    return ret;
+}
+
 
 static void      _glMatrixMode(GLenum  mode)
 {
@@ -980,8 +1298,8 @@ static GLint     _glMatrixDump(int mode)
     return TRUE;
 }
 
-static GLint     _glMatrixSet(VP vpcoord)
-// push & reset matrix GL_PROJECTION & GL_MODELVIEW
+static GLint     _glMatrixSetRot(VP vpcoord, double north)
+// push & reset matrix GL_PROJECTION & GL_MODELVIEW - rotated 'north' deg about the center
 {
 #ifdef S52_USE_GV
     return TRUE;
@@ -1035,7 +1353,7 @@ static GLint     _glMatrixSet(VP vpcoord)
     //*
     _glTranslated(  (left+right)/2.0,  (bottom+top)/2.0, 0.0);
     //_glRotated   (_north, 0.0, 0.0, 1.0);
-    _glRotated   (_view.north, 0.0, 0.0, 1.0);
+    _glRotated   (north, 0.0, 0.0, 1.0);
     _glTranslated( -(left+right)/2.0, -(bottom+top)/2.0, 0.0);
     //PRINTF("DEBUG: north:%f\n", _north);
     //*/
@@ -1058,6 +1376,12 @@ static GLint     _glMatrixSet(VP vpcoord)
     return TRUE;
 }
 
+static GLint     _glMatrixSet(VP vpcoord)
+// push & reset matrix GL_PROJECTION & GL_MODELVIEW - rotated to the view
+{
+    return _glMatrixSetRot(vpcoord, _view.north);
+}
+
 static GLint     _glMatrixDel(VP vpcoord)
 // pop matrix GL_PROJECTION & GL_MODELVIEW
 {
@@ -1144,7 +1468,7 @@ static projXY    _prj2win(projXY p)
 
 #ifdef S52_USE_GL2
     // FIXME: find a better way to catch non initialyse matrix
-    if (0 == _pjm[_pjmTop]) {
+    if (0 == _pjm[_pjmTop][0]) {
         g_assert(0);
         return p;
     }
@@ -1225,6 +1549,164 @@ int        S52_GL_prj2win(double *x, double *y)
     return TRUE;
 }
 
+static _frame_t *_getFrame(gpointer ctx);  // NULL - current context
+
+static void      _setFrameView(void)
+{
+    g_atomic_int_inc(&_frame->seq);
+
+    _frame->fv.l     = _pmin.u;
+    _frame->fv.r     = _pmax.u;
+    _frame->fv.b     = _pmin.v;
+    _frame->fv.t     = _pmax.v;
+    _frame->fv.north = _view.north;
+    _frame->fv.x     = _vp.x;
+    _frame->fv.y     = _vp.y;
+    _frame->fv.w     = _vp.w;
+    _frame->fv.h     = _vp.h;
+
+    g_atomic_int_inc(&_frame->seq);
+}
+
+static int       _getFrameView(gpointer ctx, _frameView_t *fv)
+{
+    _frame_t *f   = _getFrame(ctx);
+    gint      seq = 0;
+
+    do {
+        while (1 == ((seq = g_atomic_int_get(&f->seq)) & 1))
+            ;  // writer busy
+
+        if (0 == seq)
+            return FALSE;
+
+        *fv = f->fv;
+    } while (seq != g_atomic_int_get(&f->seq));
+
+    return TRUE;
+}
+
+// affine transform of the frame: x' = m[0]*x + m[1]*y + m[2], y' = m[3]*x + m[4]*y + m[5]
+// computed once per batch - the inverse of the ortho+rotation is the transpose (no matrix inversion)
+static void      _frameAffine(const _frameView_t *fv, int toWin, double m[6])
+{
+    double cx = (fv->l + fv->r) / 2.0;
+    double cy = (fv->b + fv->t) / 2.0;
+    double hw = (fv->r - fv->l) / 2.0;   // half extent (prj)
+    double hh = (fv->t - fv->b) / 2.0;
+    double c  = cos(fv->north * DEG_TO_RAD);
+    double s  = sin(fv->north * DEG_TO_RAD);
+
+    if (TRUE == toWin) {
+        // prj --> rotate about center --> NDC --> window
+        double sx = fv->w / (2.0 * hw);
+        double sy = fv->h / (2.0 * hh);
+        m[0] =  c * sx; m[1] = -s * sx; m[2] = fv->x + fv->w / 2.0 - (c*cx - s*cy) * sx;
+        m[3] =  s * sy; m[4] =  c * sy; m[5] = fv->y + fv->h / 2.0 - (s*cx + c*cy) * sy;
+    } else {
+        // window --> NDC --> undo rotation --> prj
+        double sx = 2.0 * hw / fv->w;
+        double sy = 2.0 * hh / fv->h;
+        double qx = -(fv->x + fv->w / 2.0) * sx;
+        double qy = -(fv->y + fv->h / 2.0) * sy;
+        m[0] =  c * sx; m[1] =  s * sy; m[2] = cx + c*qx + s*qy;
+        m[3] = -s * sx; m[4] =  c * sy; m[5] = cy - s*qx + c*qy;
+    }
+}
+
+static void      _frameAffinev(const double m[6], guint npt, double *x, double *y, guint stride)
+{
+#ifdef __SSE2__
+    // interleaved XY: one point per register
+    if ((2==stride) && (y==x+1)) {
+        __m128d m0 = _mm_set_pd(m[3], m[0]);
+        __m128d m1 = _mm_set_pd(m[4], m[1]);
+        __m128d m2 = _mm_set_pd(m[5], m[2]);
+        for (guint i=0; i<npt; ++i, x+=2) {
+            __m128d p  = _mm_loadu_pd(x);
+            __m128d px = _mm_unpacklo_pd(p, p);
+            __m128d py = _mm_unpackhi_pd(p, p);
+            _mm_storeu_pd(x, _mm_add_pd(_mm_add_pd(_mm_mul_pd(m0, px), _mm_mul_pd(m1, py)), m2));
+        }
+        return;
+    }
+#endif
+
+    for (guint i=0; i<npt; ++i, x+=stride, y+=stride) {
+        double u = *x;
+        double v = *y;
+        *x = m[0]*u + m[1]*v + m[2];
+        *y = m[3]*u + m[4]*v + m[5];
+    }
+}
+
+int        S52_GL_win2prjFramev(gpointer ctx, guint npt, double *x, double *y, guint stride)
+// convert coordinate: window --> projected, for the last frame drawn
+// same as S52_GL_win2prj() (ortho rotated about the center) but no GL call, any thread
+{
+    _frameView_t fv;
+    if (FALSE == _getFrameView(ctx, &fv))
+        return FALSE;
+
+    double m[6];
+    _frameAffine(&fv, FALSE, m);
+    _frameAffinev(m, npt, x, y, stride);
+
+    return TRUE;
+}
+
+int        S52_GL_prj2winFramev(gpointer ctx, guint npt, double *x, double *y, guint stride)
+// convert coordinate: projected --> window, for the last frame drawn (no GL call, any thread)
+{
+    _frameView_t fv;
+    if (FALSE == _getFrameView(ctx, &fv))
+        return FALSE;
+
+    double m[6];
+    _frameAffine(&fv, TRUE, m);
+    _frameAffinev(m, npt, x, y, stride);
+
+    return TRUE;
+}
+
+int        S52_GL_win2prjFrame(gpointer ctx, double *x, double *y)
+{
+    return S52_GL_win2prjFramev(ctx, 1, x, y, 0);
+}
+
+int        S52_GL_prj2winFrame(gpointer ctx, double *x, double *y)
+{
+    return S52_GL_prj2winFramev(ctx, 1, x, y, 0);
+}
+
+int        S52_GL_getViewPortFrame(gpointer ctx, int *x, int *y, int *width, int *height)
+// viewport of the last frame drawn
+{
+    _frameView_t fv;
+    if (FALSE == _getFrameView(ctx, &fv))
+        return FALSE;
+
+    *x      = (int)fv.x;
+    *y      = (int)fv.y;
+    *width  = (int)fv.w;
+    *height = (int)fv.h;
+
+    return TRUE;
+}
+
+int        S52_GL_getViewCtx(gpointer ctx, double *centerLat, double *centerLon, double *rangeNM, double *north)
+// view set by S52_GL_setView() in ctx (NULL - current context)
+{
+    _frame_t *f = _getFrame(ctx);
+
+    *centerLat = f->view.cLat;
+    *centerLon = f->view.cLon;
+    *rangeNM   = f->view.rNM;
+    *north     = f->view.north;
+
+    return TRUE;
+}
+
 static void      _glLineStipple(GLint  factor,  GLushort  pattern)
 {
 #ifdef S52_USE_GL2
@@ -1298,6 +1780,7 @@ static GLvoid    _DrawArrays_LINE_STRIP(guint npt, vertex_t *ppt)
     }
 
 #ifdef S52_USE_GL2
+    ATLAS_OFF();
     glEnableVertexAttribArray(_aPosition);
     glVertexAttribPointer    (_aPosition, 3, GL_FLOAT, GL_FALSE, 0, ppt);
     glDrawArrays(GL_LINE_STRIP, 0, npt);
@@ -1329,6 +1812,7 @@ static GLvoid    _DrawArrays_LINES(guint npt, vertex_t *ppt)
     }
 
 #ifdef S52_USE_GL2
+    ATLAS_OFF();
     glEnableVertexAttribArray(_aPosition);
     glVertexAttribPointer    (_aPosition, 3, GL_FLOAT, GL_FALSE, 0, ppt);
     glDrawArrays(GL_LINES, 0, npt);
@@ -1390,6 +1874,13 @@ static int       _VBODrawArrays_AREA(S57_prim *prim)
             g_assert(0);
         } else {
             glDrawArrays(mode, first, count);
+
+            // stat - triangles sent
+            if (GL_TRIANGLES == mode)
+                _ntris += count / 3;
+            else
+                _ntris += (2 < count) ? count - 2 : 0;
+            ++_npoly;
         }
     }
 
@@ -1424,6 +1915,7 @@ static int       _VBOCreate(S57_prim *prim)
         }
 
         // bind VBO in order to use
+        ATLAS_OFF();
         glBindBuffer(GL_ARRAY_BUFFER, vboID);
 
         // upload VBO data to GPU
@@ -1433,6 +1925,8 @@ static int       _VBOCreate(S57_prim *prim)
 
         _checkError("_VBOCreate()");
 
+        g_atomic_int_inc(&_memGen);
+
     } else {
         PRINTF("ERROR: VBO allready set!\n");
         g_assert(0);
@@ -1453,12 +1947,12 @@ static int       _VBODraw_AREA(S57_prim *prim)
     if (FALSE == S57_getPrimData(prim, &primNbr, &vert, &vertNbr, &vboID))
         return FALSE;
 
-    if (0 == vboID) {
-        vboID = _VBOCreate(prim);
-        S57_setPrimDList(prim, vboID);
-    }
+    // Note: VBO created by _fillAreaPrim()
+    if (0 == vboID)
+        return FALSE;
 
     // bind VBOs for vertex array of vertex coordinates
+    ATLAS_OFF();
     glBindBuffer(GL_ARRAY_BUFFER, vboID);
 
 #ifdef S52_USE_GL2
@@ -1554,98 +2048,359 @@ static double    _getWorldGridRef(S52_obj *obj, double *LLx, double *LLy, double
     return stagOffsetPix;
 }
 
-static int       _fillArea(S57_geo *geo)
+#ifdef S52_USE_STENCIL_FILL
+// valid GLenum for glDrawArrays mode is 0-9 (see _TRANSLATE in _GLU.i)
+// first primitive of the prim of a stencil-then-cover area - the decision is kept in the prim
+#define _STENCIL      0x000C  // mode=12, no vertex
+
+static int       _stencilOn(void)
+// TRUE if the area of many vertex can be filled by stencil-then-cover
 {
-    S57_prim *prim = S57_getPrimGeo(geo);
-    if (NULL == prim) {
-        prim = _tessd(_tobj, geo);
-    }
+    if ((0>=_stencilFillNpt) || (0>=_stencilBits))
+        return FALSE;
 
-#ifdef S52_USE_OPENGL_VBO
-    if (FALSE == _VBODraw_AREA(prim)) {
-        PRINTF("DEBUG: _VBODraw_AREA() failed [%s]\n", S57_getName(geo));
-    }
-#else
-    _callDList(prim);
+#ifdef S52_USE_SW
+    // stencil not in S52SW.c
+    if (TRUE == _swOn)
+        return FALSE;
 #endif
 
     return TRUE;
 }
 
+static int       _isStencilPrim(S57_prim *prim)
+{
+    GLint mode  = 0;
+    GLint first = 0;
+    GLint count = 0;
 
-//---------------------------------------
-//
-// SYMBOLOGY INSTRUCTION RENDERER SECTION
-//
-//---------------------------------------
-
-// FIXME: ship head up for safety perimeter
-
-// S52_GL_PICK mode
-typedef struct col {
-    GLubyte r;
-    GLubyte g;
-    GLubyte b;
-    // FIXME: use _fb_format (rgb/rgba) and EGL rgb/rgba
-    GLubyte a;
-} col;
+    if (FALSE == S57_getPrimIdx(prim, 0, &mode, &first, &count))
+        return FALSE;
 
-typedef union cIdx {
-    col   color;
-    guint idx;
-} cIdx;
-static cIdx _cIdx;
-// FIXME: try 1 x 1
-//static cIdx _pixelsRead[1 * 1];  // buffer to collect pixels when in S52_GL_PICK mode
-static cIdx _pixelsRead[8 * 8];  // buffer to collect pixels when in S52_GL_PICK mode
+    return (_STENCIL == mode);
+}
 
-#if 0
-/* MSAA experiment does the blending now
-static int       _setBlend(int blend)
-// TRUE turn on blending if AA
+static S57_prim *_stencilPrim(S57_geo *geo)
+// prim of a stencil-then-cover area: _STENCIL, a fan per ring, the cover quad
+// (extent of the outer ring) - ring converted to vertex_t once, then drawn from the VBO
 {
-    if (TRUE == (int) S52_MP_get(S52_MAR_ANTIALIAS)) {
-        if (TRUE == blend) {
-            glEnable(GL_BLEND);
-
-#ifdef S52_USE_GL1
-            glEnable(GL_LINE_SMOOTH);
-            glEnable(GL_ALPHA_TEST);
-#endif
+    S57_prim *prim = S57_initPrimGeo(geo);
+    guint     nr   = S57_getRingNbr(geo);
+    double    minx = INFINITY, miny = INFINITY;
+    double    maxx =-INFINITY, maxy =-INFINITY;
+
+    S57_begPrim(prim, _STENCIL);
+    S57_endPrim(prim);
+
+    for (guint i=0; i<nr; ++i) {
+        guint   npt = 0;
+        double *ppt = NULL;
+
+        // ring closed - last vertex not needed by the fan
+        if ((TRUE==S57_getGeoData(geo, i, &npt, &ppt)) && (3<npt)) {
+            S57_begPrim(prim, GL_TRIANGLE_FAN);
+            for (guint j=0; j<npt-1; ++j) {
+                vertex_t d[3] = {ppt[j*3+0], ppt[j*3+1], 0.0};
+                S57_addPrimVertex(prim, d);
+
+                if (0 == i) {
+                    minx = MIN(minx, ppt[j*3+0]);
+                    miny = MIN(miny, ppt[j*3+1]);
+                    maxx = MAX(maxx, ppt[j*3+0]);
+                    maxy = MAX(maxy, ppt[j*3+1]);
+                }
+            }
+            S57_endPrim(prim);
         } else {
-            glDisable(GL_BLEND);
-
-#ifdef S52_USE_GL1
-            glDisable(GL_LINE_SMOOTH);
-            glDisable(GL_ALPHA_TEST);
-#endif
+            // no outer ring - nothing to cover
+            if (0 == i)
+                break;
         }
     }
 
-    _checkError("_setBlend()");
+    if (INFINITY != minx) {
+        vertex_t quad[4*3] = {
+            minx, miny, 0.0,
+            maxx, miny, 0.0,
+            minx, maxy, 0.0,
+            maxx, maxy, 0.0
+        };
+        S57_begPrim(prim, GL_TRIANGLE_STRIP);
+        for (guint j=0; j<4; ++j)
+            S57_addPrimVertex(prim, &quad[j*3]);
+        S57_endPrim(prim);
+    }
 
-    return TRUE;
+    return prim;
 }
-*/
-#endif  // 0
 
-static int       _glColor4ub(GLubyte r, GLubyte g, GLubyte b, GLubyte a)
+static int       _fillAreaStencil(S57_prim *prim)
+// stencil-then-cover - no tessellation: a fan of each ring invert the stencil bit
+// (even-odd, as libtess ODD winding), then a quad on the extent of the outer ring
+// cover where the bit is set - and reset it for the next area
 {
-#ifdef S52_USE_GL2
-    GLfloat alpha = (4 - (a - '0')) * TRNSP_FAC_GLES2;
-    glUniform4f(_uColor, r/255.0, g/255.0, b/255.0, alpha);
-#else
-    GLbyte alpha = (4 - (a - '0')) * TRNSP_FAC;
-    glColor4ub(r, g, b, alpha);
-#endif
+    guint     primNbr = 0;
+    vertex_t *vert    = NULL;
+    guint     vertNbr = 0;
+    guint     vboID   = 0;
 
-    _checkError("_glColor4ub()");
+    if (FALSE == S57_getPrimData(prim, &primNbr, &vert, &vertNbr, &vboID))
+        return FALSE;
 
-    return TRUE;
-}
+    // no outer ring
+    if (primNbr < 3)
+        return TRUE;
 
-static GLubyte   _setFragAttrib(S52_Color *c, gboolean highlight)
-// set fragment attributes: color/highlight, trans, pen_w
+    ATLAS_OFF();
+
+#ifdef S52_USE_OPENGL_VBO
+    // Note: VBO created by _fillAreaPrim()
+    if (0 == vboID)
+        return FALSE;
+    glBindBuffer(GL_ARRAY_BUFFER, vboID);
+    vert = NULL;  // offset in VBO
+#endif
+
+    // fan are CW and CCW
+    GLboolean cull = glIsEnabled(GL_CULL_FACE);
+    glDisable(GL_CULL_FACE);
+
+    glEnable(GL_STENCIL_TEST);
+    glStencilMask(0x01);
+
+    // stencil
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glStencilFunc(GL_ALWAYS, 0, 0x01);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+
+    glEnableVertexAttribArray(_aPosition);
+    glVertexAttribPointer(_aPosition, 3, GL_FLOAT, GL_FALSE, 0, vert);
+
+    for (guint i=1; i<primNbr; ++i) {
+        GLint mode  = 0;
+        GLint first = 0;
+        GLint count = 0;
+
+        S57_getPrimIdx(prim, i, &mode, &first, &count);
+
+        // cover - last prim
+        if (GL_TRIANGLE_STRIP == mode) {
+            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            glStencilFunc(GL_NOTEQUAL, 0, 0x01);
+            glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
+
+            ++_npoly;
+        }
+
+        glDrawArrays(mode, first, count);
+
+        // stat - triangles sent
+        _ntris += count - 2;
+    }
+
+    glDisableVertexAttribArray(_aPosition);
+
+#ifdef S52_USE_OPENGL_VBO
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+#endif
+
+    glDisable(GL_STENCIL_TEST);
+    if (GL_TRUE == cull)
+        glEnable(GL_CULL_FACE);
+
+    _checkError("_fillAreaStencil()");
+
+    return TRUE;
+}
+#endif  // S52_USE_STENCIL_FILL
+
+static int       _fillAreaBuilt(S57_prim *prim)
+// TRUE if the prim of an area can be drawn as is - the VBO is set last (see _fillAreaPrim())
+{
+    if (NULL == prim)
+        return FALSE;
+
+#ifdef S52_USE_OPENGL_VBO
+    guint     primNbr = 0;
+    vertex_t *vert    = NULL;
+    guint     vertNbr = 0;
+    guint     vboID   = 0;
+    if ((FALSE==S57_getPrimData(prim, &primNbr, &vert, &vertNbr, &vboID)) || (0==vboID))
+        return FALSE;
+#endif
+
+#ifdef S52_USE_STENCIL_FILL
+    if ((TRUE==_isStencilPrim(prim)) && (FALSE==_stencilOn()))
+        return FALSE;
+#endif
+
+    return TRUE;
+}
+
+static S57_prim *_fillAreaPrim(S57_geo *geo)
+// build the prim of an area (stencil or tessellated) and its VBO
+{
+    S57_prim *prim = S57_getPrimGeo(geo);
+
+#ifdef S52_USE_STENCIL_FILL
+    // huge area (ocean DEPARE, M_COVR, LNDARE) - skip tessellation (CPU and memory)
+    // Note: decided once, at the first draw of the area - the prim keep it (_STENCIL)
+    if (NULL == prim) {
+        if (TRUE == _stencilOn()) {
+            guint n = 0;
+            for (guint i=0; i<S57_getRingNbr(geo); ++i) {
+                guint   npt = 0;
+                double *ppt = NULL;
+                if (TRUE == S57_getGeoData(geo, i, &npt, &ppt))
+                    n += npt;
+            }
+
+            if ((guint)_stencilFillNpt <= n) {
+                prim = _stencilPrim(geo);
+                g_atomic_int_inc(&_memGen);
+            }
+        }
+    } else {
+        if ((TRUE==_isStencilPrim(prim)) && (FALSE==_stencilOn())) {
+            // no stencil now (SW rasteriser) - tessellate after all
+#ifdef S52_USE_OPENGL_VBO
+            guint     primNbr = 0;
+            vertex_t *vert    = NULL;
+            guint     vertNbr = 0;
+            guint     vboID   = 0;
+            S57_getPrimData(prim, &primNbr, &vert, &vertNbr, &vboID);
+            if (0 != vboID) {
+                glDeleteBuffers(1, &vboID);
+                S57_setPrimDList(prim, 0);
+            }
+#endif
+            prim = NULL;
+        }
+    }
+#endif  // S52_USE_STENCIL_FILL
+
+    if (NULL == prim) {
+        prim = _tessd(_tobj, geo);
+        g_atomic_int_inc(&_memGen);
+    }
+
+#ifdef S52_USE_OPENGL_VBO
+    guint     primNbr = 0;
+    vertex_t *vert    = NULL;
+    guint     vertNbr = 0;
+    guint     vboID   = 0;
+    if ((TRUE==S57_getPrimData(prim, &primNbr, &vert, &vertNbr, &vboID)) && (0==vboID)) {
+        vboID = _VBOCreate(prim);
+        // last - the VBO is complete for the other context
+        GLBUILDFLUSH;
+        S57_setPrimDList(prim, vboID);
+    }
+#endif
+
+    return prim;
+}
+
+static int       _fillArea(S57_geo *geo)
+{
+    S57_prim *prim = S57_getPrimGeo(geo);
+
+    // build once, by the first context that draw the area
+    if (FALSE == _fillAreaBuilt(prim)) {
+        GLBUILDLOCK;
+        prim = _fillAreaPrim(geo);
+        GLBUILDUNLOCK;
+    }
+
+#ifdef S52_USE_STENCIL_FILL
+    if ((NULL!=prim) && (TRUE==_isStencilPrim(prim)))
+        return _fillAreaStencil(prim);
+#endif
+
+#ifdef S52_USE_OPENGL_VBO
+    if (FALSE == _VBODraw_AREA(prim)) {
+        PRINTF("DEBUG: _VBODraw_AREA() failed [%s]\n", S57_getName(geo));
+    }
+#else
+    _callDList(prim);
+#endif
+
+    return TRUE;
+}
+
+
+//---------------------------------------
+//
+// SYMBOLOGY INSTRUCTION RENDERER SECTION
+//
+//---------------------------------------
+
+// FIXME: ship head up for safety perimeter
+
+// S52_GL_PICK mode
+typedef struct col {
+    GLubyte r;
+    GLubyte g;
+    GLubyte b;
+    // FIXME: use _fb_format (rgb/rgba) and EGL rgb/rgba
+    GLubyte a;
+} col;
+
+typedef union cIdx {
+    col   color;
+    guint idx;
+} cIdx;
+static cIdx _cIdx;
+// FIXME: try 1 x 1
+//static cIdx _pixelsRead[1 * 1];  // buffer to collect pixels when in S52_GL_PICK mode
+static cIdx _pixelsRead[8 * 8];  // buffer to collect pixels when in S52_GL_PICK mode
+
+#if 0
+/* MSAA experiment does the blending now
+static int       _setBlend(int blend)
+// TRUE turn on blending if AA
+{
+    if (TRUE == (int) S52_MP_get(S52_MAR_ANTIALIAS)) {
+        if (TRUE == blend) {
+            glEnable(GL_BLEND);
+
+#ifdef S52_USE_GL1
+            glEnable(GL_LINE_SMOOTH);
+            glEnable(GL_ALPHA_TEST);
+#endif
+        } else {
+            glDisable(GL_BLEND);
+
+#ifdef S52_USE_GL1
+            glDisable(GL_LINE_SMOOTH);
+            glDisable(GL_ALPHA_TEST);
+#endif
+        }
+    }
+
+    _checkError("_setBlend()");
+
+    return TRUE;
+}
+*/
+#endif  // 0
+
+static int       _glColor4ub(GLubyte r, GLubyte g, GLubyte b, GLubyte a)
+{
+#ifdef S52_USE_GL2
+    GLfloat alpha = (4 - (a - '0')) * TRNSP_FAC_GLES2;
+    glUniform4f(_uColor, r/255.0, g/255.0, b/255.0, alpha);
+#else
+    GLbyte alpha = (4 - (a - '0')) * TRNSP_FAC;
+    glColor4ub(r, g, b, alpha);
+#endif
+
+    _checkError("_glColor4ub()");
+
+    return TRUE;
+}
+
+static GLubyte   _setFragAttrib(S52_Color *c, gboolean highlight)
+// set fragment attributes: color/highlight, trans, pen_w
 // return transparancy/alpha
 {
     if (S52_GL_PICK == _crnt_GL_cycle) {
@@ -1709,21 +2464,42 @@ static int       _glCallList(S52_DListData *DListData)
     GLuint     lst = DListData->vboIds[0];
     S52_Color *col = DListData->colors;
 
+#ifdef S52_USE_SYM_ATLAS
+    // bind once for a run of SY / LC / AP - unbound lazily (see _glAtlasOff())
+    if ((TRUE==DListData->atlas) && (FALSE==_atlasOn)) {
+        glBindBuffer(GL_ARRAY_BUFFER, _symbAtlasVBO);
+        glVertexAttribPointer(_aPosition, 3, GL_FLOAT, GL_FALSE, 0, 0);
+        _atlasOn = TRUE;
+        ++_nbind;
+    }
+#endif
+
     for (guint i=0; i<DListData->nbr; ++i, ++lst, ++col) {
 
         //GLubyte trans =
         _setFragAttrib(col, FALSE);
 
 #ifdef S52_USE_OPENGL_VBO
-        GLuint vboId = DListData->vboIds[i];
-        glBindBuffer(GL_ARRAY_BUFFER, vboId);         // for vertex coordinates
+        GLint base = 0;   // first vertex of sub-list in VBO
+
+#ifdef S52_USE_SYM_ATLAS
+        if (TRUE == DListData->atlas) {
+            base = DListData->atlasOff[i];
+        } else
+#endif
+        {
+            GLuint vboId = DListData->vboIds[i];
+            ATLAS_OFF();
+            glBindBuffer(GL_ARRAY_BUFFER, vboId);         // for vertex coordinates
+            ++_nbind;
 
-        // reset offset in VBO
+            // reset offset in VBO
 #ifdef S52_USE_GL2
-        glVertexAttribPointer(_aPosition, 3, GL_FLOAT, GL_FALSE, 0, 0);
+            glVertexAttribPointer(_aPosition, 3, GL_FLOAT, GL_FALSE, 0, 0);
 #else
-        glVertexPointer(3, GL_DBL_FLT, 0, 0);
+            glVertexPointer(3, GL_DBL_FLT, 0, 0);
 #endif
+        }
 
         {
             guint j     = 0;
@@ -1774,7 +2550,7 @@ static int       _glCallList(S52_DListData *DListData)
                         //*/
 
                         // normal draw
-                        glDrawArrays(mode, first, count);
+                        glDrawArrays(mode, base + first, count);
 
 #ifdef S52_USE_GL2
                         glUniformMatrix4fv(_uModelview,  1, GL_FALSE, _mvm[_mvmTop]);
@@ -1788,6 +2564,9 @@ static int       _glCallList(S52_DListData *DListData)
 
             }
         }
+#ifdef S52_USE_SYM_ATLAS
+        if (TRUE != DListData->atlas)
+#endif
         glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 #else   // S52_USE_OPENGL_VBO
@@ -2777,26 +3556,10 @@ static int       _renderSY(S52_obj *obj)
             double offset_x;
             double offset_y;
 
-            // corner case where scrolling set area is clipped by view
-            ObjExt_t ext = S57_getExt(geo);
-            if ((ext.S < _gmin.v) || (ext.N > _gmax.v) || (ext.W < _gmin.u) || (ext.E > _gmax.u)) {
-                // reset centroid
-                S57_newCentroid(geo);
-            }
-
-            // skip centroid computation if allready available
+            // centroid cached in geo - recomputed only when the LOD band change
+            // or when a centroid scroll out of view
             // (cost 30% CPU and no glDraw(); from 120ms to 80ms on Estuaire du St-L CA279037.000)
-            if (TRUE == S57_hasCentroid(geo)) {
-                double x,y;
-                while (TRUE == S57_getNextCent(geo, &x, &y)) {
-                    //_renderSY_POINT_T(obj, x, y, orient+_north);
-                    _renderSY_POINT_T(obj, x, y, orient);
-                }
-                return TRUE;
-            }
-
-            // no centroid - compute new one
-            _computeCentroid(geo);
+            _getCentroids(geo);
 
             // compute offset
             if (0 < _centroids->len) {
@@ -2810,20 +3573,14 @@ static int       _renderSY(S52_obj *obj)
                 // scale offset
                 offset_x *= _scalex;
                 offset_y *= _scaley;
-
-                S57_newCentroid(geo);
             }
 
-            // add new centroid
             for (guint i=0; i<_centroids->len; ++i) {
                 pt3 *pt = &g_array_index(_centroids, pt3, i);
 
                 //S57_highlightON(geo);
                 //PRINTF("DEBUG: drawing centered at: %f/%f\n", pt->x, pt->y);
 
-                // save centroid
-                S57_addCentroid(geo, pt->x, pt->y);
-
                 // check if offset move the object outside pick region
                 // that symbole 'Y' axis is down, so '-offsety'
                 //_renderSY_POINT_T(obj, pt->x, pt->y, orient+_north);
@@ -3251,6 +4008,7 @@ static int       _renderLS_afterglow(S52_obj *obj)
     glUniform1f(_uGlowOn, 1.0);
 
     // vertex array - fill vbo arrays
+    ATLAS_OFF();
     glEnableVertexAttribArray(_aPosition);
     glVertexAttribPointer    (_aPosition, 3, GL_FLOAT, GL_FALSE, 0,  _tessWorkBuf_f->data);
     //_checkError("_renderLS_afterglow() .. -0.1-");
@@ -3870,57 +4628,69 @@ static int       _renderAC_LIGHTS05(S52_obj *obj)
             radius = 20.0 / S52_MP_get(S52_MAR_DOTPITCH_MM_X);    // (not 20 mm on xoom)
         }
 
-        // Note: specs say unit, assume it mean pixel
+        // first pass - create VBO
+        S52_DListData *DListData = S52_PL_getDListData(obj);
+        if ((NULL==DListData) || (0==DListData->vboIds[0])) {
+            GLBUILDLOCK;
+
+            // Note: specs say unit, assume it mean pixel
 #ifdef S52_USE_OPENGL_VBO
-        _gluQuadricDrawStyle(_qobj, GLU_FILL);
+            _gluQuadricDrawStyle(_qobj, GLU_FILL);
 #else
-        gluQuadricDrawStyle(_qobj, GLU_FILL);
+            gluQuadricDrawStyle(_qobj, GLU_FILL);
 #endif
 
-        // first pass - create VBO
-        S52_DListData *DListData = S52_PL_getDListData(obj);
-        if (NULL == DListData) {
-            DListData = S52_PL_newDListData(obj);
-            DListData->nbr        =  2;
-            DListData->crntPalIDX = -1;
-        }
+            // other context might have create it
+            DListData = S52_PL_getDListData(obj);
+            if (NULL == DListData) {
+                DListData = S52_PL_newDListData(obj);
+                DListData->nbr        =  2;
+                DListData->crntPalIDX = -1;
+            }
 
-        //if (FALSE == glIsBuffer(DList->vboIds[0])) {
-        if (0 == DListData->vboIds[0]) {
-            DListData->prim[0] = S57_initPrim(NULL);
-            DListData->prim[1] = S57_initPrim(NULL);
+            //if (FALSE == glIsBuffer(DList->vboIds[0])) {
+            if (0 == DListData->vboIds[0]) {
+                DListData->prim[0] = S57_initPrim(NULL);
+                DListData->prim[1] = S57_initPrim(NULL);
 
-            DListData->colors[0] = *black;
-            DListData->colors[1] = *c;
+                DListData->colors[0] = *black;
+                DListData->colors[1] = *c;
 
 #ifdef S52_USE_OPENGL_VBO
-            _diskPrimTmp = DListData->prim[0];
-            _gluPartialDisk(_qobj, radius, radius+4, sweep/2.0, loops, sectr1+180, sweep);
-            DListData->vboIds[0] = _VBOCreate(_diskPrimTmp);
+                _diskPrimTmp = DListData->prim[1];
+                _gluPartialDisk(_qobj, radius+1, radius+3, sweep/2.0, loops, sectr1+180, sweep);
+                DListData->vboIds[1] = _VBOCreate(_diskPrimTmp);
 
-            _diskPrimTmp = DListData->prim[1];
-            _gluPartialDisk(_qobj, radius+1, radius+3, sweep/2.0, loops, sectr1+180, sweep);
-            DListData->vboIds[1] = _VBOCreate(_diskPrimTmp);
-#else
-            // black sector
-            DListData->vboIds[0] = glGenLists(1);
-            glNewList(DListData->vboIds[0], GL_COMPILE);
-
-            _diskPrimTmp = DListData->prim[0];
-            gluPartialDisk(_qobj, radius, radius+4, sweep/2.0, loops, sectr1+180, sweep);
-            _DrawArrays(_diskPrimTmp);
-            glEndList();
+                _diskPrimTmp = DListData->prim[0];
+                _gluPartialDisk(_qobj, radius, radius+4, sweep/2.0, loops, sectr1+180, sweep);
+                guint vboId0 = _VBOCreate(_diskPrimTmp);
 
-            // color sector
-            DListData->vboIds[1] = glGenLists(1);
-            glNewList(DListData->vboIds[1], GL_COMPILE);
-
-            _diskPrimTmp = DListData->prim[1];
-            gluPartialDisk(_qobj, radius+1, radius+3, sweep/2.0, loops, sectr1+180, sweep);
-            _DrawArrays(_diskPrimTmp);
-            glEndList();
+                // [0] last - the VBO are complete for the other context
+                GLBUILDFLUSH;
+                DListData->vboIds[0] = vboId0;
+#else
+                // black sector
+                DListData->vboIds[0] = glGenLists(1);
+                glNewList(DListData->vboIds[0], GL_COMPILE);
+
+                _diskPrimTmp = DListData->prim[0];
+                gluPartialDisk(_qobj, radius, radius+4, sweep/2.0, loops, sectr1+180, sweep);
+                _DrawArrays(_diskPrimTmp);
+                glEndList();
+
+                // color sector
+                DListData->vboIds[1] = glGenLists(1);
+                glNewList(DListData->vboIds[1], GL_COMPILE);
+
+                _diskPrimTmp = DListData->prim[1];
+                gluPartialDisk(_qobj, radius+1, radius+3, sweep/2.0, loops, sectr1+180, sweep);
+                _DrawArrays(_diskPrimTmp);
+                glEndList();
 #endif
-            _diskPrimTmp = NULL;
+                _diskPrimTmp = NULL;
+            }
+
+            GLBUILDUNLOCK;
         }
 
         //_setBlend(TRUE);
@@ -3956,6 +4726,9 @@ static int       _renderAC_VRMEBL01(S52_obj *obj)
     if (FALSE == S57_getGeoData(geo, 0, &npt, &ppt))
         return FALSE;
 
+    // Note: the prim is rebuilt at each frame - one context at a time
+    GLBUILDLOCK;
+
     S52_DListData *DListData = S52_PL_getDListData(obj);
     if (NULL == DListData) {
         DListData = S52_PL_newDListData(obj);
@@ -3991,8 +4764,11 @@ static int       _renderAC_VRMEBL01(S52_obj *obj)
     guint     vertNbr = 0;
     guint     DList   = 0;
 
-    if (FALSE == S57_getPrimData(_diskPrimTmp, &primNbr, &vert, &vertNbr, &DList))
+    if (FALSE == S57_getPrimData(_diskPrimTmp, &primNbr, &vert, &vertNbr, &DList)) {
+        _diskPrimTmp = NULL;
+        GLBUILDUNLOCK;
         return FALSE;
+    }
 
     //_setBlend(TRUE);
 
@@ -4014,6 +4790,7 @@ static int       _renderAC_VRMEBL01(S52_obj *obj)
 
     _diskPrimTmp = NULL;
 
+    GLBUILDUNLOCK;
 
     //_setBlend(FALSE);
 
@@ -4118,6 +4895,7 @@ static int       _renderAP_NODATA_layer0(void)
         pt3.x, pt3.y, 0.0,        n_tile_x, 0.0f
     };
 
+    ATLAS_OFF();
     glEnableVertexAttribArray(_aUV);
     glVertexAttribPointer(_aUV, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), &ppt[3]);
 
@@ -4333,53 +5111,71 @@ static int       _renderTXTAA(S52_obj *obj, S52_Color *color, double x, double y
 
     if ((NULL!=obj) && (S52_GL_DRAW==_crnt_GL_cycle)) {
         GLuint vboID = S52_PL_getFreetypeGL_VBO(obj, &len, &strWpx, &strHpx, &hjust, &vjust);
-        if (0 != vboID) {
-        //if (GL_TRUE == glIsBuffer(vboID)) {
-            // connect to data in VBO on GPU
-            glBindBuffer(GL_ARRAY_BUFFER, vboID);
-        } else {
-            //_freetype_gl_buffer = _fill_freetype_gl_buffer(_freetype_gl_buffer, str, weight, &strWpx, &strHpx);
-            _freetype_gl_buffer = _fill_freetype_gl_buffer(_freetype_gl_buffer, str, bsize, &strWpx, &strHpx);
-            if (0 == _freetype_gl_buffer->len)
-                return TRUE;
-            else
-                len = _freetype_gl_buffer->len;
-
-            glGenBuffers(1, &vboID);
-
-            // glIsBuffer() fail!
+        if (0 == vboID) {
+            GLBUILDLOCK;
+            // other context might have upload it
+            vboID = S52_PL_getFreetypeGL_VBO(obj, &len, &strWpx, &strHpx, &hjust, &vjust);
             if (0 == vboID) {
-                PRINTF("ERROR: glGenBuffers() fail\n");
-                g_assert(0);
-                return FALSE;
-            }
+                //_freetype_gl_buffer = _fill_freetype_gl_buffer(_freetype_gl_buffer, str, weight, &strWpx, &strHpx);
+                _freetype_gl_buffer = _fill_freetype_gl_buffer(_freetype_gl_buffer, str, bsize, &strWpx, &strHpx);
+                if (0 == _freetype_gl_buffer->len) {
+                    GLBUILDUNLOCK;
+                    return TRUE;
+                } else
+                    len = _freetype_gl_buffer->len;
 
-            S52_PL_setFreetypeGL_VBO(obj, vboID, _freetype_gl_buffer->len, strWpx, strHpx);
+                glGenBuffers(1, &vboID);
 
-            // bind VBOs for vertex array
-            glBindBuffer(GL_ARRAY_BUFFER, vboID);      // for vertex coordinates
-            // upload freetype_gl data to GPU
-            glBufferData(GL_ARRAY_BUFFER,
-                         _freetype_gl_buffer->len * sizeof(_freetype_gl_vertex_t),
-                         (const void *)_freetype_gl_buffer->data,
-                         GL_STATIC_DRAW);
+                // glIsBuffer() fail!
+                if (0 == vboID) {
+                    PRINTF("ERROR: glGenBuffers() fail\n");
+                    g_assert(0);
+                    GLBUILDUNLOCK;
+                    return FALSE;
+                }
+
+                // bind VBOs for vertex array
+                ATLAS_OFF();
+                glBindBuffer(GL_ARRAY_BUFFER, vboID);      // for vertex coordinates
+                // upload freetype_gl data to GPU
+                glBufferData(GL_ARRAY_BUFFER,
+                             _freetype_gl_buffer->len * sizeof(_freetype_gl_vertex_t),
+                             (const void *)_freetype_gl_buffer->data,
+                             GL_STATIC_DRAW);
+
+                // last - the VBO is complete for the other context
+                GLBUILDFLUSH;
+                S52_PL_setFreetypeGL_VBO(obj, vboID, _freetype_gl_buffer->len, strWpx, strHpx);
+                g_atomic_int_inc(&_memGen);
+            }
+            GLBUILDUNLOCK;
         }
+
+        //if (GL_TRUE == glIsBuffer(vboID)) {
+        // connect to data in VBO on GPU
+        ATLAS_OFF();
+        glBindBuffer(GL_ARRAY_BUFFER, vboID);
     }
 
     //
     // update dynamique str dim.
     //
 
+    // Note: glyph not in the atlas cache are added to the shared atlas
     // dynamique text - layer 9
     if (S52_GL_LAST == _crnt_GL_cycle) {
         //_freetype_gl_buffer = _fill_freetype_gl_buffer(_freetype_gl_buffer, str, weight, &strWpx, &strHpx);
+        GLBUILDLOCK;
         _freetype_gl_buffer = _fill_freetype_gl_buffer(_freetype_gl_buffer, str, bsize, &strWpx, &strHpx);
+        GLBUILDUNLOCK;
     }
 
     // lone text - S52_GL_drawStr() / S52_GL_drawStrWorld()
     if (S52_GL_NONE == _crnt_GL_cycle) {
         //_freetype_gl_buffer = _fill_freetype_gl_buffer(_freetype_gl_buffer, str, weight, &strWpx, &strHpx);
+        GLBUILDLOCK;
         _freetype_gl_buffer = _fill_freetype_gl_buffer(_freetype_gl_buffer, str, bsize, &strWpx, &strHpx);
+        GLBUILDUNLOCK;
     }
 
     /* debug: draw all text sans just. Change color to DNGHL
@@ -4490,9 +5286,6 @@ static int       _renderTXTAA(S52_obj *obj, S52_Color *color, double x, double y
 #ifdef S52_USE_FTGL
     (void)obj;
 
-    double n = _view.north;
-    _view.north = 0.0;
-
     _setFragAttrib(color, FALSE);
 
     //_setBlend(FALSE);
@@ -4501,7 +5294,7 @@ static int       _renderTXTAA(S52_obj *obj, S52_Color *color, double x, double y
     projUV p = {x, y};
     p = _prj2win(p);
 
-    _glMatrixSet(VP_WIN);    // new - set win coord
+    _glMatrixSetRot(VP_WIN, 0.0);    // new - set win coord
 
     //glRasterPos2i(p.u, p.v);  // round to pixels
     glRasterPos2d(p.u, p.v);
@@ -4514,8 +5307,6 @@ static int       _renderTXTAA(S52_obj *obj, S52_Color *color, double x, double y
     _glMatrixDel(VP_WIN);
 
     _checkError("_renderTXTAA() / POINT_T");
-
-    _view.north = n;
 #endif // S52_USE_FTGL
 
 
@@ -4703,7 +5494,7 @@ static int       _renderTXT(S52_obj *obj)
 
     if (S57_AREAS_T == S57_getObjtype(geo)) {
 
-        _computeCentroid(geo);
+        _getCentroids(geo);
 
         for (guint i=0; i<_centroids->len; ++i) {
             pt3 *pt = &g_array_index(_centroids, pt3, i);
@@ -5129,7 +5920,9 @@ static GLint     _buildPatternDL(gpointer key, gpointer value, gpointer data)
 #ifdef S52_USE_OPENGL_VBO
     // using VBO we need to keep some info (mode, first, count)
     DListData->prim[0]   = _parseHPGL(vecObj, DListData->prim[0]);
+#ifndef S52_USE_SYM_ATLAS
     DListData->vboIds[0] = _VBOCreate(DListData->prim[0]);
+#endif
 
     // set normal mode
     //glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -5220,7 +6013,9 @@ static GLint     _buildSymbDL(gpointer key, gpointer value, gpointer data)
     for (guint i=0; i<DListData->nbr; ++i) {
         // using VBO we need to keep some info (mode, first, count)
         DListData->prim[i]   = _parseHPGL(vecObj, DListData->prim[i]);
+#ifndef S52_USE_SYM_ATLAS
         DListData->vboIds[i] = _VBOCreate(DListData->prim[i]);
+#endif
     }
     // return to normal mode
     //glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -5243,29 +6038,103 @@ static GLint     _buildSymbDL(gpointer key, gpointer value, gpointer data)
     return 0; // 0 continue traversing
 }
 
-static GLint     _createSymb(void)
+#ifdef S52_USE_SYM_ATLAS
+static GLint     _addSymbAtlas(gpointer key, gpointer value, gpointer data)
+// append vertex of each sub-list of this symbol to the atlas
 {
-    if (TRUE == _symbCreated)
-        return TRUE;
-
-    // FIXME: what if the ViewPort is to small !?
+    (void) key;
+    (void) data;
 
-    _glMatrixSet(VP_WIN);
+    S52_symDef    *symDef    = (S52_symDef*)value;
+    S52_DListData *DListData = S52_PL_getDLData(symDef);
 
-    S52_PL_traverse(S52_SMB_PATT, _buildPatternDL);
-    PRINTF("NOTE: PATT symbol finish\n");
+    for (guint i=0; i<DListData->nbr; ++i) {
+        guint     primNbr = 0;
+        vertex_t *vert    = NULL;
+        guint     vertNbr = 0;
+        guint     vboID   = 0;
 
-    S52_PL_traverse(S52_SMB_LINE, _buildSymbDL);
+        if (FALSE == S57_getPrimData(DListData->prim[i], &primNbr, &vert, &vertNbr, &vboID)) {
+            PRINTF("WARNING: no prim for sub-list %i\n", i);
+            g_assert(0);
+            return FALSE;
+        }
+
+        DListData->atlasOff[i] = _symbAtlasTmp->len / 3;
+        g_array_append_vals(_symbAtlasTmp, vert, vertNbr*3);
+    }
+
+    DListData->atlas = TRUE;
+
+    return 0;  // 0 continue traversing
+}
+
+static GLint     _buildSymbAtlas(void)
+// pack all PLib symbol / pattern in one VBO - sub-list are at DListData->atlasOff[]
+{
+    _symbAtlasTmp = g_array_new(FALSE, FALSE, sizeof(vertex_t));
+
+    S52_PL_traverse(S52_SMB_PATT, _addSymbAtlas);
+    S52_PL_traverse(S52_SMB_LINE, _addSymbAtlas);
+    S52_PL_traverse(S52_SMB_SYMB, _addSymbAtlas);
+
+    if (0 == _symbAtlasVBO)
+        glGenBuffers(1, &_symbAtlasVBO);
+
+    ATLAS_OFF();
+    glBindBuffer(GL_ARRAY_BUFFER, _symbAtlasVBO);
+    glBufferData(GL_ARRAY_BUFFER, _symbAtlasTmp->len*sizeof(vertex_t), (const void *)_symbAtlasTmp->data, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    PRINTF("NOTE: symbol atlas: %i vertex\n", _symbAtlasTmp->len / 3);
+
+    g_array_free(_symbAtlasTmp, TRUE);
+    _symbAtlasTmp = NULL;
+
+    _checkError("_buildSymbAtlas()");
+
+    return TRUE;
+}
+#endif  // S52_USE_SYM_ATLAS
+
+static GLint     _createSymb(void)
+{
+    if (TRUE == g_atomic_int_get(&_symbCreated))
+        return TRUE;
+
+    GLBUILDLOCK;
+    // other context might have create them
+    if (TRUE == _symbCreated) {
+        GLBUILDUNLOCK;
+        return TRUE;
+    }
+
+    // FIXME: what if the ViewPort is to small !?
+
+    _glMatrixSet(VP_WIN);
+
+    S52_PL_traverse(S52_SMB_PATT, _buildPatternDL);
+    PRINTF("NOTE: PATT symbol finish\n");
+
+    S52_PL_traverse(S52_SMB_LINE, _buildSymbDL);
     PRINTF("NOTE: LINE symbol finish\n");
 
     S52_PL_traverse(S52_SMB_SYMB, _buildSymbDL);
     PRINTF("NOTE: SYMB symbol finish\n");
 
+#ifdef S52_USE_SYM_ATLAS
+    _buildSymbAtlas();
+#endif
+
     _glMatrixDel(VP_WIN);
 
     _checkError("_createSymb()");
 
-    _symbCreated = TRUE;
+    // last - the symbol are complete for the other context
+    GLBUILDFLUSH;
+    g_atomic_int_set(&_symbCreated, TRUE);
+
+    GLBUILDUNLOCK;
 
     PRINTF("DEBUG: PLib sym created ..\n");
 
@@ -5313,6 +6182,21 @@ int        S52_GL_isSupp(S52_obj *obj)
     return FALSE;
 }
 
+#ifdef S52_USE_SCAMIN_BIN
+double     S52_GL_getSCAMIN(void)
+{
+    return _SCAMIN;
+}
+
+int        S52_GL_addSupp(guint n)
+// stat - n obj suppressed by SCAMIN but not passed to S52_GL_isSupp()
+{
+    _oclip += n;
+
+    return TRUE;
+}
+#endif
+
 int        S52_GL_isOFFview(S52_obj *obj)
 // TRUE if object not in view
 {
@@ -5451,7 +6335,7 @@ static int       _udtTexture(S52_GL_ras *raster)
     return TRUE;
 }
 
-int        S52_GL_drawRaster(S52_GL_ras *raster)
+static int       _drawRaster(S52_GL_ras *raster)
 {
     // bailout if not in view
     // FIXME: crossing of anti-meridian
@@ -5459,6 +6343,8 @@ int        S52_GL_drawRaster(S52_GL_ras *raster)
         return TRUE;
     }
 
+    TQ_MARK(TQ_RASTER, 0, 0);
+
 #ifdef S52_USE_RADAR
     // get user radar texture
     if (TRUE == raster->isRADAR) {
@@ -5602,6 +6488,7 @@ int        S52_GL_drawRaster(S52_GL_ras *raster)
     // FIXME: need this for bathy
     glDisable(GL_CULL_FACE);
 
+    ATLAS_OFF();
     glEnableVertexAttribArray(_aUV);
     glVertexAttribPointer    (_aUV, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), &ppt[3]);
 
@@ -5629,6 +6516,16 @@ int        S52_GL_drawRaster(S52_GL_ras *raster)
 
     return TRUE;
 }
+
+int        S52_GL_drawRaster(S52_GL_ras *raster)
+// Note: raster texture and RADAR image are shared by the context - one at a time
+{
+    GLBUILDLOCK;
+    int ret = _drawRaster(raster);
+    GLBUILDUNLOCK;
+
+    return ret;
+}
 #endif  // S52_USE_RASTER
 #endif  // S52_USE_GL2
 
@@ -5643,7 +6540,7 @@ int        S52_GL_drawText(S52_obj *obj, gpointer user_data)
     while (S52_CMD_NONE != cmdWrd) {
         switch (cmdWrd) {
             case S52_CMD_TXT_TX:
-            case S52_CMD_TXT_TE: _ncmd++; _renderTXT(obj); break;
+            case S52_CMD_TXT_TE: TQ_MARK(TQ_TEXT, 0, 0); _ncmd++; _renderTXT(obj); break;
 
             default: break;
         }
@@ -5709,11 +6606,11 @@ int        S52_GL_draw(S52_obj *obj, gpointer user_data)
             case S52_CMD_TXT_TX:
             case S52_CMD_TXT_TE: break;   // TE&TX
 
-            case S52_CMD_SYM_PT: _renderSY(obj); _ncmd++; break;   // SY
-            case S52_CMD_SIM_LN: _renderLS(obj); _ncmd++; break;   // LS
-            case S52_CMD_COM_LN: _renderLC(obj); _ncmd++; break;   // LC
-            case S52_CMD_ARE_CO: _renderAC(obj); _ncmd++; break;   // AC
-            case S52_CMD_ARE_PA: _renderAP(obj); _ncmd++; break;   // AP
+            case S52_CMD_SYM_PT: TQ_MARK(TQ_OBJ, S52_PL_getDPRI(obj), S52_GL_TQ_SY); _renderSY(obj); _ncmd++; break;   // SY
+            case S52_CMD_SIM_LN: TQ_MARK(TQ_OBJ, S52_PL_getDPRI(obj), S52_GL_TQ_LS); _renderLS(obj); _ncmd++; break;   // LS
+            case S52_CMD_COM_LN: TQ_MARK(TQ_OBJ, S52_PL_getDPRI(obj), S52_GL_TQ_LC); _renderLC(obj); _ncmd++; break;   // LC
+            case S52_CMD_ARE_CO: TQ_MARK(TQ_OBJ, S52_PL_getDPRI(obj), S52_GL_TQ_AC); _renderAC(obj); _ncmd++; break;   // AC
+            case S52_CMD_ARE_PA: TQ_MARK(TQ_OBJ, S52_PL_getDPRI(obj), S52_GL_TQ_AP); _renderAP(obj); _ncmd++; break;   // AP
 
             // trap CS call that have not been resolve
             case S52_CMD_CND_SY: _traceCS(obj); break;   // CS
@@ -5773,10 +6670,8 @@ int        S52_GL_drawBlit(double scale_x, double scale_y, double scale_z, doubl
     //_renderAC_NODATA_layer0(); nop!
     // WRAP_S/T GL_REPEAT - nop!
 
-    // set rotation (via _glMatrixSet())
-    double northtmp = _view.north;
-    _view.north = north;
-    _glMatrixSet(VP_PRJ);
+    // blit rotation
+    _glMatrixSetRot(VP_PRJ, north);
 
     glBindTexture(GL_TEXTURE_2D, _fb_pixels_id);
 
@@ -5791,6 +6686,7 @@ int        S52_GL_drawBlit(double scale_x, double scale_y, double scale_z, doubl
         _pmax.u, _pmin.v, 0.0,   1.0 + scale_x - scale_z, 0.0 + scale_y + scale_z
     };
 
+    ATLAS_OFF();
     glEnableVertexAttribArray(_aUV);
     glVertexAttribPointer    (_aUV,       2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), &ppt[3]);
 
@@ -5818,8 +6714,6 @@ int        S52_GL_drawBlit(double scale_x, double scale_y, double scale_z, doubl
 
     _glMatrixDel(VP_PRJ);
 
-    _view.north = northtmp;
-
     _checkError("S52_GL_drawBlit()");
 
     return TRUE;
@@ -5944,14 +6838,11 @@ static int       _drawFBPixels(void)
     // debug
     //PRINTF("VP: %i, %i, %i, %i\n", _vp[0], _vp[1], _vp[2], _vp[3]);
 
-    // set rotation temporatly to 0.0 (via _glMatrixSet())
-    double northtmp = _view.north;
-    _view.north = 0.0;
-
+    // Note: FB copy is drawn unrotated (rotation 0.0)
     glBindTexture(GL_TEXTURE_2D, _fb_pixels_id);
 
 #ifdef S52_USE_GL2
-    _glMatrixSet(VP_PRJ);
+    _glMatrixSetRot(VP_PRJ, 0.0);
 
     // turn ON 'sampler2d'
     glUniform1f(_uBlitOn, 1.0);
@@ -5963,6 +6854,7 @@ static int       _drawFBPixels(void)
         _pmax.u, _pmin.v, 0.0,   1.0, 0.0
     };
 
+    ATLAS_OFF();
     glEnableVertexAttribArray(_aUV);
     glVertexAttribPointer    (_aUV,       2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), &ppt[3]);
 
@@ -5985,7 +6877,7 @@ static int       _drawFBPixels(void)
 
 #else   // S52_USE_GL2
 
-    _glMatrixSet(VP_WIN);
+    _glMatrixSetRot(VP_WIN, 0.0);
     glRasterPos2i(0, 0);
 
     // parameter must be in sync with glReadPixels()
@@ -6002,8 +6894,6 @@ static int       _drawFBPixels(void)
 
     _checkError("S52_GL_drawFBPixels() -fini-");
 
-    _view.north = northtmp;
-
     return TRUE;
 }
 
@@ -6076,6 +6966,108 @@ static int       _doProjection(vp_t vp, double centerLat, double centerLon, doub
     return TRUE;
 }
 
+static int       _initFBtex(void)
+// setup texture to save FB to - one per GL context
+{
+    glGenTextures(1, &_fb_pixels_id);
+    glBindTexture  (GL_TEXTURE_2D, _fb_pixels_id);
+
+#ifdef S52_USE_TEGRA2
+    // Note: _fb_pixels must be in sync with _fb_format
+    glTexImage2D   (GL_TEXTURE_2D, 0, GL_RGBA, _vp.w, _vp.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    // modern way
+    //_glTexStorage2DEXT (GL_TEXTURE_2D, 0, GL_RGBA, _vp.w, _vp.h);
+    //glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _vp.w, _vp.h, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+#else
+#ifdef S52_USE_GLSC2
+    // modern way
+    glTexStorage2D (GL_TEXTURE_2D, 0, GL_RGB, _vp.w, _vp.h);
+#else
+    // old way
+    glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 0, 0, _vp.w, _vp.h, 0);
+    // modern way
+    //_glTexStorage2DEXT (GL_TEXTURE_2D, 0, GL_RGB, _vp.w, _vp.h);
+#endif
+#endif
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,     GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,     GL_CLAMP_TO_EDGE);
+    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,     GL_REPEAT);
+    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,     GL_REPEAT);
+
+    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glBindTexture  (GL_TEXTURE_2D, 0);
+
+    return TRUE;
+}
+
+static int       _initCtx(void)
+// state of the current context - at the first S52_GL_begin() of a context
+{
+    // tmp buffer
+    if (NULL == _tmpWorkBuffer)
+        _tmpWorkBuffer = g_array_new(FALSE, FALSE, sizeof(vertex_t)*3);
+    if (NULL == _centroids)
+        _centroids     = g_array_new(FALSE, FALSE, sizeof(double)*3);
+
+#ifdef S52_USE_GL2
+    if (NULL == _tessWorkBuf_f)
+        _tessWorkBuf_f = g_array_new(FALSE, FALSE, sizeof(float)*3);
+#ifdef S52_USE_FREETYPE_GL
+    if (NULL == _freetype_gl_buffer)
+        _freetype_gl_buffer = g_array_new(FALSE, FALSE, sizeof(_freetype_gl_vertex_t));
+#endif
+
+    if (FALSE == _initProg_gl2())
+        return FALSE;
+#endif
+
+#ifdef S52_USE_AFGLOW
+#ifdef S52_USE_GL2
+    if (NULL == _aftglwColorArr)
+        _aftglwColorArr = g_array_new(FALSE, FALSE, sizeof(float));
+#else
+    if (NULL == _aftglwColorArr)
+        _aftglwColorArr = g_array_new(FALSE, FALSE, sizeof(unsigned char));
+#endif
+
+    // init vbo for color
+    if (0 == _vboIDaftglwColrID) {
+        glGenBuffers(1, &_vboIDaftglwColrID);
+
+        // glIsBuffer() faild but _vboIDaftglwColrID is valid
+        if (0 == _vboIDaftglwColrID) {
+            PRINTF("ERROR: glGenBuffers() fail\n");
+            g_assert(0);
+            return FALSE;
+        }
+    }
+
+    // init VBO for vertex
+    if (0 == _vboIDaftglwVertID) {
+        glGenBuffers(1, &_vboIDaftglwVertID);
+
+        // glIsBuffer() failed but _vboIDaftglwVertID is valid
+        if (0 == _vboIDaftglwVertID) {
+            PRINTF("ERROR: glGenBuffers() fail\n");
+            g_assert(0);
+            return FALSE;
+        }
+    }
+#endif
+
+    // ------------
+    // setup mem buffer to save FB to
+    if (0 == _fb_pixels_id)
+        _initFBtex();
+
+    return TRUE;
+}
+
 int        S52_GL_begin(S52_GL_cycle cycle)
 {
     // GL sanity check before start of cycle
@@ -6097,15 +7089,28 @@ int        S52_GL_begin(S52_GL_cycle cycle)
     }
     _crnt_GL_cycle = cycle;
 
+    GLBUILDLOCK;
     S52_GL_init();
+    GLBUILDUNLOCK;
+
+#ifdef S52_USE_CTX
+    // new context - program, FB texture not yet in this GL context
+    _initCtx();
+#endif
+
+    TQ_BEG(cycle);
 
     // debug
     _drgare = 0;
     _depare = 0;
     _nAC    = 0;
     _nFrag  = 0;
+    _nbind  = 0;
 
     // stat
+    _nobj      = 0;
+    _ncmd      = 0;
+    _oclip     = 0;
     _ntristrip = 0;
     _ntrisfan  = 0;
     _ntris     = 0;
@@ -6199,6 +7204,16 @@ int        S52_GL_begin(S52_GL_cycle cycle)
     glDisable(GL_DITHER);
     glDisable(GL_SCISSOR_TEST);
     glDisable(GL_POLYGON_OFFSET_FILL);
+
+#ifdef S52_USE_STENCIL_FILL
+    // stencil undefined after swap - _fillAreaStencil() expect 0
+    if (0 < _stencilBits) {
+        glStencilMask(0x01);
+        glClear(GL_STENCIL_BUFFER_BIT);
+    }
+    if (S52_GL_DRAW == cycle)
+        _stencilFillNpt = S52_utils_getConfigInt(CFG_STENCIL_FILL_NPT, STENCIL_FILL_NPT);
+#endif
     //glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
     //glDisable(GL_SAMPLE_COVERAGE);
 
@@ -6206,6 +7221,10 @@ int        S52_GL_begin(S52_GL_cycle cycle)
     glUniform1i(_uSampler2d0, 0);  // default
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+#ifdef S52_USE_SYM_ATLAS
+    // the host might have bound an other buffer since the last frame
+    _atlasOn = FALSE;
+#endif
 
     _checkError("S52_GL_begin() - GL2 EnableCap");
 #endif  // S52_USE_GL2
@@ -6247,6 +7266,8 @@ int        S52_GL_begin(S52_GL_cycle cycle)
         glViewport(_vp.x, _vp.y, _vp.w, _vp.h);
 
         _doProjection(_vp, _view.cLat, _view.cLon, _view.rNM/60.0);
+
+        _setFrameView();
     }
 
     _glMatrixSet(VP_PRJ);
@@ -6254,6 +7275,11 @@ int        S52_GL_begin(S52_GL_cycle cycle)
     // then create all S52 PLib symbol
     _createSymb();
 
+#ifdef S52_USE_SW
+    // DRAW/LAST rasterised in SW from here on
+    _swBegin(_crnt_GL_cycle);
+#endif
+
     // ----- set cycle GL state --------------------------------------------------
     switch(_crnt_GL_cycle) {
 
@@ -6374,6 +7400,14 @@ int        S52_GL_end(S52_GL_cycle cycle)
     cogl_end_gl();
 #endif
 
+    // leave GL_ARRAY_BUFFER unbound to the host
+    ATLAS_OFF();
+
+#ifdef S52_USE_SW
+    // rasterise then upload to GL FB
+    _swEnd(_crnt_GL_cycle);
+#endif
+
     _glMatrixDel(VP_PRJ);
 
     // texture of FB need update
@@ -6381,6 +7415,17 @@ int        S52_GL_end(S52_GL_cycle cycle)
         _fb_pixels_udp = TRUE;
     }
 
+    // stat - keep a copy for S52_GL_getStat()
+    if (S52_GL_DRAW==_crnt_GL_cycle || S52_GL_LAST==_crnt_GL_cycle) {
+        S52_GL_stat *stat = &_stat[(S52_GL_LAST==_crnt_GL_cycle) ? 1 : 0];
+        stat->nobj  = _nobj;
+        stat->ncmd  = _ncmd;
+        stat->oclip = _oclip;
+        stat->ntris = _ntris;
+        stat->npoly = _npoly;
+        stat->nbind = _nbind;
+    }
+
     /* debug - flush / finish and blit + swap
     if (S52_GL_DRAW == _crnt_GL_cycle) {
     //if (S52_GL_LAST == _crnt_GL_cycle) {
@@ -6430,6 +7475,8 @@ int        S52_GL_end(S52_GL_cycle cycle)
 #endif
 #endif  // GL2
 
+    TQ_END(cycle);
+
     _checkError("S52_GL_end() -fini-");
 
     _crnt_GL_cycle = S52_GL_NONE;
@@ -6437,6 +7484,215 @@ int        S52_GL_end(S52_GL_cycle cycle)
     return TRUE;
 }
 
+int        S52_GL_getStat(S52_GL_cycle cycle, S52_GL_stat *stat)
+// copy stat of the last DRAW or LAST cycle
+{
+    return_if_null(stat);
+
+    if (S52_GL_DRAW!=cycle && S52_GL_LAST!=cycle)
+        return FALSE;
+
+    *stat = _stat[(S52_GL_LAST==cycle) ? 1 : 0];
+
+    return TRUE;
+}
+
+#ifdef S52_USE_GPU_TIMER
+int        S52_GL_getGPUTime(S52_GL_gpuTime *t)
+// copy the last result - FALSE if none yet
+{
+    return_if_null(t);
+
+    if (NULL==_tq || 0==_tq->res.frame)
+        return FALSE;
+
+    *t = _tq->res;
+
+    return TRUE;
+}
+#endif
+
+guint      S52_GL_getMemGen(void)
+// change each time prim or VBO are built at draw time
+{
+    return (guint)g_atomic_int_get(&_memGen);
+}
+
+gsize      S52_GL_getVBOSize(S52_obj *obj)
+// bytes uploaded to GPU for this object - 0 if no VBO
+{
+    gsize size = 0;
+
+    if (NULL == obj)
+        return 0;
+
+#ifdef S52_USE_OPENGL_VBO
+    S57_geo  *geo  = S52_PL_getGeo(obj);
+    S57_prim *prim = S57_getPrimGeo(geo);
+    if (NULL != prim) {
+        guint     primNbr = 0;
+        vertex_t *vert    = NULL;
+        guint     vertNbr = 0;
+        guint     vboID   = 0;
+
+        if (TRUE==S57_getPrimData(prim, &primNbr, &vert, &vertNbr, &vboID) && 0!=vboID)
+            size += vertNbr * sizeof(vertex_t) * 3;
+    }
+#endif
+
+#ifdef S52_USE_FREETYPE_GL
+    {
+        guint textVBOlen = 0;
+        S52_PL_getMemSize(obj, NULL, NULL, &textVBOlen);
+        size += textVBOlen * sizeof(_freetype_gl_vertex_t);
+    }
+#endif
+
+    return size;
+}
+
+gsize      S52_GL_getTexSize(void)
+// bytes of texture not own by an object (FB, glyph atlas, mask)
+{
+    gsize size = 0;
+
+    if (0 != _fb_pixels_id)
+        size += _vp.w * _vp.h * 4;
+
+#ifdef S52_USE_GL2
+    if (0 != _nodata_mask_texID) size += 32 * 32 * 4;
+    if (0 != _dottpa_mask_texID) size += 32 *  1 * 4;
+    if (0 != _dashpa_mask_texID) size += 32 *  1 * 4;
+
+#ifdef S52_USE_FREETYPE_GL
+    if (NULL != _freetype_gl_atlas)
+        size += _freetype_gl_atlas->width * _freetype_gl_atlas->height * _freetype_gl_atlas->depth;
+#endif
+#endif  // S52_USE_GL2
+
+    return size;
+}
+
+#ifdef S52_USE_RASTER
+gsize      S52_GL_getRasterSize(S52_GL_ras *raster)
+// bytes of raster texture in GPU - 0 if not uploaded yet
+{
+    _real_GL_ras *rr = (_real_GL_ras*)raster;
+
+    if (NULL==rr || 0==rr->texID)
+        return 0;
+
+    return rr->npotX * rr->npotY * 4;
+}
+#endif  // S52_USE_RASTER
+
+#ifdef S52_USE_CTX
+gpointer   S52_GL_defCtx(void)
+// context of S52_init() - own by S52GL
+{
+    return &_glcDef;
+}
+
+gpointer   S52_GL_newCtx(void)
+// new context state - copy of the current view, program and FB texture created at first S52_GL_begin()
+{
+    _GL_ctx *ctx = g_new0(_GL_ctx, 1);
+
+    // same view / last frame as the context it was copied from
+    ctx->crnt_GL_cycle = _crnt_GL_cycle;
+    ctx->view          = _view;
+    ctx->SCAMIN        = _SCAMIN;
+    ctx->scalex        = _scalex;
+    ctx->scaley        = _scaley;
+    ctx->pmin          = _pmin;
+    ctx->pmax          = _pmax;
+    ctx->gmin          = _gmin;
+    ctx->gmax          = _gmax;
+    ctx->vp            = _vp;
+    ctx->dotpitch_mm_x = _dotpitch_mm_x;
+    ctx->dotpitch_mm_y = _dotpitch_mm_y;
+    ctx->frame         = *_frame;
+    ctx->frame.view    = _view;
+
+    ctx->fb_pixels_size = _fb_pixels_size;
+    ctx->fb_pixels_udp  = TRUE;
+    if (0 != ctx->fb_pixels_size)
+        ctx->fb_pixels = g_new0(unsigned char, ctx->fb_pixels_size);
+
+    return ctx;
+}
+
+int        S52_GL_loadCtx(gpointer ctx)
+// make ctx the context of the calling thread
+{
+    return_if_null(ctx);
+
+    _glc = (_GL_ctx*)ctx;
+
+    return TRUE;
+}
+
+int        S52_GL_delCtx(gpointer ctx)
+// Note: a GL context of the share group must be current to free the FB texture
+{
+    return_if_null(ctx);
+
+    _GL_ctx *c = (_GL_ctx*)ctx;
+
+    if (&_glcDef == c) {
+        PRINTF("WARNING: default context own by S52GL\n");
+        return FALSE;
+    }
+
+    if (_glc == c)
+        _glc = &_glcDef;
+
+    if (0 != c->fb_pixels_id)
+        glDeleteTextures(1, &c->fb_pixels_id);
+#ifdef S52_USE_GL2
+#if !defined(S52_USE_GLSC2)
+    // program is shared by the share group
+    if (0 != c->programObject)
+        glDeleteProgram(c->programObject);
+#endif
+    // Note: FBO name is local to its GL context - freed with the GL context
+    if (NULL != c->tessWorkBuf_f)      g_array_free(c->tessWorkBuf_f,      TRUE);
+    if (NULL != c->freetype_gl_buffer) g_array_free(c->freetype_gl_buffer, TRUE);
+#endif
+#ifdef S52_USE_AFGLOW
+    if (NULL != c->aftglwColorArr)     g_array_free(c->aftglwColorArr,     TRUE);
+#if !defined(S52_USE_GLSC2)
+    if (0 != c->vboIDaftglwColrID) glDeleteBuffers(1, &c->vboIDaftglwColrID);
+    if (0 != c->vboIDaftglwVertID) glDeleteBuffers(1, &c->vboIDaftglwVertID);
+#endif
+#endif
+#ifdef S52_USE_GPU_TIMER
+    // same for query name
+    g_free(c->tq);
+#endif
+
+    if (NULL != c->tmpWorkBuffer) g_array_free(c->tmpWorkBuffer, TRUE);
+    if (NULL != c->centroids)     g_array_free(c->centroids,     TRUE);
+
+    g_free(c->fb_pixels);
+    g_free(c);
+
+    return TRUE;
+}
+#endif  // S52_USE_CTX
+
+static _frame_t *_getFrame(gpointer ctx)
+{
+#ifdef S52_USE_CTX
+    if (NULL != ctx)
+        return &((_GL_ctx*)ctx)->frame;
+#else
+    (void)ctx;
+#endif
+
+    return _frame;
+}
+
 int        S52_GL_delDL(S52_obj *obj)
 // delete the GL part of S57 geo object (Display List)
 // S52_obj is use only by FREETYPE_GL
@@ -6668,6 +7924,12 @@ static int       _contextValid(void)
     glGetIntegerv(GL_STENCIL_BITS, &s);
     glGetIntegerv(GL_DEPTH_BITS,   &p);
     PRINTF("NOTE: BITS:r,g,b,a,stencil,depth: %d %d %d %d %d %d\n",r,g,b,a,s,p);
+
+#ifdef S52_USE_STENCIL_FILL
+    _stencilBits = s;
+    if (0 == s)
+        PRINTF("WARNING: no stencil buffer in config - area tessellated (S52_USE_STENCIL_FILL)\n");
+#endif
     // 16 bits:mode,r,g,b,a,s: 1 5 6 5 0 8
     // 24 bits:mode,r,g,b,a,s: 1 8 8 8 0 8
 
@@ -6755,6 +8017,16 @@ static int       _contextValid(void)
             _GL_KHR_no_error = (NULL== str)? FALSE : TRUE;
         }
 
+#ifdef S52_USE_GPU_TIMER
+        {   // GL_EXT_disjoint_timer_query (GLES) / GL_ARB_timer_query (GL)
+            const char *str = g_strrstr((const char *)extensions, "GL_EXT_disjoint_timer_query");
+            if (NULL == str)
+                str = g_strrstr((const char *)extensions, "GL_ARB_timer_query");
+            PRINTF("DEBUG: GL_EXT_disjoint_timer_query / GL_ARB_timer_query %s\n", (NULL==str)? "FAILED": "OK");
+            _GL_EXT_timer_query = (NULL== str)? FALSE : TRUE;
+        }
+#endif
+
 #endif  // S52_USE_GL2
 
     }
@@ -6812,78 +8084,7 @@ int        S52_GL_init(void)
 
     //_DEBUG = TRUE;
 
-    // tmp buffer
-    if (NULL == _tmpWorkBuffer)
-        _tmpWorkBuffer = g_array_new(FALSE, FALSE, sizeof(vertex_t)*3);
-
-#ifdef S52_USE_AFGLOW
-#ifdef S52_USE_GL2
-    if (NULL == _aftglwColorArr)
-        _aftglwColorArr = g_array_new(FALSE, FALSE, sizeof(float));
-#else
-    if (NULL == _aftglwColorArr)
-        _aftglwColorArr = g_array_new(FALSE, FALSE, sizeof(unsigned char));
-#endif
-
-    // init vbo for color
-    if (0 == _vboIDaftglwColrID) {
-        glGenBuffers(1, &_vboIDaftglwColrID);
-
-        // glIsBuffer() faild but _vboIDaftglwColrID is valid
-        if (0 == _vboIDaftglwColrID) {
-            PRINTF("ERROR: glGenBuffers() fail\n");
-            g_assert(0);
-            return FALSE;
-        }
-    }
-
-    // init VBO for vertex
-    if (0 == _vboIDaftglwVertID) {
-        glGenBuffers(1, &_vboIDaftglwVertID);
-
-        // glIsBuffer() failed but _vboIDaftglwVertID is valid
-        if (0 == _vboIDaftglwVertID) {
-            PRINTF("ERROR: glGenBuffers() fail\n");
-            g_assert(0);
-            return FALSE;
-        }
-    }
-#endif
-
-    // ------------
-    // setup mem buffer to save FB to
-    glGenTextures(1, &_fb_pixels_id);
-    glBindTexture  (GL_TEXTURE_2D, _fb_pixels_id);
-
-#ifdef S52_USE_TEGRA2
-    // Note: _fb_pixels must be in sync with _fb_format
-    glTexImage2D   (GL_TEXTURE_2D, 0, GL_RGBA, _vp.w, _vp.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
-    // modern way
-    //_glTexStorage2DEXT (GL_TEXTURE_2D, 0, GL_RGBA, _vp.w, _vp.h);
-    //glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _vp.w, _vp.h, GL_RGBA, GL_UNSIGNED_BYTE, 0);
-#else
-#ifdef S52_USE_GLSC2
-    // modern way
-    glTexStorage2D (GL_TEXTURE_2D, 0, GL_RGB, _vp.w, _vp.h);
-#else
-    // old way
-    glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 0, 0, _vp.w, _vp.h, 0);
-    // modern way
-    //_glTexStorage2DEXT (GL_TEXTURE_2D, 0, GL_RGB, _vp.w, _vp.h);
-#endif
-#endif
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,     GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,     GL_CLAMP_TO_EDGE);
-    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,     GL_REPEAT);
-    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,     GL_REPEAT);
-
-    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-    glBindTexture  (GL_TEXTURE_2D, 0);
+    _initCtx();
 
 
     _doInit = FALSE;
@@ -6898,12 +8099,20 @@ int        S52_GL_done(void)
 
     _freeGLU();
 
+#ifdef S52_USE_SW
+    _swDone();
+#endif
+
     // g_clear() !
 
     if (NULL != _fb_pixels) {
         g_free(_fb_pixels);
         _fb_pixels = NULL;
     }
+    if (0 != _fb_pixels_id) {
+        glDeleteTextures(1, &_fb_pixels_id);
+        _fb_pixels_id = 0;
+    }
 
     if (NULL != _objPick) {
         // ref only
@@ -6915,6 +8124,17 @@ int        S52_GL_done(void)
         g_array_free(_tmpWorkBuffer, TRUE);
         _tmpWorkBuffer = NULL;
     }
+    if (NULL != _centroids) {
+        g_array_free(_centroids, TRUE);
+        _centroids = NULL;
+    }
+
+#ifdef S52_USE_SYM_ATLAS
+    if (0 != _symbAtlasVBO) {
+        glDeleteBuffers(1, &_symbAtlasVBO);
+        _symbAtlasVBO = 0;
+    }
+#endif
 
 #ifdef S52_USE_AFGLOW
     if (NULL != _aftglwColorArr) {
@@ -6958,6 +8178,10 @@ int        S52_GL_done(void)
     _fboID             = 0;
     _programObject     = 0;
 
+#ifdef S52_USE_GPU_TIMER
+    _tqDone();
+#endif
+
 
 #ifdef S52_USE_FREETYPE_GL
     texture_font_delete(_freetype_gl_font[0]);
@@ -7092,6 +8316,9 @@ int        S52_GL_setView(double centerLat, double centerLon, double rangeNM, do
     _view.rNM   = rangeNM;
     _view.north = north;
 
+    // query read this copy
+    _frame->view = _view;
+
     return TRUE;
 }
 
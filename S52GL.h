@@ -68,6 +68,33 @@ typedef enum S52_GL_cycle {
     S52_GL_INIT               // state before first S52_GL_DRAW
 } S52_GL_cycle;
 
+// statistic of the last S52_GL_DRAW / S52_GL_LAST cycle
+typedef struct S52_GL_stat {
+    guint nobj;               // object drawn
+    guint ncmd;               // command drawn
+    guint oclip;              // object clipped
+    guint ntris;              // area triangles sent to GPU
+    guint npoly;              // area glDrawArrays() call
+    guint nbind;              // symbol VBO bind (_glCallList()) - atlas: one per run of SY / LC / AP
+} S52_GL_stat;
+
+#ifdef S52_USE_GPU_TIMER
+// GPU time (msec) of a DRAW cycle, by display priority, command word and stage, and of the LAST cycle
+enum { S52_GL_TQ_SY, S52_GL_TQ_LS, S52_GL_TQ_LC, S52_GL_TQ_AC, S52_GL_TQ_AP, S52_GL_TQ_NCMD };
+typedef struct S52_GL_gpuTime {
+    int    isGPU;                 // TRUE timer query, FALSE CPU timestamp (GL call submission)
+    guint  frame;                 // DRAW cycle of this result (read a few cycles later)
+    double draw;                  // DRAW cycle
+    double prio[S52_PRIO_NUM];    // DRAW - object, by display priority
+    double cmd [S52_GL_TQ_NCMD];  // DRAW - object, by command word
+    double text;                  // DRAW - TE/TX
+    double raster;                // DRAW - raster / radar
+    double last;                  // LAST cycle
+    guint  overflow;              // mark dropped in the DRAW cycle (too many state change)
+    guint  dropped;               // cycle result lost (GPU too far behind, GPU disjoint)
+} S52_GL_gpuTime;
+#endif
+
 
 int   S52_GL_init(void);
 int   S52_GL_done(void);  // flush GL objects, clean up mem
@@ -90,6 +117,32 @@ int   S52_GL_drawStrWin(double pixels_x, double pixels_y, const char *colorName,
 // done frame, restore OpenGL state
 int   S52_GL_end(S52_GL_cycle cycle);
 
+// stat - counter of the last DRAW or LAST cycle
+int   S52_GL_getStat(S52_GL_cycle cycle, S52_GL_stat *stat);
+#ifdef S52_USE_GPU_TIMER
+// stat - last GPU time result
+int   S52_GL_getGPUTime(S52_GL_gpuTime *t);
+#endif
+// stat - change when prim / VBO are built at draw time (cell memory to re-walk)
+guint S52_GL_getMemGen(void);
+// stat - bytes in GPU for this object VBO (geo + text)
+gsize S52_GL_getVBOSize(S52_obj *obj);
+// stat - bytes in GPU for FB, glyph atlas and mask texture
+gsize S52_GL_getTexSize(void);
+#ifdef S52_USE_RASTER
+// stat - bytes in GPU for this raster texture
+gsize S52_GL_getRasterSize(S52_GL_ras *raster);
+#endif
+
+#ifdef S52_USE_CTX
+// context - view, viewport, program and FB copy of a chart view (see S52_newCtx())
+// Note: S52_GL_loadCtx() make ctx the context of the calling thread
+gpointer S52_GL_defCtx (void);
+gpointer S52_GL_newCtx (void);
+int      S52_GL_loadCtx(gpointer ctx);
+int      S52_GL_delCtx (gpointer ctx);
+#endif
+
 // debug
 int   S52_GL_dumpS57IDPixels(const char *toFilename, S52_obj *obj, unsigned int width, unsigned int height);
 
@@ -97,6 +150,12 @@ int   S52_GL_dumpS57IDPixels(const char *toFilename, S52_obj *obj, unsigned int
 
 int   S52_GL_isSupp(S52_obj *obj);
 int   S52_GL_isOFFview(S52_obj *obj);
+#ifdef S52_USE_SCAMIN_BIN
+// obj with a SCAMIN bellow this are suppressed by S52_GL_isSupp()
+double S52_GL_getSCAMIN(void);
+// stat - add n obj suppressed by SCAMIN (culled in bulk)
+int    S52_GL_addSupp(guint n);
+#endif
 
 // delete GL data of object (DL of geo)
 int   S52_GL_delDL(S52_obj *obj);
@@ -112,6 +171,8 @@ int   S52_GL_delRaster(S52_GL_ras *raster);
 
 int   S52_GL_setView(double  centerLat, double  centerLon, double  rangeNM, double  north);
 int   S52_GL_getView(double *centerLat, double *centerLon, double *rangeNM, double *north);
+// view of a context without switching to it (NULL - current context)
+int   S52_GL_getViewCtx(gpointer ctx, double *centerLat, double *centerLon, double *rangeNM, double *north);
 
 int   S52_GL_setPRJView(double  s, double  w, double  n, double  e);
 int   S52_GL_getPRJView(double *s, double *w, double *n, double *e);
@@ -120,6 +181,14 @@ int   S52_GL_getGEOView(double *s, double *w, double *n, double *e);
 
 int   S52_GL_win2prj(double *x, double *y);
 int   S52_GL_prj2win(double *x, double *y);
+// same as above for the view of the last frame drawn in ctx (NULL - current context)
+// no GL call, lock free (any thread)
+int   S52_GL_win2prjFrame(gpointer ctx, double *x, double *y);
+int   S52_GL_prj2winFrame(gpointer ctx, double *x, double *y);
+// batch of strided point (stride in double), in-place
+int   S52_GL_win2prjFramev(gpointer ctx, guint npt, double *x, double *y, guint stride);
+int   S52_GL_prj2winFramev(gpointer ctx, guint npt, double *x, double *y, guint stride);
+int   S52_GL_getViewPortFrame(gpointer ctx, int *x, int *y, int *width, int *height);
 
 int   S52_GL_setViewPort(int  x, int  y, int  width, int  height);
 int   S52_GL_getViewPort(int *x, int *y, int *width, int *height);
@@ -144,5 +213,7 @@ void  S52_GLU_begUnion(void);
 void  S52_GLU_addUnion(S57_geo *geo);
 //void  S52_GLU_addUnion(guint  npt, double  *ppt);
 void  S52_GLU_endUnion(guint *npt, double **ppt);
+// re-entrant: union of rings (pt3 in vertex, nbr of pt per ring in nvertex) - can be called off the GL thread
+int   S52_GLU_unionRings(GArray *vertex, GArray *nvertex, GArray *outVertex, GArray *outNvertex);
 
 #endif // _S52GL_H_
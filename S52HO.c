@@ -0,0 +1,391 @@
+// S52HO.c: HO data limit / scale boundary - incremental union of cell coverage (thread)
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Note: each union tree is a complete binary tree - cell coverage at the leaf,
+// union of the 2 children at a node, so the root is the union of all cells.
+// Setting or removing a cell redo the union on the path to the root only
+// (log2(cells) union of 2 polygons) rather than the union of all M_COVR.
+// The tree and the unions are done in a thread, the GL thread pick up
+// the last union published (see S52_HO_getGen()).
+
+
+#include "S52HO.h"
+#include "S52GL.h"      // S52_GLU_unionRings()
+#include "S57data.h"    // pt3
+#include "S52utils.h"   // PRINTF()
+
+#include <string.h>     // memset()
+
+
+typedef struct _cov {
+    gint    ref;        // shared by node (one child empty) and the published union
+    GArray *vertex;     // pt3
+    GArray *nvertex;    // guint - nbr of pt per ring
+} _cov;
+
+typedef struct _tree {
+    guint       cap;    // nbr of leaf (power of 2)
+    _cov      **node;   // [2*cap] - node[1] is the root, leaf at [cap..2*cap[
+    guint       nLeaf;  // leaf used so far
+    GHashTable *slot;   // cell --> leaf idx + 1
+    GArray     *free;   // leaf idx of removed cell
+    int         dirty;  // root changed - to be published
+} _tree;
+
+typedef struct _job {
+    int           tree;
+    gconstpointer cell;
+    _cov         *cov;  // rings of the cell (not union yet), NULL - remove cell
+} _job;
+
+static _tree        _tree_[S52_HO_TREE_NBR];    // thread only
+static _cov        *_pub[S52_HO_TREE_NBR];      // last union published - _ho_mutex
+static gint         _gen    = 0;                // atomic
+static GAsyncQueue *_queue  = NULL;             // _job
+static GThread     *_thread = NULL;
+static _job         _quit;                      // sentinel that stop _union()
+static S52_HO_pub_cb _pubCB = NULL;             // set before the thread start
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticMutex  _ho_mutex = G_STATIC_MUTEX_INIT;
+#define GMUTEXLOCK   g_static_mutex_lock
+#define GMUTEXUNLOCK g_static_mutex_unlock
+#else
+static GMutex        _ho_mutex;
+#define GMUTEXLOCK   g_mutex_lock
+#define GMUTEXUNLOCK g_mutex_unlock
+#endif
+
+
+static _cov      *_newCov(void)
+{
+    _cov *cov = g_new0(_cov, 1);
+
+    cov->ref     = 1;
+    cov->vertex  = g_array_new(FALSE, FALSE, sizeof(pt3));
+    cov->nvertex = g_array_new(FALSE, FALSE, sizeof(guint));
+
+    return cov;
+}
+
+static _cov      *_refCov(_cov *cov)
+{
+    if (NULL != cov)
+        g_atomic_int_inc(&cov->ref);
+
+    return cov;
+}
+
+static void       _unrefCov(_cov *cov)
+{
+    if ((NULL!=cov) && (TRUE==g_atomic_int_dec_and_test(&cov->ref))) {
+        g_array_free(cov->vertex,  TRUE);
+        g_array_free(cov->nvertex, TRUE);
+        g_free(cov);
+    }
+}
+
+static _cov      *_unionCov(_cov *A, _cov *B)
+// B can be NULL (leaf: union of the cell rings)
+{
+    _cov *in  = _newCov();
+    _cov *out = _newCov();
+
+    g_array_append_vals(in->vertex,  A->vertex->data,  A->vertex->len);
+    g_array_append_vals(in->nvertex, A->nvertex->data, A->nvertex->len);
+    if (NULL != B) {
+        g_array_append_vals(in->vertex,  B->vertex->data,  B->vertex->len);
+        g_array_append_vals(in->nvertex, B->nvertex->data, B->nvertex->len);
+    }
+
+    S52_GLU_unionRings(in->vertex, in->nvertex, out->vertex, out->nvertex);
+
+    _unrefCov(in);
+
+    if (0 == out->nvertex->len) {
+        _unrefCov(out);
+        return NULL;
+    }
+
+    return out;
+}
+
+static void       _updPath(_tree *t, guint idx)
+// redo union from leaf idx up to the root (leaf is the root when only one cell)
+{
+    for (idx/=2; 0<idx; idx/=2) {
+        _cov *L   = t->node[2*idx  ];
+        _cov *R   = t->node[2*idx+1];
+        _cov *cov = NULL;
+
+        if ((NULL!=L) && (NULL!=R))
+            cov = _unionCov(L, R);
+        else
+            cov = _refCov((NULL!=L) ? L : R);
+
+        _unrefCov(t->node[idx]);
+        t->node[idx] = cov;
+    }
+
+    t->dirty = TRUE;
+}
+
+static void       _grow(_tree *t)
+// double the nbr of leaf - old tree become the left subtree of the new root
+{
+    guint  cap  = (0 == t->cap) ? 1 : t->cap*2;
+    _cov **node = g_new0(_cov*, 2*cap);
+
+    // node i at depth d move to i + 2^d
+    for (guint d=1, i=1; i<2*t->cap; ++i) {
+        if (i == 2*d)
+            d = i;
+        node[i+d] = t->node[i];
+    }
+
+    // new root - right subtree empty
+    if (0 != t->cap)
+        node[1] = _refCov(node[2]);
+
+    g_free(t->node);
+    t->node = node;
+    t->cap  = cap;
+}
+
+static void       _doJob(_job *job)
+{
+    _tree *t   = &_tree_[job->tree];
+    guint  idx = GPOINTER_TO_UINT(g_hash_table_lookup(t->slot, job->cell));
+
+    if (NULL == job->cov) {
+        // remove cell
+        if (0 == idx)
+            return;
+
+        g_hash_table_remove(t->slot, job->cell);
+
+        --idx;
+        g_array_append_val(t->free, idx);
+
+        _unrefCov(t->node[t->cap + idx]);
+        t->node[t->cap + idx] = NULL;
+        _updPath(t, t->cap + idx);
+
+        return;
+    }
+
+    if (0 == idx) {
+        // new cell
+        if (0 < t->free->len) {
+            idx = g_array_index(t->free, guint, t->free->len-1);
+            g_array_set_size(t->free, t->free->len-1);
+        } else {
+            if (t->nLeaf == t->cap)
+                _grow(t);
+            idx = t->nLeaf++;
+        }
+        g_hash_table_insert(t->slot, (gpointer)job->cell, GUINT_TO_POINTER(idx+1));
+    } else {
+        --idx;
+    }
+
+    // cell coverage - cached at the leaf
+    _unrefCov(t->node[t->cap + idx]);
+    t->node[t->cap + idx] = _unionCov(job->cov, NULL);
+    _unrefCov(job->cov);
+
+    _updPath(t, t->cap + idx);
+}
+
+static void       _publish(void)
+{
+    int gen = FALSE;
+
+    GMUTEXLOCK(&_ho_mutex);
+    for (int i=0; i<S52_HO_TREE_NBR; ++i) {
+        _tree *t = &_tree_[i];
+        if (TRUE == t->dirty) {
+            _unrefCov(_pub[i]);
+            _pub[i]  = (0 == t->cap) ? NULL : _refCov(t->node[1]);
+            t->dirty = FALSE;
+            gen      = TRUE;
+        }
+    }
+    GMUTEXUNLOCK(&_ho_mutex);
+
+    if (TRUE == gen) {
+        g_atomic_int_inc(&_gen);
+
+        if (NULL != _pubCB)
+            _pubCB((guint)g_atomic_int_get(&_gen));
+    }
+}
+
+static gpointer   _union(gpointer data)
+{
+    (void)data;
+
+    int quit = FALSE;
+    while (FALSE == quit) {
+        _job *job = (_job *)g_async_queue_pop(_queue);
+
+        // do all pending job then publish once
+        while (NULL != job) {
+            if (&_quit == job) {
+                quit = TRUE;
+            } else {
+                _doJob(job);
+                g_free(job);
+            }
+            job = (_job *)g_async_queue_try_pop(_queue);
+        }
+
+        _publish();
+    }
+
+    return NULL;
+}
+
+int            S52_HO_init(S52_HO_pub_cb cb)
+{
+    if (NULL != _queue)
+        return FALSE;
+
+    _pubCB = cb;
+
+    memset(_tree_, 0, sizeof(_tree_));
+    for (int i=0; i<S52_HO_TREE_NBR; ++i) {
+        _tree_[i].slot = g_hash_table_new(g_direct_hash, g_direct_equal);
+        _tree_[i].free = g_array_new(FALSE, FALSE, sizeof(guint));
+        _pub[i]        = NULL;
+    }
+
+    _queue = g_async_queue_new();
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+    if (!g_thread_supported())
+        g_thread_init(NULL);
+    _thread = g_thread_create(_union, NULL, TRUE, NULL);
+#else
+    _thread = g_thread_new("S52HO", _union, NULL);
+#endif
+
+    return TRUE;
+}
+
+int            S52_HO_done(void)
+{
+    if (NULL == _queue)
+        return FALSE;
+
+    // stop - after pending job
+    g_async_queue_push(_queue, &_quit);
+    g_thread_join(_thread);
+    _thread = NULL;
+
+    g_async_queue_unref(_queue);
+    _queue = NULL;
+
+    for (int i=0; i<S52_HO_TREE_NBR; ++i) {
+        _tree *t = &_tree_[i];
+        for (guint j=1; j<2*t->cap; ++j)
+            _unrefCov(t->node[j]);
+        g_free(t->node);
+        g_hash_table_destroy(t->slot);
+        g_array_free(t->free, TRUE);
+
+        _unrefCov(_pub[i]);
+        _pub[i] = NULL;
+    }
+    memset(_tree_, 0, sizeof(_tree_));
+
+    return TRUE;
+}
+
+int            S52_HO_setCov(int tree, gconstpointer cell, GArray *vertex, GArray *nvertex)
+{
+    return_if_null(_queue);
+    return_if_null(vertex);
+    return_if_null(nvertex);
+
+    if ((tree<0) || (S52_HO_TREE_NBR<=tree))
+        return FALSE;
+
+    _job *job = g_new0(_job, 1);
+    job->tree = tree;
+    job->cell = cell;
+    job->cov  = _newCov();
+    g_array_append_vals(job->cov->vertex,  vertex->data,  vertex->len);
+    g_array_append_vals(job->cov->nvertex, nvertex->data, nvertex->len);
+
+    g_async_queue_push(_queue, job);
+
+    return TRUE;
+}
+
+int            S52_HO_delCov(int tree, gconstpointer cell)
+{
+    return_if_null(_queue);
+
+    if ((tree<0) || (S52_HO_TREE_NBR<=tree))
+        return FALSE;
+
+    _job *job = g_new0(_job, 1);
+    job->tree = tree;
+    job->cell = cell;
+    job->cov  = NULL;
+
+    g_async_queue_push(_queue, job);
+
+    return TRUE;
+}
+
+guint          S52_HO_getGen(void)
+{
+    return (guint)g_atomic_int_get(&_gen);
+}
+
+int            S52_HO_getUnion(int tree, GArray *vertex, GArray *nvertex)
+{
+    return_if_null(vertex);
+    return_if_null(nvertex);
+
+    if ((tree<0) || (S52_HO_TREE_NBR<=tree))
+        return FALSE;
+
+    GMUTEXLOCK(&_ho_mutex);
+    _cov *cov = _refCov(_pub[tree]);
+    GMUTEXUNLOCK(&_ho_mutex);
+
+    g_array_set_size(vertex,  0);
+    g_array_set_size(nvertex, 0);
+
+    if (NULL == cov)
+        return FALSE;
+
+    g_array_append_vals(vertex,  cov->vertex->data,  cov->vertex->len);
+    g_array_append_vals(nvertex, cov->nvertex->data, cov->nvertex->len);
+
+    _unrefCov(cov);
+
+    return TRUE;
+}
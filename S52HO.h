@@ -0,0 +1,53 @@
+// S52HO.h: HO data limit / scale boundary - incremental union of cell coverage (thread)
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _S52HO_H_
+#define _S52HO_H_
+
+#include <glib.h>       // GArray, gconstpointer
+
+// union tree
+#define S52_HO_HODATA    0   // HO data limit: M_COVR:CATCOV=1 of all cells (CS DATCVR01-2)
+                             // 1..6: scale boundary of a navigational purpose (INTU) (CS DATCVR01-3)
+#define S52_HO_TREE_NBR  7
+
+// called from the union thread after new unions are published (gen: S52_HO_getGen())
+typedef void (*S52_HO_pub_cb)(guint gen);
+
+// start / stop the union thread
+int   S52_HO_init(S52_HO_pub_cb cb);
+int   S52_HO_done(void);
+
+// set the coverage of a cell in a union tree - rings are copied
+// vertex: pt3 of all rings, nvertex: nbr of pt per ring (guint)
+int   S52_HO_setCov(int tree, gconstpointer cell, GArray *vertex, GArray *nvertex);
+// remove the coverage of a cell from a union tree
+int   S52_HO_delCov(int tree, gconstpointer cell);
+
+// change each time the thread publish new unions
+guint S52_HO_getGen(void);
+// copy the last union of a tree - CCW exterior ring, CW interior ring, not closed
+int   S52_HO_getUnion(int tree, GArray *vertex, GArray *nvertex);
+
+#endif // _S52HO_H_
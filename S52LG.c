@@ -0,0 +1,217 @@
+// S52LG.c: asynchronous logger - per-thread lock-free ring, flushed by a thread
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Note: each thread that log get its own single producer / single consumer ring
+// (the flush thread is the only consumer), so PRINTF() never take a lock nor
+// wait on I/O. A full ring drop the message, the count is logged at next flush.
+// Note: no PRINTF() here - it would recurse.
+
+#include "S52LG.h"
+
+#include <string.h>     // memset()
+
+#define RING_SZ      128            // message per thread (power of 2)
+#define FLUSH_USEC   (20 * 1000)    // flush period
+
+typedef struct _ring {
+    guint head;                     // next slot to write - producer (wrap around - unsigned)
+    guint tail;                     // next slot to read  - consumer
+    gint  drop;                     // message dropped (ring full)
+    gint  dead;                     // thread exited - freed after the last drain
+    gchar msg[RING_SZ][S52_LG_MSG_SZ];
+} _ring;
+
+static GPtrArray   *_ringList = NULL;   // all ring - _lg_mutex (never freed, ring outlive S52_LG_done())
+static GThread     *_thread   = NULL;
+static S52_LG_sink  _sink     = NULL;
+static gint         _quit     = FALSE;
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticMutex   _lg_mutex = G_STATIC_MUTEX_INIT;
+static GStaticPrivate _lgRing   = G_STATIC_PRIVATE_INIT;
+#define GMUTEXLOCK       g_static_mutex_lock
+#define GMUTEXUNLOCK     g_static_mutex_unlock
+#define RINGGET(key)     g_static_private_get(key)
+#define RINGSET(key, r)  g_static_private_set(key, r, _ringDead)
+#else
+static void           _ringDead(gpointer data);
+static GMutex         _lg_mutex;
+static GPrivate       _lgRing   = G_PRIVATE_INIT(_ringDead);
+#define GMUTEXLOCK       g_mutex_lock
+#define GMUTEXUNLOCK     g_mutex_unlock
+#define RINGGET(key)     g_private_get(key)
+#define RINGSET(key, r)  g_private_set(key, r)
+#endif
+
+static void       _ringDead(gpointer data)
+// thread exit - the flush thread free the ring once drained
+{
+    _ring *r = (_ring*) data;
+
+    g_atomic_int_set(&r->dead, TRUE);
+}
+
+static _ring     *_getRing(void)
+// ring of this thread - registered on the first message
+{
+    _ring *r = (_ring*) RINGGET(&_lgRing);
+    if (NULL != r)
+        return r;
+
+    r = g_new0(_ring, 1);
+
+    GMUTEXLOCK(&_lg_mutex);
+    g_ptr_array_add(_ringList, r);
+    GMUTEXUNLOCK(&_lg_mutex);
+
+    RINGSET(&_lgRing, r);
+
+    return r;
+}
+
+static void       _drain(_ring *r)
+// consumer side
+{
+    guint head = (guint) g_atomic_int_get((gint*)&r->head);
+    guint tail = r->tail;
+
+    for (; tail != head; ++tail)
+        _sink(r->msg[tail & (RING_SZ-1)]);
+
+    // release slot to the producer
+    g_atomic_int_set((gint*)&r->tail, (gint)tail);
+
+    gint drop = g_atomic_int_get(&r->drop);
+    if (0 != drop) {
+        gchar str[64];
+        g_snprintf(str, sizeof(str), "WARNING: log ring full, %i message dropped\n", drop);
+        _sink(str);
+        g_atomic_int_add(&r->drop, -drop);
+    }
+}
+
+static void       _drainAll(void)
+{
+    GMUTEXLOCK(&_lg_mutex);
+    for (guint i=0; i<_ringList->len; ) {
+        _ring *r    = (_ring*) g_ptr_array_index(_ringList, i);
+        int    dead = g_atomic_int_get(&r->dead);
+
+        _drain(r);
+
+        // no more producer
+        if (TRUE == dead) {
+            g_ptr_array_remove_index_fast(_ringList, i);
+            g_free(r);
+        } else {
+            ++i;
+        }
+    }
+    GMUTEXUNLOCK(&_lg_mutex);
+}
+
+static gpointer   _flush(gpointer data)
+{
+    (void)data;
+
+    while (FALSE == g_atomic_int_get(&_quit)) {
+        _drainAll();
+        g_usleep(FLUSH_USEC);
+    }
+
+    return NULL;
+}
+
+int               S52_LG_init(S52_LG_sink sink)
+{
+    if ((NULL == sink) || (NULL != _thread))
+        return FALSE;
+
+    _sink = sink;
+    g_atomic_int_set(&_quit, FALSE);
+
+    GMUTEXLOCK(&_lg_mutex);
+    if (NULL == _ringList)
+        _ringList = g_ptr_array_new();
+    GMUTEXUNLOCK(&_lg_mutex);
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+    if (!g_thread_supported())
+        g_thread_init(NULL);
+    _thread = g_thread_create(_flush, NULL, TRUE, NULL);
+#else
+    _thread = g_thread_new("S52LG", _flush, NULL);
+#endif
+
+    return TRUE;
+}
+
+int               S52_LG_done(void)
+{
+    if (NULL == _thread)
+        return FALSE;
+
+    g_atomic_int_set(&_quit, TRUE);
+    g_thread_join(_thread);
+    _thread = NULL;
+
+    // last message
+    // Note: ring of live thread stay registered (reused by the next S52_LG_init())
+    _drainAll();
+
+    return TRUE;
+}
+
+int               S52_LG_isOn(void)
+{
+    return (NULL == _thread) ? FALSE : TRUE;
+}
+
+gchar            *S52_LG_beg(void)
+// producer side - call only if S52_LG_isOn()
+{
+    if (NULL == _thread)
+        return NULL;
+
+    _ring *r = _getRing();
+    if (NULL == r)
+        return NULL;
+
+    // full
+    if (RING_SZ == (r->head - (guint) g_atomic_int_get((gint*)&r->tail))) {
+        g_atomic_int_inc(&r->drop);
+        return NULL;
+    }
+
+    return r->msg[r->head & (RING_SZ-1)];
+}
+
+void              S52_LG_end(void)
+{
+    _ring *r = (_ring*) RINGGET(&_lgRing);
+    if (NULL == r)
+        return;
+
+    // publish
+    g_atomic_int_set((gint*)&r->head, (gint)(r->head + 1));
+}
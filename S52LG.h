@@ -0,0 +1,47 @@
+// S52LG.h: asynchronous logger - per-thread lock-free ring, flushed by a thread
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _S52LG_H_
+#define _S52LG_H_
+
+#include <glib.h>       // gchar
+
+#define S52_LG_MSG_SZ   512    // max message size, including '\0' (truncated)
+
+// sink: write one message (log file, S52_log_cb, stdout) - called from the flush thread only
+typedef void (*S52_LG_sink)(const char *str);
+
+// start / stop the flush thread - stop drain all ring
+int   S52_LG_init(S52_LG_sink sink);
+int   S52_LG_done(void);
+// TRUE if the flush thread is running
+int   S52_LG_isOn(void);
+
+// reserve a message slot in the ring of the calling thread - NULL if full (message dropped)
+// write up to S52_LG_MSG_SZ char in it, then S52_LG_end() to publish
+// Note: no lock, no allocation (except the ring, on the first message of a thread)
+gchar *S52_LG_beg(void);
+void   S52_LG_end(void);
+
+#endif // _S52LG_H_
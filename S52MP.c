@@ -26,6 +26,7 @@
 #include "S52utils.h"   // PRINTF()
 
 #include <glib.h>       // TRUE, FALSE
+#include <string.h>     // memcpy(), memcmp()
 
 ///////////////////////////////////////////////////////////////////
 //
@@ -257,6 +258,13 @@ static double _MARparamVal[] = {
     51.0      // number of parameter type
 };
 
+#ifdef S52_USE_CTX
+// MP of the context of this thread (see S52_MP_loadCtx()) - _MARparamVal is the default context
+static S52_TLS double *_mpVal = _MARparamVal;
+#else
+#define _mpVal _MARparamVal
+#endif
+
 static double     _validate_bool(double val)
 {
     val = (val==0.0)? 0.0 : 1.0;
@@ -432,6 +440,64 @@ static double     _validate_positive(double val)
     return val;
 }
 
+// name of S52MarinerParameter - label in s52.cfg (see S52_MP_getID())
+// Note: designated initializer, an enum missing here is NULL (not an error)
+#define _MPNAME(id) [id] = #id
+static const char *_MARparamName[S52_MAR_NUM] = {
+    _MPNAME(S52_MAR_ERROR),
+    _MPNAME(S52_MAR_SHOW_TEXT),
+    _MPNAME(S52_MAR_TWO_SHADES),
+    _MPNAME(S52_MAR_SAFETY_CONTOUR),
+    _MPNAME(S52_MAR_SAFETY_DEPTH),
+    _MPNAME(S52_MAR_SHALLOW_CONTOUR),
+    _MPNAME(S52_MAR_DEEP_CONTOUR),
+    _MPNAME(S52_MAR_SHALLOW_PATTERN),
+    _MPNAME(S52_MAR_SHIPS_OUTLINE),
+    _MPNAME(S52_MAR_DISTANCE_TAGS),
+    _MPNAME(S52_MAR_TIME_TAGS),
+    _MPNAME(S52_MAR_FULL_SECTORS),
+    _MPNAME(S52_MAR_SYMBOLIZED_BND),
+    _MPNAME(S52_MAR_SYMPLIFIED_PNT),
+    _MPNAME(S52_MAR_DISP_CATEGORY),
+    _MPNAME(S52_MAR_COLOR_PALETTE),
+    _MPNAME(S52_MAR_VECPER),
+    _MPNAME(S52_MAR_VECMRK),
+    _MPNAME(S52_MAR_VECSTB),
+    _MPNAME(S52_MAR_HEADNG_LINE),
+    _MPNAME(S52_MAR_BEAM_BRG_NM),
+    _MPNAME(S52_MAR_FONT_SOUNDG),
+    _MPNAME(S52_MAR_DATUM_OFFSET),
+    _MPNAME(S52_MAR_SCAMIN),
+    _MPNAME(S52_MAR_ANTIALIAS),
+    _MPNAME(S52_MAR_QUAPNT01),
+    _MPNAME(S52_MAR_DISP_OVERLAP),
+    _MPNAME(S52_MAR_DISP_LAYER_LAST),
+    _MPNAME(S52_MAR_ROT_BUOY_LIGHT),
+    _MPNAME(S52_MAR_DISP_CRSR_PICK),
+    _MPNAME(S52_MAR_DISP_GRATICULE),
+    _MPNAME(S52_MAR_DISP_WHOLIN),
+    _MPNAME(S52_MAR_DISP_LEGEND),
+    _MPNAME(S52_CMD_WRD_FILTER),
+    _MPNAME(S52_MAR_DOTPITCH_MM_X),
+    _MPNAME(S52_MAR_DOTPITCH_MM_Y),
+    _MPNAME(S52_MAR_DISP_CALIB),
+    _MPNAME(S52_MAR_DISP_DRGARE_PATTERN),
+    _MPNAME(S52_MAR_DISP_NODATA_LAYER),
+    _MPNAME(S52_MAR_DISP_VESSEL_DELAY),
+    _MPNAME(S52_MAR_DISP_AFTERGLOW),
+    _MPNAME(S52_MAR_DISP_CENTROIDS),
+    _MPNAME(S52_MAR_DISP_WORLD),
+    _MPNAME(S52_MAR_DISP_RND_LN_END),
+    _MPNAME(S52_MAR_DISP_VRMEBL_LABEL),
+    _MPNAME(S52_MAR_DISP_RADAR_LAYER),
+    _MPNAME(S52_MAR_GUARDZONE_BEAM),
+    _MPNAME(S52_MAR_GUARDZONE_LENGTH),
+    _MPNAME(S52_MAR_GUARDZONE_ALARM),
+    _MPNAME(S52_MAR_DISP_HODATA_UNION),
+    _MPNAME(S52_MAR_DISP_SCLBDY_UNION),
+};
+#undef _MPNAME
+
 static int        _fixme(S52MarinerParameter paramName)
 {
     PRINTF("FIXME: S52MarinerParameter %i not implemented\n", paramName);
@@ -445,12 +511,12 @@ double S52_MP_get(S52MarinerParameter paramID)
 {
     //if (param<S52_MAR_ERROR || S52_MAR_NUM<=param) {
     if (S52_MAR_ERROR<=paramID && paramID<S52_MAR_NUM) {
-        return _MARparamVal[paramID];
+        return _mpVal[paramID];
     } else {
         PRINTF("WARNING: param invalid(%f)\n", paramID);
         g_assert(0);
 
-        return _MARparamVal[S52_MAR_ERROR];
+        return _mpVal[S52_MAR_ERROR];
     }
 
 }
@@ -536,7 +602,7 @@ int    S52_MP_set(S52MarinerParameter paramID, double val)
     }
 
     if (S52_MAR_ERROR<=paramID && paramID<S52_MAR_NUM) {
-        _MARparamVal[paramID] = val;
+        _mpVal[paramID] = val;
 
         return TRUE;
     } else {
@@ -567,6 +633,27 @@ static unsigned int _textDisp[TEXT_IDX_MAX] = {
     1,1,1,1,1,1,1,1,1,1    // 90 - 99 future requirements (AIS etc.)
 };
 
+#ifdef S52_USE_CTX
+// text display of the context of this thread - _textDisp is the default context
+static S52_TLS unsigned int *_mpText = _textDisp;
+#else
+#define _mpText _textDisp
+#endif
+
+S52MarinerParameter S52_MP_getID(const char *name)
+// return paramID of name (ex "S52_MAR_SAFETY_CONTOUR"), S52_MAR_ERROR if unknown
+{
+    if (NULL == name)
+        return S52_MAR_ERROR;
+
+    for (int i=1; i<S52_MAR_NUM; ++i) {
+        if ((NULL!=_MARparamName[i]) && (0==g_strcmp0(_MARparamName[i], name)))
+            return (S52MarinerParameter)i;
+    }
+
+    return S52_MAR_ERROR;
+}
+
 int    S52_MP_setTextDisp(unsigned int prioIdx, unsigned int count, unsigned int state)
 {
     state = _validate_bool(state);
@@ -587,7 +674,7 @@ int    S52_MP_setTextDisp(unsigned int prioIdx, unsigned int count, unsigned int
     }
 
     for (guint i=0; i<count; ++i)
-        _textDisp[prioIdx + i] = state;
+        _mpText[prioIdx + i] = state;
 
     return TRUE;
 }
@@ -595,7 +682,117 @@ int    S52_MP_setTextDisp(unsigned int prioIdx, unsigned int count, unsigned int
 int    S52_MP_getTextDisp(unsigned int prioIdx)
 {
     if (prioIdx < TEXT_IDX_MAX)
-        return _textDisp[prioIdx];
+        return _mpText[prioIdx];
     else
         return -1;
 }
+
+#ifdef S52_USE_CTX
+// Mariners' Parameter and text display of a context (see S52_newCtx())
+// Note: set by the writer of the context, read by its drawing thread and query (reader lock held)
+typedef struct _MP_ctx {
+    double       *MARparamVal;
+    unsigned int *textDisp;
+} _MP_ctx;
+
+static _MP_ctx _mpDef = {_MARparamVal, _textDisp};   // default context - the globals
+
+gpointer S52_MP_defCtx(void)
+{
+    return &_mpDef;
+}
+
+gpointer S52_MP_newCtx(void)
+// new context - copy of the MP of the context of this thread
+{
+    _MP_ctx *ctx = g_new0(_MP_ctx, 1);
+
+    ctx->MARparamVal = g_new(double,       G_N_ELEMENTS(_MARparamVal));
+    ctx->textDisp    = g_new(unsigned int, TEXT_IDX_MAX);
+    memcpy(ctx->MARparamVal, _mpVal,  sizeof(_MARparamVal));
+    memcpy(ctx->textDisp,    _mpText, sizeof(_textDisp));
+
+    return ctx;
+}
+
+int    S52_MP_loadCtx(gpointer ctx)
+// ctx become the context of this thread
+// Note: CS depend only on the MP of S52_MP_getCSKey()
+{
+    return_if_null(ctx);
+
+    _MP_ctx *c = (_MP_ctx*)ctx;
+
+    _mpVal  = c->MARparamVal;
+    _mpText = c->textDisp;
+
+    return TRUE;
+}
+
+int    S52_MP_delCtx(gpointer ctx)
+{
+    return_if_null(ctx);
+
+    _MP_ctx *c = (_MP_ctx*)ctx;
+
+    if (&_mpDef == c)
+        return FALSE;
+
+    // this thread fall back to the default context
+    if (c->MARparamVal == _mpVal)
+        S52_MP_loadCtx(&_mpDef);
+
+    g_free(c->MARparamVal);
+    g_free(c->textDisp);
+    g_free(c);
+
+    return TRUE;
+}
+
+// Mariners' Parameter that CS depend on (see _APP_CS in S52_setMarinerParam())
+static const S52MarinerParameter _CSparam[S52_MP_CSKEY_NUM] = {
+    S52_MAR_SAFETY_DEPTH,    S52_MAR_SHALLOW_CONTOUR, S52_MAR_TWO_SHADES,   S52_MAR_SHALLOW_PATTERN,
+    S52_MAR_SYMBOLIZED_BND,  S52_MAR_SAFETY_CONTOUR,  S52_MAR_DEEP_CONTOUR, S52_MAR_DATUM_OFFSET
+};
+
+int    S52_MP_getCSKey(double key[S52_MP_CSKEY_NUM])
+{
+    return_if_null(key);
+
+    for (int i=0; i<S52_MP_CSKEY_NUM; ++i)
+        key[i] = _mpVal[_CSparam[i]];
+
+    return TRUE;
+}
+#endif  // S52_USE_CTX
+
+double S52_MP_getCtx(gpointer ctx, S52MarinerParameter paramID)
+// MP of ctx without switching to it (NULL - current)
+{
+#ifdef S52_USE_CTX
+    _MP_ctx *c = (_MP_ctx*)ctx;
+    if (NULL!=c && S52_MAR_ERROR<=paramID && paramID<S52_MAR_NUM)
+        return c->MARparamVal[paramID];
+#else
+    (void)ctx;
+#endif
+
+    return S52_MP_get(paramID);
+}
+
+int    S52_MP_getTextDispCtx(gpointer ctx, unsigned int prioIdx)
+{
+#ifdef S52_USE_CTX
+    _MP_ctx *c = (_MP_ctx*)ctx;
+    if (NULL != c) {
+        if (prioIdx < TEXT_IDX_MAX)
+            return c->textDisp[prioIdx];
+        else
+            return -1;
+    }
+#else
+    (void)ctx;
+#endif
+
+    return S52_MP_getTextDisp(prioIdx);
+}
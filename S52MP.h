@@ -27,11 +27,33 @@
 
 #include "S52.h"  // S52MarinerParameter
 
+#include <glib.h> // gpointer
+
 double S52_MP_get(S52MarinerParameter paramID);
 int    S52_MP_set(S52MarinerParameter paramID, double val);
 
+// label of s52.cfg to paramID
+S52MarinerParameter S52_MP_getID(const char *name);
+
 int    S52_MP_setTextDisp(unsigned int prioIdx, unsigned int count, unsigned int state);
 int    S52_MP_getTextDisp(unsigned int prioIdx);
 
+// read MP / text display of a context without switching to it (NULL - current)
+double S52_MP_getCtx        (gpointer ctx, S52MarinerParameter paramID);
+int    S52_MP_getTextDispCtx(gpointer ctx, unsigned int prioIdx);
+
+#ifdef S52_USE_CTX
+// context - Mariners' Parameter and text display of a chart view (see S52_newCtx())
+// Note: S52_MP_get/set() is on the context of the calling thread (S52_MP_loadCtx())
+gpointer S52_MP_defCtx (void);
+gpointer S52_MP_newCtx (void);
+int      S52_MP_loadCtx(gpointer ctx);
+int      S52_MP_delCtx (gpointer ctx);
+
+// CS key - value of the MP that CS depend on (same key, same CS)
+#define S52_MP_CSKEY_NUM 8
+int      S52_MP_getCSKey(double key[S52_MP_CSKEY_NUM]);
+#endif
+
 
 #endif //_S52MP_H_
@@ -341,6 +341,29 @@ typedef struct _S52_obj {
     _AUX_Info    auxInfo;
 } _S52_obj;
 
+#ifdef S52_USE_CTX
+// command iterator of the drawing thread - context draw the same obj at once
+// Note: iteration of an obj is never nested (S52_GL_draw() / S52_GL_drawText() / S52_PL_hasText())
+static S52_TLS GArray *_crntA    = NULL;
+static S52_TLS guint   _crntAidx = 0;
+#define CRNTA(obj)     _crntA
+#define CRNTAIDX(obj)  _crntAidx
+
+// text parsed and color refreshed at draw time - by the first context drawing the obj
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticMutex _pl_mutex = G_STATIC_MUTEX_INIT;
+#define GPLLOCK        g_static_mutex_lock
+#define GPLUNLOCK      g_static_mutex_unlock
+#else
+static GMutex       _pl_mutex;
+#define GPLLOCK        g_mutex_lock
+#define GPLUNLOCK      g_mutex_unlock
+#endif
+#else   // S52_USE_CTX
+#define CRNTA(obj)     (obj)->crntA
+#define CRNTAIDX(obj)  (obj)->crntAidx
+#endif  // S52_USE_CTX
+
 // Tables (LUP+symbology) --BBTree holder
 static gboolean _initPLib       = TRUE;  // will init PLib
 static GTree   *_table[TBL_NUM] = {NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL};
@@ -2698,8 +2721,8 @@ int         S52_PL_done(void)
     return TRUE;
 }
 
-static S52_Color *_getColorAt(guchar index)
-// return color at index, for the currently selected color table
+static S52_Color *_getColorAtPal(guchar index, int n)
+// return color at index, for the color table n
 {
     /*
     if (NULL == _colTables) {
@@ -2716,8 +2739,6 @@ static S52_Color *_getColorAt(guchar index)
         return NULL;
     }
 
-    int n = (int) S52_MP_get(S52_MAR_COLOR_PALETTE);
-
     _colTable *ct = &g_array_index(_colTables, _colTable, n);
     if (NULL == ct) {
         PRINTF("ERROR: no COLOR_PALETTE (NULL == ct) \n");
@@ -2730,6 +2751,12 @@ static S52_Color *_getColorAt(guchar index)
     return c;
 }
 
+static S52_Color *_getColorAt(guchar index)
+// return color at index, for the currently selected color table
+{
+    return _getColorAtPal(index, (int) S52_MP_get(S52_MAR_COLOR_PALETTE));
+}
+
 S52_Color  *S52_PL_getColor(const char *colorName)
 {
     return_if_null(colorName);
@@ -3158,11 +3185,11 @@ S52_CmdWrd  S52_PL_iniCmd(_S52_obj *obj)
 
     S52_CmdWrd cmdW  = S52_CMD_NONE;
 
-    obj->crntAidx    = 0;
-    obj->crntA       = obj->cmdAfinal[_getAlt(obj)];
+    CRNTAIDX(obj)    = 0;
+    CRNTA(obj)       = obj->cmdAfinal[_getAlt(obj)];
 
-    if (obj->crntA->len > 0) {
-        _cmdWL *cmd = &g_array_index(obj->crntA, _cmdWL, 0);
+    if (CRNTA(obj)->len > 0) {
+        _cmdWL *cmd = &g_array_index(CRNTA(obj), _cmdWL, 0);
         cmdW = cmd->cmdWord;
     }
 
@@ -3173,9 +3200,9 @@ S52_CmdWrd  S52_PL_getCmdNext(_S52_obj *obj)
 {
     return_if_null(obj);
 
-    obj->crntAidx++;
-    if (obj->crntAidx < obj->crntA->len) {
-        _cmdWL *cmd = &g_array_index(obj->crntA, _cmdWL, obj->crntAidx);
+    CRNTAIDX(obj)++;
+    if (CRNTAIDX(obj) < CRNTA(obj)->len) {
+        _cmdWL *cmd = &g_array_index(CRNTA(obj), _cmdWL, CRNTAIDX(obj));
         // debug: can this array call return NULL!
         if (NULL == cmd) {
             PRINTF("DEBUG: no cmd word\n");
@@ -3190,7 +3217,7 @@ S52_CmdWrd  S52_PL_getCmdNext(_S52_obj *obj)
     {
         //PRINTF("DEBUG: crntAidx at end of command word array\n");
         //g_assert(0);
-        obj->crntAidx = 0;
+        CRNTAIDX(obj) = 0;
     }
     //*/
 
@@ -3199,19 +3226,19 @@ S52_CmdWrd  S52_PL_getCmdNext(_S52_obj *obj)
 
 _cmdWL           *_getCrntCmd(_S52_obj *obj)
 {
-    if (NULL == obj->crntA) {
+    if (NULL == CRNTA(obj)) {
         PRINTF("WARNING: internal inconsistency\n");
         g_assert(0);
         return NULL;
     }
 
-    if (obj->crntAidx >= obj->crntA->len) {
+    if (CRNTAIDX(obj) >= CRNTA(obj)->len) {
         PRINTF("DEBUG: idx >= len\n");
         g_assert(0);
         return NULL;
     }
 
-    _cmdWL *cmd = &g_array_index(obj->crntA, _cmdWL, obj->crntAidx);
+    _cmdWL *cmd = &g_array_index(CRNTA(obj), _cmdWL, CRNTAIDX(obj));
     if (NULL == cmd) {
         PRINTF("WARNING: no cmd\n");
         g_assert(0);
@@ -3342,8 +3369,8 @@ double      S52_PL_getSYorient(_S52_obj *obj)
     //double noOrient = 360.0;
 
     if (0 != isinf(obj->auxInfo.orient)) { // +inf
-        if (NULL != obj->crntA) {
-            _cmdWL *cmd = &g_array_index(obj->crntA, _cmdWL, obj->crntAidx);
+        if (NULL != CRNTA(obj)) {
+            _cmdWL *cmd = &g_array_index(CRNTA(obj), _cmdWL, CRNTAIDX(obj));
 
             if (NULL != cmd) {
                 char *str = cmd->param;
@@ -3616,7 +3643,8 @@ int         S52_PL_setAPtexID(_S52_obj *obj, guint mask_texID)
         return FALSE;
     }
 
-    cmd->cmd.def->mask_texID = mask_texID;
+    // Note: atomic - the texture is complete for the other context (see _renderTexure())
+    g_atomic_int_set((gint*)&cmd->cmd.def->mask_texID, mask_texID);
 
     return TRUE;
 }
@@ -3635,7 +3663,7 @@ guint       S52_PL_getAPtexID(_S52_obj *obj)
         return FALSE;
     }
 
-    return cmd->cmd.def->mask_texID;
+    return g_atomic_int_get((gint*)&cmd->cmd.def->mask_texID);
 }
 #endif  // S52_USE_GL2 | S52_USE_GLES2
 
@@ -3701,27 +3729,28 @@ S52_DListData *S52_PL_getDListData(_S52_obj *obj)
             return &cmd->cmd.def->DListData;
     }
 
-    guint      nbr = 0;
-    S52_Color *c   = NULL;
-    if (S52_CMD_ARE_CO == cmd->cmdWord) {
-        // no need to init DList for light sector
-        if (NULL == cmd->cmd.DListData) {
-            //PRINTF("DEBUG: no DListData in cmd\n");
-            return NULL;
-        }
+    // no need to init DList for light sector
+    if ((S52_CMD_ARE_CO==cmd->cmdWord) && (NULL==cmd->cmd.DListData)) {
+        //PRINTF("DEBUG: no DListData in cmd\n");
+        return NULL;
+    }
+    if ((S52_CMD_ARE_CO!=cmd->cmdWord) && (NULL==cmd->cmd.def)) {
+        PRINTF("DEBUG: no DListData in cmd.def\n");
+        g_assert(0);
+    }
 
-        nbr = cmd->cmd.DListData->nbr;
-        c   = cmd->cmd.DListData->colors;
-        cmd->cmd.DListData->crntPalIDX = (int)S52_MP_get(S52_MAR_COLOR_PALETTE);
-    } else {
-        if (NULL == cmd->cmd.def) {
-            PRINTF("DEBUG: no DListData in cmd.def\n");
-            g_assert(0);
-        }
-        nbr = cmd->cmd.def->DListData.nbr;
-        c   = cmd->cmd.def->DListData.colors;
-        cmd->cmd.def->DListData.crntPalIDX = (int)S52_MP_get(S52_MAR_COLOR_PALETTE);
+    S52_DListData *DListData = (S52_CMD_ARE_CO == cmd->cmdWord) ? cmd->cmd.DListData : &cmd->cmd.def->DListData;
+    guint          nbr       = DListData->nbr;
+    S52_Color     *c         = DListData->colors;
+
+#ifdef S52_USE_CTX
+    // an other context could be at it - the palette of context drawing at once is the same
+    GPLLOCK(&_pl_mutex);
+    if (DListData->crntPalIDX == (int)S52_MP_get(S52_MAR_COLOR_PALETTE)) {
+        GPLUNLOCK(&_pl_mutex);
+        return DListData;
     }
+#endif
 
     /* debug - trying to nail a curious bug
     if (MAX_SUBLIST < nbr) {
@@ -3757,10 +3786,14 @@ S52_DListData *S52_PL_getDListData(_S52_obj *obj)
         }
     }
 
-    if (S52_CMD_ARE_CO == cmd->cmdWord)
-        return  cmd->cmd.DListData;
-    else
-        return &cmd->cmd.def->DListData;
+    // Note: after the colors - a context that see the palette use the colors
+    g_atomic_int_set(&DListData->crntPalIDX, (int)S52_MP_get(S52_MAR_COLOR_PALETTE));
+
+#ifdef S52_USE_CTX
+    GPLUNLOCK(&_pl_mutex);
+#endif
+
+    return DListData;
 }
 
 S52_vec    *S52_PL_initVOCmd(_S52_symDef *def)
@@ -4156,6 +4189,22 @@ const char *S52_PL_getEX(_S52_obj *obj, S52_Color **col,
         return NULL;
     }
 
+#ifdef S52_USE_CTX
+    // an other context could be parsing / reading it - text of an obj is
+    // only freed by S52_PL_resetParseText() (writer), so parse if none
+    if ((FALSE==g_atomic_int_get(&obj->textParsed[_getAlt(obj)])) && (NULL==g_atomic_pointer_get((gpointer*)&cmd->cmd.text))) {
+        GPLLOCK(&_pl_mutex);
+        if (NULL == cmd->cmd.text) {
+            _Text *text = NULL;
+            if (S52_CMD_TXT_TX == cmd->cmdWord)
+                text = _parseTX(obj->geo, cmd);
+            if (S52_CMD_TXT_TE == cmd->cmdWord)
+                text = _parseTE(obj->geo, cmd);
+            g_atomic_pointer_set((gpointer*)&cmd->cmd.text, text);
+        }
+        GPLUNLOCK(&_pl_mutex);
+    }
+#else   // S52_USE_CTX
     if (FALSE == obj->textParsed[_getAlt(obj)]) {
 
         if (S52_CMD_TXT_TX == cmd->cmdWord) {
@@ -4185,6 +4234,8 @@ const char *S52_PL_getEX(_S52_obj *obj, S52_Color **col,
         }
     }
 
+#endif  // S52_USE_CTX
+
     if (NULL == cmd->cmd.text)
         return NULL;
 
@@ -4216,7 +4267,7 @@ int         S52_PL_setTextParsed(_S52_obj *obj)
     return_if_null(obj);
 
     // flag text as parsed
-    obj->textParsed[_getAlt(obj)] = TRUE;
+    g_atomic_int_set(&obj->textParsed[_getAlt(obj)], TRUE);
 
     return TRUE;
 }
@@ -4544,9 +4595,26 @@ int         S52_PL_setRGB(const char *colorName, unsigned char  R, unsigned char
     return TRUE;
 }
 
-int         S52_PL_getRGB(const char *colorName, unsigned char *R, unsigned char *G, unsigned char *B)
+int         S52_PL_getRGB(unsigned int palIdx, const char *colorName, unsigned char *R, unsigned char *G, unsigned char *B)
+// Note: palette passed by the caller - query read the palette of its context (not the MP in the globals)
 {
-    S52_Color *c = S52_PL_getColor(colorName);
+    return_if_null(colorName);
+
+    if (NULL==_colTables || _colTables->len<=palIdx) {
+        PRINTF("WARNING: unknown colors table (%u)\n", palIdx);
+        return FALSE;
+    }
+
+    gpointer idx = g_tree_lookup(_colref, (gpointer*)colorName);
+    if (NULL == idx) {
+        PRINTF("WARNING: no color name: %s\n", colorName);
+        return FALSE;
+    }
+
+    // IHO color index start at 1
+    S52_Color *c = _getColorAtPal(GPOINTER_TO_INT(idx) - 1, palIdx);
+    if (NULL == c)
+        return FALSE;
 
     *R = c->R;
     *G = c->G;
@@ -4680,10 +4748,11 @@ int         S52_PL_setFreetypeGL_VBO(_S52_obj *obj, guint vboID, guint len, doub
     if (NULL == cmd->cmd.text)
          return FALSE;
 
-    cmd->cmd.text->vboID  = vboID;
     cmd->cmd.text->len    = len;
     cmd->cmd.text->strWpx = strWpx;
     cmd->cmd.text->strHpx = strHpx;
+    // last - the other context read the rest once vboID is set
+    g_atomic_int_set((gint*)&cmd->cmd.text->vboID, vboID);
 
     return TRUE;
 }
@@ -4705,16 +4774,63 @@ guint       S52_PL_getFreetypeGL_VBO(_S52_obj *obj, guint *len, double *strWpx,
     if (NULL == cmd->cmd.text)
          return FALSE;
 
+    guint vboID = g_atomic_int_get((gint*)&cmd->cmd.text->vboID);
+
     *len    = cmd->cmd.text->len;
     *strWpx = cmd->cmd.text->strWpx;
     *strHpx = cmd->cmd.text->strHpx;
     *hjust  = cmd->cmd.text->hjust;
     *vjust  = cmd->cmd.text->vjust;
 
-    return cmd->cmd.text->vboID;
+    return vboID;
 }
 #endif  // S52_USE_FREETYPE_GL
 
+int         S52_PL_getMemSize(_S52_obj *obj, gsize *objB, gsize *textB, guint *textVBOlen)
+// memory held by this obj (approximate) - LUP and PLib symbol are shared, not counted
+// textVBOlen: nbr of vertex in text VBO (freetype-gl) on the GPU
+{
+    return_if_null(obj);
+
+    gsize sz  = sizeof(_S52_obj);
+    gsize txt = 0;
+    guint len = 0;
+
+    for (int alt=0; alt<2; ++alt) {
+        if (NULL != obj->CSinst[alt])
+            sz += sizeof(GString) + obj->CSinst[alt]->allocated_len;
+
+        for (_cmdWL *cmd=obj->CScmdL[alt]; NULL!=cmd; cmd=cmd->next)
+            sz += sizeof(_cmdWL);
+
+        GArray *cmdA = obj->cmdAfinal[alt];
+        if (NULL == cmdA)
+            continue;
+
+        sz += sizeof(GArray) + cmdA->len * sizeof(_cmdWL);
+
+        for (guint i=0; i<cmdA->len; ++i) {
+            _cmdWL *cmd = &g_array_index(cmdA, _cmdWL, i);
+            if (((S52_CMD_TXT_TX==cmd->cmdWord) || (S52_CMD_TXT_TE==cmd->cmdWord)) && (NULL!=cmd->cmd.text)) {
+                _Text *text = cmd->cmd.text;
+                txt += sizeof(_Text);
+                if (NULL != text->frmtd)
+                    txt += sizeof(GString) + text->frmtd->allocated_len;
+#ifdef S52_USE_FREETYPE_GL
+                if (0 != text->vboID)
+                    len += text->len;
+#endif
+            }
+        }
+    }
+
+    if (NULL != objB      ) *objB       = sz;
+    if (NULL != textB     ) *textB      = txt;
+    if (NULL != textVBOlen) *textVBOlen = len;
+
+    return TRUE;
+}
+
 S52_obj    *S52_PL_isObjValid(unsigned int objH)
 {
     if (0 == objH) {
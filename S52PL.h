@@ -136,6 +136,10 @@ typedef struct S52_DListData {
     guint     vboIds[MAX_SUBLIST];   // array of starting index of Display List / VBO ids
     S52_Color colors[MAX_SUBLIST];   // color of each Display List / VBO
     S57_prim *prim  [MAX_SUBLIST];   // hold PLib sym prim info for VBO
+#ifdef S52_USE_SYM_ATLAS
+    int       atlas;                 // TRUE sub-list in symbol atlas VBO (vboIds not used)
+    guint     atlasOff[MAX_SUBLIST]; // first vertex of each sub-list in symbol atlas VBO
+#endif
 
     int       crntPalIDX;            // -1 - init, 0..n palette index
 } S52_DListData;
@@ -295,6 +299,8 @@ int            S52_PL_setTextParsed(S52_obj *obj);
 
 // TRUE if this object has text else FALSE
 int            S52_PL_hasText(S52_obj *obj);
+// memory stat - bytes of obj (cmd, CS) and text, nbr of vertex in text VBO
+int            S52_PL_getMemSize(S52_obj *obj, gsize *objB, gsize *textB, guint *textVBOlen);
 // TRUE if this object has LC (Line Complex) else FALSE - not used
 //int            S52_PL_hasLC(S52_obj *obj);
 // return CS name if this object has CS (Conditional Symbology) else NULL - not used (eventual optimisation)
@@ -322,7 +328,7 @@ int            S52_PL_setNextCN(S52_obj *objA, S52_obj *objB);
 #endif
 
 int            S52_PL_setRGB(const char *colorName, unsigned char  R, unsigned char  G, unsigned char  B);
-int            S52_PL_getRGB(const char *colorName, unsigned char *R, unsigned char *G, unsigned char *B);
+int            S52_PL_getRGB(unsigned int palIdx, const char *colorName, unsigned char *R, unsigned char *G, unsigned char *B);
 
 guint          S52_PL_getPalTableSz(void);
 const char    *S52_PL_getPalTableNm(unsigned int idx);
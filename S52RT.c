@@ -0,0 +1,391 @@
+// S52RT.c: render thread - S52_draw() / S52_drawLast() in a thread, fence to wait on
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Note: the thread call the public S52_setView() / S52_draw() / S52_drawLast(),
+// so the EGL callback (S52_setEGLCallBack()) run in this thread - the GL context
+// must be made current there (and released by the host thread).
+// Note: when many frames of a context are pending only the newest S52_draw() (and the
+// S52_drawLast() after it) of that context are rendered, older frames of that context
+// are dropped (fence signaled, S52_RT_wait() return RT_DROPPED).
+// Note: the render thread wait for the lock (see _drawWait() in S52.c) - a frame that
+// can't be drawn (S52_draw() fail, ex: no projection yet) is signaled as failed,
+// S52_RT_wait() return FALSE.
+// Note: while the thread is on, S52_setMarinerParam() of an other thread only stage
+// the value (S52_RT_setMP()), the next frame of that context carry the staged MP
+// and the render thread apply them (writer lock) before drawing - so the host loop
+// never wait for the frame being drawn. A dropped frame still apply its MP.
+
+
+#include "S52RT.h"
+#include "S52.h"        // S52_draw()
+#include "S52utils.h"   // PRINTF()
+
+#define RT_RESULT_N  64     // result of the last frames - S52_RT_wait()
+
+typedef struct _mp {
+    void  *ctx;         // context of the caller, NULL - default
+    int    paramID;
+    double val;
+} _mp;
+
+typedef struct _req {
+    guint   fence;
+    void   *ctx;        // context of the caller (S52_setCtx()), NULL - default
+    int     last;       // TRUE S52_drawLast(), else S52_draw()
+    double  cLat;       // view snapshot - S52_draw() only
+    double  cLon;
+    double  rNM;
+    double  north;
+    GArray *mp;         // _mp staged for ctx before this frame, NULL - none
+} _req;
+
+static GAsyncQueue *_queue     = NULL;   // _req
+static GThread     *_thread    = NULL;
+static _req         _quit;               // sentinel that stop _render()
+static guint        _fenceNext = 0;      // last fence issued - _rt_mutex
+static guint        _fenceDone = 0;      // last fence done   - _rt_mutex
+static GArray      *_mpStage   = NULL;   // _mp not yet in a frame  - _rt_mutex
+static int          _stop      = FALSE;  // S52_RT_done() - no more staging - _rt_mutex
+static struct {
+    guint fence;
+    int   res;      // FALSE - failed, TRUE - drawn, RT_DROPPED
+} _result[RT_RESULT_N];                  // by fence % RT_RESULT_N - _rt_mutex
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticMutex  _rt_mutex = G_STATIC_MUTEX_INIT;
+static GCond        *_rt_cond  = NULL;
+#define GMUTEXLOCK   g_static_mutex_lock
+#define GMUTEXUNLOCK g_static_mutex_unlock
+#else
+static GMutex        _rt_mutex;
+static GCond         _rt_cond;
+#define GMUTEXLOCK   g_mutex_lock
+#define GMUTEXUNLOCK g_mutex_unlock
+#endif
+
+
+static void       _signal(guint fence, int res)
+{
+    GMUTEXLOCK(&_rt_mutex);
+
+    if (fence > _fenceDone)
+        _fenceDone = fence;
+
+    _result[fence % RT_RESULT_N].fence = fence;
+    _result[fence % RT_RESULT_N].res   = res;
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+    g_cond_broadcast(_rt_cond);
+#else
+    g_cond_broadcast(&_rt_cond);
+#endif
+
+    GMUTEXUNLOCK(&_rt_mutex);
+}
+
+static int        _isDropped(GPtrArray *pending, guint i)
+// TRUE if a newer S52_draw() of the same context is pending
+{
+    _req *r = (_req *)g_ptr_array_index(pending, i);
+
+    for (guint j=i+1; j<pending->len; ++j) {
+        _req *n = (_req *)g_ptr_array_index(pending, j);
+        if (&_quit!=n && r->ctx==n->ctx && FALSE==n->last)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+static GArray    *_takeMP(void *ctx, int all)
+// move the staged MP of ctx (all: of every context) out of the stage - call with _rt_mutex held
+{
+    GArray *mp = NULL;
+
+    for (guint i=0; i<_mpStage->len; ) {
+        _mp *e = &g_array_index(_mpStage, _mp, i);
+        if ((TRUE==all) || (ctx==e->ctx)) {
+            if (NULL == mp)
+                mp = g_array_new(FALSE, FALSE, sizeof(_mp));
+            g_array_append_val(mp, *e);
+            // keep order
+            g_array_remove_index(_mpStage, i);
+            continue;
+        }
+        ++i;
+    }
+
+    return mp;
+}
+
+static void       _applyMP(GArray *mp)
+// render thread - set the MP in their context (writer lock)
+{
+    if (NULL == mp)
+        return;
+
+    for (guint i=0; i<mp->len; ++i) {
+        _mp *e = &g_array_index(mp, _mp, i);
+#ifdef S52_USE_CTX
+        S52_setCtx(e->ctx);
+#endif
+        S52_setMarinerParam((S52MarinerParameter)e->paramID, e->val);
+    }
+    g_array_free(mp, TRUE);
+}
+
+static gpointer   _render(gpointer data)
+{
+    (void)data;
+
+    GPtrArray *pending = g_ptr_array_new();
+
+    int quit = FALSE;
+    while (FALSE == quit) {
+        // take all pending frame
+        _req *req = (_req *)g_async_queue_pop(_queue);
+        while (NULL != req) {
+            g_ptr_array_add(pending, req);
+            req = (_req *)g_async_queue_try_pop(_queue);
+        }
+
+        for (guint i=0; i<pending->len; ++i) {
+            _req *r = (_req *)g_ptr_array_index(pending, i);
+
+            if (&_quit == r) {
+                quit = TRUE;
+                continue;
+            }
+
+            // MP of the host at the time of the frame - dropped or not
+            _applyMP(r->mp);
+
+            // older than the newest S52_draw() of this context
+            int res = RT_DROPPED;
+            if (FALSE == _isDropped(pending, i)) {
+#ifdef S52_USE_CTX
+                S52_setCtx(r->ctx);
+#endif
+                if (FALSE == r->last)
+                    S52_setView(r->cLat, r->cLon, r->rNM, r->north);
+
+                // Note: this thread wait for a writer (ex: S52_loadCell())
+                res = (TRUE == r->last) ? S52_drawLast() : S52_draw();
+                if (FALSE == res)
+                    PRINTF("WARNING: frame %u failed\n", r->fence);
+            }
+
+            _signal(r->fence, res);
+            g_free(r);
+        }
+        g_ptr_array_set_size(pending, 0);
+    }
+
+    // MP staged after the last frame (_stop set: no more)
+    GMUTEXLOCK(&_rt_mutex);
+    GArray *mp = _takeMP(NULL, TRUE);
+    GMUTEXUNLOCK(&_rt_mutex);
+    _applyMP(mp);
+
+    g_ptr_array_free(pending, TRUE);
+
+    return NULL;
+}
+
+int               S52_RT_init(void)
+{
+    if (NULL != _queue)
+        return FALSE;
+
+    _queue    = g_async_queue_new();
+    _mpStage  = g_array_new(FALSE, FALSE, sizeof(_mp));
+    _stop     = FALSE;
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+    if (!g_thread_supported())
+        g_thread_init(NULL);
+    if (NULL == _rt_cond)
+        _rt_cond = g_cond_new();
+    _thread = g_thread_create(_render, NULL, TRUE, NULL);
+#else
+    _thread = g_thread_new("S52RT", _render, NULL);
+#endif
+
+    return TRUE;
+}
+
+int               S52_RT_done(void)
+{
+    if (NULL == _queue)
+        return FALSE;
+
+    // stop - after pending frame and staged MP
+    GMUTEXLOCK(&_rt_mutex);
+    _stop = TRUE;
+    GMUTEXUNLOCK(&_rt_mutex);
+
+    g_async_queue_push(_queue, &_quit);
+    g_thread_join(_thread);
+    _thread = NULL;
+
+    g_async_queue_unref(_queue);
+    _queue = NULL;
+    g_array_free(_mpStage, TRUE);
+    _mpStage = NULL;
+
+    return TRUE;
+}
+
+int               S52_RT_isOn(void)
+{
+    return (NULL == _queue) ? FALSE : TRUE;
+}
+
+int               S52_RT_isRT(void)
+{
+    return ((NULL!=_thread) && (g_thread_self()==_thread)) ? TRUE : FALSE;
+}
+
+int               S52_RT_setMP(void *ctx, int paramID, double val)
+{
+    if ((NULL==_queue) || (TRUE==S52_RT_isRT()))
+        return FALSE;
+
+    int ret = FALSE;
+
+    GMUTEXLOCK(&_rt_mutex);
+    if (FALSE == _stop) {
+        // last value win
+        guint i = 0;
+        for (i=0; i<_mpStage->len; ++i) {
+            _mp *e = &g_array_index(_mpStage, _mp, i);
+            if ((ctx==e->ctx) && (paramID==e->paramID)) {
+                e->val = val;
+                break;
+            }
+        }
+        if (i == _mpStage->len) {
+            _mp e = {ctx, paramID, val};
+            g_array_append_val(_mpStage, e);
+        }
+        ret = TRUE;
+    }
+    GMUTEXUNLOCK(&_rt_mutex);
+
+    return ret;
+}
+
+int               S52_RT_getMP(void *ctx, int paramID, double *val)
+{
+    if ((NULL==_queue) || (TRUE==S52_RT_isRT()))
+        return FALSE;
+
+    int ret = FALSE;
+
+    GMUTEXLOCK(&_rt_mutex);
+    for (guint i=0; i<_mpStage->len; ++i) {
+        _mp *e = &g_array_index(_mpStage, _mp, i);
+        if ((ctx==e->ctx) && (paramID==e->paramID)) {
+            *val = e->val;
+            ret  = TRUE;
+            break;
+        }
+    }
+    GMUTEXUNLOCK(&_rt_mutex);
+
+    return ret;
+}
+
+guint             S52_RT_push(void *ctx, int last, double cLat, double cLon, double rNM, double north)
+{
+    if (NULL == _queue) {
+        PRINTF("WARNING: render thread not running\n");
+        return 0;
+    }
+
+    _req *req  = g_new0(_req, 1);
+    req->ctx   = ctx;
+    req->last  = last;
+    req->cLat  = cLat;
+    req->cLon  = cLon;
+    req->rNM   = rNM;
+    req->north = north;
+
+    // Note: push under the lock so that frame are queued in fence order,
+    // req belong to the render thread once pushed (freed after the frame)
+    GMUTEXLOCK(&_rt_mutex);
+    // skip 0 on wrap
+    if (0 == ++_fenceNext)
+        ++_fenceNext;
+    guint fence = _fenceNext;
+    req->fence  = fence;
+    req->mp     = _takeMP(ctx, FALSE);
+    g_async_queue_push(_queue, req);
+    GMUTEXUNLOCK(&_rt_mutex);
+
+    return fence;
+}
+
+int               S52_RT_wait(guint fence, int timeout_ms)
+{
+    int res = FALSE;
+
+    if (0 == fence)
+        return FALSE;
+
+    GMUTEXLOCK(&_rt_mutex);
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+    GTimeVal end;
+    g_get_current_time(&end);
+    g_time_val_add(&end, (glong)timeout_ms * 1000);
+
+    while (fence > _fenceDone) {
+        if (0 == timeout_ms)
+            break;
+        if (FALSE == g_cond_timed_wait(_rt_cond, g_static_mutex_get_mutex(&_rt_mutex), (timeout_ms < 0) ? NULL : &end))
+            break;
+    }
+#else
+    gint64 end = g_get_monotonic_time() + (gint64)timeout_ms * G_TIME_SPAN_MILLISECOND;
+
+    while (fence > _fenceDone) {
+        if (0 == timeout_ms)
+            break;
+        if (timeout_ms < 0)
+            g_cond_wait(&_rt_cond, &_rt_mutex);
+        else if (FALSE == g_cond_wait_until(&_rt_cond, &_rt_mutex, end))
+            break;
+    }
+#endif
+
+    // result of the frame - done if it has been overwritten by a newer frame
+    if (fence <= _fenceDone) {
+        res = TRUE;
+        if (fence == _result[fence % RT_RESULT_N].fence)
+            res = _result[fence % RT_RESULT_N].res;
+    }
+
+    GMUTEXUNLOCK(&_rt_mutex);
+
+    return res;
+}
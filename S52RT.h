@@ -0,0 +1,56 @@
+// S52RT.h: render thread - S52_draw() / S52_drawLast() in a thread, fence to wait on
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _S52RT_H_
+#define _S52RT_H_
+
+#include <glib.h>       // guint
+
+// start / stop the render thread - stop after pending frame
+int   S52_RT_init(void);
+int   S52_RT_done(void);
+// TRUE if the render thread is running
+int   S52_RT_isOn(void);
+// TRUE if the caller is the render thread
+int   S52_RT_isRT(void);
+
+// Mariners' Parameter set while the render thread is on - applied by the render thread
+// before the next frame of ctx (S52_setMarinerParam() don't wait for the frame being drawn)
+// return FALSE if not staged (thread not running or caller is the render thread)
+int   S52_RT_setMP(void *ctx, int paramID, double val);
+// TRUE and val if paramID of ctx is staged
+int   S52_RT_getMP(void *ctx, int paramID, double *val);
+
+// queue a frame - return fence, 0 if the thread is not running
+// ctx : context drawn (S52_setCtx() in the render thread), NULL - default context
+//       the MP staged for ctx go with the frame
+// last: TRUE S52_drawLast(), else S52_setView(cLat, cLon, rNM, north) + S52_draw()
+guint S52_RT_push(void *ctx, int last, double cLat, double cLon, double rNM, double north);
+// wait until frame fence is done (or dropped by a newer S52_draw() of the same context)
+// timeout_ms: 0 poll, -1 no timeout - return TRUE if drawn, RT_DROPPED if dropped,
+// FALSE on timeout or if the frame failed
+#define RT_DROPPED 2
+int   S52_RT_wait(guint fence, int timeout_ms);
+
+#endif // _S52RT_H_
@@ -0,0 +1,752 @@
+// S52SW.c: software rasteriser - tiled, multi-threaded, SIMD span (GPU-less server)
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Note: all primitive of a frame are reduced to triangle in window coord and
+// binned by screen tile (TILE_SZ x TILE_SZ). At S52_SW_end() each thread take
+// one tile in n and run the triangle of that tile in draw order, so the blending
+// order is the same as GL without any lock. Triangle are scan converted one row
+// at a time (pixel center, top-left rule) and each span blended by a SSE2 kernel
+// (4 pixels per step, scalar tail) - scalar only if no SSE2 (ARM: GCC vectorize).
+// Line are GL non-antialiased wide line (offset in the minor axis), point are
+// square - both as 2 triangles, never culled.
+// Texture are alpha only (as the GL2 shader: pattern, text and stipple line use
+// the alpha of the texel and the RGB of the color).
+
+#include "S52SW.h"
+#include "S52utils.h"   // PRINTF()
+
+#ifdef S52_USE_SW
+
+#include <string.h>     // memcpy()
+#include <math.h>       // ceilf(), floorf(), sqrtf()
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define TILE_SZ     64      // pixel - power of 2
+#define TILE_SH      6      // log2(TILE_SZ)
+#define MAX_THREAD  16
+
+typedef struct _tri {
+    float   x[3], y[3];     // window - CCW
+    float   u[3], v[3];     // texture coord
+    guint32 color;          // RGBA in memory order
+    gint    tex;            // index in _texs, -1 none
+    float   cx, cy, r2;     // round point: disc center, radius^2 - 0.0 none
+} _tri;
+
+// FB
+static int      _w      = 0;
+static int      _h      = 0;
+static guchar  *_fb     = NULL;     // _w x _h x 4
+static int      _tw     = 0;        // tile count
+static int      _th     = 0;
+
+// frame
+static GArray  *_tris   = NULL;     // _tri
+static GArray  *_texs   = NULL;     // S52_SW_tex
+static GArray **_bins   = NULL;     // _tw x _th - guint index in _tris
+static int      _inFrame= FALSE;
+static int      _clearOn= FALSE;    // clear each tile before its triangle
+static guint32  _clearC = 0;
+
+// fragment state
+static guint32  _color  = 0xFF000000;
+static float    _lineW  = 1.0;
+static float    _pointSz= 1.0;
+static gint     _tex    = -1;
+static int      _cull   = S52_SW_CULL_CW;
+static float    _disc[3]= {0.0, 0.0, 0.0};  // cx, cy, r2 of the round point recorded
+
+// thread - worker k (1..n-1) run tile k, k+n, .. ; the caller run worker 0
+static int          _nThread = 1;
+static GThread     *_thread[MAX_THREAD];
+static GAsyncQueue *_jobQ  [MAX_THREAD];
+static GAsyncQueue *_doneQ   = NULL;
+static int          _job     = 0;       // token - address only
+static int          _quit    = 0;       // token - address only
+
+static guint32    _rgba(guchar r, guchar g, guchar b, guchar a)
+{
+    guint32 c;
+    guchar *p = (guchar*)&c;
+
+    p[0] = r;
+    p[1] = g;
+    p[2] = b;
+    p[3] = a;
+
+    return c;
+}
+
+static void       _fill(guchar *dst, int n, guint32 c)
+{
+    guint32 *d = (guint32*)dst;
+
+#ifdef __SSE2__
+    __m128i cv = _mm_set1_epi32((int)c);
+    for (; n>=4; n-=4, d+=4)
+        _mm_storeu_si128((__m128i*)d, cv);
+#endif
+
+    for (; n>0; --n)
+        *d++ = c;
+}
+
+static void       _blend(guchar *dst, int n, guint32 c)
+// dst = (src*a + dst*(255-a)) / 255, alpha channel too (glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA))
+{
+    const guchar *s = (const guchar*)&c;
+    guint         a = s[3];
+
+    if (255 == a) {
+        _fill(dst, n, c);
+        return;
+    }
+    if (0 == a)
+        return;
+
+#ifdef __SSE2__
+    __m128i zero = _mm_setzero_si128();
+    __m128i sa   = _mm_set1_epi16((short)a);
+    __m128i da   = _mm_set1_epi16((short)(255 - a));
+    __m128i sm   = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32((int)c), zero), sa),
+                                 _mm_set1_epi16(128));
+    for (; n>=4; n-=4, dst+=16) {
+        __m128i d  = _mm_loadu_si128((const __m128i*)dst);
+        __m128i lo = _mm_add_epi16(sm, _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), da));
+        __m128i hi = _mm_add_epi16(sm, _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), da));
+        // x/255 rounded: (x + 128 + ((x + 128) >> 8)) >> 8
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128((__m128i*)dst, _mm_packus_epi16(lo, hi));
+    }
+#endif
+
+    for (; n>0; --n, dst+=4) {
+        for (int i=0; i<4; ++i) {
+            guint t = s[i]*a + dst[i]*(255-a) + 128;
+            dst[i]  = (guchar)((t + (t >> 8)) >> 8);
+        }
+    }
+}
+
+static void       _blendTex(guchar *dst, int n, guint32 c, const S52_SW_tex *tex, float u, float v, float du, float dv)
+// per pixel alpha from texel - RGB from color
+{
+    guchar *s = (guchar*)&c;
+
+    for (; n>0; --n, dst+=4, u+=du, v+=dv) {
+        int ix = (int)floorf(u * tex->w) % tex->w;
+        int iy = (int)floorf(v * tex->h) % tex->h;
+        if (ix < 0) ix += tex->w;
+        if (iy < 0) iy += tex->h;
+
+        guint a = tex->data[iy*tex->stride + ix*tex->bpp + tex->bpp - 1];
+        if (0 == a)
+            continue;
+
+        s[3] = (guchar)a;
+        for (int i=0; i<4; ++i) {
+            guint t = s[i]*a + dst[i]*(255-a) + 128;
+            dst[i]  = (guchar)((t + (t >> 8)) >> 8);
+        }
+    }
+}
+
+static void       _rasterTri(const _tri *t, int tx0, int ty0, int tx1, int ty1)
+// scan convert 't' in the tile [tx0,tx1[ x [ty0,ty1[
+{
+    float ymin = MIN(t->y[0], MIN(t->y[1], t->y[2]));
+    float ymax = MAX(t->y[0], MAX(t->y[1], t->y[2]));
+    int   y0   = MAX(ty0, (int)ceilf(ymin - 0.5f));
+    int   y1   = MIN(ty1, (int)ceilf(ymax - 0.5f));
+    if (y0 >= y1)
+        return;
+
+    // edge i: from vertex i to i+1, inside on the left (CCW)
+    float ex[3], ey[3], edx[3], edy[3], slope[3];
+    for (int i=0; i<3; ++i) {
+        int j    = (i + 1) % 3;
+        ex [i]   = t->x[i];
+        ey [i]   = t->y[i];
+        edx[i]   = t->x[j] - t->x[i];
+        edy[i]   = t->y[j] - t->y[i];
+        slope[i] = (0.0f == edy[i]) ? 0.0f : edx[i] / edy[i];
+    }
+
+    // texture plane: u = ux*x + uy*y + uc
+    const S52_SW_tex *tex = (0 <= t->tex) ? &g_array_index(_texs, S52_SW_tex, t->tex) : NULL;
+    float ux = 0.0, uy = 0.0, uc = 0.0;
+    float vx = 0.0, vy = 0.0, vc = 0.0;
+    if (NULL != tex) {
+        float x1 = t->x[1] - t->x[0], y1_ = t->y[1] - t->y[0];
+        float x2 = t->x[2] - t->x[0], y2  = t->y[2] - t->y[0];
+        float u1 = t->u[1] - t->u[0], u2  = t->u[2] - t->u[0];
+        float v1 = t->v[1] - t->v[0], v2  = t->v[2] - t->v[0];
+        float d  = x1*y2 - x2*y1_;
+        ux = (u1*y2 - u2*y1_) / d;
+        uy = (u2*x1 - u1*x2 ) / d;
+        uc = t->u[0] - ux*t->x[0] - uy*t->y[0];
+        vx = (v1*y2 - v2*y1_) / d;
+        vy = (v2*x1 - v1*x2 ) / d;
+        vc = t->v[0] - vx*t->x[0] - vy*t->y[0];
+    }
+
+    for (int y=y0; y<y1; ++y) {
+        float yc = y + 0.5f;
+        float xl = (float)tx0 + 0.5f;   // pixel center bound
+        float xr = (float)tx1 + 0.5f;
+        int   in = TRUE;
+
+        for (int i=0; i<3; ++i) {
+            if (0.0f == edy[i]) {
+                // horizontal: bottom edge (going right) inclusive, top edge exclusive
+                if (((0.0f < edx[i]) && (yc < ey[i])) || ((edx[i] <= 0.0f) && (yc >= ey[i])))
+                    in = FALSE;
+                continue;
+            }
+            float xe = ex[i] + (yc - ey[i]) * slope[i];
+            if (edy[i] < 0.0f) {
+                // left edge (going down) - inclusive
+                if (xe > xl) xl = xe;
+            } else {
+                // right edge (going up) - exclusive
+                if (xe < xr) xr = xe;
+            }
+        }
+        if (FALSE == in)
+            continue;
+
+        // round point: as gl_PointCoord discard - pixel center out of the disc
+        if (0.0f < t->r2) {
+            float dy = yc - t->cy;
+            float d2 = t->r2 - dy*dy;
+            if (d2 < 0.0f)
+                continue;
+            float dx = sqrtf(d2);
+            xl = MAX(xl, t->cx - dx);
+            xr = MIN(xr, t->cx + dx);
+        }
+
+        int x0 = MAX(tx0, (int)ceilf(xl - 0.5f));
+        int x1 = MIN(tx1, (int)ceilf(xr - 0.5f));
+        if (x0 >= x1)
+            continue;
+
+        guchar *dst = _fb + ((gsize)y * _w + x0) * 4;
+        if (NULL == tex) {
+            _blend(dst, x1 - x0, t->color);
+        } else {
+            float xc = x0 + 0.5f;
+            _blendTex(dst, x1 - x0, t->color, tex,
+                      ux*xc + uy*yc + uc, vx*xc + vy*yc + vc, ux, vx);
+        }
+    }
+}
+
+static void       _rasterTile(int k)
+{
+    int tx  = k % _tw;
+    int ty  = k / _tw;
+    int tx0 = tx << TILE_SH;
+    int ty0 = ty << TILE_SH;
+    int tx1 = MIN(tx0 + TILE_SZ, _w);
+    int ty1 = MIN(ty0 + TILE_SZ, _h);
+
+    if (TRUE == _clearOn) {
+        for (int y=ty0; y<ty1; ++y)
+            _fill(_fb + ((gsize)y * _w + tx0) * 4, tx1 - tx0, _clearC);
+    }
+
+    GArray *bin = _bins[k];
+    for (guint i=0; i<bin->len; ++i) {
+        const _tri *t = &g_array_index(_tris, _tri, g_array_index(bin, guint, i));
+        _rasterTri(t, tx0, ty0, tx1, ty1);
+    }
+}
+
+static void       _rasterShare(int id)
+// tile id, id+n, id+2n, ..
+{
+    for (int k=id; k<_tw*_th; k+=_nThread)
+        _rasterTile(k);
+}
+
+static gpointer   _worker(gpointer data)
+{
+    int id = GPOINTER_TO_INT(data);
+
+    for (;;) {
+        gpointer tok = g_async_queue_pop(_jobQ[id]);
+        if (&_quit == tok)
+            break;
+
+        _rasterShare(id);
+
+        g_async_queue_push(_doneQ, &_job);
+    }
+
+    return NULL;
+}
+
+static int        _addTri(const float *p0, const float *p1, const float *p2,
+                          const float *t0, const float *t1, const float *t2, int cull)
+{
+    float area = (p1[0]-p0[0])*(p2[1]-p0[1]) - (p2[0]-p0[0])*(p1[1]-p0[1]);
+
+    // degenerate / NaN
+    if (!(0.0f != area))
+        return FALSE;
+
+    if (TRUE == cull) {
+        if ((S52_SW_CULL_CW ==_cull) && (area < 0.0f)) return FALSE;
+        if ((S52_SW_CULL_CCW==_cull) && (area > 0.0f)) return FALSE;
+    }
+
+    // bbox in tile - skip if off FB
+    float xmin = MIN(p0[0], MIN(p1[0], p2[0]));
+    float xmax = MAX(p0[0], MAX(p1[0], p2[0]));
+    float ymin = MIN(p0[1], MIN(p1[1], p2[1]));
+    float ymax = MAX(p0[1], MAX(p1[1], p2[1]));
+    if ((xmax < 0.0f) || (ymax < 0.0f) || (xmin >= (float)_w) || (ymin >= (float)_h))
+        return FALSE;
+
+    int kx0 = (int)MAX(xmin, 0.0f)               >> TILE_SH;
+    int ky0 = (int)MAX(ymin, 0.0f)               >> TILE_SH;
+    int kx1 = (int)MIN(xmax, (float)_w - 1.0f)   >> TILE_SH;
+    int ky1 = (int)MIN(ymax, (float)_h - 1.0f)   >> TILE_SH;
+
+    _tri t;
+    // CCW
+    const float *q1 = (area > 0.0f) ? p1 : p2;
+    const float *q2 = (area > 0.0f) ? p2 : p1;
+    const float *s1 = (area > 0.0f) ? t1 : t2;
+    const float *s2 = (area > 0.0f) ? t2 : t1;
+    t.x[0] = p0[0]; t.y[0] = p0[1];
+    t.x[1] = q1[0]; t.y[1] = q1[1];
+    t.x[2] = q2[0]; t.y[2] = q2[1];
+    if (NULL != t0) {
+        t.u[0] = t0[0]; t.v[0] = t0[1];
+        t.u[1] = s1[0]; t.v[1] = s1[1];
+        t.u[2] = s2[0]; t.v[2] = s2[1];
+    }
+    t.color = _color;
+    t.tex   = (NULL == t0) ? -1 : _tex;
+    t.cx    = _disc[0];
+    t.cy    = _disc[1];
+    t.r2    = _disc[2];
+
+    guint idx = _tris->len;
+    g_array_append_val(_tris, t);
+
+    for (int ky=ky0; ky<=ky1; ++ky)
+        for (int kx=kx0; kx<=kx1; ++kx)
+            g_array_append_val(_bins[ky*_tw + kx], idx);
+
+    return TRUE;
+}
+
+static int        _addQuad(const float q[4][2], const float uv[4][2])
+// q: CCW or CW - no cull
+{
+    const float *t = (NULL == uv) ? NULL : uv[0];
+
+    _addTri(q[0], q[1], q[2], t, (NULL==uv) ? NULL : uv[1], (NULL==uv) ? NULL : uv[2], FALSE);
+    _addTri(q[0], q[2], q[3], t, (NULL==uv) ? NULL : uv[2], (NULL==uv) ? NULL : uv[3], FALSE);
+
+    return TRUE;
+}
+
+static int        _addLine(const float *p0, const float *p1, const float *t0, const float *t1)
+// GL non-AA wide line: w pixels in the minor axis - in the major axis, pull both
+// end back half a pixel (diamond exit: first pixel drawn, last pixel not), so a
+// strip draw shared vertex once
+{
+    float dx = p1[0] - p0[0];
+    float dy = p1[1] - p0[1];
+    float hw = MAX(_lineW, 1.0f) / 2.0f;
+    float ox = 0.0, oy = 0.0;   // minor axis offset
+    float mx = 0.0, my = 0.0;   // pull back along the line
+
+    if ((0.0f == dx) && (0.0f == dy))
+        return FALSE;
+
+    if (fabsf(dx) >= fabsf(dy)) {
+        // X major
+        oy = hw;
+        mx = (dx > 0.0f) ? -0.5f + 1.0f/256.0f : 0.5f - 1.0f/256.0f;
+        my = mx * dy / dx;
+    } else {
+        // Y major
+        ox = hw;
+        my = (dy > 0.0f) ? -0.5f + 1.0f/256.0f : 0.5f - 1.0f/256.0f;
+        mx = my * dx / dy;
+    }
+
+    const float q[4][2] = {
+        {p0[0] - ox + mx, p0[1] - oy + my},
+        {p1[0] - ox + mx, p1[1] - oy + my},
+        {p1[0] + ox + mx, p1[1] + oy + my},
+        {p0[0] + ox + mx, p0[1] + oy + my}
+    };
+
+    if (NULL == t0)
+        return _addQuad(q, NULL);
+
+    const float uv[4][2] = {
+        {t0[0], t0[1]},
+        {t1[0], t1[1]},
+        {t1[0], t1[1]},
+        {t0[0], t0[1]}
+    };
+
+    return _addQuad(q, uv);
+}
+
+static int        _addPoint(const float *p, int round)
+// round: GL2 afterglow shader - fragment farther than half the size from the center discarded
+{
+    float h = MAX(_pointSz, 1.0f) / 2.0f;
+
+    const float q[4][2] = {
+        {p[0] - h, p[1] - h},
+        {p[0] + h, p[1] - h},
+        {p[0] + h, p[1] + h},
+        {p[0] - h, p[1] + h}
+    };
+
+    if (FALSE == round)
+        return _addQuad(q, NULL);
+
+    _disc[0] = p[0];
+    _disc[1] = p[1];
+    _disc[2] = h * h;
+
+    _addQuad(q, NULL);
+
+    _disc[2] = 0.0;
+
+    return TRUE;
+}
+
+int        S52_SW_init(int w, int h, int nThread)
+{
+    if ((w <= 0) || (h <= 0))
+        return FALSE;
+
+    // resize
+    if ((w != _w) || (h != _h)) {
+        if (NULL != _bins) {
+            for (int k=0; k<_tw*_th; ++k)
+                g_array_free(_bins[k], TRUE);
+            g_free(_bins);
+        }
+
+        _w   = w;
+        _h   = h;
+        _tw  = (w + TILE_SZ - 1) >> TILE_SH;
+        _th  = (h + TILE_SZ - 1) >> TILE_SH;
+        _fb  = g_renew(guchar, _fb, (gsize)w * h * 4);
+        memset(_fb, 0, (gsize)w * h * 4);
+
+        _bins = g_new0(GArray*, _tw * _th);
+        for (int k=0; k<_tw*_th; ++k)
+            _bins[k] = g_array_new(FALSE, FALSE, sizeof(guint));
+    }
+
+    if (NULL == _tris) {
+        _tris = g_array_new(FALSE, FALSE, sizeof(_tri));
+        _texs = g_array_new(FALSE, FALSE, sizeof(S52_SW_tex));
+    }
+
+    if (NULL != _doneQ)
+        return TRUE;
+
+    // thread
+    if (0 == nThread)
+        nThread = (int)g_get_num_processors();
+    _nThread = CLAMP(nThread, 1, MAX_THREAD);
+    _doneQ   = g_async_queue_new();
+
+    for (int i=1; i<_nThread; ++i) {
+        _jobQ[i] = g_async_queue_new();
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+        _thread[i] = g_thread_create(_worker, GINT_TO_POINTER(i), TRUE, NULL);
+#else
+        _thread[i] = g_thread_new("S52SW", _worker, GINT_TO_POINTER(i));
+#endif
+    }
+
+    PRINTF("DEBUG: SW rasteriser %ix%i, %i tile, %i thread\n", _w, _h, _tw*_th, _nThread);
+
+    return TRUE;
+}
+
+int        S52_SW_done(void)
+{
+    if (NULL == _doneQ)
+        return FALSE;
+
+    for (int i=1; i<_nThread; ++i) {
+        g_async_queue_push(_jobQ[i], &_quit);
+        g_thread_join(_thread[i]);
+        g_async_queue_unref(_jobQ[i]);
+        _thread[i] = NULL;
+        _jobQ  [i] = NULL;
+    }
+    g_async_queue_unref(_doneQ);
+    _doneQ = NULL;
+
+    for (int k=0; k<_tw*_th; ++k)
+        g_array_free(_bins[k], TRUE);
+    g_free(_bins);
+    g_free(_fb);
+    g_array_free(_tris, TRUE);
+    g_array_free(_texs, TRUE);
+    _bins = NULL;
+    _fb   = NULL;
+    _tris = NULL;
+    _texs = NULL;
+    _w    = _h  = 0;
+    _tw   = _th = 0;
+
+    return TRUE;
+}
+
+int        S52_SW_begin(void)
+{
+    return_if_null(_fb);
+
+    g_array_set_size(_tris, 0);
+    g_array_set_size(_texs, 0);
+    for (int k=0; k<_tw*_th; ++k)
+        g_array_set_size(_bins[k], 0);
+
+    _tex     = -1;
+    _cull    = S52_SW_CULL_CW;
+    _clearOn = FALSE;
+    _inFrame = TRUE;
+
+    return TRUE;
+}
+
+int        S52_SW_end(void)
+{
+    return_if_null(_fb);
+
+    if (FALSE == _inFrame)
+        return FALSE;
+
+    for (int i=1; i<_nThread; ++i)
+        g_async_queue_push(_jobQ[i], &_job);
+
+    _rasterShare(0);
+
+    for (int i=1; i<_nThread; ++i)
+        g_async_queue_pop(_doneQ);
+
+    _clearOn = FALSE;
+    _inFrame = FALSE;
+
+    return _tris->len;
+}
+
+int        S52_SW_clear(guchar r, guchar g, guchar b, guchar a)
+{
+    return_if_null(_fb);
+
+    _clearC = _rgba(r, g, b, a);
+
+    if (TRUE == _inFrame) {
+        // what is under is hidden - drop it, tile clear in parallel at S52_SW_end()
+        g_array_set_size(_tris, 0);
+        for (int k=0; k<_tw*_th; ++k)
+            g_array_set_size(_bins[k], 0);
+        _clearOn = TRUE;
+    } else {
+        _fill(_fb, _w * _h, _clearC);
+    }
+
+    return TRUE;
+}
+
+int        S52_SW_setPixels(const guchar *rgba)
+{
+    return_if_null(_fb);
+    return_if_null((void*)rgba);
+
+    if (TRUE == _inFrame) {
+        PRINTF("WARNING: in frame\n");
+        return FALSE;
+    }
+
+    memcpy(_fb, rgba, (gsize)_w * _h * 4);
+
+    return TRUE;
+}
+
+guchar    *S52_SW_getPixels(int *w, int *h)
+{
+    if (NULL != w) *w = _w;
+    if (NULL != h) *h = _h;
+
+    return _fb;
+}
+
+int        S52_SW_setColor(guchar r, guchar g, guchar b, guchar a)
+{
+    _color = _rgba(r, g, b, a);
+
+    return TRUE;
+}
+
+int        S52_SW_setLineWidth(float w)
+{
+    _lineW = w;
+
+    return TRUE;
+}
+
+int        S52_SW_setPointSize(float sz)
+{
+    _pointSz = sz;
+
+    return TRUE;
+}
+
+int        S52_SW_setCull(int cull)
+{
+    _cull = cull;
+
+    return TRUE;
+}
+
+int        S52_SW_setTex(const S52_SW_tex *tex)
+{
+    if ((NULL==tex) || (NULL==tex->data) || (0>=tex->w) || (0>=tex->h)) {
+        _tex = -1;
+        return (NULL == tex);
+    }
+
+    // same as last one
+    if (0 <= _tex) {
+        S52_SW_tex *last = &g_array_index(_texs, S52_SW_tex, _tex);
+        if (0 == memcmp(last, tex, sizeof(S52_SW_tex)))
+            return TRUE;
+    }
+
+    _tex = _texs->len;
+    g_array_append_val(_texs, *tex);
+
+    return TRUE;
+}
+
+int        S52_SW_draw(int mode, const float *xy, const float *uv, int stride, int count)
+{
+    return_if_null((void*)xy);
+
+    if (FALSE == _inFrame)
+        return FALSE;
+
+    if (-1 == _tex)
+        uv = NULL;
+
+#define P(i)  (xy + (gsize)(i)*stride)
+#define T(i)  ((NULL == uv) ? NULL : uv + (gsize)(i)*stride)
+
+    switch (mode) {
+        case S52_SW_TRIANGLES:
+            for (int i=0; i+2<count; i+=3)
+                _addTri(P(i), P(i+1), P(i+2), T(i), T(i+1), T(i+2), TRUE);
+            break;
+
+        case S52_SW_TRIANGLE_STRIP:
+            // keep winding: odd triangle swap
+            for (int i=0; i+2<count; ++i) {
+                if (0 == (i & 1))
+                    _addTri(P(i),   P(i+1), P(i+2), T(i),   T(i+1), T(i+2), TRUE);
+                else
+                    _addTri(P(i+1), P(i),   P(i+2), T(i+1), T(i),   T(i+2), TRUE);
+            }
+            break;
+
+        case S52_SW_TRIANGLE_FAN:
+            for (int i=1; i+1<count; ++i)
+                _addTri(P(0), P(i), P(i+1), T(0), T(i), T(i+1), TRUE);
+            break;
+
+        case S52_SW_LINES:
+            for (int i=0; i+1<count; i+=2)
+                _addLine(P(i), P(i+1), T(i), T(i+1));
+            break;
+
+        case S52_SW_LINE_STRIP:
+        case S52_SW_LINE_LOOP:
+            for (int i=0; i+1<count; ++i)
+                _addLine(P(i), P(i+1), T(i), T(i+1));
+            if ((S52_SW_LINE_LOOP==mode) && (2<count))
+                _addLine(P(count-1), P(0), T(count-1), T(0));
+            break;
+
+        case S52_SW_POINTS:
+            for (int i=0; i<count; ++i)
+                _addPoint(P(i), FALSE);
+            break;
+
+        default:
+            PRINTF("WARNING: unknown mode [0x%x]\n", mode);
+            return FALSE;
+    }
+
+#undef P
+#undef T
+
+    return TRUE;
+}
+
+int        S52_SW_drawPointAlpha(const float *xy, const float *alpha, int stride, int count)
+{
+    return_if_null((void*)xy);
+    return_if_null((void*)alpha);
+
+    if (FALSE == _inFrame)
+        return FALSE;
+
+    guint32 color = _color;
+    guchar *c     = (guchar*)&color;
+
+    for (int i=0; i<count; ++i) {
+        float a = alpha[(gsize)i*stride];
+
+        _color = _rgba(c[0], c[1], c[2], (guchar)CLAMP(a*255.0 + 0.5, 0.0, 255.0));
+        _addPoint(xy + (gsize)i*stride, TRUE);
+    }
+
+    _color = color;
+
+    return TRUE;
+}
+
+#endif  // S52_USE_SW
@@ -0,0 +1,86 @@
+// S52SW.h: software rasteriser - tiled, multi-threaded, SIMD span (GPU-less server)
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _S52SW_H_
+#define _S52SW_H_
+
+#include <glib.h>       // guint32, guchar
+
+// primitive - same value as GL
+#define S52_SW_POINTS          0x0000
+#define S52_SW_LINES           0x0001
+#define S52_SW_LINE_LOOP       0x0002
+#define S52_SW_LINE_STRIP      0x0003
+#define S52_SW_TRIANGLES       0x0004
+#define S52_SW_TRIANGLE_STRIP  0x0005
+#define S52_SW_TRIANGLE_FAN    0x0006
+
+// cull (triangle only - line and point never culled)
+#define S52_SW_CULL_NONE       0
+#define S52_SW_CULL_CW         1    // GL_CULL_FACE + glFrontFace(GL_CCW) - default
+#define S52_SW_CULL_CCW        2    // GL_CULL_FACE + glFrontFace(GL_CW)
+
+// alpha texture (pattern, glyph atlas, line stipple) - sampled nearest, wrap repeat
+// Note: data must stay valid until S52_SW_end()
+typedef struct S52_SW_tex {
+    const guchar *data;     // first texel, row 0 is v = 0
+    int           w;        // texel
+    int           h;
+    int           stride;   // byte per row
+    int           bpp;      // byte per texel: 1 (alpha) or 4 (RGBA, alpha is the 4th byte)
+} S52_SW_tex;
+
+// frame buffer: w x h RGBA, row 0 at the bottom (as glReadPixels())
+// nThread: 0 - one per core
+int      S52_SW_init(int w, int h, int nThread);
+int      S52_SW_done(void);
+
+// start a frame - record primitive until S52_SW_end() rasterise all tiles in parallel
+int      S52_SW_begin(void);
+int      S52_SW_end(void);
+
+// clear FB (all primitive recorded before are dropped)
+int      S52_SW_clear(guchar r, guchar g, guchar b, guchar a);
+// copy 'rgba' (w x h) in FB / copy FB to 'rgba' - only outside begin/end
+int      S52_SW_setPixels(const guchar *rgba);
+guchar  *S52_SW_getPixels(int *w, int *h);
+
+// fragment state for the next primitive (blend: SRC_ALPHA, ONE_MINUS_SRC_ALPHA)
+int      S52_SW_setColor(guchar r, guchar g, guchar b, guchar a);
+int      S52_SW_setLineWidth(float w);
+int      S52_SW_setPointSize(float sz);
+int      S52_SW_setCull(int cull);
+// tex: NULL texture off - then 'uv' of S52_SW_draw() is ignored
+// Note: textured fragment take the alpha of the texel, not of the color (as the GL2 shader)
+int      S52_SW_setTex(const S52_SW_tex *tex);
+
+// record 'count' vertex of 'mode' - xy in window pixel (origin bottom left),
+// uv texture coord (NULL if no texture), stride in float of both array
+int      S52_SW_draw(int mode, const float *xy, const float *uv, int stride, int count);
+
+// record 'count' round point (as the GL2 afterglow shader) - the alpha of
+// S52_SW_setColor() is replaced by 'alpha' (0.0 - 1.0) of each vertex
+int      S52_SW_drawPointAlpha(const float *xy, const float *alpha, int stride, int count);
+
+#endif // _S52SW_H_
@@ -0,0 +1,293 @@
+// S52TR.c: trace of the S52_* calls in a binary file - replay with test/s52replay.c
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "S52TR.h"
+#include "S52utils.h"   // PRINTF()
+
+#include <stdio.h>      // FILE
+#include <stdarg.h>     // va_list
+#include <string.h>     // strlen()
+
+
+static const char *_name[S52_TR_NUM] = {
+    "NONE",
+    "S52_init",             "S52_done",             "S52_version",
+    "S52_setEGLCallBack",   "S52_setRADARCallBack",
+    "S52_getMarinerParam",  "S52_setMarinerParam",  "S52_setTextDisp",
+    "S52_getTextDisp",      "S52_setRGB",           "S52_getRGB",
+    "S52_getS57ObjClassSupp","S52_setS57ObjClassSupp",
+    "S52_loadCell",         "S52_doneCell",         "S52_loadUpdate",
+    "S52_loadPLib",         "S52_getPLibNameList",  "S52_getPalettesNameList",
+    "S52_getCellNameList",  "S52_getS57ClassList",  "S52_getObjList",
+    "S52_getAttList",       "S52_getCellExtent",
+    "S52_draw",             "S52_drawLast",         "S52_drawStr",
+    "S52_drawBlit",         "S52_pickAt",           "S52_xy2LL",
+    "S52_LL2xy",            "S52_setView",          "S52_getView",
+    "S52_setViewPort",      "S52_dumpS57IDPixels",
+    "S52_newMarObj",        "S52_getMarObj",        "S52_delMarObj",
+    "S52_toggleDispMarObj", "S52_newCLRLIN",        "S52_newLEGLIN",
+    "S52_newOWNSHP",        "S52_setDimension",     "S52_setVector",
+    "S52_newPASTRK",        "S52_pushPosition",     "S52_newVESSEL",
+    "S52_setVESSELlabel",   "S52_setVESSELstate",   "S52_newVRMEBL",
+    "S52_setVRMEBL",        "S52_newCSYMB",
+    "S52_getDrawTime",
+    "S52_getStats",
+    "S52_newCtx",
+    "S52_setCtx",
+    "S52_delCtx",
+    "S52_setRenderThread",
+    "S52_drawAsync",
+    "S52_drawLastAsync",
+    "S52_waitFence",
+    "S52_xy2LLv",
+    "S52_LL2xyv",
+    "S52_needDraw",
+    "S52_needDrawLast",
+    "S52_setDirtyCallBack",
+    "S52_setLogLevel",
+    "S52_getGPUTime"
+};
+
+const char    *S52_TR_getName(int id)
+{
+    if (S52_TR_RET == id)
+        return "RET";
+
+    if ((id<=S52_TR_NONE) || (S52_TR_NUM<=id))
+        return NULL;
+
+    return _name[id];
+}
+
+#ifdef S52_USE_TRACE
+
+static int      _doInit = TRUE;     // check env S52_TRACE on first call
+static FILE    *_fd     = NULL;     // trace file
+static GTimer  *_timer  = NULL;
+static gulong   _last   = 0;        // usec of the previous record
+static guint    _seq    = 0;        // number of call recorded
+
+#define SEQ_NONE  G_MAXUINT         // call not recorded (internal)
+
+// depth of S52_TR_internal() - per thread
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticMutex   _tr_mutex = G_STATIC_MUTEX_INIT;
+static GStaticPrivate _internal = G_STATIC_PRIVATE_INIT;
+#define GMUTEXLOCK       g_static_mutex_lock
+#define GMUTEXUNLOCK     g_static_mutex_unlock
+#define INTERNALGET()    GPOINTER_TO_INT(g_static_private_get(&_internal))
+#define INTERNALSET(n)   g_static_private_set(&_internal, GINT_TO_POINTER(n), NULL)
+#else
+static GMutex         _tr_mutex;
+static GPrivate       _internal = G_PRIVATE_INIT(NULL);
+#define GMUTEXLOCK       g_mutex_lock
+#define GMUTEXUNLOCK     g_mutex_unlock
+#define INTERNALGET()    GPOINTER_TO_INT(g_private_get(&_internal))
+#define INTERNALSET(n)   g_private_set(&_internal, GINT_TO_POINTER(n))
+#endif
+
+
+static void       _putVarint(guint64 v)
+// LEB128
+{
+    guchar buf[10];
+    int    n = 0;
+
+    do {
+        buf[n] = v & 0x7F;
+        v >>= 7;
+        if (0 != v)
+            buf[n] |= 0x80;
+        ++n;
+    } while (0 != v);
+
+    fwrite(buf, 1, n, _fd);
+}
+
+static void       _putDouble(double d)
+{
+    union { double d; guint64 u; } v = {d};
+    guint64 le = GUINT64_TO_LE(v.u);
+
+    fwrite(&le, sizeof(le), 1, _fd);
+}
+
+static void       _putHeader(guchar id)
+{
+    gulong now = (gulong)(g_timer_elapsed(_timer, NULL) * 1000000.0);
+
+    fputc(id, _fd);
+    _putVarint(now - _last);
+    _last = now;
+}
+
+static int        _open(void)
+{
+    _doInit = FALSE;
+
+    const char *path = g_getenv("S52_TRACE");
+    if (NULL == path)
+        return FALSE;
+
+    _fd = fopen(path, "wb");
+    if (NULL == _fd) {
+        PRINTF("WARNING: can't open trace file: %s\n", path);
+        return FALSE;
+    }
+
+    const guchar hdr[8] = {'S','5','2','T','R', 0, S52_TR_VERSION, 0};
+    fwrite(hdr, 1, sizeof(hdr), _fd);
+
+    _timer = g_timer_new();
+    _last  = 0;
+    _seq   = 0;
+
+    PRINTF("NOTE: trace S52_* call in %s\n", path);
+
+    return TRUE;
+}
+
+guint          S52_TR_call(S52_TR_id id, const char *sig, ...)
+{
+    guint seq = SEQ_NONE;
+
+    if (0 < INTERNALGET())
+        return SEQ_NONE;
+
+    GMUTEXLOCK(&_tr_mutex);
+
+    if (TRUE == _doInit)
+        _open();
+
+    if (NULL == _fd)
+        goto exit;
+
+    _putHeader((guchar)id);
+
+    va_list ap;
+    va_start(ap, sig);
+    for (const char *c=sig; '\0'!=*c; ++c) {
+        switch (*c) {
+            case 'i': {
+                gint32 i = va_arg(ap, int);
+                _putVarint((guint32)((i << 1) ^ (i >> 31)));  // zigzag
+                break;
+            }
+            case 'u': _putVarint(va_arg(ap, unsigned int)); break;
+            case 'd': _putDouble(va_arg(ap, double));       break;
+            case 's': {
+                const char *s = va_arg(ap, const char *);
+                if (NULL == s) {
+                    _putVarint(0);
+                } else {
+                    gsize len = strlen(s);
+                    _putVarint(len + 1);
+                    fwrite(s, 1, len, _fd);
+                }
+                break;
+            }
+            case 'a': {
+                unsigned int n = va_arg(ap, unsigned int);
+                double      *a = va_arg(ap, double *);
+                if (NULL == a) {
+                    _putVarint(0);
+                } else {
+                    _putVarint((guint64)n + 1);
+                    for (unsigned int k=0; k<n; ++k)
+                        _putDouble(a[k]);
+                }
+                break;
+            }
+            case 'P': {
+                double *p = va_arg(ap, double *);
+                _putDouble((NULL == p) ? 0.0 : *p);
+                break;
+            }
+            default:
+                PRINTF("WARNING: unknown trace signature '%c' (%s)\n", *c, S52_TR_getName(id));
+                g_assert(0);
+        }
+    }
+    va_end(ap);
+
+    // field capture: keep file usable if the app die
+    if ((S52_TR_draw==id) || (S52_TR_done==id))
+        fflush(_fd);
+
+    seq = _seq++;
+
+exit:
+    GMUTEXUNLOCK(&_tr_mutex);
+
+    return seq;
+}
+
+int            S52_TR_ret(guint seq, guint objH)
+{
+    if (SEQ_NONE == seq)
+        return TRUE;
+
+    GMUTEXLOCK(&_tr_mutex);
+
+    if (NULL != _fd) {
+        _putHeader(S52_TR_RET);
+        _putVarint(seq);
+        _putVarint(objH);
+    }
+
+    GMUTEXUNLOCK(&_tr_mutex);
+
+    return TRUE;
+}
+
+int            S52_TR_internal(int on)
+{
+    int n = INTERNALGET() + ((TRUE == on) ? 1 : -1);
+
+    INTERNALSET(MAX(n, 0));
+
+    return TRUE;
+}
+
+int            S52_TR_close(void)
+{
+    GMUTEXLOCK(&_tr_mutex);
+
+    if (NULL != _fd) {
+        fclose(_fd);
+        _fd = NULL;
+    }
+    if (NULL != _timer) {
+        g_timer_destroy(_timer);
+        _timer = NULL;
+    }
+
+    // next S52_init() check env again
+    _doInit = TRUE;
+
+    GMUTEXUNLOCK(&_tr_mutex);
+
+    return TRUE;
+}
+
+#endif  // S52_USE_TRACE
@@ -0,0 +1,162 @@
+// S52TR.h: trace of the S52_* calls in a binary file - replay with test/s52replay.c
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _S52TR_H_
+#define _S52TR_H_
+
+#include <glib.h>       // guint
+
+// Trace is ON when env S52_TRACE is set to a file name at the first S52_* call.
+//
+// File: header "S52TR" 0 <version> 0, then one record per call:
+//   <id:u8> <dt:varint> <arg> ..
+//   dt : usec since the previous record
+//   arg: as the signature of the call (see S52TR.c)
+//        'i' int        - zigzag varint
+//        'u' uint       - varint
+//        'd' double     - 8 bytes, little endian
+//        's' string     - varint len+1 (0 - NULL), bytes (no '\0')
+//        'a' double[]   - varint n+1 (0 - NULL), n double
+//        'P' double*    - 8 bytes, the value pointed to (in/out param)
+//   id S52_TR_RET: <seq:varint> <objH:varint> - handle returned by call number 'seq'
+//   (call are numbered from 0 in file order) - replay map old handle to new handle
+
+#define S52_TR_MAGIC   "S52TR"
+#define S52_TR_VERSION 1
+
+typedef enum S52_TR_id {
+    S52_TR_NONE = 0,
+
+    // lib
+    S52_TR_init,
+    S52_TR_done,
+    S52_TR_version,
+    S52_TR_setEGLCallBack,  // replay use its own EGL
+    S52_TR_setRADARCallBack,// not replayed
+
+    // param
+    S52_TR_getMarinerParam,
+    S52_TR_setMarinerParam,
+    S52_TR_setTextDisp,
+    S52_TR_getTextDisp,
+    S52_TR_setRGB,
+    S52_TR_getRGB,
+    S52_TR_getS57ObjClassSupp,
+    S52_TR_setS57ObjClassSupp,
+
+    // cell / plib
+    S52_TR_loadCell,
+    S52_TR_doneCell,
+    S52_TR_loadUpdate,
+    S52_TR_loadPLib,
+    S52_TR_getPLibNameList,
+    S52_TR_getPalettesNameList,
+    S52_TR_getCellNameList,
+    S52_TR_getS57ClassList,
+    S52_TR_getObjList,
+    S52_TR_getAttList,
+    S52_TR_getCellExtent,
+
+    // draw / view
+    S52_TR_draw,
+    S52_TR_drawLast,
+    S52_TR_drawStr,
+    S52_TR_drawBlit,
+    S52_TR_pickAt,
+    S52_TR_xy2LL,
+    S52_TR_LL2xy,
+    S52_TR_setView,
+    S52_TR_getView,
+    S52_TR_setViewPort,
+    S52_TR_dumpS57IDPixels,
+
+    // mariner object
+    S52_TR_newMarObj,
+    S52_TR_getMarObj,
+    S52_TR_delMarObj,
+    S52_TR_toggleDispMarObj,
+    S52_TR_newCLRLIN,
+    S52_TR_newLEGLIN,
+    S52_TR_newOWNSHP,
+    S52_TR_setDimension,
+    S52_TR_setVector,
+    S52_TR_newPASTRK,
+    S52_TR_pushPosition,
+    S52_TR_newVESSEL,
+    S52_TR_setVESSELlabel,
+    S52_TR_setVESSELstate,
+    S52_TR_newVRMEBL,
+    S52_TR_setVRMEBL,
+    S52_TR_newCSYMB,
+
+    // added after version 1 - append only (id of older trace stay valid)
+    S52_TR_getDrawTime,
+    S52_TR_getStats,
+    S52_TR_newCtx,
+    S52_TR_setCtx,
+    S52_TR_delCtx,
+    S52_TR_setRenderThread, // not replayed (render thread S52_draw() are traced)
+    S52_TR_drawAsync,       // not replayed
+    S52_TR_drawLastAsync,   // not replayed
+    S52_TR_waitFence,       // not replayed
+    S52_TR_xy2LLv,
+    S52_TR_LL2xyv,
+    S52_TR_needDraw,
+    S52_TR_needDrawLast,
+    S52_TR_setDirtyCallBack,// not replayed
+    S52_TR_setLogLevel,
+    S52_TR_getGPUTime,
+
+    S52_TR_NUM,
+
+    S52_TR_RET  = 0xFF      // handle returned by a call
+} S52_TR_id;
+
+// name of a call ("S52_setView", ..)
+const char *S52_TR_getName(int id);
+
+#ifdef S52_USE_TRACE
+// record a call - return its number (seq)
+guint S52_TR_call(S52_TR_id id, const char *sig, ...);
+// record the handle returned by call number 'seq'
+int   S52_TR_ret (guint seq, guint objH);
+// call made by libS52 itself in this thread (Chart Manager load, s52.cfg watch)
+// are not recorded - replay redo them (nest: TRUE .. FALSE)
+int   S52_TR_internal(int on);
+// flush and close trace file (S52_done())
+int   S52_TR_close(void);
+
+#define S52_TR_CALL(id, ...)     S52_TR_call(id, __VA_ARGS__)
+// for call that return a new handle
+#define S52_TR_CALL_SEQ(id, ...) guint _trSeq = S52_TR_call(id, __VA_ARGS__)
+#define S52_TR_RET(objH)         S52_TR_ret(_trSeq, objH)
+#define S52_TR_INTERNAL(on)      S52_TR_internal(on)
+#else
+#define S52_TR_CALL(id, ...)
+#define S52_TR_CALL_SEQ(id, ...)
+#define S52_TR_RET(objH)
+#define S52_TR_INTERNAL(on)
+#endif  // S52_USE_TRACE
+
+#endif // _S52TR_H_
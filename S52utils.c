@@ -30,6 +30,16 @@
 #include <stdlib.h>        // atoi(), atof()
 #include <string.h>        // strlen()
 #include <unistd.h>        // write()
+#include <time.h>          // time()
+
+#ifdef S52_USE_LOG_ASYNC
+#include "S52LG.h"         // S52_LG_beg()
+#endif
+
+#ifdef S52_USE_CFG_WATCH
+#include <sys/inotify.h>   // inotify_init1()
+#include <poll.h>          // poll()
+#endif
 
 // debug - configuration file
 #ifdef S52_USE_ANDROID
@@ -69,9 +79,51 @@ static const char _version[] = S52_VERSION
 #ifdef  S52_USE_PROJ
       ",S52_USE_PROJ"
 #endif
+#ifdef  S52_USE_ISO8211
+      ",S52_USE_ISO8211"
+#endif
+#ifdef  S52_USE_ARENA
+      ",S52_USE_ARENA"
+#endif
+#ifdef  S52_USE_CHART_MANAGER
+      ",S52_USE_CHART_MANAGER"
+#endif
 #ifdef  S52_USE_SUPP_LINE_OVERLAP
       ",S52_USE_SUPP_LINE_OVERLAP"
 #endif
+#ifdef  S52_USE_TRACE
+      ",S52_USE_TRACE"
+#endif
+#ifdef  S52_USE_CTX
+      ",S52_USE_CTX"
+#endif
+#ifdef  S52_USE_RENDER_THREAD
+      ",S52_USE_RENDER_THREAD"
+#endif
+#ifdef  S52_USE_LOG_ASYNC
+      ",S52_USE_LOG_ASYNC"
+#endif
+#ifdef  S52_USE_CFG_WATCH
+      ",S52_USE_CFG_WATCH"
+#endif
+#ifdef  S52_USE_GPU_TIMER
+      ",S52_USE_GPU_TIMER"
+#endif
+#ifdef  S52_USE_SW
+      ",S52_USE_SW"
+#endif
+#ifdef  S52_USE_EARCUT
+      ",S52_USE_EARCUT"
+#endif
+#ifdef  S52_USE_STENCIL_FILL
+      ",S52_USE_STENCIL_FILL"
+#endif
+#ifdef  S52_USE_SCAMIN_BIN
+      ",S52_USE_SCAMIN_BIN"
+#endif
+#ifdef  S52_USE_SYM_ATLAS
+      ",S52_USE_SYM_ATLAS"
+#endif
 #ifdef  S52_DEBUG
       ",S52_DEBUG"
 #endif
@@ -157,102 +209,458 @@ CCHAR   *S52_utils_version(void)
     return _version;
 }
 
+//////////////////////////////////////////////////////////
+//
+// config: s52.cfg parsed once in a hash table (label --> _cfgEntry)
+//
+
+typedef struct _cfgEntry {
+    gchar   *str;        // value (the rest of the line)
+    double   num;        // value as number
+    gboolean isNum;      // str is a number
+} _cfgEntry;
+
+static GHashTable *_cfg       = NULL;   // label --> _cfgEntry - _cfg_mutex
+static gboolean    _cfgLoaded = FALSE;  // try to load s52.cfg once - reload on S52_utils_loadConfig()
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticMutex _cfg_mutex     = G_STATIC_MUTEX_INIT;  // _cfg
+static GStaticMutex _cfgLoad_mutex = G_STATIC_MUTEX_INIT;  // one (re)load at a time
+#define GCFGLOCK         g_static_mutex_lock
+#define GCFGUNLOCK       g_static_mutex_unlock
+#define GCFGLOADLOCK     g_static_mutex_lock
+#define GCFGLOADUNLOCK   g_static_mutex_unlock
+#else
+static GMutex       _cfg_mutex;                            // _cfg
+static GMutex       _cfgLoad_mutex;                        // one (re)load at a time
+#define GCFGLOCK         g_mutex_lock
+#define GCFGUNLOCK       g_mutex_unlock
+#define GCFGLOADLOCK     g_mutex_lock
+#define GCFGLOADUNLOCK   g_mutex_unlock
+#endif
+
+static void       _cfgFree(gpointer data)
+{
+    _cfgEntry *e = (_cfgEntry*) data;
+
+    g_free(e->str);
+    g_free(e);
+}
+
+static GHashTable*_cfgParse(void)
+// return table of s52.cfg, NULL if no file
+{
+    char lbuf[MAXL];
+    char vbuf[MAXL];
+    char frmt[MAXL];
+    char str [MAXL];
+
+    FILE *fp = g_fopen(CFG_NAME, "r");
+    if (NULL == fp) {
+        PRINTF("WARNING: .cfg not found: %s\n", CFG_NAME);
+        return NULL;
+    }
+
+    GHashTable *cfg = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, _cfgFree);
+
+    // prevent buffer overflow
+    SNPRINTF(frmt, MAXL, "%s%i%s%i%s", " %", MAXL-1, "s %", MAXL-1, "[^\n]");
+
+    while (NULL != fgets(str, MAXL, fp)) {
+        if ('#' == str[0])
+            continue;
+
+        vbuf[0] = '\0';
+        if (sscanf(str, frmt, lbuf, vbuf) < 1)
+            continue;
+
+        // first label win (as the old scan)
+        if (NULL != g_hash_table_lookup(cfg, lbuf))
+            continue;
+
+        _cfgEntry *e = g_new0(_cfgEntry, 1);
+        e->str = g_strchomp(g_strdup(vbuf));
+
+        char *end = NULL;
+        e->num   = g_ascii_strtod(e->str, &end);
+        e->isNum = ((end != e->str) && ('\0' == *end)) ? TRUE : FALSE;
+
+        PRINTF("--->>> label:%s value:%s \n", lbuf, e->str);
+
+        g_hash_table_insert(cfg, g_strdup(lbuf), e);
+    }
+
+    fclose(fp);
+
+    return cfg;
+}
+
+static _cfgEntry *_cfgGet(CCHAR *label)
+// Note: _cfg_mutex locked
+{
+    if (FALSE == _cfgLoaded) {
+        _cfg       = _cfgParse();
+        _cfgLoaded = TRUE;
+    }
+
+    if ((NULL==_cfg) || (NULL==label))
+        return NULL;
+
+    return (_cfgEntry*) g_hash_table_lookup(_cfg, label);
+}
+
 int      S52_utils_getConfig(CCHAR *label, char *vbuf)
 // return TRUE and string value in vbuf for label, FALSE if fail
 {
-   FILE *fp;
-   //int  ret;
-   int  nline = 1;
-   //char lbuf[PATH_MAX];
-   //char frmt[PATH_MAX];
-   char lbuf[MAXL];
-   char frmt[MAXL];
-   char str [MAXL];
-   char *pstr = NULL;
-
-   fp = g_fopen(CFG_NAME, "r");
-   if (NULL == fp) {
-       PRINTF("WARNING: .cfg not found: %s\n", CFG_NAME);
-       return FALSE;
-   }
-
-   // prevent buffer overflow
-   SNPRINTF(frmt, MAXL, "%s%i%s", " %s %", MAXL-1, "[^\n]s");
-   //printf("frmt:%s\n", frmt);
-
-   pstr = fgets(str, MAXL, fp);
-   while (NULL != pstr) {
-       // debug
-       //printf("%i - label:%s value:%s\n", nline, lbuf, vbuf);
-
-       if ('#' != str[0]) {
-           //ret = sscanf(str, frmt, lbuf, vbuf);
-           sscanf(str, frmt, lbuf, vbuf);
-           if (0 == g_strcmp0(lbuf, label)) {
-               PRINTF("--->>> label:%s value:%s \n", lbuf, vbuf);
-               fclose(fp);
-               return TRUE;
-           }
-       }
-
-       ++nline;
-       pstr = fgets(str, MAXL, fp);
-   }
-
-   fclose(fp);
-
-   vbuf[0] = '\0';
-
-   return FALSE;
+    return_if_null(vbuf);
+
+    int ret = FALSE;
+
+    GCFGLOCK(&_cfg_mutex);
+
+    _cfgEntry *e = _cfgGet(label);
+    if (NULL != e) {
+        g_strlcpy(vbuf, e->str, MAXL);
+        ret = TRUE;
+    } else {
+        vbuf[0] = '\0';
+    }
+
+    GCFGUNLOCK(&_cfg_mutex);
+
+    return ret;
+}
+
+int      S52_utils_getConfigInt(CCHAR *label, int def)
+// return value of label, def if no label or not a number
+{
+    int val = def;
+
+    GCFGLOCK(&_cfg_mutex);
+
+    _cfgEntry *e = _cfgGet(label);
+    if ((NULL!=e) && (TRUE==e->isNum))
+        val = (int) e->num;
+
+    GCFGUNLOCK(&_cfg_mutex);
+
+    return val;
+}
+
+double   S52_utils_getConfigDbl(CCHAR *label, double def)
+// return value of label, def if no label or not a number
+{
+    double val = def;
+
+    GCFGLOCK(&_cfg_mutex);
+
+    _cfgEntry *e = _cfgGet(label);
+    if ((NULL!=e) && (TRUE==e->isNum))
+        val = e->num;
+
+    GCFGUNLOCK(&_cfg_mutex);
+
+    return val;
+}
+
+int      S52_utils_loadConfig(S52_utils_cfg_cb cb, void *user_data)
+// (re)parse s52.cfg - call cb for each label new or changed since the last load
+// return the number of label new or changed, -1 if no file
+{
+    GCFGLOADLOCK(&_cfgLoad_mutex);
+
+    GHashTable *cfg = _cfgParse();
+    if (NULL == cfg) {
+        GCFGLOADUNLOCK(&_cfgLoad_mutex);
+        return -1;
+    }
+
+    GCFGLOCK(&_cfg_mutex);
+    GHashTable *old = _cfg;
+    _cfg       = cfg;
+    _cfgLoaded = TRUE;
+    GCFGUNLOCK(&_cfg_mutex);
+
+    // Note: cfg is only read from here on (_cfgLoad_mutex)
+    // cb can then use the getter without deadlock
+    int            n = 0;
+    GHashTableIter iter;
+    gpointer       key, value;
+    g_hash_table_iter_init(&iter, cfg);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        _cfgEntry *e = (_cfgEntry*) value;
+        _cfgEntry *o = (NULL==old) ? NULL : (_cfgEntry*) g_hash_table_lookup(old, key);
+
+        if ((NULL!=o) && (0==g_strcmp0(o->str, e->str)))
+            continue;
+
+        ++n;
+        if (NULL != cb)
+            cb((CCHAR*)key, e->str, user_data);
+    }
+
+    if (NULL != old)
+        g_hash_table_destroy(old);
+
+    GCFGLOADUNLOCK(&_cfgLoad_mutex);
+
+    return n;
+}
+
+int      S52_utils_doneConfig(void)
+{
+#ifdef S52_USE_CFG_WATCH
+    S52_utils_unwatchConfig();
+#endif
+
+    GCFGLOADLOCK(&_cfgLoad_mutex);
+    GCFGLOCK(&_cfg_mutex);
+    if (NULL != _cfg)
+        g_hash_table_destroy(_cfg);
+    _cfg       = NULL;
+    _cfgLoaded = FALSE;
+    GCFGUNLOCK(&_cfg_mutex);
+    GCFGLOADUNLOCK(&_cfgLoad_mutex);
+
+    return TRUE;
+}
+
+#ifdef S52_USE_CFG_WATCH
+// watch the folder of s52.cfg (editor often write a new file then rename it)
+#define CFG_WATCH_POLL 250    // msec - check _cfgQuit
+
+static GThread         *_cfgThread = NULL;
+static gint             _cfgQuit   = FALSE;
+static int              _cfgFd     = -1;    // inotify
+static S52_utils_cfg_cb _cfgCB     = NULL;
+static void            *_cfgUData  = NULL;
+
+static gpointer   _cfgWatch(gpointer data)
+{
+    (void)data;
+
+    gchar *base = g_path_get_basename(CFG_NAME);
+    char   buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+
+    while (FALSE == g_atomic_int_get(&_cfgQuit)) {
+        struct pollfd pfd = {_cfgFd, POLLIN, 0};
+        if (poll(&pfd, 1, CFG_WATCH_POLL) <= 0)
+            continue;
+
+        ssize_t len = read(_cfgFd, buf, sizeof(buf));
+        if (len <= 0)
+            continue;
+
+        gboolean hit = FALSE;
+        for (char *p = buf; p < buf + len; ) {
+            struct inotify_event *ev = (struct inotify_event*) p;
+            if ((0<ev->len) && (0==g_strcmp0(ev->name, base)))
+                hit = TRUE;
+            p += sizeof(struct inotify_event) + ev->len;
+        }
+
+        if ((TRUE==hit) && (0<S52_utils_loadConfig(_cfgCB, _cfgUData))) {
+            PRINTF("NOTE: %s changed\n", CFG_NAME);
+        }
+    }
+
+    g_free(base);
+
+    return NULL;
+}
+
+int      S52_utils_watchConfig(S52_utils_cfg_cb cb, void *user_data)
+// cb is called from the watch thread
+{
+    if (NULL != _cfgThread) {
+        PRINTF("WARNING: already watching %s\n", CFG_NAME);
+        return FALSE;
+    }
+
+    _cfgFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (-1 == _cfgFd) {
+        PRINTF("WARNING: inotify_init1() failed\n");
+        return FALSE;
+    }
+
+    gchar *dir = g_path_get_dirname(CFG_NAME);
+    int    wd  = inotify_add_watch(_cfgFd, dir, IN_CLOSE_WRITE | IN_MOVED_TO);
+    g_free(dir);
+    if (-1 == wd) {
+        PRINTF("WARNING: inotify_add_watch() failed: %s\n", CFG_NAME);
+        close(_cfgFd);
+        _cfgFd = -1;
+        return FALSE;
+    }
+
+    _cfgCB    = cb;
+    _cfgUData = user_data;
+    g_atomic_int_set(&_cfgQuit, FALSE);
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+    if (!g_thread_supported())
+        g_thread_init(NULL);
+    _cfgThread = g_thread_create(_cfgWatch, NULL, TRUE, NULL);
+#else
+    _cfgThread = g_thread_new("S52cfg", _cfgWatch, NULL);
+#endif
+
+    return TRUE;
+}
+
+int      S52_utils_unwatchConfig(void)
+// Note: cb might be running - caller must not hold a lock that cb take
+{
+    if (NULL == _cfgThread)
+        return FALSE;
+
+    g_atomic_int_set(&_cfgQuit, TRUE);
+    g_thread_join(_cfgThread);
+    _cfgThread = NULL;
+
+    // also remove the watch
+    close(_cfgFd);
+    _cfgFd = -1;
+
+    _cfgCB    = NULL;
+    _cfgUData = NULL;
+
+    return TRUE;
 }
+#endif  // S52_USE_CFG_WATCH
 
 #if defined(S52_DEBUG) || defined(S52_USE_LOGFILE)
+// runtime log level - S52_setLogLevel(), env S52_LOG_LEVEL
+static gint       _logLevel = S52_LOG_DEBUG;
+
+// rate limit per call site (file:line) - approximate, lock free
+// a site logging more than LOG_RATE_MAX msg in a second is muted until the next second
+#define LOG_RATE_MAX   20
+#define LOG_RATE_SLOT  1024    // hash of call site
+typedef struct _logRate {
+    gint sec;
+    gint n;
+    gint drop;
+} _logRate;
+static _logRate   _logRates[LOG_RATE_SLOT];
+
+static int        _msgLevel(const char *frmt)
+// level from the message prefix
+{
+    if (0 == strncmp(frmt, "ERROR:",   6)) return S52_LOG_ERROR;
+    if (0 == strncmp(frmt, "WARNING:", 8)) return S52_LOG_WARNING;
+    if (0 == strncmp(frmt, "NOTE:",    5)) return S52_LOG_NOTE;
+
+    // DEBUG:, FIXME:, no prefix
+    return S52_LOG_DEBUG;
+}
+
+static int        _rateOK(const char *file, int line, int *drop)
+// TRUE if this call site can log, drop: message muted in the last second
+{
+    guint     h   = (GPOINTER_TO_UINT(file) ^ ((guint)line * 2654435761u)) & (LOG_RATE_SLOT-1);
+    _logRate *r   = &_logRates[h];
+    gint      sec = (gint) time(NULL);
+
+    *drop = 0;
+
+    if (sec != g_atomic_int_get(&r->sec)) {
+        g_atomic_int_set(&r->sec, sec);
+        g_atomic_int_set(&r->n,   0);
+        *drop = g_atomic_int_get(&r->drop);
+        g_atomic_int_add(&r->drop, -*drop);
+    }
+
+    g_atomic_int_inc(&r->n);
+    if (LOG_RATE_MAX < g_atomic_int_get(&r->n)) {
+        g_atomic_int_inc(&r->drop);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static void       _logSink(const char *str)
+// where a message end up
+{
+    printf("%s", str);
+
+#if !defined(S52_USE_LOGFILE)
+    // if user set a callback .. call it,
+    // unless logging to file witch will call the cb
+    if (NULL != _log_cb) {
+        _log_cb(str);
+    }
+#endif
+}
+
 void _printf(const char *file, int line, const char *function, const char *frmt, ...)
-// FIXME: filter msg type: NOTE:, DEBUG:, FIXME:, WARNING:, ERROR:
 {
+    int level = _msgLevel(frmt);
+    if (level > g_atomic_int_get(&_logLevel))
+        return;
+
+    int drop = 0;
+    if ((S52_LOG_ERROR!=level) && (FALSE==_rateOK(file, line, &drop)))
+        return;
+
     int  MAX = 1024;
     char buf[MAX];
-    char headerfrmt[] = "%s:%i in %s(): ";
-    int  size = snprintf(buf, MAX, headerfrmt, file, line, function);
+    char *pbuf = buf;
+
+#ifdef S52_USE_LOG_ASYNC
+    // ERROR is sync - often followed by g_assert(0)
+    if ((S52_LOG_ERROR!=level) && (TRUE==S52_LG_isOn())) {
+        pbuf = S52_LG_beg();
+        if (NULL == pbuf)
+            return;  // ring full - counted
+        MAX  = S52_LG_MSG_SZ;
+    }
+#endif
+
+    int size = 0;
+    if (0 != drop)
+        size = snprintf(pbuf, MAX, "%s:%i: %i message muted (rate limit)\n", file, line, drop);
+    if (size < MAX)
+        size += snprintf(pbuf+size, MAX-size, "%s:%i in %s(): ", file, line, function);
 
     if (size < MAX) {
         va_list argptr;
         va_start(argptr, frmt);
-        int n = vsnprintf(&buf[size], (MAX-size), frmt, argptr);
+        int n = vsnprintf(&pbuf[size], (MAX-size), frmt, argptr);
         va_end(argptr);
 
-        char bufFinal[size + n + 1];
-        memcpy(bufFinal, buf, size);
-        va_start(argptr, frmt);
-        //int nn = vsnprintf(&buf[size], (MAX-size), frmt, argptr);
-        int nn = vsnprintf(&bufFinal[size], (n+1), frmt, argptr);
-        va_end(argptr);
-
-        printf("%s", bufFinal);
-
-#if !defined(S52_USE_LOGFILE)
-        // if user set a callback .. call it,
-        // unless logging to file witch will call the cb
-        if (NULL != _log_cb) {
-            _log_cb(bufFinal);
-        }
-#endif
-
-        if (nn > (n+1)) {
-        //if (n > (MAX-size)) {
-            //g_print("WARNING: _printf(): string buffer FULL, str len:%i, buf len:%i\n", n, (MAX-size));
-            g_message("WARNING: _printf(): string buffer FULL, str len:%i, buf len:%i\n", nn, (n+1));
-            g_assert(0);
+        // truncated - keep the newline
+        if (n >= (MAX-size)) {
+            pbuf[MAX-2] = '\n';
+            pbuf[MAX-1] = '\0';
         }
     } else {
-        // FIXME: use printf() or g_message / g_error !
-        g_message("WARNING: _printf(): buf FULL, str size:%i, buf len:%i\n", size, MAX);
-        g_assert(0);
+        pbuf[MAX-1] = '\0';
     }
 
+#ifdef S52_USE_LOG_ASYNC
+    if (pbuf != buf) {
+        S52_LG_end();
+        return;
+    }
+#endif
+
+    _logSink(pbuf);
+
     return;
 }
 
+int      S52_utils_setLogLevel(int level)
+{
+    if ((level < S52_LOG_ERROR) || (S52_LOG_DEBUG < level))
+        return FALSE;
+
+    g_atomic_int_set(&_logLevel, level);
+
+    return TRUE;
+}
+
 #ifdef S52_USE_LOGFILE
 static void     _S52_printf(cchar *string)
 {
@@ -289,6 +697,16 @@ int      S52_utils_initLog(S52_log_cb log_cb)
         _log_cb = log_cb;
     }
 
+    {   // 0 ERROR, 1 WARNING, 2 NOTE, 3 DEBUG
+        const char *level = g_getenv("S52_LOG_LEVEL");
+        if (NULL != level)
+            S52_utils_setLogLevel(S52_atoi(level));
+    }
+
+#ifdef S52_USE_LOG_ASYNC
+    S52_LG_init(_logSink);
+#endif
+
 #ifdef S52_USE_LOGFILE
     GError *error = NULL;
     _logFile = g_file_open_tmp("XXXXXX", NULL, &error);
@@ -313,6 +731,11 @@ int      S52_utils_initLog(S52_log_cb log_cb)
 
 int      S52_utils_doneLog()
 {
+#ifdef S52_USE_LOG_ASYNC
+    // flush - before _log_cb is gone
+    S52_LG_done();
+#endif
+
     _log_cb = NULL;
 
 #ifdef S52_USE_LOGFILE
@@ -38,7 +38,7 @@
 #include <string.h>
 #include <stdarg.h>
 
-// FIXME: filter msg type: NOTE:, DEBUG:, FIXME:, WARNING:, ERROR:
+// level from msg prefix: ERROR:, WARNING:, NOTE:, (DEBUG:, FIXME:, none) - see S52_setLogLevel()
 void _printf(const char *file, int line, const char *function, const char *frmt, ...);
 #define PRINTF(...) _printf(__FILE__, __LINE__, __func__, __VA_ARGS__)
 #else    // S52_DEBUG  S52_USE_LOGFILE
@@ -65,15 +65,30 @@ if (NULL==ptr) {                             \
 #define CFG_CHART    "CHART"
 #define CFG_WORLD    "WORLD"
 #define CFG_TTF      "TTF"
+#define CFG_CM_BUDGET "CM_BUDGET"
+#define CFG_SW_THREAD "SW_THREAD"
+#define CFG_STENCIL_FILL_NPT "STENCIL_FILL_NPT"
 
 #define MAXL 1024    // MAX lenght of buffer _including_ '\0'
 typedef char valueBuf[MAXL];
 
-int      S52_utils_getConfig(CCHAR *label, char *vbuf);
+// s52.cfg parsed once - cb: label new or changed on (re)load
+typedef void (*S52_utils_cfg_cb)(CCHAR *label, CCHAR *value, void *user_data);
+int      S52_utils_getConfig   (CCHAR *label, char *vbuf);
+int      S52_utils_getConfigInt(CCHAR *label, int    def);
+double   S52_utils_getConfigDbl(CCHAR *label, double def);
+int      S52_utils_loadConfig  (S52_utils_cfg_cb cb, void *user_data);
+int      S52_utils_doneConfig  (void);
+#ifdef S52_USE_CFG_WATCH
+// reload on change (inotify)
+int      S52_utils_watchConfig  (S52_utils_cfg_cb cb, void *user_data);
+int      S52_utils_unwatchConfig(void);
+#endif
 
 CCHAR   *S52_utils_version(void);
 int      S52_utils_initLog(S52_log_cb log_cb);
 int      S52_utils_doneLog(void);
+int      S52_utils_setLogLevel(int level);
 
 int      S52_atoi(CCHAR *str);
 double   S52_atof(CCHAR *str);
@@ -92,6 +107,18 @@ char    *S52_utils_new0(size_t sz, int n);
 // quiet compiler warning on unused param
 #define UNUSED(expr) do { (void)(expr); } while (0)
 
+// thread local - pointer to the context state of the drawing thread (see S52_newCtx())
+// Note: GPrivate is a call at each access, this is in the hot path of the render
+#ifdef S52_USE_CTX
+#ifdef _MSC_VER
+#define S52_TLS __declspec(thread)
+#else
+#define S52_TLS __thread
+#endif
+#else
+#define S52_TLS
+#endif
+
 
 
 /*
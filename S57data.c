@@ -21,12 +21,24 @@
 */
 
 
+#ifdef S52_USE_ARENA
+// MAP_ANONYMOUS is not POSIX - hidden by -std=c99
+#define _DEFAULT_SOURCE
+#define _BSD_SOURCE
+#endif
+
 #include "S57data.h"    // S57_geo
 #include "S52utils.h"   // PRINTF()
 
 #define _ISOC99_SOURCE
 #include <math.h>       // INFINITY, NAN, nearbyint()
 
+#ifdef S52_USE_ARENA
+#include <sys/mman.h>   // mmap(), munmap()
+#include <unistd.h>     // sysconf()
+#include <string.h>     // memset()
+#endif
+
 #ifdef S52_USE_PROJ
 static projPJ      _pjsrc   = NULL;   // projection source
 static projPJ      _pjdst   = NULL;   // projection destination
@@ -40,6 +52,18 @@ static const char *_argssrc = "+proj=latlong +ellps=WGS84 +datum=WGS84";
 // FIXME: test POLAR ENC omerc:
 //  "+proj=omerc +lat_0=4 +lonc=115 +alpha=53.31582047222222 +k=0.99984 +x_0=590476.8727431979 +y_0=442857.6545573985
 //   +ellps=evrstSS +towgs84=-533.4,669.2,-52.5,0,0,4.28,9.4 +to_meter=0.3047994715386762 +no_defs ";
+
+// serialise PROJ4 call - projPJ and pj_errno are shared by the reader
+// (ie S52_xy2LL() and co. in parallel) and the loader threads
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticMutex  _pj_mutex = G_STATIC_MUTEX_INIT;
+#define PJLOCK()     g_static_mutex_lock(&_pj_mutex)
+#define PJUNLOCK()   g_static_mutex_unlock(&_pj_mutex)
+#else
+static GMutex        _pj_mutex;
+#define PJLOCK()     g_mutex_lock(&_pj_mutex)
+#define PJUNLOCK()   g_mutex_unlock(&_pj_mutex)
+#endif
 #endif
 
 // MAXINT-6 is how OGR tag an UNKNOWN value
@@ -130,10 +154,11 @@ typedef struct _S57_geo {
 
 #ifdef S52_USE_SUPP_LINE_OVERLAP
     // only for object "Edge"
-    gchar       *name_rcidstr;  // optimisation: point to Att NAME_RCID str value
-
     S57_geo     *geoOwner;      // s57 obj that use this edge
 
+    // only for LINES / AREAS - edge (RCNM 130) in FSPT order
+    GArray      *edgeRef;       // S57_edgeRef
+
     //S57_AW_t     origAW;        // debug - original Area Winding, CW: area < 0,  CCW: area > 0
 #endif
 
@@ -141,11 +166,21 @@ typedef struct _S57_geo {
     // optimisation mostly for layer 9 AREA (FIXME: exemple of centroid on layer 9 ?!)
     guint        centroidIdx;
     GArray      *centroid;
+    int          centroidLOD;  // LOD band (S52GL.c:_getLODidx()) of the centroids, 0 - not set
+    int          centroidClip; // TRUE - centroids of the part of the area in view (CSG clip)
+
+    // visual centre: pole of inaccessibility of the area (all ring) in PRJ
+    gboolean     centerDone;
+    pt2          center;
 
 #ifdef S52_USE_WORLD
     S57_geo     *nextPoly;
 #endif
 
+#ifdef S52_USE_ARENA
+    S57_arena   *arena;      // geo and coords come from this arena, NULL if heap
+#endif
+
     gboolean     highlight;  // highlight this geo object (cursor pick / hazard - experimental)
 
     gboolean     hazard;     // TRUE if a Safety Contour / hazard - use by leglin and GUARDZONE
@@ -158,6 +193,237 @@ typedef struct _S57_geo {
 
 static GString *_attList = NULL;
 
+#ifdef S52_USE_ARENA
+// cell-lifetime geometry: geo struct and coordinates of a cell are bump allocated
+// in big mmap() chunks, small block freed before the cell go are recycled by size class
+// Note: geometry only - attribs (GData/GString), prim (GArray), centroid, edgeRef
+//       stay on the heap and S57_doneData() still free them obj by obj
+#define ARENA_CHUNK_SZ   (1024*1024)                 // 1MB
+#define ARENA_ALIGN      16
+#define ARENA_CLASS_MAX  512                         // bigger block are not recycled
+#define ARENA_CLASS_NBR  (ARENA_CLASS_MAX/ARENA_ALIGN)
+#define ARENA_HDR_SZ     ((sizeof(_chunk) + ARENA_ALIGN-1) & ~(gsize)(ARENA_ALIGN-1))
+
+typedef struct _chunk {
+    struct _chunk *next;
+    gsize          size;     // mapped size
+    gsize          used;     // bump offset (including header)
+} _chunk;
+
+typedef struct _S57_arena {
+    _chunk   *chunk;         // chunk list - head is the one in use
+    _chunk   *big;           // block bigger than ARENA_CHUNK_SZ/4 - own mapping
+    gpointer  freeList[ARENA_CLASS_NBR];  // free block by size class
+    gboolean  closed;        // S57_closeArena() - block are not freed one by one anymore
+
+    gsize     mapped;        // stat
+    gsize     used;
+    gsize     freed;
+} _S57_arena;
+
+// arena in use while loading a cell - per thread (the Chart Manager load
+// cell while the main thread load an other one or an update)
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticPrivate _arenaThread = G_STATIC_PRIVATE_INIT;
+#define ARENAGET()       ((_S57_arena*)g_static_private_get(&_arenaThread))
+#define ARENASET(a)      g_static_private_set(&_arenaThread, a, NULL)
+#else
+static GPrivate       _arenaThread = G_PRIVATE_INIT(NULL);
+#define ARENAGET()       ((_S57_arena*)g_private_get(&_arenaThread))
+#define ARENASET(a)      g_private_set(&_arenaThread, a)
+#endif
+
+static _chunk    *_mapChunk(gsize size)
+{
+    _chunk *c = (_chunk*)mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == (void*)c) {
+        PRINTF("ERROR: mmap() failed (%lu bytes)\n", (unsigned long)size);
+        return NULL;
+    }
+
+    c->next = NULL;
+    c->size = size;
+    c->used = ARENA_HDR_SZ;
+
+    return c;
+}
+
+static gpointer   _arenaAlloc(_S57_arena *arena, gsize size)
+{
+    size = (0 == size) ? ARENA_ALIGN : (size + ARENA_ALIGN-1) & ~(gsize)(ARENA_ALIGN-1);
+
+    // recycle
+    if (size <= ARENA_CLASS_MAX) {
+        guint    cl = size/ARENA_ALIGN - 1;
+        gpointer p  = arena->freeList[cl];
+        if (NULL != p) {
+            arena->freeList[cl] = *(gpointer*)p;
+            arena->freed       -= size;
+            return p;
+        }
+    }
+
+    // big block
+    if (size > ARENA_CHUNK_SZ/4) {
+        gsize   pgsz = (gsize)sysconf(_SC_PAGESIZE);
+        _chunk *c    = _mapChunk((ARENA_HDR_SZ + size + pgsz-1) & ~(pgsz-1));
+        if (NULL == c)
+            return NULL;
+
+        c->used          = ARENA_HDR_SZ + size;
+        c->next          = arena->big;
+        arena->big       = c;
+        arena->mapped   += c->size;
+        arena->used     += size;
+
+        return (char*)c + ARENA_HDR_SZ;
+    }
+
+    // bump - tail of a full chunk is lost
+    if ((NULL==arena->chunk) || (arena->chunk->used+size > arena->chunk->size)) {
+        _chunk *c = _mapChunk(ARENA_CHUNK_SZ);
+        if (NULL == c)
+            return NULL;
+
+        c->next        = arena->chunk;
+        arena->chunk   = c;
+        arena->mapped += c->size;
+    }
+
+    gpointer p = (char*)arena->chunk + arena->chunk->used;
+    arena->chunk->used += size;
+    arena->used        += size;
+
+    return p;
+}
+
+static void       _arenaFree(_S57_arena *arena, gpointer p, gsize size)
+// big block stay until the arena is done
+{
+    size = (0 == size) ? ARENA_ALIGN : (size + ARENA_ALIGN-1) & ~(gsize)(ARENA_ALIGN-1);
+
+    if (size <= ARENA_CLASS_MAX) {
+        guint cl = size/ARENA_ALIGN - 1;
+        *(gpointer*)p       = arena->freeList[cl];
+        arena->freeList[cl] = p;
+    }
+
+    arena->freed += size;
+
+    return;
+}
+
+S57_arena *S57_newArena(void)
+{
+    return g_new0(_S57_arena, 1);
+}
+
+int        S57_doneArena(_S57_arena *arena)
+{
+    return_if_null(arena);
+
+    if (ARENAGET() == arena)
+        ARENASET(NULL);
+
+    for (_chunk *c = arena->chunk; NULL != c; ) {
+        _chunk *next = c->next;
+        munmap(c, c->size);
+        c = next;
+    }
+    for (_chunk *c = arena->big; NULL != c; ) {
+        _chunk *next = c->next;
+        munmap(c, c->size);
+        c = next;
+    }
+
+    g_free(arena);
+
+    return TRUE;
+}
+
+int        S57_closeArena(_S57_arena *arena)
+{
+    return_if_null(arena);
+
+    arena->closed = TRUE;
+
+    return TRUE;
+}
+
+S57_arena *S57_setArena(_S57_arena *arena)
+{
+    _S57_arena *prev = ARENAGET();
+
+    ARENASET(arena);
+
+    return prev;
+}
+
+int        S57_getArenaStat(_S57_arena *arena, gsize *mapped, gsize *used, gsize *freed)
+{
+    return_if_null(arena);
+
+    if (NULL != mapped) *mapped = arena->mapped;
+    if (NULL != used  ) *used   = arena->used;
+    if (NULL != freed ) *freed  = arena->freed;
+
+    return TRUE;
+}
+#endif  // S52_USE_ARENA
+
+gpointer   S57_newGeoData(_S57_geo *geo, gsize size)
+{
+#ifdef S52_USE_ARENA
+    _S57_arena *arena = (NULL == geo) ? ARENAGET() : geo->arena;
+    if (NULL != arena) {
+        gpointer p = _arenaAlloc(arena, size);
+        if (NULL == p)
+            g_assert(0);
+
+        return p;
+    }
+#else
+    (void)geo;
+#endif
+
+    return g_malloc(size);
+}
+
+static void       _freeGeoData(_S57_geo *geo, gpointer data, gsize size)
+{
+#ifdef S52_USE_ARENA
+    if (NULL != geo->arena) {
+        _arenaFree(geo->arena, data, size);
+        return;
+    }
+#else
+    (void)geo;
+    (void)size;
+#endif
+
+    g_free(data);
+
+    return;
+}
+
+static _S57_geo  *_newGeo(void)
+{
+#ifdef S52_USE_ARENA
+    _S57_arena *arena = ARENAGET();
+    if (NULL != arena) {
+        _S57_geo *geo = (_S57_geo*)_arenaAlloc(arena, sizeof(_S57_geo));
+        if (NULL == geo)
+            g_assert(0);
+        memset(geo, 0, sizeof(_S57_geo));
+        geo->arena = arena;
+
+        return geo;
+    }
+#endif
+
+    return g_new0(_S57_geo, 1);
+}
+
 
 int           _initPROJ()
 // Note: corrected for PROJ 4.6.0 ("datum=WGS84")
@@ -166,6 +432,13 @@ int           _initPROJ()
         return FALSE;
 
 #ifdef S52_USE_PROJ
+    PJLOCK();
+    // other thread did init
+    if (FALSE == _doInit) {
+        PJUNLOCK();
+        return FALSE;
+    }
+
     const char *pj_ver = pj_get_release();
     if (NULL != pj_ver)
         PRINTF("PROJ4 VERSION: %s\n", pj_ver);
@@ -173,6 +446,7 @@ int           _initPROJ()
     // setup source projection
     if (!(_pjsrc = pj_init_plus(_argssrc))){
         PRINTF("ERROR: init src PROJ4\n");
+        PJUNLOCK();
         S57_donePROJ();
         g_assert(0);
         return FALSE;
@@ -185,12 +459,17 @@ int           _initPROJ()
     // FIXME: will need resetting for different projection
     _doInit = FALSE;
 
+#ifdef S52_USE_PROJ
+    PJUNLOCK();
+#endif
+
     return TRUE;
 }
 
 int        S57_donePROJ(void)
 {
 #ifdef S52_USE_PROJ
+    PJLOCK();
     if (NULL != _pjsrc) pj_free(_pjsrc);
     if (NULL != _pjdst) pj_free(_pjdst);
 #endif
@@ -199,6 +478,10 @@ int        S57_donePROJ(void)
     _pjdst  = NULL;
     _doInit = TRUE;
 
+#ifdef S52_USE_PROJ
+    PJUNLOCK();
+#endif
+
     if (NULL != _attList)
         g_string_free(_attList, TRUE);
     _attList = NULL;
@@ -259,19 +542,25 @@ PROJCS["WGS 84 / Pseudo-Mercator",
         return FALSE;
     }
 
+    // source projection - init here (writer) so that query never init PROJ
+    _initPROJ();
+
     _pjstr = g_strdup_printf(templ, lat, lon);
     PRINTF("DEBUG: lat:%f, lon:%f [%s]\n", lat, lon, _pjstr);
 
 #ifdef S52_USE_PROJ
+    PJLOCK();
     if (NULL != _pjdst)
         pj_free(_pjdst);
 
     _pjdst = pj_init_plus(_pjstr);
     if (FALSE == _pjdst) {
         PRINTF("ERROR: init pjdst PROJ4 (lat:%f) [%s]\n", lat, pj_strerrno(pj_errno));
+        PJUNLOCK();
         g_assert(0);
         return FALSE;
     }
+    PJUNLOCK();
 #endif
 
     return TRUE;
@@ -289,12 +578,15 @@ projXY     S57_prj2geo(projUV uv)
     if (NULL == _pjdst)  return uv;
 
 #ifdef S52_USE_PROJ
+    PJLOCK();
     uv = pj_inv(uv, _pjdst);
     if (0 != pj_errno) {
         PRINTF("ERROR: x=%f y=%f %s\n", uv.u, uv.v, pj_strerrno(pj_errno));
+        PJUNLOCK();
         g_assert(0);
         return uv;
     }
+    PJUNLOCK();
 
     uv.u /= DEG_TO_RAD;
     uv.v /= DEG_TO_RAD;
@@ -303,6 +595,76 @@ projXY     S57_prj2geo(projUV uv)
     return uv;
 }
 
+int        S57_prj2geov(guint npt, double *x, double *y, guint stride)
+// convert a strided array of projected XY to geographic (LL) 'in-place'
+// stride: distance in double between two points
+{
+    return_if_null(x);
+    return_if_null(y);
+
+    if (TRUE == _doInit) return FALSE;
+    if (NULL == _pjdst)  return FALSE;
+
+#ifdef S52_USE_PROJ
+    PJLOCK();
+    int ret = pj_transform(_pjdst, _pjsrc, npt, stride, x, y, NULL);
+    if (0 != ret) {
+        PRINTF("WARNING: in transform (%i): %s\n", ret, pj_strerrno(pj_errno));
+        PJUNLOCK();
+        return FALSE;
+    }
+    PJUNLOCK();
+
+    // rad to deg
+    for (guint i=0; i<npt; ++i, x+=stride, y+=stride) {
+        *x /= DEG_TO_RAD;
+        *y /= DEG_TO_RAD;
+    }
+#endif
+
+    return TRUE;
+}
+
+int        S57_geo2prjv(guint npt, double *x, double *y, guint stride)
+// convert a strided array of lon/lat (deg) to XY 'in-place'
+// stride: distance in double between two points
+{
+    return_if_null(x);
+    return_if_null(y);
+
+    // Note: query - PROJ is init by S57_setMercPrj() (writer)
+    if (TRUE == _doInit) {
+        PRINTF("WARNING: PROJ not initialized .. load a chart first!\n");
+        return FALSE;
+    }
+
+    if (NULL == _pjdst) {
+        PRINTF("WARNING: nothing to project to .. load a chart first!\n");
+        return FALSE;
+    }
+
+#ifdef S52_USE_PROJ
+    // deg to rad
+    double *px = x;
+    double *py = y;
+    for (guint i=0; i<npt; ++i, px+=stride, py+=stride) {
+        *px *= DEG_TO_RAD;
+        *py *= DEG_TO_RAD;
+    }
+
+    PJLOCK();
+    int ret = pj_transform(_pjsrc, _pjdst, npt, stride, x, y, NULL);
+    if (0 != ret) {
+        PRINTF("WARNING: in transform (%i): %s\n", ret, pj_strerrno(pj_errno));
+        PJUNLOCK();
+        return FALSE;
+    }
+    PJUNLOCK();
+#endif
+
+    return TRUE;
+}
+
 //int        S57_geo2prj3dv(guint npt, geocoord *data)
 int        S57_geo2prj3dv(guint npt, pt3 *data)
 // convert a vector of lon/lat/z (pt3) to XY(z) 'in-place'
@@ -336,12 +698,15 @@ int        S57_geo2prj3dv(guint npt, pt3 *data)
     pt = (pt3*)data;
 
     // rad to cartesian  --mercator
+    PJLOCK();
     int ret = pj_transform(_pjsrc, _pjdst, npt, 3, &pt->x, &pt->y, &pt->z);
     if (0 != ret) {
         PRINTF("WARNING: in transform (%i): %s (%f,%f)\n", ret, pj_strerrno(pj_errno), pt->x, pt->y);
+        PJUNLOCK();
         g_assert(0);
         return FALSE;
     }
+    PJUNLOCK();
 
     /*
     // FIXME: test heuristic to reduce the number of point (for LOD):
@@ -541,6 +906,9 @@ int        S57_geo2prj(_S57_geo *geo)
 
     _simplifyGEO(geo);
 
+    // coord change
+    geo->centerDone = FALSE;
+
     if (TRUE == _doInit)
         _initPROJ();
 
@@ -569,13 +937,13 @@ static int    _doneGeoData(_S57_geo *geo)
 
     // POINT
     if (NULL != geo->pointxyz) {
-        g_free((geocoord*)geo->pointxyz);
+        _freeGeoData(geo, geo->pointxyz, sizeof(geocoord)*3);
         geo->pointxyz = NULL;
     }
 
     // LINES
     if (NULL != geo->linexyz) {
-        g_free((geocoord*)geo->linexyz);
+        _freeGeoData(geo, geo->linexyz, sizeof(geocoord)*3*geo->linexyznbr);
         geo->linexyz = NULL;
     }
 
@@ -584,15 +952,15 @@ static int    _doneGeoData(_S57_geo *geo)
         unsigned int i;
         for(i = 0; i < geo->ringnbr; ++i) {
             if (NULL != geo->ringxyz[i])
-                g_free((geocoord*)geo->ringxyz[i]);
+                _freeGeoData(geo, geo->ringxyz[i], sizeof(geocoord)*3*geo->ringxyznbr[i]);
             geo->ringxyz[i] = NULL;
         }
-        g_free((geocoord*)geo->ringxyz);
+        _freeGeoData(geo, geo->ringxyz, sizeof(geocoord*)*geo->ringnbr);
         geo->ringxyz = NULL;
     }
 
     if (NULL != geo->ringxyznbr) {
-        g_free(geo->ringxyznbr);
+        _freeGeoData(geo, geo->ringxyznbr, sizeof(guint)*geo->ringnbr);
         geo->ringxyznbr = NULL;
     }
 
@@ -617,8 +985,16 @@ int        S57_doneData   (_S57_geo *geo, gpointer user_data)
     }
 #endif
 
+#ifdef S52_USE_ARENA
+    // cell unload - geo and coords go with the arena chunks, only free
+    // what is outside the arena (heap, GL)
+    int inArena = ((NULL!=geo->arena) && (TRUE==geo->arena->closed)) ? TRUE : FALSE;
+#else
+    int inArena = FALSE;
+#endif
 
-    _doneGeoData(geo);
+    if (FALSE == inArena)
+        _doneGeoData(geo);
 
     S57_donePrimGeo(geo);
 
@@ -628,7 +1004,13 @@ int        S57_doneData   (_S57_geo *geo, gpointer user_data)
     if (NULL != geo->centroid)
         g_array_free(geo->centroid, TRUE);
 
-    g_free(geo);
+#ifdef S52_USE_SUPP_LINE_OVERLAP
+    if (NULL != geo->edgeRef)
+        g_array_free(geo->edgeRef, TRUE);
+#endif
+
+    if (FALSE == inArena)
+        _freeGeoData(geo, geo, sizeof(_S57_geo));
 
     return TRUE;
 }
@@ -637,7 +1019,7 @@ S57_geo   *S57_setPOINT(geocoord *xyz)
 {
     return_if_null(xyz);
 
-    _S57_geo *geo = g_new0(_S57_geo, 1);
+    _S57_geo *geo = _newGeo();
     //_S57_geo *geo = g_try_new0(_S57_geo, 1);
     if (NULL == geo)
         g_assert(0);
@@ -667,6 +1049,10 @@ S57_geo   *S57_setGeoLine(_S57_geo *geo, guint xyznbr, geocoord *xyz)
     return_if_null(geo);
 
     geo->obj_t      = S57_LINES_T;  // because some Edge objet default to _META_T when no geo yet
+
+    if ((NULL!=geo->linexyz) && (xyz!=geo->linexyz))
+        _freeGeoData(geo, geo->linexyz, sizeof(geocoord)*3*geo->linexyznbr);
+
     geo->linexyznbr = xyznbr;
     geo->linexyz    = xyz;
 
@@ -679,7 +1065,7 @@ S57_geo   *S57_setLINES(guint xyznbr, geocoord *xyz)
     // Edge might have 0 node
     //return_if_null(xyz);
 
-    _S57_geo *geo = g_new0(_S57_geo, 1);
+    _S57_geo *geo = _newGeo();
     //_S57_geo *geo = g_try_new0(_S57_geo, 1);
     if (NULL == geo)
         g_assert(0);
@@ -734,7 +1120,7 @@ S57_geo   *S57_setAREAS(guint ringnbr, guint *ringxyznbr, geocoord **ringxyz)
     return_if_null(ringxyznbr);
     return_if_null(ringxyz);
 
-    _S57_geo *geo = g_new0(_S57_geo, 1);
+    _S57_geo *geo = _newGeo();
     //_S57_geo *geo = g_try_new0(_S57_geo, 1);
     if (NULL == geo)
         g_assert(0);
@@ -767,7 +1153,7 @@ S57_geo   *S57_setAREAS(guint ringnbr, guint *ringxyznbr, geocoord **ringxyz)
 
 S57_geo   *S57_set_META(void)
 {
-    _S57_geo *geo = g_new0(_S57_geo, 1);
+    _S57_geo *geo = _newGeo();
     //_S57_geo *geo = g_try_new0(_S57_geo, 1);
     if (NULL == geo)
         g_assert(0);
@@ -1293,15 +1679,6 @@ GData     *S57_setAtt(_S57_geo *geo, const char *name, const char *val)
     if (NULL == geo->attribs)
         g_datalist_init(&geo->attribs);
 
-#ifdef S52_USE_SUPP_LINE_OVERLAP
-    if ((0==g_strcmp0(geo->name, "Edge")) && (0==g_strcmp0(name, "RCID"))) {
-        geo->name_rcidstr = value->str;
-
-        // FIXME: check for substring ",...)" if found at the end
-        // this mean that TEMP_BUFFER_SIZE in OGR is not large anought.
-     }
-#endif
-
     g_datalist_id_set_data_full(&geo->attribs, qname, value, _string_free);
 
     return geo->attribs;
@@ -1435,6 +1812,30 @@ S57_geo   *S57_getTouchDEPVAL(_S57_geo *geo)
     return geo->touch.DEPVAL;
 }
 
+int        S57_unlinkGeo(_S57_geo *geo, S57_geo *other)
+// remove ref to 'other' (touch, relation) - 'other' is about to be deleted
+// return TRUE if a ref was removed
+{
+    return_if_null(geo);
+
+    int ret = FALSE;
+
+    // Note: touch is an union
+    if ((NULL!=other) && (other==geo->touch.TOPMAR)) {
+        geo->touch.TOPMAR = NULL;
+        ret = TRUE;
+    }
+
+#ifdef S52_USE_C_AGGR_C_ASSO
+    if ((NULL!=other) && (other==geo->relation)) {
+        geo->relation = NULL;
+        ret = TRUE;
+    }
+#endif
+
+    return ret;
+}
+
 double     S57_setScamin(_S57_geo *geo, double scamin)
 {
     // test useless since the only caller allready did that
@@ -1861,9 +2262,67 @@ guint      S57_setGeoSize(_S57_geo *geo, guint size)
         return FALSE;
     }
 
+    // coord change
+    if (size != geo->geoSize) {
+        geo->centerDone = FALSE;
+    }
+
     return geo->geoSize = size;
 }
 
+static void       _sizeAtt(GQuark key_id, gpointer data, gpointer user_data)
+{
+    GString *attValue = (GString*) data;
+    gsize   *sz       = (gsize*)   user_data;
+
+    (void)key_id;  // quark are shared
+
+    // GData entry (quark + pointer) + GString
+    *sz += sizeof(GQuark) + sizeof(gpointer) + sizeof(GString) + attValue->allocated_len;
+}
+
+int        S57_getMemSize(_S57_geo *geo, guint *nvertex, gsize *geoB, gsize *attB, gsize *primB)
+// memory held by this geo (approximate - malloc overhead not counted)
+// geoB: struct + coords, attB: attributes, primB: tessellated prim (CPU copy)
+{
+    return_if_null(geo);
+
+    guint npt = 0;
+    gsize sz  = sizeof(_S57_geo);
+
+    if (NULL != geo->pointxyz)
+        npt += 1;
+    npt += geo->linexyznbr;
+    for (guint i=0; i<geo->ringnbr; ++i)
+        npt += geo->ringxyznbr[i];
+
+    sz += npt * sizeof(geocoord) * 3;
+    sz += geo->ringnbr * (sizeof(guint) + sizeof(geocoord*));
+    if (NULL != geo->centroid)
+        sz += sizeof(GArray) + geo->centroid->len * sizeof(pt2);
+#ifdef S52_USE_SUPP_LINE_OVERLAP
+    if (NULL != geo->edgeRef)
+        sz += sizeof(GArray) + geo->edgeRef->len * sizeof(guint);
+#endif
+
+    gsize att = 0;
+    g_datalist_foreach(&geo->attribs, _sizeAtt, &att);
+
+    gsize prim = 0;
+    if (NULL != geo->prim) {
+        prim = sizeof(_S57_prim) + 2*sizeof(GArray) +
+               geo->prim->list->len   * sizeof(_prim) +
+               geo->prim->vertex->len * sizeof(pt3v);
+    }
+
+    if (NULL != nvertex) *nvertex = npt;
+    if (NULL != geoB   ) *geoB    = sz;
+    if (NULL != attB   ) *attB    = att;
+    if (NULL != primB  ) *primB   = prim;
+
+    return TRUE;
+}
+
 int        S57_newCentroid(_S57_geo *geo)
 // init or reset
 {
@@ -1925,6 +2384,243 @@ int        S57_hasCentroid(_S57_geo *geo)
     return TRUE;
 }
 
+int        S57_setCentroidLOD(_S57_geo *geo, int lod)
+{
+    return_if_null(geo);
+
+    geo->centroidLOD = lod;
+
+    return TRUE;
+}
+
+int        S57_getCentroidLOD(_S57_geo *geo)
+{
+    return_if_null(geo);
+
+    return geo->centroidLOD;
+}
+
+int        S57_setCentroidClip(_S57_geo *geo, int clip)
+{
+    return_if_null(geo);
+
+    geo->centroidClip = clip;
+
+    return TRUE;
+}
+
+int        S57_getCentroidClip(_S57_geo *geo)
+{
+    return_if_null(geo);
+
+    return geo->centroidClip;
+}
+
+// pole of inaccessibility - grid cell refined in best first order (quadtree)
+// (after Mapbox polylabel, Agafonkin 2016)
+#define POLE_PRECISION  256.0   // stop when a cell can't do better than 1/256 of the extent
+#define POLE_MAX_CELL   4096    // bound the cost for pathological ring
+
+typedef struct _poleCell {
+    double x, y;    // center
+    double h;       // half size
+    double d;       // distance center to area, < 0 outside
+    double max;     // best distance possible in the cell (d + h*sqrt(2))
+} _poleCell;
+
+static double     _segDist2(double px, double py, pt3 a, pt3 b)
+// square distance of p to segment ab
+{
+    double x  = a.x;
+    double y  = a.y;
+    double dx = b.x - x;
+    double dy = b.y - y;
+
+    if ((0.0!=dx) || (0.0!=dy)) {
+        double t = ((px - x) * dx + (py - y) * dy) / (dx * dx + dy * dy);
+        if (t > 1.0) {
+            x = b.x;
+            y = b.y;
+        } else {
+            if (t > 0.0) {
+                x += dx * t;
+                y += dy * t;
+            }
+        }
+    }
+
+    dx = px - x;
+    dy = py - y;
+
+    return dx * dx + dy * dy;
+}
+
+static double     _poleDist(_S57_geo *geo, double x, double y)
+// signed distance from (x,y) to the area outline (all ring), > 0 inside
+{
+    gboolean inside = FALSE;
+    double   min2   = INFINITY;
+
+    for (guint r=0; r<geo->ringnbr; ++r) {
+        guint npt = geo->ringxyznbr[r];
+        pt3  *v   = (pt3 *)geo->ringxyz[r];
+
+        for (guint i=0, j=npt-1; i<npt; j=i++) {
+            pt3 a = v[i];
+            pt3 b = v[j];
+
+            if (((a.y>y) != (b.y>y)) && (x < (b.x-a.x) * (y-a.y) / (b.y-a.y) + a.x))
+                inside = !inside;
+
+            double d2 = _segDist2(x, y, a, b);
+            if (d2 < min2)
+                min2 = d2;
+        }
+    }
+
+    return (TRUE==inside ? 1.0 : -1.0) * sqrt(min2);
+}
+
+static _poleCell  _poleNewCell(_S57_geo *geo, double x, double y, double h)
+{
+    _poleCell c = {x, y, h, _poleDist(geo, x, y), 0.0};
+    c.max = c.d + h * G_SQRT2;
+
+    return c;
+}
+
+static void       _polePush(GArray *heap, _poleCell c)
+// max heap on 'max'
+{
+    g_array_append_val(heap, c);
+
+    _poleCell *h = (_poleCell *)heap->data;
+    for (guint i=heap->len-1; i>0; ) {
+        guint p = (i - 1) / 2;
+        if (h[p].max >= h[i].max)
+            break;
+        _poleCell t = h[p]; h[p] = h[i]; h[i] = t;
+        i = p;
+    }
+}
+
+static _poleCell  _polePop(GArray *heap)
+{
+    _poleCell *h   = (_poleCell *)heap->data;
+    _poleCell  top = h[0];
+
+    h[0] = h[heap->len-1];
+    g_array_set_size(heap, heap->len-1);
+
+    for (guint i=0; ; ) {
+        guint l = 2*i + 1;
+        guint r = l + 1;
+        guint m = i;
+        if ((l<heap->len) && (h[l].max > h[m].max)) m = l;
+        if ((r<heap->len) && (h[r].max > h[m].max)) m = r;
+        if (m == i)
+            break;
+        _poleCell t = h[m]; h[m] = h[i]; h[i] = t;
+        i = m;
+    }
+
+    return top;
+}
+
+int        S57_setCenter(_S57_geo *geo)
+// compute visual centre of area - thread safe for distinct geo
+{
+    return_if_null(geo);
+
+    if ((S57_AREAS_T!=geo->obj_t) || (0==geo->ringnbr) || (NULL==geo->ringxyz) || (geo->ringxyznbr[0]<3))
+        return FALSE;
+
+    guint npt = geo->ringxyznbr[0];
+    pt3  *v   = (pt3 *)geo->ringxyz[0];
+
+    // extent (PRJ) and area centroid of outer ring
+    double W = INFINITY, S = INFINITY, E = -INFINITY, N = -INFINITY;
+    double a = 0.0, cx = 0.0, cy = 0.0;
+    for (guint i=0, j=npt-1; i<npt; j=i++) {
+        double ai = v[i].x * v[j].y - v[j].x * v[i].y;
+        a  += ai;
+        cx += (v[i].x + v[j].x) * ai;
+        cy += (v[i].y + v[j].y) * ai;
+
+        W = MIN(W, v[i].x); E = MAX(E, v[i].x);
+        S = MIN(S, v[i].y); N = MAX(N, v[i].y);
+    }
+
+    double w    = E - W;
+    double h    = N - S;
+    if (0.0 == MIN(w, h)) {
+        geo->center.x   = W;
+        geo->center.y   = S;
+        geo->centerDone = TRUE;
+        return TRUE;
+    }
+    double cell      = MAX(w, h);
+    double precision = cell / POLE_PRECISION;
+
+    GArray *heap = g_array_sized_new(FALSE, FALSE, sizeof(_poleCell), 64);
+
+    // one cell over the extent - a cell size of MIN(w, h) would start a thin
+    // area with (long/short side) cells, all evaluated before any refinement
+    double hc = cell / 2.0;
+    _polePush(heap, _poleNewCell(geo, W + w/2.0, S + h/2.0, hc));
+
+    // first guess: centroid, then extent center
+    _poleCell best = _poleNewCell(geo, W + w/2.0, S + h/2.0, 0.0);
+    if (0.0 != a) {
+        _poleCell c = _poleNewCell(geo, cx / (3.0 * a), cy / (3.0 * a), 0.0);
+        if (c.d > best.d)
+            best = c;
+    }
+
+    guint ncell = heap->len;
+    while ((0<heap->len) && (ncell<POLE_MAX_CELL)) {
+        _poleCell c = _polePop(heap);
+
+        if (c.d > best.d)
+            best = c;
+
+        // no better solution in this cell
+        if (c.max - best.d <= precision)
+            continue;
+
+        hc = c.h / 2.0;
+        _polePush(heap, _poleNewCell(geo, c.x - hc, c.y - hc, hc));
+        _polePush(heap, _poleNewCell(geo, c.x + hc, c.y - hc, hc));
+        _polePush(heap, _poleNewCell(geo, c.x - hc, c.y + hc, hc));
+        _polePush(heap, _poleNewCell(geo, c.x + hc, c.y + hc, hc));
+        ncell += 4;
+    }
+
+    g_array_free(heap, TRUE);
+
+    geo->center.x   = best.x;
+    geo->center.y   = best.y;
+    geo->centerDone = TRUE;
+
+    return TRUE;
+}
+
+int        S57_getCenter(_S57_geo *geo, double *x, double *y)
+// visual centre of area (PRJ) - computed on first call if not done at load
+{
+    return_if_null(geo);
+
+    if (FALSE == geo->centerDone) {
+        if (FALSE == S57_setCenter(geo))
+            return FALSE;
+    }
+
+    *x = geo->center.x;
+    *y = geo->center.y;
+
+    return TRUE;
+}
+
 #ifdef S52_USE_SUPP_LINE_OVERLAP
 S57_geo   *S57_getEdgeOwner(_S57_geo *geoEdge)
 {
@@ -2078,11 +2774,24 @@ int        S57_markOverlapGeo(_S57_geo *geo, _S57_geo *geoEdge)
     return TRUE;
 }
 
-gchar     *S57_getRCIDstr(_S57_geo *geo)
+int        S57_addEdgeRef(_S57_geo *geo, guint rcid, gboolean mask)
+{
+    return_if_null(geo);
+
+    if (NULL == geo->edgeRef)
+        geo->edgeRef = g_array_new(FALSE, FALSE, sizeof(S57_edgeRef));
+
+    S57_edgeRef ref = {rcid, mask};
+    g_array_append_val(geo->edgeRef, ref);
+
+    return TRUE;
+}
+
+GArray    *S57_getEdgeRef(_S57_geo *geo)
 {
     return_if_null(geo);
 
-    return geo->name_rcidstr;
+    return geo->edgeRef;
 }
 
 //S57_AW_t   S57_getOrigAW(_S57_geo *geo)
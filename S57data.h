@@ -97,6 +97,21 @@ typedef struct _pt3v { vertex_t x,y,z; } pt3v; // used in all files
 
 int       S57_doneData(S57_geo *geo, gpointer user_data);
 
+#ifdef S52_USE_ARENA
+// per-cell geometry arena - geo and coords allocated while an arena is set live until S57_doneArena()
+// Note: geometry only, the rest of a geo (attribs, prim, ..) is on the heap
+typedef struct _S57_arena S57_arena;
+S57_arena *S57_newArena(void);
+int        S57_doneArena(S57_arena *arena);
+// the cell is going - S57_doneData() skip the geo and coords of this arena (S57_doneArena() unmap them)
+int        S57_closeArena(S57_arena *arena);
+// set the arena for the next geo of this thread, return the previous one
+S57_arena *S57_setArena(S57_arena *arena);
+int        S57_getArenaStat(S57_arena *arena, gsize *mapped, gsize *used, gsize *freed);
+#endif
+// alloc coords for geo (from geo's arena) or for a geo to be set (NULL: current arena)
+gpointer  S57_newGeoData(S57_geo *geo, gsize size);
+
 S57_geo  *S57_setPOINT(geocoord *xyz);
 S57_geo  *S57_setLINES(guint xyznbr, geocoord *xyz);
 //S57_geo  *S57_setMLINE(guint linenbr, guint *linexyznbr, geocoord **linexyz);
@@ -168,6 +183,8 @@ int       S57_setTouchDEPARE(S57_geo *geo, S57_geo *touch);
 S57_geo  *S57_getTouchDEPARE(S57_geo *geo);
 int       S57_setTouchDEPVAL(S57_geo *geo, S57_geo *touch);
 S57_geo  *S57_getTouchDEPVAL(S57_geo *geo);
+// remove ref to 'other' (touch, relation)
+int       S57_unlinkGeo(S57_geo *geo, S57_geo *other);
 
 double    S57_setScamin(S57_geo *geo, double scamin);
 double    S57_getScamin(S57_geo *geo);
@@ -199,6 +216,9 @@ GCPTR     S57_getPrjStr(void);
 projXY    S57_prj2geo(projUV uv);
 //int       S57_geo2prj3dv(guint npt, geocoord *data);
 int       S57_geo2prj3dv(guint npt, pt3 *data);
+// strided array (stride in double) of XY / LL, in-place - one PROJ call for all point
+int       S57_prj2geov(guint npt, double *x, double *y, guint stride);
+int       S57_geo2prjv(guint npt, double *x, double *y, guint stride);
 int       S57_geo2prj(S57_geo *geo);
 #endif  // S52_USE_PROJ
 
@@ -208,17 +228,36 @@ int       S57_touch(S57_geo *geoA, S57_geo *geoB);
 
 guint     S57_getGeoSize(S57_geo *geo);
 guint     S57_setGeoSize(S57_geo *geo, guint size);
+// memory stat - nbr of coords, bytes of geo (+coords), attributes and prim
+int       S57_getMemSize(S57_geo *geo, guint *nvertex, gsize *geoB, gsize *attB, gsize *primB);
 
 int       S57_newCentroid(S57_geo *geo);
 int       S57_addCentroid(S57_geo *geo, double  x, double  y);
 int       S57_getNextCent(S57_geo *geo, double *x, double *y);
 int       S57_hasCentroid(S57_geo *geo);
+// LOD band the centroids where computed for (0 - none)
+int       S57_setCentroidLOD(S57_geo *geo, int lod);
+int       S57_getCentroidLOD(S57_geo *geo);
+// TRUE if the centroids are the one of the part of the area in the view they where computed for
+int       S57_setCentroidClip(S57_geo *geo, int clip);
+int       S57_getCentroidClip(S57_geo *geo);
+// visual centre of area in PRJ - pole of inaccessibility (farthest point from outline)
+// S57_setCenter(): thread safe for distinct geo (load time), S57_getCenter(): compute if not done
+int       S57_setCenter(S57_geo *geo);
+int       S57_getCenter(S57_geo *geo, double *x, double *y);
 
 #ifdef S52_USE_SUPP_LINE_OVERLAP
 S57_geo  *S57_getEdgeOwner(S57_geo *geoEdge);
 S57_geo  *S57_setEdgeOwner(S57_geo *geoEdge, S57_geo *owner);
 int       S57_markOverlapGeo(S57_geo *geo, S57_geo *geoEdge);
-gchar    *S57_getRCIDstr(S57_geo *geo);
+
+// edge (RCNM 130) referenced by a LINES / AREAS (FSPT) - filled at load time
+typedef struct S57_edgeRef {
+    guint    rcid;      // RCID is b14 - full range, no room for a flag
+    gboolean mask;      // TRUE if the edge is masked (FSPT MASK = 1)
+} S57_edgeRef;
+int       S57_addEdgeRef(S57_geo *geo, guint rcid, gboolean mask);
+GArray   *S57_getEdgeRef(S57_geo *geo);  // S57_edgeRef
 
 // debug - failed experiment - outer ring original Area Winding - info needed to revere S57_att
 //S57_AW_t  S57_getOrigAW (S57_geo *geo);
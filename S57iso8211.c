@@ -0,0 +1,2176 @@
+// S57iso8211.c: S57 object data streamed directly from ISO 8211 (bypass OGR)
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Note: the cell (.000) is mapped in memory and each ISO 8211 record is
+// indexed in place (no copy). Features are then assembled straight into
+// S57_geo, one class at a time, to mimic the layer/feature order of OGR.
+// The attribute string are formated the way OGR_F_GetFieldAsString() does
+// (with the OGR_S57_OPTIONS set in S52_init()) so that CS / PL see no difference.
+//
+// Ref: IHO S-57 Ed 3.1, Part 3 (Data Structure) and Appendix B.1 (ENC Product Spec)
+
+
+#include "S57iso8211.h" // --
+
+#include "S52utils.h"   // PRINTF()
+
+#include <glib.h>       // GMappedFile, GArray, GHashTable
+#include <string.h>     // memcmp()
+#include <stdlib.h>     // atoi()
+#include <math.h>       // INFINITY
+
+
+#define FT  0x1e        // ISO 8211 field terminator
+#define UT  0x1f        // ISO 8211 unit terminator
+
+#define RCNM_DSID  10   // ReCord NaMe
+#define RCNM_FE   100
+#define RCNM_VI   110
+#define RCNM_VC   120
+#define RCNM_VE   130
+#define RCNM_VF   140
+
+#define PRIM_P      1   // FRID:PRIM
+#define PRIM_L      2
+#define PRIM_A      3
+
+#define RUIN_I      1   // Record Update INstruction (also FFUI, FSUI, VPUI, CCUI)
+#define RUIN_D      2
+#define RUIN_M      3
+
+// ISO 8211 field of a record - point into the mapped file
+typedef struct _fld {
+    const guchar *data;
+    guint         len;      // including field terminator
+} _fld;
+
+// spatial record (VRID)
+typedef struct _vrec {
+    guint rcnm;
+    guint rcid;
+    _fld  vrpt;             // edge: begin / end node
+    _fld  sg2d;
+    _fld  sg3d;
+    int   upd;              // TRUE if changed by the tracked update
+} _vrec;
+
+// feature record (FRID)
+typedef struct _frec {
+    guint objl;
+    guint prim;
+    guint rcid;
+    guint ruin;             // RUIN of the tracked update, 0 if unchanged
+    int   del;              // TRUE if deleted by an update
+    _fld  frid;
+    _fld  foid;
+    _fld  attf;
+    _fld  natf;
+    _fld  ffpt;
+    _fld  fspt;
+} _frec;
+
+typedef struct _iso8211 {
+    GMappedFile *mfile;
+
+    _fld        dsid;
+    _fld        dssi;
+    _fld        dspm;
+
+    double      comf;       // coordinate multiplication factor
+    double      somf;       // 3-D (sounding) multiplication factor
+    guint       nall;       // lexical level of NATF (2 - UCS-2)
+
+    GArray     *vrec;       // _vrec
+    GArray     *frec;       // _frec
+
+    // RCID --> idx+1 in vrec
+    GHashTable *VI;
+    GHashTable *VC;
+    GHashTable *VE;
+
+    // update (.001, ..)
+    GHashTable *FE;         // RCID --> idx+1 in frec
+    GPtrArray  *upd;        // GMappedFile - fields point into them
+    GPtrArray  *buf;        // field edited by an update
+} _iso8211;
+
+typedef enum _layer_t {
+    _LAYER_DSID  = 'D',
+    _LAYER_CN    = 'C',     // ConnectedNode
+    _LAYER_EDGE  = 'E',
+    _LAYER_FEAT  = 'F'
+} _layer_t;
+
+typedef struct _isolayer {
+    _iso8211 *iso;
+    _layer_t  type;
+    GArray   *idx;          // guint: index in iso->frec or iso->vrec
+} _isolayer;
+
+typedef struct _isofeature {
+    _isolayer *layer;
+    guint      idx;         // index in iso->frec or iso->vrec
+    int        iPt;         // SOUNDG: split multipoint, -1 otherwise
+} _isofeature;
+
+// S-57 catalogue - from GDAL/OGR CSV file
+typedef struct _attdef {
+    char acronym[S57_OBJ_ATT_LEN+1];
+    char type;              // E, L, F, I, A, S
+} _attdef;
+
+static GHashTable *_objlTbl = NULL;   // OBJL --> acronym (gchar*)
+static GHashTable *_attlTbl = NULL;   // ATTL --> _attdef
+
+
+static guint      _getUInt(const guchar *p, int n)
+// little-endian binary subfield (b11, b12, b14)
+{
+    guint val = 0;
+    for (int i=n-1; i>=0; --i)
+        val = (val << 8) | p[i];
+
+    return val;
+}
+
+static gint       _getInt32(const guchar *p)
+// b24
+{
+    return (gint)_getUInt(p, 4);
+}
+
+static gchar     *_findCSV(const char *basename)
+// same search as OGR: S57_CSV then GDAL_DATA
+{
+    const char *dir[] = {g_getenv("S57_CSV"), g_getenv("GDAL_DATA"),
+                         "/usr/share/gdal", "/usr/local/share/gdal", "."};
+
+    for (guint i=0; i<G_N_ELEMENTS(dir); ++i) {
+        if (NULL == dir[i])
+            continue;
+
+        gchar *path = g_build_filename(dir[i], basename, NULL);
+        if (TRUE == g_file_test(path, G_FILE_TEST_EXISTS))
+            return path;
+
+        g_free(path);
+    }
+
+    return NULL;
+}
+
+static gchar    **_splitCSV(gchar *line)
+// split a CSV line in place, handle quoted field (ex: "Berth, ..")
+{
+    GPtrArray *fields = g_ptr_array_new();
+    gchar     *p      = line;
+
+    while ('\0' != *p) {
+        gchar *start = p;
+        if ('"' == *p) {
+            start = ++p;
+            while ('\0'!=*p && '"'!=*p)
+                ++p;
+            if ('"' == *p)
+                *p++ = '\0';
+        }
+        while ('\0'!=*p && ','!=*p)
+            ++p;
+        if (',' == *p)
+            *p++ = '\0';
+
+        g_ptr_array_add(fields, start);
+    }
+    g_ptr_array_add(fields, NULL);
+
+    return (gchar **)g_ptr_array_free(fields, FALSE);
+}
+
+static int        _loadCatalogue(void)
+// load object class and attribute code to acronym
+{
+    if (NULL != _objlTbl)
+        return TRUE;
+
+    gchar *objpath = _findCSV("s57objectclasses.csv");
+    gchar *attpath = _findCSV("s57attributes.csv");
+    gchar *objbuf  = NULL;
+    gchar *attbuf  = NULL;
+
+    if ((NULL==objpath) || (NULL==attpath)) {
+        PRINTF("WARNING: s57objectclasses.csv / s57attributes.csv not found (set S57_CSV)\n");
+        goto exit;
+    }
+
+    if ((FALSE==g_file_get_contents(objpath, &objbuf, NULL, NULL)) ||
+        (FALSE==g_file_get_contents(attpath, &attbuf, NULL, NULL))) {
+        PRINTF("WARNING: fail to read S-57 CSV (%s, %s)\n", objpath, attpath);
+        goto exit;
+    }
+
+    _objlTbl = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+    _attlTbl = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+
+    {   // "Code","ObjectClass","Acronym", ..
+        gchar **lines = g_strsplit(objbuf, "\n", 0);
+        for (guint i=1; NULL!=lines[i]; ++i) {
+            gchar **f = _splitCSV(g_strstrip(lines[i]));
+            if ((NULL!=f[0]) && (NULL!=f[1]) && (NULL!=f[2])) {
+                guint code = (guint)atoi(f[0]);
+                if (0 != code)
+                    g_hash_table_insert(_objlTbl, GUINT_TO_POINTER(code), g_strdup(f[2]));
+            }
+            g_free(f);
+        }
+        g_strfreev(lines);
+    }
+
+    {   // "Code","Attribute","Acronym","Attributetype","Class"
+        gchar **lines = g_strsplit(attbuf, "\n", 0);
+        for (guint i=1; NULL!=lines[i]; ++i) {
+            gchar **f = _splitCSV(g_strstrip(lines[i]));
+            if ((NULL!=f[0]) && (NULL!=f[1]) && (NULL!=f[2]) && (NULL!=f[3])) {
+                guint code = (guint)atoi(f[0]);
+                if (0 != code) {
+                    _attdef *att = g_new0(_attdef, 1);
+                    g_strlcpy(att->acronym, f[2], sizeof(att->acronym));
+                    att->type = f[3][0];
+                    g_hash_table_insert(_attlTbl, GUINT_TO_POINTER(code), att);
+                }
+            }
+            g_free(f);
+        }
+        g_strfreev(lines);
+    }
+
+    PRINTF("DEBUG: S-57 catalogue: %i classes, %i attributes\n",
+           g_hash_table_size(_objlTbl), g_hash_table_size(_attlTbl));
+
+exit:
+    g_free(objpath);
+    g_free(attpath);
+    g_free(objbuf);
+    g_free(attbuf);
+
+    return (NULL == _objlTbl) ? FALSE : TRUE;
+}
+
+static int        _hasUpdate(const char *filename)
+// TRUE if update .001 is next to the base cell
+// Note: update are applied by OGR (UPDATES=APPLY) - not here
+{
+    gchar *upd = g_strdup(filename);
+    guint  len = strlen(upd);
+    upd[len-1] = '1';
+
+    int ret = g_file_test(upd, G_FILE_TEST_EXISTS);
+
+    g_free(upd);
+
+    return ret;
+}
+
+static int        _getLeader(const guchar *rec, guint reclen, guint *base, guint *sizeLen, guint *sizePos)
+// leader of a record - FALSE if malformed
+// Note: caller check that reclen >= 24
+{
+    char buf[6] = {'\0'};
+    memcpy(buf, rec+12, 5);
+
+    *base    = (guint)atoi(buf);
+    *sizeLen = rec[20] - '0';
+    *sizePos = rec[21] - '0';
+
+    // Note: sizeTag is 4 in S-57
+    if (('4'!=rec[23]) || (0==*sizeLen) || (0==*sizePos) || (9<*sizeLen) || (9<*sizePos) ||
+        (*base<24) || (*base>reclen))
+        return FALSE;
+
+    return TRUE;
+}
+
+static int        _getDirEntry(const guchar *rec, guint reclen, guint base, const guchar *dir,
+                               guint sizeLen, guint sizePos, _fld *fld)
+// field of this directory entry - FALSE if it overflow the directory or the record
+{
+    char buf[10];
+
+    if ((dir + 4 + sizeLen + sizePos) > (rec + base))
+        return FALSE;
+
+    memcpy(buf, dir+4, sizeLen);
+    buf[sizeLen] = '\0';
+    guint flen = (guint)atoi(buf);
+
+    memcpy(buf, dir+4+sizeLen, sizePos);
+    buf[sizePos] = '\0';
+    guint fpos = (guint)atoi(buf);
+
+    if ((fpos>reclen) || (flen>reclen) || (reclen<(base + fpos + flen)))
+        return FALSE;
+
+    fld->data = rec + base + fpos;
+    fld->len  = flen;
+
+    return TRUE;
+}
+
+static int        _indexRec(_iso8211 *iso, const guchar *rec, guint reclen)
+// index the fields of one data record (DR) - FALSE if malformed
+{
+    // leader
+    guint base    = 0;
+    guint sizeLen = 0;
+    guint sizePos = 0;
+    if (FALSE == _getLeader(rec, reclen, &base, &sizeLen, &sizePos)) {
+        PRINTF("WARNING: invalid ISO 8211 leader\n");
+        return FALSE;
+    }
+    guint entry = 4 + sizeLen + sizePos;
+
+    _vrec vrec;
+    _frec frec;
+    _fld  dsid = {NULL, 0};
+    _fld  dssi = {NULL, 0};
+    _fld  dspm = {NULL, 0};
+    int   isVR = FALSE;
+    int   isFR = FALSE;
+
+    memset(&vrec, 0, sizeof(_vrec));
+    memset(&frec, 0, sizeof(_frec));
+
+    // directory
+    for (const guchar *dir=rec+24; dir<(rec+base) && FT!=*dir; dir+=entry) {
+        _fld fld = {NULL, 0};
+        if (FALSE == _getDirEntry(rec, reclen, base, dir, sizeLen, sizePos, &fld)) {
+            PRINTF("WARNING: ISO 8211 field overflow record\n");
+            return FALSE;
+        }
+
+        // minimum length of the fixed part of fields read here, by _setAttDSID() and _getLNAM()
+        // Note: len include field terminator
+        if (((0==memcmp(dir, "DSID", 4)) && (fld.len <  9)) ||
+            ((0==memcmp(dir, "DSSI", 4)) && (fld.len < 36)) ||
+            ((0==memcmp(dir, "DSPM", 4)) && (fld.len < 25)) ||
+            ((0==memcmp(dir, "VRID", 4)) && (fld.len <  6)) ||
+            ((0==memcmp(dir, "FRID", 4)) && (fld.len < 13)) ||
+            ((0==memcmp(dir, "FOID", 4)) && (fld.len <  9))) {
+            PRINTF("WARNING: ISO 8211 field %.4s too short (%u)\n", (const char*)dir, fld.len);
+            return FALSE;
+        }
+
+        if      (0 == memcmp(dir, "DSID", 4)) dsid = fld;
+        else if (0 == memcmp(dir, "DSSI", 4)) dssi = fld;
+        else if (0 == memcmp(dir, "DSPM", 4)) dspm = fld;
+        else if (0 == memcmp(dir, "VRID", 4)) {
+            isVR      = TRUE;
+            vrec.rcnm = fld.data[0];
+            vrec.rcid = _getUInt(fld.data+1, 4);
+        }
+        else if (0 == memcmp(dir, "VRPT", 4)) vrec.vrpt = fld;
+        else if (0 == memcmp(dir, "SG2D", 4)) vrec.sg2d = fld;
+        else if (0 == memcmp(dir, "SG3D", 4)) vrec.sg3d = fld;
+        else if (0 == memcmp(dir, "FRID", 4)) {
+            isFR      = TRUE;
+            frec.frid = fld;
+            frec.rcid = _getUInt(fld.data+1, 4);
+            frec.prim = fld.data[5];
+            frec.objl = _getUInt(fld.data+7, 2);
+        }
+        else if (0 == memcmp(dir, "FOID", 4)) frec.foid = fld;
+        else if (0 == memcmp(dir, "ATTF", 4)) frec.attf = fld;
+        else if (0 == memcmp(dir, "NATF", 4)) frec.natf = fld;
+        else if (0 == memcmp(dir, "FFPT", 4)) frec.ffpt = fld;
+        else if (0 == memcmp(dir, "FSPT", 4)) frec.fspt = fld;
+        // else: 0001, ATTV, VRPC, SGCC, FFPC, FSPC, .. skip
+    }
+
+    if (NULL != dsid.data) iso->dsid = dsid;
+    if (NULL != dssi.data) {
+        iso->dssi = dssi;
+        iso->nall = dssi.data[2];
+    }
+    if (NULL != dspm.data) {
+        iso->dspm = dspm;
+        // RCNM(1) RCID(4) HDAT VDAT SDAT CSCL(4) DUNI HUNI PUNI COUN COMF(4) SOMF(4)
+        iso->comf = _getUInt(dspm.data+16, 4);
+        iso->somf = _getUInt(dspm.data+20, 4);
+    }
+
+    if (TRUE == isVR) {
+        GHashTable *tbl = NULL;
+        switch (vrec.rcnm) {
+            case RCNM_VI: tbl = iso->VI; break;
+            case RCNM_VC: tbl = iso->VC; break;
+            case RCNM_VE: tbl = iso->VE; break;
+            default: break;  // face - unused
+        }
+        if (NULL != tbl) {
+            g_array_append_val(iso->vrec, vrec);
+            g_hash_table_insert(tbl, GUINT_TO_POINTER(vrec.rcid), GUINT_TO_POINTER(iso->vrec->len));
+        }
+    }
+
+    if (TRUE == isFR)
+        g_array_append_val(iso->frec, frec);
+
+    return TRUE;
+}
+
+static void       _closeCell(_iso8211 *iso)
+{
+    if (NULL != iso->FE)
+        g_hash_table_destroy(iso->FE);
+    // Note: free_func set at creation (update)
+    if (NULL != iso->upd)
+        g_ptr_array_free(iso->upd, TRUE);
+    if (NULL != iso->buf)
+        g_ptr_array_free(iso->buf, TRUE);
+
+    g_hash_table_destroy(iso->VI);
+    g_hash_table_destroy(iso->VC);
+    g_hash_table_destroy(iso->VE);
+    g_array_free(iso->vrec, TRUE);
+    g_array_free(iso->frec, TRUE);
+    g_mapped_file_unref(iso->mfile);
+    g_free(iso);
+
+    return;
+}
+
+static _iso8211  *_openCell(const char *filename)
+// map cell then index all records
+{
+    GError      *error = NULL;
+    GMappedFile *mfile = g_mapped_file_new(filename, FALSE, &error);
+    if (NULL != error) {
+        PRINTF("WARNING: g_mapped_file_new() failed (%s)\n", error->message);
+        g_error_free(error);
+        return NULL;
+    }
+
+    const guchar *buf = (const guchar *)g_mapped_file_get_contents(mfile);
+    gsize         len = g_mapped_file_get_length(mfile);
+
+    // DDR - leader id 'L'
+    if ((len<24) || ('L'!=buf[6])) {
+        PRINTF("WARNING: not an ISO 8211 file (%s)\n", filename);
+        g_mapped_file_unref(mfile);
+        return NULL;
+    }
+
+    _iso8211 *iso = g_new0(_iso8211, 1);
+    iso->mfile = mfile;
+    iso->comf  = 10000000.0;   // default S-57 ENC
+    iso->somf  = 10.0;
+    iso->vrec  = g_array_new(FALSE, FALSE, sizeof(_vrec));
+    iso->frec  = g_array_new(FALSE, FALSE, sizeof(_frec));
+    iso->VI    = g_hash_table_new(g_direct_hash, g_direct_equal);
+    iso->VC    = g_hash_table_new(g_direct_hash, g_direct_equal);
+    iso->VE    = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    // Note: field descriptions in the DDR are fixed by S-57 - skip it
+    for (gsize pos=0; (pos+24)<=len; ) {
+        char  lbuf[6] = {'\0'};
+        memcpy(lbuf, buf+pos, 5);
+        guint reclen = (guint)atoi(lbuf);
+
+        if ((reclen<24) || (len<(pos+reclen))) {
+            PRINTF("WARNING: ISO 8211 record truncated (%s)\n", filename);
+            _closeCell(iso);
+            return NULL;
+        }
+
+        if (('L'!=buf[pos+6]) && (FALSE==_indexRec(iso, buf+pos, reclen))) {
+            PRINTF("WARNING: ISO 8211 record malformed at %u (%s)\n", (guint)pos, filename);
+            _closeCell(iso);
+            return NULL;
+        }
+
+        pos += reclen;
+    }
+
+    return iso;
+}
+
+static _vrec     *_getVRec(_iso8211 *iso, guint rcnm, guint rcid)
+{
+    GHashTable *tbl = NULL;
+    switch (rcnm) {
+        case RCNM_VI: tbl = iso->VI; break;
+        case RCNM_VC: tbl = iso->VC; break;
+        case RCNM_VE: tbl = iso->VE; break;
+        default: return NULL;
+    }
+
+    guint idx = GPOINTER_TO_UINT(g_hash_table_lookup(tbl, GUINT_TO_POINTER(rcid)));
+    if (0 == idx)
+        return NULL;
+
+    return &g_array_index(iso->vrec, _vrec, idx-1);
+}
+
+static int        _getNodeXY(_iso8211 *iso, const guchar *name, pt3 *pt)
+// NAME: RCNM(1) RCID(4)
+{
+    _vrec *v = _getVRec(iso, name[0], _getUInt(name+1, 4));
+    if ((NULL==v) || (NULL==v->sg2d.data) || (v->sg2d.len<9)) {
+        PRINTF("WARNING: node not found (RCNM:%i RCID:%i)\n", name[0], _getUInt(name+1, 4));
+        return FALSE;
+    }
+
+    pt->y = _getInt32(v->sg2d.data  ) / iso->comf;
+    pt->x = _getInt32(v->sg2d.data+4) / iso->comf;
+    pt->z = 0.0;
+
+    return TRUE;
+}
+
+static int        _addEdge(_iso8211 *iso, guint rcid, int reverse, GArray *pts)
+// append edge (begin node, SG2D, end node) to pts
+{
+    _vrec *v = _getVRec(iso, RCNM_VE, rcid);
+    if ((NULL==v) || (NULL==v->vrpt.data)) {
+        PRINTF("WARNING: edge not found (RCID:%i)\n", rcid);
+        return FALSE;
+    }
+
+    pt3 beg = {0.0, 0.0, 0.0};
+    pt3 end = {0.0, 0.0, 0.0};
+    // VRPT: NAME(5) ORNT USAG TOPI MASK
+    for (guint i=0; (i+1)*9<v->vrpt.len; ++i) {
+        const guchar *g = v->vrpt.data + i*9;
+        if (1 == g[7]) _getNodeXY(iso, g, &beg);
+        if (2 == g[7]) _getNodeXY(iso, g, &end);
+    }
+
+    guint n      = (NULL == v->sg2d.data) ? 0 : (v->sg2d.len-1) / 8;
+    guint npt    = n + 2;
+    guint first  = pts->len;
+
+    g_array_set_size(pts, first + npt);
+    pt3 *p = &g_array_index(pts, pt3, first);
+
+    p[0]     = beg;
+    p[npt-1] = end;
+    for (guint i=0; i<n; ++i) {
+        p[i+1].y = _getInt32(v->sg2d.data + i*8    ) / iso->comf;
+        p[i+1].x = _getInt32(v->sg2d.data + i*8 + 4) / iso->comf;
+        p[i+1].z = 0.0;
+    }
+
+    if (TRUE == reverse) {
+        for (guint i=0, j=npt-1; i<j; ++i, --j) {
+            pt3 tmp = p[i];
+            p[i] = p[j];
+            p[j] = tmp;
+        }
+    }
+
+    return TRUE;
+}
+
+static S57_geo   *_newLINES(GArray *pts)
+{
+    geocoord *linexyz = NULL;
+    if (0 != pts->len) {
+        linexyz = (geocoord*)S57_newGeoData(NULL, sizeof(pt3) * pts->len);
+        memcpy(linexyz, pts->data, sizeof(pt3) * pts->len);
+    }
+
+    return S57_setLINES(pts->len, linexyz);
+}
+
+static int        _setExtent(S57_geo *geo, pt3 *pt, guint npt)
+{
+    double W =  INFINITY, S =  INFINITY;
+    double E = -INFINITY, N = -INFINITY;
+
+    for (guint i=0; i<npt; ++i) {
+        if (W > pt[i].x) W = pt[i].x;
+        if (E < pt[i].x) E = pt[i].x;
+        if (S > pt[i].y) S = pt[i].y;
+        if (N < pt[i].y) N = pt[i].y;
+    }
+
+    S57_setExt(geo, W, S, E, N);
+
+    return TRUE;
+}
+
+static double     _ringArea(pt3 *pt, guint npt)
+// CW if area is < 0, else CCW
+{
+    double area = 0.0;
+    for (guint i=0; (i+1)<npt; ++i)
+        area += (pt[i].x * pt[i+1].y) - (pt[i+1].x * pt[i].y);
+
+    return area;
+}
+
+static S57_geo   *_assembleAREA(_iso8211 *iso, _frec *f, const char *objname)
+// link edges into rings - S57 area have CW outer ring and CCW inner ring
+{
+    // FSPT: NAME(5) ORNT USAG MASK
+    guint     nEdge = (f->fspt.len-1) / 8;
+    GArray   *edges = g_array_new(FALSE, FALSE, sizeof(GArray*));
+    gboolean *used  = g_new0(gboolean, nEdge);
+    int       outer = -1;  // ring index of exterior boundary
+    int       closed= TRUE;
+
+    for (guint i=0; i<nEdge; ++i) {
+        const guchar *g    = f->fspt.data + i*8;
+        GArray       *pts  = g_array_new(FALSE, FALSE, sizeof(pt3));
+
+        _addEdge(iso, _getUInt(g+1, 4), (2==g[5]) ? TRUE : FALSE, pts);
+        g_array_append_val(edges, pts);
+    }
+
+    GPtrArray *rings = g_ptr_array_new();
+    for (guint i=0; i<nEdge; ++i) {
+        if ((TRUE==used[i]) || (0==g_array_index(edges, GArray*, i)->len))
+            continue;
+
+        GArray *ring = g_array_new(FALSE, FALSE, sizeof(pt3));
+        GArray *e    = g_array_index(edges, GArray*, i);
+        g_array_append_vals(ring, e->data, e->len);
+        used[i] = TRUE;
+
+        // USAG: 1 - exterior, 3 - exterior truncated by data limit
+        guint usag = f->fspt.data[i*8 + 6];
+        if ((-1==outer) && (1==usag || 3==usag))
+            outer = rings->len;
+
+        // Note: edges are usualy in sequence, so start searching at the next one
+        for (;;) {
+            pt3 *beg = &g_array_index(ring, pt3, 0);
+            pt3 *end = &g_array_index(ring, pt3, ring->len-1);
+            if ((beg->x==end->x) && (beg->y==end->y) && (1<ring->len))
+                break;
+
+            int found = FALSE;
+            for (guint k=1; k<nEdge && FALSE==found; ++k) {
+                guint j = (i + k) % nEdge;
+                if (TRUE == used[j])
+                    continue;
+
+                GArray *ej = g_array_index(edges, GArray*, j);
+                if (0 == ej->len)
+                    continue;
+
+                pt3 *jbeg = &g_array_index(ej, pt3, 0);
+                pt3 *jend = &g_array_index(ej, pt3, ej->len-1);
+                if ((jbeg->x==end->x) && (jbeg->y==end->y)) {
+                    g_array_append_vals(ring, jbeg+1, ej->len-1);
+                    found = TRUE;
+                } else {
+                    if ((jend->x==end->x) && (jend->y==end->y)) {
+                        for (int n=ej->len-2; n>=0; --n)
+                            g_array_append_val(ring, g_array_index(ej, pt3, n));
+                        found = TRUE;
+                    }
+                }
+                if (TRUE == found)
+                    used[j] = TRUE;
+            }
+
+            if (FALSE == found) {
+                PRINTF("ERROR: S-57 ring (AREA) not closed, feature skipped (%s:%u)\n", objname, f->rcid);
+                closed = FALSE;
+                break;
+            }
+        }
+
+        g_ptr_array_add(rings, ring);
+
+        if (FALSE == closed)
+            break;
+    }
+
+    S57_geo *geo = NULL;
+    if (FALSE == closed) {
+        for (guint i=0; i<rings->len; ++i)
+            g_array_free((GArray*)g_ptr_array_index(rings, i), TRUE);
+    } else if (0 != rings->len) {
+        // exterior first
+        if (0 < outer) {
+            gpointer tmp = rings->pdata[0];
+            rings->pdata[0]     = rings->pdata[outer];
+            rings->pdata[outer] = tmp;
+        }
+
+        guint      nRing      = rings->len;
+        guint     *ringxyznbr = (guint    *)S57_newGeoData(NULL, sizeof(guint)      * nRing);
+        geocoord **ringxyz    = (geocoord**)S57_newGeoData(NULL, sizeof(geocoord *) * nRing);
+
+        for (guint iRing=0; iRing<nRing; ++iRing) {
+            GArray *ring = (GArray*)g_ptr_array_index(rings, iRing);
+            pt3    *pt   = (pt3*)ring->data;
+            double  area = _ringArea(pt, ring->len);
+
+            // outer ring CW, inner ring CCW
+            if (((0==iRing) && (area>0.0)) || ((0!=iRing) && (area<0.0))) {
+                for (guint i=0, j=ring->len-1; i<j; ++i, --j) {
+                    pt3 tmp = pt[i];
+                    pt[i] = pt[j];
+                    pt[j] = tmp;
+                }
+            }
+
+            ringxyznbr[iRing] = ring->len;
+            ringxyz   [iRing] = (geocoord*)S57_newGeoData(NULL, sizeof(pt3) * ring->len);
+            memcpy(ringxyz[iRing], ring->data, sizeof(pt3) * ring->len);
+            g_array_free(ring, TRUE);
+        }
+
+        geo = S57_setAREAS(nRing, ringxyznbr, ringxyz);
+        _setExtent(geo, (pt3*)ringxyz[0], ringxyznbr[0]);
+    } else {
+        PRINTF("WARNING: area with no edge (%s)\n", objname);
+    }
+
+    for (guint i=0; i<nEdge; ++i)
+        g_array_free(g_array_index(edges, GArray*, i), TRUE);
+    g_array_free(edges, TRUE);
+    g_ptr_array_free(rings, TRUE);
+    g_free(used);
+
+    return geo;
+}
+
+static S57_geo   *_assembleLINES(_iso8211 *iso, _frec *f, const char *objname)
+// chain edges - return NULL if not continuous (OGR: wkbMultiLineString)
+{
+    guint   nEdge = (f->fspt.len-1) / 8;
+    GArray *pts   = g_array_new(FALSE, FALSE, sizeof(pt3));
+
+    for (guint i=0; i<nEdge; ++i) {
+        const guchar *g     = f->fspt.data + i*8;
+        guint         first = pts->len;
+
+        _addEdge(iso, _getUInt(g+1, 4), (2==g[5]) ? TRUE : FALSE, pts);
+
+        // remove duplicate junction vertex - a gap between edges is a multi-line
+        if ((0!=first) && (first<pts->len)) {
+            pt3 *a = &g_array_index(pts, pt3, first-1);
+            pt3 *b = &g_array_index(pts, pt3, first);
+            if ((a->x!=b->x) || (a->y!=b->y)) {
+                PRINTF("WARNING: multi-line not handled (%s)\n", objname);
+                g_array_free(pts, TRUE);
+                return NULL;
+            }
+            g_array_remove_index(pts, first);
+        }
+    }
+
+    S57_geo *geo = _newLINES(pts);
+    _setExtent(geo, (pt3*)pts->data, pts->len);
+
+    g_array_free(pts, TRUE);
+
+    return geo;
+}
+
+static S57_geo   *_assemblePOINT(_iso8211 *iso, _frec *f, int iPt)
+{
+    if (f->fspt.len < 9)
+        return NULL;
+
+    _vrec *v = _getVRec(iso, f->fspt.data[0], _getUInt(f->fspt.data+1, 4));
+    if (NULL == v)
+        return NULL;
+
+    if ((-1==iPt) && ((NULL==v->sg2d.data) || (v->sg2d.len<9)))
+        return NULL;
+
+    geocoord *pointxyz = (geocoord*)S57_newGeoData(NULL, sizeof(geocoord)*3);
+
+    if (-1 == iPt) {
+        pointxyz[0] = _getInt32(v->sg2d.data+4) / iso->comf;
+        pointxyz[1] = _getInt32(v->sg2d.data  ) / iso->comf;
+        pointxyz[2] = 0.0;
+    } else {
+        // SG3D: YCOO XCOO VE3D
+        const guchar *p = v->sg3d.data + iPt*12;
+        pointxyz[0] = _getInt32(p+4) / iso->comf;
+        pointxyz[1] = _getInt32(p  ) / iso->comf;
+        pointxyz[2] = _getInt32(p+8) / iso->somf;
+    }
+
+    S57_geo *geo = S57_setPOINT(pointxyz);
+    S57_setExt(geo, pointxyz[0], pointxyz[1], pointxyz[0], pointxyz[1]);
+
+    return geo;
+}
+
+static guint      _getSndNbr(_iso8211 *iso, _frec *f)
+// number of sounding in SG3D, 0 if not a multipoint
+{
+    if ((PRIM_P!=f->prim) || (f->fspt.len<9))
+        return 0;
+
+    _vrec *v = _getVRec(iso, f->fspt.data[0], _getUInt(f->fspt.data+1, 4));
+    if ((NULL==v) || (NULL==v->sg3d.data))
+        return 0;
+
+    return (v->sg3d.len-1) / 12;
+}
+
+static int        _setAttInt(S57_geo *geo, const char *name, gint val)
+{
+    char buf[32];
+    g_snprintf(buf, sizeof(buf), "%i", val);
+    S57_setAtt(geo, name, buf);
+
+    return TRUE;
+}
+
+static int        _setAttList(S57_geo *geo, const char *name, GString *list, guint n)
+// IntegerList / StringList as formated by OGR: (n:v1,v2,..)
+{
+    char buf[32];
+    g_snprintf(buf, sizeof(buf), "(%i:", n);
+    g_string_prepend(list, buf);
+    g_string_append_c(list, ')');
+
+    S57_setAtt(geo, name, list->str);
+
+    return TRUE;
+}
+
+static int        _setAttVal(S57_geo *geo, guint attl, const char *val)
+// set value according to attribute type (as OGR would)
+{
+    _attdef *att = (_attdef *)g_hash_table_lookup(_attlTbl, GUINT_TO_POINTER(attl));
+    if (NULL == att) {
+        PRINTF("WARNING: unknown ATTL:%i\n", attl);
+        return FALSE;
+    }
+
+    int isNum = ('E'==att->type || 'I'==att->type || 'F'==att->type);
+
+    // PRESERVE_EMPTY_NUMBERS=ON
+    if ('\0' == *val) {
+        if (TRUE == isNum)
+            S57_setAtt(geo, att->acronym, EMPTY_NUMBER_MARKER);
+        return TRUE;
+    }
+
+    if ('F' == att->type) {
+        char buf[G_ASCII_DTOSTR_BUF_SIZE];
+        g_ascii_formatd(buf, sizeof(buf), "%.15g", g_ascii_strtod(val, NULL));
+        S57_setAtt(geo, att->acronym, buf);
+        return TRUE;
+    }
+
+    if (('E'==att->type) || ('I'==att->type)) {
+        _setAttInt(geo, att->acronym, atoi(val));
+        return TRUE;
+    }
+
+    // A, S, L
+    if (TRUE == g_utf8_validate(val, -1, NULL)) {
+        S57_setAtt(geo, att->acronym, val);
+    } else {
+        // lexical level 1 (ISO 8859-1)
+        gchar *utf8 = g_convert(val, -1, "UTF-8", "ISO-8859-1", NULL, NULL, NULL);
+        S57_setAtt(geo, att->acronym, (NULL==utf8) ? "" : utf8);
+        g_free(utf8);
+    }
+
+    return TRUE;
+}
+
+static int        _setATTF(S57_geo *geo, _fld *fld)
+// ATTL(2) ATVL(A) - level 0/1
+{
+    const guchar *p   = fld->data;
+    const guchar *end = fld->data + fld->len - 1;
+    GString      *val = g_string_sized_new(32);
+
+    while (p+2 < end) {
+        guint attl = _getUInt(p, 2);
+        p += 2;
+
+        g_string_truncate(val, 0);
+        while (p<end && UT!=*p)
+            g_string_append_c(val, *p++);
+        ++p;  // UT
+
+        _setAttVal(geo, attl, val->str);
+    }
+
+    g_string_free(val, TRUE);
+
+    return TRUE;
+}
+
+static int        _setNATF(S57_geo *geo, _fld *fld, guint nall)
+// ATTL(2) ATVL(A) - level 2 is UCS-2 (terminated by UT 0x00)
+{
+    if (2 != nall)
+        return _setATTF(geo, fld);
+
+    const guchar *p    = fld->data;
+    const guchar *end  = fld->data + fld->len - 2;
+    GArray       *ucs2 = g_array_new(TRUE, FALSE, sizeof(gunichar2));
+
+    while (p+2 < end) {
+        guint attl = _getUInt(p, 2);
+        p += 2;
+
+        g_array_set_size(ucs2, 0);
+        while (p+1<end && !(UT==p[0] && 0==p[1])) {
+            gunichar2 c = (gunichar2)_getUInt(p, 2);
+            g_array_append_val(ucs2, c);
+            p += 2;
+        }
+        p += 2;  // UT
+
+        gchar *utf8 = g_utf16_to_utf8((gunichar2*)ucs2->data, ucs2->len, NULL, NULL, NULL);
+        _setAttVal(geo, attl, (NULL==utf8) ? "" : utf8);
+        g_free(utf8);
+    }
+
+    g_array_free(ucs2, TRUE);
+
+    return TRUE;
+}
+
+static int        _getLNAM(_frec *f, char lnam[17])
+// LNAM as formated by OGR - FOID: AGEN(2) FIDN(4) FIDS(2)
+{
+    if (NULL == f->foid.data) {
+        lnam[0] = '\0';
+        return FALSE;
+    }
+
+    const guchar *foid = f->foid.data;
+    g_snprintf(lnam, 17, "%04X%08X%04X", _getUInt(foid, 2), _getUInt(foid+2, 4), _getUInt(foid+6, 2));
+
+    return TRUE;
+}
+
+static int        _setAttFeature(_iso8211 *iso, S57_geo *geo, _frec *f)
+// OGR field: RCID, PRIM, GRUP, OBJL, RVER, AGEN, FIDN, FIDS, LNAM, LNAM_REFS, FFPT_RIND
+{
+    // FRID: RCNM(1) RCID(4) PRIM(1) GRUP(1) OBJL(2) RVER(2) RUIN(1)
+    const guchar *frid = f->frid.data;
+    _setAttInt(geo, "RCID", _getUInt(frid+1, 4));
+    _setAttInt(geo, "PRIM", frid[5]);
+    _setAttInt(geo, "GRUP", frid[6]);
+    _setAttInt(geo, "OBJL", _getUInt(frid+7, 2));
+    _setAttInt(geo, "RVER", _getUInt(frid+9, 2));
+
+    // FOID: AGEN(2) FIDN(4) FIDS(2)
+    if (NULL != f->foid.data) {
+        const guchar *foid = f->foid.data;
+        char          lnam[17];
+
+        _setAttInt(geo, "AGEN", _getUInt(foid,   2));
+        _setAttInt(geo, "FIDN", _getUInt(foid+2, 4));
+        _setAttInt(geo, "FIDS", _getUInt(foid+6, 2));
+
+        _getLNAM(f, lnam);
+        S57_setAtt(geo, "LNAM", lnam);
+    }
+
+    // FFPT: LNAM(8) RIND(1) COMT(A)
+    if (NULL != f->ffpt.data) {
+        const guchar *p    = f->ffpt.data;
+        const guchar *end  = f->ffpt.data + f->ffpt.len - 1;
+        GString      *refs = g_string_new("");
+        GString      *rind = g_string_new("");
+        guint         n    = 0;
+
+        while (p+9 <= end) {
+            g_string_append_printf(refs, "%s%04X%08X%04X", (0==n)?"":",", _getUInt(p, 2), _getUInt(p+2, 4), _getUInt(p+6, 2));
+            g_string_append_printf(rind, "%s%i",           (0==n)?"":",", p[8]);
+            p += 9;
+            while (p<end && UT!=*p)  // skip COMT
+                ++p;
+            ++p;
+            ++n;
+        }
+
+        _setAttList(geo, "LNAM_REFS", refs, n);
+        _setAttList(geo, "FFPT_RIND", rind, n);
+
+        g_string_free(refs, TRUE);
+        g_string_free(rind, TRUE);
+    }
+
+#ifdef S52_USE_SUPP_LINE_OVERLAP
+    // RETURN_LINKAGES=ON: NAME_RCNM, NAME_RCID, ORNT, USAG, MASK
+    if (NULL != f->fspt.data) {
+        guint    n    = (f->fspt.len-1) / 8;
+        GString *rcnm = g_string_new("");
+        GString *rcid = g_string_new("");
+        GString *ornt = g_string_new("");
+        GString *usag = g_string_new("");
+        GString *mask = g_string_new("");
+
+        for (guint i=0; i<n; ++i) {
+            const guchar *g   = f->fspt.data + i*8;
+            const char   *sep = (0==i) ? "" : ",";
+            g_string_append_printf(rcnm, "%s%i", sep, g[0]);
+            g_string_append_printf(rcid, "%s%i", sep, _getUInt(g+1, 4));
+            g_string_append_printf(ornt, "%s%i", sep, g[5]);
+            g_string_append_printf(usag, "%s%i", sep, g[6]);
+            g_string_append_printf(mask, "%s%i", sep, g[7]);
+
+            // integer edge list for _suppLineOverlap()
+            if (RCNM_VE == g[0])
+                S57_addEdgeRef(geo, _getUInt(g+1, 4), (1 == g[7]));
+        }
+
+        _setAttList(geo, "NAME_RCNM", rcnm, n);
+        _setAttList(geo, "NAME_RCID", rcid, n);
+        _setAttList(geo, "ORNT",      ornt, n);
+        _setAttList(geo, "USAG",      usag, n);
+        _setAttList(geo, "MASK",      mask, n);
+
+        g_string_free(rcnm, TRUE);
+        g_string_free(rcid, TRUE);
+        g_string_free(ornt, TRUE);
+        g_string_free(usag, TRUE);
+        g_string_free(mask, TRUE);
+    }
+#endif  // S52_USE_SUPP_LINE_OVERLAP
+
+    if (NULL != f->attf.data) _setATTF(geo, &f->attf);
+    if (NULL != f->natf.data) _setNATF(geo, &f->natf, iso->nall);
+
+    // optimisation: direct link to the value of Att (GString)
+    // save the search in attList
+    GString *scamin = S57_getAttVal(geo, "SCAMIN");
+    if ((NULL!=scamin) && (NULL!=scamin->str)) {
+        S57_setScamin(geo, S52_atof(scamin->str));
+    }
+
+    return TRUE;
+}
+
+static const guchar *_getStr(const guchar *p, const guchar *end, GString *str)
+// A subfield (UT terminated)
+{
+    g_string_truncate(str, 0);
+    while (p<end && UT!=*p)
+        g_string_append_c(str, *p++);
+
+    return p+1;
+}
+
+static int        _getDSIDEdition(_fld *dsid, guint *edtn, guint *updn)
+// EDTN and UPDN subfield of DSID
+{
+    if ((NULL==dsid->data) || (dsid->len<8))
+        return FALSE;
+
+    // RCNM RCID(4) EXPP INTU DSNM EDTN UPDN ..
+    GString      *str = g_string_new("");
+    const guchar *p   = dsid->data + 7;
+    const guchar *end = dsid->data + dsid->len - 1;
+
+    p = _getStr(p, end, str);
+    p = _getStr(p, end, str); *edtn = (guint)atoi(str->str);
+    p = _getStr(p, end, str); *updn = (guint)atoi(str->str);
+
+    g_string_free(str, TRUE);
+
+    return TRUE;
+}
+
+static int        _setAttDSID(_iso8211 *iso, S57_geo *geo)
+// DSID layer field as named by OGR
+{
+    GString *str = g_string_new("");
+    char     buf[G_ASCII_DTOSTR_BUF_SIZE];
+
+    if (NULL != iso->dsid.data) {
+        // RCNM RCID(4) EXPP INTU DSNM EDTN UPDN UADT(8) ISDT(8) STED(4) PRSP PSDN PRED PROF AGEN(2) COMT
+        const guchar *p   = iso->dsid.data;
+        const guchar *end = iso->dsid.data + iso->dsid.len - 1;
+
+        _setAttInt(geo, "DSID_EXPP", p[5]);
+        _setAttInt(geo, "DSID_INTU", p[6]);
+        p += 7;
+        p = _getStr(p, end, str); S57_setAtt(geo, "DSID_DSNM", str->str);
+        p = _getStr(p, end, str); S57_setAtt(geo, "DSID_EDTN", str->str);
+        p = _getStr(p, end, str); S57_setAtt(geo, "DSID_UPDN", str->str);
+
+        if (p+20 <= end) {
+            g_string_truncate(str, 0); g_string_append_len(str, (const char*)p, 8); p += 8;
+            S57_setAtt(geo, "DSID_UADT", str->str);
+            g_string_truncate(str, 0); g_string_append_len(str, (const char*)p, 8); p += 8;
+            S57_setAtt(geo, "DSID_ISDT", str->str);
+            g_string_truncate(str, 0); g_string_append_len(str, (const char*)p, 4); p += 4;
+            g_ascii_formatd(buf, sizeof(buf), "%.15g", g_ascii_strtod(str->str, NULL));
+            S57_setAtt(geo, "DSID_STED", buf);
+
+            _setAttInt(geo, "DSID_PRSP", *p++);
+            p = _getStr(p, end, str); S57_setAtt(geo, "DSID_PSDN", str->str);
+            p = _getStr(p, end, str); S57_setAtt(geo, "DSID_PRED", str->str);
+            if (p+3 <= end) {
+                _setAttInt(geo, "DSID_PROF", p[0]);
+                _setAttInt(geo, "DSID_AGEN", _getUInt(p+1, 2));
+                p += 3;
+                p = _getStr(p, end, str); S57_setAtt(geo, "DSID_COMT", str->str);
+            }
+        }
+    }
+
+    if (NULL != iso->dssi.data) {
+        // DSTR AALL NALL NOMR(4) NOCR(4) NOGR(4) NOLR(4) NOIN(4) NOCN(4) NOED(4) NOFA(4)
+        const guchar *p = iso->dssi.data;
+        const char   *nm[] = {"DSSI_NOMR", "DSSI_NOCR", "DSSI_NOGR", "DSSI_NOLR",
+                              "DSSI_NOIN", "DSSI_NOCN", "DSSI_NOED", "DSSI_NOFA"};
+
+        _setAttInt(geo, "DSSI_DSTR", p[0]);
+        _setAttInt(geo, "DSSI_AALL", p[1]);
+        _setAttInt(geo, "DSSI_NALL", p[2]);
+        for (guint i=0; i<G_N_ELEMENTS(nm); ++i)
+            _setAttInt(geo, nm[i], _getUInt(p+3+i*4, 4));
+    }
+
+    if (NULL != iso->dspm.data) {
+        // RCNM RCID(4) HDAT VDAT SDAT CSCL(4) DUNI HUNI PUNI COUN COMF(4) SOMF(4) COMT
+        const guchar *p   = iso->dspm.data;
+        const guchar *end = iso->dspm.data + iso->dspm.len - 1;
+
+        _setAttInt(geo, "DSPM_HDAT", p[5]);
+        _setAttInt(geo, "DSPM_VDAT", p[6]);
+        _setAttInt(geo, "DSPM_SDAT", p[7]);
+        _setAttInt(geo, "DSPM_CSCL", _getUInt(p+8, 4));
+        _setAttInt(geo, "DSPM_DUNI", p[12]);
+        _setAttInt(geo, "DSPM_HUNI", p[13]);
+        _setAttInt(geo, "DSPM_PUNI", p[14]);
+        _setAttInt(geo, "DSPM_COUN", p[15]);
+        _setAttInt(geo, "DSPM_COMF", _getUInt(p+16, 4));
+        _setAttInt(geo, "DSPM_SOMF", _getUInt(p+20, 4));
+        _getStr(p+24, end, str);
+        S57_setAtt(geo, "DSPM_COMT", str->str);
+    }
+
+    g_string_free(str, TRUE);
+
+    return TRUE;
+}
+
+#ifdef S52_USE_SUPP_LINE_OVERLAP
+static S57_geo   *_loadPrimitive(_iso8211 *iso, _layer_t type, _vrec *v)
+// RETURN_PRIMITIVES=ON: ConnectedNode, Edge (SG2D only, no end node)
+{
+    S57_geo *geo = NULL;
+
+    if (_LAYER_CN == type) {
+        if ((NULL==v->sg2d.data) || (v->sg2d.len<9))
+            return NULL;
+
+        geocoord *pointxyz = (geocoord*)S57_newGeoData(NULL, sizeof(geocoord)*3);
+        pointxyz[0] = _getInt32(v->sg2d.data+4) / iso->comf;
+        pointxyz[1] = _getInt32(v->sg2d.data  ) / iso->comf;
+        pointxyz[2] = 0.0;
+
+        geo = S57_setPOINT(pointxyz);
+        S57_setExt(geo, pointxyz[0], pointxyz[1], pointxyz[0], pointxyz[1]);
+        S57_setName(geo, "ConnectedNode");
+    } else {
+        guint   n   = (NULL == v->sg2d.data) ? 0 : (v->sg2d.len-1) / 8;
+        GArray *pts = g_array_sized_new(FALSE, FALSE, sizeof(pt3), n);
+        for (guint i=0; i<n; ++i) {
+            pt3 pt = {_getInt32(v->sg2d.data + i*8 + 4) / iso->comf,
+                      _getInt32(v->sg2d.data + i*8    ) / iso->comf,
+                      0.0};
+            g_array_append_val(pts, pt);
+        }
+        geo = _newLINES(pts);
+        if (0 != n)
+            _setExtent(geo, (pt3*)pts->data, pts->len);
+        g_array_free(pts, TRUE);
+
+        S57_setName(geo, "Edge");
+
+        // VRPT: NAME(5) ORNT USAG TOPI MASK
+        for (guint i=0; (i+1)*9<v->vrpt.len && i<2; ++i) {
+            const guchar *g = v->vrpt.data + i*9;
+            char          nm[16];
+
+            g_snprintf(nm, sizeof(nm), "NAME_RCNM_%i", i); _setAttInt(geo, nm, g[0]);
+            g_snprintf(nm, sizeof(nm), "NAME_RCID_%i", i); _setAttInt(geo, nm, _getUInt(g+1, 4));
+            g_snprintf(nm, sizeof(nm), "ORNT_%i",      i); _setAttInt(geo, nm, g[5]);
+            g_snprintf(nm, sizeof(nm), "USAG_%i",      i); _setAttInt(geo, nm, g[6]);
+            g_snprintf(nm, sizeof(nm), "TOPI_%i",      i); _setAttInt(geo, nm, g[7]);
+            g_snprintf(nm, sizeof(nm), "MASK_%i",      i); _setAttInt(geo, nm, g[8]);
+        }
+    }
+
+    _setAttInt(geo, "RCNM", v->rcnm);
+    _setAttInt(geo, "RCID", v->rcid);
+
+    return geo;
+}
+#endif  // S52_USE_SUPP_LINE_OVERLAP
+
+static gint       _cmpOBJL(gconstpointer a, gconstpointer b)
+{
+    guint A = *(guint*)a;
+    guint B = *(guint*)b;
+
+    return (A < B) ? -1 : (A > B);
+}
+
+static int        _loadLayer(_iso8211 *iso, _layer_t type, const char *layername, GArray *idx,
+                             S52_loadLayer_cb loadLayer_cb, S52_loadObject_cb loadObject_cb)
+{
+    _isolayer layer = {iso, type, idx};
+
+#ifdef _MINGW
+    // on Windows 32 the callback is broken
+    S52_loadLayer(layername, &layer, NULL);
+    (void)loadObject_cb;
+#else
+    loadLayer_cb(layername, &layer, loadObject_cb);
+#endif
+
+    return TRUE;
+}
+
+DLL int   STD  S52_loadLayer(const char *layername, void *layer, S52_loadObject_cb loadObject_cb);
+int            S57_iso8211LoadCell(const char *filename, S52_loadLayer_cb loadLayer_cb, S52_loadObject_cb loadObject_cb)
+{
+    return_if_null(filename);
+
+    if (NULL==loadLayer_cb || NULL==loadObject_cb) {
+        PRINTF("ERROR: should be using default S52_loadLayer_cb() / S52_loadObject_cb() callback\n");
+        g_assert(0);
+        return FALSE;
+    }
+
+    if (FALSE == g_str_has_suffix(filename, ".000"))
+        return FALSE;
+
+    if (TRUE == _hasUpdate(filename)) {
+        PRINTF("NOTE: update found, fallback to OGR (%s)\n", filename);
+        return FALSE;
+    }
+
+    if (FALSE == _loadCatalogue())
+        return FALSE;
+
+    _iso8211 *iso = _openCell(filename);
+    if (NULL == iso)
+        return FALSE;
+
+    PRINTF("DEBUG: starting to stream cell (%s): %i spatial, %i feature\n", filename, iso->vrec->len, iso->frec->len);
+
+    GArray *idx = g_array_new(FALSE, FALSE, sizeof(guint));
+
+    {   // 1st layer: DSID
+        guint zero = 0;
+        g_array_append_val(idx, zero);
+        _loadLayer(iso, _LAYER_DSID, "DSID", idx, loadLayer_cb, loadObject_cb);
+    }
+
+#ifdef S52_USE_SUPP_LINE_OVERLAP
+    // primitive layer - same order as OGR
+    {
+        g_array_set_size(idx, 0);
+        for (guint i=0; i<iso->vrec->len; ++i)
+            if (RCNM_VC == g_array_index(iso->vrec, _vrec, i).rcnm)
+                g_array_append_val(idx, i);
+        _loadLayer(iso, _LAYER_CN, "ConnectedNode", idx, loadLayer_cb, loadObject_cb);
+
+        g_array_set_size(idx, 0);
+        for (guint i=0; i<iso->vrec->len; ++i)
+            if (RCNM_VE == g_array_index(iso->vrec, _vrec, i).rcnm)
+                g_array_append_val(idx, i);
+        _loadLayer(iso, _LAYER_EDGE, "Edge", idx, loadLayer_cb, loadObject_cb);
+    }
+#endif
+
+    {   // one layer per object class, in OBJL order (as OGR)
+        GHashTable *classes = g_hash_table_new(g_direct_hash, g_direct_equal);
+        GArray     *objls   = g_array_new(FALSE, FALSE, sizeof(guint));
+
+        for (guint i=0; i<iso->frec->len; ++i) {
+            guint objl = g_array_index(iso->frec, _frec, i).objl;
+            if (NULL == g_hash_table_lookup(classes, GUINT_TO_POINTER(objl))) {
+                g_hash_table_insert(classes, GUINT_TO_POINTER(objl), GUINT_TO_POINTER(TRUE));
+                g_array_append_val(objls, objl);
+            }
+        }
+        g_array_sort(objls, _cmpOBJL);
+
+        for (guint i=0; i<objls->len; ++i) {
+            guint       objl = g_array_index(objls, guint, i);
+            const char *name = (const char *)g_hash_table_lookup(_objlTbl, GUINT_TO_POINTER(objl));
+            if (NULL == name) {
+                PRINTF("WARNING: unknown OBJL:%i .. skipped\n", objl);
+                continue;
+            }
+
+            g_array_set_size(idx, 0);
+            for (guint j=0; j<iso->frec->len; ++j)
+                if (objl == g_array_index(iso->frec, _frec, j).objl)
+                    g_array_append_val(idx, j);
+
+            _loadLayer(iso, _LAYER_FEAT, name, idx, loadLayer_cb, loadObject_cb);
+        }
+
+        g_array_free(objls, TRUE);
+        g_hash_table_destroy(classes);
+    }
+
+    g_array_free(idx, TRUE);
+
+    _closeCell(iso);
+
+    return TRUE;
+}
+
+int            S57_iso8211LoadLayer(const char *layername, void *isolayer, S52_loadObject_cb loadObject_cb)
+{
+    if ((NULL==layername) || (NULL==isolayer)) {
+        PRINTF("ERROR: layername || isolayer is NULL\n");
+        g_assert(0);
+        return FALSE;
+    }
+
+    if (NULL == loadObject_cb) {
+        static int  silent  = FALSE;
+        if (FALSE == silent) {
+            PRINTF("NOTE: using default S52_loadObject() callback\n");
+            PRINTF("NOTE: (this msg will not repeat)\n");
+            silent = TRUE;
+        }
+        loadObject_cb = S52_loadObject;
+    }
+
+    _isolayer  *layer   = (_isolayer *)isolayer;
+    _isofeature feature = {layer, 0, -1};
+
+    for (guint i=0; i<layer->idx->len; ++i) {
+        feature.idx = g_array_index(layer->idx, guint, i);
+        feature.iPt = -1;
+
+        // SPLIT_MULTIPOINT=ON: one feature per sounding
+        guint nSnd = 0;
+        if (_LAYER_FEAT == layer->type)
+            nSnd = _getSndNbr(layer->iso, &g_array_index(layer->iso->frec, _frec, feature.idx));
+
+        if (0 == nSnd) {
+#ifdef _MINGW
+            S52_loadObject(layername, &feature);
+#else
+            loadObject_cb(layername, (void*)&feature);
+#endif
+        } else {
+            for (guint j=0; j<nSnd; ++j) {
+                feature.iPt = j;
+#ifdef _MINGW
+                S52_loadObject(layername, &feature);
+#else
+                loadObject_cb(layername, (void*)&feature);
+#endif
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+S57_geo       *S57_iso8211LoadObject(const char *objname, void *feature)
+{
+    return_if_null(objname);
+    return_if_null(feature);
+
+    _isofeature *feat = (_isofeature *)feature;
+    _iso8211    *iso  = feat->layer->iso;
+    S57_geo     *geo  = NULL;
+
+    switch (feat->layer->type) {
+        case _LAYER_DSID:
+            geo = S57_set_META();
+            S57_setName(geo, objname);
+            _setAttDSID(iso, geo);
+            return geo;
+
+#ifdef S52_USE_SUPP_LINE_OVERLAP
+        case _LAYER_CN:
+        case _LAYER_EDGE:
+            return _loadPrimitive(iso, feat->layer->type, &g_array_index(iso->vrec, _vrec, feat->idx));
+#endif
+
+        case _LAYER_FEAT: {
+            _frec *f = &g_array_index(iso->frec, _frec, feat->idx);
+
+            if (NULL == f->fspt.data) {
+                // C_AGGR, C_ASSO, M_NPUB, ..
+                geo = S57_set_META();
+            } else {
+                switch (f->prim) {
+                    case PRIM_P: geo = _assemblePOINT(iso, f, feat->iPt); break;
+                    case PRIM_L: geo = _assembleLINES(iso, f, objname);   break;
+                    case PRIM_A: geo = _assembleAREA (iso, f, objname);   break;
+                    default:     geo = S57_set_META();                     break;
+                }
+            }
+
+            if (NULL == geo)
+                return NULL;
+
+            S57_setName(geo, objname);
+            _setAttFeature(iso, geo, f);
+
+            return geo;
+        }
+
+        default:
+            PRINTF("WARNING: unknown layer type (%c)\n", feat->layer->type);
+            g_assert(0);
+    }
+
+    return NULL;
+}
+
+static int        _getField(const guchar *rec, guint reclen, const char *tag, _fld *fld)
+// find field 'tag' in record (DDR or DR)
+{
+    guint base    = 0;
+    guint sizeLen = 0;
+    guint sizePos = 0;
+
+    if ((reclen<24) || (FALSE==_getLeader(rec, reclen, &base, &sizeLen, &sizePos)))
+        return FALSE;
+
+    guint entry = 4 + sizeLen + sizePos;
+    for (const guchar *dir=rec+24; dir<(rec+base) && FT!=*dir; dir+=entry) {
+        if ((dir+4)>(rec+base) || 0!=memcmp(dir, tag, 4))
+            continue;
+
+        return _getDirEntry(rec, reclen, base, dir, sizeLen, sizePos, fld);
+    }
+
+    return FALSE;
+}
+
+static int        _parseFormat(const char *fmt, GArray *width)
+// expand ISO 8211 format controls (ex: "(A(2),I(10),3A,A(3),4R,2A)") to subfield width
+// (0 - variable, delimited by UT)
+// Note: no repeating group (not used by CATD)
+{
+    const char *p = fmt;
+
+    if ('(' == *p)
+        ++p;
+
+    while (('\0'!=*p) && (')'!=*p)) {
+        guint rep = 0;
+        while (g_ascii_isdigit(*p))
+            rep = rep*10 + (*p++ - '0');
+        if (0 == rep)
+            rep = 1;
+
+        if ('(' == *p)
+            return FALSE;
+
+        char  type = *p++;
+        guint w    = 0;
+        if ('b' == type) {
+            // bXY: Y - width in byte
+            if (g_ascii_isdigit(p[0]) && g_ascii_isdigit(p[1])) {
+                w  = p[1] - '0';
+                p += 2;
+            }
+        } else {
+            if ('(' == *p) {
+                ++p;
+                while (g_ascii_isdigit(*p))
+                    w = w*10 + (*p++ - '0');
+                if (')' == *p)
+                    ++p;
+            }
+        }
+
+        for (guint i=0; i<rep; ++i)
+            g_array_append_val(width, w);
+
+        if (',' == *p)
+            ++p;
+    }
+
+    return TRUE;
+}
+
+int            S57_iso8211ReadCATALOG(const char *filename, S57_iso8211CATD_cb catd_cb, void *user_data)
+{
+    return_if_null(filename);
+    return_if_null(catd_cb);
+
+    GError      *error = NULL;
+    GMappedFile *mfile = g_mapped_file_new(filename, FALSE, &error);
+    if (NULL != error) {
+        PRINTF("WARNING: g_mapped_file_new() failed (%s)\n", error->message);
+        g_error_free(error);
+        return FALSE;
+    }
+
+    const guchar *buf    = (const guchar *)g_mapped_file_get_contents(mfile);
+    gsize         len    = g_mapped_file_get_length(mfile);
+    gchar       **labels = NULL;            // CATD subfield name
+    GArray       *width  = g_array_new(FALSE, FALSE, sizeof(guint));
+    gchar       **val    = NULL;            // CATD subfield value
+    int           idx[6] = {-1,-1,-1,-1,-1,-1};
+    guint         nCATD  = 0;
+
+    for (gsize pos=0; (pos+24)<=len; ) {
+        char  lbuf[6] = {'\0'};
+        memcpy(lbuf, buf+pos, 5);
+        guint reclen = (guint)atoi(lbuf);
+
+        if ((reclen<24) || (len<(pos+reclen))) {
+            PRINTF("WARNING: ISO 8211 record truncated (%s)\n", filename);
+            break;
+        }
+
+        const guchar *rec = buf + pos;
+        _fld          fld = {NULL, 0};
+        pos += reclen;
+
+        if (FALSE == _getField(rec, reclen, "CATD", &fld))
+            continue;
+
+        if ('L' == rec[6]) {
+            // DDR: field controls, name UT labels UT format controls FT
+            // field control length (leader) - from the file, check it
+            if ((FALSE==g_ascii_isdigit(rec[10])) || (FALSE==g_ascii_isdigit(rec[11]))) {
+                PRINTF("WARNING: CATD field control length invalid (%s)\n", filename);
+                break;
+            }
+            guint  fctl = (rec[10]-'0')*10 + (rec[11]-'0');
+            if (fctl > fld.len) {
+                PRINTF("WARNING: CATD field control length %u > field length %u (%s)\n", fctl, fld.len, filename);
+                break;
+            }
+            gchar *desc = g_strndup((const gchar *)fld.data + fctl, fld.len - fctl);
+            g_strdelimit(desc, "\x1e", '\0');
+            gchar **part = g_strsplit(desc, "\x1f", 0);
+            g_free(desc);
+
+            if ((NULL!=part[0]) && (NULL!=part[1]) && (NULL!=part[2])) {
+                labels = g_strsplit(part[1], "!", 0);
+                _parseFormat(part[2], width);
+            }
+            g_strfreev(part);
+
+            if ((NULL==labels) || (g_strv_length(labels)!=width->len)) {
+                PRINTF("WARNING: CATD field description not handled (%s)\n", filename);
+                break;
+            }
+
+            const char *name[6] = {"FILE", "IMPL", "SLAT", "WLON", "NLAT", "ELON"};
+            for (guint i=0; NULL!=labels[i]; ++i)
+                for (guint j=0; j<6; ++j)
+                    if (0 == g_strcmp0(labels[i], name[j]))
+                        idx[j] = i;
+
+            val = g_new0(gchar*, width->len + 1);
+
+            continue;
+        }
+
+        if ((NULL==val) || (-1==idx[0]))
+            continue;
+
+        // DR: split CATD subfields
+        const guchar *p   = fld.data;
+        const guchar *end = fld.data + fld.len;
+        for (guint i=0; i<width->len; ++i) {
+            guint w = g_array_index(width, guint, i);
+            guint n = 0;
+            if (0 == w) {
+                while (((p+n)<end) && (UT!=p[n]) && (FT!=p[n]))
+                    ++n;
+            } else {
+                n = MIN(w, (guint)(end-p));
+            }
+
+            g_free(val[i]);
+            val[i] = g_strndup((const gchar *)p, n);
+
+            p += n;
+            if ((0==w) && (p<end) && (UT==*p))
+                ++p;
+        }
+
+        double ext[4] = {NAN, NAN, NAN, NAN};  // S, W, N, E
+        for (guint j=0; j<4; ++j)
+            if ((-1!=idx[2+j]) && ('\0'!=val[idx[2+j]][0]))
+                ext[j] = g_ascii_strtod(val[idx[2+j]], NULL);
+
+        catd_cb(val[idx[0]], (-1==idx[1]) ? "" : val[idx[1]], ext[0], ext[1], ext[2], ext[3], user_data);
+        ++nCATD;
+    }
+
+    PRINTF("DEBUG: %s: %i CATD entry\n", filename, nCATD);
+
+    g_strfreev(val);
+    g_strfreev(labels);
+    g_array_free(width, TRUE);
+    g_mapped_file_unref(mfile);
+
+    return (0 == nCATD) ? FALSE : TRUE;
+}
+
+static GArray    *_splitFld(_fld *fld, guint size)
+// split a field in entries (without FT) - size 0: FFPT, LNAM(8) RIND(1) COMT(A)
+{
+    GArray *ent = g_array_new(FALSE, FALSE, sizeof(_fld));
+    if (NULL == fld->data)
+        return ent;
+
+    const guchar *p   = fld->data;
+    const guchar *end = fld->data + fld->len - 1;
+
+    while (p < end) {
+        _fld e = {p, size};
+        if (0 == size) {
+            const guchar *q = p + 9;
+            while (q<end && UT!=*q)
+                ++q;
+            e.len = (q<end) ? (guint)(q-p)+1 : (guint)(end-p);
+        }
+        if (end < p+e.len)
+            break;
+
+        g_array_append_val(ent, e);
+        p += e.len;
+    }
+
+    return ent;
+}
+
+static GArray    *_splitATT(_fld *fld, guint w)
+// split ATTF / NATF in entries ATTL(2) ATVL UT - w: width of UT and FT (2 - NATF UCS-2)
+{
+    GArray *ent = g_array_new(FALSE, FALSE, sizeof(_fld));
+    if (NULL == fld->data)
+        return ent;
+
+    const guchar *p   = fld->data;
+    const guchar *end = fld->data + fld->len - w;
+
+    while (p+2 < end) {
+        const guchar *q = p + 2;
+        while (q<end && !(UT==q[0] && (1==w || 0==q[1])))
+            q += w;
+
+        _fld e = {p, (q<end) ? (guint)(q-p)+w : (guint)(end-p)};
+        g_array_append_val(ent, e);
+        p += e.len;
+    }
+
+    return ent;
+}
+
+static int        _joinFld(_iso8211 *iso, GArray *ent, guint w, _fld *fld)
+// rebuild field from entries - the buffer is own by iso
+{
+    if (0 == ent->len) {
+        fld->data = NULL;
+        fld->len  = 0;
+        return TRUE;
+    }
+
+    GByteArray *buf = g_byte_array_new();
+    for (guint i=0; i<ent->len; ++i) {
+        _fld *e = &g_array_index(ent, _fld, i);
+        g_byte_array_append(buf, e->data, e->len);
+    }
+
+    const guchar ft[2] = {FT, 0x00};
+    g_byte_array_append(buf, ft, w);
+
+    fld->len  = buf->len;
+    fld->data = g_byte_array_free(buf, FALSE);
+    g_ptr_array_add(iso->buf, (gpointer)fld->data);
+
+    return TRUE;
+}
+
+static int        _editFld(_iso8211 *iso, _fld *fld, _fld *ctl, _fld *upd, guint size)
+// FSPC, FFPC, VRPC, SGCC: update instruction(1) index(2) count(2) applied to fld
+{
+    if ((NULL==ctl->data) || (ctl->len<6))
+        return FALSE;
+
+    guint   ui  = ctl->data[0];
+    guint   ix  = _getUInt(ctl->data+1, 2);
+    guint   n   = _getUInt(ctl->data+3, 2);
+    GArray *ent = _splitFld(fld, size);
+    GArray *nu  = _splitFld(upd, size);
+
+    if ((0==ix) || (ent->len+1<ix)) {
+        PRINTF("WARNING: update index out of range (%i/%i)\n", ix, ent->len);
+        g_array_free(nu,  TRUE);
+        g_array_free(ent, TRUE);
+        return FALSE;
+    }
+    --ix;
+
+    switch (ui) {
+        case RUIN_I:
+            g_array_insert_vals(ent, ix, nu->data, MIN(n, nu->len));
+            break;
+        case RUIN_D:
+            g_array_remove_range(ent, ix, MIN(n, ent->len-ix));
+            break;
+        case RUIN_M:
+            for (guint i=0; i<n && i<nu->len && ix+i<ent->len; ++i)
+                g_array_index(ent, _fld, ix+i) = g_array_index(nu, _fld, i);
+            break;
+        default:
+            PRINTF("WARNING: unknown update instruction (%i)\n", ui);
+    }
+
+    _joinFld(iso, ent, 1, fld);
+
+    g_array_free(nu,  TRUE);
+    g_array_free(ent, TRUE);
+
+    return TRUE;
+}
+
+static int        _editATT(_iso8211 *iso, _fld *fld, _fld *upd, guint w)
+// replace / add ATVL of each ATTL in upd - ATVL 0x7f delete the attribute
+{
+    GArray *ent = _splitATT(fld, w);
+    GArray *nu  = _splitATT(upd, w);
+
+    for (guint i=0; i<nu->len; ++i) {
+        _fld  *u    = &g_array_index(nu, _fld, i);
+        guint  attl = _getUInt(u->data, 2);
+        int    del  = ((2+w+w)==u->len) && (0x7f==u->data[2]);
+        guint  j    = 0;
+
+        for (j=0; j<ent->len; ++j)
+            if (attl == _getUInt(g_array_index(ent, _fld, j).data, 2))
+                break;
+
+        if (j < ent->len) {
+            if (TRUE == del)
+                g_array_remove_index(ent, j);
+            else
+                g_array_index(ent, _fld, j) = *u;
+        } else {
+            if (FALSE == del)
+                g_array_append_val(ent, *u);
+        }
+    }
+
+    _joinFld(iso, ent, w, fld);
+
+    g_array_free(nu,  TRUE);
+    g_array_free(ent, TRUE);
+
+    return TRUE;
+}
+
+static int        _updFeature(_iso8211 *iso, const guchar *rec, guint reclen, _fld *frid, int track)
+// apply FRID update record
+{
+    guint rcid = _getUInt(frid->data+1, 4);
+    guint ruin = frid->data[11];
+    guint idx  = GPOINTER_TO_UINT(g_hash_table_lookup(iso->FE, GUINT_TO_POINTER(rcid)));
+
+    if (RUIN_I == ruin) {
+        _frec f;
+        memset(&f, 0, sizeof(_frec));
+        f.frid = *frid;
+        f.rcid = rcid;
+        f.prim = frid->data[5];
+        f.objl = _getUInt(frid->data+7, 2);
+        f.ruin = (TRUE == track) ? RUIN_I : 0;
+        _getField(rec, reclen, "FOID", &f.foid);
+        _getField(rec, reclen, "ATTF", &f.attf);
+        _getField(rec, reclen, "NATF", &f.natf);
+        _getField(rec, reclen, "FFPT", &f.ffpt);
+        _getField(rec, reclen, "FSPT", &f.fspt);
+
+        g_array_append_val(iso->frec, f);
+        g_hash_table_insert(iso->FE, GUINT_TO_POINTER(rcid), GUINT_TO_POINTER(iso->frec->len));
+
+        return TRUE;
+    }
+
+    if (0 == idx) {
+        PRINTF("WARNING: update of unknown feature (RCID:%i)\n", rcid);
+        return FALSE;
+    }
+
+    _frec *f = &g_array_index(iso->frec, _frec, idx-1);
+
+    if (RUIN_D == ruin) {
+        f->del = TRUE;
+        if (TRUE == track)
+            f->ruin = RUIN_D;
+        g_hash_table_remove(iso->FE, GUINT_TO_POINTER(rcid));
+
+        return TRUE;
+    }
+
+    if (RUIN_M == ruin) {
+        _fld fld = {NULL, 0};
+        _fld ctl = {NULL, 0};
+
+        f->frid = *frid;  // RVER
+        if (TRUE == _getField(rec, reclen, "ATTF", &fld)) _editATT(iso, &f->attf, &fld, 1);
+        if (TRUE == _getField(rec, reclen, "NATF", &fld)) _editATT(iso, &f->natf, &fld, (2==iso->nall) ? 2 : 1);
+
+        fld.data = NULL; fld.len = 0;
+        if (TRUE == _getField(rec, reclen, "FFPC", &ctl)) {
+            _getField(rec, reclen, "FFPT", &fld);
+            _editFld(iso, &f->ffpt, &ctl, &fld, 0);
+        }
+
+        fld.data = NULL; fld.len = 0;
+        if (TRUE == _getField(rec, reclen, "FSPC", &ctl)) {
+            _getField(rec, reclen, "FSPT", &fld);
+            _editFld(iso, &f->fspt, &ctl, &fld, 8);
+        }
+
+        if ((TRUE==track) && (RUIN_I!=f->ruin))
+            f->ruin = RUIN_M;
+
+        return TRUE;
+    }
+
+    PRINTF("WARNING: unknown RUIN (%i)\n", ruin);
+
+    return FALSE;
+}
+
+static int        _updSpatial(_iso8211 *iso, const guchar *rec, guint reclen, _fld *vrid, int track)
+// apply VRID update record
+{
+    guint rcnm = vrid->data[0];
+    guint rcid = _getUInt(vrid->data+1, 4);
+    guint ruin = vrid->data[7];
+
+    GHashTable *tbl = NULL;
+    switch (rcnm) {
+        case RCNM_VI: tbl = iso->VI; break;
+        case RCNM_VC: tbl = iso->VC; break;
+        case RCNM_VE: tbl = iso->VE; break;
+        default: return TRUE;  // face - unused
+    }
+
+    if (RUIN_I == ruin) {
+        _vrec v;
+        memset(&v, 0, sizeof(_vrec));
+        v.rcnm = rcnm;
+        v.rcid = rcid;
+        v.upd  = track;
+        _getField(rec, reclen, "VRPT", &v.vrpt);
+        _getField(rec, reclen, "SG2D", &v.sg2d);
+        _getField(rec, reclen, "SG3D", &v.sg3d);
+
+        g_array_append_val(iso->vrec, v);
+        g_hash_table_insert(tbl, GUINT_TO_POINTER(rcid), GUINT_TO_POINTER(iso->vrec->len));
+
+        return TRUE;
+    }
+
+    _vrec *v = _getVRec(iso, rcnm, rcid);
+    if (NULL == v) {
+        PRINTF("WARNING: update of unknown spatial (RCNM:%i RCID:%i)\n", rcnm, rcid);
+        return FALSE;
+    }
+
+    if (RUIN_D == ruin) {
+        // Note: feature using it must be updated by the same file
+        g_hash_table_remove(tbl, GUINT_TO_POINTER(rcid));
+        return TRUE;
+    }
+
+    if (RUIN_M == ruin) {
+        _fld fld = {NULL, 0};
+        _fld ctl = {NULL, 0};
+
+        if (TRUE == _getField(rec, reclen, "VRPC", &ctl)) {
+            _getField(rec, reclen, "VRPT", &fld);
+            _editFld(iso, &v->vrpt, &ctl, &fld, 9);
+        }
+
+        fld.data = NULL; fld.len = 0;
+        if (TRUE == _getField(rec, reclen, "SGCC", &ctl)) {
+            if (TRUE == _getField(rec, reclen, "SG3D", &fld))
+                _editFld(iso, &v->sg3d, &ctl, &fld, 12);
+            else {
+                _getField(rec, reclen, "SG2D", &fld);
+                _editFld(iso, &v->sg2d, &ctl, &fld, 8);
+            }
+        } else {
+            // no control - replace all coordinate
+            if (TRUE == _getField(rec, reclen, "SG2D", &fld)) v->sg2d = fld;
+            if (TRUE == _getField(rec, reclen, "SG3D", &fld)) v->sg3d = fld;
+        }
+
+        if (TRUE == track)
+            v->upd = TRUE;
+
+        return TRUE;
+    }
+
+    PRINTF("WARNING: unknown RUIN (%i)\n", ruin);
+
+    return FALSE;
+}
+
+static int        _applyUpdate(_iso8211 *iso, const char *filename, guint edtn, guint updn, int track)
+// apply update file to the cell in memory
+// edtn, updn: expected DSID of this update
+// track: TRUE mark the record changed by this update
+{
+    GError      *error = NULL;
+    GMappedFile *mfile = g_mapped_file_new(filename, FALSE, &error);
+    if (NULL != error) {
+        PRINTF("WARNING: g_mapped_file_new() failed (%s)\n", error->message);
+        g_error_free(error);
+        return FALSE;
+    }
+    g_ptr_array_add(iso->upd, mfile);
+
+    const guchar *buf = (const guchar *)g_mapped_file_get_contents(mfile);
+    gsize         len = g_mapped_file_get_length(mfile);
+
+    int dsid = FALSE;
+    for (gsize pos=0; (pos+24)<=len; ) {
+        char  lbuf[6] = {'\0'};
+        memcpy(lbuf, buf+pos, 5);
+        guint reclen = (guint)atoi(lbuf);
+
+        if ((reclen<24) || (len<(pos+reclen))) {
+            PRINTF("WARNING: ISO 8211 record truncated (%s)\n", filename);
+            return FALSE;
+        }
+
+        const guchar *rec = buf + pos;
+        _fld          fld = {NULL, 0};
+        pos += reclen;
+
+        // DDR
+        if ('L' == rec[6])
+            continue;
+
+        // 1st record: DSID - check edition and sequence before editing the cell
+        if (FALSE == dsid) {
+            guint fedtn = 0;
+            guint fupdn = 0;
+            if ((FALSE==_getField(rec, reclen, "DSID", &fld)) || (FALSE==_getDSIDEdition(&fld, &fedtn, &fupdn))) {
+                PRINTF("WARNING: no DSID in update (%s)\n", filename);
+                return FALSE;
+            }
+            if ((fedtn!=edtn) || (fupdn!=updn)) {
+                PRINTF("WARNING: update EDTN/UPDN %u/%u, expected %u/%u (%s)\n", fedtn, fupdn, edtn, updn, filename);
+                return FALSE;
+            }
+            dsid = TRUE;
+            continue;
+        }
+
+        if ((TRUE==_getField(rec, reclen, "FRID", &fld)) && (13<=fld.len)) {
+            _updFeature(iso, rec, reclen, &fld, track);
+            continue;
+        }
+
+        if ((TRUE==_getField(rec, reclen, "VRID", &fld)) && (9<=fld.len)) {
+            _updSpatial(iso, rec, reclen, &fld, track);
+            continue;
+        }
+
+        // else: DSID (EDTN, UPDN, ..) - skip
+    }
+
+    return TRUE;
+}
+
+static int        _isSpatialUpd(_iso8211 *iso, const guchar *name)
+// TRUE if the spatial NAME(5), or the node of an edge, was changed by the tracked update
+{
+    _vrec *v = _getVRec(iso, name[0], _getUInt(name+1, 4));
+    if (NULL == v)
+        return FALSE;
+
+    if (TRUE == v->upd)
+        return TRUE;
+
+    if (RCNM_VE == v->rcnm) {
+        for (guint i=0; (i+1)*9<v->vrpt.len; ++i) {
+            _vrec *n = _getVRec(iso, v->vrpt.data[i*9], _getUInt(v->vrpt.data+i*9+1, 4));
+            if ((NULL!=n) && (TRUE==n->upd))
+                return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+int            S57_iso8211LoadUpdate(const char *filename, guint edtn, S57_iso8211Update_cb update_cb, void *user_data)
+{
+    return_if_null(filename);
+    return_if_null(update_cb);
+
+    guint len = strlen(filename);
+    if ((len<4) || ('.'!=filename[len-4]) ||
+        (FALSE==g_ascii_isdigit(filename[len-3])) ||
+        (FALSE==g_ascii_isdigit(filename[len-2])) ||
+        (FALSE==g_ascii_isdigit(filename[len-1])))
+    {
+        PRINTF("WARNING: not an S-57 update file (%s)\n", filename);
+        return FALSE;
+    }
+
+    guint updn = (guint)atoi(filename+len-3);
+    if (0 == updn) {
+        PRINTF("WARNING: base cell is not an update (%s)\n", filename);
+        return FALSE;
+    }
+
+    if (FALSE == _loadCatalogue())
+        return FALSE;
+
+    gchar *fname = g_strdup(filename);
+    g_snprintf(fname+len-3, 4, "000");
+
+    _iso8211 *iso = _openCell(fname);
+    if (NULL == iso) {
+        g_free(fname);
+        return FALSE;
+    }
+
+    // base cell on disk replaced by a new edition
+    guint bedtn = 0;
+    guint bupdn = 0;
+    if ((FALSE==_getDSIDEdition(&iso->dsid, &bedtn, &bupdn)) || (bedtn!=edtn)) {
+        PRINTF("WARNING: base cell EDTN %u, expected %u (%s)\n", bedtn, edtn, fname);
+        g_free(fname);
+        _closeCell(iso);
+        return FALSE;
+    }
+
+    iso->FE  = g_hash_table_new(g_direct_hash, g_direct_equal);
+    iso->upd = g_ptr_array_new_with_free_func((GDestroyNotify)g_mapped_file_unref);
+    iso->buf = g_ptr_array_new_with_free_func(g_free);
+    for (guint i=0; i<iso->frec->len; ++i)
+        g_hash_table_insert(iso->FE, GUINT_TO_POINTER(g_array_index(iso->frec, _frec, i).rcid), GUINT_TO_POINTER(i+1));
+
+    // Note: previous update are applied (in memory) only to resolve
+    // record index and geometry of the last one
+    int ret = TRUE;
+    for (guint n=1; n<=updn && TRUE==ret; ++n) {
+        g_snprintf(fname+len-3, 4, "%03i", n);
+        ret = _applyUpdate(iso, fname, edtn, n, (n==updn) ? TRUE : FALSE);
+    }
+    g_free(fname);
+
+    if (FALSE == ret) {
+        _closeCell(iso);
+        return FALSE;
+    }
+
+    // feature unchanged but with a changed edge / node
+    for (guint i=0; i<iso->frec->len; ++i) {
+        _frec *f = &g_array_index(iso->frec, _frec, i);
+        if ((0!=f->ruin) || (TRUE==f->del) || (NULL==f->fspt.data))
+            continue;
+
+        for (guint j=0; (j+1)*8<f->fspt.len; ++j) {
+            if (TRUE == _isSpatialUpd(iso, f->fspt.data + j*8)) {
+                f->ruin = RUIN_M;
+                break;
+            }
+        }
+    }
+
+    // remove first - so that the caller can match old object by LNAM
+    guint nDel = 0;
+    guint nNew = 0;
+    for (guint i=0; i<iso->frec->len; ++i) {
+        _frec      *f    = &g_array_index(iso->frec, _frec, i);
+        const char *name = (const char *)g_hash_table_lookup(_objlTbl, GUINT_TO_POINTER(f->objl));
+        char        lnam[17];
+
+        if ((RUIN_D!=f->ruin && RUIN_M!=f->ruin) || (NULL==name) || (FALSE==_getLNAM(f, lnam)))
+            continue;
+
+        update_cb(name, lnam, NULL, user_data);
+        ++nDel;
+    }
+
+    _isolayer   layer   = {iso, _LAYER_FEAT, NULL};
+    _isofeature feature = {&layer, 0, -1};
+    for (guint i=0; i<iso->frec->len; ++i) {
+        _frec      *f    = &g_array_index(iso->frec, _frec, i);
+        const char *name = (const char *)g_hash_table_lookup(_objlTbl, GUINT_TO_POINTER(f->objl));
+        char        lnam[17];
+
+        if ((RUIN_I!=f->ruin && RUIN_M!=f->ruin) || (TRUE==f->del) || (NULL==name))
+            continue;
+
+        _getLNAM(f, lnam);
+
+        // SPLIT_MULTIPOINT=ON: one geo per sounding
+        guint nSnd = _getSndNbr(iso, f);
+        feature.idx = i;
+        for (guint j=0; j<MAX(1, nSnd); ++j) {
+            feature.iPt = (0 == nSnd) ? -1 : (int)j;
+
+            S57_geo *geo = S57_iso8211LoadObject(name, &feature);
+            if (NULL != geo) {
+                update_cb(name, lnam, geo, user_data);
+                ++nNew;
+            }
+        }
+    }
+
+    PRINTF("DEBUG: %s: %i object removed, %i object loaded\n", filename, nDel, nNew);
+
+    _closeCell(iso);
+
+    return TRUE;
+}
+
+int            S57_iso8211Done(void)
+{
+    if (NULL != _objlTbl) {
+        g_hash_table_destroy(_objlTbl);
+        _objlTbl = NULL;
+    }
+    if (NULL != _attlTbl) {
+        g_hash_table_destroy(_attlTbl);
+        _attlTbl = NULL;
+    }
+
+    return TRUE;
+}
@@ -0,0 +1,57 @@
+// S57iso8211.h: interface to load S57 directly from ISO 8211 (bypass OGR)
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _S57ISO8211_H_
+#define _S57ISO8211_H_
+
+#include "S52.h"       // S52_loadObject_cb()
+#include "S57data.h"   // S57_geo
+#include "S57ogr.h"    // S52_loadLayer_cb()
+
+// Note: same contract as S57ogr.h - 'layer' and 'feature' are opaque handle
+// that are only valid inside the callback.
+// Note: return FALSE, before any callback, if the cell can't be streamed
+// (not a .000, update file found, ..) so that the caller can fallback on OGR.
+int      S57_iso8211LoadCell  (const char *filename,                  S52_loadLayer_cb  loadLayer_cb, S52_loadObject_cb loadObject_cb);
+int      S57_iso8211LoadLayer (const char *layername, void *isolayer, S52_loadObject_cb loadObject_cb);
+S57_geo *S57_iso8211LoadObject(const char *objname,   void *feature);
+
+// update - apply .001 .. .00N to the base cell (in memory) then, for each feature
+// changed by .00N, call update_cb() with geo NULL (remove LNAM) then, for each
+// feature inserted / modified, with the new geo (SOUNDG: one geo per sounding)
+// Note: the caller own the geo
+// Note: return FALSE, before any callback, if the DSID EDTN of the base cell or an
+// update is not edtn or the DSID UPDN of .00n is not n
+typedef int (*S57_iso8211Update_cb)(const char *objname, const char *lnam, S57_geo *geo, void *user_data);
+int      S57_iso8211LoadUpdate(const char *filename, guint edtn, S57_iso8211Update_cb update_cb, void *user_data);
+
+// CATALOG.031 - call catd_cb() for each Catalogue Directory (CATD) record
+// Note: extent (deg) is NAN if the subfield is empty (ex: text file)
+typedef int (*S57_iso8211CATD_cb)(const char *file, const char *impl, double S, double W, double N, double E, void *user_data);
+int      S57_iso8211ReadCATALOG(const char *filename, S57_iso8211CATD_cb catd_cb, void *user_data);
+
+// free the object class / attribute catalogue (s57objectclasses.csv, s57attributes.csv)
+int      S57_iso8211Done(void);
+
+#endif // _S57ISO8211_H_
@@ -78,6 +78,28 @@ static int        _setAtt(S57_geo *geo, OGRFeatureH hFeature)
         }
     }
 
+#ifdef S52_USE_SUPP_LINE_OVERLAP
+    {   // integer edge list for _suppLineOverlap() - as IntegerList, not string (OGR TEMP_BUFFER_SIZE)
+        int iRCNM = OGR_F_GetFieldIndex(hFeature, "NAME_RCNM");
+        int iRCID = OGR_F_GetFieldIndex(hFeature, "NAME_RCID");
+        int iMASK = OGR_F_GetFieldIndex(hFeature, "MASK");
+        if ((0<=iRCNM) && (0<=iRCID) && OGR_F_IsFieldSet(hFeature, iRCNM) && OGR_F_IsFieldSet(hFeature, iRCID)) {
+            int        nRCNM = 0;
+            int        nRCID = 0;
+            int        nMASK = 0;
+            const int *rcnm  = OGR_F_GetFieldAsIntegerList(hFeature, iRCNM, &nRCNM);
+            const int *rcid  = OGR_F_GetFieldAsIntegerList(hFeature, iRCID, &nRCID);
+            const int *mask  = (0 <= iMASK) ? OGR_F_GetFieldAsIntegerList(hFeature, iMASK, &nMASK) : NULL;
+
+            for (int i=0; i<nRCNM && i<nRCID; ++i) {
+                if (130 == rcnm[i])
+                    S57_addEdgeRef(geo, (guint)rcid[i], ((i<nMASK) && (1==mask[i])));
+            }
+        }
+    }
+#endif
+
+
     // optimisation: direct link to the value of Att (GString)
     // save the search in attList
     GString  *scamin = S57_getAttVal(geo, "SCAMIN");
@@ -211,7 +233,7 @@ static S57_geo   *_ogrLoadObject(const char *objname, void *feature, OGRGeometry
         // POINT
         case wkbPoint25D:
         case wkbPoint: {
-            geocoord *pointxyz = g_new(geocoord, 3);
+            geocoord *pointxyz = (geocoord*)S57_newGeoData(NULL, sizeof(geocoord)*3);
 
             pointxyz[0] = OGR_G_GetX(hGeom, 0);
             pointxyz[1] = OGR_G_GetY(hGeom, 0);
@@ -239,7 +261,7 @@ static S57_geo   *_ogrLoadObject(const char *objname, void *feature, OGRGeometry
 
             geocoord *linexyz = NULL;
             if (0 != count)
-                linexyz = g_new(geocoord, 3*count);
+                linexyz = (geocoord*)S57_newGeoData(NULL, sizeof(geocoord)*3*count);
 
             for (int node=0; node<count; ++node) {
                 linexyz[node*3+0] = OGR_G_GetX(hGeom, node);
@@ -263,8 +285,8 @@ static S57_geo   *_ogrLoadObject(const char *objname, void *feature, OGRGeometry
             geocoord   **ringxyz;
             double       area = 0;
 
-            ringxyznbr = g_new(guint,      nRingCount);
-            ringxyz    = g_new(geocoord *, nRingCount);
+            ringxyznbr = (guint    *)S57_newGeoData(NULL, sizeof(guint)      * nRingCount);
+            ringxyz    = (geocoord**)S57_newGeoData(NULL, sizeof(geocoord *) * nRingCount);
 
             // Note: to check winding on an open poly area
             //for (i = n-1, j = 0; j < n; i = j, j++) {
@@ -288,7 +310,7 @@ static S57_geo   *_ogrLoadObject(const char *objname, void *feature, OGRGeometry
                     continue;
                 }
 
-                ringxyz[iRing] = g_new(geocoord, vert_count*3*sizeof(geocoord));
+                ringxyz[iRing] = (geocoord*)S57_newGeoData(NULL, sizeof(geocoord)*3*vert_count);
 
                 // check if last vertex is NOT the first vertex (ie ring not close)
                 if ((OGR_G_GetX(hRing, 0) != OGR_G_GetX(hRing, vert_count-1)) ||
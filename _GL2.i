@@ -58,33 +58,13 @@ static int _GL_KHR_no_error     = FALSE;
 
 // used to convert float to double for tesselator
 static GArray *_tessWorkBuf_d = NULL;
-// used to convert geo double to VBO float
-static GArray *_tessWorkBuf_f = NULL;
-
-// glsl main
-static GLuint _programObject = 0;
-
-// glsl uniform
-static GLint _uProjection = 0;
-static GLint _uModelview  = 0;
-static GLint _uColor      = 0;
-static GLint _uPointSize  = 0;
-static GLint _uSampler2d0 = 0;
-static GLint _uSampler2d1 = 0;
-static GLint _uBlitOn     = 0;
-static GLint _uTextOn     = 0;  // textured line and text from freetype-gl
-static GLint _uGlowOn     = 0;
-
-static GLint _uPattOn     = 0;
-static GLint _uPattGridX  = 0;
-static GLint _uPattGridY  = 0;
-static GLint _uPattW      = 0;
-static GLint _uPattH      = 0;
-
-// glsl varying
-static GLint _aPosition   = 0;
-static GLint _aUV         = 0;
-static GLint _aAlpha      = 0;
+
+#ifdef S52_USE_STENCIL_FILL
+// area with that many vertex are filled by _fillAreaStencil() - no tessellation
+#define STENCIL_FILL_NPT 20000
+static int    _stencilFillNpt = STENCIL_FILL_NPT;  // s52.cfg STENCIL_FILL_NPT, 0 - off
+static GLint  _stencilBits    = 0;                 // 0 - no stencil buffer in the config
+#endif
 
 // alpha is 0.0 - 1.0
 #define TRNSP_FAC_GLES2   0.25
@@ -176,14 +156,9 @@ static const GLubyte _dashpa_mask_bits[4] = {     // 4 x 8 bits = 32 bits
 //};
 
 
-// other pattern are created using FBO
-static GLuint         _fboID = 0;
-
-
 //---- PATTERN GL2 / GLES2 -----------------------------------------------------------
 //
 //static int _debugMatrix = 1;
-#define   MATRIX_STACK_MAX 8
 
 // symbole not in GLES2 - but defined here to mimic GL2
 #define   GL_MODELVIEW    0x1700
@@ -200,11 +175,6 @@ static GLuint         _fboID = 0;
 
 //static    GLenum   _mode = GL_MODELVIEW;  // GL_MODELVIEW (initial) or GL_PROJECTION
 //static    GLenum   _mode = GL_PROJECTION;  // GL_MODELVIEW (initial) or GL_PROJECTION
-static    GLfloat  _mvm[MATRIX_STACK_MAX][16];       // modelview matrix
-static    GLfloat  _pjm[MATRIX_STACK_MAX][16];       // projection matrix
-static    GLfloat *_crntMat;          // point to active matrix
-static    int      _mvmTop = 0;       // point to stack top
-static    int      _pjmTop = 0;       // point to stack top
 //static    int      _mvmTop = -1;       // point to stack top
 //static    int      _pjmTop = -1;       // point to stack top
 
@@ -233,7 +203,26 @@ typedef struct {
 
 // legend has no S52_obj, so this a place holder
 static GLuint  _freetype_gl_textureID = 0;
-static GArray *_freetype_gl_buffer    = NULL;
+
+#ifdef S52_USE_SW
+// GL2 call shadowed and rasterised in SW from here on
+#include "_GLSW.i"
+#endif
+
+#ifdef S52_USE_SYM_ATLAS
+static void      _glAtlasOff(void)
+// the symbol atlas stay bound across a run of SY / LC / AP (_glCallList()),
+// unbind it before a client array or an other VBO
+{
+    if (TRUE == _atlasOn) {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        _atlasOn = FALSE;
+    }
+}
+#define ATLAS_OFF()  _glAtlasOff()
+#else
+#define ATLAS_OFF()
+#endif
 
 #define LF  '\r'   // Line Feed
 #define TB  '\t'   // Tabulation
@@ -355,10 +344,6 @@ static int       _init_freetype_gl(void)
 
     _checkError("_init_freetype_gl() -end-");
 
-    if (NULL == _freetype_gl_buffer) {
-        _freetype_gl_buffer = g_array_new(FALSE, FALSE, sizeof(_freetype_gl_vertex_t));
-    }
-
     return TRUE;
 }
 
@@ -784,6 +769,8 @@ static int       _renderTXTAA_gl2(double x, double y, GLfloat *data, guint len)
         glEnableVertexAttribArray(_aUV);
         glVertexAttribPointer    (_aUV,       2, GL_FLOAT, GL_FALSE, sizeof(_freetype_gl_vertex_t), BUFFER_OFFSET(sizeof(float)*3));
     } else {
+        ATLAS_OFF();
+
         // connect ftgl buffer coord data to GPU
         glEnableVertexAttribArray(_aPosition);
         glVertexAttribPointer    (_aPosition, 3, GL_FLOAT, GL_FALSE, sizeof(_freetype_gl_vertex_t), data+0);
@@ -896,6 +883,261 @@ static int       _loadProcEXT()
 }
 #endif  // S52_USE_EGL
 
+#ifdef S52_USE_GPU_TIMER
+//---- GPU TIMER -----------------------------------------------------------------------
+//
+// A GL_TIMESTAMP query (GL_EXT_disjoint_timer_query / GL_ARB_timer_query) is issued at each
+// change of stage, display priority or command word in a DRAW cycle (and at begin / end of
+// the LAST cycle). The interval between two marks is charged to the state of the first.
+// Results are read TQ_LAG cycles later, when available, so the GPU is never stalled.
+// No timer query: CPU timestamp - cost of GL call submission, not of the GPU.
+
+#define TQ_LAG  3       // cycle in flight
+#define TQ_MAX  2048    // mark per cycle - over that the rest of the cycle go to the last state
+
+enum { TQ_NONE, TQ_OBJ, TQ_TEXT, TQ_RASTER };   // stage
+
+typedef struct _tqSlot {
+    S52_GL_cycle cycle;           // DRAW or LAST
+    guint        frame;           // DRAW cycle number
+    int          pending;         // wait on GPU result
+    guint        n;               // mark
+    guint        overflow;        // mark dropped
+    GLuint       qid  [TQ_MAX];   // query - GPU
+    GLuint64     t    [TQ_MAX];   // nsec
+    guint8       stage[TQ_MAX];
+    guint8       prio [TQ_MAX];
+    guint8       cmd  [TQ_MAX];
+} _tqSlot;
+
+typedef struct _tqState {
+    _tqSlot        slot[TQ_LAG];
+    int            gen;            // TRUE query id generated (in this GL context)
+    guint          crnt;           // slot of the current cycle
+    guint          frame;          // DRAW cycle count
+    guint          dropped;        // cycle result lost (not ready after TQ_LAG, GPU disjoint)
+    S52_GL_gpuTime res;            // last result
+} _tqState;
+
+
+static int _GL_EXT_timer_query = FALSE;   // EXT_disjoint_timer_query or ARB_timer_query
+static PFNGLGENQUERIESEXTPROC          _glGenQueries          = NULL;
+static PFNGLDELETEQUERIESEXTPROC       _glDeleteQueries       = NULL;
+static PFNGLQUERYCOUNTEREXTPROC        _glQueryCounter        = NULL;
+static PFNGLGETQUERYOBJECTIVEXTPROC    _glGetQueryObjectiv    = NULL;
+static PFNGLGETQUERYOBJECTUI64VEXTPROC _glGetQueryObjectui64v = NULL;
+
+static int       _tqInit(void)
+// load timer query entry points - EXT (GLES) first then core (GL)
+{
+    if (FALSE == _GL_EXT_timer_query)
+        return FALSE;
+
+#ifdef S52_USE_EGL
+    typedef void (*proc)(void);
+    extern proc eglGetProcAddress(const char *procname);
+
+    _glGenQueries          = (PFNGLGENQUERIESEXTPROC)         eglGetProcAddress("glGenQueriesEXT");
+    _glDeleteQueries       = (PFNGLDELETEQUERIESEXTPROC)      eglGetProcAddress("glDeleteQueriesEXT");
+    _glQueryCounter        = (PFNGLQUERYCOUNTEREXTPROC)       eglGetProcAddress("glQueryCounterEXT");
+    _glGetQueryObjectiv    = (PFNGLGETQUERYOBJECTIVEXTPROC)   eglGetProcAddress("glGetQueryObjectivEXT");
+    _glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VEXTPROC)eglGetProcAddress("glGetQueryObjectui64vEXT");
+    if (NULL == _glQueryCounter) {
+        _glGenQueries          = (PFNGLGENQUERIESEXTPROC)         eglGetProcAddress("glGenQueries");
+        _glDeleteQueries       = (PFNGLDELETEQUERIESEXTPROC)      eglGetProcAddress("glDeleteQueries");
+        _glQueryCounter        = (PFNGLQUERYCOUNTEREXTPROC)       eglGetProcAddress("glQueryCounter");
+        _glGetQueryObjectiv    = (PFNGLGETQUERYOBJECTIVEXTPROC)   eglGetProcAddress("glGetQueryObjectiv");
+        _glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VEXTPROC)eglGetProcAddress("glGetQueryObjectui64v");
+    }
+#endif
+
+    if (NULL==_glGenQueries || NULL==_glDeleteQueries || NULL==_glQueryCounter ||
+        NULL==_glGetQueryObjectiv || NULL==_glGetQueryObjectui64v) {
+        PRINTF("DEBUG: timer query FAILED - fallback to CPU timestamp\n");
+        _GL_EXT_timer_query = FALSE;
+        return FALSE;
+    }
+
+    PRINTF("DEBUG: timer query OK\n");
+
+    return TRUE;
+}
+
+static void      _tqMark(int stage, int prio, int cmd)
+// record a change of state in the current DRAW cycle
+{
+    if (NULL==_tq || S52_GL_DRAW!=_crnt_GL_cycle)
+        return;
+
+    _tqSlot *s = &_tq->slot[_tq->crnt];
+    guint    i = s->n - 1;
+
+    // same state
+    if (s->stage[i]==stage && s->prio[i]==prio && s->cmd[i]==cmd)
+        return;
+
+    // keep the last one for _tqEnd()
+    if (TQ_MAX-1 <= s->n) {
+        ++s->overflow;
+        return;
+    }
+
+    i = s->n++;
+    s->stage[i] = stage;
+    s->prio [i] = prio;
+    s->cmd  [i] = cmd;
+    if (TRUE == _GL_EXT_timer_query)
+        _glQueryCounter(s->qid[i], GL_TIMESTAMP_EXT);
+    else
+        s->t[i] = (GLuint64)g_get_monotonic_time() * 1000;
+}
+
+static int       _tqRead(_tqSlot *s)
+// collect the slot result if ready - return TRUE when done with the slot
+{
+    if (TRUE == _GL_EXT_timer_query) {
+        GLint avail = 0;
+        _glGetQueryObjectiv(s->qid[s->n-1], GL_QUERY_RESULT_AVAILABLE_EXT, &avail);
+        if (0 == avail)
+            return FALSE;
+
+        // GPU clock not reliable (power state, ..) - drop all in flight
+        GLint disjoint = 0;
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+        if (0 != disjoint) {
+            for (int j=0; j<TQ_LAG; ++j) {
+                if (TRUE == _tq->slot[j].pending) {
+                    _tq->slot[j].pending = FALSE;
+                    ++_tq->dropped;
+                }
+            }
+            return TRUE;
+        }
+
+        for (guint i=0; i<s->n; ++i)
+            _glGetQueryObjectui64v(s->qid[i], GL_QUERY_RESULT_EXT, &s->t[i]);
+    }
+
+    S52_GL_gpuTime *r = &_tq->res;
+
+    r->isGPU    = _GL_EXT_timer_query;
+    r->dropped  = _tq->dropped;
+
+    if (S52_GL_LAST == s->cycle) {
+        r->last = (s->t[s->n-1] - s->t[0]) / 1000000.0;
+        return TRUE;
+    }
+
+    r->frame    = s->frame;
+    r->draw     = (s->t[s->n-1] - s->t[0]) / 1000000.0;
+    r->text     = 0.0;
+    r->raster   = 0.0;
+    r->overflow = s->overflow;
+    memset(r->prio, 0, sizeof(r->prio));
+    memset(r->cmd,  0, sizeof(r->cmd));
+
+    for (guint i=0; i+1<s->n; ++i) {
+        double ms = (s->t[i+1] - s->t[i]) / 1000000.0;
+        switch (s->stage[i]) {
+            case TQ_OBJ:
+                if (s->prio[i] < S52_PRIO_NUM)
+                    r->prio[s->prio[i]] += ms;
+                r->cmd[s->cmd[i]] += ms;
+                break;
+            case TQ_TEXT:   r->text   += ms; break;
+            case TQ_RASTER: r->raster += ms; break;
+            default: break;   // setup, FB, ..
+        }
+    }
+
+    return TRUE;
+}
+
+static void      _tqBeg(S52_GL_cycle cycle)
+// first mark of a DRAW / LAST cycle
+{
+    if (S52_GL_DRAW!=cycle && S52_GL_LAST!=cycle)
+        return;
+
+    if (NULL == _tq)
+        _tq = g_new0(_tqState, 1);
+
+    if ((TRUE==_GL_EXT_timer_query) && (FALSE==_tq->gen)) {
+        for (int i=0; i<TQ_LAG; ++i)
+            _glGenQueries(TQ_MAX, _tq->slot[i].qid);
+        _tq->gen = TRUE;
+    }
+
+    // collect - oldest first
+    for (guint i=1; i<=TQ_LAG; ++i) {
+        _tqSlot *s = &_tq->slot[(_tq->crnt + i) % TQ_LAG];
+        if ((TRUE==s->pending) && (TRUE==_tqRead(s)))
+            s->pending = FALSE;
+    }
+
+    _tq->crnt = (_tq->crnt + 1) % TQ_LAG;
+    _tqSlot *s = &_tq->slot[_tq->crnt];
+    if (TRUE == s->pending) {
+        // GPU TQ_LAG cycle behind
+        ++_tq->dropped;
+        s->pending = FALSE;
+    }
+
+    if (S52_GL_DRAW == cycle)
+        ++_tq->frame;
+
+    s->cycle    = cycle;
+    s->frame    = _tq->frame;
+    s->n        = 1;
+    s->overflow = 0;
+    s->stage[0] = TQ_NONE;
+    s->prio [0] = 0;
+    s->cmd  [0] = 0;
+    if (TRUE == _GL_EXT_timer_query)
+        _glQueryCounter(s->qid[0], GL_TIMESTAMP_EXT);
+    else
+        s->t[0] = (GLuint64)g_get_monotonic_time() * 1000;
+}
+
+static void      _tqEnd(S52_GL_cycle cycle)
+// last mark of a DRAW / LAST cycle
+{
+    if (NULL==_tq || (S52_GL_DRAW!=cycle && S52_GL_LAST!=cycle))
+        return;
+
+    _tqSlot *s = &_tq->slot[_tq->crnt];
+    guint    i = s->n++;
+
+    s->stage[i] = TQ_NONE;
+    if (TRUE == _GL_EXT_timer_query) {
+        _glQueryCounter(s->qid[i], GL_TIMESTAMP_EXT);
+        s->pending = TRUE;
+    } else {
+        s->t[i] = (GLuint64)g_get_monotonic_time() * 1000;
+        _tqRead(s);
+    }
+}
+
+static void      _tqDone(void)
+// Note: GL context of _tq must be current
+{
+    if (NULL == _tq)
+        return;
+
+    if (TRUE == _tq->gen) {
+        for (int i=0; i<TQ_LAG; ++i)
+            _glDeleteQueries(TQ_MAX, _tq->slot[i].qid);
+    }
+
+    g_free(_tq);
+    _tq = NULL;
+}
+
+#define TQ_MARK(stage, prio, cmd) _tqMark(stage, prio, cmd)
+#define TQ_BEG(cycle)             _tqBeg(cycle)
+#define TQ_END(cycle)             _tqEnd(cycle)
+#endif  // S52_USE_GPU_TIMER
+
 static int       _1024bitMask2RGBATex(const GLubyte *mask, GLubyte *rgba_mask)
 // make a RGBA texture from 32x32 bitmask
 {
@@ -1458,7 +1700,8 @@ static GLuint    _bindUnifrom(GLuint programObject)
     return programObject;
 }
 
-static int       _init_gl2(void)
+static int       _initProg_gl2(void)
+// program of the current context - uniform are program state, so one program per context
 {
     //if (TRUE == glIsProgram(_programObject)) {
     if (0 != _programObject) {
@@ -1466,21 +1709,6 @@ static int       _init_gl2(void)
         return TRUE;
     }
 
-    PRINTF("NOTE: begin GL2/GLSL init ..\n");
-
-    if (NULL == _tessWorkBuf_d)
-        _tessWorkBuf_d = g_array_new(FALSE, FALSE, sizeof(double)*3);
-    if (NULL == _tessWorkBuf_f)
-        _tessWorkBuf_f = g_array_new(FALSE, FALSE, sizeof(float)*3);
-
-    _init_freetype_gl();
-
-#ifdef S52_USE_EGL
-    _loadProcEXT();
-#endif
-
-    _initTexture();
-
     _programObject = _loadShaderBin();
     if (0 == _programObject) {
 #ifdef S52_USE_GLSC2
@@ -1530,8 +1758,33 @@ static int       _init_gl2(void)
     return TRUE;
 }
 
+static int       _init_gl2(void)
+// shared by all the context
+{
+    PRINTF("NOTE: begin GL2/GLSL init ..\n");
+
+    if (NULL == _tessWorkBuf_d)
+        _tessWorkBuf_d = g_array_new(FALSE, FALSE, sizeof(double)*3);
+
+    _init_freetype_gl();
+
+#ifdef S52_USE_EGL
+    _loadProcEXT();
+#endif
+
+#ifdef S52_USE_GPU_TIMER
+    _tqInit();
+#endif
+
+    _initTexture();
+
+    return TRUE;
+}
+
 static int       _renderTile(S52_DListData *DListData)
 {
+    ATLAS_OFF();
+
     glUniformMatrix4fv(_uModelview,  1, GL_FALSE, _mvm[_mvmTop]);
 
     glEnableVertexAttribArray(_aPosition);
@@ -1760,9 +2013,6 @@ static int       _renderTexure(S52_obj *obj, double tileWpx, double tileHpx, dou
 
     _initFBO(mask_texID);
 
-    // save texture mask ID when everythings check ok
-    S52_PL_setAPtexID(obj, mask_texID);
-
     // Clear Color ------------------------------------------------
     glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
     glClearColor(0.0, 0.0, 0.0, 0.0);
@@ -1907,6 +2157,11 @@ static int       _renderTexure(S52_obj *obj, double tileWpx, double tileHpx, dou
 
     _checkError("_renderTexure() -2-");
 
+    // save texture mask ID when everythings check ok
+    // Note: last - the texture is complete for the other context
+    GLBUILDFLUSH;
+    S52_PL_setAPtexID(obj, mask_texID);
+
     return mask_texID;
 }
 
@@ -1938,14 +2193,20 @@ static int       _renderAP_gl2(S52_obj *obj)
 
     GLuint mask_texID = S52_PL_getAPtexID(obj);
     if (0 == mask_texID) {
-        if (TRUE == glIsEnabled(GL_SCISSOR_TEST)) {
-            // scissor box interfere with texture creation
-            glDisable(GL_SCISSOR_TEST);
-            mask_texID = _renderTexure(obj, tileWpx, tileHpx, stagOffsetPix);
-            glEnable(GL_SCISSOR_TEST);
-        } else {
-            mask_texID = _renderTexure(obj, tileWpx, tileHpx, stagOffsetPix);
+        GLBUILDLOCK;
+        // other context might have render it
+        mask_texID = S52_PL_getAPtexID(obj);
+        if (0 == mask_texID) {
+            if (TRUE == glIsEnabled(GL_SCISSOR_TEST)) {
+                // scissor box interfere with texture creation
+                glDisable(GL_SCISSOR_TEST);
+                mask_texID = _renderTexure(obj, tileWpx, tileHpx, stagOffsetPix);
+                glEnable(GL_SCISSOR_TEST);
+            } else {
+                mask_texID = _renderTexure(obj, tileWpx, tileHpx, stagOffsetPix);
+            }
         }
+        GLBUILDUNLOCK;
     }
 
     S52_DListData *DListData = S52_PL_getDListData(obj);
@@ -2033,6 +2294,7 @@ static int       _renderLS_gl2(char style, guint npt, double *ppt)
             tex_n, 1.0
         };
 
+        ATLAS_OFF();
         glEnableVertexAttribArray(_aUV);
         glVertexAttribPointer    (_aUV, 2, GL_FLOAT, GL_FALSE, 0, ptr);
 
@@ -0,0 +1,603 @@
+// _GLSW.i: software rasteriser (S52SW.c) behind the GL2 code path.
+//          Included by _GL2.i when S52_USE_SW is defined.
+//
+// SD 2017MAR10
+//
+// Note: the GL2 call of S52GL.c/_GL2.i that matter to rendering are shadowed here
+//       (uniform, attrib, buffer, texture, cull, clear). In a DRAW/LAST cycle
+//       glDrawArrays() is then rasterised by S52SW.c instead of GL. S52_GL_end()
+//       upload the result to the GL FB, so readback (S52_GL_readFBPixels(),
+//       BLIT cycle, dump) and EGL swap are unchanged.
+// Note: GL is still used for init, PICK, pattern creation (FBO) and the final upload
+//       - a context on llvmpipe / Mesa surfaceless is enough.
+// Note: afterglow (uGlowOn) take aAlpha per vertex - round point, as the shader.
+
+#include "S52SW.h"
+
+typedef struct _swAttrib_t {
+    GLuint         buf;     // VBO ID, 0 client side array
+    const GLvoid  *ptr;     // offset in VBO or pointer
+    GLsizei        stride;  // byte
+} _swAttrib_t;
+
+typedef struct _swTex_t {
+    guchar *data;           // NULL until read back from GL
+    int     w;
+    int     h;
+    int     bpp;
+} _swTex_t;
+
+static void         _multiply(GLfloat *m, GLfloat *n);  // _GL2.i
+
+static int          _swOn       = FALSE;   // DRAW/LAST cycle rasterised in SW
+static GLuint       _swFBO      = 0;       // FBO bound - draw go to GL (pattern creation)
+static GLfloat      _swPrj[16];            // uProjection
+static GLfloat      _swMvm[16];            // uModelview
+static guchar       _swColor[4] = {0, 0, 0, 255};
+static guchar       _swClear[4] = {0, 0, 0, 255};
+static float        _swTextOn   = 0.0;
+static float        _swPattOn   = 0.0;
+static float        _swGlowOn   = 0.0;
+static float        _swBlitOn   = 0.0;
+static float        _swPatt[4]  = {0.0, 0.0, 0.0, 0.0};  // uPattGridX, uPattGridY, uPattW, uPattH
+static float        _swLineW    = 1.0;
+static float        _swPointSz  = 1.0;
+static int          _swCullOn   = FALSE;
+static GLenum       _swFront    = GL_CCW;
+static GLint        _swVP[4]    = {0, 0, 0, 0};
+static GLuint       _swBuf      = 0;       // GL_ARRAY_BUFFER bound
+static GLuint       _swTexID    = 0;       // GL_TEXTURE_2D bound
+static _swAttrib_t  _swPos      = {0, NULL, 0};
+static _swAttrib_t  _swUV       = {0, NULL, 0};
+static _swAttrib_t  _swAlpha    = {0, NULL, 0};
+static GHashTable  *_swBufData  = NULL;    // VBO ID --> GByteArray, CPU copy of glBufferData()
+static GHashTable  *_swTexData  = NULL;    // tex ID --> _swTex_t
+static GArray      *_swXY       = NULL;    // x,y,u,v (x,y,alpha) in window - S52_SW_draw() input
+static guchar      *_swFB       = NULL;    // DRAW cycle result - LAST start from it
+static gsize        _swFBsz     = 0;
+static GLuint       _swFBtexID  = 0;       // upload SW FB to GL FB
+
+static void      _swFreeTex(gpointer data)
+{
+    _swTex_t *t = (_swTex_t *)data;
+    g_free(t->data);
+    g_free(t);
+}
+
+static void      _swFreeBuf(gpointer data)
+{
+    g_byte_array_free((GByteArray *)data, TRUE);
+}
+
+static void      _swInitShadow(void)
+{
+    if (NULL != _swBufData)
+        return;
+
+    _swBufData = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, _swFreeBuf);
+    _swTexData = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, _swFreeTex);
+    _swXY      = g_array_new(FALSE, FALSE, sizeof(float)*4);
+}
+
+//-----------------------------------------
+// shadow - real GL call then keep state
+// Note: (glXxx)() is not expanded by the macro below
+//
+
+static void      _swUniformMatrix4fv(GLint loc, GLsizei n, GLboolean t, const GLfloat *m)
+{
+    (glUniformMatrix4fv)(loc, n, t, m);
+
+    if (loc == _uProjection) memcpy(_swPrj, m, sizeof(_swPrj));
+    if (loc == _uModelview ) memcpy(_swMvm, m, sizeof(_swMvm));
+}
+
+static void      _swUniform1f(GLint loc, GLfloat v)
+{
+    (glUniform1f)(loc, v);
+
+    if      (loc == _uTextOn   ) _swTextOn  = v;
+    else if (loc == _uPattOn   ) _swPattOn  = v;
+    else if (loc == _uGlowOn   ) _swGlowOn  = v;
+    else if (loc == _uBlitOn   ) _swBlitOn  = v;
+    else if (loc == _uPattGridX) _swPatt[0] = v;
+    else if (loc == _uPattGridY) _swPatt[1] = v;
+    else if (loc == _uPattW    ) _swPatt[2] = v;
+    else if (loc == _uPattH    ) _swPatt[3] = v;
+    else if (loc == _uPointSize) _swPointSz = v;
+}
+
+static void      _swUniform4f(GLint loc, GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+{
+    (glUniform4f)(loc, r, g, b, a);
+
+    if (loc == _uColor) {
+        _swColor[0] = (guchar)CLAMP(r*255.0 + 0.5, 0.0, 255.0);
+        _swColor[1] = (guchar)CLAMP(g*255.0 + 0.5, 0.0, 255.0);
+        _swColor[2] = (guchar)CLAMP(b*255.0 + 0.5, 0.0, 255.0);
+        _swColor[3] = (guchar)CLAMP(a*255.0 + 0.5, 0.0, 255.0);
+    }
+}
+
+static void      _swVertexAttribPointer(GLuint idx, GLint sz, GLenum type, GLboolean norm, GLsizei stride, const GLvoid *ptr)
+{
+    (glVertexAttribPointer)(idx, sz, type, norm, stride, ptr);
+
+    _swAttrib_t *a = NULL;
+    if ((GLint)idx == _aPosition) a = &_swPos;
+    if ((GLint)idx == _aUV      ) a = &_swUV;
+    if ((GLint)idx == _aAlpha   ) a = &_swAlpha;
+    if (NULL == a)
+        return;
+
+    a->buf    = _swBuf;
+    a->ptr    = ptr;
+    a->stride = (0 == stride) ? sz * (GLsizei)sizeof(GLfloat) : stride;
+}
+
+static void      _swBindBuffer(GLenum target, GLuint id)
+{
+    (glBindBuffer)(target, id);
+
+    if (GL_ARRAY_BUFFER == target)
+        _swBuf = id;
+}
+
+static void      _swBufferData(GLenum target, GLsizeiptr sz, const GLvoid *data, GLenum usage)
+{
+    (glBufferData)(target, sz, data, usage);
+
+    if ((GL_ARRAY_BUFFER!=target) || (0==_swBuf))
+        return;
+
+    _swInitShadow();
+
+    GByteArray *buf = g_byte_array_sized_new((guint)sz);
+    if (NULL != data)
+        g_byte_array_append(buf, (const guint8 *)data, (guint)sz);
+    else
+        g_byte_array_set_size(buf, (guint)sz);
+
+    g_hash_table_replace(_swBufData, GUINT_TO_POINTER(_swBuf), buf);
+}
+
+static void      _swDeleteBuffers(GLsizei n, const GLuint *ids)
+{
+    (glDeleteBuffers)(n, ids);
+
+    if (NULL == _swBufData)
+        return;
+
+    for (GLsizei i=0; i<n; ++i)
+        g_hash_table_remove(_swBufData, GUINT_TO_POINTER(ids[i]));
+}
+
+static void      _swBindTexture(GLenum target, GLuint id)
+{
+    (glBindTexture)(target, id);
+
+    if (GL_TEXTURE_2D == target)
+        _swTexID = id;
+}
+
+static void      _swTexImage2D(GLenum target, GLint level, GLint ifmt, GLsizei w, GLsizei h,
+                               GLint border, GLenum fmt, GLenum type, const GLvoid *data)
+{
+    (glTexImage2D)(target, level, ifmt, w, h, border, fmt, type, data);
+
+    if ((GL_TEXTURE_2D!=target) || (0!=level) || (0==_swTexID))
+        return;
+
+    _swInitShadow();
+
+    _swTex_t *t = g_new0(_swTex_t, 1);
+    t->w   = w;
+    t->h   = h;
+    t->bpp = (GL_ALPHA == fmt) ? 1 : 4;
+    // no data (FBO target) or not alpha/RGBA byte - read back on first use
+    if ((NULL!=data) && (GL_UNSIGNED_BYTE==type) && ((GL_ALPHA==fmt) || (GL_RGBA==fmt)))
+        t->data = (guchar *)g_memdup(data, (guint)(w * h * t->bpp));
+
+    g_hash_table_replace(_swTexData, GUINT_TO_POINTER(_swTexID), t);
+}
+
+static void      _swTexSubImage2D(GLenum target, GLint level, GLint x, GLint y, GLsizei w, GLsizei h,
+                                  GLenum fmt, GLenum type, const GLvoid *data)
+{
+    (glTexSubImage2D)(target, level, x, y, w, h, fmt, type, data);
+
+    if ((GL_TEXTURE_2D!=target) || (0!=level) || (NULL==_swTexData))
+        return;
+
+    _swTex_t *t = (_swTex_t *)g_hash_table_lookup(_swTexData, GUINT_TO_POINTER(_swTexID));
+    if ((NULL==t) || (NULL==t->data) || (x+w>t->w) || (y+h>t->h))
+        return;
+
+    int bpp = (GL_ALPHA == fmt) ? 1 : 4;
+    if ((NULL==data) || (GL_UNSIGNED_BYTE!=type) || (bpp!=t->bpp)) {
+        // can't follow - read back on next use
+        g_free(t->data);
+        t->data = NULL;
+        return;
+    }
+
+    for (int j=0; j<h; ++j)
+        memcpy(t->data + ((y+j)*t->w + x)*bpp, (const guchar *)data + j*w*bpp, w*bpp);
+}
+
+static void      _swDeleteTextures(GLsizei n, const GLuint *ids)
+{
+    (glDeleteTextures)(n, ids);
+
+    if (NULL == _swTexData)
+        return;
+
+    for (GLsizei i=0; i<n; ++i)
+        g_hash_table_remove(_swTexData, GUINT_TO_POINTER(ids[i]));
+}
+
+static void      _swBindFramebuffer(GLenum target, GLuint id)
+{
+    (glBindFramebuffer)(target, id);
+
+    _swFBO = id;
+}
+
+static void      _swViewport(GLint x, GLint y, GLsizei w, GLsizei h)
+{
+    (glViewport)(x, y, w, h);
+
+    _swVP[0] = x;
+    _swVP[1] = y;
+    _swVP[2] = w;
+    _swVP[3] = h;
+}
+
+static void      _swEnable(GLenum cap)
+{
+    (glEnable)(cap);
+
+    if (GL_CULL_FACE == cap)
+        _swCullOn = TRUE;
+}
+
+static void      _swDisable(GLenum cap)
+{
+    (glDisable)(cap);
+
+    if (GL_CULL_FACE == cap)
+        _swCullOn = FALSE;
+}
+
+static void      _swFrontFace(GLenum mode)
+{
+    (glFrontFace)(mode);
+
+    _swFront = mode;
+}
+
+static void      _swLineWidth(GLfloat w)
+{
+    (glLineWidth)(w);
+
+    _swLineW = w;
+}
+
+static void      _swClearColor(GLclampf r, GLclampf g, GLclampf b, GLclampf a)
+{
+    (glClearColor)(r, g, b, a);
+
+    _swClear[0] = (guchar)CLAMP(r*255.0 + 0.5, 0.0, 255.0);
+    _swClear[1] = (guchar)CLAMP(g*255.0 + 0.5, 0.0, 255.0);
+    _swClear[2] = (guchar)CLAMP(b*255.0 + 0.5, 0.0, 255.0);
+    _swClear[3] = (guchar)CLAMP(a*255.0 + 0.5, 0.0, 255.0);
+}
+
+static void      _swClearGL(GLbitfield mask)
+{
+    if ((TRUE==_swOn) && (0==_swFBO)) {
+        if (GL_COLOR_BUFFER_BIT & mask)
+            S52_SW_clear(_swClear[0], _swClear[1], _swClear[2], _swClear[3]);
+        return;
+    }
+
+    (glClear)(mask);
+}
+
+static const S52_SW_tex *_swGetTex(S52_SW_tex *tex)
+// texture bound as a S52_SW_tex, read back from GL the first time if need be
+{
+    if (0 == _swTexID)
+        return NULL;
+
+    // glyph atlas - uploaded by freetype-gl, alpha only
+    if ((NULL!=_freetype_gl_atlas) && (_swTexID==_freetype_gl_atlas->id)) {
+        if (1 != _freetype_gl_atlas->depth)
+            return NULL;   // FIXME: GLSC2 RGB atlas
+        tex->data   = _freetype_gl_atlas->data;
+        tex->w      = (int)_freetype_gl_atlas->width;
+        tex->h      = (int)_freetype_gl_atlas->height;
+        tex->stride = (int)_freetype_gl_atlas->width;
+        tex->bpp    = 1;
+        return tex;
+    }
+
+    _swTex_t *t = (_swTex_t *)g_hash_table_lookup(_swTexData, GUINT_TO_POINTER(_swTexID));
+    if (NULL == t)
+        return NULL;
+
+    if (NULL == t->data) {
+        // pattern rendered in a FBO - read it back once
+        if (0 == _fboID)
+            (glGenFramebuffers)(1, &_fboID);
+
+        t->bpp  = 4;
+        t->data = g_new0(guchar, t->w * t->h * 4);
+
+        (glBindFramebuffer)     (GL_FRAMEBUFFER, _fboID);
+        (glFramebufferTexture2D)(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _swTexID, 0);
+        glReadPixels(0, 0, t->w, t->h, GL_RGBA, GL_UNSIGNED_BYTE, t->data);
+        (glBindFramebuffer)     (GL_FRAMEBUFFER, 0);
+    }
+
+    tex->data   = t->data;
+    tex->w      = t->w;
+    tex->h      = t->h;
+    tex->stride = t->w * t->bpp;
+    tex->bpp    = t->bpp;
+
+    return tex;
+}
+
+static const guchar *_swAttribPtr(const _swAttrib_t *a, GLint first)
+{
+    const guchar *base = (const guchar *)a->ptr;
+
+    if (0 != a->buf) {
+        GByteArray *buf = (GByteArray *)g_hash_table_lookup(_swBufData, GUINT_TO_POINTER(a->buf));
+        if (NULL == buf)
+            return NULL;
+        base = buf->data + GPOINTER_TO_SIZE(a->ptr);
+    }
+
+    return (NULL == base) ? NULL : base + first * a->stride;
+}
+
+static void      _swDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    if ((FALSE==_swOn) || (0!=_swFBO)) {
+        (glDrawArrays)(mode, first, count);
+        return;
+    }
+
+    // FB blit - SW FB allready hold it
+    if (1.0 == _swBlitOn)
+        return;
+
+    const guchar *pos = _swAttribPtr(&_swPos, first);
+    if (NULL == pos) {
+        PRINTF("WARNING: no vertex for SW\n");
+        return;
+    }
+    // afterglow - alpha per vertex
+    const guchar *alpha = NULL;
+    if (0.0 < _swGlowOn) {
+        alpha = _swAttribPtr(&_swAlpha, first);
+        if ((NULL==alpha) || (GL_POINTS!=mode)) {
+            PRINTF("WARNING: afterglow without alpha or not POINTS\n");
+            return;
+        }
+    }
+    const guchar *uv  = NULL;
+    S52_SW_tex    tex;
+    if (1.0 == _swTextOn) {
+        uv = _swAttribPtr(&_swUV, first);
+        S52_SW_setTex((NULL == uv) ? NULL : _swGetTex(&tex));
+    } else {
+        if (1.0 == _swPattOn)
+            S52_SW_setTex(_swGetTex(&tex));
+        else
+            S52_SW_setTex(NULL);
+    }
+
+    // uProjection * uModelview, then to window as glViewport() (SW FB origin is the VP)
+    GLfloat m[16];
+    memcpy(m, _swMvm, sizeof(m));
+    {
+        GLfloat p[16];
+        memcpy(p, _swPrj, sizeof(p));
+        _multiply(p, m);
+        memcpy(m, p, sizeof(m));
+    }
+    const float hw = _swVP[2] * 0.5f;
+    const float hh = _swVP[3] * 0.5f;
+
+    g_array_set_size(_swXY, count);
+    float *out = (float *)_swXY->data;
+    for (GLsizei i=0; i<count; ++i, out+=4) {
+        const GLfloat *v = (const GLfloat *)(pos + i * _swPos.stride);
+        float cx = m[0]*v[0] + m[4]*v[1] + m[8] *v[2] + m[12];
+        float cy = m[1]*v[0] + m[5]*v[1] + m[9] *v[2] + m[13];
+        float cw = m[3]*v[0] + m[7]*v[1] + m[11]*v[2] + m[15];
+        if (0.0f == cw) cw = 1.0f;
+
+        out[0] = (cx/cw + 1.0f) * hw;
+        out[1] = (cy/cw + 1.0f) * hh;
+
+        if (NULL != alpha) {
+            out[2] = *(const GLfloat *)(alpha + i * _swAlpha.stride);
+            out[3] = 0.0f;
+        } else if (NULL != uv) {
+            const GLfloat *t = (const GLfloat *)(uv + i * _swUV.stride);
+            out[2] = t[0];
+            out[3] = t[1];
+        } else {
+            // as the vertex shader
+            out[2] = (0.0 == _swPatt[2]) ? 0.0f : (_swPatt[0] - v[0]) / _swPatt[2];
+            out[3] = (0.0 == _swPatt[3]) ? 0.0f : (_swPatt[1] - v[1]) / _swPatt[3];
+        }
+    }
+
+    S52_SW_setColor(_swColor[0], _swColor[1], _swColor[2], _swColor[3]);
+    S52_SW_setLineWidth(_swLineW);
+    S52_SW_setPointSize(_swPointSz);
+    S52_SW_setCull((FALSE == _swCullOn) ? S52_SW_CULL_NONE :
+                   ((GL_CCW == _swFront) ? S52_SW_CULL_CW : S52_SW_CULL_CCW));
+
+    if (NULL != alpha)
+        S52_SW_drawPointAlpha((const float *)_swXY->data, (const float *)_swXY->data + 2, 4, count);
+    else
+        S52_SW_draw(mode, (const float *)_swXY->data, (const float *)_swXY->data + 2, 4, count);
+}
+
+// from here on the GL2 code path go through the shadow
+#define glUniformMatrix4fv(l,n,t,m)        _swUniformMatrix4fv(l,n,t,m)
+#define glUniform1f(l,v)                   _swUniform1f(l,v)
+#define glUniform4f(l,r,g,b,a)             _swUniform4f(l,r,g,b,a)
+#define glVertexAttribPointer(i,n,t,b,s,p) _swVertexAttribPointer(i,n,t,b,s,p)
+#define glBindBuffer(t,i)                  _swBindBuffer(t,i)
+#define glBufferData(t,n,d,u)              _swBufferData(t,n,d,u)
+#define glDeleteBuffers(n,i)               _swDeleteBuffers(n,i)
+#define glBindTexture(t,i)                 _swBindTexture(t,i)
+#define glTexImage2D(t,l,i,w,h,b,f,y,d)    _swTexImage2D(t,l,i,w,h,b,f,y,d)
+#define glTexSubImage2D(t,l,x,y,w,h,f,p,d) _swTexSubImage2D(t,l,x,y,w,h,f,p,d)
+#define glDeleteTextures(n,i)              _swDeleteTextures(n,i)
+#define glBindFramebuffer(t,i)             _swBindFramebuffer(t,i)
+#define glViewport(x,y,w,h)                _swViewport(x,y,w,h)
+#define glEnable(c)                        _swEnable(c)
+#define glDisable(c)                       _swDisable(c)
+#define glFrontFace(m)                     _swFrontFace(m)
+#define glLineWidth(w)                     _swLineWidth(w)
+#define glClearColor(r,g,b,a)              _swClearColor(r,g,b,a)
+#define glClear(m)                         _swClearGL(m)
+#define glDrawArrays(m,f,c)                _swDrawArrays(m,f,c)
+
+//-----------------------------------------
+// cycle
+//
+
+static int       _swBegin(int cycle)
+// start SW for DRAW/LAST
+{
+    _swOn = FALSE;
+
+    if ((S52_GL_DRAW!=cycle) && (S52_GL_LAST!=cycle))
+        return FALSE;
+
+    _swInitShadow();
+
+    if (FALSE == S52_SW_init(_swVP[2], _swVP[3], S52_utils_getConfigInt(CFG_SW_THREAD, 0)))
+        return FALSE;
+
+    // LAST draw on top of the previous DRAW
+    if (S52_GL_LAST == cycle) {
+        if (_swFBsz != (gsize)_swVP[2] * _swVP[3] * 4) {
+            PRINTF("WARNING: LAST without DRAW, SW skipped\n");
+            return FALSE;
+        }
+        S52_SW_setPixels(_swFB);
+    }
+
+    S52_SW_begin();
+
+    _swOn = TRUE;
+
+    return TRUE;
+}
+
+static int       _swEnd(int cycle)
+// rasterise then upload to GL FB
+{
+    if (FALSE == _swOn)
+        return FALSE;
+
+    _swOn = FALSE;
+
+    S52_SW_end();
+
+    int     w  = 0;
+    int     h  = 0;
+    guchar *px = S52_SW_getPixels(&w, &h);
+    if (NULL == px)
+        return FALSE;
+
+    if (S52_GL_DRAW == cycle) {
+        _swFBsz = (gsize)w * h * 4;
+        _swFB   = g_renew(guchar, _swFB, _swFBsz);
+        memcpy(_swFB, px, _swFBsz);
+    }
+
+    if (0 == _swFBtexID) {
+        glGenTextures(1, &_swFBtexID);
+        (glBindTexture)(GL_TEXTURE_2D, _swFBtexID);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,     GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,     GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+    (glBindTexture)(GL_TEXTURE_2D, _swFBtexID);
+    (glTexImage2D) (GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, px);
+
+    // blit in clip coord - FB replaced (no blend)
+    static const GLfloat ident[16] = {1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1};
+    static const GLfloat quad [4*4] = {
+        -1.0, -1.0,   0.0, 0.0,
+         1.0, -1.0,   1.0, 0.0,
+         1.0,  1.0,   1.0, 1.0,
+        -1.0,  1.0,   0.0, 1.0
+    };
+
+    (glUniformMatrix4fv)(_uProjection, 1, GL_FALSE, ident);
+    (glUniformMatrix4fv)(_uModelview,  1, GL_FALSE, ident);
+    (glUniform1f)(_uBlitOn, 1.0);
+    (glDisable)(GL_BLEND);
+    (glDisable)(GL_CULL_FACE);
+    (glBindBuffer)(GL_ARRAY_BUFFER, 0);
+
+    glEnableVertexAttribArray(_aPosition);
+    (glVertexAttribPointer)  (_aPosition, 2, GL_FLOAT, GL_FALSE, 4*sizeof(GLfloat), quad);
+    glEnableVertexAttribArray(_aUV);
+    (glVertexAttribPointer)  (_aUV,       2, GL_FLOAT, GL_FALSE, 4*sizeof(GLfloat), quad+2);
+
+    (glDrawArrays)(GL_TRIANGLE_FAN, 0, 4);
+
+    glDisableVertexAttribArray(_aUV);
+    glDisableVertexAttribArray(_aPosition);
+
+    // back to shadow state
+    (glUniform1f)(_uBlitOn, _swBlitOn);
+    (glUniformMatrix4fv)(_uProjection, 1, GL_FALSE, _swPrj);
+    (glUniformMatrix4fv)(_uModelview,  1, GL_FALSE, _swMvm);
+    (glEnable)(GL_BLEND);
+    if (TRUE == _swCullOn)
+        (glEnable)(GL_CULL_FACE);
+    (glBindBuffer) (GL_ARRAY_BUFFER, _swBuf);
+    (glBindTexture)(GL_TEXTURE_2D,   _swTexID);
+
+    return TRUE;
+}
+
+static int       _swDone(void)
+{
+    S52_SW_done();
+
+    if (0 != _swFBtexID) {
+        (glDeleteTextures)(1, &_swFBtexID);
+        _swFBtexID = 0;
+    }
+
+    if (NULL != _swBufData) {
+        g_hash_table_destroy(_swBufData);
+        g_hash_table_destroy(_swTexData);
+        g_array_free(_swXY, TRUE);
+        _swBufData = NULL;
+        _swTexData = NULL;
+        _swXY      = NULL;
+    }
+
+    g_free(_swFB);
+    _swFB   = NULL;
+    _swFBsz = 0;
+
+    return TRUE;
+}
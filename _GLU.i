@@ -27,11 +27,18 @@ typedef _CALLBACK (*fpp)  (void*, void*);
 static GLUtriangulatorObj *_tobj       = NULL;
 static GPtrArray          *_tmpV       = NULL;     // place holder during tesssalation (GLUtriangulatorObj combineCallback)
 
+#ifdef S52_USE_EARCUT
+#include "S52EC.h"
+// ear clipping of simple area - libtess (_tobj) for the rest
+static S52_EC             *_ec         = NULL;
+static GArray             *_ecNpt      = NULL;     // guint   - nbr of vertex per ring
+static GArray             *_ecPpt      = NULL;     // double* - ring
+#endif
+
 // centroid
 static GLUtriangulatorObj *_tcen       = NULL;     // GLU CSG - Computational Solid Geometry
 static GArray             *_vertexs    = NULL;
 static GArray             *_nvertex    = NULL;     // list of nbr of vertex per poly in _vertexs
-static GArray             *_centroids  = NULL;     // centroids of poly's in _vertexs
 
 // check if centroid is inside the poly
 static GLUtriangulatorObj *_tcin       = NULL;
@@ -394,6 +401,12 @@ static GLint     _initGLU(void)
         // hold vertex comming from GLU_TESS_COMBINE callback
         _tmpV = g_ptr_array_new();
 
+#ifdef S52_USE_EARCUT
+        _ec    = S52_EC_new();
+        _ecNpt = g_array_new(FALSE, FALSE, sizeof(guint));
+        _ecPpt = g_array_new(FALSE, FALSE, sizeof(double*));
+#endif
+
         _tobj = gluNewTess();
         if (NULL == _tobj) {
             PRINTF("WARNING: gluNewTess() failed\n");
@@ -450,7 +463,6 @@ static GLint     _initGLU(void)
             PRINTF("WARNING: gluNewTess() failed\n");
             return FALSE;
         }
-        _centroids = g_array_new(FALSE, FALSE, sizeof(double)*3);
         _vertexs   = g_array_new(FALSE, FALSE, sizeof(double)*3);
         _nvertex   = g_array_new(FALSE, FALSE, sizeof(int));
 
@@ -566,12 +578,18 @@ static GLint     _freeGLU(void)
     _tobj = NULL;
     _qobj = NULL;
 
+#ifdef S52_USE_EARCUT
+    _ec = S52_EC_free(_ec);
+    if (NULL != _ecNpt) g_array_free(_ecNpt, TRUE);
+    if (NULL != _ecPpt) g_array_free(_ecPpt, TRUE);
+    _ecNpt = NULL;
+    _ecPpt = NULL;
+#endif
+
     if (NULL != _tcen) gluDeleteTess(_tcen);
     _tcen = NULL;
     if (NULL != _tcin) gluDeleteTess(_tcin);
     _tcin = NULL;
-    if (NULL != _centroids) g_array_free(_centroids, TRUE);
-    _centroids = NULL;
     if (NULL != _vertexs)   g_array_free(_vertexs,   TRUE);
     _vertexs = NULL;
     if (NULL != _nvertex)   g_array_free(_nvertex,   TRUE);
@@ -596,6 +614,41 @@ static S57_prim *_tessd(GLUtriangulatorObj *tobj, S57_geo *geo)
     guint     nr   = S57_getRingNbr(geo);
     S57_prim *prim = S57_initPrimGeo(geo);
 
+#ifdef S52_USE_EARCUT
+    // fast path: simple area (most DEPARE / LNDARE) - one GL_TRIANGLES
+    if (tobj == _tobj) {
+        g_array_set_size(_ecNpt, 0);
+        g_array_set_size(_ecPpt, 0);
+        for (guint i=0; i<nr; ++i) {
+            guint   npt = 0;
+            double *ppt = NULL;
+
+            if (TRUE == S57_getGeoData(geo, i, &npt, &ppt)) {
+                // delete possible S57_OVERLAP_GEO_Z - as libtess path
+                for (guint j=0; j<npt-1; ++j)
+                    ppt[j*3+2] = 0.0;
+
+                g_array_append_val(_ecNpt, npt);
+                g_array_append_val(_ecPpt, ppt);
+            }
+        }
+
+        double *tri  = NULL;
+        guint   nTri = S52_EC_triangulate(_ec, _ecNpt->len, (guint*)_ecNpt->data, (double**)_ecPpt->data, &tri);
+        if (0 < nTri) {
+            S57_begPrim(prim, GL_TRIANGLES);
+            for (guint i=0; i<nTri*3; ++i, tri+=3) {
+                vertex_t d[3] = {tri[0], tri[1], 0.0};
+                S57_addPrimVertex(prim, d);
+            }
+            S57_endPrim(prim);
+
+            return prim;
+        }
+        // not simple - libtess
+    }
+#endif  // S52_USE_EARCUT
+
     _g_ptr_array_clear(_tmpV);
 
     // Note: _*NOT*_ NULL to trigger GL_TRIANGLES tessallation
@@ -662,3 +715,94 @@ void      S52_GLU_endUnion(guint *npt, double **ppt)
 
     return;
 }
+
+// re-entrant union - own tess and buffers (run in the HO data thread, not only GL)
+typedef struct _union {
+    GArray    *vertex;     // out
+    GArray    *nvertex;    // out
+    GPtrArray *tmpV;       // combine vertex
+    guint      beg;        // first vertex of current ring
+} _union;
+
+static void_cb_t _begUnionData(GLenum data, _union *u)
+{
+    (void) data;  // GL_LINE_LOOP
+
+    u->beg = u->vertex->len;
+}
+
+static void_cb_t _vertexUnionData(GLvoid *data, _union *u)
+{
+    g_array_append_val(u->vertex, *(pt3*)data);
+}
+
+static void_cb_t _endUnionData(_union *u)
+{
+    guint n = u->vertex->len - u->beg;
+    if (0 < n)
+        g_array_append_val(u->nvertex, n);
+}
+
+static void_cb_t _combineUnionData(GLdouble coords[3], GLdouble *vertex_data[4], GLfloat weight[4], GLdouble **dataOut, _union *u)
+{
+    (void) vertex_data;
+    (void) weight;
+
+    pt3 *p = g_new(pt3, 1);
+    p->x   = coords[0];
+    p->y   = coords[1];
+    p->z   = coords[2];
+    *dataOut = (GLdouble*)p;
+
+    g_ptr_array_add(u->tmpV, p);
+}
+
+int       S52_GLU_unionRings(GArray *vertex, GArray *nvertex, GArray *outVertex, GArray *outNvertex)
+// union of rings (pt3 in vertex, nbr of pt per ring in nvertex)
+// out: CCW exterior ring, CW interior ring, not closed
+// Note: input rings must have the same winding (outer) or be a previous output
+{
+    GLUtriangulatorObj *tobj = gluNewTess();
+    if (NULL == tobj) {
+        PRINTF("WARNING: gluNewTess() failed\n");
+        return FALSE;
+    }
+
+    _union u = {outVertex, outNvertex, g_ptr_array_new(), 0};
+
+    g_array_set_size(outVertex,  0);
+    g_array_set_size(outNvertex, 0);
+
+    gluTessProperty(tobj, GLU_TESS_WINDING_RULE,  GLU_TESS_WINDING_NONZERO);
+    gluTessProperty(tobj, GLU_TESS_BOUNDARY_ONLY, GLU_TRUE);
+
+    gluTessCallback(tobj, GLU_TESS_BEGIN_DATA,   (f)_begUnionData);
+    gluTessCallback(tobj, GLU_TESS_END_DATA,     (f)_endUnionData);
+    gluTessCallback(tobj, GLU_TESS_VERTEX_DATA,  (f)_vertexUnionData);
+    gluTessCallback(tobj, GLU_TESS_COMBINE_DATA, (f)_combineUnionData);
+    gluTessCallback(tobj, GLU_TESS_ERROR,        (f)_tessError);
+
+    // set poly in x-y plane normal is Z (for performance)
+    gluTessNormal(tobj, 0.0, 0.0, 1.0);
+
+    gluTessBeginPolygon(tobj, &u);
+    pt3 *pt = (pt3*)vertex->data;
+    for (guint i=0; i<nvertex->len; ++i) {
+        guint npt = g_array_index(nvertex, guint, i);
+
+        gluTessBeginContour(tobj);
+        for (guint j=0; j<npt; ++j, ++pt) {
+            pt->z = 0.0;  // delete possible S57_OVERLAP_GEO_Z
+            gluTessVertex(tobj, (GLdouble*)pt, (void*)pt);
+        }
+        gluTessEndContour(tobj);
+    }
+    gluTessEndPolygon(tobj);
+
+    gluDeleteTess(tobj);
+
+    g_ptr_array_foreach(u.tmpV, (GFunc)g_free, NULL);
+    g_ptr_array_free(u.tmpV, TRUE);
+
+    return TRUE;
+}
@@ -313,6 +313,25 @@ static int                 _handleS52method(const gchar *str, char *result, char
         goto exit;
     }
 
+    //const char * STD S52_getStats(const char *cellName);
+    if (0 == g_strcmp0(cmdName, "S52_getStats")) {
+        // cellName is optional
+        const char *cellName = (1 == count) ? json_array_get_string(paramsArr, 0) : NULL;
+
+        const char *statstr = S52_getStats(cellName);
+        if (NULL == statstr) {
+            _setErr(err, "S52_getStats() failed");
+            goto exit;
+        }
+
+        // JSON object as is - big output ("*" with many cells) overflow SOCK_BUF
+        if (FALSE == _encode(result, "[%s]", statstr)) {
+            _setErr(err, "S52_getStats() output too big for socket buffer");
+        }
+
+        goto exit;
+    }
+
     //double STD S52_getMarinerParam(S52MarinerParameter paramID);
     if (0 == g_strcmp0(cmdName, "S52_getMarinerParam")) {
         if (1 != count) {
@@ -350,6 +369,22 @@ static int                 _handleS52method(const gchar *str, char *result, char
         goto exit;
     }
 
+    //int    STD S52_setLogLevel(S52_logLevel level);
+    if (0 == g_strcmp0(cmdName, "S52_setLogLevel")) {
+        if (1 != count) {
+            _setErr(err, "params 'level' not found");
+            goto exit;
+        }
+
+        double level = json_array_get_number(paramsArr, 0);
+
+        int i = S52_setLogLevel((S52_logLevel)level);
+
+        _encode(result, "[%i]", i);
+
+        goto exit;
+    }
+
     //DLL int    STD S52_drawBlit(double scale_x, double scale_y, double scale_z, double north);
     if (0 == g_strcmp0(cmdName, "S52_drawBlit")) {
         if (4 != count) {
@@ -385,6 +420,24 @@ static int                 _handleS52method(const gchar *str, char *result, char
         goto exit;
     }
 
+    //int    STD S52_needDraw(void);
+    if (0 == g_strcmp0(cmdName, "S52_needDraw")) {
+        int i = S52_needDraw();
+
+        _encode(result, "[%i]", i);
+
+        goto exit;
+    }
+
+    //int    STD S52_needDrawLast(void);
+    if (0 == g_strcmp0(cmdName, "S52_needDrawLast")) {
+        int i = S52_needDrawLast();
+
+        _encode(result, "[%i]", i);
+
+        goto exit;
+    }
+
     //int    STD S52_draw(void);
     if (0 == g_strcmp0(cmdName, "S52_draw")) {
         int i = S52_draw();
@@ -1698,6 +1751,50 @@ static DBusHandlerResult   _dbus_getS57ClassList    (DBusConnection *dbus, DBusM
     return _sendDBusMessage(dbus, reply);
 }
 
+static DBusHandlerResult   _dbus_getStats           (DBusConnection *dbus, DBusMessage *message, void *user_data)
+{
+    DBusMessage*    reply;
+    DBusMessageIter args;
+    DBusError       error;
+    char           *cellName;
+
+    (void)user_data;
+
+    dbus_error_init(&error);
+
+    if (!dbus_message_get_args(message, &error, DBUS_TYPE_STRING, &cellName, DBUS_TYPE_INVALID)) {
+        PRINTF("ERROR: %s\n", error.message);
+        dbus_error_free(&error);
+
+        // debug
+        g_assert(0);
+
+        return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+    }
+
+    // make the S52 call - empty string is the global stats
+    const char * str = S52_getStats(('\0'==*cellName) ? NULL : cellName);
+    if (NULL == str) {
+        PRINTF("WARNING: S52_getStats() failed\n");
+        str = "{}";
+    }
+
+    // -- reply --
+
+    // create a reply from the message
+    reply = dbus_message_new_method_return(message);
+
+    // add the arguments to the reply
+    dbus_message_iter_init_append(reply, &args);
+
+    if (!dbus_message_iter_append_basic(&args, DBUS_TYPE_STRING, &str)) {
+        PRINTF("ERROR: Out Of Memory!\n");
+        g_assert(0);
+    }
+
+    return _sendDBusMessage(dbus, reply);
+}
+
 static DBusHandlerResult   _dbus_getObjList         (DBusConnection *dbus, DBusMessage *message, void *user_data)
 {
     DBusMessage*    reply;
@@ -2074,6 +2171,9 @@ static DBusHandlerResult   _dbus_selectCall         (DBusConnection *dbus, DBusM
     if (dbus_message_is_method_call(message, S52_DBUS_OBJ_NAME, "S52_getS57ClassList")) {
         return _dbus_getS57ClassList(dbus, message, user_data);
     }
+    if (dbus_message_is_method_call(message, S52_DBUS_OBJ_NAME, "S52_getStats")) {
+        return _dbus_getStats(dbus, message, user_data);
+    }
     if (dbus_message_is_method_call(message, S52_DBUS_OBJ_NAME, "S52_getObjList")) {
         return _dbus_getObjList(dbus, message, user_data);
     }
@@ -2188,6 +2288,7 @@ static int                 _initDBus()
     dbus_bus_add_match(_dbus, "type='method_call',interface='nav.ecs.dbus',member='S52_getPalettesNameList'", &_dbusError);
     dbus_bus_add_match(_dbus, "type='method_call',interface='nav.ecs.dbus',member='S52_getCellNameList'",     &_dbusError);
     dbus_bus_add_match(_dbus, "type='method_call',interface='nav.ecs.dbus',member='S52_getS57ClassList'",     &_dbusError);
+    dbus_bus_add_match(_dbus, "type='method_call',interface='nav.ecs.dbus',member='S52_getStats'",            &_dbusError);
     dbus_bus_add_match(_dbus, "type='method_call',interface='nav.ecs.dbus',member='S52_getObjList'",          &_dbusError);
     dbus_bus_add_match(_dbus, "type='method_call',interface='nav.ecs.dbus',member='S52_getAttList'",          &_dbusError);
     dbus_bus_add_match(_dbus, "type='method_call',interface='nav.ecs.dbus',member='S52_getS57ObjClassSupp'",  &_dbusError);
@@ -0,0 +1,150 @@
+// _bench.i: common code of the bench / tool (cell list, stat, EGL pbuffer)
+//
+// started with s57bench (ISO 8211 reader) _collectCell(), the later tool add to it
+// included by s52bench.c, s52rwbench.c, s52replay.c, s52tiled.c, s52swbench.c,
+// s57bench.c, s57arena.c, s52ecbench.c - include <EGL/egl.h> before for _egl_*()
+
+#include <stdlib.h>         // qsort()
+#include <math.h>           // ceil()
+
+
+static G_GNUC_UNUSED void   _collectCell(const char *path, GPtrArray *cells)
+// path is a cell or a directory (ENC_ROOT) walked for base cell (*.000)
+{
+    if (TRUE == g_file_test(path, G_FILE_TEST_IS_DIR)) {
+        GDir *dir = g_dir_open(path, 0, NULL);
+        if (NULL == dir)
+            return;
+
+        const gchar *name = NULL;
+        while (NULL != (name = g_dir_read_name(dir))) {
+            gchar *sub = g_build_filename(path, name, NULL);
+            if ((TRUE == g_file_test(sub, G_FILE_TEST_IS_DIR)) || (TRUE == g_str_has_suffix(sub, ".000")))
+                _collectCell(sub, cells);
+            g_free(sub);
+        }
+        g_dir_close(dir);
+    } else {
+        g_ptr_array_add(cells, g_strdup(path));
+    }
+}
+
+static G_GNUC_UNUSED int    _cmpDouble(gconstpointer a, gconstpointer b)
+// g_array_sort() / qsort()
+{
+    double A = *(const double*)a;
+    double B = *(const double*)b;
+
+    return (A < B) ? -1 : (A > B) ? 1 : 0;
+}
+
+static G_GNUC_UNUSED double _median(double *t, guint n)
+// sort t
+{
+    if (0 == n)
+        return 0.0;
+
+    qsort(t, n, sizeof(double), _cmpDouble);
+
+    return t[n/2];
+}
+
+static G_GNUC_UNUSED void   _printStat(FILE *fd, const char *name, GArray *t, const char *sep)
+// "name": {"n":, "min":, "median":, "p99":, "max":} - sort t
+{
+    if (0 == t->len) {
+        fprintf(fd, "    \"%s\": {\"n\": 0}%s\n", name, sep);
+        return;
+    }
+
+    double med = _median((double*)t->data, t->len);
+    guint  p99 = (guint)ceil(0.99 * t->len) - 1;
+    double min = g_array_index(t, double, 0);
+    double max = g_array_index(t, double, t->len-1);
+
+    fprintf(fd, "    \"%s\": {\"n\": %u, \"min\": %.4f, \"median\": %.4f, \"p99\": %.4f, \"max\": %.4f}%s\n",
+            name, t->len, min, med, g_array_index(t, double, p99), max, sep);
+}
+
+
+#ifdef EGL_VERSION_1_0
+typedef struct _egl {
+    EGLDisplay dpy;
+    EGLConfig  cfg;
+    EGLSurface sfc;
+    EGLContext ctx;
+} _egl;
+
+static G_GNUC_UNUSED int    _egl_init(_egl *egl, const _egl *share, int w, int h)
+// GLES2 pbuffer - share: NULL new display, else same display / config and share group
+{
+    const EGLint cfgAttr[] = {
+        EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+        EGL_RED_SIZE,        8,
+        EGL_GREEN_SIZE,      8,
+        EGL_BLUE_SIZE,       8,
+        EGL_ALPHA_SIZE,      8,
+        EGL_STENCIL_SIZE,    8,
+        EGL_NONE
+    };
+    const EGLint sfcAttr[] = {
+        EGL_WIDTH,  w,
+        EGL_HEIGHT, h,
+        EGL_NONE
+    };
+    const EGLint ctxAttr[] = {
+        EGL_CONTEXT_CLIENT_VERSION, 2,
+        EGL_NONE
+    };
+
+    if (NULL == share) {
+        EGLint nCfg  = 0;
+        EGLint major = 0;
+        EGLint minor = 0;
+
+        egl->dpy = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if ((EGL_NO_DISPLAY==egl->dpy) || (EGL_FALSE==eglInitialize(egl->dpy, &major, &minor))) {
+            printf("_egl_init(): eglInitialize() failed [0x%x]\n", eglGetError());
+            return FALSE;
+        }
+
+        eglBindAPI(EGL_OPENGL_ES_API);
+
+        if ((EGL_FALSE==eglChooseConfig(egl->dpy, cfgAttr, &egl->cfg, 1, &nCfg)) || (0==nCfg)) {
+            printf("_egl_init(): eglChooseConfig() no pbuffer config [0x%x]\n", eglGetError());
+            return FALSE;
+        }
+    } else {
+        egl->dpy = share->dpy;
+        egl->cfg = share->cfg;
+        eglBindAPI(EGL_OPENGL_ES_API);
+    }
+
+    egl->sfc = eglCreatePbufferSurface(egl->dpy, egl->cfg, sfcAttr);
+    egl->ctx = eglCreateContext(egl->dpy, egl->cfg, (NULL==share) ? EGL_NO_CONTEXT : share->ctx, ctxAttr);
+    if ((EGL_NO_SURFACE==egl->sfc) || (EGL_NO_CONTEXT==egl->ctx)) {
+        printf("_egl_init(): pbuffer / context creation failed [0x%x]\n", eglGetError());
+        return FALSE;
+    }
+
+    if (EGL_FALSE == eglMakeCurrent(egl->dpy, egl->sfc, egl->sfc, egl->ctx)) {
+        printf("_egl_init(): eglMakeCurrent() failed [0x%x]\n", eglGetError());
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static G_GNUC_UNUSED void   _egl_done(_egl *egl, int terminate)
+// terminate: TRUE the display (root), else release this thread
+{
+    eglMakeCurrent(egl->dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(egl->dpy, egl->ctx);
+    eglDestroySurface(egl->dpy, egl->sfc);
+    if (TRUE == terminate)
+        eglTerminate(egl->dpy);
+    else
+        eglReleaseThread();
+}
+#endif  // EGL_VERSION_1_0
@@ -334,6 +334,9 @@ static int      _egl_init       (EGLState *eglState)
         EGL_BLUE_SIZE,       8,
         //EGL_ALPHA_SIZE,      8,
 
+        // libS52 S52_USE_STENCIL_FILL
+        EGL_STENCIL_SIZE,    8,
+
         // MSAA - fail on MESA with "export MESA_GLES_VERSION_OVERRIDE=2.0"
         // black frame flicker
         EGL_SAMPLE_BUFFERS,      1,
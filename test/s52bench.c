@@ -0,0 +1,458 @@
+// s52bench.c: headless (EGL pbuffer) rendering benchmark - scripted pan/zoom scenario, JSON output
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Usage: s52bench [-w width] [-h height] [-p plib.rle].. [-s script] [-a nAIS] [-o out.json] cell.000|ENC_ROOT ..
+//
+// No window: render in an EGL pbuffer, so it run on Mesa llvmpipe without X:
+//   $ EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./s52bench -a 100 ENC_ROOT
+// With no cell on the command line the cells of s52.cfg are loaded (S52_loadCell(NULL)).
+//
+// Each frame is one S52_draw() + S52_drawLast(), libS52 phase time come from
+// S52_getDrawTime(). Result (min / median / p99 in msec) is written in JSON,
+// one entry per phase then per step of the scenario.
+//
+// Symbol VBO bind of a frame ("bind" of S52_getStats()) is also written ("gl"),
+// run it with a libS52 build with and without S52_USE_SYM_ATLAS to compare.
+//
+// With -DS52_USE_GPU_TIMER (libS52 build with it) the GPU time of S52_getGPUTime()
+// is also written: by stage, display priority and command word ("gpu").
+//
+// Script: one step per line, '#' comment, the view start on the extent of all cells
+//   frames  <n>                   draw n frames, view unchanged
+//   pan     <n> <dxNM> <dyNM>     n frames, move the view (dx,dy) NM each frame
+//   zoom    <n> <factor>          n frames, range *= factor each frame
+//   rot     <n> <deg>             n frames, north += deg each frame
+//   palette <n>                   n frames, next palette each frame
+//   safety  <n> <m1> <m2>         n frames, safety contour alternate m1 / m2 (meters)
+
+
+#include "S52.h"
+
+#include <EGL/egl.h>
+
+#include <glib.h>
+#include <stdio.h>          // printf(), fopen()
+#include <stdlib.h>         // atoi()
+#include <string.h>         // strcmp()
+#include <math.h>           // cos()
+
+#include "_bench.i"         // _collectCell(), _printStat(), _egl_init(), _egl_done()
+
+// default scenario
+static const char *_scenario =
+    "frames  20\n"
+    "pan     40  0.5  0.0\n"
+    "pan     40  0.0 -0.5\n"
+    "zoom    30  0.9\n"
+    "zoom    30  1.111\n"
+    "rot     36  10.0\n"
+    "palette 10\n"
+    "safety  20  5.0 10.0\n"
+    "frames  20\n";
+
+// phase of a frame
+enum { _APP, _CULL, _DRAW, _TEXT, _LAST, _FRAME, _N_PHASE };
+static const char *_phaseName[_N_PHASE] = {"app", "cull", "draw", "text", "drawLast", "frame"};
+
+#ifdef S52_USE_GPU_TIMER
+// GPU time of a frame - S52_getGPUTime()
+enum { _GPU_DRAW, _GPU_TEXT, _GPU_RASTER, _GPU_LAST, _GPU_PRIO, _GPU_CMD = _GPU_PRIO + 10, _N_GPU = _GPU_CMD + 5 };
+static const char *_gpuName[_N_GPU] = {"draw", "text", "raster", "drawLast",
+                                       "prio0", "prio1", "prio2", "prio3", "prio4",
+                                       "prio5", "prio6", "prio7", "prio8", "prio9",
+                                       "SY", "LS", "LC", "AC", "AP"};
+static GArray *_gpu[_N_GPU];        // double - all frames with a new result
+static guint   _gpuFrame = 0;       // frame of the last result
+static int     _gpuSrc   = 0;       // 2 GPU, 1 CPU, 0 none
+#endif
+
+typedef struct _step {
+    gchar  *name;           // script line
+    GArray *frame;          // double - frame time (msec)
+} _step;
+
+typedef struct _ais {
+    S52ObjectHandle vessel;
+    double          lat;
+    double          lon;
+    double          course; // deg
+    double          speed;  // NM per frame
+} _ais;
+
+static _egl    _eglState;
+static GArray *_phase[_N_PHASE];    // double - all frames
+static GArray *_bind[2];            // double - symbol VBO bind of S52_draw() / S52_drawLast()
+static GArray *_aisList = NULL;     // _ais
+static GTimer *_timer   = NULL;
+
+static int      _egl_beg(void *EGLctx, const char *tag)
+{
+    _egl *egl = (_egl*)EGLctx;
+    (void)tag;
+
+    if (egl->ctx != eglGetCurrentContext())
+        eglMakeCurrent(egl->dpy, egl->sfc, egl->sfc, egl->ctx);
+
+    return TRUE;
+}
+
+static int      _egl_end(void *EGLctx, const char *tag)
+// no swap in a pbuffer - wait for the GPU so the frame time is real
+{
+    (void)EGLctx;
+    (void)tag;
+
+    eglWaitGL();
+
+    return TRUE;
+}
+
+static void     _newAIS(int nAIS, double cLat, double cLon, double rNM)
+// AIS target scattered in the view, random course
+{
+    GRand *rnd = g_rand_new_with_seed(52);   // same target every run
+
+    _aisList = g_array_new(FALSE, TRUE, sizeof(_ais));
+    for (int i=0; i<nAIS; ++i) {
+        _ais  a;
+        gchar label[32];
+
+        g_snprintf(label, sizeof(label), "AIS%03i", i);
+
+        a.lat    = cLat + g_rand_double_range(rnd, -rNM, rNM) / 60.0;
+        a.lon    = cLon + g_rand_double_range(rnd, -rNM, rNM) / (60.0 * cos(cLat * G_PI / 180.0));
+        a.course = g_rand_double_range(rnd, 0.0, 360.0);
+        a.speed  = rNM / 500.0;
+        a.vessel = S52_newVESSEL(2, label);
+
+        S52_setVESSELstate(a.vessel, 0, 1, 0);  // AIS active
+        S52_setVector(a.vessel, 1, a.course, 12.0);
+        S52_pushPosition(a.vessel, a.lat, a.lon, a.course);
+
+        g_array_append_val(_aisList, a);
+    }
+
+    g_rand_free(rnd);
+}
+
+static void     _moveAIS(void)
+{
+    for (guint i=0; NULL!=_aisList && i<_aisList->len; ++i) {
+        _ais *a = &g_array_index(_aisList, _ais, i);
+
+        a->lat += a->speed * cos(a->course * G_PI / 180.0) / 60.0;
+        a->lon += a->speed * sin(a->course * G_PI / 180.0) / (60.0 * cos(a->lat * G_PI / 180.0));
+
+        S52_pushPosition(a->vessel, a->lat, a->lon, a->course);
+    }
+}
+
+static void     _getBind(void)
+// "bind" of "gl":{"draw":{}, "last":{}} in S52_getStats()
+{
+    const char *str = S52_getStats(NULL);
+    const char *p   = (NULL == str) ? NULL : strstr(str, "\"gl\":");
+
+    for (int i=0; NULL!=p && i<2; ++i) {
+        p = strstr(p, "\"bind\":");
+        if (NULL == p)
+            return;
+        p += strlen("\"bind\":");
+
+        double n = g_ascii_strtod(p, NULL);
+        g_array_append_val(_bind[i], n);
+    }
+}
+
+static void     _frame(_step *step)
+{
+    double t[_N_PHASE];
+
+    _moveAIS();
+
+    g_timer_start(_timer);
+    S52_draw();
+    S52_drawLast();
+    t[_FRAME] = g_timer_elapsed(_timer, NULL) * 1000.0;
+
+    S52_getDrawTime(&t[_APP], &t[_CULL], &t[_DRAW], &t[_TEXT], &t[_LAST]);
+    _getBind();
+
+    for (int i=0; i<_N_PHASE; ++i)
+        g_array_append_val(_phase[i], t[i]);
+
+#ifdef S52_USE_GPU_TIMER
+    {   // result come a few frames later - keep each once
+        double       g[_N_GPU];
+        unsigned int frame = 0;
+        int          src   = S52_getGPUTime(&frame, &g[_GPU_DRAW], &g[_GPU_TEXT], &g[_GPU_RASTER], &g[_GPU_LAST],
+                                            &g[_GPU_PRIO], &g[_GPU_CMD]);
+        if ((0!=src) && (frame!=_gpuFrame)) {
+            _gpuFrame = frame;
+            _gpuSrc   = src;
+            for (int i=0; i<_N_GPU; ++i)
+                g_array_append_val(_gpu[i], g[i]);
+        }
+    }
+#endif
+
+    g_array_append_val(step->frame, t[_FRAME]);
+}
+
+static int      _runStep(_step *step)
+{
+    gchar **tok = g_strsplit_set(g_strstrip(step->name), " \t", 0);
+    gchar **arg = tok;
+    double  a[3] = {0.0, 0.0, 0.0};
+    int     na   = 0;
+
+    // skip empty token (many blank)
+    for (gchar **p=tok+1; NULL!=*p && na<3; ++p)
+        if ('\0' != **p)
+            a[na++] = g_ascii_strtod(*p, NULL);
+
+    int    n = (int)a[0];
+    double cLat, cLon, rNM, north;
+    S52_getView(&cLat, &cLon, &rNM, &north);
+
+    for (int i=0; i<n; ++i) {
+        if (0 == g_strcmp0(*arg, "pan")) {
+            cLat += a[2] / 60.0;
+            cLon += a[1] / (60.0 * cos(cLat * G_PI / 180.0));
+            S52_setView(cLat, cLon, rNM, north);
+        } else if (0 == g_strcmp0(*arg, "zoom")) {
+            rNM *= a[1];
+            S52_setView(cLat, cLon, rNM, north);
+        } else if (0 == g_strcmp0(*arg, "rot")) {
+            north = fmod(north + a[1] + 360.0, 360.0);
+            S52_setView(cLat, cLon, rNM, north);
+        } else if (0 == g_strcmp0(*arg, "palette")) {
+            // count palette from the name list
+            const char *list = S52_getPalettesNameList();
+            gchar     **pal  = g_strsplit((NULL == list) ? "" : list, ",", 0);
+            guint       nPal = g_strv_length(pal);
+            g_strfreev(pal);
+            S52_setMarinerParam(S52_MAR_COLOR_PALETTE, (double)((i+1) % MAX(nPal, 1)));
+        } else if (0 == g_strcmp0(*arg, "safety")) {
+            S52_setMarinerParam(S52_MAR_SAFETY_CONTOUR, (0 == i%2) ? a[1] : a[2]);
+        } else if (0 != g_strcmp0(*arg, "frames")) {
+            printf("s52bench: unknown step: %s\n", step->name);
+            g_strfreev(tok);
+            return FALSE;
+        }
+
+        _frame(step);
+    }
+
+    // back to default - next step start from the same state
+    if (0 == g_strcmp0(*arg, "palette"))
+        S52_setMarinerParam(S52_MAR_COLOR_PALETTE, 0.0);
+
+    g_strfreev(tok);
+
+    return TRUE;
+}
+
+int main(int argc, char *argv[])
+{
+    int         w      = 1280;
+    int         h      = 1024;
+    int         nAIS   = 0;
+    const char *script = NULL;
+    const char *out    = NULL;
+    GPtrArray  *plibs  = g_ptr_array_new();
+    GPtrArray  *cells  = g_ptr_array_new();
+
+    for (int i=1; i<argc; ++i) {
+        if ((0==strcmp(argv[i], "-w")) && (i+1<argc)) { w      = atoi(argv[++i]);           continue; }
+        if ((0==strcmp(argv[i], "-h")) && (i+1<argc)) { h      = atoi(argv[++i]);           continue; }
+        if ((0==strcmp(argv[i], "-a")) && (i+1<argc)) { nAIS   = atoi(argv[++i]);           continue; }
+        if ((0==strcmp(argv[i], "-s")) && (i+1<argc)) { script = argv[++i];                 continue; }
+        if ((0==strcmp(argv[i], "-o")) && (i+1<argc)) { out    = argv[++i];                 continue; }
+        if ((0==strcmp(argv[i], "-p")) && (i+1<argc)) { g_ptr_array_add(plibs, argv[++i]);  continue; }
+        if ('-' == argv[i][0]) {
+            printf("Usage: %s [-w width] [-h height] [-p plib.rle].. [-s script] [-a nAIS] [-o out.json] cell.000|ENC_ROOT ..\n", argv[0]);
+            return 1;
+        }
+        _collectCell(argv[i], cells);
+    }
+
+    // scenario
+    gchar *text = NULL;
+    if (NULL == script) {
+        text = g_strdup(_scenario);
+    } else if (FALSE == g_file_get_contents(script, &text, NULL, NULL)) {
+        printf("s52bench: can't read script %s\n", script);
+        return 1;
+    }
+
+    GArray *steps = g_array_new(FALSE, TRUE, sizeof(_step));
+    gchar **lines = g_strsplit(text, "\n", 0);
+    for (gchar **l=lines; NULL!=*l; ++l) {
+        gchar *hash = strchr(*l, '#');
+        if (NULL != hash)
+            *hash = '\0';
+        if ('\0' == *g_strstrip(*l))
+            continue;
+
+        _step step = {g_strdup(*l), g_array_new(FALSE, FALSE, sizeof(double))};
+        g_array_append_val(steps, step);
+    }
+    g_strfreev(lines);
+    g_free(text);
+
+    // GL / libS52
+    if (FALSE == _egl_init(&_eglState, NULL, w, h))
+        return 1;
+
+    // ~ 96 DPI
+    if (FALSE == S52_init(w, h, (int)(w * 25.4 / 96.0), (int)(h * 25.4 / 96.0), NULL)) {
+        printf("s52bench: S52_init() failed\n");
+        return 1;
+    }
+    S52_setEGLCallBack(_egl_beg, _egl_end, &_eglState);
+
+    for (guint i=0; i<plibs->len; ++i)
+        S52_loadPLib((const char *)g_ptr_array_index(plibs, i));
+
+    GTimer *load = g_timer_new();
+    if (0 == cells->len) {
+        S52_loadCell(NULL, NULL);
+    } else {
+        for (guint i=0; i<cells->len; ++i)
+            S52_loadCell((const char *)g_ptr_array_index(cells, i), NULL);
+    }
+    double loadSec = g_timer_elapsed(load, NULL);
+    g_timer_destroy(load);
+
+    S52_setMarinerParam(S52_MAR_DISP_CATEGORY,   S52_MAR_DISP_CATEGORY_SELECT);
+    S52_setMarinerParam(S52_MAR_DISP_LAYER_LAST, S52_MAR_DISP_LAYER_LAST_SELECT);
+
+    // start on the extent of all cells
+    double S, W, N, E;
+    if (FALSE == S52_getCellExtent(NULL, &S, &W, &N, &E)) {
+        printf("s52bench: no cell loaded\n");
+        return 1;
+    }
+    double cLat = (S + N) / 2.0;
+    double cLon = (W + E) / 2.0;
+    double rNM  = (N - S) * 60.0 / 2.0;
+    S52_setView(cLat, cLon, rNM, 0.0);
+
+    _newAIS(nAIS, cLat, cLon, rNM);
+
+    // run
+    _timer = g_timer_new();
+    for (int i=0; i<_N_PHASE; ++i)
+        _phase[i] = g_array_new(FALSE, FALSE, sizeof(double));
+    for (int i=0; i<2; ++i)
+        _bind[i] = g_array_new(FALSE, FALSE, sizeof(double));
+#ifdef S52_USE_GPU_TIMER
+    for (int i=0; i<_N_GPU; ++i)
+        _gpu[i] = g_array_new(FALSE, FALSE, sizeof(double));
+#endif
+
+    // first frame set the projection, build VBO, .. - not in the stat
+    {
+        _step warm = {"warm-up", g_array_new(FALSE, FALSE, sizeof(double))};
+        _frame(&warm);
+        for (int i=0; i<_N_PHASE; ++i)
+            g_array_set_size(_phase[i], 0);
+        for (int i=0; i<2; ++i)
+            g_array_set_size(_bind[i], 0);
+#ifdef S52_USE_GPU_TIMER
+        for (int i=0; i<_N_GPU; ++i)
+            g_array_set_size(_gpu[i], 0);
+#endif
+        g_array_free(warm.frame, TRUE);
+    }
+
+    for (guint i=0; i<steps->len; ++i) {
+        S52_setView(cLat, cLon, rNM, 0.0);
+        if (FALSE == _runStep(&g_array_index(steps, _step, i)))
+            return 1;
+    }
+
+    // result
+    FILE *fd = (NULL == out) ? stdout : fopen(out, "w");
+    if (NULL == fd) {
+        printf("s52bench: can't write %s\n", out);
+        return 1;
+    }
+
+    fprintf(fd, "{\n  \"width\": %i, \"height\": %i, \"cells\": %u, \"ais\": %i, \"load_ms\": %.1f,\n",
+            w, h, cells->len, nAIS, loadSec * 1000.0);
+    fprintf(fd, "  \"phase\": {\n");
+    for (int i=0; i<_N_PHASE; ++i)
+        _printStat(fd, _phaseName[i], _phase[i], (i+1<_N_PHASE) ? "," : "");
+    fprintf(fd, "  },\n  \"gl\": {\n    \"sym_atlas\": %s,\n",
+            (NULL != strstr(S52_version(), "S52_USE_SYM_ATLAS")) ? "true" : "false");
+    _printStat(fd, "bind_draw", _bind[0], ",");
+    _printStat(fd, "bind_last", _bind[1], "");
+#ifdef S52_USE_GPU_TIMER
+    fprintf(fd, "  },\n  \"gpu\": {\n    \"src\": \"%s\",\n",
+            (2==_gpuSrc) ? "timer_query" : (1==_gpuSrc) ? "cpu" : "none");
+    for (int i=0; i<_N_GPU; ++i)
+        _printStat(fd, _gpuName[i], _gpu[i], (i+1<_N_GPU) ? "," : "");
+#endif
+    fprintf(fd, "  },\n  \"step\": {\n");
+    for (guint i=0; i<steps->len; ++i) {
+        _step *step = &g_array_index(steps, _step, i);
+        gchar *name = g_strdup_printf("%u: %s", i, step->name);
+        gchar *esc  = g_strescape(name, NULL);
+        _printStat(fd, esc, step->frame, (i+1<steps->len) ? "," : "");
+        g_free(esc);
+        g_free(name);
+    }
+    fprintf(fd, "  }\n}\n");
+
+    if (stdout != fd)
+        fclose(fd);
+
+    // cleanup
+    S52_done();
+    _egl_done(&_eglState, TRUE);
+
+    for (guint i=0; i<steps->len; ++i) {
+        _step *step = &g_array_index(steps, _step, i);
+        g_free(step->name);
+        g_array_free(step->frame, TRUE);
+    }
+    g_array_free(steps, TRUE);
+    for (int i=0; i<_N_PHASE; ++i)
+        g_array_free(_phase[i], TRUE);
+    for (int i=0; i<2; ++i)
+        g_array_free(_bind[i], TRUE);
+#ifdef S52_USE_GPU_TIMER
+    for (int i=0; i<_N_GPU; ++i)
+        g_array_free(_gpu[i], TRUE);
+#endif
+    if (NULL != _aisList)
+        g_array_free(_aisList, TRUE);
+    g_timer_destroy(_timer);
+    g_ptr_array_foreach(cells, (GFunc)g_free, NULL);
+    g_ptr_array_free(cells, TRUE);
+    g_ptr_array_free(plibs, TRUE);
+
+    return 0;
+}
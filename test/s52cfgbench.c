@@ -0,0 +1,156 @@
+// s52cfgbench.c: s52.cfg lookup cost - scan the file on each call (old) vs parsed once (S52utils.c), JSON output
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Usage: s52cfgbench [-n nLookup] [-o out.json]
+//
+// Run in the folder of s52.cfg (ex test/). Each label of s52.cfg, plus one
+// missing label (worst case: the scan read the whole file), is looked up in
+// turn n times with the old scan (fopen/fgets/sscanf, copy of the code before
+// the cache) then with S52_utils_getConfig() and S52_utils_getConfigDbl().
+// Result: nsec per lookup and speedup.
+
+
+#include "S52utils.h"       // S52_utils_getConfig()
+
+#include <glib.h>
+#include <glib/gstdio.h>    // g_fopen()
+#include <stdio.h>          // printf(), fgets()
+#include <stdlib.h>         // atoi()
+#include <string.h>         // strcmp()
+
+#define CFG_NAME  "s52.cfg"
+#define CFG_NONE  "S52CFGBENCH_NO_SUCH_LABEL"
+
+static int        _getConfigScan(CCHAR *label, char *vbuf)
+// old S52_utils_getConfig() - scan s52.cfg on each call
+{
+    char lbuf[MAXL];
+    char frmt[MAXL];
+    char str [MAXL];
+
+    FILE *fp = g_fopen(CFG_NAME, "r");
+    if (NULL == fp)
+        return FALSE;
+
+    g_snprintf(frmt, MAXL, "%s%i%s", " %s %", MAXL-1, "[^\n]s");
+
+    while (NULL != fgets(str, MAXL, fp)) {
+        if ('#' != str[0]) {
+            sscanf(str, frmt, lbuf, vbuf);
+            if (0 == g_strcmp0(lbuf, label)) {
+                fclose(fp);
+                return TRUE;
+            }
+        }
+    }
+
+    fclose(fp);
+
+    vbuf[0] = '\0';
+
+    return FALSE;
+}
+
+static GPtrArray *_labels(void)
+// label of s52.cfg + one missing
+{
+    GPtrArray *labels = g_ptr_array_new_with_free_func(g_free);
+
+    FILE *fp = g_fopen(CFG_NAME, "r");
+    if (NULL != fp) {
+        char str[MAXL];
+        char lbuf[MAXL];
+        while (NULL != fgets(str, MAXL, fp)) {
+            if (('#'!=str[0]) && (1==sscanf(str, " %1023s", lbuf)))
+                g_ptr_array_add(labels, g_strdup(lbuf));
+        }
+        fclose(fp);
+    }
+
+    g_ptr_array_add(labels, g_strdup(CFG_NONE));
+
+    return labels;
+}
+
+int main(int argc, char *argv[])
+{
+    int         nLookup = 100000;
+    const char *out     = NULL;
+
+    for (int i=1; i<argc; ++i) {
+        if ((0==strcmp(argv[i], "-n")) && (i+1<argc)) { nLookup = atoi(argv[++i]); continue; }
+        if ((0==strcmp(argv[i], "-o")) && (i+1<argc)) { out     = argv[++i];       continue; }
+        printf("Usage: %s [-n nLookup] [-o out.json]\n", argv[0]);
+        return 1;
+    }
+
+    GPtrArray *labels = _labels();
+    if (1 == labels->len)
+        printf("s52cfgbench: WARNING: no label in ./%s\n", CFG_NAME);
+
+    valueBuf vbuf  = {'\0'};
+    double   sum   = 0.0;   // keep the getter call
+    int      found = 0;
+    GTimer  *timer = g_timer_new();
+
+    // old: scan the file - 1/100 of the lookup (slow), scaled
+    int nScan = MAX(nLookup / 100, (int)labels->len);
+    g_timer_start(timer);
+    for (int i=0; i<nScan; ++i)
+        found += _getConfigScan((CCHAR*)g_ptr_array_index(labels, i % labels->len), vbuf);
+    double nsScan = g_timer_elapsed(timer, NULL) * 1e9 / nScan;
+
+    // parse once (first call) - not in the stat
+    S52_utils_getConfig(CFG_NONE, vbuf);
+
+    g_timer_start(timer);
+    for (int i=0; i<nLookup; ++i)
+        found += S52_utils_getConfig((CCHAR*)g_ptr_array_index(labels, i % labels->len), vbuf);
+    double nsStr = g_timer_elapsed(timer, NULL) * 1e9 / nLookup;
+
+    g_timer_start(timer);
+    for (int i=0; i<nLookup; ++i)
+        sum += S52_utils_getConfigDbl((CCHAR*)g_ptr_array_index(labels, i % labels->len), 0.0);
+    double nsDbl = g_timer_elapsed(timer, NULL) * 1e9 / nLookup;
+
+    FILE *fd = (NULL == out) ? stdout : fopen(out, "w");
+    if (NULL == fd) {
+        printf("s52cfgbench: can't write %s\n", out);
+        return 1;
+    }
+
+    fprintf(fd, "{\n  \"labels\": %u, \"lookups\": %i, \"scan_lookups\": %i, \"found\": %i, \"sum\": %g,\n",
+            labels->len, nLookup, nScan, found, sum);
+    fprintf(fd, "  \"ns_per_lookup\": {\"scan\": %.1f, \"cached_str\": %.1f, \"cached_dbl\": %.1f},\n",
+            nsScan, nsStr, nsDbl);
+    fprintf(fd, "  \"speedup\": %.0f\n}\n", nsScan / nsStr);
+
+    if (stdout != fd)
+        fclose(fd);
+
+    S52_utils_doneConfig();
+    g_timer_destroy(timer);
+    g_ptr_array_free(labels, TRUE);
+
+    return 0;
+}
@@ -0,0 +1,400 @@
+// s52ecbench.c: area triangulation - libtess vs ear clipping (S52EC.c) on ENC
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Usage: s52ecbench [-n loop] [-k sample] cell.000|ENC_ROOT ..
+//
+// Each area of each cell (native ISO 8211 reader) is triangulated with libtess
+// (as _tessd() in _GLU.i: ODD winding, GL_TRIANGLES only) then with S52EC.c,
+// falling back to libtess when the rings are not simple (as _tessd() with
+// S52_USE_EARCUT). Time is for the triangulation only.
+// Check, on the area that S52EC.c triangulate:
+//  - area   : sum of triangle area equal the area of the rings (outer - holes)
+//  - coverage: 'sample' points in the bbox are covered by a triangle if and only if
+//              they are inside the rings (even-odd) - for both triangulator
+
+#include "S57iso8211.h"     // S57_iso8211LoadCell(), ..
+#include "S52EC.h"          // S52_EC_triangulate()
+#include "tesselator.h"     // libtess
+
+#include <glib.h>
+#include <glib/gstdio.h>    // g_file_test()
+#include <stdio.h>          // printf()
+#include <stdlib.h>         // atoi()
+#include <string.h>         // strcmp()
+#include <math.h>           // fabs()
+
+#include "_bench.i"         // _collectCell()
+
+#define AREA_EPS  1e-9      // relative
+
+typedef struct _count {
+    guint  nArea;
+    guint  nSimple;         // triangulated by S52EC.c
+    guint  nVert;
+    guint  nAreaErr;        // area mismatch
+    guint  nCovErr;         // coverage mismatch
+    double tessSec;         // libtess on all area
+    double ecSec;           // S52EC.c + libtess fallback
+} _count;
+
+static _count         _cnt;
+static int            _nSample = 16;
+static S52_EC        *_ec      = NULL;
+static GLUtesselator *_tobj    = NULL;
+static GArray        *_tessTri = NULL;  // double xyz
+static GPtrArray     *_tmpV    = NULL;  // combine vertex
+static GTimer        *_timer   = NULL;
+
+//-----------------------------------------------
+// libtess - same setup as _initGLU()
+
+static void     _tessBeg(GLenum mode)
+{
+    (void)mode;   // GL_TRIANGLES (edge flag)
+}
+
+static void     _tessEnd(void)
+{
+}
+
+static void     _tessEdgeFlag(GLboolean flag)
+{
+    (void)flag;
+}
+
+static void     _tessVertex(GLvoid *data)
+{
+    g_array_append_vals(_tessTri, data, 1);
+}
+
+static void     _tessCombine(double coords[3], void *vertex_data[4], float weight[4], void **dataOut)
+{
+    (void)vertex_data;
+    (void)weight;
+
+    double *p = g_new(double, 3);
+    p[0] = coords[0];
+    p[1] = coords[1];
+    p[2] = coords[2];
+    *dataOut = p;
+
+    g_ptr_array_add(_tmpV, p);
+}
+
+static void     _tessError(GLenum err)
+{
+    printf("libtess error: %i\n", err);
+}
+
+static void     _initTess(void)
+{
+    _tobj = gluNewTess();
+
+    gluTessCallback(_tobj, GLU_TESS_BEGIN,     (_GLUfuncptr*)_tessBeg);
+    gluTessCallback(_tobj, GLU_TESS_END,       (_GLUfuncptr*)_tessEnd);
+    gluTessCallback(_tobj, GLU_TESS_VERTEX,    (_GLUfuncptr*)_tessVertex);
+    gluTessCallback(_tobj, GLU_TESS_COMBINE,   (_GLUfuncptr*)_tessCombine);
+    gluTessCallback(_tobj, GLU_TESS_ERROR,     (_GLUfuncptr*)_tessError);
+    gluTessCallback(_tobj, GLU_TESS_EDGE_FLAG, (_GLUfuncptr*)_tessEdgeFlag);
+
+    gluTessProperty(_tobj, GLU_TESS_BOUNDARY_ONLY, GL_FALSE);
+    gluTessProperty(_tobj, GLU_TESS_WINDING_RULE,  GLU_TESS_WINDING_ODD);
+    gluTessNormal  (_tobj, 0.0, 0.0, 1.0);
+
+    _tessTri = g_array_new(FALSE, FALSE, sizeof(double)*3);
+    _tmpV    = g_ptr_array_new();
+}
+
+static guint    _tess(guint nr, guint *npt, double **ppt, double **tri)
+{
+    for (guint i=0; i<_tmpV->len; ++i)
+        g_free(g_ptr_array_index(_tmpV, i));
+    g_ptr_array_set_size(_tmpV, 0);
+    g_array_set_size(_tessTri, 0);
+
+    gluTessBeginPolygon(_tobj, NULL);
+    for (guint i=0; i<nr; ++i) {
+        double *p = ppt[i];
+        gluTessBeginContour(_tobj);
+        for (guint j=0; j<npt[i]-1; ++j, p+=3) {
+            p[2] = 0.0;
+            gluTessVertex(_tobj, p, p);
+        }
+        gluTessEndContour(_tobj);
+    }
+    gluTessEndPolygon(_tobj);
+
+    *tri = (double *)_tessTri->data;
+
+    return _tessTri->len / 3;
+}
+
+//-----------------------------------------------
+// check
+
+static double   _ringArea(guint npt, double *ppt)
+// relative to the first vertex (large coord - round off)
+{
+    double a  = 0.0;
+    double x0 = ppt[0];
+    double y0 = ppt[1];
+    for (guint i=0; i<npt-1; ++i)
+        a += (ppt[i*3]-x0) * (ppt[i*3+4]-y0) - (ppt[i*3+3]-x0) * (ppt[i*3+1]-y0);
+
+    return fabs(a) / 2.0;
+}
+
+static double   _triArea(guint n, double *t)
+{
+    double a = 0.0;
+    for (guint i=0; i<n; ++i, t+=9)
+        a += fabs((t[3]-t[0])*(t[7]-t[1]) - (t[4]-t[1])*(t[6]-t[0])) / 2.0;
+
+    return a;
+}
+
+static int      _inRings(guint nr, guint *npt, double **ppt, double x, double y)
+{
+    int in = FALSE;
+    for (guint r=0; r<nr; ++r) {
+        double *v = ppt[r];
+        for (guint i=0, j=npt[r]-2; i<npt[r]-1; j=i++) {
+            if (((v[i*3+1] > y) != (v[j*3+1] > y)) &&
+                (x < (v[j*3] - v[i*3]) * (y - v[i*3+1]) / (v[j*3+1] - v[i*3+1]) + v[i*3]))
+                in = !in;
+        }
+    }
+
+    return in;
+}
+
+static int      _inTri(guint n, double *t, double x, double y)
+{
+    for (guint i=0; i<n; ++i, t+=9) {
+        double d1 = (t[3]-t[0])*(y-t[1]) - (t[4]-t[1])*(x-t[0]);
+        double d2 = (t[6]-t[3])*(y-t[4]) - (t[7]-t[4])*(x-t[3]);
+        double d3 = (t[0]-t[6])*(y-t[7]) - (t[1]-t[7])*(x-t[6]);
+        if (((d1>=0.0) && (d2>=0.0) && (d3>=0.0)) || ((d1<=0.0) && (d2<=0.0) && (d3<=0.0)))
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+static int      _checkCover(guint nr, guint *npt, double **ppt, guint n, double *tri)
+// FALSE if a sample point is in the rings but not in a triangle (or the reverse)
+{
+    double minx = INFINITY, miny = INFINITY, maxx = -INFINITY, maxy = -INFINITY;
+    for (guint i=0; i<npt[0]; ++i) {
+        minx = MIN(minx, ppt[0][i*3]); maxx = MAX(maxx, ppt[0][i*3]);
+        miny = MIN(miny, ppt[0][i*3+1]); maxy = MAX(maxy, ppt[0][i*3+1]);
+    }
+
+    // same point every run
+    GRand *rand = g_rand_new_with_seed(52);
+    int    ok   = TRUE;
+    for (int s=0; s<_nSample; ++s) {
+        double x = g_rand_double_range(rand, minx, maxx);
+        double y = g_rand_double_range(rand, miny, maxy);
+        if (_inRings(nr, npt, ppt, x, y) != _inTri(n, tri, x, y)) {
+            ok = FALSE;
+            break;
+        }
+    }
+    g_rand_free(rand);
+
+    return ok;
+}
+
+//-----------------------------------------------
+
+static int      _doGeo(S57_geo *geo)
+{
+    if (NULL == geo)
+        return FALSE;
+
+    if (S57_AREAS_T != S57_getObjtype(geo)) {
+        S57_doneData(geo, NULL);
+        return TRUE;
+    }
+
+    guint    nr  = S57_getRingNbr(geo);
+    guint   *npt = g_new0(guint,    nr);
+    double **ppt = g_new0(double *, nr);
+    for (guint i=0; i<nr; ++i) {
+        if ((FALSE == S57_getGeoData(geo, i, &npt[i], &ppt[i])) || (npt[i] < 4)) {
+            // not a polygon
+            nr = 0;
+            break;
+        }
+        _cnt.nVert += npt[i];
+    }
+
+    if (0 < nr) {
+        double *tri    = NULL;
+        guint   nTess  = 0;
+        guint   nEc    = 0;
+        double *triEc  = NULL;
+
+        ++_cnt.nArea;
+
+        g_timer_start(_timer);
+        nTess = _tess(nr, npt, ppt, &tri);
+        _cnt.tessSec += g_timer_elapsed(_timer, NULL);
+
+        g_timer_start(_timer);
+        nEc = S52_EC_triangulate(_ec, nr, npt, ppt, &triEc);
+        if (0 == nEc)
+            _tess(nr, npt, ppt, &tri);
+        _cnt.ecSec += g_timer_elapsed(_timer, NULL);
+
+        if (0 < nEc) {
+            double a = 0.0;
+            ++_cnt.nSimple;
+
+            a = _ringArea(npt[0], ppt[0]);
+            for (guint i=1; i<nr; ++i)
+                a -= _ringArea(npt[i], ppt[i]);
+
+            if (fabs(_triArea(nEc, triEc) - a) > AREA_EPS * a)
+                ++_cnt.nAreaErr;
+
+            if ((0 < _nSample) && (FALSE == _checkCover(nr, npt, ppt, nEc, triEc)))
+                ++_cnt.nCovErr;
+
+            // libtess on the same (simple) area should agree
+            nTess = _tess(nr, npt, ppt, &tri);
+            if (fabs(_triArea(nTess, tri) - a) > AREA_EPS * a)
+                printf("WARNING: libtess area mismatch: %s\n", (const char *)S57_getName(geo));
+        }
+    }
+
+    g_free(npt);
+    g_free(ppt);
+
+    S57_doneData(geo, NULL);
+
+    return TRUE;
+}
+
+static int      _isoLoadObject(const char *objname, void *feature)
+{
+    return _doGeo(S57_iso8211LoadObject(objname, feature));
+}
+
+static int      _isoLoadLayer(const char *layername, void *layer, S52_loadObject_cb loadObject_cb)
+{
+    (void)loadObject_cb;
+    return S57_iso8211LoadLayer(layername, layer, _isoLoadObject);
+}
+
+// S57iso8211.c link to these when the callback is NULL
+DLL int   STD  S52_loadLayer(const char *layername, void *layer, S52_loadObject_cb loadObject_cb)
+{
+    return _isoLoadLayer(layername, layer, loadObject_cb);
+}
+
+DLL int   STD  S52_loadObject(const char *objname, void *feature)
+{
+    return _isoLoadObject(objname, feature);
+}
+
+int main(int argc, char *argv[])
+{
+    int        nLoop = 1;
+    GPtrArray *cells = g_ptr_array_new();
+
+    for (int i=1; i<argc; ++i) {
+        if ((0==strcmp(argv[i], "-n")) && (i+1<argc)) {
+            nLoop = atoi(argv[++i]);
+            if (nLoop < 1) nLoop = 1;
+            continue;
+        }
+        if ((0==strcmp(argv[i], "-k")) && (i+1<argc)) {
+            _nSample = atoi(argv[++i]);
+            continue;
+        }
+        _collectCell(argv[i], cells);
+    }
+
+    if (0 == cells->len) {
+        printf("Usage: %s [-n loop] [-k sample] cell.000|ENC_ROOT ..\n", argv[0]);
+        return 1;
+    }
+
+    _ec    = S52_EC_new();
+    _timer = g_timer_new();
+    _initTess();
+
+    _count tot;
+    memset(&tot, 0, sizeof(_count));
+
+    printf("%-30s %7s %7s %9s %10s %10s %8s %6s %6s\n",
+           "cell", "nArea", "simple", "nVert", "tess(ms)", "ec(ms)", "speedup", "errA", "errC");
+    for (guint i=0; i<cells->len; ++i) {
+        const char *cell = (const char *)g_ptr_array_index(cells, i);
+        gchar      *base = g_path_get_basename(cell);
+        _count      c;
+
+        memset(&c, 0, sizeof(_count));
+        for (int n=0; n<nLoop; ++n) {
+            memset(&_cnt, 0, sizeof(_count));
+            if (FALSE == S57_iso8211LoadCell(cell, _isoLoadLayer, _isoLoadObject))
+                break;
+            c.tessSec += _cnt.tessSec;
+            c.ecSec   += _cnt.ecSec;
+        }
+        c.nArea    = _cnt.nArea;
+        c.nSimple  = _cnt.nSimple;
+        c.nVert    = _cnt.nVert;
+        c.nAreaErr = _cnt.nAreaErr;
+        c.nCovErr  = _cnt.nCovErr;
+
+        printf("%-30s %7u %7u %9u %10.2f %10.2f %7.2fx %6u %6u\n", base,
+               c.nArea, c.nSimple, c.nVert, c.tessSec*1000.0/nLoop, c.ecSec*1000.0/nLoop,
+               (0.0<c.ecSec) ? c.tessSec/c.ecSec : 0.0, c.nAreaErr, c.nCovErr);
+
+        tot.nArea    += c.nArea;
+        tot.nSimple  += c.nSimple;
+        tot.nVert    += c.nVert;
+        tot.nAreaErr += c.nAreaErr;
+        tot.nCovErr  += c.nCovErr;
+        tot.tessSec  += c.tessSec;
+        tot.ecSec    += c.ecSec;
+
+        g_free(base);
+    }
+
+    printf("%-30s %7u %7u %9u %10.2f %10.2f %7.2fx %6u %6u\n", "TOTAL",
+           tot.nArea, tot.nSimple, tot.nVert, tot.tessSec*1000.0/nLoop, tot.ecSec*1000.0/nLoop,
+           (0.0<tot.ecSec) ? tot.tessSec/tot.ecSec : 0.0, tot.nAreaErr, tot.nCovErr);
+
+    S57_iso8211Done();
+    S52_EC_free(_ec);
+    gluDeleteTess(_tobj);
+    g_timer_destroy(_timer);
+    g_ptr_array_foreach(cells, (GFunc)g_free, NULL);
+    g_ptr_array_free(cells, TRUE);
+
+    return (0==tot.nAreaErr && 0==tot.nCovErr) ? 0 : 1;
+}
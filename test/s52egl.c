@@ -451,7 +451,8 @@ static int      _s52_draw_cb  (gpointer user_data)
 #endif
 
     // draw background - IHO layer 0-8
-    if (TRUE == engine->do_S52draw) {
+    // (or something changed from an other source - socket, DBus, ..)
+    if ((TRUE == engine->do_S52draw) || (TRUE == S52_needDraw())) {
 #ifdef S52_USE_RADAR
         // read 10 lines (or 360 deg == 2048 lines, so 10 lines == 1.7 deg per sector per 0.1 sec)
         _radar_readLog(10);  // seem like nice rotation speed
@@ -471,10 +472,13 @@ static int      _s52_draw_cb  (gpointer user_data)
 #ifdef USE_FAKE_AIS
         _s52_updFakeAIS(engine->state.cLat, engine->state.cLon);
 #endif
-        S52_drawLast();
+        // idle - nothing moved since the last frame
+        if (TRUE == S52_needDrawLast()) {
+            S52_drawLast();
 
-        // test that user can add stuff on top of drawLast()
-        _s52_draw_user(engine);
+            // test that user can add stuff on top of drawLast()
+            _s52_draw_user(engine);
+        }
     }
 
 #if !defined(S52_USE_EGL)
@@ -0,0 +1,664 @@
+// s52replay.c: replay a trace of S52_* call (libS52 build with S52_USE_TRACE) in a headless (EGL pbuffer) context
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Usage: s52replay [-f] [-v] trace.s52tr
+//
+// Record:  $ S52_TRACE=/tmp/run.s52tr ./s52eglx ..
+// Replay:  $ EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./s52replay -f /tmp/run.s52tr
+//
+// -f: as fast as possible, default is the original speed (timestamp of the trace)
+// -v: print each call
+//
+// The pbuffer take the size of the recorded S52_init(). The app EGL callback are
+// replaced by the pbuffer one, the RADAR callback is not replayed.
+// Handle returned by S52_new*() in the trace are mapped to the handle of the replay.
+// At the end: wall time, then count / total msec per call.
+
+
+#include "S52.h"
+#include "S52TR.h"          // S52_TR_*, S52_TR_getName()
+
+#include <EGL/egl.h>
+
+#include <glib.h>
+#include <stdio.h>          // printf(), fopen()
+#include <string.h>         // memcmp()
+
+#include "_bench.i"         // _egl_init(), _egl_done()
+
+typedef struct _stat {
+    guint  count;
+    double msec;
+} _stat;
+
+static _egl        _eglState;
+static int         _eglOK   = FALSE;
+static FILE       *_fd      = NULL;
+static GArray     *_retH    = NULL;     // S52ObjectHandle - value returned by call 'seq' in replay
+static GHashTable *_handle  = NULL;     // trace handle --> replay handle
+#ifdef S52_USE_CTX
+static GPtrArray  *_ctx     = NULL;     // context by trace id ([0] NULL - default context)
+#endif
+static _stat       _stat_[S52_TR_NUM];
+
+static int      _egl_beg(void *EGLctx, const char *tag)
+{
+    _egl *egl = (_egl*)EGLctx;
+    (void)tag;
+
+    if (egl->ctx != eglGetCurrentContext())
+        eglMakeCurrent(egl->dpy, egl->sfc, egl->sfc, egl->ctx);
+
+    return TRUE;
+}
+
+static int      _egl_end(void *EGLctx, const char *tag)
+{
+    (void)EGLctx;
+    (void)tag;
+
+    eglWaitGL();
+
+    return TRUE;
+}
+
+//----------------------------------
+// decode - see S52TR.h
+//----------------------------------
+
+static int      _eof = FALSE;
+
+static guint64  _getVarint(void)
+{
+    guint64 v     = 0;
+    int     shift = 0;
+
+    for (;;) {
+        int c = fgetc(_fd);
+        if (EOF == c) {
+            _eof = TRUE;
+            return 0;
+        }
+        v |= (guint64)(c & 0x7F) << shift;
+        if (0 == (c & 0x80))
+            break;
+        shift += 7;
+    }
+
+    return v;
+}
+
+static int      _getInt(void)
+{
+    guint32 u = (guint32)_getVarint();
+
+    return (int)((u >> 1) ^ (~(u & 1) + 1));   // zigzag
+}
+
+static guint    _getUInt(void)
+{
+    return (guint)_getVarint();
+}
+
+static double   _getDouble(void)
+{
+    guint64 le = 0;
+
+    if (1 != fread(&le, sizeof(le), 1, _fd)) {
+        _eof = TRUE;
+        return 0.0;
+    }
+
+    union { guint64 u; double d; } v;
+    v.u = GUINT64_FROM_LE(le);
+
+    return v.d;
+}
+
+static gchar   *_getStr(void)
+// caller free
+{
+    guint64 len = _getVarint();
+    if (0 == len)
+        return NULL;
+
+    gchar *str = g_malloc0(len);
+    if (0<len-1 && 1!=fread(str, len-1, 1, _fd))
+        _eof = TRUE;
+
+    return str;
+}
+
+static double  *_getArray(guint *n)
+// caller free
+{
+    guint64 len = _getVarint();
+    *n = 0;
+    if (0 == len)
+        return NULL;
+
+    *n = (guint)(len - 1);
+    double *a = g_new0(double, *n + 1);
+    for (guint i=0; i<*n; ++i)
+        a[i] = _getDouble();
+
+    return a;
+}
+
+static S52ObjectHandle _getH(void)
+// handle in the trace --> handle in the replay (same value if not a new handle)
+{
+    guint    objH = _getUInt();
+    gpointer newH = NULL;
+
+    if (TRUE == g_hash_table_lookup_extended(_handle, GUINT_TO_POINTER(objH), NULL, &newH))
+        return GPOINTER_TO_UINT(newH);
+
+    return objH;
+}
+
+//----------------------------------
+// replay
+//----------------------------------
+
+static guint    _call(int id)
+// decode arg of 'id' then call libS52 - return new handle (or 0)
+{
+    guint ret = 0;
+
+    switch (id) {
+        case S52_TR_init: {
+            int w    = _getInt();
+            int h    = _getInt();
+            int mm_w = _getInt();
+            int mm_h = _getInt();
+            if (FALSE == _eglOK) {
+                _eglOK = _egl_init(&_eglState, NULL, w, h);
+                if (FALSE == _eglOK)
+                    return 0;
+            }
+            S52_init(w, h, mm_w, mm_h, NULL);
+            S52_setEGLCallBack(_egl_beg, _egl_end, &_eglState);
+            break;
+        }
+        case S52_TR_done:            S52_done();    break;
+        case S52_TR_version:         S52_version(); break;
+        case S52_TR_setEGLCallBack:  S52_setEGLCallBack(_egl_beg, _egl_end, &_eglState); break;
+        case S52_TR_setRADARCallBack: _getUInt(); break;   // not replayed
+
+        case S52_TR_getMarinerParam: S52_getMarinerParam((S52MarinerParameter)_getInt()); break;
+        case S52_TR_setMarinerParam: {
+            int    paramID = _getInt();
+            double val     = _getDouble();
+            S52_setMarinerParam((S52MarinerParameter)paramID, val);
+            break;
+        }
+        case S52_TR_setTextDisp: {
+            guint prioIdx = _getUInt();
+            guint count   = _getUInt();
+            guint state   = _getUInt();
+            S52_setTextDisp(prioIdx, count, state);
+            break;
+        }
+        case S52_TR_getTextDisp:     S52_getTextDisp(_getUInt()); break;
+        case S52_TR_setRGB: {
+            gchar *colorName = _getStr();
+            guint  R         = _getUInt();
+            guint  G         = _getUInt();
+            guint  B         = _getUInt();
+            S52_setRGB(colorName, (unsigned char)R, (unsigned char)G, (unsigned char)B);
+            g_free(colorName);
+            break;
+        }
+        case S52_TR_getRGB: {
+            gchar        *colorName = _getStr();
+            unsigned char R, G, B;
+            S52_getRGB(colorName, &R, &G, &B);
+            g_free(colorName);
+            break;
+        }
+        case S52_TR_getS57ObjClassSupp: {
+            gchar *className = _getStr();
+            S52_getS57ObjClassSupp(className);
+            g_free(className);
+            break;
+        }
+        case S52_TR_setS57ObjClassSupp: {
+            gchar *className = _getStr();
+            int    value     = _getInt();
+            S52_setS57ObjClassSupp(className, value);
+            g_free(className);
+            break;
+        }
+
+        case S52_TR_loadCell:
+        case S52_TR_doneCell:
+        case S52_TR_loadUpdate:
+        case S52_TR_loadPLib:
+        case S52_TR_getCellExtent:
+        case S52_TR_getS57ClassList: {
+            gchar *str = _getStr();
+            switch (id) {
+                case S52_TR_loadCell:       S52_loadCell      (str, NULL); break;
+                case S52_TR_doneCell:       S52_doneCell      (str);       break;
+                case S52_TR_loadUpdate:     S52_loadUpdate    (str);       break;
+                case S52_TR_loadPLib:       S52_loadPLib      (str);       break;
+                case S52_TR_getS57ClassList:S52_getS57ClassList(str);      break;
+                case S52_TR_getCellExtent: {
+                    double S, W, N, E;
+                    S52_getCellExtent(str, &S, &W, &N, &E);
+                    break;
+                }
+            }
+            g_free(str);
+            break;
+        }
+        case S52_TR_getPLibNameList:     S52_getPLibNameList();     break;
+        case S52_TR_getPalettesNameList: S52_getPalettesNameList(); break;
+        case S52_TR_getCellNameList:     S52_getCellNameList();     break;
+        case S52_TR_getObjList: {
+            gchar *cellName  = _getStr();
+            gchar *className = _getStr();
+            S52_getObjList(cellName, className);
+            g_free(cellName);
+            g_free(className);
+            break;
+        }
+        case S52_TR_getAttList:      S52_getAttList(_getH()); break;
+
+        case S52_TR_draw:            S52_draw();     break;
+        case S52_TR_drawLast:        S52_drawLast(); break;
+        case S52_TR_drawStr: {
+            double x         = _getDouble();
+            double y         = _getDouble();
+            gchar *colorName = _getStr();
+            guint  bsize     = _getUInt();
+            gchar *str       = _getStr();
+            S52_drawStr(x, y, colorName, bsize, str);
+            g_free(colorName);
+            g_free(str);
+            break;
+        }
+        case S52_TR_drawBlit: {
+            double x     = _getDouble();
+            double y     = _getDouble();
+            double z     = _getDouble();
+            double north = _getDouble();
+            S52_drawBlit(x, y, z, north);
+            break;
+        }
+        case S52_TR_pickAt: {
+            double x = _getDouble();
+            double y = _getDouble();
+            S52_pickAt(x, y);
+            break;
+        }
+        case S52_TR_xy2LL:
+        case S52_TR_LL2xy: {
+            double a = _getDouble();
+            double b = _getDouble();
+            if (S52_TR_xy2LL == id)
+                S52_xy2LL(&a, &b);
+            else
+                S52_LL2xy(&a, &b);
+            break;
+        }
+        case S52_TR_xy2LLv:
+        case S52_TR_LL2xyv: {
+            guint   npt    = _getUInt();
+            guint   stride = _getUInt();
+            guint   n      = 0;
+            double *xy     = _getArray(&n);
+            if (S52_TR_xy2LLv == id)
+                S52_xy2LLv(npt, xy, stride);
+            else
+                S52_LL2xyv(npt, xy, stride);
+            g_free(xy);
+            break;
+        }
+        case S52_TR_setView: {
+            double cLat  = _getDouble();
+            double cLon  = _getDouble();
+            double rNM   = _getDouble();
+            double north = _getDouble();
+            S52_setView(cLat, cLon, rNM, north);
+            break;
+        }
+        case S52_TR_getView: {
+            double cLat, cLon, rNM, north;
+            S52_getView(&cLat, &cLon, &rNM, &north);
+            break;
+        }
+        case S52_TR_setViewPort: {
+            int x = _getInt();
+            int y = _getInt();
+            int w = _getInt();
+            int h = _getInt();
+            S52_setViewPort(x, y, w, h);
+            break;
+        }
+        case S52_TR_dumpS57IDPixels: {
+            gchar *toFilename = _getStr();
+            guint  S57ID      = _getH();
+            guint  width      = _getUInt();
+            guint  height     = _getUInt();
+            S52_dumpS57IDPixels(toFilename, S57ID, width, height);
+            g_free(toFilename);
+            break;
+        }
+
+        case S52_TR_newMarObj: {
+            gchar  *plibObjName = _getStr();
+            int     objType     = _getInt();
+            guint   xyznbr      = _getUInt();
+            guint   n           = 0;
+            double *xyz         = _getArray(&n);
+            gchar  *listAttVal  = _getStr();
+            ret = S52_newMarObj(plibObjName, (S52ObjectType)objType, xyznbr, xyz, listAttVal);
+            g_free(plibObjName);
+            g_free(xyz);
+            g_free(listAttVal);
+            break;
+        }
+        case S52_TR_getMarObj:       ret = S52_getMarObj(_getH()); break;
+        case S52_TR_delMarObj:       S52_delMarObj(_getH());       break;
+        case S52_TR_toggleDispMarObj:S52_toggleDispMarObj(_getH());break;
+        case S52_TR_newCLRLIN: {
+            int    catclr   = _getInt();
+            double latBegin = _getDouble();
+            double lonBegin = _getDouble();
+            double latEnd   = _getDouble();
+            double lonEnd   = _getDouble();
+            ret = S52_newCLRLIN(catclr, latBegin, lonBegin, latEnd, lonEnd);
+            break;
+        }
+        case S52_TR_newLEGLIN: {
+            int    select     = _getInt();
+            double plnspd     = _getDouble();
+            double wholinDist = _getDouble();
+            double latBegin   = _getDouble();
+            double lonBegin   = _getDouble();
+            double latEnd     = _getDouble();
+            double lonEnd     = _getDouble();
+            guint  previous   = _getH();
+            ret = S52_newLEGLIN(select, plnspd, wholinDist, latBegin, lonBegin, latEnd, lonEnd, previous);
+            break;
+        }
+        case S52_TR_newOWNSHP: {
+            gchar *label = _getStr();
+            ret = S52_newOWNSHP(label);
+            g_free(label);
+            break;
+        }
+        case S52_TR_setDimension: {
+            guint  objH = _getH();
+            double a    = _getDouble();
+            double b    = _getDouble();
+            double c    = _getDouble();
+            double d    = _getDouble();
+            S52_setDimension(objH, a, b, c, d);
+            break;
+        }
+        case S52_TR_setVector: {
+            guint  objH   = _getH();
+            int    vecstb = _getInt();
+            double course = _getDouble();
+            double speed  = _getDouble();
+            S52_setVector(objH, vecstb, course, speed);
+            break;
+        }
+        case S52_TR_newPASTRK: {
+            int   catpst = _getInt();
+            guint maxpts = _getUInt();
+            ret = S52_newPASTRK(catpst, maxpts);
+            break;
+        }
+        case S52_TR_pushPosition: {
+            guint  objH = _getH();
+            double lat  = _getDouble();
+            double lon  = _getDouble();
+            double data = _getDouble();
+            S52_pushPosition(objH, lat, lon, data);
+            break;
+        }
+        case S52_TR_newVESSEL: {
+            int    vesrce = _getInt();
+            gchar *label  = _getStr();
+            ret = S52_newVESSEL(vesrce, label);
+            g_free(label);
+            break;
+        }
+        case S52_TR_setVESSELlabel: {
+            guint  objH  = _getH();
+            gchar *label = _getStr();
+            S52_setVESSELlabel(objH, label);
+            g_free(label);
+            break;
+        }
+        case S52_TR_setVESSELstate: {
+            guint objH         = _getH();
+            int   vesselSelect = _getInt();
+            int   vestat       = _getInt();
+            int   vesselTurn   = _getInt();
+            S52_setVESSELstate(objH, vesselSelect, vestat, vesselTurn);
+            break;
+        }
+        case S52_TR_newVRMEBL: {
+            int vrm             = _getInt();
+            int ebl             = _getInt();
+            int normalLineStyle = _getInt();
+            int setOrigin       = _getInt();
+            ret = S52_newVRMEBL(vrm, ebl, normalLineStyle, setOrigin);
+            break;
+        }
+        case S52_TR_setVRMEBL: {
+            guint  objH = _getH();
+            double x    = _getDouble();
+            double y    = _getDouble();
+            double brg, rge;
+            S52_setVRMEBL(objH, x, y, &brg, &rge);
+            break;
+        }
+        case S52_TR_newCSYMB:        S52_newCSYMB(); break;
+
+        case S52_TR_getDrawTime: {
+            double app, cull, draw, text, last;
+            S52_getDrawTime(&app, &cull, &draw, &text, &last);
+            break;
+        }
+#ifdef S52_USE_GPU_TIMER
+        case S52_TR_getGPUTime:      S52_getGPUTime(NULL, NULL, NULL, NULL, NULL, NULL, NULL); break;
+#else
+        case S52_TR_getGPUTime:                                                                 break;  // libS52 without S52_USE_GPU_TIMER
+#endif
+        case S52_TR_getStats: {
+            gchar *cellName = _getStr();
+            S52_getStats(cellName);
+            g_free(cellName);
+            break;
+        }
+
+#ifdef S52_USE_CTX
+        // context are traced by id - 1, 2, .. in creation order, 0 the default context
+        case S52_TR_newCtx:          g_ptr_array_add(_ctx, S52_newCtx()); break;
+        case S52_TR_setCtx:
+        case S52_TR_delCtx: {
+            guint ctxID = _getUInt();
+            void *ctx   = (ctxID < _ctx->len) ? g_ptr_array_index(_ctx, ctxID) : NULL;
+            if (S52_TR_setCtx == id)
+                S52_setCtx(ctx);
+            else
+                S52_delCtx(ctx);
+            break;
+        }
+#else
+        case S52_TR_newCtx:                   break;  // libS52 without S52_USE_CTX
+        case S52_TR_setCtx:
+        case S52_TR_delCtx:          _getUInt(); break;
+#endif
+
+        case S52_TR_needDraw:        S52_needDraw();     break;
+        case S52_TR_needDrawLast:    S52_needDrawLast(); break;
+        case S52_TR_setDirtyCallBack:                    break;  // not replayed
+        case S52_TR_setLogLevel:     S52_setLogLevel((S52_logLevel)_getInt()); break;
+
+        // not replayed - S52_setView() / S52_draw() of the render thread are in the trace
+        case S52_TR_setRenderThread: _getInt();  break;
+        case S52_TR_drawAsync:       _getDouble(); _getDouble(); _getDouble(); _getDouble(); break;
+        case S52_TR_drawLastAsync:               break;
+        case S52_TR_waitFence:       _getUInt(); _getInt(); break;
+
+        default:
+            printf("s52replay: unknown call id %i - trace corrupted\n", id);
+            _eof = TRUE;
+    }
+
+    return ret;
+}
+
+static int      _replay(const char *path, int fast, int verbose)
+{
+    _fd = fopen(path, "rb");
+    if (NULL == _fd) {
+        printf("s52replay: can't open %s\n", path);
+        return FALSE;
+    }
+
+    guchar hdr[8];
+    if ((1!=fread(hdr, sizeof(hdr), 1, _fd)) || (0!=memcmp(hdr, S52_TR_MAGIC, 6)) || (S52_TR_VERSION!=hdr[6])) {
+        printf("s52replay: %s not a trace (version %i)\n", path, S52_TR_VERSION);
+        fclose(_fd);
+        return FALSE;
+    }
+
+    _retH   = g_array_new(FALSE, TRUE, sizeof(S52ObjectHandle));
+    _handle = g_hash_table_new(g_direct_hash, g_direct_equal);
+#ifdef S52_USE_CTX
+    _ctx    = g_ptr_array_new();
+    g_ptr_array_add(_ctx, NULL);
+#endif
+
+    GTimer *wall  = g_timer_new();
+    GTimer *timer = g_timer_new();
+    double  tRec  = 0.0;     // sec - time of the record in the trace
+    int     done  = FALSE;   // last call was S52_done()
+
+    for (;;) {
+        int c = fgetc(_fd);
+        if (EOF == c)
+            break;
+
+        tRec += _getVarint() / 1000000.0;
+        if (TRUE == _eof)
+            break;
+
+        if (S52_TR_RET == c) {
+            guint seq  = _getUInt();
+            guint objH = _getUInt();
+            if (seq < _retH->len)
+                g_hash_table_insert(_handle, GUINT_TO_POINTER(objH),
+                                    GUINT_TO_POINTER(g_array_index(_retH, S52ObjectHandle, seq)));
+            continue;
+        }
+
+        // original speed: wait for the time of the record
+        if (FALSE == fast) {
+            double now = g_timer_elapsed(wall, NULL);
+            if (now < tRec)
+                g_usleep((gulong)((tRec - now) * 1000000.0));
+        }
+
+        if (TRUE == verbose)
+            printf("%10.3f %s\n", tRec, S52_TR_getName(c));
+
+        g_timer_start(timer);
+        S52ObjectHandle objH = _call(c);
+        double msec = g_timer_elapsed(timer, NULL) * 1000.0;
+
+        if (TRUE == _eof)
+            break;
+
+        g_array_append_val(_retH, objH);
+
+        if ((S52_TR_NONE<c) && (c<S52_TR_NUM)) {
+            _stat_[c].count += 1;
+            _stat_[c].msec  += msec;
+        }
+
+        done = (S52_TR_done == c);
+    }
+
+    double wallSec = g_timer_elapsed(wall, NULL);
+
+    if (FALSE == done)
+        S52_done();
+
+    printf("s52replay: %s: %u call, trace %.3f sec, replay %.3f sec (%s)\n",
+           path, _retH->len, tRec, wallSec, (TRUE==fast) ? "fast" : "original speed");
+    printf("%-26s %8s %12s %10s\n", "call", "count", "total msec", "avg msec");
+    for (int i=S52_TR_NONE+1; i<S52_TR_NUM; ++i) {
+        if (0 == _stat_[i].count)
+            continue;
+        printf("%-26s %8u %12.3f %10.4f\n", S52_TR_getName(i),
+               _stat_[i].count, _stat_[i].msec, _stat_[i].msec / _stat_[i].count);
+    }
+
+    g_timer_destroy(timer);
+    g_timer_destroy(wall);
+    g_hash_table_destroy(_handle);
+#ifdef S52_USE_CTX
+    g_ptr_array_free(_ctx, TRUE);
+#endif
+    g_array_free(_retH, TRUE);
+    fclose(_fd);
+
+    return TRUE;
+}
+
+int main(int argc, char *argv[])
+{
+    int fast    = FALSE;
+    int verbose = FALSE;
+    int i       = 1;
+
+    for (; i<argc && '-'==argv[i][0]; ++i) {
+        if      (0 == g_strcmp0(argv[i], "-f")) fast    = TRUE;
+        else if (0 == g_strcmp0(argv[i], "-v")) verbose = TRUE;
+        else break;
+    }
+
+    if (i != argc-1) {
+        printf("Usage: s52replay [-f] [-v] trace.s52tr\n");
+        return 1;
+    }
+
+    // don't trace the replay (libS52 build with S52_USE_TRACE)
+    g_unsetenv("S52_TRACE");
+
+    int ret = _replay(argv[i], fast, verbose);
+
+    if (TRUE == _eglOK)
+        _egl_done(&_eglState, TRUE);
+
+    return (TRUE == ret) ? 0 : 1;
+}
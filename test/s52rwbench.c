@@ -0,0 +1,270 @@
+// s52rwbench.c: lock contention benchmark - query threads running while the main thread draw, JSON output
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Usage: s52rwbench [-w width] [-h height] [-t nThread] [-n nFrame] [-o out.json] cell.000|ENC_ROOT ..
+//
+// No window: render in an EGL pbuffer, so it run on Mesa llvmpipe without X:
+//   $ EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./s52rwbench -t 4 ENC_ROOT
+//
+// The main thread pan the view and draw (S52_draw() + S52_drawLast()) n frames,
+// meanwhile t threads loop on read-only query (S52_getMarinerParam(), S52_xy2LL(),
+// S52_LL2xy(), S52_getView(), S52_getRGB()). First the frames are drawn alone (t=0)
+// to get the baseline, then with the query threads. Result: frame time, query
+// latency (min / median / p99 / max in msec), frames/sec and queries/sec.
+// With a reader-writer lock in libS52 the query latency stay well below a frame time.
+
+
+#include "S52.h"
+
+#include <EGL/egl.h>
+
+#include <glib.h>
+#include <stdio.h>          // printf(), fopen()
+#include <stdlib.h>         // atoi()
+#include <string.h>         // strcmp()
+#include <math.h>           // cos()
+
+#include "_bench.i"         // _collectCell(), _printStat(), _egl_init(), _egl_done()
+
+// query done by each thread, in turn
+enum { _MARPARAM, _XY2LL, _LL2XY, _VIEW, _RGB, _N_QUERY };
+static const char *_queryName[_N_QUERY] = {"getMarinerParam", "xy2LL", "LL2xy", "getView", "getRGB"};
+
+typedef struct _query {
+    GThread *thread;
+    GArray  *t[_N_QUERY];   // double - query time (msec)
+    guint    n;             // all query
+} _query;
+
+static _egl    _eglState;
+static int     _w       = 1280;
+static int     _h       = 1024;
+static gint    _running = 0;    // atomic - query threads loop while 1
+
+static int      _egl_beg(void *EGLctx, const char *tag)
+{
+    _egl *egl = (_egl*)EGLctx;
+    (void)tag;
+
+    if (egl->ctx != eglGetCurrentContext())
+        eglMakeCurrent(egl->dpy, egl->sfc, egl->sfc, egl->ctx);
+
+    return TRUE;
+}
+
+static int      _egl_end(void *EGLctx, const char *tag)
+// no swap in a pbuffer - wait for the GPU so the frame time is real
+{
+    (void)EGLctx;
+    (void)tag;
+
+    eglWaitGL();
+
+    return TRUE;
+}
+
+static gpointer _queryThread(gpointer data)
+{
+    _query *q     = (_query*)data;
+    GTimer *timer = g_timer_new();
+    GRand  *rnd   = g_rand_new();
+    int     i     = 0;
+
+    while (1 == g_atomic_int_get(&_running)) {
+        double        x = g_rand_double_range(rnd, 0.0, _w);
+        double        y = g_rand_double_range(rnd, 0.0, _h);
+        double        cLat, cLon, rNM, north;
+        unsigned char R, G, B;
+
+        g_timer_start(timer);
+        switch (i) {
+            case _MARPARAM: S52_getMarinerParam(S52_MAR_SAFETY_CONTOUR);     break;
+            case _XY2LL:    S52_xy2LL(&x, &y);                               break;
+            case _LL2XY:    S52_getView(&cLat, &cLon, &rNM, &north);
+                            S52_LL2xy(&cLon, &cLat);                         break;
+            case _VIEW:     S52_getView(&cLat, &cLon, &rNM, &north);         break;
+            case _RGB:      S52_getRGB("DEPDW", &R, &G, &B);                 break;
+        }
+        double t = g_timer_elapsed(timer, NULL) * 1000.0;
+
+        g_array_append_val(q->t[i], t);
+        ++q->n;
+
+        i = (i + 1) % _N_QUERY;
+    }
+
+    g_rand_free(rnd);
+    g_timer_destroy(timer);
+
+    return NULL;
+}
+
+static double   _drawFrames(int nFrame, GArray *frame)
+// pan east and back - return elapsed sec
+{
+    double  cLat, cLon, rNM, north;
+    GTimer *all   = g_timer_new();
+    GTimer *timer = g_timer_new();
+
+    S52_getView(&cLat, &cLon, &rNM, &north);
+
+    for (int i=0; i<nFrame; ++i) {
+        double dx = ((i/50) % 2) ? -rNM/50.0 : rNM/50.0;
+        cLon += dx / (60.0 * cos(cLat * G_PI / 180.0));
+        S52_setView(cLat, cLon, rNM, north);
+
+        g_timer_start(timer);
+        S52_draw();
+        S52_drawLast();
+        double t = g_timer_elapsed(timer, NULL) * 1000.0;
+
+        g_array_append_val(frame, t);
+    }
+
+    double sec = g_timer_elapsed(all, NULL);
+    g_timer_destroy(timer);
+    g_timer_destroy(all);
+
+    return sec;
+}
+
+int main(int argc, char *argv[])
+{
+    int         nThread = 4;
+    int         nFrame  = 200;
+    const char *out     = NULL;
+    GPtrArray  *cells   = g_ptr_array_new();
+
+    for (int i=1; i<argc; ++i) {
+        if ((0==strcmp(argv[i], "-w")) && (i+1<argc)) { _w      = atoi(argv[++i]); continue; }
+        if ((0==strcmp(argv[i], "-h")) && (i+1<argc)) { _h      = atoi(argv[++i]); continue; }
+        if ((0==strcmp(argv[i], "-t")) && (i+1<argc)) { nThread = atoi(argv[++i]); continue; }
+        if ((0==strcmp(argv[i], "-n")) && (i+1<argc)) { nFrame  = atoi(argv[++i]); continue; }
+        if ((0==strcmp(argv[i], "-o")) && (i+1<argc)) { out     = argv[++i];       continue; }
+        if ('-' == argv[i][0]) {
+            printf("Usage: %s [-w width] [-h height] [-t nThread] [-n nFrame] [-o out.json] cell.000|ENC_ROOT ..\n", argv[0]);
+            return 1;
+        }
+        _collectCell(argv[i], cells);
+    }
+
+    // GL / libS52
+    if (FALSE == _egl_init(&_eglState, NULL, _w, _h))
+        return 1;
+
+    // ~ 96 DPI
+    if (FALSE == S52_init(_w, _h, (int)(_w * 25.4 / 96.0), (int)(_h * 25.4 / 96.0), NULL)) {
+        printf("s52rwbench: S52_init() failed\n");
+        return 1;
+    }
+    S52_setEGLCallBack(_egl_beg, _egl_end, &_eglState);
+
+    if (0 == cells->len) {
+        S52_loadCell(NULL, NULL);
+    } else {
+        for (guint i=0; i<cells->len; ++i)
+            S52_loadCell((const char *)g_ptr_array_index(cells, i), NULL);
+    }
+
+    // start on the extent of all cells
+    double S, W, N, E;
+    if (FALSE == S52_getCellExtent(NULL, &S, &W, &N, &E)) {
+        printf("s52rwbench: no cell loaded\n");
+        return 1;
+    }
+    double cLat = (S + N) / 2.0;
+    double cLon = (W + E) / 2.0;
+    double rNM  = (N - S) * 60.0 / 2.0;
+    S52_setView(cLat, cLon, rNM, 0.0);
+
+    // first frame set the projection, build VBO, .. - not in the stat
+    S52_draw();
+    S52_drawLast();
+
+    // baseline: draw alone
+    GArray *frame0 = g_array_new(FALSE, FALSE, sizeof(double));
+    double  sec0   = _drawFrames(nFrame, frame0);
+
+    // contention: draw with the query threads
+    _query *query  = g_new0(_query, MAX(nThread, 1));
+    g_atomic_int_set(&_running, 1);
+    for (int i=0; i<nThread; ++i) {
+        for (int j=0; j<_N_QUERY; ++j)
+            query[i].t[j] = g_array_new(FALSE, FALSE, sizeof(double));
+        query[i].thread = g_thread_new("s52rwbench", _queryThread, &query[i]);
+    }
+
+    S52_setView(cLat, cLon, rNM, 0.0);
+    GArray *frame1 = g_array_new(FALSE, FALSE, sizeof(double));
+    double  sec1   = _drawFrames(nFrame, frame1);
+
+    g_atomic_int_set(&_running, 0);
+    guint nQuery = 0;
+    for (int i=0; i<nThread; ++i) {
+        g_thread_join(query[i].thread);
+        nQuery += query[i].n;
+    }
+
+    // result
+    FILE *fd = (NULL == out) ? stdout : fopen(out, "w");
+    if (NULL == fd) {
+        printf("s52rwbench: can't write %s\n", out);
+        return 1;
+    }
+
+    fprintf(fd, "{\n  \"width\": %i, \"height\": %i, \"cells\": %u, \"threads\": %i, \"frames\": %i,\n",
+            _w, _h, cells->len, nThread, nFrame);
+    fprintf(fd, "  \"fps_alone\": %.1f, \"fps_contended\": %.1f, \"queries_per_sec\": %.0f,\n",
+            nFrame / sec0, nFrame / sec1, nQuery / sec1);
+    fprintf(fd, "  \"frame\": {\n");
+    _printStat(fd, "alone",     frame0, ",");
+    _printStat(fd, "contended", frame1, "");
+    fprintf(fd, "  },\n  \"query\": {\n");
+    for (int j=0; j<_N_QUERY; ++j) {
+        // all threads together
+        GArray *t = g_array_new(FALSE, FALSE, sizeof(double));
+        for (int i=0; i<nThread; ++i)
+            g_array_append_vals(t, query[i].t[j]->data, query[i].t[j]->len);
+        _printStat(fd, _queryName[j], t, (j+1<_N_QUERY) ? "," : "");
+        g_array_free(t, TRUE);
+    }
+    fprintf(fd, "  }\n}\n");
+
+    if (stdout != fd)
+        fclose(fd);
+
+    // cleanup
+    S52_done();
+    _egl_done(&_eglState, TRUE);
+
+    for (int i=0; i<nThread; ++i)
+        for (int j=0; j<_N_QUERY; ++j)
+            g_array_free(query[i].t[j], TRUE);
+    g_free(query);
+    g_array_free(frame0, TRUE);
+    g_array_free(frame1, TRUE);
+    g_ptr_array_foreach(cells, (GFunc)g_free, NULL);
+    g_ptr_array_free(cells, TRUE);
+
+    return 0;
+}
@@ -0,0 +1,602 @@
+// s52swbench.c: S52SW.c software rasteriser vs GLES2 (llvmpipe) - same primitive, time and pixel diff, JSON output
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Usage: s52swbench [-w width] [-h height] [-n nFrame] [-t nThread] [-a nArea] [-l nLine] [-g nGlyph] [-o out.json]
+//        s52swbench [-w width] [-h height] [-n nFrame] [-d dump.fb] [-r ref.fb] [-o out.json] -c cell.000|ENC_ROOT ..
+//
+// A synthetic chart frame, the mix S52GL.c send: area (AC, tessellated in fan
+// and strip, some transparent), pattern (AP, alpha mask in world grid), line
+// (LS/LC, width 1-3) and glyph quad (TX/TE, alpha atlas). The frame is drawn
+// n times by GLES2 in an EGL pbuffer (Mesa llvmpipe when no GPU) then by S52SW,
+// result: msec per frame (median) and pixel diff of the two FB.
+//   $ EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./s52swbench
+// Note: llvmpipe thread: env LP_NUM_THREADS (default: one per core).
+//
+// Cell mode (-c, build with -DS52SWBENCH_CELL and libS52): real cell drawn by
+// S52_draw() then FB read back - the path of libS52 (GL or S52_USE_SW, _GLSW.i)
+// is the one it was build with. -d dump the FB, -r diff the FB against a dump.
+// So, same cell / size / view:
+//   $ ./s52swbench -c ENC_ROOT -d gl.fb      (libS52 GLES2)
+//   $ ./s52swbench -c ENC_ROOT -r gl.fb      (libS52 GLES2 + S52_USE_SW)
+
+
+#include "S52SW.h"
+#ifdef S52SWBENCH_CELL
+#include "S52.h"
+#endif
+
+#include <EGL/egl.h>
+#include <GLES2/gl2.h>
+
+#include <glib.h>
+#include <stdio.h>          // printf()
+#include <stdlib.h>         // atoi()
+#include <string.h>         // strcmp()
+#include <math.h>           // cos()
+
+#include "_bench.i"         // _collectCell(), _median(), _egl_init(), _egl_done()
+
+#define ATLAS_SZ  256
+
+typedef struct _prim {
+    int      mode;          // S52_SW_* == GL_*
+    int      first;         // in _vert
+    int      count;
+    guchar   rgba[4];
+    float    width;         // line
+    int      tex;           // 0: none, 1: pattern, 2: atlas
+} _prim;
+
+static int     _w = 800;
+static int     _h = 600;
+static GArray *_vert = NULL;    // x, y, u, v - window pixel
+static GArray *_prims = NULL;   // _prim
+static guchar  _atlas[ATLAS_SZ * ATLAS_SZ];
+static guchar  _patt [32 * 32];
+
+static void     _addVert(float x, float y, float u, float v)
+{
+    float p[4] = {x, y, u, v};
+    g_array_append_vals(_vert, p, 4);
+}
+
+static void     _addPrim(int mode, int first, int count, guchar a, float width, int tex, GRand *r)
+{
+    _prim p = {mode, first, count, {0,0,0,a}, width, tex};
+
+    p.rgba[0] = (guchar)g_rand_int_range(r, 0, 256);
+    p.rgba[1] = (guchar)g_rand_int_range(r, 0, 256);
+    p.rgba[2] = (guchar)g_rand_int_range(r, 0, 256);
+
+    g_array_append_val(_prims, p);
+}
+
+static void     _scene(int nArea, int nLine, int nGlyph)
+{
+    GRand *r = g_rand_new_with_seed(52);
+
+    _vert = g_array_new(FALSE, FALSE, sizeof(float));
+    _prims = g_array_new(FALSE, FALSE, sizeof(_prim));
+
+    // glyph atlas: soft disc - pattern: 32x32 cross
+    for (int y=0; y<ATLAS_SZ; ++y)
+        for (int x=0; x<ATLAS_SZ; ++x) {
+            float dx = (x % 16) - 7.5f, dy = (y % 16) - 7.5f;
+            float d  = sqrtf(dx*dx + dy*dy);
+            _atlas[y*ATLAS_SZ + x] = (guchar)((d < 6.0f) ? 255 : (d < 7.0f) ? 128 : 0);
+        }
+    for (int y=0; y<32; ++y)
+        for (int x=0; x<32; ++x)
+            _patt[y*32 + x] = (guchar)(((x>=14 && x<18) || (y>=14 && y<18)) ? 255 : 0);
+
+    // background - full screen fan
+    int first = _vert->len / 4;
+    _addVert(0,  0,  0, 0);
+    _addVert(_w, 0,  0, 0);
+    _addVert(_w, _h, 0, 0);
+    _addVert(0,  _h, 0, 0);
+    _addPrim(GL_TRIANGLE_FAN, first, 4, 255, 1.0, 0, r);
+
+    // area: star polygon as fan, band as strip - CCW
+    for (int i=0; i<nArea; ++i) {
+        float cx = g_rand_double_range(r, -50, _w + 50);
+        float cy = g_rand_double_range(r, -50, _h + 50);
+        float rd = g_rand_double_range(r, 10, 120);
+        int   n  = g_rand_int_range(r, 6, 40);
+        guchar a = (0 == i % 4) ? 128 : 255;
+
+        first = _vert->len / 4;
+        _addVert(cx, cy, 0, 0);
+        for (int k=0; k<=n; ++k) {
+            float ang = (float)(2.0 * G_PI * k / n);
+            float rr  = rd * (0.6f + 0.4f * (k & 1));
+            _addVert(cx + rr*cosf(ang), cy + rr*sinf(ang), 0, 0);
+        }
+        _addPrim(GL_TRIANGLE_FAN, first, n+2, a, 1.0, 0, r);
+
+        // every 8 area: same with pattern (world grid = window here)
+        if (0 == i % 8) {
+            first = _vert->len / 4;
+            _addVert(cx, cy, cx/32.0f, cy/32.0f);
+            for (int k=0; k<=n; ++k) {
+                float ang = (float)(2.0 * G_PI * k / n);
+                float x   = cx + rd*cosf(ang);
+                float y   = cy + rd*sinf(ang);
+                _addVert(x, y, x/32.0f, y/32.0f);
+            }
+            _addPrim(GL_TRIANGLE_FAN, first, n+2, 255, 1.0, 1, r);
+        }
+
+        if (0 == i % 3) {
+            first = _vert->len / 4;
+            for (int k=0; k<20; ++k) {
+                float x = cx + k * 6.0f;
+                _addVert(x, cy + ((k & 1) ? 8.0f : 0.0f), 0, 0);
+            }
+            _addPrim(GL_TRIANGLE_STRIP, first, 20, a, 1.0, 0, r);
+        }
+    }
+
+    // line: random walk strip
+    for (int i=0; i<nLine; ++i) {
+        float x = g_rand_double_range(r, 0, _w);
+        float y = g_rand_double_range(r, 0, _h);
+        int   n = g_rand_int_range(r, 2, 60);
+
+        first = _vert->len / 4;
+        for (int k=0; k<n; ++k) {
+            _addVert(x, y, 0, 0);
+            x += g_rand_double_range(r, -15, 15);
+            y += g_rand_double_range(r, -15, 15);
+        }
+        _addPrim(GL_LINE_STRIP, first, n, 255, (float)g_rand_int_range(r, 1, 4), 0, r);
+    }
+
+    // glyph: 1:1 texel quad (as freetype-gl at _pushScaletoPixel())
+    for (int i=0; i<nGlyph; ++i) {
+        float x  = floorf(g_rand_double_range(r, 0, _w - 16));
+        float y  = floorf(g_rand_double_range(r, 0, _h - 16));
+        float s0 = 16.0f * g_rand_int_range(r, 0, ATLAS_SZ/16) / ATLAS_SZ;
+        float t0 = 16.0f * g_rand_int_range(r, 0, ATLAS_SZ/16) / ATLAS_SZ;
+        float d  = 16.0f / ATLAS_SZ;
+
+        first = _vert->len / 4;
+        _addVert(x,    y,    s0,   t0);
+        _addVert(x+16, y,    s0+d, t0);
+        _addVert(x+16, y+16, s0+d, t0+d);
+        _addVert(x,    y,    s0,   t0);
+        _addVert(x+16, y+16, s0+d, t0+d);
+        _addVert(x,    y+16, s0,   t0+d);
+        _addPrim(GL_TRIANGLES, first, 6, 255, 1.0, 2, r);
+    }
+
+    g_rand_free(r);
+}
+
+//---- GLES2 ----------------------------------------------------------
+
+static GLuint   _prog = 0;
+static GLint    _uColor, _uTexOn, _aPos, _aUV;
+static GLuint   _tex[3];
+
+static GLuint   _shader(GLenum type, const char *src)
+{
+    GLuint s  = glCreateShader(type);
+    GLint  ok = 0;
+
+    glShaderSource(s, 1, &src, NULL);
+    glCompileShader(s);
+    glGetShaderiv(s, GL_COMPILE_STATUS, &ok);
+    if (GL_FALSE == ok) {
+        char log[1024];
+        glGetShaderInfoLog(s, sizeof(log), NULL, log);
+        printf("s52swbench: shader: %s\n", log);
+    }
+
+    return s;
+}
+
+static int      _glInit(void)
+{
+    // same fragment as _GL2.i: text / pattern take texel alpha, color RGB
+    static const char vs[] =
+        "attribute vec2 aPos;                                                   \n"
+        "attribute vec2 aUV;                                                    \n"
+        "uniform   vec2 uWH;                                                    \n"
+        "varying   vec2 v_uv;                                                   \n"
+        "void main() {                                                          \n"
+        "    v_uv        = aUV;                                                 \n"
+        "    gl_Position = vec4(aPos / uWH * 2.0 - 1.0, 0.0, 1.0);              \n"
+        "}                                                                      \n";
+    static const char fs[] =
+        "precision mediump float;                                               \n"
+        "uniform sampler2D uTex;                                                \n"
+        "uniform vec4      uColor;                                              \n"
+        "uniform float     uTexOn;                                              \n"
+        "varying vec2      v_uv;                                                \n"
+        "void main() {                                                          \n"
+        "    gl_FragColor = uColor;                                             \n"
+        "    if (1.0 == uTexOn)                                                 \n"
+        "        gl_FragColor.a = texture2D(uTex, v_uv).a;                      \n"
+        "}                                                                      \n";
+
+    _prog = glCreateProgram();
+    glAttachShader(_prog, _shader(GL_VERTEX_SHADER,   vs));
+    glAttachShader(_prog, _shader(GL_FRAGMENT_SHADER, fs));
+    glLinkProgram(_prog);
+    glUseProgram(_prog);
+
+    _uColor = glGetUniformLocation(_prog, "uColor");
+    _uTexOn = glGetUniformLocation(_prog, "uTexOn");
+    _aPos   = glGetAttribLocation (_prog, "aPos");
+    _aUV    = glGetAttribLocation (_prog, "aUV");
+    glUniform2f(glGetUniformLocation(_prog, "uWH"), (float)_w, (float)_h);
+    glUniform1i(glGetUniformLocation(_prog, "uTex"), 0);
+
+    glGenTextures(3, _tex);
+    glBindTexture(GL_TEXTURE_2D, _tex[1]);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, 32, 32, 0, GL_ALPHA, GL_UNSIGNED_BYTE, _patt);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, _tex[2]);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, ATLAS_SZ, ATLAS_SZ, 0, GL_ALPHA, GL_UNSIGNED_BYTE, _atlas);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    glViewport(0, 0, _w, _h);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_CULL_FACE);
+    glDisable(GL_DITHER);
+
+    return (GL_NO_ERROR == glGetError());
+}
+
+static void     _glFrame(guchar *pixels)
+{
+    const float *v = (const float *)_vert->data;
+
+    glEnableVertexAttribArray(_aPos);
+    glEnableVertexAttribArray(_aUV);
+    glVertexAttribPointer(_aPos, 2, GL_FLOAT, GL_FALSE, 4*sizeof(float), v);
+    glVertexAttribPointer(_aUV,  2, GL_FLOAT, GL_FALSE, 4*sizeof(float), v+2);
+
+    for (guint i=0; i<_prims->len; ++i) {
+        _prim *p = &g_array_index(_prims, _prim, i);
+
+        glUniform4f(_uColor, p->rgba[0]/255.0f, p->rgba[1]/255.0f, p->rgba[2]/255.0f, p->rgba[3]/255.0f);
+        glUniform1f(_uTexOn, (0 == p->tex) ? 0.0f : 1.0f);
+        glBindTexture(GL_TEXTURE_2D, _tex[p->tex]);
+        glLineWidth(p->width);
+        glDrawArrays(p->mode, p->first, p->count);
+    }
+
+    // readback - as the tile / dump path
+    glReadPixels(0, 0, _w, _h, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+}
+
+//---- SW -------------------------------------------------------------
+
+static void     _swFrame(guchar *pixels)
+{
+    const float *v = (const float *)_vert->data;
+    S52_SW_tex   tex[3] = {
+        {NULL,   0,        0,        0,        0},
+        {_patt,  32,       32,       32,       1},
+        {_atlas, ATLAS_SZ, ATLAS_SZ, ATLAS_SZ, 1}
+    };
+
+    S52_SW_begin();
+    for (guint i=0; i<_prims->len; ++i) {
+        _prim *p = &g_array_index(_prims, _prim, i);
+
+        S52_SW_setColor(p->rgba[0], p->rgba[1], p->rgba[2], p->rgba[3]);
+        S52_SW_setTex((0 == p->tex) ? NULL : &tex[p->tex]);
+        S52_SW_setLineWidth(p->width);
+        S52_SW_draw(p->mode, v + p->first*4, v + p->first*4 + 2, 4, p->count);
+    }
+    S52_SW_end();
+
+    memcpy(pixels, S52_SW_getPixels(NULL, NULL), (gsize)_w * _h * 4);
+}
+
+static void     _printDiff(FILE *fd, const guchar *a, const guchar *b)
+// "diff": {} of the two FB (RGB)
+{
+    gsize   sz    = (gsize)_w * _h * 4;
+    guint64 sum   = 0;
+    guint   nDiff = 0;
+    guint   nBad  = 0;
+    int     maxD  = 0;
+    for (gsize p=0; p<sz; p+=4) {
+        int d = 0;
+        for (int c=0; c<3; ++c)
+            d = MAX(d, abs((int)a[p+c] - (int)b[p+c]));
+        sum  += d;
+        maxD  = MAX(maxD, d);
+        nDiff += (0 < d);
+        nBad  += (32 < d);
+    }
+    guint nPix = _w * _h;
+
+    fprintf(fd, "  \"diff\": {\"mean\": %.3f, \"max\": %i, \"pct_pixels\": %.3f, \"pct_pixels_over_32\": %.3f}",
+            (double)sum / nPix, maxD, 100.0 * nDiff / nPix, 100.0 * nBad / nPix);
+}
+
+#ifdef S52SWBENCH_CELL
+//---- cell (libS52) --------------------------------------------------
+
+#define FB_MAGIC "s52swbench FB %i %i\n"
+
+static int      _dumpFB(const char *path, const guchar *pixels)
+// raw RGBA, bottom-up (glReadPixels), after a one line header
+{
+    gchar  *hdr  = g_strdup_printf(FB_MAGIC, _w, _h);
+    gsize   lHdr = strlen(hdr);
+    gsize   sz   = (gsize)_w * _h * 4;
+    gchar  *buf  = g_malloc(lHdr + sz);
+
+    memcpy(buf,        hdr,    lHdr);
+    memcpy(buf + lHdr, pixels, sz);
+    int ret = g_file_set_contents(path, buf, lHdr + sz, NULL);
+
+    g_free(buf);
+    g_free(hdr);
+
+    return ret;
+}
+
+static guchar  *_loadFB(const char *path)
+// NULL: no file or not the same size
+{
+    gchar *buf = NULL;
+    gsize  len = 0;
+    if (FALSE == g_file_get_contents(path, &buf, &len, NULL))
+        return NULL;
+
+    gchar  *hdr  = g_strdup_printf(FB_MAGIC, _w, _h);
+    gsize   lHdr = strlen(hdr);
+    gsize   sz   = (gsize)_w * _h * 4;
+    guchar *pix  = NULL;
+    if ((lHdr+sz == len) && (0 == strncmp(buf, hdr, lHdr)))
+        pix = (guchar*)g_memdup(buf + lHdr, sz);
+
+    g_free(hdr);
+    g_free(buf);
+
+    return pix;
+}
+
+static int      _cellFrame(guchar *pixels)
+// S52_draw() then readback - SW: the FB uploaded by S52_GL_end()
+{
+    if (FALSE == S52_draw())
+        return FALSE;
+
+    glReadPixels(0, 0, _w, _h, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+    return TRUE;
+}
+
+static int      _cellBench(GPtrArray *cells, int nFrame, const char *dump, const char *ref, FILE *fd)
+{
+    if (FALSE == S52_init(_w, _h, (int)(_w * 25.4 / 96.0), (int)(_h * 25.4 / 96.0), NULL)) {
+        printf("s52swbench: S52_init() failed\n");
+        return FALSE;
+    }
+
+    for (guint i=0; i<cells->len; ++i)
+        S52_loadCell((const char *)g_ptr_array_index(cells, i), NULL);
+
+    S52_setMarinerParam(S52_MAR_DISP_CATEGORY,   S52_MAR_DISP_CATEGORY_SELECT);
+    S52_setMarinerParam(S52_MAR_DISP_LAYER_LAST, S52_MAR_DISP_LAYER_LAST_SELECT);
+
+    double S, W, N, E;
+    if (FALSE == S52_getCellExtent(NULL, &S, &W, &N, &E)) {
+        printf("s52swbench: no cell loaded\n");
+        S52_done();
+        return FALSE;
+    }
+    S52_setView((S + N) / 2.0, (W + E) / 2.0, (N - S) * 60.0 / 2.0, 0.0);
+
+    int     isSW   = (NULL != strstr(S52_version(), "S52_USE_SW"));
+    gsize   sz     = (gsize)_w * _h * 4;
+    guchar *pixels = g_new0(guchar, sz);
+    double *t      = g_new0(double, nFrame);
+    guchar *refPix = NULL;
+    GTimer *timer  = g_timer_new();
+    int     ret    = TRUE;
+
+    // warm up (symbol, VBO, first touch)
+    if (FALSE == _cellFrame(pixels)) {
+        printf("s52swbench: S52_draw() failed\n");
+        ret = FALSE;
+        goto exit;
+    }
+
+    for (int i=0; i<nFrame; ++i) {
+        g_timer_start(timer);
+        _cellFrame(pixels);
+        t[i] = g_timer_elapsed(timer, NULL) * 1000.0;
+    }
+
+    if ((NULL!=dump) && (FALSE==_dumpFB(dump, pixels))) {
+        printf("s52swbench: can't write %s\n", dump);
+        ret = FALSE;
+        goto exit;
+    }
+
+    if ((NULL!=ref) && (NULL==(refPix = _loadFB(ref)))) {
+        printf("s52swbench: can't read %s (or not %ix%i)\n", ref, _w, _h);
+        ret = FALSE;
+        goto exit;
+    }
+
+    fprintf(fd, "{\n  \"width\": %i, \"height\": %i, \"frames\": %i, \"cells\": %u, \"path\": \"%s\", \"gl_renderer\": \"%s\",\n",
+            _w, _h, nFrame, cells->len, (TRUE==isSW) ? "sw" : "gl", (const char *)glGetString(GL_RENDERER));
+    fprintf(fd, "  \"ms_per_frame\": {\"draw\": %.2f}", _median(t, nFrame));
+    if (NULL != refPix) {
+        fprintf(fd, ",\n  \"ref\": \"%s\",\n", ref);
+        _printDiff(fd, refPix, pixels);
+        g_free(refPix);
+    }
+    fprintf(fd, "\n}\n");
+
+exit:
+    S52_done();
+
+    g_timer_destroy(timer);
+    g_free(pixels);
+    g_free(t);
+
+    return ret;
+}
+#endif  // S52SWBENCH_CELL
+
+int main(int argc, char *argv[])
+{
+    int         nFrame  = 20;
+    int         nThread = 0;
+    int         nArea   = 2000;
+    int         nLine   = 2000;
+    int         nGlyph  = 3000;
+    const char *out     = NULL;
+#ifdef S52SWBENCH_CELL
+    const char *dump    = NULL;
+    const char *ref     = NULL;
+    GPtrArray  *cells   = g_ptr_array_new_with_free_func(g_free);
+#endif
+
+    for (int i=1; i<argc; ++i) {
+        if ((0==strcmp(argv[i], "-w")) && (i+1<argc)) { _w      = atoi(argv[++i]); continue; }
+        if ((0==strcmp(argv[i], "-h")) && (i+1<argc)) { _h      = atoi(argv[++i]); continue; }
+        if ((0==strcmp(argv[i], "-n")) && (i+1<argc)) { nFrame  = atoi(argv[++i]); continue; }
+        if ((0==strcmp(argv[i], "-t")) && (i+1<argc)) { nThread = atoi(argv[++i]); continue; }
+        if ((0==strcmp(argv[i], "-a")) && (i+1<argc)) { nArea   = atoi(argv[++i]); continue; }
+        if ((0==strcmp(argv[i], "-l")) && (i+1<argc)) { nLine   = atoi(argv[++i]); continue; }
+        if ((0==strcmp(argv[i], "-g")) && (i+1<argc)) { nGlyph  = atoi(argv[++i]); continue; }
+        if ((0==strcmp(argv[i], "-o")) && (i+1<argc)) { out     = argv[++i];       continue; }
+#ifdef S52SWBENCH_CELL
+        if ((0==strcmp(argv[i], "-d")) && (i+1<argc)) { dump    = argv[++i];       continue; }
+        if ((0==strcmp(argv[i], "-r")) && (i+1<argc)) { ref     = argv[++i];       continue; }
+        if ((0==strcmp(argv[i], "-c")) && (i+1<argc)) { _collectCell(argv[++i], cells); continue; }
+#endif
+        printf("Usage: %s [-w width] [-h height] [-n nFrame] [-t nThread] [-a nArea] [-l nLine] [-g nGlyph] [-o out.json]\n", argv[0]);
+#ifdef S52SWBENCH_CELL
+        printf("       %s [-w width] [-h height] [-n nFrame] [-d dump.fb] [-r ref.fb] [-o out.json] -c cell.000|ENC_ROOT ..\n", argv[0]);
+#endif
+        return 1;
+    }
+    nFrame = MAX(nFrame, 1);
+
+#ifdef S52SWBENCH_CELL
+    if (0 < cells->len) {
+        _egl egl;
+        if (FALSE == _egl_init(&egl, NULL, _w, _h))
+            return 1;
+
+        FILE *fd = (NULL == out) ? stdout : fopen(out, "w");
+        if (NULL == fd) {
+            printf("s52swbench: can't write %s\n", out);
+            return 1;
+        }
+
+        int ret = _cellBench(cells, nFrame, dump, ref, fd);
+
+        if (stdout != fd)
+            fclose(fd);
+        _egl_done(&egl, TRUE);
+        g_ptr_array_free(cells, TRUE);
+
+        return (TRUE == ret) ? 0 : 1;
+    }
+    g_ptr_array_free(cells, TRUE);
+#endif
+
+    _scene(nArea, nLine, nGlyph);
+
+    // EGL pbuffer
+    _egl egl;
+    if (FALSE == _egl_init(&egl, NULL, _w, _h))
+        return 1;
+    if (FALSE == _glInit()) {
+        printf("s52swbench: GL init failed\n");
+        return 1;
+    }
+
+    S52_SW_init(_w, _h, nThread);
+
+    gsize   sz    = (gsize)_w * _h * 4;
+    guchar *glPix = g_new0(guchar, sz);
+    guchar *swPix = g_new0(guchar, sz);
+    double *tGL   = g_new0(double, nFrame);
+    double *tSW   = g_new0(double, nFrame);
+    GTimer *timer = g_timer_new();
+
+    // warm up (shader JIT, first touch)
+    _glFrame(glPix);
+    _swFrame(swPix);
+
+    for (int i=0; i<nFrame; ++i) {
+        g_timer_start(timer);
+        _glFrame(glPix);
+        tGL[i] = g_timer_elapsed(timer, NULL) * 1000.0;
+
+        g_timer_start(timer);
+        _swFrame(swPix);
+        tSW[i] = g_timer_elapsed(timer, NULL) * 1000.0;
+    }
+
+    double msGL = _median(tGL, nFrame);
+    double msSW = _median(tSW, nFrame);
+
+    FILE *fd = (NULL == out) ? stdout : fopen(out, "w");
+    if (NULL == fd) {
+        printf("s52swbench: can't write %s\n", out);
+        return 1;
+    }
+
+    fprintf(fd, "{\n  \"width\": %i, \"height\": %i, \"frames\": %i, \"prims\": %u, \"vertex\": %u, \"gl_renderer\": \"%s\",\n",
+            _w, _h, nFrame, _prims->len, _vert->len / 4, (const char *)glGetString(GL_RENDERER));
+    fprintf(fd, "  \"ms_per_frame\": {\"gles2\": %.2f, \"sw\": %.2f}, \"speedup\": %.2f,\n",
+            msGL, msSW, msGL / msSW);
+    _printDiff(fd, glPix, swPix);
+    fprintf(fd, "\n}\n");
+
+    if (stdout != fd)
+        fclose(fd);
+
+    S52_SW_done();
+    _egl_done(&egl, TRUE);
+
+    g_timer_destroy(timer);
+    g_free(glPix);
+    g_free(swPix);
+    g_free(tGL);
+    g_free(tSW);
+    g_array_free(_vert, TRUE);
+    g_array_free(_prims, TRUE);
+
+    return 0;
+}
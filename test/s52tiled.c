@@ -0,0 +1,645 @@
+// s52tiled.c: headless XYZ tile renderer - seed a tile cache or serve tiles over HTTP
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Usage: s52tiled [-s size] [-r nRender] [-e nEncode] [-f png|webp] [-c cacheDir] [-P palette]
+//                 [-m paramID=value].. [-z zmin:zmax | -l port] [-o out.json] cell.000|ENC_ROOT ..
+//
+// No GPU, no window: each render thread draw in its own EGL pbuffer, so it run on Mesa llvmpipe:
+//   $ EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./s52tiled -z 8:12 ENC_ROOT        (seed)
+//   $ EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./s52tiled -l 8080 ENC_ROOT        (serve)
+//     then GET http://host:8080/{z}/{x}/{y}.png
+//
+// libS52 must be build with -DS52_USE_CTX: each render thread has a chart view context
+// (S52_newCtx()) and a GL context in the share group of the root context, so cells,
+// PLib, VBO and texture are loaded once. libS52 draw each context in parallel (GLES2),
+// so does glReadPixels() (own pbuffer), PNG / WebP encoding (GThreadPool) and the
+// cache I/O - Mesa llvmpipe also rasterize on LP_NUM_THREADS.
+//
+// Cache: cacheDir/key/z/x/y.fmt - key is a hash of the cell set (S52_getCellNameList()),
+// all the Mariners' Parameter, tile size, format and libS52 version. A new key on change
+// of any of these, so a stale tile is never served.
+//
+// Tile: Web Mercator XYZ (as OSM, WMTS GoogleMapsCompatible). libS52 draw in ellipsoidal
+// Mercator (WGS84) in a square view, so the tile E/W edges are exact and the N/S edges
+// centered on the tile, within e^2 (~0.7%) of its height (see _tileView()).
+//
+// Result of seed in JSON: tiles, tiles per sec, tiles per sec per core.
+
+
+#include "S52.h"
+
+#include <EGL/egl.h>
+#include <GLES2/gl2.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>    // g_rename()
+#include <gio/gio.h>        // GThreadedSocketService
+#include <png.h>
+#ifdef S52TILED_WEBP
+#include <webp/encode.h>
+#endif
+
+#include <stdio.h>          // printf(), fopen()
+#include <stdlib.h>         // atoi()
+#include <string.h>         // strcmp()
+#include <math.h>           // sinh()
+
+#include "_bench.i"         // _collectCell(), _egl_init(), _egl_done()
+
+typedef struct _tile {
+    int     z, x, y;        // z < 0: render thread quit
+    gchar  *path;           // in cache
+    guchar *rgba;           // glReadPixels() - bottom row first
+    int     wait;           // TRUE a HTTP thread wait on it, else free when done
+    int     done;           // _jobMutex
+    int     ok;
+} _tile;
+
+static int           _size     = 256;       // tile size (pixels)
+static const char   *_fmt      = "png";
+static gchar        *_cacheDir = NULL;      // cacheDir/key
+
+static _egl          _root;                 // S52_init(), cell load - share group root
+static GAsyncQueue  *_renderQ  = NULL;      // _tile to render
+static GThreadPool  *_encodeP  = NULL;      // _tile to encode
+
+static GMutex        _jobMutex;
+static GCond         _jobCond;
+static guint         _nDone    = 0;         // _jobMutex
+static guint         _nFail    = 0;         // _jobMutex
+static guint         _nReady   = 0;         // render thread that tried EGL init - _jobMutex
+static guint         _nLive    = 0;         // render thread with a GL context   - _jobMutex
+
+#define WGS84_E      0.0818191908426        // first eccentricity of the ellipsoid of libS52 Mercator
+
+static int      _egl_beg(void *EGLctx, const char *tag)
+{
+    _egl *egl = (_egl*)EGLctx;
+    (void)tag;
+
+    if (egl->ctx != eglGetCurrentContext())
+        eglMakeCurrent(egl->dpy, egl->sfc, egl->sfc, egl->ctx);
+
+    return TRUE;
+}
+
+static int      _egl_end(void *EGLctx, const char *tag)
+// no swap in a pbuffer - pixels are read after S52_draw()
+{
+    (void)EGLctx;
+    (void)tag;
+
+    return TRUE;
+}
+
+static void     _tileExt(int z, int x, int y, double *S, double *W, double *N, double *E)
+// Web Mercator tile to lat/lon (deg)
+{
+    double n = (double)(1 << z);
+
+    *W = x       / n * 360.0 - 180.0;
+    *E = (x + 1) / n * 360.0 - 180.0;
+    *N = atan(sinh(G_PI * (1.0 - 2.0 *  y      / n))) * 180.0 / G_PI;
+    *S = atan(sinh(G_PI * (1.0 - 2.0 * (y + 1) / n))) * 180.0 / G_PI;
+}
+
+static double   _mercY(double lat)
+// ellipsoidal Mercator northing (unit: radius) of lat (deg)
+{
+    double phi = lat * G_PI / 180.0;
+    double es  = WGS84_E * sin(phi);
+
+    return log(tan(G_PI / 4.0 + phi / 2.0) * pow((1.0 - es) / (1.0 + es), WGS84_E / 2.0));
+}
+
+static double   _mercLat(double y)
+// inverse of _mercY() - fixed point, converge in a few iteration
+{
+    double t   = exp(-y);
+    double phi = G_PI / 2.0 - 2.0 * atan(t);
+
+    for (int i=0; i<8; ++i) {
+        double es = WGS84_E * sin(phi);
+        phi = G_PI / 2.0 - 2.0 * atan(t * pow((1.0 - es) / (1.0 + es), WGS84_E / 2.0));
+    }
+
+    return phi * 180.0 / G_PI;
+}
+
+static void     _tileView(int z, int x, int y, double *cLat, double *cLon, double *rNM)
+// S52_setView() of a tile - libS52 view is cLat +/- rNM/60 deg, then as wide as high (projected),
+// so the view height is set to the tile width in ellipsoidal Mercator, centered on the tile
+{
+    double S, W, N, E;
+    _tileExt(z, x, y, &S, &W, &N, &E);
+
+    double h   = (E - W) * G_PI / 180.0;
+    double mid = (_mercY(N) + _mercY(S)) / 2.0;
+    double top = _mercLat(mid + h / 2.0);
+    double bot = _mercLat(mid - h / 2.0);
+
+    *cLat = (top + bot) / 2.0;
+    *cLon = (W   + E  ) / 2.0;
+    *rNM  = (top - bot) * 60.0 / 2.0;
+}
+
+static void     _tileXY(int z, double lat, double lon, int *x, int *y)
+// lat/lon (deg) to Web Mercator tile
+{
+    int    n   = 1 << z;
+    double rad = lat * G_PI / 180.0;
+
+    *x = (int)floor((lon + 180.0) / 360.0 * n);
+    *y = (int)floor((1.0 - log(tan(rad) + 1.0 / cos(rad)) / G_PI) / 2.0 * n);
+    *x = CLAMP(*x, 0, n-1);
+    *y = CLAMP(*y, 0, n-1);
+}
+
+static _tile   *_newTile(int z, int x, int y, int wait)
+{
+    _tile *t = g_new0(_tile, 1);
+
+    t->z    = z;
+    t->x    = x;
+    t->y    = y;
+    t->wait = wait;
+    if (0 <= z)
+        t->path = g_strdup_printf("%s/%i/%i/%i.%s", _cacheDir, z, x, y, _fmt);
+
+    return t;
+}
+
+static void     _delTile(_tile *t)
+{
+    g_free(t->path);
+    g_free(t->rgba);
+    g_free(t);
+}
+
+static void     _tileDone(_tile *t, int ok)
+{
+    g_free(t->rgba);
+    t->rgba = NULL;
+
+    g_mutex_lock(&_jobMutex);
+    t->ok   = ok;
+    t->done = TRUE;
+    ++_nDone;
+    if (FALSE == ok)
+        ++_nFail;
+    g_cond_broadcast(&_jobCond);
+    g_mutex_unlock(&_jobMutex);
+
+    // seed - nobody wait on it
+    if (FALSE == t->wait)
+        _delTile(t);
+}
+
+static int      _writePNG(const char *fname, const guchar *rgba)
+{
+    FILE *fp = fopen(fname, "wb");
+    if (NULL == fp)
+        return FALSE;
+
+    png_structp png  = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    png_infop   info = png_create_info_struct(png);
+    if ((NULL==png) || (NULL==info) || (0!=setjmp(png_jmpbuf(png)))) {
+        png_destroy_write_struct(&png, &info);
+        fclose(fp);
+        return FALSE;
+    }
+
+    png_init_io(png, fp);
+    // speed over size - tile are written once, read many
+    png_set_compression_level(png, 1);
+    png_set_IHDR(png, info, _size, _size, 8, PNG_COLOR_TYPE_RGBA, PNG_INTERLACE_NONE,
+                 PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_write_info(png, info);
+
+    // GL is bottom row first
+    for (int row=_size-1; row>=0; --row)
+        png_write_row(png, (png_const_bytep)(rgba + row * _size * 4));
+
+    png_write_end(png, NULL);
+    png_destroy_write_struct(&png, &info);
+    fclose(fp);
+
+    return TRUE;
+}
+
+#ifdef S52TILED_WEBP
+static int      _writeWebP(const char *fname, const guchar *rgba)
+{
+    // GL is bottom row first - negative stride from the top row
+    uint8_t *out = NULL;
+    size_t   sz  = WebPEncodeRGBA(rgba + (_size-1) * _size * 4, _size, _size, -_size * 4, 80.0f, &out);
+    if (0 == sz)
+        return FALSE;
+
+    int ret = g_file_set_contents(fname, (const gchar *)out, sz, NULL);
+    WebPFree(out);
+
+    return ret;
+}
+#endif
+
+static void     _encode(gpointer data, gpointer user_data)
+// GThreadPool - encode then write in the cache (tmp file renamed, reader never see a partial tile)
+{
+    _tile *t = (_tile*)data;
+    (void)user_data;
+
+    gchar *dir = g_path_get_dirname(t->path);
+    g_mkdir_with_parents(dir, 0755);
+    g_free(dir);
+
+    gchar *tmp = g_strdup_printf("%s.%p.tmp", t->path, (void*)t);
+    int    ok  = FALSE;
+#ifdef S52TILED_WEBP
+    if (0 == strcmp(_fmt, "webp"))
+        ok = _writeWebP(tmp, t->rgba);
+    else
+#endif
+        ok = _writePNG(tmp, t->rgba);
+
+    if ((TRUE==ok) && (0!=g_rename(tmp, t->path)))
+        ok = FALSE;
+    if (FALSE == ok)
+        g_unlink(tmp);
+    g_free(tmp);
+
+    _tileDone(t, ok);
+}
+
+static gpointer _renderThread(gpointer data)
+{
+    _egl *egl = (_egl*)data;
+
+    // GL context in the share group of the root (VBO, texture)
+    int ok = _egl_init(egl, &_root, _size, _size);
+
+    g_mutex_lock(&_jobMutex);
+    ++_nReady;
+    if (TRUE == ok)
+        ++_nLive;
+    g_cond_broadcast(&_jobCond);
+    g_mutex_unlock(&_jobMutex);
+
+    if (FALSE == ok)
+        return NULL;
+
+    // chart view - copy of the default context (view, MP)
+    void *ctx = S52_newCtx();
+    S52_setCtx(ctx);
+    S52_setEGLCallBack(_egl_beg, _egl_end, egl);
+
+    for (;;) {
+        _tile *t = (_tile*)g_async_queue_pop(_renderQ);
+        if (t->z < 0) {
+            _delTile(t);
+            break;
+        }
+
+        double cLat, cLon, rNM;
+        _tileView(t->z, t->x, t->y, &cLat, &cLon, &rNM);
+        S52_setView(cLat, cLon, rNM, 0.0);
+
+        // Note: S52_setView() only touch this context and S52_draw() of a context
+        // of S52_newCtx() wait for a setter - fail is not lock contention
+        if (FALSE == S52_draw()) {
+            _tileDone(t, FALSE);
+            continue;
+        }
+
+        // own pbuffer
+        t->rgba = g_new(guchar, _size * _size * 4);
+        glReadPixels(0, 0, _size, _size, GL_RGBA, GL_UNSIGNED_BYTE, t->rgba);
+
+        g_thread_pool_push(_encodeP, t, NULL);
+    }
+
+    S52_setCtx(NULL);
+    S52_delCtx(ctx);
+    _egl_done(egl, FALSE);
+
+    return NULL;
+}
+
+static _tile   *_getTile(int z, int x, int y)
+// HTTP thread - from cache, else render and wait
+{
+    _tile *t = _newTile(z, x, y, TRUE);
+
+    if (TRUE == g_file_test(t->path, G_FILE_TEST_EXISTS)) {
+        t->ok   = TRUE;
+        t->done = TRUE;
+        return t;
+    }
+
+    g_async_queue_push(_renderQ, t);
+
+    g_mutex_lock(&_jobMutex);
+    while (FALSE == t->done)
+        g_cond_wait(&_jobCond, &_jobMutex);
+    g_mutex_unlock(&_jobMutex);
+
+    return t;
+}
+
+static gboolean _serve(GThreadedSocketService *service, GSocketConnection *conn, GObject *source, gpointer user_data)
+// one request: GET /z/x/y.fmt
+{
+    (void)service;
+    (void)source;
+    (void)user_data;
+
+    GInputStream     *in   = g_io_stream_get_input_stream (G_IO_STREAM(conn));
+    GOutputStream    *out  = g_io_stream_get_output_stream(G_IO_STREAM(conn));
+    GDataInputStream *data = g_data_input_stream_new(in);
+    gchar            *line = g_data_input_stream_read_line(data, NULL, NULL, NULL);
+    int               z, x, y;
+    char              ext[8] = {'\0'};
+    gchar            *body   = NULL;
+    gsize             len    = 0;
+
+    if ((NULL!=line) && (4==sscanf(line, "GET /%i/%i/%i.%7s", &z, &x, &y, ext)) &&
+        (0==strcmp(ext, _fmt)) && (0<=z) && (z<=22) && (0<=x) && (x<(1<<z)) && (0<=y) && (y<(1<<z))) {
+        _tile *t = _getTile(z, x, y);
+        if (TRUE == t->ok)
+            g_file_get_contents(t->path, &body, &len, NULL);
+        _delTile(t);
+    }
+
+    gchar *head = (NULL == body) ?
+        g_strdup("HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\n\r\n") :
+        g_strdup_printf("HTTP/1.0 200 OK\r\nContent-Type: image/%s\r\nContent-Length: %lu\r\n"
+                        "Access-Control-Allow-Origin: *\r\nCache-Control: max-age=3600\r\n\r\n",
+                        _fmt, (gulong)len);
+
+    g_output_stream_write_all(out, head, strlen(head), NULL, NULL, NULL);
+    if (NULL != body)
+        g_output_stream_write_all(out, body, len, NULL, NULL, NULL);
+
+    g_free(head);
+    g_free(body);
+    g_free(line);
+    g_object_unref(data);
+
+    return TRUE;
+}
+
+static gchar   *_cacheKey(void)
+// hash of all that change the pixels of a tile
+{
+    GString *str = g_string_new(S52_version());
+
+    g_string_append_printf(str, "|%s|%i|%s|", S52_getCellNameList(), _size, _fmt);
+    for (int i=0; i<S52_MAR_NUM; ++i)
+        g_string_append_printf(str, "%g,", S52_getMarinerParam((S52MarinerParameter)i));
+
+    gchar *sum = g_compute_checksum_for_string(G_CHECKSUM_SHA1, str->str, -1);
+    gchar *key = g_strndup(sum, 16);
+
+    g_free(sum);
+    g_string_free(str, TRUE);
+
+    return key;
+}
+
+static int      _setPalette(const char *name)
+{
+    const char *list = S52_getPalettesNameList();
+    gchar     **pal  = g_strsplit((NULL == list) ? "" : list, ",", 0);
+    int         ret  = FALSE;
+
+    for (guint i=0; NULL!=pal[i]; ++i) {
+        if (0 == g_strcmp0(g_strstrip(pal[i]), name)) {
+            ret = S52_setMarinerParam(S52_MAR_COLOR_PALETTE, (double)i);
+            break;
+        }
+    }
+    g_strfreev(pal);
+
+    if (FALSE == ret)
+        printf("s52tiled: WARNING: palette not found: %s\n", name);
+
+    return ret;
+}
+
+int main(int argc, char *argv[])
+{
+    int         nRender  = 2;
+    int         nEncode  = MAX((int)g_get_num_processors() - 1, 1);
+    int         zmin     = -1;
+    int         zmax     = -1;
+    int         port     = 0;
+    const char *cacheDir = "tiles";
+    const char *palette  = NULL;
+    const char *out      = NULL;
+    GPtrArray  *params   = g_ptr_array_new();
+    GPtrArray  *cells    = g_ptr_array_new_with_free_func(g_free);
+
+    for (int i=1; i<argc; ++i) {
+        if ((0==strcmp(argv[i], "-s")) && (i+1<argc)) { _size    = atoi(argv[++i]);             continue; }
+        if ((0==strcmp(argv[i], "-r")) && (i+1<argc)) { nRender  = atoi(argv[++i]);             continue; }
+        if ((0==strcmp(argv[i], "-e")) && (i+1<argc)) { nEncode  = atoi(argv[++i]);             continue; }
+        if ((0==strcmp(argv[i], "-f")) && (i+1<argc)) { _fmt     = argv[++i];                   continue; }
+        if ((0==strcmp(argv[i], "-c")) && (i+1<argc)) { cacheDir = argv[++i];                   continue; }
+        if ((0==strcmp(argv[i], "-P")) && (i+1<argc)) { palette  = argv[++i];                   continue; }
+        if ((0==strcmp(argv[i], "-m")) && (i+1<argc)) { g_ptr_array_add(params, argv[++i]);     continue; }
+        if ((0==strcmp(argv[i], "-z")) && (i+1<argc)) { sscanf(argv[++i], "%i:%i", &zmin, &zmax); continue; }
+        if ((0==strcmp(argv[i], "-l")) && (i+1<argc)) { port     = atoi(argv[++i]);             continue; }
+        if ((0==strcmp(argv[i], "-o")) && (i+1<argc)) { out      = argv[++i];                   continue; }
+        if ('-' == argv[i][0]) {
+            printf("Usage: %s [-s size] [-r nRender] [-e nEncode] [-f png|webp] [-c cacheDir] [-P palette]\n"
+                   "       [-m paramID=value].. [-z zmin:zmax | -l port] [-o out.json] cell.000|ENC_ROOT ..\n", argv[0]);
+            return 1;
+        }
+        _collectCell(argv[i], cells);
+    }
+
+#ifndef S52TILED_WEBP
+    if (0 != strcmp(_fmt, "png")) {
+        printf("s52tiled: format %s not build in (-DS52TILED_WEBP)\n", _fmt);
+        return 1;
+    }
+#endif
+    if ((zmin<0 || zmax<zmin) && (0==port)) {
+        printf("s52tiled: need -z zmin:zmax (seed) or -l port (serve)\n");
+        return 1;
+    }
+    nRender = MAX(nRender, 1);
+    nEncode = MAX(nEncode, 1);
+
+    // GL / libS52 - root context: init and load
+    if (FALSE == _egl_init(&_root, NULL, _size, _size))
+        return 1;
+
+    // ~ 96 DPI
+    int mm = (int)(_size * 25.4 / 96.0);
+    if (FALSE == S52_init(_size, _size, mm, mm, NULL)) {
+        printf("s52tiled: S52_init() failed\n");
+        return 1;
+    }
+    S52_setEGLCallBack(_egl_beg, _egl_end, &_root);
+
+    if (0 == cells->len) {
+        S52_loadCell(NULL, NULL);
+    } else {
+        for (guint i=0; i<cells->len; ++i)
+            S52_loadCell((const char *)g_ptr_array_index(cells, i), NULL);
+    }
+
+    double S, W, N, E;
+    if (FALSE == S52_getCellExtent(NULL, &S, &W, &N, &E)) {
+        printf("s52tiled: no cell loaded\n");
+        return 1;
+    }
+
+    // display setting - before S52_newCtx() (copied by the render context)
+    S52_setMarinerParam(S52_MAR_DISP_CATEGORY, S52_MAR_DISP_CATEGORY_SELECT);
+    if (NULL != palette)
+        _setPalette(palette);
+    for (guint i=0; i<params->len; ++i) {
+        int    id  = 0;
+        double val = 0.0;
+        if (2 == sscanf((const char *)g_ptr_array_index(params, i), "%i=%lf", &id, &val))
+            S52_setMarinerParam((S52MarinerParameter)id, val);
+    }
+
+    // first draw in the root set the projection, build VBO, ..
+    S52_setView((S + N) / 2.0, (W + E) / 2.0, (N - S) * 60.0 / 2.0, 0.0);
+    S52_draw();
+
+    gchar *key = _cacheKey();
+    _cacheDir  = g_build_filename(cacheDir, key, NULL);
+    g_mkdir_with_parents(_cacheDir, 0755);
+    printf("s52tiled: cache %s\n", _cacheDir);
+
+    // render / encode threads
+    _renderQ = g_async_queue_new();
+    _encodeP = g_thread_pool_new(_encode, NULL, nEncode, TRUE, NULL);
+    _egl     *egls    = g_new0(_egl,     nRender);
+    GThread **threads = g_new0(GThread*, nRender);
+    for (int i=0; i<nRender; ++i)
+        threads[i] = g_thread_new("s52tiled", _renderThread, &egls[i]);
+
+    // fail fast - without a GL context no render thread drain _renderQ
+    g_mutex_lock(&_jobMutex);
+    while (_nReady < (guint)nRender)
+        g_cond_wait(&_jobCond, &_jobMutex);
+    guint nLive = _nLive;
+    g_mutex_unlock(&_jobMutex);
+    if (0 == nLive) {
+        printf("s52tiled: no render thread (EGL init failed)\n");
+        return 1;
+    }
+    if (nLive < (guint)nRender)
+        printf("s52tiled: WARNING: %u render thread of %i (EGL init failed)\n", nLive, nRender);
+
+    GTimer *timer = g_timer_new();
+    guint   nTile = 0;
+    guint   nHit  = 0;
+
+    if (0 != port) {
+        // serve until killed
+        GSocketService *service = g_threaded_socket_service_new(MAX(nEncode, nRender) * 4);
+        if (FALSE == g_socket_listener_add_inet_port(G_SOCKET_LISTENER(service), port, NULL, NULL)) {
+            printf("s52tiled: can't listen on port %i\n", port);
+            return 1;
+        }
+        g_signal_connect(service, "run", G_CALLBACK(_serve), NULL);
+        printf("s52tiled: GET http://localhost:%i/{z}/{x}/{y}.%s\n", port, _fmt);
+
+        GMainLoop *loop = g_main_loop_new(NULL, FALSE);
+        g_main_loop_run(loop);
+    } else {
+        // seed - all tiles over the cells extent
+        for (int z=zmin; z<=zmax; ++z) {
+            int x0, y0, x1, y1;
+            _tileXY(z, N, W, &x0, &y0);
+            _tileXY(z, S, E, &x1, &y1);
+            for (int y=y0; y<=y1; ++y) {
+                for (int x=x0; x<=x1; ++x) {
+                    _tile *t = _newTile(z, x, y, FALSE);
+                    ++nTile;
+                    if (TRUE == g_file_test(t->path, G_FILE_TEST_EXISTS)) {
+                        ++nHit;
+                        _delTile(t);
+                        continue;
+                    }
+                    g_async_queue_push(_renderQ, t);
+                }
+            }
+        }
+
+        g_mutex_lock(&_jobMutex);
+        while (_nDone < nTile - nHit)
+            g_cond_wait(&_jobCond, &_jobMutex);
+        g_mutex_unlock(&_jobMutex);
+    }
+
+    double sec = g_timer_elapsed(timer, NULL);
+    g_timer_destroy(timer);
+
+    // stop
+    for (guint i=0; i<nLive; ++i)
+        g_async_queue_push(_renderQ, _newTile(-1, 0, 0, FALSE));
+    for (int i=0; i<nRender; ++i)
+        g_thread_join(threads[i]);
+    g_thread_pool_free(_encodeP, FALSE, TRUE);
+
+    // result
+    FILE *fd = (NULL == out) ? stdout : fopen(out, "w");
+    if (NULL == fd) {
+        printf("s52tiled: can't write %s\n", out);
+        return 1;
+    }
+
+    guint  nRendered = nTile - nHit;
+    guint  nCore     = g_get_num_processors();
+    double tps       = (0.0 < sec) ? nRendered / sec : 0.0;
+    fprintf(fd, "{\n  \"size\": %i, \"format\": \"%s\", \"render_threads\": %i, \"encode_threads\": %i, \"cores\": %u,\n",
+            _size, _fmt, nRender, nEncode, nCore);
+    fprintf(fd, "  \"zoom\": [%i, %i], \"key\": \"%s\", \"tiles\": %u, \"cached\": %u, \"rendered\": %u, \"failed\": %u,\n",
+            zmin, zmax, key, nTile, nHit, nRendered - _nFail, _nFail);
+    fprintf(fd, "  \"sec\": %.3f, \"tiles_per_sec\": %.2f, \"tiles_per_sec_per_core\": %.2f\n}\n",
+            sec, tps, tps / nCore);
+
+    if (stdout != fd)
+        fclose(fd);
+
+    // cleanup
+    S52_done();
+    _egl_done(&_root, TRUE);
+
+    g_async_queue_unref(_renderQ);
+    g_free(egls);
+    g_free(threads);
+    g_free(key);
+    g_free(_cacheDir);
+    g_ptr_array_free(params, TRUE);
+    g_ptr_array_free(cells, TRUE);
+
+    return 0;
+}
@@ -0,0 +1,280 @@
+// s57arena.c: time cell load / unload and measure heap fragmentation - heap vs per-cell geometry arena
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Usage: s57arena [-a] [-n cycle] [-k resident] cell.000|ENC_ROOT ..
+//
+// Load cells round-robin, keeping the S57_geo of the last 'resident' cells alive
+// (as the chart manager does), so cell lifetimes interleave on the heap. Each
+// cycle load one cell and unload the oldest. With -a the geo and coords of a
+// cell come from its own arena (S57_newArena()), unmapped by S57_doneArena().
+// Run once without and once with -a to compare.
+//
+// The arena is geometry only: attribs and prim of a geo are still on the heap,
+// so unload is split in the per-object free (S57_doneData() loop) and the
+// unmap - the objFree column / TOTAL % is what the arena do not cover.
+//
+// Per cycle: load / unload time, malloc heap in use / free (fordblks) and RSS.
+// Fragmentation is the part of the malloc heap that is free but not returned
+// to the system: free / (in use + free).
+
+
+#include "S57ogr.h"         // S57_ogrLoadCell(), ..
+#include "S57iso8211.h"     // S57_iso8211LoadCell(), ..
+
+#include <glib.h>
+#include <stdio.h>          // printf(), fopen()
+#include <stdlib.h>         // atoi()
+#include <string.h>         // strcmp()
+#include <unistd.h>         // sysconf()
+#ifdef __GLIBC__
+#include <malloc.h>         // mallinfo()
+
+#include "_bench.i"         // _collectCell()
+#endif
+
+typedef struct _resident {
+    GPtrArray *geo;         // S57_geo of this cell
+#ifdef S52_USE_ARENA
+    S57_arena *arena;
+#endif
+} _resident;
+
+static GPtrArray *_geo = NULL;  // cell being loaded
+
+static int      _keepGeo(S57_geo *geo)
+{
+    if (NULL != geo)
+        g_ptr_array_add(_geo, geo);
+
+    return TRUE;
+}
+
+static int      _ogrLoadObject(const char *objname, void *feature)
+{
+    return _keepGeo(S57_ogrLoadObject(objname, feature));
+}
+
+static int      _ogrLoadLayer(const char *layername, void *layer, S52_loadObject_cb loadObject_cb)
+{
+    (void)loadObject_cb;
+    return S57_ogrLoadLayer(layername, layer, _ogrLoadObject);
+}
+
+static int      _isoLoadObject(const char *objname, void *feature)
+{
+    return _keepGeo(S57_iso8211LoadObject(objname, feature));
+}
+
+static int      _isoLoadLayer(const char *layername, void *layer, S52_loadObject_cb loadObject_cb)
+{
+    (void)loadObject_cb;
+    return S57_iso8211LoadLayer(layername, layer, _isoLoadObject);
+}
+
+// S57ogr.c / S57iso8211.c link to these when the callback is NULL
+DLL int   STD  S52_loadLayer(const char *layername, void *layer, S52_loadObject_cb loadObject_cb)
+{
+    return _ogrLoadLayer(layername, layer, loadObject_cb);
+}
+
+DLL int   STD  S52_loadObject(const char *objname, void *feature)
+{
+    return _ogrLoadObject(objname, feature);
+}
+
+static void     _heapStat(double *inuseMB, double *freeMB, double *rssMB)
+{
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2,33)
+    struct mallinfo2 mi = mallinfo2();
+#else
+    struct mallinfo  mi = mallinfo();
+#endif
+    *inuseMB = (double)mi.uordblks / (1024.0*1024.0);
+    *freeMB  = (double)mi.fordblks / (1024.0*1024.0);
+#else
+    *inuseMB = 0.0;
+    *freeMB  = 0.0;
+#endif
+
+    // resident pages
+    *rssMB = 0.0;
+    FILE *fd = fopen("/proc/self/statm", "r");
+    if (NULL != fd) {
+        unsigned long size = 0;
+        unsigned long rss  = 0;
+        if (2 == fscanf(fd, "%lu %lu", &size, &rss))
+            *rssMB = (double)rss * sysconf(_SC_PAGESIZE) / (1024.0*1024.0);
+        fclose(fd);
+    }
+}
+
+static double   _unload(_resident *r, GTimer *timer)
+// return time (sec) in the per-object free
+{
+#ifdef S52_USE_ARENA
+    // same as libS52 _freeCell() - geo / coords are not freed one by one
+    if (NULL != r->arena)
+        S57_closeArena(r->arena);
+#endif
+
+    double t0 = g_timer_elapsed(timer, NULL);
+    g_ptr_array_foreach(r->geo, (GFunc)S57_doneData, NULL);
+    double objSec = g_timer_elapsed(timer, NULL) - t0;
+
+    g_ptr_array_free(r->geo, TRUE);
+
+#ifdef S52_USE_ARENA
+    if (NULL != r->arena)
+        S57_doneArena(r->arena);
+#endif
+
+    g_free(r);
+
+    return objSec;
+}
+
+int main(int argc, char *argv[])
+{
+    int        useArena = FALSE;
+    int        nCycle   = 0;
+    guint      nKeep    = 4;
+    GPtrArray *cells    = g_ptr_array_new();
+
+    for (int i=1; i<argc; ++i) {
+        if (0 == strcmp(argv[i], "-a")) {
+            useArena = TRUE;
+            continue;
+        }
+        if ((0==strcmp(argv[i], "-n")) && (i+1<argc)) {
+            nCycle = atoi(argv[++i]);
+            continue;
+        }
+        if ((0==strcmp(argv[i], "-k")) && (i+1<argc)) {
+            nKeep = atoi(argv[++i]);
+            if (nKeep < 1) nKeep = 1;
+            continue;
+        }
+        _collectCell(argv[i], cells);
+    }
+
+    if (0 == cells->len) {
+        printf("Usage: %s [-a] [-n cycle] [-k resident] cell.000|ENC_ROOT ..\n", argv[0]);
+        return 1;
+    }
+
+#ifndef S52_USE_ARENA
+    if (TRUE == useArena) {
+        printf("WARNING: -a need -DS52_USE_ARENA, using heap\n");
+        useArena = FALSE;
+    }
+#endif
+
+    // default: go 4 times around the cell list
+    if (nCycle < 1)
+        nCycle = 4 * cells->len;
+
+#ifdef S52_USE_SUPP_LINE_OVERLAP
+    g_setenv("OGR_S57_OPTIONS", "UPDATES=APPLY,SPLIT_MULTIPOINT=ON,PRESERVE_EMPTY_NUMBERS=ON,RETURN_PRIMITIVES=ON,RETURN_LINKAGES=ON,LNAM_REFS=ON,RECODE_BY_DSSI=ON", 1);
+#else
+    g_setenv("OGR_S57_OPTIONS", "LNAM_REFS=ON,UPDATES=APPLY,SPLIT_MULTIPOINT=ON,PRESERVE_EMPTY_NUMBERS=ON", 1);
+#endif
+
+    GTimer *timer    = g_timer_new();
+    GQueue *resident = g_queue_new();
+    double  loadTot  = 0.0;
+    double  doneTot  = 0.0;
+    double  objTot   = 0.0;     // part of doneTot in S57_doneData()
+    double  fragMax  = 0.0;
+    double  inuse, hfree, rss;
+
+    printf("mode: %s, %i cycle, %u resident cell\n", (TRUE==useArena) ? "arena" : "heap", nCycle, nKeep);
+    printf("%6s %-24s %8s %10s %10s %11s %10s %10s %8s %8s\n",
+           "cycle", "cell", "nObj", "load(ms)", "unload(ms)", "objFree(ms)", "inuse(MB)", "free(MB)", "frag(%)", "RSS(MB)");
+
+    for (int n=0; n<nCycle; ++n) {
+        const char *cell = (const char *)g_ptr_array_index(cells, n % cells->len);
+        gchar      *base = g_path_get_basename(cell);
+        _resident  *r    = g_new0(_resident, 1);
+
+        r->geo = _geo = g_ptr_array_new();
+
+        g_timer_start(timer);
+#ifdef S52_USE_ARENA
+        if (TRUE == useArena) {
+            r->arena = S57_newArena();
+            S57_setArena(r->arena);
+        }
+#endif
+        if (FALSE == S57_iso8211LoadCell(cell, _isoLoadLayer, _isoLoadObject))
+            S57_ogrLoadCell(cell, _ogrLoadLayer, _ogrLoadObject);
+#ifdef S52_USE_ARENA
+        S57_setArena(NULL);
+#endif
+        double loadSec = g_timer_elapsed(timer, NULL);
+
+        g_queue_push_tail(resident, r);
+
+        double doneSec = 0.0;
+        double objSec  = 0.0;
+        if (nKeep < g_queue_get_length(resident)) {
+            g_timer_start(timer);
+            objSec  = _unload((_resident*)g_queue_pop_head(resident), timer);
+            doneSec = g_timer_elapsed(timer, NULL);
+        }
+
+        _heapStat(&inuse, &hfree, &rss);
+        double frag = (0.0 < inuse+hfree) ? 100.0 * hfree / (inuse+hfree) : 0.0;
+        if (frag > fragMax)
+            fragMax = frag;
+
+        loadTot += loadSec;
+        doneTot += doneSec;
+        objTot  += objSec;
+
+        printf("%6i %-24s %8u %10.1f %10.1f %11.1f %10.1f %10.1f %8.1f %8.1f\n", n, base, r->geo->len,
+               loadSec*1000.0, doneSec*1000.0, objSec*1000.0, inuse, hfree, frag, rss);
+
+        g_free(base);
+    }
+
+    // steady state is the last line - unload what is left
+    g_timer_start(timer);
+    guint nLeft = g_queue_get_length(resident);
+    while (0 < g_queue_get_length(resident))
+        _unload((_resident*)g_queue_pop_head(resident), timer);
+    double leftSec = g_timer_elapsed(timer, NULL);
+
+    _heapStat(&inuse, &hfree, &rss);
+    printf("TOTAL load:%.1f ms  unload:%.1f ms (per-object free:%.1f ms, %.1f%%)  (+%u cell at exit:%.1f ms)  max frag:%.1f%%  heap at exit: inuse %.1f MB free %.1f MB RSS %.1f MB\n",
+           loadTot*1000.0, doneTot*1000.0, objTot*1000.0, (0.0 < doneTot) ? 100.0*objTot/doneTot : 0.0,
+           nLeft, leftSec*1000.0, fragMax, inuse, hfree, rss);
+
+    S57_iso8211Done();
+    g_queue_free(resident);
+    g_timer_destroy(timer);
+    g_ptr_array_foreach(cells, (GFunc)g_free, NULL);
+    g_ptr_array_free(cells, TRUE);
+
+    return 0;
+}
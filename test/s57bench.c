@@ -0,0 +1,247 @@
+// s57bench.c: time S57 cell loading - OGR vs native ISO 8211 reader (S57iso8211.c)
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Usage: s57bench [-n loop] cell.000|ENC_ROOT ..
+//
+// Build S57_geo (geometry + attributes) for each feature then free it - the
+// part of S52_loadCell() that depend on the reader. Note that the native reader
+// return FALSE (no timing) on a cell that OGR must load (update, no catalogue).
+// For a cell with update, the time to apply the last one (S52_loadUpdate())
+// is shown instead.
+
+
+#include "S57ogr.h"         // S57_ogrLoadCell(), ..
+#include "S57iso8211.h"     // S57_iso8211LoadCell(), ..
+
+#include <glib.h>
+#include <glib/gstdio.h>    // g_file_test()
+#include <stdio.h>          // printf()
+#include <stdlib.h>         // atoi()
+#include <string.h>         // strcmp()
+
+#include "_bench.i"         // _collectCell()
+
+typedef struct _count {
+    guint nObj;             // S57_geo
+    guint nPt;              // vertex
+} _count;
+
+static _count _cnt;
+static guint  _edtn = 0;    // DSID_EDTN of the last cell loaded by OGR - S57_iso8211LoadUpdate()
+
+static int      _countGeo(S57_geo *geo)
+{
+    if (NULL == geo)
+        return FALSE;
+
+    for (guint i=0; i<S57_getRingNbr(geo); ++i) {
+        guint   npt = 0;
+        double *ppt = NULL;
+        if (TRUE == S57_getGeoData(geo, i, &npt, &ppt))
+            _cnt.nPt += npt;
+    }
+    ++_cnt.nObj;
+
+    S57_doneData(geo, NULL);
+
+    return TRUE;
+}
+
+static int      _isoUpdate(const char *objname, const char *lnam, S57_geo *geo, void *user_data)
+{
+    (void)objname;
+    (void)lnam;
+    (void)user_data;
+
+    // geo NULL: object removed
+    return _countGeo(geo);
+}
+
+static int      _ogrLoadObject(const char *objname, void *feature)
+{
+    S57_geo *geo = S57_ogrLoadObject(objname, feature);
+
+    if ((NULL!=geo) && (0==strcmp(objname, "DSID"))) {
+        GString *edtn = S57_getAttVal(geo, "DSID_EDTN");
+        _edtn = (NULL == edtn) ? 0 : (guint)atoi(edtn->str);
+    }
+
+    return _countGeo(geo);
+}
+
+static int      _ogrLoadLayer(const char *layername, void *layer, S52_loadObject_cb loadObject_cb)
+{
+    (void)loadObject_cb;
+    return S57_ogrLoadLayer(layername, layer, _ogrLoadObject);
+}
+
+static int      _isoLoadObject(const char *objname, void *feature)
+{
+    return _countGeo(S57_iso8211LoadObject(objname, feature));
+}
+
+static int      _isoLoadLayer(const char *layername, void *layer, S52_loadObject_cb loadObject_cb)
+{
+    (void)loadObject_cb;
+    return S57_iso8211LoadLayer(layername, layer, _isoLoadObject);
+}
+
+// S57ogr.c / S57iso8211.c link to these when the callback is NULL
+DLL int   STD  S52_loadLayer(const char *layername, void *layer, S52_loadObject_cb loadObject_cb)
+{
+    return _ogrLoadLayer(layername, layer, loadObject_cb);
+}
+
+DLL int   STD  S52_loadObject(const char *objname, void *feature)
+{
+    return _ogrLoadObject(objname, feature);
+}
+
+static gchar   *_lastUpdate(const char *cell)
+// last update file (.00N) of a base cell, NULL if none
+{
+    gchar *upd  = g_strdup(cell);
+    guint  len  = strlen(upd);
+    guint  n    = 0;
+
+    for (n=1; n<1000; ++n) {
+        g_snprintf(upd+len-3, 4, "%03i", n);
+        if (FALSE == g_file_test(upd, G_FILE_TEST_EXISTS))
+            break;
+    }
+
+    if (1 == n) {
+        g_free(upd);
+        return NULL;
+    }
+
+    g_snprintf(upd+len-3, 4, "%03i", n-1);
+
+    return upd;
+}
+
+int main(int argc, char *argv[])
+{
+    int        nLoop = 1;
+    GPtrArray *cells = g_ptr_array_new();
+
+    for (int i=1; i<argc; ++i) {
+        if ((0==strcmp(argv[i], "-n")) && (i+1<argc)) {
+            nLoop = atoi(argv[++i]);
+            if (nLoop < 1) nLoop = 1;
+            continue;
+        }
+        _collectCell(argv[i], cells);
+    }
+
+    if (0 == cells->len) {
+        printf("Usage: %s [-n loop] cell.000|ENC_ROOT ..\n", argv[0]);
+        return 1;
+    }
+
+    // same options as S52_init() - the native reader return the same fields
+#ifdef S52_USE_SUPP_LINE_OVERLAP
+    g_setenv("OGR_S57_OPTIONS", "UPDATES=APPLY,SPLIT_MULTIPOINT=ON,PRESERVE_EMPTY_NUMBERS=ON,RETURN_PRIMITIVES=ON,RETURN_LINKAGES=ON,LNAM_REFS=ON,RECODE_BY_DSSI=ON", 1);
+#else
+    g_setenv("OGR_S57_OPTIONS", "LNAM_REFS=ON,UPDATES=APPLY,SPLIT_MULTIPOINT=ON,PRESERVE_EMPTY_NUMBERS=ON", 1);
+#endif
+
+    GTimer *timer  = g_timer_new();
+    double  ogrTot = 0.0;
+    double  isoTot = 0.0;
+
+    printf("%-40s %10s %10s %8s %8s %8s\n", "cell", "ogr(ms)", "iso(ms)", "speedup", "nObj", "nPt");
+    for (guint i=0; i<cells->len; ++i) {
+        const char *cell = (const char *)g_ptr_array_index(cells, i);
+        gchar      *base = g_path_get_basename(cell);
+        _count      ogrCnt;
+        _count      isoCnt;
+        double      ogrSec = 0.0;
+        double      isoSec = 0.0;
+        int         isoOK  = TRUE;
+        int         nOgr   = 0;
+
+        for (int n=0; n<nLoop; ++n) {
+            memset(&_cnt, 0, sizeof(_count));
+            g_timer_start(timer);
+            S57_ogrLoadCell(cell, _ogrLoadLayer, _ogrLoadObject);
+            ogrSec += g_timer_elapsed(timer, NULL);
+            ogrCnt  = _cnt;
+            ++nOgr;
+
+            memset(&_cnt, 0, sizeof(_count));
+            g_timer_start(timer);
+            isoOK   = S57_iso8211LoadCell(cell, _isoLoadLayer, _isoLoadObject);
+            isoSec += g_timer_elapsed(timer, NULL);
+            isoCnt  = _cnt;
+
+            if (FALSE == isoOK)
+                break;
+        }
+
+        if (FALSE == isoOK) {
+            gchar *upd = _lastUpdate(cell);
+            if (NULL == upd) {
+                printf("%-40s %10.1f %10s\n", base, ogrSec*1000.0/nOgr, "(ogr)");
+            } else {
+                double updSec = 0.0;
+                for (int n=0; n<nLoop; ++n) {
+                    memset(&_cnt, 0, sizeof(_count));
+                    g_timer_start(timer);
+                    S57_iso8211LoadUpdate(upd, _edtn, _isoUpdate, NULL);
+                    updSec += g_timer_elapsed(timer, NULL);
+                }
+                gchar *ext = g_path_get_basename(upd);
+                printf("%-40s %10.1f %10.1f %7.2fx %8u %8u  (update %s)\n", base,
+                       ogrSec*1000.0/nOgr, updSec*1000.0/nLoop, (0.0<updSec) ? (ogrSec/nOgr)/(updSec/nLoop) : 0.0,
+                       _cnt.nObj, _cnt.nPt, ext);
+                g_free(ext);
+                g_free(upd);
+            }
+            g_free(base);
+            continue;
+        }
+
+        ogrTot += ogrSec;
+        isoTot += isoSec;
+
+        printf("%-40s %10.1f %10.1f %7.2fx %8u %8u\n", base,
+               ogrSec*1000.0/nLoop, isoSec*1000.0/nLoop, (0.0<isoSec) ? ogrSec/isoSec : 0.0,
+               isoCnt.nObj, isoCnt.nPt);
+
+        if ((ogrCnt.nObj!=isoCnt.nObj) || (ogrCnt.nPt!=isoCnt.nPt))
+            printf("WARNING: count mismatch - ogr: %u obj %u pt\n", ogrCnt.nObj, ogrCnt.nPt);
+
+        g_free(base);
+    }
+
+    if (0.0 < isoTot)
+        printf("TOTAL %34s %10.1f %10.1f %7.2fx\n", "", ogrTot*1000.0/nLoop, isoTot*1000.0/nLoop, ogrTot/isoTot);
+
+    S57_iso8211Done();
+    g_timer_destroy(timer);
+    g_ptr_array_foreach(cells, (GFunc)g_free, NULL);
+    g_ptr_array_free(cells, TRUE);
+
+    return 0;
+}
@@ -0,0 +1,956 @@
+// s57gen.c: synthetic S-57 ENC generator (ISO 8211) - cells and CATALOG.031 for scaling / stress test
+//
+// Project:  OpENCview
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Usage: s57gen [-u 3,4,5] [-g grid] [-x overlap] [-a lat,lon,size] [-o CLASS=n,..] [-p nSnd] [-v nVertex] [-s seed] ENC_ROOT
+//
+//   -u  INTU (navigational purpose) of each level, default "3,4,5"
+//   -g  the first level is a grid x grid of cells, each next level double the grid, default 1
+//       (ie -g 10 -u 3,4 give 100 + 400 cells)
+//   -x  cells of a level overlap their neighbour by this fraction of a cell, default 0.0
+//   -a  area covered by every level: south-west corner and size in deg, default 45.0,-65.0,1.0
+//   -o  objects per cell, default DEPARE=16,DEPCNT=8,SOUNDG=10,LIGHTS=10,BOYLAT=10,LNDARE=4
+//   -p  soundings per SOUNDG, default 20
+//   -v  polygon complexity: vertex per edge (DEPARE / DEPCNT / M_COVR) or per ring (LNDARE), default 8
+//   -s  random seed, default 52 (same ENC every run)
+//
+// Ex: 10 to 10,000 cells, 1k to 10M objects
+//   $ ./s57gen -g 10 -u 3 /tmp/enc10x10                           # 100 cells, 5.8k objects
+//   $ ./s57gen -g 25 -u 3,4,5 -x 0.1 -o DEPARE=100,SOUNDG=200 /tmp/encBig
+//   $ S52_loadCell(/tmp/enc10x10/CATALOG.031) -or- each .000
+//
+// Topology is chain-node (DSTR 2): DEPARE tile the cell on a grid and share their
+// (jagged) edges with each other, DEPCNT and M_COVR (CATCOV 1), LNDARE are star
+// shaped islands (a closed edge), SOUNDG / LIGHTS / BOYLAT are isolated nodes.
+// Cell name is ZZ<INTU><5 digits>.000, as expected by S52CM.c.
+
+
+#include <glib.h>
+#include <glib/gstdio.h>    // g_mkdir_with_parents()
+#include <stdio.h>          // printf(), fopen()
+#include <stdlib.h>         // atoi()
+#include <stdarg.h>         // va_list
+#include <string.h>         // strlen()
+#include <math.h>           // sin()
+
+#define FT      0x1e        // ISO 8211 field terminator
+#define UT      0x1f        // ISO 8211 unit terminator
+#define COMF    10000000.0  // coordinate multiplication factor
+#define SOMF    10.0        // 3-D (sounding) multiplication factor
+#define MAX_PT  8000        // keep record under 99999 bytes (5 digit record length)
+
+// RCNM
+#define RCNM_VI 110         // isolated node
+#define RCNM_VC 120         // connected node
+#define RCNM_VE 130         // edge
+#define RCNM_FE 100         // feature
+
+// S-57 object class (OBJL) - see s57objectclasses.csv
+enum { _DEPARE, _DEPCNT, _SOUNDG, _LIGHTS, _BOYLAT, _LNDARE, _N_CLASS };
+static const char  *_className[_N_CLASS] = {"DEPARE", "DEPCNT", "SOUNDG", "LIGHTS", "BOYLAT", "LNDARE"};
+static const guint  _classOBJL[_N_CLASS] = {  42,       43,       129,      75,       17,       71    };
+static       guint  _classN   [_N_CLASS] = {  16,        8,        10,      10,       10,        4    };
+#define OBJL_M_COVR 302
+
+// S-57 attribute (ATTL) - see s57attributes.csv
+#define ATTL_BOYSHP   4
+#define ATTL_CATCOV  18
+#define ATTL_CATLAM  36
+#define ATTL_COLOUR  75
+#define ATTL_COLPAT  76
+#define ATTL_DRVAL1  87
+#define ATTL_DRVAL2  88
+#define ATTL_LITCHR 107
+#define ATTL_OBJNAM 116
+#define ATTL_SCAMIN 133
+#define ATTL_SIGPER 141
+#define ATTL_VALDCO 174
+#define ATTL_VALNMR 178
+
+// compilation scale of INTU 1..6
+static const guint _CSCL[7] = {0, 1500000, 350000, 90000, 22000, 8000, 3000};
+
+typedef struct _ext {
+    double S, W, N, E;
+} _ext;
+
+typedef struct _cell {
+    gchar  *name;       // ZZ<INTU><n>.000
+    int     intu;
+    _ext    ext;
+} _cell;
+
+typedef struct _gen {
+    GByteArray *buf;    // whole cell
+    guint       nRec;   // 0001 record id
+    guint       rcid;   // next RCID of vector / feature
+    guint       fidn;   // next FIDN
+    guint       nVI, nVC, nVE, nFE;
+    guint       nMeta, nCart, nGeo;
+} _gen;
+
+static GRand  *_rnd     = NULL;
+static int     _nVertex = 8;
+static int     _nSnd    = 20;
+static GArray *_intu    = NULL;     // int
+static int     _grid    = 1;
+static double  _overlap = 0.0;
+static _ext    _area    = {45.0, -65.0, 46.0, -64.0};
+
+//----------------------------------
+// ISO 8211 record
+//----------------------------------
+
+typedef struct _fld {
+    char        tag[5];
+    GByteArray *data;
+} _fld;
+
+static int        _ndigit(guint v)
+{
+    int n = 1;
+    for (; 10<=v; v/=10)
+        ++n;
+    return n;
+}
+
+static void       _putU(GByteArray *b, guint v, int n)
+// binary unsigned int, little endian - S-57 bn
+{
+    for (int i=0; i<n; ++i) {
+        guint8 c = (v >> (8*i)) & 0xFF;
+        g_byte_array_append(b, &c, 1);
+    }
+}
+
+static void       _putI4(GByteArray *b, gint32 v)
+{
+    _putU(b, (guint)v, 4);
+}
+
+static void       _putA(GByteArray *b, const char *str)
+// variable length text - UT terminated
+{
+    guint8 ut = UT;
+    g_byte_array_append(b, (const guint8*)str, strlen(str));
+    g_byte_array_append(b, &ut, 1);
+}
+
+static void       _putFix(GByteArray *b, const char *str)
+// fixed length text
+{
+    g_byte_array_append(b, (const guint8*)str, strlen(str));
+}
+
+static void       _putFT(GByteArray *b)
+{
+    guint8 ft = FT;
+    g_byte_array_append(b, &ft, 1);
+}
+
+static void       _writeRec(GByteArray *out, GArray *flds, char leaderID)
+// leader + directory + field area - DDR when leaderID is 'L'
+{
+    guint area = 0;
+    for (guint i=0; i<flds->len; ++i)
+        area += g_array_index(flds, _fld, i).data->len;
+
+    int   sizeLen = MAX(_ndigit(area), 3);
+    int   sizePos = MAX(_ndigit(area), 4);
+    guint base    = 24 + flds->len * (4 + sizeLen + sizePos) + 1;
+    guint reclen  = base + area;
+
+    char leader[25];
+    if ('L' == leaderID)
+        g_snprintf(leader, sizeof(leader), "%05u3LE1 09%05u ! %1d%1d04", reclen, base, sizeLen, sizePos);
+    else
+        g_snprintf(leader, sizeof(leader), "%05u D     %05u   %1d%1d04", reclen, base, sizeLen, sizePos);
+    g_byte_array_append(out, (const guint8*)leader, 24);
+
+    guint pos = 0;
+    for (guint i=0; i<flds->len; ++i) {
+        _fld *f = &g_array_index(flds, _fld, i);
+        char  dir[32];
+        g_snprintf(dir, sizeof(dir), "%s%0*u%0*u", f->tag, sizeLen, f->data->len, sizePos, pos);
+        g_byte_array_append(out, (const guint8*)dir, strlen(dir));
+        pos += f->data->len;
+    }
+    _putFT(out);
+
+    for (guint i=0; i<flds->len; ++i) {
+        _fld *f = &g_array_index(flds, _fld, i);
+        g_byte_array_append(out, f->data->data, f->data->len);
+        g_byte_array_free(f->data, TRUE);
+    }
+
+    g_array_free(flds, TRUE);
+}
+
+static GByteArray *_addFld(GArray *flds, const char *tag)
+// new field in record 'flds' - return its data to fill
+{
+    _fld f;
+    g_strlcpy(f.tag, tag, sizeof(f.tag));
+    f.data = g_byte_array_new();
+    g_array_append_val(flds, f);
+
+    return f.data;
+}
+
+static GArray    *_newRec(_gen *g)
+// data record - with its 0001 field
+{
+    GArray     *flds = g_array_new(FALSE, FALSE, sizeof(_fld));
+    GByteArray *b    = _addFld(flds, "0001");
+    _putU(b, ++g->nRec, 2);
+    _putFT(b);
+
+    return flds;
+}
+
+static void       _addDDF(GArray *flds, const char *tag, const char *ctl, const char *name,
+                          const char *label, const char *format)
+// field description in the DDR
+{
+    GByteArray *b = _addFld(flds, tag);
+    _putFix(b, ctl);
+    _putFix(b, name);
+    if (NULL != label) {
+        guint8 ut = UT;
+        g_byte_array_append(b, &ut, 1);
+        _putA(b, label);
+        _putFix(b, format);
+    }
+    _putFT(b);
+}
+
+static void       _writeDDR(GByteArray *out, const char *title, int catalog)
+{
+    GArray *flds = g_array_new(FALSE, FALSE, sizeof(_fld));
+
+    GByteArray *b = _addFld(flds, "0000");
+    _putFix(b, "0000;&   ");
+    _putFix(b, title);
+    _putFT(b);
+
+    if (TRUE == catalog) {
+        _addDDF(flds, "0001", "0100;&   ", "ISO 8211 Record Identifier", "", "(I(5))");
+        _addDDF(flds, "CATD", "1600;&   ", "Catalogue Directory field",
+                "RCNM!RCID!FILE!LFIL!VOLM!IMPL!SLAT!WLON!NLAT!ELON!CRCS!COMT", "(A(2),I(10),3A,A(3),4R,2A)");
+    } else {
+        _addDDF(flds, "0001", "0100;&   ", "ISO 8211 Record Identifier", "", "(b12)");
+        _addDDF(flds, "DSID", "1600;&   ", "Data set identification field",
+                "RCNM!RCID!EXPP!INTU!DSNM!EDTN!UPDN!UADT!ISDT!STED!PRSP!PSDN!PRED!PROF!AGEN!COMT",
+                "(b11,b14,2b11,3A,2A(8),R(4),b11,2A,b11,b12,A)");
+        _addDDF(flds, "DSSI", "1600;&   ", "Data set structure information field",
+                "DSTR!AALL!NALL!NOMR!NOCR!NOGR!NOLR!NOIN!NOCN!NOED!NOFA", "(3b11,8b14)");
+        _addDDF(flds, "DSPM", "1600;&   ", "Data set parameter field",
+                "RCNM!RCID!HDAT!VDAT!SDAT!CSCL!DUNI!HUNI!PUNI!COUN!COMF!SOMF!COMT", "(b11,b14,3b11,b14,4b11,2b14,A)");
+        _addDDF(flds, "VRID", "1600;&   ", "Vector record identifier field",
+                "RCNM!RCID!RVER!RUIN", "(b11,b14,b12,b11)");
+        _addDDF(flds, "VRPT", "2600;&   ", "Vector record pointer field",
+                "*NAME!ORNT!USAG!TOPI!MASK", "(B(40),4b11)");
+        _addDDF(flds, "SG2D", "2500;&   ", "2-D coordinate field",
+                "*YCOO!XCOO", "(2b24)");
+        _addDDF(flds, "SG3D", "2500;&   ", "3-D coordinate (sounding array) field",
+                "*YCOO!XCOO!VE3D", "(3b24)");
+        _addDDF(flds, "FRID", "1600;&   ", "Feature record identifier field",
+                "RCNM!RCID!PRIM!GRUP!OBJL!RVER!RUIN", "(b11,b14,2b11,2b12,b11)");
+        _addDDF(flds, "FOID", "1600;&   ", "Feature object identifier field",
+                "AGEN!FIDN!FIDS", "(b12,b14,b12)");
+        _addDDF(flds, "ATTF", "2600;&   ", "Feature record attribute field",
+                "*ATTL!ATVL", "(b12,A)");
+        _addDDF(flds, "FSPT", "2600;&   ", "Feature record to spatial record pointer field",
+                "*NAME!ORNT!USAG!MASK", "(B(40),3b11)");
+    }
+
+    _writeRec(out, flds, 'L');
+}
+
+//----------------------------------
+// S-57 record
+//----------------------------------
+
+static void       _putXY(GByteArray *b, double lat, double lon)
+{
+    _putI4(b, (gint32)lround(lat * COMF));
+    _putI4(b, (gint32)lround(lon * COMF));
+}
+
+static void       _putVRID(GArray *flds, guint rcnm, guint rcid)
+{
+    GByteArray *b = _addFld(flds, "VRID");
+    _putU(b, rcnm, 1);
+    _putU(b, rcid, 4);
+    _putU(b, 1,    2);  // RVER
+    _putU(b, 1,    1);  // RUIN: insert
+    _putFT(b);
+}
+
+static guint      _newNode(_gen *g, guint rcnm, double lat, double lon)
+// isolated / connected node - return RCID
+{
+    guint   rcid = ++g->rcid;
+    GArray *flds = _newRec(g);
+
+    _putVRID(flds, rcnm, rcid);
+    GByteArray *b = _addFld(flds, "SG2D");
+    _putXY(b, lat, lon);
+    _putFT(b);
+
+    _writeRec(g->buf, flds, 'D');
+
+    if (RCNM_VI == rcnm) ++g->nVI; else ++g->nVC;
+
+    return rcid;
+}
+
+static guint      _newSnd(_gen *g, _ext *ext, int n)
+// isolated node with n sounding
+{
+    guint   rcid = ++g->rcid;
+    GArray *flds = _newRec(g);
+
+    _putVRID(flds, RCNM_VI, rcid);
+    GByteArray *b = _addFld(flds, "SG3D");
+    for (int i=0; i<n; ++i) {
+        double lat = g_rand_double_range(_rnd, ext->S, ext->N);
+        double lon = g_rand_double_range(_rnd, ext->W, ext->E);
+        _putXY(b, lat, lon);
+        _putI4(b, (gint32)lround(g_rand_double_range(_rnd, 0.0, 50.0) * SOMF));
+    }
+    _putFT(b);
+
+    _writeRec(g->buf, flds, 'D');
+
+    ++g->nVI;
+
+    return rcid;
+}
+
+static guint      _newEdge(_gen *g, guint beg, guint end, GArray *pts)
+// edge from connected node beg to end, pts: lat/lon pair of the interior vertex
+{
+    guint   rcid = ++g->rcid;
+    GArray *flds = _newRec(g);
+
+    _putVRID(flds, RCNM_VE, rcid);
+
+    GByteArray *b = _addFld(flds, "VRPT");
+    _putU(b, RCNM_VC, 1); _putU(b, beg, 4); _putU(b, 255, 1); _putU(b, 255, 1); _putU(b, 1, 1); _putU(b, 255, 1);
+    _putU(b, RCNM_VC, 1); _putU(b, end, 4); _putU(b, 255, 1); _putU(b, 255, 1); _putU(b, 2, 1); _putU(b, 255, 1);
+    _putFT(b);
+
+    if ((NULL!=pts) && (0<pts->len)) {
+        b = _addFld(flds, "SG2D");
+        for (guint i=0; i<pts->len; i+=2)
+            _putXY(b, g_array_index(pts, double, i), g_array_index(pts, double, i+1));
+        _putFT(b);
+    }
+
+    _writeRec(g->buf, flds, 'D');
+
+    ++g->nVE;
+
+    return rcid;
+}
+
+typedef struct _fspt {
+    guint rcnm;
+    guint rcid;
+    guint ornt;     // 1 forward, 2 reverse, 255 N/A
+    guint usag;     // 1 exterior, 2 interior, 255 N/A
+} _fspt;
+
+static void       _newFeature(_gen *g, guint prim, guint grup, guint objl, GString *attf, _fspt *fspt, guint n)
+// attf: ATTL/ATVL already encoded
+{
+    GArray     *flds = _newRec(g);
+    GByteArray *b    = _addFld(flds, "FRID");
+
+    _putU(b, RCNM_FE,   1);
+    _putU(b, ++g->rcid, 4);
+    _putU(b, prim,      1);
+    _putU(b, grup,      1);
+    _putU(b, objl,      2);
+    _putU(b, 1,         2);  // RVER
+    _putU(b, 1,         1);  // RUIN
+    _putFT(b);
+
+    b = _addFld(flds, "FOID");
+    _putU(b, 540,       2);  // AGEN
+    _putU(b, ++g->fidn, 4);
+    _putU(b, 1,         2);  // FIDS
+    _putFT(b);
+
+    if ((NULL!=attf) && (0<attf->len)) {
+        b = _addFld(flds, "ATTF");
+        g_byte_array_append(b, (const guint8*)attf->str, attf->len);
+        _putFT(b);
+    }
+
+    if (0 < n) {
+        b = _addFld(flds, "FSPT");
+        for (guint i=0; i<n; ++i) {
+            _putU(b, fspt[i].rcnm, 1);
+            _putU(b, fspt[i].rcid, 4);
+            _putU(b, fspt[i].ornt, 1);
+            _putU(b, fspt[i].usag, 1);
+            _putU(b, 255,          1);  // MASK
+        }
+        _putFT(b);
+    }
+
+    _writeRec(g->buf, flds, 'D');
+
+    ++g->nFE;
+    if (OBJL_M_COVR == objl) ++g->nMeta; else ++g->nGeo;
+}
+
+static void       _att(GString *attf, guint attl, const char *fmt, ...)
+{
+    guint8 code[2] = {attl & 0xFF, (attl >> 8) & 0xFF};
+    g_string_append_len(attf, (const gchar*)code, 2);
+
+    va_list ap;
+    va_start(ap, fmt);
+    g_string_append_vprintf(attf, fmt, ap);
+    va_end(ap);
+
+    g_string_append_c(attf, UT);
+}
+
+//----------------------------------
+// cell content
+//----------------------------------
+
+static double     _depth(_ext *area, double lat, double lon)
+// smooth depth field over the whole area (m) - same at every INTU
+{
+    double y = (lat - area->S) / (area->N - area->S);
+    double x = (lon - area->W) / (area->E - area->W);
+
+    return 60.0 * (0.5 + 0.25*sin(6.0*x) + 0.25*cos(5.0*y)) ;
+}
+
+static void       _jagged(GArray *pts, double lat0, double lon0, double lat1, double lon1, double amp)
+// interior vertex of an edge - amp 0: straight
+{
+    g_array_set_size(pts, 0);
+    for (int k=1; k<=_nVertex; ++k) {
+        double t   = (double)k / (_nVertex + 1);
+        double off = (0.0 == amp) ? 0.0 : g_rand_double_range(_rnd, -amp, amp);
+        double lat = lat0 + t*(lat1 - lat0) + ((lon0==lon1) ? 0.0 : off);
+        double lon = lon0 + t*(lon1 - lon0) + ((lat0==lat1) ? 0.0 : off);
+        g_array_append_val(pts, lat);
+        g_array_append_val(pts, lon);
+    }
+}
+
+static void       _genDEPARE(_gen *g, _cell *c)
+// DEPARE tile the cell on a n x n grid of shared edges, DEPCNT on inner edges, M_COVR on the border
+{
+    int     n    = MAX(1, (int)ceil(sqrt((double)_classN[_DEPARE])));
+    double  dLat = (c->ext.N - c->ext.S) / n;
+    double  dLon = (c->ext.E - c->ext.W) / n;
+    guint  *node = g_new0(guint, (n+1)*(n+1));
+    guint  *H    = g_new0(guint, n*(n+1));     // H[j*n+i]    : node(i,j) --> node(i+1,j)
+    guint  *V    = g_new0(guint, (n+1)*n);     // V[i*n+j]    : node(i,j) --> node(i,j+1)
+    GArray *pts  = g_array_new(FALSE, FALSE, sizeof(double));
+
+#define NODE(i,j) node[(j)*(n+1)+(i)]
+#define LAT(j)    (c->ext.S + (j)*dLat)
+#define LON(i)    (c->ext.W + (i)*dLon)
+
+    for (int j=0; j<=n; ++j)
+        for (int i=0; i<=n; ++i)
+            NODE(i,j) = _newNode(g, RCNM_VC, LAT(j), LON(i));
+
+    // keep the jagged edge inside its grid square
+    double ampLat = 0.3 * dLat;
+    double ampLon = 0.3 * dLon;
+    for (int j=0; j<=n; ++j)
+        for (int i=0; i<n; ++i) {
+            _jagged(pts, LAT(j), LON(i), LAT(j), LON(i+1), (0==j || n==j) ? 0.0 : ampLat);
+            H[j*n+i] = _newEdge(g, NODE(i,j), NODE(i+1,j), pts);
+        }
+    for (int i=0; i<=n; ++i)
+        for (int j=0; j<n; ++j) {
+            _jagged(pts, LAT(j), LON(i), LAT(j+1), LON(i), (0==i || n==i) ? 0.0 : ampLon);
+            V[i*n+j] = _newEdge(g, NODE(i,j), NODE(i,j+1), pts);
+        }
+
+    // DEPARE - exterior ring CW: left up, top right, right down, bottom left
+    GString *attf  = g_string_new("");
+    guint    nDEP  = 0;
+    for (int j=0; j<n && nDEP<_classN[_DEPARE]; ++j)
+        for (int i=0; i<n && nDEP<_classN[_DEPARE]; ++i, ++nDEP) {
+            _fspt  ring[4] = {
+                {RCNM_VE, V[ i   *n+j], 1, 1},
+                {RCNM_VE, H[(j+1)*n+i], 1, 1},
+                {RCNM_VE, V[(i+1)*n+j], 2, 1},
+                {RCNM_VE, H[ j   *n+i], 2, 1}
+            };
+            double d  = _depth(&_area, LAT(j) + dLat/2, LON(i) + dLon/2);
+            double d1 = floor(d / 10.0) * 10.0;
+
+            g_string_set_size(attf, 0);
+            _att(attf, ATTL_DRVAL1, "%.1f", d1);
+            _att(attf, ATTL_DRVAL2, "%.1f", d1 + 10.0);
+            _newFeature(g, 3, 1, _classOBJL[_DEPARE], attf, ring, 4);
+        }
+
+    // DEPCNT - on inner edges, first H then V
+    guint nDC = 0;
+    for (int j=1; j<n && nDC<_classN[_DEPCNT]; ++j)
+        for (int i=0; i<n && nDC<_classN[_DEPCNT]; ++i, ++nDC) {
+            _fspt e = {RCNM_VE, H[j*n+i], 1, 255};
+            g_string_set_size(attf, 0);
+            _att(attf, ATTL_VALDCO, "%.1f", floor(_depth(&_area, LAT(j), LON(i) + dLon/2) / 10.0) * 10.0);
+            _newFeature(g, 2, 2, _classOBJL[_DEPCNT], attf, &e, 1);
+        }
+    for (int i=1; i<n && nDC<_classN[_DEPCNT]; ++i)
+        for (int j=0; j<n && nDC<_classN[_DEPCNT]; ++j, ++nDC) {
+            _fspt e = {RCNM_VE, V[i*n+j], 1, 255};
+            g_string_set_size(attf, 0);
+            _att(attf, ATTL_VALDCO, "%.1f", floor(_depth(&_area, LAT(j) + dLat/2, LON(i)) / 10.0) * 10.0);
+            _newFeature(g, 2, 2, _classOBJL[_DEPCNT], attf, &e, 1);
+        }
+    if (nDC < _classN[_DEPCNT])
+        printf("s57gen: WARNING: only %u inner edge for DEPCNT (DEPARE grid %ix%i)\n", nDC, n, n);
+
+    // M_COVR CATCOV 1 - border of the grid, CW
+    GArray *cov = g_array_new(FALSE, FALSE, sizeof(_fspt));
+    for (int j=0; j<n; ++j)     { _fspt e = {RCNM_VE, V[0*n+j], 1, 1}; g_array_append_val(cov, e); }
+    for (int i=0; i<n; ++i)     { _fspt e = {RCNM_VE, H[n*n+i], 1, 1}; g_array_append_val(cov, e); }
+    for (int j=n-1; j>=0; --j)  { _fspt e = {RCNM_VE, V[n*n+j], 2, 1}; g_array_append_val(cov, e); }
+    for (int i=n-1; i>=0; --i)  { _fspt e = {RCNM_VE, H[0*n+i], 2, 1}; g_array_append_val(cov, e); }
+    g_string_set_size(attf, 0);
+    _att(attf, ATTL_CATCOV, "1");
+    _newFeature(g, 3, 2, OBJL_M_COVR, attf, (_fspt*)cov->data, cov->len);
+    g_array_free(cov, TRUE);
+
+#undef NODE
+#undef LAT
+#undef LON
+
+    g_string_free(attf, TRUE);
+    g_array_free(pts, TRUE);
+    g_free(V);
+    g_free(H);
+    g_free(node);
+}
+
+static void       _genLNDARE(_gen *g, _cell *c)
+// star shaped island - one closed edge, CW
+{
+    GArray  *pts  = g_array_new(FALSE, FALSE, sizeof(double));
+    GString *attf = g_string_new("");
+    double   rLat = (c->ext.N - c->ext.S) / 20.0;
+    double   rLon = (c->ext.E - c->ext.W) / 20.0;
+    int      nv   = MAX(3, _nVertex);
+
+    for (guint k=0; k<_classN[_LNDARE]; ++k) {
+        double cLat = g_rand_double_range(_rnd, c->ext.S + rLat, c->ext.N - rLat);
+        double cLon = g_rand_double_range(_rnd, c->ext.W + rLon, c->ext.E - rLon);
+
+        // CW: angle decrease
+        g_array_set_size(pts, 0);
+        double lat0 = 0.0, lon0 = 0.0;
+        for (int v=0; v<nv; ++v) {
+            double a   = -2.0 * G_PI * v / nv;
+            double r   = g_rand_double_range(_rnd, 0.4, 1.0);
+            double lat = cLat + r*rLat*sin(a);
+            double lon = cLon + r*rLon*cos(a);
+            if (0 == v) {
+                lat0 = lat;
+                lon0 = lon;
+            } else {
+                g_array_append_val(pts, lat);
+                g_array_append_val(pts, lon);
+            }
+        }
+
+        guint  vc   = _newNode(g, RCNM_VC, lat0, lon0);
+        guint  ve   = _newEdge(g, vc, vc, pts);
+        _fspt  ring = {RCNM_VE, ve, 1, 1};
+
+        g_string_set_size(attf, 0);
+        _att(attf, ATTL_OBJNAM, "Island %s-%u", c->name, k);
+        _newFeature(g, 3, 1, _classOBJL[_LNDARE], attf, &ring, 1);
+    }
+
+    g_string_free(attf, TRUE);
+    g_array_free(pts, TRUE);
+}
+
+static void       _genPoint(_gen *g, _cell *c)
+// SOUNDG, LIGHTS, BOYLAT
+{
+    GString *attf   = g_string_new("");
+    guint    cscl   = _CSCL[c->intu];
+
+    for (guint k=0; k<_classN[_SOUNDG]; ++k) {
+        _fspt p = {RCNM_VI, _newSnd(g, &c->ext, _nSnd), 255, 255};
+        _newFeature(g, 1, 2, _classOBJL[_SOUNDG], NULL, &p, 1);
+    }
+
+    for (guint k=0; k<_classN[_LIGHTS]; ++k) {
+        double lat = g_rand_double_range(_rnd, c->ext.S, c->ext.N);
+        double lon = g_rand_double_range(_rnd, c->ext.W, c->ext.E);
+        _fspt  p   = {RCNM_VI, _newNode(g, RCNM_VI, lat, lon), 255, 255};
+
+        g_string_set_size(attf, 0);
+        _att(attf, ATTL_COLOUR, "%i", g_rand_int_range(_rnd, 1, 5));    // white, black, red, green
+        _att(attf, ATTL_LITCHR, "%i", g_rand_int_range(_rnd, 1, 8));
+        _att(attf, ATTL_SIGPER, "%i", g_rand_int_range(_rnd, 2, 10));
+        _att(attf, ATTL_VALNMR, "%i", g_rand_int_range(_rnd, 3, 20));
+        // half with SCAMIN - exercise SCAMIN culling
+        if (0 == (k & 1))
+            _att(attf, ATTL_SCAMIN, "%u", cscl * 2);
+        _newFeature(g, 1, 2, _classOBJL[_LIGHTS], attf, &p, 1);
+    }
+
+    for (guint k=0; k<_classN[_BOYLAT]; ++k) {
+        double lat = g_rand_double_range(_rnd, c->ext.S, c->ext.N);
+        double lon = g_rand_double_range(_rnd, c->ext.W, c->ext.E);
+        _fspt  p   = {RCNM_VI, _newNode(g, RCNM_VI, lat, lon), 255, 255};
+        int    lam = g_rand_int_range(_rnd, 1, 3);     // port / starboard
+
+        g_string_set_size(attf, 0);
+        _att(attf, ATTL_BOYSHP, "%i", (1==lam) ? 1 : 2);   // conical / can
+        _att(attf, ATTL_CATLAM, "%i", lam);
+        _att(attf, ATTL_COLOUR, "%i", (1==lam) ? 3 : 4);   // red / green
+        _att(attf, ATTL_COLPAT, "");
+        _att(attf, ATTL_OBJNAM, "%s%u", (1==lam) ? "P" : "S", k);
+        if (0 == (k & 1))
+            _att(attf, ATTL_SCAMIN, "%u", cscl * 2);
+        _newFeature(g, 1, 2, _classOBJL[_BOYLAT], attf, &p, 1);
+    }
+
+    g_string_free(attf, TRUE);
+}
+
+static void       _setDSID(_gen *g, GArray *flds, _cell *c)
+{
+    GByteArray *b = _addFld(flds, "DSID");
+    _putU(b, 10, 1);        // RCNM
+    _putU(b, 1,  4);        // RCID
+    _putU(b, 1,  1);        // EXPP: new
+    _putU(b, c->intu, 1);
+    _putA(b, c->name);      // DSNM
+    _putA(b, "1");          // EDTN
+    _putA(b, "0");          // UPDN
+    _putFix(b, "20170101"); // UADT
+    _putFix(b, "20170101"); // ISDT
+    _putFix(b, "03.1");     // STED
+    _putU(b, 1, 1);         // PRSP: ENC
+    _putA(b, "");           // PSDN
+    _putA(b, "2.0");        // PRED
+    _putU(b, 1, 1);         // PROF: EN
+    _putU(b, 540, 2);       // AGEN
+    _putA(b, "s57gen synthetic cell - not for navigation");
+    _putFT(b);
+
+    b = _addFld(flds, "DSSI");
+    _putU(b, 2, 1);         // DSTR: chain-node
+    _putU(b, 1, 1);         // AALL
+    _putU(b, 1, 1);         // NALL
+    _putU(b, g->nMeta, 4);
+    _putU(b, g->nCart, 4);
+    _putU(b, g->nGeo,  4);
+    _putU(b, 0,        4);  // NOLR
+    _putU(b, g->nVI,   4);
+    _putU(b, g->nVC,   4);
+    _putU(b, g->nVE,   4);
+    _putU(b, 0,        4);  // NOFA
+    _putFT(b);
+}
+
+static void       _setDSPM(_gen *g, _cell *c)
+{
+    GArray     *flds = _newRec(g);
+    GByteArray *b    = _addFld(flds, "DSPM");
+
+    _putU(b, 20, 1);        // RCNM
+    _putU(b, 1,  4);        // RCID
+    _putU(b, 2,  1);        // HDAT: WGS 84
+    _putU(b, 17, 1);        // VDAT
+    _putU(b, 23, 1);        // SDAT
+    _putU(b, _CSCL[c->intu], 4);
+    _putU(b, 1,  1);        // DUNI: m
+    _putU(b, 1,  1);        // HUNI: m
+    _putU(b, 1,  1);        // PUNI: m
+    _putU(b, 1,  1);        // COUN: lat/lon
+    _putU(b, (guint)COMF, 4);
+    _putU(b, (guint)SOMF, 4);
+    _putA(b, "");
+    _putFT(b);
+
+    _writeRec(g->buf, flds, 'D');
+}
+
+static guint      _writeCell(const char *dir, _cell *c)
+// return nbr of feature
+{
+    _gen  g;
+    memset(&g, 0, sizeof(g));
+
+    // DSID need the count - vector / feature first, DDR + DSID prepended
+    GByteArray *body = g_byte_array_new();
+    g.buf  = body;
+    g.nRec = 1;             // DSID is record 1
+
+    _setDSPM(&g, c);
+    _genDEPARE(&g, c);
+    _genLNDARE(&g, c);
+    _genPoint (&g, c);
+
+    GByteArray *head = g_byte_array_new();
+    _writeDDR(head, c->name, FALSE);
+    GArray *flds = g_array_new(FALSE, FALSE, sizeof(_fld));
+    GByteArray *b = _addFld(flds, "0001");
+    _putU(b, 1, 2);
+    _putFT(b);
+    _setDSID(&g, flds, c);
+    _writeRec(head, flds, 'D');
+
+    gchar *path = g_build_filename(dir, c->name, NULL);
+    FILE  *fd   = fopen(path, "wb");
+    if (NULL == fd) {
+        printf("s57gen: can't write %s\n", path);
+        g_free(path);
+        g_byte_array_free(head, TRUE);
+        g_byte_array_free(body, TRUE);
+        return 0;
+    }
+    fwrite(head->data, 1, head->len, fd);
+    fwrite(body->data, 1, body->len, fd);
+    fclose(fd);
+
+    g_free(path);
+    g_byte_array_free(head, TRUE);
+    g_byte_array_free(body, TRUE);
+
+    return g.nFE;
+}
+
+static int        _writeCATALOG(const char *dir, GArray *cells)
+{
+    GByteArray *out = g_byte_array_new();
+    _writeDDR(out, "CATALOG", TRUE);
+
+    for (guint i=0; i<=cells->len; ++i) {
+        GArray     *flds = g_array_new(FALSE, FALSE, sizeof(_fld));
+        GByteArray *b    = _addFld(flds, "0001");
+        char        buf[64];
+
+        g_snprintf(buf, sizeof(buf), "%05u", i+1);
+        _putFix(b, buf);
+        _putFT(b);
+
+        b = _addFld(flds, "CATD");
+        g_snprintf(buf, sizeof(buf), "CD%010u", i+1);
+        _putFix(b, buf);
+        if (0 == i) {
+            // the catalog itself
+            _putA(b, "CATALOG.031");
+            _putA(b, "");
+            _putA(b, "V01X01");
+            _putFix(b, "ASC");
+            _putA(b, ""); _putA(b, ""); _putA(b, ""); _putA(b, "");
+        } else {
+            _cell *c = &g_array_index(cells, _cell, i-1);
+            _putA(b, c->name);
+            _putA(b, "");
+            _putA(b, "V01X01");
+            _putFix(b, "BIN");
+            g_snprintf(buf, sizeof(buf), "%.7f", c->ext.S); _putA(b, buf);
+            g_snprintf(buf, sizeof(buf), "%.7f", c->ext.W); _putA(b, buf);
+            g_snprintf(buf, sizeof(buf), "%.7f", c->ext.N); _putA(b, buf);
+            g_snprintf(buf, sizeof(buf), "%.7f", c->ext.E); _putA(b, buf);
+        }
+        _putA(b, "");   // CRCS
+        _putA(b, "");   // COMT
+        _putFT(b);
+
+        _writeRec(out, flds, 'D');
+    }
+
+    gchar *path = g_build_filename(dir, "CATALOG.031", NULL);
+    int    ret  = g_file_set_contents(path, (const gchar*)out->data, out->len, NULL);
+
+    g_free(path);
+    g_byte_array_free(out, TRUE);
+
+    return ret;
+}
+
+//----------------------------------
+// main
+//----------------------------------
+
+static int        _parseClass(const char *arg)
+// CLASS=n,..
+{
+    gchar **tok = g_strsplit(arg, ",", 0);
+    int     ret = TRUE;
+
+    for (int i=0; NULL!=tok[i]; ++i) {
+        gchar **kv = g_strsplit(tok[i], "=", 2);
+        int     ok = FALSE;
+        if ((NULL!=kv[0]) && (NULL!=kv[1])) {
+            for (int k=0; k<_N_CLASS; ++k) {
+                if (0 == g_strcmp0(kv[0], _className[k])) {
+                    _classN[k] = (guint)atoi(kv[1]);
+                    ok = TRUE;
+                }
+            }
+        }
+        if (FALSE == ok) {
+            printf("s57gen: unknown class in '%s'\n", tok[i]);
+            ret = FALSE;
+        }
+        g_strfreev(kv);
+    }
+    g_strfreev(tok);
+
+    return ret;
+}
+
+static void       _usage(void)
+{
+    printf("Usage: s57gen [-u 3,4,5] [-g grid] [-x overlap] [-a lat,lon,size] [-o CLASS=n,..] [-p nSnd] [-v nVertex] [-s seed] ENC_ROOT\n");
+    printf("       CLASS: DEPARE DEPCNT SOUNDG LIGHTS BOYLAT LNDARE\n");
+}
+
+int main(int argc, char *argv[])
+{
+    guint32 seed = 52;
+    int     i    = 1;
+
+    _intu = g_array_new(FALSE, FALSE, sizeof(int));
+
+    for (; i<argc-1 && '-'==argv[i][0]; i+=2) {
+        const char *opt = argv[i];
+        const char *val = argv[i+1];
+
+        if (0 == g_strcmp0(opt, "-u")) {
+            gchar **tok = g_strsplit(val, ",", 0);
+            for (int k=0; NULL!=tok[k]; ++k) {
+                int intu = atoi(tok[k]);
+                if ((intu<1) || (6<intu)) {
+                    printf("s57gen: INTU %i out of 1..6\n", intu);
+                    return 1;
+                }
+                g_array_append_val(_intu, intu);
+            }
+            g_strfreev(tok);
+        }
+        else if (0 == g_strcmp0(opt, "-g")) _grid    = MAX(1, atoi(val));
+        else if (0 == g_strcmp0(opt, "-x")) _overlap = CLAMP(g_ascii_strtod(val, NULL), 0.0, 1.0);
+        else if (0 == g_strcmp0(opt, "-p")) _nSnd    = CLAMP(atoi(val), 1, MAX_PT);
+        else if (0 == g_strcmp0(opt, "-v")) _nVertex = CLAMP(atoi(val), 0, MAX_PT);
+        else if (0 == g_strcmp0(opt, "-s")) seed     = (guint32)atoi(val);
+        else if (0 == g_strcmp0(opt, "-o")) {
+            if (FALSE == _parseClass(val))
+                return 1;
+        }
+        else if (0 == g_strcmp0(opt, "-a")) {
+            double lat, lon, size;
+            if (3 != sscanf(val, "%lf,%lf,%lf", &lat, &lon, &size)) {
+                _usage();
+                return 1;
+            }
+            _area.S = lat;  _area.N = lat + size;
+            _area.W = lon;  _area.E = lon + size;
+        }
+        else {
+            _usage();
+            return 1;
+        }
+    }
+
+    if (i != argc-1) {
+        _usage();
+        return 1;
+    }
+    const char *dir = argv[i];
+
+    if (0 == _intu->len) {
+        int intu[3] = {3, 4, 5};
+        g_array_append_vals(_intu, intu, 3);
+    }
+
+    if (0 != g_mkdir_with_parents(dir, 0755)) {
+        printf("s57gen: can't create %s\n", dir);
+        return 1;
+    }
+
+    _rnd = g_rand_new_with_seed(seed);
+
+    GArray *cells = g_array_new(FALSE, TRUE, sizeof(_cell));
+    GTimer *timer = g_timer_new();
+    guint   nFE   = 0;
+    gsize   nCell = 0;
+
+    // each level cover the area - grid double at each level
+    for (guint l=0; l<_intu->len; ++l) {
+        int    intu = g_array_index(_intu, int, l);
+        int    n    = _grid << l;
+        double dLat = (_area.N - _area.S) / n;
+        double dLon = (_area.E - _area.W) / n;
+
+        if (99999 < n*n) {
+            printf("s57gen: too many cell at INTU %i (%i)\n", intu, n*n);
+            break;
+        }
+
+        for (int y=0; y<n; ++y)
+            for (int x=0; x<n; ++x) {
+                _cell c;
+                c.intu  = intu;
+                c.name  = g_strdup_printf("ZZ%i%05i.000", intu, y*n + x + 1);
+                c.ext.S = _area.S + (y  -_overlap) * dLat;
+                c.ext.N = _area.S + (y+1+_overlap) * dLat;
+                c.ext.W = _area.W + (x  -_overlap) * dLon;
+                c.ext.E = _area.W + (x+1+_overlap) * dLon;
+
+                nFE += _writeCell(dir, &c);
+                g_array_append_val(cells, c);
+                ++nCell;
+            }
+    }
+
+    _writeCATALOG(dir, cells);
+
+    printf("s57gen: %s: %zu cells, %u features, %.3f sec\n", dir, nCell, nFE, g_timer_elapsed(timer, NULL));
+
+    for (guint k=0; k<cells->len; ++k)
+        g_free(g_array_index(cells, _cell, k).name);
+    g_array_free(cells, TRUE);
+    g_array_free(_intu, TRUE);
+    g_timer_destroy(timer);
+    g_rand_free(_rnd);
+
+    return 0;
+}